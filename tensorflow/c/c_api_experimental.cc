@@ -15,6 +15,9 @@ limitations under the License.
 
 #include "tensorflow/c/c_api_experimental.h"
 
+#include <map>
+#include <memory>
+
 #include "absl/strings/substitute.h"
 #include "tensorflow/c/c_api.h"
 #include "tensorflow/c/c_api_internal.h"
@@ -25,6 +28,7 @@ limitations under the License.
 #include "tensorflow/c/eager/tfe_op_internal.h"
 #include "tensorflow/c/eager/tfe_tensorhandle_internal.h"
 #include "tensorflow/c/tf_buffer_internal.h"
+#include "tensorflow/cc/saved_model/fingerprinting.h"
 #include "tensorflow/compiler/jit/flags.h"
 #include "tensorflow/core/common_runtime/eager/attr_builder.h"
 #include "tensorflow/core/common_runtime/eager/context.h"
@@ -338,6 +342,21 @@ TF_Buffer* TFE_GetServerDef(const char* text_proto, TF_Status* status) {
   return ret;
 }
 
+TF_Buffer* TF_ReadSavedModelFingerprint(const char* export_dir,
+                                        TF_Status* status) {
+  auto fingerprint =
+      tensorflow::saved_model::fingerprinting::ReadSavedModelFingerprint(
+          export_dir);
+  if (!fingerprint.ok()) {
+    status->status = fingerprint.status();
+    return nullptr;
+  }
+  status->status = tensorflow::Status();
+  TF_Buffer* ret = TF_NewBuffer();
+  TF_CHECK_OK(MessageToBuffer(*fingerprint, ret));
+  return ret;
+}
+
 void TF_MakeInternalErrorStatus(TF_Status* status, const char* errMsg) {
   status->status = tensorflow::errors::Internal(errMsg);
 }
@@ -764,3 +783,93 @@ void TF_GraphRemoveFunction(TF_Graph* g, const char* func_name,
   tensorflow::mutex_lock l(g->mu);
   status->status = g->graph.mutable_flib_def()->RemoveFunction(func_name);
 }
+
+// The pool state is shared between the TF_TensorPool handle and every
+// outstanding acquired tensor, so recycling stays safe even if the pool is
+// deleted while tensors are still alive.
+struct TF_TensorPool {
+  struct State {
+    tensorflow::mutex mu;
+    // Idle buffers keyed by their allocated size; acquires are best-fit.
+    std::multimap<size_t, void*> idle TF_GUARDED_BY(mu);
+    bool deleted TF_GUARDED_BY(mu) = false;
+  };
+  std::shared_ptr<State> state = std::make_shared<State>();
+};
+
+namespace {
+
+// Deallocator arg for pooled buffers. `alloc_size` is the size the buffer was
+// allocated with, which can exceed the `len` the tensor was created with when
+// a larger idle buffer was reused.
+struct TF_PooledBuffer {
+  std::shared_ptr<TF_TensorPool::State> state;
+  size_t alloc_size;
+};
+
+void RecyclePooledBuffer(void* data, size_t len, void* arg) {
+  auto* pooled = static_cast<TF_PooledBuffer*>(arg);
+  {
+    tensorflow::mutex_lock l(pooled->state->mu);
+    if (!pooled->state->deleted) {
+      pooled->state->idle.emplace(pooled->alloc_size, data);
+      data = nullptr;
+    }
+  }
+  if (data != nullptr) {
+    tensorflow::deallocate_buffer(data, pooled->alloc_size, nullptr);
+  }
+  delete pooled;
+}
+
+}  // namespace
+
+TF_TensorPool* TF_NewTensorPool(void) { return new TF_TensorPool; }
+
+TF_Tensor* TF_TensorPoolAcquire(TF_TensorPool* pool, TF_DataType dtype,
+                                const int64_t* dims, int num_dims, size_t len) {
+  void* data = nullptr;
+  size_t alloc_size = len;
+  {
+    tensorflow::mutex_lock l(pool->state->mu);
+    auto it = pool->state->idle.lower_bound(len);
+    // Reject buffers more than twice the requested size so one oversized feed
+    // cannot permanently satisfy (and waste most of) every small request.
+    if (it != pool->state->idle.end() && len > 0 && it->first <= 2 * len) {
+      alloc_size = it->first;
+      data = it->second;
+      pool->state->idle.erase(it);
+    }
+  }
+  if (data == nullptr) {
+    data = tensorflow::allocate_tensor("TF_TensorPoolAcquire", len);
+  }
+  // The buffer is aligned to EIGEN_MAX_ALIGN_BYTES, so TF_NewTensor adopts it
+  // without copying. If tensor creation fails, the deallocator runs and the
+  // buffer returns to the pool.
+  auto* pooled = new TF_PooledBuffer{pool->state, alloc_size};
+  return TF_NewTensor(dtype, dims, num_dims, data, len, RecyclePooledBuffer,
+                      pooled);
+}
+
+void TF_TensorPoolTrim(TF_TensorPool* pool) {
+  std::multimap<size_t, void*> idle;
+  {
+    tensorflow::mutex_lock l(pool->state->mu);
+    idle.swap(pool->state->idle);
+  }
+  for (const auto& size_and_buffer : idle) {
+    tensorflow::deallocate_buffer(size_and_buffer.second, size_and_buffer.first,
+                                  nullptr);
+  }
+}
+
+void TF_DeleteTensorPool(TF_TensorPool* pool) {
+  if (pool == nullptr) return;
+  {
+    tensorflow::mutex_lock l(pool->state->mu);
+    pool->state->deleted = true;
+  }
+  TF_TensorPoolTrim(pool);
+  delete pool;
+}
@@ -132,6 +132,14 @@ TF_CAPI_EXPORT extern void TF_EnqueueNamedTensor(TF_Session* session,
 // Create a serialized tensorflow.ServerDef proto.
 TF_Buffer* TFE_GetServerDef(const char* text_proto, TF_Status* status);
 
+// Reads the fingerprint of the SavedModel in `export_dir` and returns it as a
+// serialized tensorflow.FingerprintDef proto, or NULL (with `status` set) if
+// the directory has no fingerprint file. The fingerprint is a stable content
+// hash of the model, identical across processes and restarts, and is intended
+// for use as the model-identity part of cache keys.
+TF_CAPI_EXPORT extern TF_Buffer* TF_ReadSavedModelFingerprint(
+    const char* export_dir, TF_Status* status);
+
 TF_CAPI_EXPORT extern void TF_MakeInternalErrorStatus(TF_Status* status,
                                                       const char* errMsg);
 
@@ -317,6 +325,41 @@ TF_CAPI_EXPORT extern void TF_GraphRemoveFunction(TF_Graph* g,
                                                   const char* func_name,
                                                   TF_Status* status);
 
+// --------------------------------------------------------------------------
+// TF_TensorPool recycles tensor buffers across TF_Tensor lifetimes so that
+// high-rate callers (e.g. serving shims feeding the same shapes every step)
+// perform no allocations across the C boundary in steady state.
+//
+// TF_TensorPoolAcquire() behaves like TF_AllocateTensor() but backs the
+// tensor with a pooled buffer when one of a sufficient size is available.
+// Deleting an acquired tensor with TF_DeleteTensor() returns its buffer to
+// the pool instead of freeing it; that is the recycle operation. Buffers are
+// aligned for direct consumption by TensorFlow (EIGEN_MAX_ALIGN_BYTES).
+//
+// All functions are thread-safe. TF_DeleteTensorPool() may be called while
+// acquired tensors are still alive; their buffers are freed rather than
+// recycled when those tensors are deleted.
+typedef struct TF_TensorPool TF_TensorPool;
+TF_CAPI_EXPORT extern TF_TensorPool* TF_NewTensorPool(void);
+
+// Returns a tensor of the given type and shape backed by `len` bytes of
+// pooled memory, or nullptr if `len` is insufficient for the requested shape.
+// The contents of the buffer are unspecified; callers are expected to
+// overwrite it. The returned tensor is owned by the caller and must be
+// released with TF_DeleteTensor().
+TF_CAPI_EXPORT extern TF_Tensor* TF_TensorPoolAcquire(TF_TensorPool* pool,
+                                                      TF_DataType dtype,
+                                                      const int64_t* dims,
+                                                      int num_dims, size_t len);
+
+// Frees all idle buffers held by the pool, e.g. after a change in serving
+// batch shape makes the cached sizes useless.
+TF_CAPI_EXPORT extern void TF_TensorPoolTrim(TF_TensorPool* pool);
+
+// Deletes the pool and all idle buffers. Outstanding acquired tensors remain
+// valid; their buffers are freed when they are deleted.
+TF_CAPI_EXPORT extern void TF_DeleteTensorPool(TF_TensorPool* pool);
+
 #ifdef __cplusplus
 } /* end extern "C" */
 #endif
@@ -86,6 +86,36 @@ TEST(CAPI_EXPERIMENTAL, IsStateful) {
   EXPECT_EQ(id, 0);
 }
 
+TEST(CAPI_EXPERIMENTAL, TensorPoolRecyclesBuffers) {
+  TF_TensorPool* pool = TF_NewTensorPool();
+  const int64_t dims[] = {2, 3};
+  const size_t len = 6 * TF_DataTypeSize(TF_FLOAT);
+
+  TF_Tensor* t = TF_TensorPoolAcquire(pool, TF_FLOAT, dims, 2, len);
+  ASSERT_NE(t, nullptr);
+  EXPECT_EQ(TF_TensorByteSize(t), len);
+  void* first_buffer = TF_TensorData(t);
+  ASSERT_NE(first_buffer, nullptr);
+  // Deleting the tensor recycles its buffer into the pool.
+  TF_DeleteTensor(t);
+
+  // A same-sized acquire reuses the recycled buffer.
+  t = TF_TensorPoolAcquire(pool, TF_FLOAT, dims, 2, len);
+  ASSERT_NE(t, nullptr);
+  EXPECT_EQ(TF_TensorData(t), first_buffer);
+  TF_DeleteTensor(t);
+
+  // After trimming, a fresh buffer is allocated.
+  TF_TensorPoolTrim(pool);
+  t = TF_TensorPoolAcquire(pool, TF_FLOAT, dims, 2, len);
+  ASSERT_NE(t, nullptr);
+
+  // Deleting the pool with a tensor outstanding leaves the tensor valid.
+  TF_DeleteTensorPool(pool);
+  EXPECT_NE(TF_TensorData(t), nullptr);
+  TF_DeleteTensor(t);
+}
+
 class ShapeInferenceTest : public ::testing::Test {
  protected:
   ShapeInferenceTest()
@@ -15,8 +15,11 @@ limitations under the License.
 
 #include "tensorflow/cc/saved_model/loader.h"
 
+#include <memory>
 #include <string>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include "absl/status/status.h"
 #include "absl/strings/str_cat.h"
@@ -40,6 +43,7 @@ limitations under the License.
 #include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/errors.h"
 #include "tensorflow/core/platform/file_system_helper.h"
+#include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/platform/statusor.h"
 #include "tensorflow/core/protobuf/meta_graph.pb.h"
 #include "tensorflow/core/protobuf/saver.pb.h"
@@ -269,6 +273,11 @@ Status RunRestore(const RunOptions& run_options, const string& export_dir,
 
 SavedModelBundleInterface::~SavedModelBundleInterface() {}
 
+const string& SavedModelBundleInterface::GetModelFingerprint() const {
+  static const string* const kEmptyFingerprint = new string;
+  return *kEmptyFingerprint;
+}
+
 Status LoadMetagraphIntoSession(const SessionOptions& session_options,
                                 const MetaGraphDef& meta_graph,
                                 std::unique_ptr<Session>* session) {
@@ -321,6 +330,12 @@ Status LoadSavedModel(const SessionOptions& session_options,
   if (status.ok()) {
     log_and_count(kLoadAttemptSuccess);
     metrics::SavedModelReadPath().Set(export_dir);
+    if (fingerprint_proto.ok()) {
+      // Expose the content hash on the bundle so runtime caches can key
+      // against the model identity rather than inventing their own keys.
+      bundle->fingerprint =
+          saved_model::fingerprinting::Singleprint(*fingerprint_proto);
+    }
   } else {
     log_and_count(kLoadAttemptFail);
   }
@@ -438,6 +453,170 @@ class LiteSessionWrapper : public Session {
  private:
   const std::unique_ptr<Session> wrapped_;
 };
+
+// Session wrapper that defers restoring variables and running the
+// initialization op until the session is first used, so that loading a model
+// does not pay for state its caller may never touch. The deferred work runs
+// exactly once, before the first Run()/RunCallable()/PRun(); its error, if
+// any, is returned from that and every subsequent call.
+class DeferredInitSessionWrapper : public Session {
+ public:
+  DeferredInitSessionWrapper(std::unique_ptr<Session> wrapped,
+                             const RunOptions& run_options, string export_dir,
+                             bool has_saver_def, string restore_op_name,
+                             string filename_tensor_name, string init_op_name,
+                             std::vector<AssetFileDef> asset_file_defs)
+      : wrapped_(std::move(wrapped)),
+        run_options_(run_options),
+        export_dir_(std::move(export_dir)),
+        has_saver_def_(has_saver_def),
+        restore_op_name_(std::move(restore_op_name)),
+        filename_tensor_name_(std::move(filename_tensor_name)),
+        init_op_name_(std::move(init_op_name)),
+        asset_file_defs_(std::move(asset_file_defs)) {}
+
+  Status Create(const GraphDef& graph) override {
+    return wrapped_->Create(graph);
+  }
+  Status Create(GraphDef&& graph) override {
+    return wrapped_->Create(std::move(graph));
+  }
+  Status Create(const RunOptions& run_options, const GraphDef& graph) override {
+    return wrapped_->Create(run_options, graph);
+  }
+  Status Create(const RunOptions& run_options, GraphDef&& graph) override {
+    return wrapped_->Create(run_options, std::move(graph));
+  }
+
+  Status Extend(const GraphDef& graph) override {
+    return wrapped_->Extend(graph);
+  }
+  Status Extend(GraphDef&& graph) override {
+    return wrapped_->Extend(std::move(graph));
+  }
+  Status Extend(const RunOptions& run_options, const GraphDef& graph) override {
+    return wrapped_->Extend(run_options, graph);
+  }
+  Status Extend(const RunOptions& run_options, GraphDef&& graph) override {
+    return wrapped_->Extend(run_options, std::move(graph));
+  }
+
+  Status Run(const std::vector<std::pair<string, Tensor>>& inputs,
+             const std::vector<string>& output_tensor_names,
+             const std::vector<string>& target_node_names,
+             std::vector<Tensor>* outputs) override {
+    TF_RETURN_IF_ERROR(EnsureInitialized());
+    return wrapped_->Run(inputs, output_tensor_names, target_node_names,
+                         outputs);
+  }
+
+  Status Run(const RunOptions& run_options,
+             const std::vector<std::pair<string, Tensor>>& inputs,
+             const std::vector<string>& output_tensor_names,
+             const std::vector<string>& target_node_names,
+             std::vector<Tensor>* outputs, RunMetadata* run_metadata) override {
+    TF_RETURN_IF_ERROR(EnsureInitialized());
+    return wrapped_->Run(run_options, inputs, output_tensor_names,
+                         target_node_names, outputs, run_metadata);
+  }
+
+  Status PRunSetup(const std::vector<string>& input_names,
+                   const std::vector<string>& output_names,
+                   const std::vector<string>& target_nodes,
+                   string* handle) override {
+    TF_RETURN_IF_ERROR(EnsureInitialized());
+    return wrapped_->PRunSetup(input_names, output_names, target_nodes, handle);
+  }
+
+  Status PRun(const string& handle,
+              const std::vector<std::pair<string, Tensor>>& inputs,
+              const std::vector<string>& output_names,
+              std::vector<Tensor>* outputs) override {
+    TF_RETURN_IF_ERROR(EnsureInitialized());
+    return wrapped_->PRun(handle, inputs, output_names, outputs);
+  }
+
+  Status ListDevices(std::vector<DeviceAttributes>* response) override {
+    return wrapped_->ListDevices(response);
+  }
+
+  Status Close(const RunOptions& run_options) override {
+    return wrapped_->Close(run_options);
+  }
+  Status Close() override { return wrapped_->Close(); }
+
+  Status MakeCallable(const CallableOptions& callable_options,
+                      CallableHandle* out_handle) override {
+    return wrapped_->MakeCallable(callable_options, out_handle);
+  }
+
+  Status RunCallable(CallableHandle handle,
+                     const std::vector<Tensor>& feed_tensors,
+                     std::vector<Tensor>* fetch_tensors,
+                     RunMetadata* run_metadata) override {
+    TF_RETURN_IF_ERROR(EnsureInitialized());
+    return wrapped_->RunCallable(handle, feed_tensors, fetch_tensors,
+                                 run_metadata);
+  }
+
+  Status RunCallable(
+      CallableHandle handle, const std::vector<Tensor>& feed_tensors,
+      std::vector<Tensor>* fetch_tensors, RunMetadata* run_metadata,
+      const thread::ThreadPoolOptions& threadpool_options) override {
+    TF_RETURN_IF_ERROR(EnsureInitialized());
+    return wrapped_->RunCallable(handle, feed_tensors, fetch_tensors,
+                                 run_metadata, threadpool_options);
+  }
+
+  Status ReleaseCallable(CallableHandle handle) override {
+    return wrapped_->ReleaseCallable(handle);
+  }
+
+  Status Finalize() override { return wrapped_->Finalize(); }
+
+ private:
+  Status EnsureInitialized() {
+    mutex_lock l(mu_);
+    if (!initialized_) {
+      init_status_ = RunDeferredInit();
+      initialized_ = true;
+    }
+    return init_status_;
+  }
+
+  Status RunDeferredInit() TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+    if (has_saver_def_) {
+      TF_RETURN_IF_ERROR(RunRestore(run_options_, export_dir_,
+                                    restore_op_name_, filename_tensor_name_,
+                                    asset_file_defs_, wrapped_.get()));
+    }
+    if (!init_op_name_.empty()) {
+      LOG(INFO) << "Running deferred initialization op on SavedModel bundle "
+                   "at path: "
+                << export_dir_;
+      std::vector<std::pair<string, Tensor>> inputs;
+      AddAssetsTensorsToInputs(export_dir_, asset_file_defs_, &inputs);
+      RunMetadata run_metadata;
+      TF_RETURN_IF_ERROR(RunOnce(run_options_, inputs, {}, {init_op_name_},
+                                 nullptr /* outputs */, &run_metadata,
+                                 wrapped_.get()));
+    }
+    return OkStatus();
+  }
+
+  const std::unique_ptr<Session> wrapped_;
+  const RunOptions run_options_;
+  const string export_dir_;
+  const bool has_saver_def_;
+  const string restore_op_name_;
+  const string filename_tensor_name_;
+  const string init_op_name_;
+  const std::vector<AssetFileDef> asset_file_defs_;
+
+  mutex mu_;
+  bool initialized_ TF_GUARDED_BY(mu_) = false;
+  Status init_status_ TF_GUARDED_BY(mu_);
+};
 }  // namespace
 
 Status RestoreSession(const RunOptions& run_options,
@@ -492,10 +671,67 @@ Status LoadSavedModel(const SessionOptions& session_options,
                                     tags, &legacy_bundle));
   *bundle = SavedModelBundleLite(
       absl::make_unique<LiteSessionWrapper>(std::move(legacy_bundle.session)),
-      std::move(*legacy_bundle.meta_graph_def.mutable_signature_def()));
+      std::move(*legacy_bundle.meta_graph_def.mutable_signature_def()),
+      std::move(legacy_bundle.fingerprint));
   return OkStatus();
 }
 
+Status LoadSavedModelLazy(const SessionOptions& session_options,
+                          const RunOptions& run_options,
+                          const string& export_dir,
+                          const std::unordered_set<string>& tags,
+                          SavedModelBundle* const bundle) {
+  metrics::SavedModelReadApi(kCCLoadLabel).IncrementBy(1);
+  const uint64 start_microseconds = Env::Default()->NowMicros();
+
+  const Status status = [&]() -> Status {
+    TF_RETURN_IF_ERROR(ReadMetaGraphDefFromSavedModel(export_dir, tags,
+                                                      &bundle->meta_graph_def));
+    TF_RETURN_IF_ERROR(
+        ReadSavedModelDebugInfoIfPresent(export_dir, &bundle->debug_info));
+    TF_RETURN_IF_ERROR(LoadMetagraphIntoSession(
+        session_options, bundle->meta_graph_def, &bundle->session));
+
+    // Capture everything the deferred restore/init needs now, so that errors
+    // in the metadata surface at load time rather than on the first Run.
+    std::vector<AssetFileDef> asset_file_defs;
+    TF_RETURN_IF_ERROR(
+        internal::GetAssetFileDefs(bundle->meta_graph_def, &asset_file_defs));
+    string init_op_name;
+    TF_RETURN_IF_ERROR(
+        internal::GetInitOp(export_dir, bundle->meta_graph_def, &init_op_name));
+    const SaverDef& saver_def = bundle->meta_graph_def.saver_def();
+    bundle->session = std::make_unique<DeferredInitSessionWrapper>(
+        std::move(bundle->session), run_options, export_dir,
+        bundle->meta_graph_def.has_saver_def(), saver_def.restore_op_name(),
+        saver_def.filename_tensor_name(), init_op_name,
+        std::move(asset_file_defs));
+    return OkStatus();
+  }();
+
+  LOG(INFO) << "SavedModel lazy load for tags { " << absl::StrJoin(tags, " ")
+            << " }; Status: " << status << ". Took "
+            << GetLatencyMicroseconds(start_microseconds)
+            << " microseconds (restore/init deferred to first Run).";
+  load_attempt_count
+      ->GetCell(export_dir, status.ok() ? kLoadAttemptSuccess : kLoadAttemptFail)
+      ->IncrementBy(1);
+  if (status.ok()) {
+    metrics::SavedModelReadPath().Set(export_dir);
+    auto fingerprint_proto =
+        saved_model::fingerprinting::ReadSavedModelFingerprint(export_dir);
+    if (fingerprint_proto.ok()) {
+      metrics::SavedModelReadFingerprint().Set(
+          std::to_string(fingerprint_proto->saved_model_checksum()));
+      bundle->fingerprint =
+          saved_model::fingerprinting::Singleprint(*fingerprint_proto);
+    }
+  }
+  load_latency->GetCell(export_dir)
+      ->IncrementBy(GetLatencyMicroseconds(start_microseconds));
+  return status;
+}
+
 bool MaybeSavedModelDirectory(const string& export_dir) {
   const string saved_model_pb_path =
       io::JoinPath(export_dir, kSavedModelFilenamePb);
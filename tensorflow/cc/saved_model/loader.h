@@ -40,6 +40,14 @@ class SavedModelBundleInterface {
   /// Returns a map from signature name to SignatureDef for all signatures in
   /// in the SavedModel.
   virtual const protobuf::Map<string, SignatureDef>& GetSignatures() const = 0;
+
+  /// Returns the stable content fingerprint (singleprint) of the loaded
+  /// SavedModel, or an empty string if the SavedModel did not ship a
+  /// fingerprint. The value is identical across processes and restarts for
+  /// the same model content, which makes it suitable as the identity part of
+  /// cache keys for expensive runtime artifacts (compiled executables,
+  /// autotuning results, packed weights).
+  virtual const string& GetModelFingerprint() const;
 };
 
 /// SavedModel representation once the SavedModel is loaded from storage.
@@ -61,10 +69,14 @@ struct SavedModelBundle : public SavedModelBundleInterface {
   const protobuf::Map<string, SignatureDef>& GetSignatures() const override {
     return meta_graph_def.signature_def();
   }
+  const string& GetModelFingerprint() const override { return fingerprint; }
 
   std::unique_ptr<Session> session;
   MetaGraphDef meta_graph_def;
   std::unique_ptr<GraphDebugInfo> debug_info;
+  // The singleprint of the loaded SavedModel; empty if the export directory
+  // had no fingerprint file.
+  string fingerprint;
 };
 
 // A version of SavedModelBundle that avoids storing a potentially large
@@ -76,8 +88,11 @@ class SavedModelBundleLite : public SavedModelBundleInterface {
   SavedModelBundleLite& operator=(SavedModelBundleLite&& other) = default;
 
   SavedModelBundleLite(std::unique_ptr<Session> session,
-                       protobuf::Map<string, SignatureDef> signatures)
-      : session_(std::move(session)), signatures_(std::move(signatures)) {}
+                       protobuf::Map<string, SignatureDef> signatures,
+                       string fingerprint = "")
+      : session_(std::move(session)),
+        signatures_(std::move(signatures)),
+        fingerprint_(std::move(fingerprint)) {}
 
   /// A TensorFlow Session does not Close itself on destruction. To avoid
   /// resource leaks, we explicitly call Close on Sessions that we create.
@@ -91,10 +106,12 @@ class SavedModelBundleLite : public SavedModelBundleInterface {
   const protobuf::Map<string, SignatureDef>& GetSignatures() const override {
     return signatures_;
   }
+  const string& GetModelFingerprint() const override { return fingerprint_; }
 
  private:
   std::unique_ptr<Session> session_;
   protobuf::Map<string, SignatureDef> signatures_;
+  string fingerprint_;
 };
 
 // Restore variable and resources in the SavedModel export dir for the
@@ -135,6 +152,23 @@ Status LoadSavedModel(const SessionOptions& session_options,
                       const std::unordered_set<string>& tags,
                       SavedModelBundleLite* const bundle);
 
+/// Loads a SavedModel as `LoadSavedModel` does, but defers restoring variables
+/// and running the initialization op until the first call to `Run` (or
+/// `RunCallable`) on the returned session. Functions and signatures are
+/// already instantiated on demand by the session, so for a multi-signature
+/// model only the state needed by the signatures actually called is ever
+/// materialized; processes that use a single signature see startup drop to
+/// roughly the cost of reading the MetaGraphDef.
+///
+/// The first `Run` pays for the deferred restore/init and fails with its
+/// error, if any. Callers that touch variables through other channels (e.g.
+/// the resource manager) before the first `Run` should use `LoadSavedModel`.
+Status LoadSavedModelLazy(const SessionOptions& session_options,
+                          const RunOptions& run_options,
+                          const string& export_dir,
+                          const std::unordered_set<string>& tags,
+                          SavedModelBundle* const bundle);
+
 /// Checks whether the provided directory could contain a SavedModel. Note that
 /// the method does not load any data by itself. If the method returns `false`,
 /// the export directory definitely does not contain a SavedModel. If the method
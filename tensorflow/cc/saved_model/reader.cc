@@ -15,6 +15,8 @@ limitations under the License.
 
 #include "tensorflow/cc/saved_model/reader.h"
 
+#include <cstdlib>
+#include <limits>
 #include <memory>
 #include <string>
 #include <unordered_set>
@@ -34,6 +36,7 @@ limitations under the License.
 #include "tensorflow/core/lib/strings/strcat.h"
 #include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/file_system_helper.h"
+#include "tensorflow/core/platform/protobuf.h"
 #include "tensorflow/core/platform/path.h"
 #include "tensorflow/core/platform/statusor.h"
 #include "tensorflow/core/protobuf/saved_model.pb.h"
@@ -74,6 +77,38 @@ Status FindMetaGraphDef(const std::unordered_set<string>& tags,
           " }. To inspect available tag-sets in the SavedModel, please "
           "use the SavedModel CLI: `saved_model_cli`"));
 }
+
+// Set TF_SAVED_MODEL_MMAP_PARSE=1 to parse saved_model.pb directly out of a
+// read-only memory-mapped region instead of streaming the file through a heap
+// buffer. For multi-hundred-megabyte graph protos this skips one full copy of
+// the file and lets repeated loads parse straight from the page cache.
+bool MmapParseEnabled() {
+  const char* val = std::getenv("TF_SAVED_MODEL_MMAP_PARSE");
+  return val != nullptr && val[0] == '1';
+}
+
+Status ReadSavedModelFromMemoryRegion(Env* env, const std::string& fname,
+                                      SavedModel* saved_model_proto) {
+  std::unique_ptr<ReadOnlyMemoryRegion> region;
+  TF_RETURN_IF_ERROR(env->NewReadOnlyMemoryRegionFromFile(fname, &region));
+  if (region->length() >
+      static_cast<uint64>(std::numeric_limits<int>::max())) {
+    // CodedInputStream addresses the region with an int; larger SavedModels
+    // cannot be parsed in one piece and must use the chunked proto format.
+    return errors::InvalidArgument("SavedModel file ", fname,
+                                   " is too large to memory-map (",
+                                   region->length(), " bytes)");
+  }
+  protobuf::io::CodedInputStream coded_stream(
+      static_cast<const uint8*>(region->data()),
+      static_cast<int>(region->length()));
+  coded_stream.SetTotalBytesLimit(std::numeric_limits<int>::max());
+  if (!saved_model_proto->ParseFromCodedStream(&coded_stream) ||
+      !coded_stream.ConsumedEntireMessage()) {
+    return errors::DataLoss("Can't parse ", fname, " as binary proto");
+  }
+  return OkStatus();
+}
 }  // namespace
 
 // Reads the SavedModel proto from saved_model.pb in `export_dir`.
@@ -89,8 +124,23 @@ Status ReadSavedModel(absl::string_view export_dir,
         bool saved_model_pb_exists,
         internal::FileExists(Env::Default(), saved_model_pb_path));
     if (saved_model_pb_exists) {
-      Status result = ReadBinaryProto(Env::Default(), saved_model_pb_path,
-                                      saved_model_proto);
+      Status result;
+      if (MmapParseEnabled()) {
+        result = ReadSavedModelFromMemoryRegion(
+            Env::Default(), saved_model_pb_path, saved_model_proto);
+        if (!result.ok()) {
+          // Not every filesystem supports memory mapping; fall back to the
+          // buffered read rather than failing the load.
+          LOG(WARNING) << "Memory-mapped parse of " << saved_model_pb_path
+                       << " failed (" << result
+                       << "); falling back to buffered read.";
+          result = ReadBinaryProto(Env::Default(), saved_model_pb_path,
+                                   saved_model_proto);
+        }
+      } else {
+        result = ReadBinaryProto(Env::Default(), saved_model_pb_path,
+                                 saved_model_proto);
+      }
       if (result.ok()) {
         metrics::SavedModelReadCount(
             saved_model::GetWriteVersion(*saved_model_proto))
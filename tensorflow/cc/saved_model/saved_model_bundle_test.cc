@@ -141,6 +141,21 @@ TEST_F(LoaderTest, TagMatch) {
   CheckSavedModelBundle(export_dir, bundle);
 }
 
+TEST_F(LoaderTest, LazyLoad) {
+  SavedModelBundle bundle;
+  SessionOptions session_options;
+  RunOptions run_options;
+
+  const string export_dir =
+      io::JoinPath(testing::TensorFlowSrcRoot(), kTestDataSharded);
+  TF_ASSERT_OK(LoadSavedModelLazy(session_options, run_options, export_dir,
+                                  {kSavedModelTagServe}, &bundle));
+  // Restore and init run on the first Run(); afterwards the bundle behaves
+  // exactly like an eagerly loaded one.
+  CheckSavedModelBundle(export_dir, bundle);
+  CheckSavedModelBundle(export_dir, bundle);
+}
+
 TEST_F(LoaderTest, ReadMetaGraphFromSavedModel) {
   SavedModelBundle bundle;
   SessionOptions session_options;
@@ -400,5 +415,31 @@ TEST_F(LoaderTest, UpdateFingerprintMetrics) {
             kV2ModuleSavedModelChecksum);
 }
 
+TEST_F(LoaderTest, ModelFingerprintSetOnBundle) {
+  SessionOptions session_options;
+  RunOptions run_options;
+  const string export_dir =
+      io::JoinPath(testing::TensorFlowSrcRoot(), kVarsAndArithmeticObjectGraph);
+
+  SavedModelBundle bundle;
+  TF_ASSERT_OK(LoadSavedModel(session_options, run_options, export_dir,
+                              {kSavedModelTagServe}, &bundle));
+  EXPECT_FALSE(bundle.GetModelFingerprint().empty());
+
+  // The lite bundle reports the same content fingerprint.
+  SavedModelBundleLite lite_bundle;
+  TF_ASSERT_OK(LoadSavedModel(session_options, run_options, export_dir,
+                              {kSavedModelTagServe}, &lite_bundle));
+  EXPECT_EQ(lite_bundle.GetModelFingerprint(), bundle.GetModelFingerprint());
+
+  // Models exported without a fingerprint file report an empty fingerprint.
+  SavedModelBundle unfingerprinted_bundle;
+  const string v1_export_dir =
+      io::JoinPath(testing::TensorFlowSrcRoot(), kTestDataSharded);
+  TF_ASSERT_OK(LoadSavedModel(session_options, run_options, v1_export_dir,
+                              {kSavedModelTagServe}, &unfingerprinted_bundle));
+  EXPECT_TRUE(unfingerprinted_bundle.GetModelFingerprint().empty());
+}
+
 }  // namespace
 }  // namespace tensorflow
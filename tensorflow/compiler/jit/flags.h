@@ -62,6 +62,13 @@ struct MarkForCompilationPassFlags {
   // Maximum number of operators in an XLA compilation.
   int32 tf_xla_max_cluster_size;
 
+  // If positive, an approximate per-cluster compile-time budget in
+  // milliseconds. Clustering stops growing a cluster once its estimated
+  // compile time (derived from a coarse per-operator HLO expansion estimate)
+  // would exceed the budget, trading some fusion opportunity for bounded
+  // first-execution compile latency. Zero disables the budget.
+  int64_t tf_xla_cluster_compile_time_budget_ms;
+
   // If non-empty, limit XLA clustering to the following TF operations.
   string tf_xla_ops_to_cluster;
 
@@ -112,6 +112,13 @@ class MarkForCompilationPassImpl {
     int max_cluster_size;
     int min_cluster_size;
 
+    // If positive, an upper bound on the estimated compile cost of a cluster,
+    // measured in approximate HLO instructions. Edge contractions that would
+    // push a cluster's estimated cost past this budget are rejected so that
+    // no single cluster takes unboundedly long to compile. Zero disables the
+    // budget.
+    int64_t cluster_compile_cost_budget;
+
     // Compiler fuel for the auto-clustering algorithm.
     //
     // We decrement this value by one on every time we choose a compilation
@@ -147,13 +154,14 @@ class MarkForCompilationPassImpl {
    public:
     // Constructs a trivial cluster representing a single TF node.
     Cluster(int tf_graph_node_id, int effective_cluster_size,
-            bool has_functional_control_flow, DeviceSet devices,
-            std::optional<DeviceId> resource_op_device,
+            int64_t compile_cost, bool has_functional_control_flow,
+            DeviceSet devices, std::optional<DeviceId> resource_op_device,
             std::optional<int> resource_var_operation_node_id,
             std::optional<DeadnessPredicate> deadness_predicate,
             bool is_xla_compile_attr_true, std::optional<string> xla_scope)
         : cycles_graph_node_id_(tf_graph_node_id),
           effective_cluster_size_(effective_cluster_size),
+          compile_cost_(compile_cost),
           has_functional_control_flow_(has_functional_control_flow),
           devices_(std::move(devices)),
           resource_op_device_(resource_op_device),
@@ -191,6 +199,9 @@ class MarkForCompilationPassImpl {
     // The size of the cluster excluding constant and identity nodes.
     int effective_cluster_size() const { return effective_cluster_size_; }
 
+    // The cluster's estimated compile cost in approximate HLO instructions.
+    int64_t compile_cost() const { return compile_cost_; }
+
     // True if the cluster has functional control flow like `If` and `While`.
     bool has_functional_control_flow() const {
       return has_functional_control_flow_;
@@ -249,6 +260,7 @@ class MarkForCompilationPassImpl {
     int cluster_size_ = 1;
     int cycles_graph_node_id_;
     int effective_cluster_size_;
+    int64_t compile_cost_;
     bool has_functional_control_flow_;
     DeviceSet devices_;
     std::optional<DeviceId> resource_op_device_;
@@ -359,6 +371,7 @@ class MarkForCompilationPassImpl {
   void VLogClusteringSummary();
 
   Cluster* MakeNewCluster(int cycles_graph_node_id, int effective_cluster_size,
+                          int64_t compile_cost,
                           bool has_functional_control_flow,
                           const DeviceSet& device_set,
                           std::optional<DeviceId> resource_op_device,
@@ -367,7 +380,7 @@ class MarkForCompilationPassImpl {
                           bool is_xla_compile_attr_true,
                           std::optional<string> xla_scope) {
     cluster_storage_.push_back(std::make_unique<Cluster>(
-        cycles_graph_node_id, effective_cluster_size,
+        cycles_graph_node_id, effective_cluster_size, compile_cost,
         has_functional_control_flow, device_set, resource_op_device,
         resource_var_operation_node_id, deadness_predicate,
         is_xla_compile_attr_true, xla_scope));
@@ -587,6 +600,7 @@ void MarkForCompilationPassImpl::Cluster::Merge(Cluster* other) {
 
   cluster_size_ += other->cluster_size_;
   effective_cluster_size_ += other->effective_cluster_size_;
+  compile_cost_ += other->compile_cost_;
   has_functional_control_flow_ |= other->has_functional_control_flow_;
 
   devices_.UnionWith(other->devices_);
@@ -1109,6 +1123,22 @@ static bool GetNodeOrFuncAttr(Node* node, FunctionLibraryDefinition* flib_def,
   return out;
 }
 
+// Returns a coarse estimate of the number of HLO instructions `node` lowers
+// to, used to bound per-cluster compile time. The estimate only needs to be
+// good enough to keep pathological clusters from blowing through a compile
+// budget, so it is intentionally simple: most operators lower to a handful of
+// instructions, while function calls and functional control flow inline whole
+// bodies and get a correspondingly larger weight.
+int64_t ApproximateCompileCost(Node* node) {
+  if (node->IsIdentity() || node->IsConstant()) {
+    return 0;
+  }
+  if (node->IsWhileNode() || node->IsIfNode() || node->IsFunctionCall()) {
+    return 100;
+  }
+  return 3;
+}
+
 Status MarkForCompilationPassImpl::BuildInitialClusterSet() {
   auto ignore_resource_ops = [&](const Node& n, bool* ignore) {
     return IgnoreResourceOpForSafetyAnalysis(&device_info_cache_, n, ignore);
@@ -1173,6 +1203,7 @@ Status MarkForCompilationPassImpl::BuildInitialClusterSet() {
     Cluster* new_cluster = MakeNewCluster(
         /*cycles_graph_node_id=*/node->id(),
         /*effective_cluster_size=*/effective_cluster_size,
+        /*compile_cost=*/ApproximateCompileCost(node),
         /*has_functional_control_flow=*/has_functional_control_flow, devices,
         resource_op_device, resource_var_operation_node_id, deadness_predicate,
         /*is_xla_compile_attr_true=*/is_xla_compile_attr_true,
@@ -1548,6 +1579,15 @@ StatusOr<bool> MarkForCompilationPassImpl::TryToContractEdge(Cluster* from,
         from, to, "the new cluster will be larger than the max cluster size");
   }
 
+  // Don't exceed the per-cluster compile-time budget, if one is configured.
+  if (debug_options_.cluster_compile_cost_budget > 0 &&
+      from->compile_cost() + to->compile_cost() >
+          debug_options_.cluster_compile_cost_budget) {
+    return LogNotContractableAndReturnFalse(
+        from, to,
+        "the new cluster's estimated compile time will exceed the budget");
+  }
+
   TF_ASSIGN_OR_RETURN(bool will_introduce_cross_device_dependency,
                       ClusteringWillIntroduceInterDeviceDependency(*from, *to));
 
@@ -1893,6 +1933,11 @@ Status MarkForCompilation(
       .Run();
 }
 
+// Coarse calibration for turning the user-facing compile-time budget
+// (milliseconds) into the estimated-HLO-instruction budget used during
+// clustering. The exact rate matters much less than the budget being finite.
+constexpr int64_t kEstimatedHloInstructionsCompiledPerMs = 25;
+
 std::atomic<int64_t>* GetPointerToFuel(int64_t initial_value) {
   static std::atomic<int64_t>* fuel = [&]() {
     std::atomic<int64_t>* fuel = new std::atomic<int64_t>;
@@ -1919,6 +1964,9 @@ Status MarkForCompilationPass::Run(
       flags->tf_xla_deterministic_cluster_names;
   debug_options.max_cluster_size = flags->tf_xla_max_cluster_size;
   debug_options.min_cluster_size = flags->tf_xla_min_cluster_size;
+  debug_options.cluster_compile_cost_budget =
+      flags->tf_xla_cluster_compile_time_budget_ms *
+      kEstimatedHloInstructionsCompiledPerMs;
   debug_options.fuel = GetPointerToFuel(flags->tf_xla_clustering_fuel);
   debug_options.dump_graphs = flags->tf_xla_clustering_debug;
 
@@ -1938,6 +1986,9 @@ Status MarkForCompilationPass::RunForTest(
   debug_options.deterministic_cluster_names = deterministic_cluster_names;
   debug_options.max_cluster_size = flags->tf_xla_max_cluster_size;
   debug_options.min_cluster_size = flags->tf_xla_min_cluster_size;
+  debug_options.cluster_compile_cost_budget =
+      flags->tf_xla_cluster_compile_time_budget_ms *
+      kEstimatedHloInstructionsCompiledPerMs;
   debug_options.fuel = GetPointerToFuel(flags->tf_xla_clustering_fuel);
   debug_options.dump_graphs = flags->tf_xla_clustering_debug;
 
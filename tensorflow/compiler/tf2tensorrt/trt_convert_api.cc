@@ -15,8 +15,12 @@ limitations under the License.
 
 #include "tensorflow/compiler/tf2tensorrt/trt_convert_api.h"
 
+#include <algorithm>
+#include <cstring>
 #include <iostream>
+#include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "absl/strings/str_join.h"
@@ -369,6 +373,56 @@ Status ValidateConversionParams(const TfTrtConversionParams& p, int n_inputs) {
   return OkStatus();
 }
 
+// Synthesizes zero-filled input tensors for the declared shapes, taking each
+// input's dtype from its node in the graph.
+Status MakeSyntheticInputs(
+    const GraphDef& graph_def, const std::vector<string>& input_names,
+    const std::vector<std::vector<TensorShape>>& input_shapes,
+    std::vector<std::vector<Tensor>>* inputs) {
+  std::map<string, DataType> input_dtypes;
+  for (const NodeDef& node : graph_def.node()) {
+    if (std::find(input_names.begin(), input_names.end(), node.name()) ==
+        input_names.end()) {
+      continue;
+    }
+    const auto it = node.attr().find("dtype");
+    if (it == node.attr().end()) {
+      return errors::InvalidArgument("Node ", node.name(),
+                                     " has no dtype attribute, cannot "
+                                     "synthesize a build input for it");
+    }
+    input_dtypes[node.name()] = it->second.type();
+  }
+  for (const std::vector<TensorShape>& shapes : input_shapes) {
+    if (shapes.size() != input_names.size()) {
+      return errors::InvalidArgument("Expected one shape per input (",
+                                     input_names.size(), "), got ",
+                                     shapes.size());
+    }
+    std::vector<Tensor> tensors;
+    tensors.reserve(shapes.size());
+    for (int i = 0; i < shapes.size(); i++) {
+      auto it = input_dtypes.find(input_names.at(i));
+      if (it == input_dtypes.end()) {
+        return errors::InvalidArgument("Input node ", input_names.at(i),
+                                       " not found in the graph");
+      }
+      const DataType dtype = it->second;
+      if (!DataTypeCanUseMemcpy(dtype)) {
+        return errors::InvalidArgument(
+            "Cannot synthesize a build input of type ", DataTypeString(dtype),
+            " for input ", input_names.at(i));
+      }
+      Tensor tensor(dtype, shapes.at(i));
+      memset(const_cast<char*>(tensor.tensor_data().data()), 0,
+             tensor.tensor_data().size());
+      tensors.push_back(std::move(tensor));
+    }
+    inputs->push_back(std::move(tensors));
+  }
+  return OkStatus();
+}
+
 // Returns configuration used during the build step session run.
 tensorflow::SessionOptions GetSessionConfg() {
   // We also need to disable constant folding because we already ran constant
@@ -430,6 +484,18 @@ StatusOr<GraphDef> ConvertAndBuild(
   return output;
 }
 
+StatusOr<GraphDef> ConvertAndBuildForShapes(
+    const GraphDef& frozen_graph_def, const std::vector<string>& input_names,
+    const std::vector<string>& output_names,
+    const std::vector<std::vector<TensorShape>>& input_shapes,
+    const TfTrtConversionParams& conv_params) {
+  std::vector<std::vector<Tensor>> inputs;
+  TF_RETURN_IF_ERROR(MakeSyntheticInputs(frozen_graph_def, input_names,
+                                         input_shapes, &inputs));
+  return ConvertAndBuild(frozen_graph_def, input_names, output_names, inputs,
+                         conv_params);
+}
+
 Status InlineFunctions(const MetaGraphDef& meta_graph_def,
                        GraphDef* out_graph_def) {
   ConfigProto config_proto;
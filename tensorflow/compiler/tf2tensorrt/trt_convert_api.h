@@ -25,6 +25,7 @@ limitations under the License.
 #include "tensorflow/compiler/tf2tensorrt/common/utils.h"
 #include "tensorflow/compiler/tf2tensorrt/convert/trt_parameters.h"
 #include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_shape.h"
 #include "tensorflow/core/platform/statusor.h"
 #include "tensorflow/core/protobuf/meta_graph.pb.h"
 
@@ -115,6 +116,35 @@ StatusOr<GraphDef> ConvertAndBuild(
     const std::vector<std::vector<tensorflow::Tensor>>& inputs,
     const TfTrtConversionParams& conv_params);
 
+/**
+ * Pre-builds the TRT engines from declared input shapes.
+ *
+ * Equivalent to ConvertAndBuild, but instead of sample input data the caller
+ * declares the input shapes the deployed model has to handle; zero-filled
+ * tensors of those shapes are synthesized to drive the build. This allows
+ * building the engines ahead of deployment, so the first requests after
+ * deploy do not stall on an engine build. In dynamic shape mode, declaring
+ * several shape sets creates optimization profiles covering all of them (see
+ * TfTrtConversionParams::profile_strategy), yielding a single engine that
+ * serves the declared ranges -- e.g. varying batch sizes -- without
+ * triggering a rebuild at runtime.
+ *
+ * Arguments:
+ * - frozen_graph_def input graph, it is assumed to be frozen
+ * - input_names names of the input tensors
+ * - output_names names of the output tensors
+ * - input_shapes one entry per build pass; each entry holds one fully
+ *   defined shape per input tensor, in the same order as input_names
+ * - conv_params parameters for the TF-TRT conversion
+ *
+ * Returns the converted graph_def.
+ */
+StatusOr<GraphDef> ConvertAndBuildForShapes(
+    const GraphDef& frozen_graph_def, const std::vector<string>& input_names,
+    const std::vector<string>& output_names,
+    const std::vector<std::vector<TensorShape>>& input_shapes,
+    const TfTrtConversionParams& conv_params);
+
 StatusOr<GraphDef> ConvertAndBuild(
     SavedModelBundle* bundle,
     const std::string& signature_key = "serving_default",
@@ -352,6 +352,43 @@ TEST_P(TrtConverterTest, Basic) {
   }
 }
 
+TEST(TrtConverterShapeBuildTest, BuildForDeclaredShapes) {
+  // output = input * [42, 137] + input
+  Scope root = Scope::NewRootScope();
+  auto c = ops::Const(root.WithOpName("my_const"), {{42.0f, 137.0f}});
+  const auto attrs = ops::Placeholder::Shape(PartialTensorShape({-1, 2}));
+  auto x = ops::Placeholder(root.WithOpName("input"), DT_FLOAT, attrs);
+  auto y = ops::Mul(root.WithOpName("my_mul"), x, c);
+  auto z = ops::Add(root.WithOpName("my_add"), x, y);
+  auto q = ops::Identity(root.WithOpName("output"), z);
+  GraphDef graph_def;
+  TF_ASSERT_OK(root.ToGraphDef(&graph_def));
+
+  TfTrtConversionParams params;
+  params.max_workspace_size_bytes = 1 << 20;
+  params.use_calibration = false;
+  params.use_dynamic_shape = true;
+  params.profile_strategy = ProfileStrategy::kOptimal;
+  params.convert_to_static_engine = true;
+
+  // Two declared batch sizes: in dynamic shape mode this creates optimization
+  // profiles covering both without any sample input data.
+  StatusOr<GraphDef> result = ConvertAndBuildForShapes(
+      graph_def, {"input"}, {"output"},
+      {{TensorShape({1, 2})}, {TensorShape({4, 2})}}, params);
+  TF_ASSERT_OK(result.status());
+
+  int n_trt_ops = 0;
+  for (const auto& node : result.value().node()) {
+    if (node.op() == "TRTEngineOp") {
+      n_trt_ops++;
+      EXPECT_TRUE(node.attr().at("static_engine").b());
+      EXPECT_GT(node.attr().at("serialized_segment").s().size(), 0);
+    }
+  }
+  EXPECT_EQ(n_trt_ops, 1);
+}
+
 }  // namespace tensorrt
 }  // namespace tensorflow
 
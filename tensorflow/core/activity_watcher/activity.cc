@@ -15,22 +15,317 @@ limitations under the License.
 
 #include "tensorflow/core/activity_watcher/activity.h"
 
+#include <algorithm>
 #include <atomic>
+#include <cstdint>
 #include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_split.h"
+#include "absl/strings/strip.h"
+#include "absl/time/time.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/env_time.h"
+#include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/platform/logging.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/util/env_var.h"
+#include "tsl/distributed_runtime/coordination/coordination_service_agent.h"
 
 namespace tensorflow {
 namespace activity_watcher {
-void MaybeEnableMultiWorkersWatching(tsl::CoordinationServiceAgent* agent) {}
 
 namespace tfw_internal {
 
 std::atomic<int> g_watcher_level(kWatcherDisabled);
-ActivityId RecordActivityStart(std::unique_ptr<Activity>) {
-  return kActivityNotRecorded;
+
+namespace {
+
+// Completed activities are kept in a fixed-size ring so that recording stays
+// O(1) and memory stays bounded no matter how long the job runs.
+constexpr size_t kRingCapacity = 1 << 12;
+
+struct Recorder {
+  std::atomic<ActivityId> next_id{1};
+  mutex mu;
+  // Activities that have started but not yet ended.
+  absl::flat_hash_map<ActivityId, ActivityRecord> pending TF_GUARDED_BY(mu);
+  // Ring of completed activities.  Once full, next_slot is the oldest entry.
+  std::vector<ActivityRecord> ring TF_GUARDED_BY(mu);
+  size_t next_slot TF_GUARDED_BY(mu) = 0;
+};
+
+Recorder& GlobalRecorder() {
+  static Recorder* recorder = new Recorder();
+  return *recorder;
+}
+
+}  // namespace
+
+ActivityId RecordActivityStart(std::unique_ptr<Activity> activity) {
+  Recorder& recorder = GlobalRecorder();
+  const ActivityId id =
+      recorder.next_id.fetch_add(1, std::memory_order_relaxed);
+  ActivityRecord record;
+  record.id = id;
+  record.activity = std::move(*activity);
+  record.start_timestamp_ns = EnvTime::NowNanos();
+  mutex_lock l(recorder.mu);
+  recorder.pending.emplace(id, std::move(record));
+  return id;
+}
+
+void RecordActivityEnd(ActivityId id) {
+  Recorder& recorder = GlobalRecorder();
+  mutex_lock l(recorder.mu);
+  auto it = recorder.pending.find(id);
+  if (it == recorder.pending.end()) return;
+  it->second.end_timestamp_ns = EnvTime::NowNanos();
+  if (recorder.ring.size() < kRingCapacity) {
+    recorder.ring.push_back(std::move(it->second));
+  } else {
+    recorder.ring[recorder.next_slot] = std::move(it->second);
+    recorder.next_slot = (recorder.next_slot + 1) % kRingCapacity;
+  }
+  recorder.pending.erase(it);
 }
-void RecordActivityEnd(ActivityId id) {}
 
 }  // namespace tfw_internal
 
+namespace {
+
+constexpr char kClockKeyPrefix[] = "activity_watcher/clock/";
+constexpr char kSummaryKeyPrefix[] = "activity_watcher/summary/";
+constexpr char kClockSampleBarrier[] = "activity_watcher_clock_sample";
+constexpr char kClockPublishedBarrier[] = "activity_watcher_clock_published";
+
+// Offset of this worker's clock relative to the cluster median.
+std::atomic<int64_t> g_clock_offset_ns(0);
+
+// Keeps the clock exchange thread alive for the lifetime of the process.
+std::unique_ptr<Thread>* g_clock_sync_thread = new std::unique_ptr<Thread>();
+
+Status OwnKey(tsl::CoordinationServiceAgent* agent, const char* prefix,
+              std::string* key) {
+  TF_ASSIGN_OR_RETURN(const tensorflow::CoordinatedTask task,
+                      agent->GetOwnTask());
+  *key = absl::StrCat(prefix, task.job_name(), "/", task.task_id());
+  return OkStatus();
+}
+
+// Publishes 'value' under 'key', replacing any value from a previous run.
+Status PublishKeyValue(tsl::CoordinationServiceAgent* agent,
+                       const std::string& key, const std::string& value) {
+  agent->DeleteKeyValue(key).IgnoreError();
+  return agent->InsertKeyValue(key, value);
+}
+
+// Estimates the offset of this worker's clock against the cluster median.
+// All workers sample their clock immediately after the same barrier is
+// released, publish the samples, and compare against the median sample, so
+// the estimate is accurate to within the barrier release skew (typically a
+// network round trip).  That is adequate for lining up step phase timelines
+// across workers; it is not a substitute for precise tracing.
+void ExchangeClockSamples(tsl::CoordinationServiceAgent* agent) {
+  // The agent connects shortly after the server starts; wait for it instead
+  // of blocking server setup.
+  for (int i = 0; i < 600 && !agent->IsConnected(); ++i) {
+    Env::Default()->SleepForMicroseconds(100 * 1000);
+  }
+  if (!agent->IsConnected()) {
+    LOG(WARNING) << "Activity watcher clock exchange skipped: coordination "
+                    "service agent never connected.";
+    return;
+  }
+  Status status = agent->WaitAtBarrier(kClockSampleBarrier,
+                                       absl::Minutes(10), /*tasks=*/{});
+  const uint64 sample_ns = EnvTime::NowNanos();
+  if (!status.ok()) {
+    LOG(WARNING) << "Activity watcher clock exchange failed at barrier: "
+                 << status;
+    return;
+  }
+  std::string key;
+  status = OwnKey(agent, kClockKeyPrefix, &key);
+  if (status.ok()) {
+    status = PublishKeyValue(agent, key, absl::StrCat(sample_ns));
+  }
+  if (status.ok()) {
+    status = agent->WaitAtBarrier(kClockPublishedBarrier, absl::Minutes(10),
+                                  /*tasks=*/{});
+  }
+  if (!status.ok()) {
+    LOG(WARNING) << "Activity watcher clock exchange failed: " << status;
+    return;
+  }
+  auto entries = agent->GetKeyValueDir(kClockKeyPrefix);
+  if (!entries.ok()) {
+    LOG(WARNING) << "Activity watcher clock exchange failed: "
+                 << entries.status();
+    return;
+  }
+  std::vector<int64_t> samples;
+  samples.reserve(entries->size());
+  for (const auto& entry : *entries) {
+    int64_t value;
+    if (absl::SimpleAtoi(entry.value(), &value)) samples.push_back(value);
+  }
+  if (samples.empty()) return;
+  std::nth_element(samples.begin(), samples.begin() + samples.size() / 2,
+                   samples.end());
+  const int64_t median = samples[samples.size() / 2];
+  g_clock_offset_ns.store(median - static_cast<int64_t>(sample_ns),
+                          std::memory_order_relaxed);
+  VLOG(1) << "Activity watcher clock offset vs cluster median: "
+          << (median - static_cast<int64_t>(sample_ns)) << "ns across "
+          << samples.size() << " workers.";
+}
+
+struct CategorySummary {
+  int64_t count = 0;
+  int64_t total_ns = 0;
+  int64_t max_ns = 0;
+};
+
+// One line per category: "<category> <count> <total_ns> <max_ns>", preceded
+// by a "clock <offset_ns>" line.
+std::string SerializeLocalSummary() {
+  absl::flat_hash_map<int, CategorySummary> summaries;
+  for (const ActivityRecord& record : CollectActivityRecords()) {
+    CategorySummary& summary = summaries[record.activity.category];
+    const int64_t duration_ns = static_cast<int64_t>(
+        record.end_timestamp_ns - record.start_timestamp_ns);
+    ++summary.count;
+    summary.total_ns += duration_ns;
+    summary.max_ns = std::max(summary.max_ns, duration_ns);
+  }
+  std::string serialized =
+      absl::StrCat("clock ", g_clock_offset_ns.load(std::memory_order_relaxed),
+                   "\n");
+  for (const auto& [category, summary] : summaries) {
+    absl::StrAppend(&serialized, category, " ", summary.count, " ",
+                    summary.total_ns, " ", summary.max_ns, "\n");
+  }
+  return serialized;
+}
+
+}  // namespace
+
+void WatchActivities(int level) {
+  tfw_internal::g_watcher_level.store(level, std::memory_order_release);
+}
+
+std::vector<ActivityRecord> CollectActivityRecords() {
+  tfw_internal::Recorder& recorder = tfw_internal::GlobalRecorder();
+  mutex_lock l(recorder.mu);
+  std::vector<ActivityRecord> records;
+  records.reserve(recorder.ring.size());
+  const size_t size = recorder.ring.size();
+  const size_t oldest = size < tfw_internal::kRingCapacity ? 0
+                                                           : recorder.next_slot;
+  for (size_t i = 0; i < size; ++i) {
+    records.push_back(recorder.ring[(oldest + i) % size]);
+  }
+  return records;
+}
+
+tsl::int64 EstimatedClockOffsetNanos() {
+  return g_clock_offset_ns.load(std::memory_order_relaxed);
+}
+
+tsl::StatusOr<tsl::string> DistributedStragglerReport(
+    tsl::CoordinationServiceAgent* agent) {
+  std::string own_key;
+  TF_RETURN_IF_ERROR(OwnKey(agent, kSummaryKeyPrefix, &own_key));
+  TF_RETURN_IF_ERROR(PublishKeyValue(agent, own_key, SerializeLocalSummary()));
+  TF_ASSIGN_OR_RETURN(const auto entries,
+                      agent->GetKeyValueDir(kSummaryKeyPrefix));
+
+  // worker -> category -> summary.
+  std::vector<std::pair<std::string, absl::flat_hash_map<int, CategorySummary>>>
+      workers;
+  std::vector<std::pair<std::string, int64_t>> offsets;
+  for (const auto& entry : *entries) {
+    absl::string_view worker(entry.key());
+    absl::ConsumePrefix(&worker, kSummaryKeyPrefix);
+    absl::flat_hash_map<int, CategorySummary> summaries;
+    for (absl::string_view line :
+         absl::StrSplit(entry.value(), '\n', absl::SkipEmpty())) {
+      std::vector<absl::string_view> fields = absl::StrSplit(line, ' ');
+      int64_t offset_ns;
+      if (fields.size() == 2 && fields[0] == "clock" &&
+          absl::SimpleAtoi(fields[1], &offset_ns)) {
+        offsets.emplace_back(std::string(worker), offset_ns);
+        continue;
+      }
+      int category;
+      CategorySummary summary;
+      if (fields.size() == 4 && absl::SimpleAtoi(fields[0], &category) &&
+          absl::SimpleAtoi(fields[1], &summary.count) &&
+          absl::SimpleAtoi(fields[2], &summary.total_ns) &&
+          absl::SimpleAtoi(fields[3], &summary.max_ns)) {
+        summaries[category] = summary;
+      }
+    }
+    workers.emplace_back(std::string(worker), std::move(summaries));
+  }
+
+  std::string report = absl::StrCat("Activity watcher straggler report (",
+                                    workers.size(), " workers):\n");
+  for (const auto& [worker, offset_ns] : offsets) {
+    if (offset_ns != 0) {
+      absl::StrAppend(&report, "  clock offset ", worker, ": ", offset_ns,
+                      "ns\n");
+    }
+  }
+  for (int category = kCollective; category <= kRendezvous; ++category) {
+    std::vector<int64_t> totals;
+    for (const auto& [worker, summaries] : workers) {
+      auto it = summaries.find(category);
+      totals.push_back(it == summaries.end() ? 0 : it->second.total_ns);
+    }
+    std::vector<int64_t> sorted_totals = totals;
+    std::nth_element(sorted_totals.begin(),
+                     sorted_totals.begin() + sorted_totals.size() / 2,
+                     sorted_totals.end());
+    const int64_t median = sorted_totals[sorted_totals.size() / 2];
+    if (median == 0) continue;
+    absl::StrAppend(&report,
+                    "  ", ToString(static_cast<ActivityCategory>(category)),
+                    ": median total ", median, "ns\n");
+    for (size_t i = 0; i < workers.size(); ++i) {
+      // A worker spending more than twice the median in a phase is the
+      // straggler signature: everyone else is waiting on it.
+      if (totals[i] > 2 * median) {
+        absl::StrAppend(&report, "    straggler ", workers[i].first, ": ",
+                        totals[i], "ns (",
+                        static_cast<double>(totals[i]) / median,
+                        "x median)\n");
+      }
+    }
+  }
+  return report;
+}
+
+void MaybeEnableMultiWorkersWatching(tsl::CoordinationServiceAgent* agent) {
+  // Re-read on every server creation so a restarted worker can flip it.
+  int64_t level = 0;
+  Status status =
+      ReadInt64FromEnvVar("TF_ACTIVITY_WATCHER_LEVEL", /*default_val=*/0,
+                          &level);
+  if (!status.ok()) LOG(WARNING) << status;
+  if (level <= kWatcherDisabled) return;
+  WatchActivities(static_cast<int>(level));
+  if (agent == nullptr || *g_clock_sync_thread != nullptr) return;
+  g_clock_sync_thread->reset(Env::Default()->StartThread(
+      ThreadOptions(), "activity_watcher_clock_sync",
+      [agent]() { ExchangeClockSamples(agent); }));
+}
+
 }  // namespace activity_watcher
 }  // namespace tensorflow
@@ -19,9 +19,11 @@ limitations under the License.
 #include <functional>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "absl/container/flat_hash_map.h"
 #include "tsl/platform/macros.h"
+#include "tsl/platform/statusor.h"
 #include "tsl/platform/types.h"
 
 namespace tsl {
@@ -80,6 +82,41 @@ struct Activity {
         attributes(std::move(attributes)) {}
 };
 
+// A completed activity as captured by the per-process ring buffer recorder.
+struct ActivityRecord {
+  ActivityId id = kActivityNotRecorded;
+  Activity activity;
+  // Timestamps in nanoseconds on this worker's clock.  Add
+  // EstimatedClockOffsetNanos() to align them with other workers.
+  tsl::uint64 start_timestamp_ns = 0;
+  tsl::uint64 end_timestamp_ns = 0;
+};
+
+// Starts recording activities of the given level (and below) into the
+// per-process ring buffer.  kWatcherDisabled stops recording.
+void WatchActivities(int level);
+
+// Returns a snapshot of the most recently completed activities, oldest
+// first.  The ring buffer is bounded, so under load older records are
+// overwritten.
+std::vector<ActivityRecord> CollectActivityRecords();
+
+// Estimated offset of this worker's clock relative to the cluster median, in
+// nanoseconds, from the clock exchange performed when multi-worker watching
+// is enabled.  Zero until the exchange has completed.  The accuracy is
+// bounded by the release skew of a coordination service barrier, which is
+// adequate for aligning step phase timelines, not for precise tracing.
+tsl::int64 EstimatedClockOffsetNanos();
+
+// Publishes a per-category summary (count, total and max duration) of this
+// worker's recorded activities to the coordination service key-value store
+// and aggregates the summaries published by all workers into a
+// human-readable straggler report.  Cheap enough for production use: it
+// exchanges a few hundred bytes per worker instead of a profiler trace.  The
+// report covers every worker that has published a summary so far.
+tsl::StatusOr<tsl::string> DistributedStragglerReport(
+    tsl::CoordinationServiceAgent* agent);
+
 // Enable activity wathcer to send own workers activities to coordination
 // service and also fetch all workers' activities.
 void MaybeEnableMultiWorkersWatching(tsl::CoordinationServiceAgent* agent);
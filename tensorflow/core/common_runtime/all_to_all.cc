@@ -14,6 +14,7 @@ limitations under the License.
 ==============================================================================*/
 #include "tensorflow/core/common_runtime/all_to_all.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "tensorflow/core/common_runtime/collective_rma_local.h"
@@ -36,11 +37,52 @@ limitations under the License.
 #include "tensorflow/core/platform/blocking_counter.h"
 #include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/types.h"
+#include "tensorflow/core/util/env_var.h"
 
 namespace tensorflow {
 
+namespace {
+
+// Maximum bytes per pipelined all-to-all chunk, or 0 to exchange each peer
+// slice in one shot. Must be set to the same value on all participating
+// workers, since senders and receivers independently derive chunk boundaries
+// from the (uniform) peer slice shape.
+int64_t AllToAllChunkBytes() {
+  int64_t chunk_bytes;
+  TF_CHECK_OK(ReadInt64FromEnvVar("TF_COLLECTIVE_ALL_TO_ALL_CHUNK_BYTES", 0,
+                                  &chunk_bytes));
+  return chunk_bytes;
+}
+
+// Splits slice into contiguous views of at most chunk_bytes along its first
+// dimension. Returns the slice itself when it cannot or need not be split.
+std::vector<Tensor> SplitSliceIntoChunks(const Tensor& slice,
+                                         int64_t chunk_bytes) {
+  if (chunk_bytes <= 0 || slice.dims() == 0 || slice.dim_size(0) <= 1 ||
+      static_cast<int64_t>(slice.TotalBytes()) <= chunk_bytes) {
+    return {slice};
+  }
+  const int64_t num_rows = slice.dim_size(0);
+  const int64_t bytes_per_row = slice.TotalBytes() / num_rows;
+  const int64_t rows_per_chunk =
+      std::max(int64_t{1}, chunk_bytes / std::max(int64_t{1}, bytes_per_row));
+  std::vector<Tensor> chunks;
+  chunks.reserve((num_rows + rows_per_chunk - 1) / rows_per_chunk);
+  for (int64_t start = 0; start < num_rows; start += rows_per_chunk) {
+    chunks.push_back(
+        slice.Slice(start, std::min(num_rows, start + rows_per_chunk)));
+  }
+  return chunks;
+}
+
+}  // namespace
+
 AllToAll::AllToAll()
-    : col_ctx_(nullptr), col_params_(nullptr), done_(nullptr), counter_(0) {}
+    : col_ctx_(nullptr),
+      col_params_(nullptr),
+      done_(nullptr),
+      counter_(0),
+      total_dispatches_(0) {}
 
 StatusCallback AllToAll::CheckCounterAndCallDone() {
   return [this](const Status& s) {
@@ -49,12 +91,13 @@ StatusCallback AllToAll::CheckCounterAndCallDone() {
       mutex_lock l(mu_);
       status_.Update(s);
       ++counter_;
-      // For all devices other than itself, there's a send and a receive. We
-      // wait until all of them complete.
-      if (counter_ < 2 * col_params_->group.group_size) {
+      // For every device in the group there's at least a send and a receive,
+      // each possibly split into multiple chunks. We wait until all of them
+      // complete.
+      if (counter_ < total_dispatches_) {
         return;
       }
-      CHECK_LE(counter_, 2 * col_params_->group.group_size);  // Crash ok.
+      CHECK_LE(counter_, total_dispatches_);  // Crash ok.
       final_status = status_;
     }
     if (!final_status.ok()) {
@@ -110,20 +153,47 @@ void AllToAll::Run(StatusCallback done) {
     output_chunks_.push_back(output_buffer_.SubSlice(output_index));
   }
 
+  // Optionally split each peer slice into fixed-size chunks so that transfers
+  // to different peers interleave on the wire. Peer slices all have the same
+  // shape, so senders and receivers agree on the chunk boundaries as long as
+  // they use the same chunk size.
+  const int64_t chunk_bytes = AllToAllChunkBytes();
+  input_subchunks_.reserve(col_params_->group.group_size);
+  output_subchunks_.reserve(col_params_->group.group_size);
+  total_dispatches_ = 0;
+  for (int i = 0; i < col_params_->group.group_size; ++i) {
+    input_subchunks_.push_back(
+        SplitSliceIntoChunks(input_chunks_[i], chunk_bytes));
+    output_subchunks_.push_back(
+        SplitSliceIntoChunks(output_chunks_[i], chunk_bytes));
+    CHECK_EQ(input_subchunks_[i].size(),
+             output_subchunks_[i].size());  // Crash ok.
+    total_dispatches_ += 2 * input_subchunks_[i].size();
+  }
+
   for (int i = 0; i < col_params_->group.group_size; ++i) {
     auto default_rank = col_params_->default_rank;
-    // Issue send request from current device to all devices in group.
-    DispatchSend(default_rank, i, &input_chunks_[i], CheckCounterAndCallDone());
-    // Issue receive requests from all devices to current device.
-    DispatchRecv(i, default_rank, &output_chunks_[i],
-                 CheckCounterAndCallDone());
+    const int num_subchunks = input_subchunks_[i].size();
+    for (int c = 0; c < num_subchunks; ++c) {
+      // Chunk index -1 keeps the unchunked buffer keys unchanged.
+      const int chunk_index = num_subchunks == 1 ? -1 : c;
+      // Issue send request from current device to all devices in group.
+      DispatchSend(default_rank, i, &input_subchunks_[i][c], chunk_index,
+                   CheckCounterAndCallDone());
+      // Issue receive requests from all devices to current device.
+      DispatchRecv(i, default_rank, &output_subchunks_[i][c], chunk_index,
+                   CheckCounterAndCallDone());
+    }
   }
 }
 
 void AllToAll::DispatchSend(int src_rank, int target_rank, const Tensor* tensor,
-                            const StatusCallback& done) {
+                            int chunk_index, const StatusCallback& done) {
   string send_buf_key =
       strings::StrCat(col_ctx_->exec_key, src_rank, target_rank);
+  if (chunk_index >= 0) {
+    strings::StrAppend(&send_buf_key, ":", chunk_index);
+  }
   col_ctx_->col_exec->remote_access()->PostToPeer(
       col_params_->group.members[target_rank].device.name(),
       col_params_->group.members[target_rank].task, send_buf_key,
@@ -133,9 +203,12 @@ void AllToAll::DispatchSend(int src_rank, int target_rank, const Tensor* tensor,
 }
 
 void AllToAll::DispatchRecv(int src_rank, int target_rank, Tensor* tensor,
-                            const StatusCallback& done) {
+                            int chunk_index, const StatusCallback& done) {
   string recv_buf_key =
       strings::StrCat(col_ctx_->exec_key, src_rank, target_rank);
+  if (chunk_index >= 0) {
+    strings::StrAppend(&recv_buf_key, ":", chunk_index);
+  }
   col_ctx_->col_exec->remote_access()->RecvFromPeer(
       col_params_->group.members[src_rank].device.name(),
       col_params_->group.members[src_rank].task,
@@ -48,19 +48,28 @@ class AllToAll : public CollectiveImplementationInterface {
   std::vector<Tensor> input_chunks_;
   Tensor output_buffer_;
   std::vector<Tensor> output_chunks_;
+  // When chunked pipelining is enabled, per-peer slices split into fixed-size
+  // sub-chunks along the first dimension. Each sub-chunk is exchanged under
+  // its own buffer key so transfers to/from different peers interleave on the
+  // wire instead of serializing whole slices.
+  std::vector<std::vector<Tensor>> input_subchunks_;
+  std::vector<std::vector<Tensor>> output_subchunks_;
   StatusCallback done_;
   mutex mu_;
   Status status_ TF_GUARDED_BY(mu_);
   int counter_ TF_GUARDED_BY(mu_);
+  int total_dispatches_;
 
+  // If chunk_index is negative, the tensor is the peer's entire slice and the
+  // buffer key is unchanged from the unchunked protocol.
   void DispatchSend(int src_rank, int target_rank, const Tensor* tensor,
-                    const StatusCallback& done);
+                    int chunk_index, const StatusCallback& done);
 
   void DispatchRecv(int src_rank, int target_rank, Tensor* tensor,
-                    const StatusCallback& done);
+                    int chunk_index, const StatusCallback& done);
 
-  // Atomically increments counter_ by one for sending, one for receiving.
-  // Invokes done when counter_ reaches 2.
+  // Atomically increments counter_ by one for each completed send or receive.
+  // Invokes done_ when counter_ reaches total_dispatches_.
   // The purpose of checking counter_ is to ensure that done_ is called once.
   StatusCallback CheckCounterAndCallDone();
 };
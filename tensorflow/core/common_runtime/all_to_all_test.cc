@@ -63,6 +63,45 @@ TEST_F(AllToAllTest, Success) {
                                   test::AsTensor<double>({3., 6., 9.}));
 }
 
+TEST_F(AllToAllTest, SuccessChunked) {
+  // Force each peer slice (2 doubles = 16 bytes) to be exchanged as two
+  // pipelined 8-byte chunks.
+  setenv("TF_COLLECTIVE_ALL_TO_ALL_CHUNK_BYTES", "8", /*overwrite*/ 1);
+  test_env_ = CreateCollectiveTestEnv(/*num_workers*/ 1,
+                                      /*num_devices_per_worker*/ 3, DEVICE_CPU);
+  std::vector<Tensor> tensors = {
+      test::AsTensor<double>({1., 2., 3., 4., 5., 6.}, TensorShape({3, 2})),
+      test::AsTensor<double>({7., 8., 9., 10., 11., 12.}, TensorShape({3, 2})),
+      test::AsTensor<double>({13., 14., 15., 16., 17., 18.},
+                             TensorShape({3, 2})),
+  };
+  BlockingCounter counter(3);
+  for (int i = 0; i < 3; ++i) {
+    SchedClosure([this, &tensors, i, &counter]() {
+      auto col_params = CreateCollectiveParams(*test_env_, i, "AllToAll",
+                                               ALL_TO_ALL_COLLECTIVE, DT_DOUBLE,
+                                               tensors[i].shape());
+      Device* device = nullptr;
+      TF_CHECK_OK(test_env_->device_mgr->LookupDevice(
+          col_params->group.members[i].device.name(), &device));
+      TF_CHECK_OK(RunCollective(test_env_.get(), col_params.get(), device,
+                                &tensors[i], &tensors[i]));
+      counter.DecrementCount();
+    });
+  }
+  counter.Wait();
+  unsetenv("TF_COLLECTIVE_ALL_TO_ALL_CHUNK_BYTES");
+  test::ExpectTensorEqual<double>(
+      tensors[0],
+      test::AsTensor<double>({1., 2., 7., 8., 13., 14.}, TensorShape({3, 2})));
+  test::ExpectTensorEqual<double>(
+      tensors[1],
+      test::AsTensor<double>({3., 4., 9., 10., 15., 16.}, TensorShape({3, 2})));
+  test::ExpectTensorEqual<double>(
+      tensors[2], test::AsTensor<double>({5., 6., 11., 12., 17., 18.},
+                                         TensorShape({3, 2})));
+}
+
 TEST_F(AllToAllTest, SuccessDifferentRank) {
   test_env_ = CreateCollectiveTestEnv(/*num_workers*/ 1,
                                       /*num_devices_per_worker*/ 3, DEVICE_CPU);
@@ -15,7 +15,9 @@ limitations under the License.
 #include "tensorflow/core/common_runtime/base_collective_executor.h"
 
 #include <algorithm>
+#include <cstring>
 #include <functional>
+#include <memory>
 #include <utility>
 
 #include "tensorflow/core/common_runtime/copy_tensor.h"
@@ -227,6 +229,177 @@ CollectiveAdapter* MakeCollectiveAdapter(Tensor* output, int num_chunks,
   }
 }
 
+CollectiveFusionManager::CollectiveFusionManager(int instances_per_buffer,
+                                                 LaunchFn launch)
+    : instances_per_buffer_(instances_per_buffer), launch_(std::move(launch)) {
+  DCHECK_GT(instances_per_buffer_, 1);
+}
+
+CollectiveFusionManager::~CollectiveFusionManager() {
+  Abort(errors::Cancelled(
+      "CollectiveFusionManager destroyed with pending members. A fusion "
+      "bucket was never completed; every instance key in a bucket's range "
+      "must execute in every step when collective fusion is enabled."));
+}
+
+/* static */ bool CollectiveFusionManager::IsEligible(
+    const CollectiveParams* col_params) {
+  return col_params->instance.type == REDUCTION_COLLECTIVE &&
+         col_params->group.device_type == DeviceType(DEVICE_CPU) &&
+         col_params->instance.impl_details.dependencies.empty() &&
+         DataTypeCanUseMemcpy(col_params->instance.data_type);
+}
+
+void CollectiveFusionManager::EnqueueAsync(OpKernelContext* ctx,
+                                           const CollectiveParams* col_params,
+                                           const string& exec_key,
+                                           const Tensor* input, Tensor* output,
+                                           StatusCallback done) {
+  const int32_t instance_key = col_params->instance.instance_key;
+  const int64_t bucket_id = instance_key / instances_per_buffer_;
+  Status early_status;
+  bool bucket_complete = false;
+  Bucket complete_bucket;
+  {
+    mutex_lock l(mu_);
+    if (!status_.ok()) {
+      early_status = status_;
+    } else {
+      Bucket& bucket = buckets_[bucket_id];
+      Member& member = bucket[instance_key];
+      if (member.done != nullptr) {
+        early_status = errors::Internal(
+            "Duplicate fusion bucket member for collective instance ",
+            instance_key);
+      } else {
+        member.ctx = ctx;
+        member.col_params = col_params;
+        member.exec_key = exec_key;
+        member.input = input;
+        member.output = output;
+        member.done = std::move(done);
+        if (static_cast<int>(bucket.size()) == instances_per_buffer_) {
+          complete_bucket = std::move(bucket);
+          buckets_.erase(bucket_id);
+          bucket_complete = true;
+        }
+      }
+    }
+  }
+  if (!early_status.ok()) {
+    done(early_status);
+    return;
+  }
+  if (bucket_complete) {
+    LaunchBucket(std::move(complete_bucket));
+  }
+}
+
+void CollectiveFusionManager::Abort(const Status& s) {
+  std::map<int64_t, Bucket> buckets;
+  {
+    mutex_lock l(mu_);
+    if (status_.ok()) status_ = s;
+    buckets.swap(buckets_);
+  }
+  for (auto& bucket_iter : buckets) {
+    for (auto& member_iter : bucket_iter.second) {
+      member_iter.second.done(s);
+    }
+  }
+}
+
+void CollectiveFusionManager::LaunchBucket(Bucket bucket) {
+  // Partition the bucket by metadata that is identical on every rank for a
+  // given instance, so that all ranks fuse exactly the same members into
+  // each collective without negotiating.
+  std::map<string, std::vector<Member>> partitions;
+  for (auto& member_iter : bucket) {
+    Member& member = member_iter.second;
+    const CollectiveParams* cp = member.col_params;
+    const string partition_key = strings::StrCat(
+        cp->group.group_key, ";", DataTypeString(cp->instance.data_type), ";",
+        cp->instance.impl_details.collective_name, ";",
+        cp->merge_op != nullptr ? cp->merge_op->type_string() : "", ";",
+        cp->final_op != nullptr ? cp->final_op->type_string() : "");
+    partitions[partition_key].push_back(std::move(member));
+  }
+  for (auto& partition_iter : partitions) {
+    LaunchPartition(std::move(partition_iter.second));
+  }
+}
+
+void CollectiveFusionManager::LaunchPartition(std::vector<Member> members) {
+  if (members.size() == 1) {
+    Member& member = members[0];
+    launch_(member.ctx, member.col_params, member.exec_key, member.input,
+            member.output, std::move(member.done));
+    return;
+  }
+
+  struct FusedState {
+    std::vector<Member> members;
+    Tensor buffer;
+  };
+  auto state = std::make_shared<FusedState>();
+  state->members = std::move(members);
+
+  int64_t total_elts = 0;
+  for (const Member& member : state->members) {
+    total_elts += member.input->NumElements();
+  }
+  // The first member (lowest instance key) stands in for the fused
+  // collective: its context allocates the fusion buffer and its exec key and
+  // params seed the fused params, so all ranks pick the same representative.
+  const Member& rep = state->members[0];
+  const DataType dtype = rep.col_params->instance.data_type;
+  Status alloc_status = rep.ctx->allocate_temp(
+      dtype, TensorShape({total_elts}), &state->buffer);
+  if (!alloc_status.ok()) {
+    for (Member& member : state->members) member.done(alloc_status);
+    return;
+  }
+
+  // Gather member inputs into the fusion buffer in instance-key order.
+  char* base = reinterpret_cast<char*>(DMAHelper::base(&state->buffer));
+  for (const Member& member : state->members) {
+    const StringPiece src = member.input->tensor_data();
+    memcpy(base, src.data(), src.size());
+    base += src.size();
+  }
+
+  CollectiveParams* fused = new CollectiveParams();
+  fused->name = strings::StrCat(rep.col_params->name, "/fused");
+  fused->group = rep.col_params->group;
+  fused->instance = rep.col_params->instance;
+  fused->instance.shape = TensorShape({total_elts});
+  fused->default_rank = rep.col_params->default_rank;
+  fused->subdiv_rank = rep.col_params->subdiv_rank;
+  fused->merge_op = rep.col_params->merge_op;
+  fused->final_op = rep.col_params->final_op;
+  fused->run_group_initialization = rep.col_params->run_group_initialization;
+  fused->is_stateless = rep.col_params->is_stateless;
+
+  // Reduce the fusion buffer in place as one collective, then scatter the
+  // result back to the members' outputs.
+  launch_(rep.ctx, fused, rep.exec_key, &state->buffer, &state->buffer,
+          [state, fused](const Status& s) {
+            if (s.ok()) {
+              const char* base = reinterpret_cast<const char*>(
+                  DMAHelper::base(&state->buffer));
+              for (Member& member : state->members) {
+                const size_t bytes = member.output->tensor_data().size();
+                memcpy(DMAHelper::base(member.output), base, bytes);
+                base += bytes;
+              }
+            }
+            fused->Unref();
+            for (Member& member : state->members) {
+              member.done(s);
+            }
+          });
+}
+
 BaseCollectiveExecutor::~BaseCollectiveExecutor() {}
 
 void BaseCollectiveExecutor::StartAbort(const Status& s) {
@@ -247,6 +420,9 @@ void BaseCollectiveExecutor::StartAbort(const Status& s) {
     status = status_;
   }
   LOG(ERROR) << "BaseCollectiveExecutor::StartAbort " << s;
+  if (fusion_manager_ != nullptr) {
+    fusion_manager_->Abort(status);
+  }
   cem_->GetParamResolver()->StartAbort(status);
   remote_access_->StartAbort(status);
   if (cem_->GetNcclCommunicator() != nullptr) {
@@ -313,6 +489,22 @@ void BaseCollectiveExecutor::ExecuteAsync(OpKernelContext* ctx,
         col_params->is_source))
           ? &ctx->input(0)
           : nullptr;
+  if (fusion_manager_ != nullptr &&
+      CollectiveFusionManager::IsEligible(col_params)) {
+    fusion_manager_->EnqueueAsync(ctx, col_params, exec_key, input, output,
+                                  std::move(done_safe));
+    return;
+  }
+  LaunchCollective(ctx, col_params, exec_key, input, output,
+                   std::move(done_safe));
+}
+
+void BaseCollectiveExecutor::LaunchCollective(OpKernelContext* ctx,
+                                              const CollectiveParams* col_params,
+                                              const string& exec_key,
+                                              const Tensor* input,
+                                              Tensor* output,
+                                              StatusCallback done_safe) {
   CollectiveImplementationInterface* col_impl = nullptr;
   Status status = CreateCollective(*col_params, &col_impl);
   if (!status.ok()) {
@@ -15,8 +15,10 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_COMMON_RUNTIME_BASE_COLLECTIVE_EXECUTOR_H_
 #define TENSORFLOW_CORE_COMMON_RUNTIME_BASE_COLLECTIVE_EXECUTOR_H_
 
+#include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "tensorflow/core/common_runtime/buf_rendezvous.h"
 #include "tensorflow/core/framework/collective.h"
@@ -90,6 +92,73 @@ CollectiveAdapter* MakeCollectiveAdapter(Tensor* output, int num_chunks,
                                          Allocator* allocator,
                                          bool align_chunks = true);
 
+// Fuses small reduction collectives into fewer, larger collectives to
+// amortize per-collective setup cost, in the style of gradient fusion
+// buffers.  Members are assigned to buckets deterministically from their
+// instance keys alone so that every rank forms identical buckets without a
+// negotiation phase: bucket b holds instance keys
+// [b * instances_per_buffer, (b + 1) * instances_per_buffer).  When all
+// members of a bucket have been enqueued locally they are partitioned by
+// globally consistent metadata (group, data type, collective and reduction
+// op), each multi-member partition is gathered into one fusion buffer,
+// reduced as a single collective, and scattered back to the members'
+// outputs.
+//
+// Fusion assumes that every instance key in a bucket's range executes on
+// every rank in every step; a bucket whose members only partially execute
+// stalls until the collective timeout aborts the step.  For this reason
+// fusion is opt-in (see TF_COLLECTIVE_FUSION_NUM_INSTANCES in
+// CollectiveExecutorMgr).
+class CollectiveFusionManager {
+ public:
+  // Callback used to run one collective; mirrors the tail of
+  // BaseCollectiveExecutor::ExecuteAsync after feed/fetch resolution.
+  typedef std::function<void(OpKernelContext*, const CollectiveParams*,
+                             const string&, const Tensor*, Tensor*,
+                             StatusCallback)>
+      LaunchFn;
+
+  CollectiveFusionManager(int instances_per_buffer, LaunchFn launch);
+
+  // Fails any still-pending members with Cancelled.
+  ~CollectiveFusionManager();
+
+  // Returns true iff `col_params` describes a collective that may be fused:
+  // a dependency-free CPU reduction over a memcpy-able data type.
+  static bool IsEligible(const CollectiveParams* col_params);
+
+  // Queues one bucket member.  When the member's bucket is complete its
+  // fused collectives are launched and `done` is invoked once the member's
+  // slice has been scattered back into `output`.
+  void EnqueueAsync(OpKernelContext* ctx, const CollectiveParams* col_params,
+                    const string& exec_key, const Tensor* input,
+                    Tensor* output, StatusCallback done);
+
+  // Fails all pending members with `s` and rejects future members.
+  void Abort(const Status& s);
+
+ private:
+  struct Member {
+    OpKernelContext* ctx = nullptr;
+    const CollectiveParams* col_params = nullptr;
+    string exec_key;
+    const Tensor* input = nullptr;
+    Tensor* output = nullptr;
+    StatusCallback done;
+  };
+  // Bucket members keyed (and therefore ordered) by instance key.
+  typedef std::map<int32, Member> Bucket;
+
+  void LaunchBucket(Bucket bucket);
+  void LaunchPartition(std::vector<Member> members);
+
+  const int instances_per_buffer_;
+  const LaunchFn launch_;
+  mutex mu_;
+  Status status_ TF_GUARDED_BY(mu_);
+  std::map<int64_t, Bucket> buckets_ TF_GUARDED_BY(mu_);
+};
+
 // Default implementation of CollectiveExecutor.  Delegates the actual
 // work of moving data to a class specialized for the operation type,
 // arguments and device+interconnect topology.
@@ -98,12 +167,24 @@ class BaseCollectiveExecutor : public CollectiveExecutor {
   BaseCollectiveExecutor(CollectiveExecutorMgrInterface* cem,
                          CollectiveRemoteAccess* remote_access, int64_t step_id,
                          const DeviceMgr* dev_mgr,
-                         std::shared_ptr<UnboundedWorkQueue> work_queue)
+                         std::shared_ptr<UnboundedWorkQueue> work_queue,
+                         int fusion_instances_per_buffer = 0)
       : CollectiveExecutor(cem),
         step_id_(step_id),
         dev_mgr_(dev_mgr),
         remote_access_(remote_access),
-        work_queue_(std::move(work_queue)) {}
+        work_queue_(std::move(work_queue)) {
+    if (fusion_instances_per_buffer > 1) {
+      fusion_manager_ = std::make_unique<CollectiveFusionManager>(
+          fusion_instances_per_buffer,
+          [this](OpKernelContext* ctx, const CollectiveParams* col_params,
+                 const string& exec_key, const Tensor* input, Tensor* output,
+                 StatusCallback done) {
+            LaunchCollective(ctx, col_params, exec_key, input, output,
+                             std::move(done));
+          });
+    }
+  }
 
   ~BaseCollectiveExecutor() override;
 
@@ -141,6 +222,8 @@ class BaseCollectiveExecutor : public CollectiveExecutor {
   // Ownership of `work_queue_` is shared between `this` and
   // `CollectiveExecutorMgr`.
   std::shared_ptr<UnboundedWorkQueue> work_queue_;
+  // Non-null iff fusion of small reduction collectives is enabled.
+  std::unique_ptr<CollectiveFusionManager> fusion_manager_;
   mutex launch_mu_;
   condition_variable launch_cv_;
   // collective instance key -> number of local devices for which NCCL ops have
@@ -150,6 +233,12 @@ class BaseCollectiveExecutor : public CollectiveExecutor {
   Status status_ TF_GUARDED_BY(status_mu_);
 
  private:
+  // Runs one collective on the given feed/fetch tensors; the tail of
+  // ExecuteAsync shared with the fusion path.
+  void LaunchCollective(OpKernelContext* ctx,
+                        const CollectiveParams* col_params,
+                        const string& exec_key, const Tensor* input,
+                        Tensor* output, StatusCallback done_safe);
   Status CreateCollective(const CollectiveParams& col_params,
                           CollectiveImplementationInterface** col_impl);
   // Check if all ops on which this collective depends on have launched.
@@ -23,6 +23,7 @@ limitations under the License.
 #include "tensorflow/core/common_runtime/device_resolver_local.h"
 #include "tensorflow/core/framework/collective.h"
 #include "tensorflow/core/protobuf/config.pb.h"
+#include "tensorflow/core/util/env_var.h"
 
 namespace tensorflow {
 
@@ -38,7 +39,20 @@ CollectiveExecutorMgr::CollectiveExecutorMgr(
           config.gpu_options().experimental().collective_ring_order()),
       nccl_communicator_(std::move(nccl_communicator)),
       work_queue_(std::make_shared<UnboundedWorkQueue>(Env::Default(),
-                                                       "collective_ops")) {}
+                                                       "collective_ops")) {
+  int64_t fusion_instances = 0;
+  Status status = ReadInt64FromEnvVar("TF_COLLECTIVE_FUSION_NUM_INSTANCES", 0,
+                                      &fusion_instances);
+  if (!status.ok()) {
+    LOG(ERROR) << "Invalid TF_COLLECTIVE_FUSION_NUM_INSTANCES: " << status;
+  } else if (fusion_instances < 0) {
+    LOG(ERROR) << "Invalid TF_COLLECTIVE_FUSION_NUM_INSTANCES: must be >= 0, "
+                  "got "
+               << fusion_instances;
+  } else {
+    fusion_instances_per_buffer_ = fusion_instances;
+  }
+}
 
 CollectiveExecutorMgr::~CollectiveExecutorMgr() {
   for (auto iter : executor_table_) {
@@ -65,7 +79,8 @@ CollectiveExecutor* CollectiveExecutorMgr::FindOrCreate(int64_t step_id) {
 CollectiveExecutor* CollectiveExecutorMgr::Create(int64_t step_id) {
   CollectiveRemoteAccessLocal* rma =
       new CollectiveRemoteAccessLocal(dev_mgr_, dev_resolver_.get(), step_id);
-  return new BaseCollectiveExecutor(this, rma, step_id, dev_mgr_, work_queue_);
+  return new BaseCollectiveExecutor(this, rma, step_id, dev_mgr_, work_queue_,
+                                    fusion_instances_per_buffer_);
 }
 
 void CollectiveExecutorMgr::Cleanup(int64_t step_id) {
@@ -71,6 +71,10 @@ class CollectiveExecutorMgr : public CollectiveExecutorMgrInterface {
   std::unique_ptr<ParamResolverInterface> param_resolver_;
   string gpu_ring_order_;
   std::unique_ptr<NcclCommunicatorInterface> nccl_communicator_;
+  // If > 1, executors fuse eligible small reduction collectives into
+  // buckets of this many consecutive instance keys. Configured via
+  // TF_COLLECTIVE_FUSION_NUM_INSTANCES; see CollectiveFusionManager.
+  int fusion_instances_per_buffer_ = 0;
   // Unbounded work queue for scheduling potentially-blocking work during
   // collective op execution.  Ownership is shared between `this` and
   // `CollectiveRemoteAccessLocal`.
@@ -14,17 +14,25 @@ limitations under the License.
 ==============================================================================*/
 #include "tensorflow/core/common_runtime/collective_executor_mgr.h"
 
+#include "tensorflow/core/common_runtime/base_collective_executor.h"
 #include "tensorflow/core/common_runtime/collective_param_resolver_local.h"
 #include "tensorflow/core/common_runtime/device.h"
 #include "tensorflow/core/common_runtime/device_factory.h"
 #include "tensorflow/core/common_runtime/device_mgr.h"
 #include "tensorflow/core/common_runtime/device_resolver_local.h"
+#include "tensorflow/core/framework/node_def.pb.h"
+#include "tensorflow/core/framework/op_kernel.h"
+#include "tensorflow/core/framework/tensor_testutil.h"
+#include "tensorflow/core/lib/core/errors.h"
 #include "tensorflow/core/lib/core/notification.h"
 #include "tensorflow/core/lib/core/status.h"
 #include "tensorflow/core/lib/core/status_test_util.h"
 #include "tensorflow/core/nccl/collective_communicator.h"
+#include "tensorflow/core/lib/strings/strcat.h"
+#include "tensorflow/core/platform/refcount.h"
 #include "tensorflow/core/platform/test.h"
 #include "tensorflow/core/public/session_options.h"
+#include "tensorflow/core/public/version.h"
 
 namespace tensorflow {
 namespace {
@@ -106,5 +114,168 @@ TEST_F(CollectiveExecutorMgrTest, StepSequenceRelated) {
             "CollectiveExecutorMgr does not implement GetStepSequence.");
 }
 
+class CollectiveFusionManagerTest : public ::testing::Test {
+ protected:
+  CollectiveFusionManagerTest() {
+    SessionOptions options;
+    device_ = DeviceFactory::NewDevice("CPU", options,
+                                       "/job:localhost/replica:0/task:0");
+    NodeDef noop_def;
+    noop_def.set_name("fusion_test_noop");
+    noop_def.set_op("NoOp");
+    Status status;
+    kernel_ = CreateOpKernel(DEVICE_CPU, device_.get(),
+                             device_->GetAllocator(AllocatorAttributes()),
+                             noop_def, TF_GRAPH_DEF_VERSION, &status);
+    TF_CHECK_OK(status);
+    params_.device = device_.get();
+    params_.op_kernel = kernel_.get();
+    ctx_ = std::make_unique<OpKernelContext>(&params_, /*num_outputs=*/0);
+  }
+
+  // Returns eligible reduction params owned by the caller.
+  CollectiveParams* MakeReductionParams(int32_t instance_key,
+                                        DataType dtype) {
+    auto* cp = new CollectiveParams();
+    cp->name = strings::StrCat("reduce_", instance_key);
+    cp->group.group_key = 1;
+    cp->group.group_size = 2;
+    cp->instance.type = REDUCTION_COLLECTIVE;
+    cp->instance.instance_key = instance_key;
+    cp->instance.data_type = dtype;
+    cp->instance.impl_details.collective_name = "RingReduce";
+    return cp;
+  }
+
+  std::unique_ptr<Device> device_;
+  std::unique_ptr<OpKernel> kernel_;
+  OpKernelContext::Params params_;
+  std::unique_ptr<OpKernelContext> ctx_;
+};
+
+TEST_F(CollectiveFusionManagerTest, IsEligible) {
+  core::RefCountPtr<CollectiveParams> reduction(
+      MakeReductionParams(0, DT_FLOAT));
+  EXPECT_TRUE(CollectiveFusionManager::IsEligible(reduction.get()));
+
+  core::RefCountPtr<CollectiveParams> broadcast(
+      MakeReductionParams(1, DT_FLOAT));
+  broadcast->instance.type = BROADCAST_COLLECTIVE;
+  EXPECT_FALSE(CollectiveFusionManager::IsEligible(broadcast.get()));
+
+  core::RefCountPtr<CollectiveParams> ordered(MakeReductionParams(2, DT_FLOAT));
+  ordered->instance.impl_details.dependencies.push_back(1);
+  EXPECT_FALSE(CollectiveFusionManager::IsEligible(ordered.get()));
+
+  core::RefCountPtr<CollectiveParams> gpu(MakeReductionParams(3, DT_FLOAT));
+  gpu->group.device_type = DeviceType(DEVICE_GPU);
+  EXPECT_FALSE(CollectiveFusionManager::IsEligible(gpu.get()));
+}
+
+TEST_F(CollectiveFusionManagerTest, FusesCompleteBucket) {
+  int launch_count = 0;
+  string fused_name;
+  int64_t fused_elements = 0;
+  CollectiveFusionManager mgr(
+      /*instances_per_buffer=*/2,
+      [&](OpKernelContext* ctx, const CollectiveParams* col_params,
+          const string& exec_key, const Tensor* input, Tensor* output,
+          StatusCallback done) {
+        ++launch_count;
+        fused_name = col_params->name;
+        fused_elements = input->NumElements();
+        EXPECT_EQ(input, output);
+        EXPECT_EQ(TensorShape({fused_elements}), col_params->instance.shape);
+        // Stand in for the reduction by doubling the buffer in place.
+        auto flat = output->flat<float>();
+        for (int64_t i = 0; i < flat.size(); ++i) flat(i) *= 2.0f;
+        done(OkStatus());
+      });
+
+  core::RefCountPtr<CollectiveParams> cp0(MakeReductionParams(0, DT_FLOAT));
+  core::RefCountPtr<CollectiveParams> cp1(MakeReductionParams(1, DT_FLOAT));
+  Tensor in0(DT_FLOAT, TensorShape({2}));
+  test::FillValues<float>(&in0, {1, 2});
+  Tensor in1(DT_FLOAT, TensorShape({1}));
+  test::FillValues<float>(&in1, {3});
+  Tensor out0(DT_FLOAT, TensorShape({2}));
+  Tensor out1(DT_FLOAT, TensorShape({1}));
+
+  int done_count = 0;
+  auto count_done = [&done_count](const Status& s) {
+    TF_EXPECT_OK(s);
+    ++done_count;
+  };
+  mgr.EnqueueAsync(ctx_.get(), cp0.get(), "key0", &in0, &out0, count_done);
+  EXPECT_EQ(0, launch_count);
+  mgr.EnqueueAsync(ctx_.get(), cp1.get(), "key1", &in1, &out1, count_done);
+
+  EXPECT_EQ(1, launch_count);
+  EXPECT_EQ("reduce_0/fused", fused_name);
+  EXPECT_EQ(3, fused_elements);
+  EXPECT_EQ(2, done_count);
+  test::ExpectTensorEqual<float>(out0, test::AsTensor<float>({2, 4}));
+  test::ExpectTensorEqual<float>(out1, test::AsTensor<float>({6}));
+}
+
+TEST_F(CollectiveFusionManagerTest, PartitionsByDataType) {
+  std::vector<string> launched;
+  CollectiveFusionManager mgr(
+      /*instances_per_buffer=*/2,
+      [&](OpKernelContext* ctx, const CollectiveParams* col_params,
+          const string& exec_key, const Tensor* input, Tensor* output,
+          StatusCallback done) {
+        launched.push_back(col_params->name);
+        done(OkStatus());
+      });
+
+  core::RefCountPtr<CollectiveParams> cp0(MakeReductionParams(0, DT_FLOAT));
+  core::RefCountPtr<CollectiveParams> cp1(MakeReductionParams(1, DT_INT32));
+  Tensor in0(DT_FLOAT, TensorShape({2}));
+  Tensor in1(DT_INT32, TensorShape({2}));
+  Tensor out0(DT_FLOAT, TensorShape({2}));
+  Tensor out1(DT_INT32, TensorShape({2}));
+
+  int done_count = 0;
+  auto count_done = [&done_count](const Status& s) {
+    TF_EXPECT_OK(s);
+    ++done_count;
+  };
+  mgr.EnqueueAsync(ctx_.get(), cp0.get(), "key0", &in0, &out0, count_done);
+  mgr.EnqueueAsync(ctx_.get(), cp1.get(), "key1", &in1, &out1, count_done);
+
+  // Mixed data types cannot share a fusion buffer; each member runs as its
+  // own collective with its original params.
+  ASSERT_EQ(2, launched.size());
+  EXPECT_EQ("reduce_0", launched[0]);
+  EXPECT_EQ("reduce_1", launched[1]);
+  EXPECT_EQ(2, done_count);
+}
+
+TEST_F(CollectiveFusionManagerTest, AbortFailsPendingMembers) {
+  CollectiveFusionManager mgr(
+      /*instances_per_buffer=*/2,
+      [](OpKernelContext* ctx, const CollectiveParams* col_params,
+         const string& exec_key, const Tensor* input, Tensor* output,
+         StatusCallback done) { done(OkStatus()); });
+
+  core::RefCountPtr<CollectiveParams> cp0(MakeReductionParams(0, DT_FLOAT));
+  Tensor in0(DT_FLOAT, TensorShape({2}));
+  Tensor out0(DT_FLOAT, TensorShape({2}));
+
+  Status pending_status;
+  mgr.EnqueueAsync(ctx_.get(), cp0.get(), "key0", &in0, &out0,
+                   [&pending_status](const Status& s) { pending_status = s; });
+  mgr.Abort(errors::Cancelled("test abort"));
+  EXPECT_TRUE(errors::IsCancelled(pending_status));
+
+  // Members enqueued after an abort fail immediately.
+  core::RefCountPtr<CollectiveParams> cp1(MakeReductionParams(1, DT_FLOAT));
+  Status late_status;
+  mgr.EnqueueAsync(ctx_.get(), cp1.get(), "key1", &in0, &out0,
+                   [&late_status](const Status& s) { late_status = s; });
+  EXPECT_TRUE(errors::IsCancelled(late_status));
+}
+
 }  // namespace
 }  // namespace tensorflow
@@ -68,7 +68,17 @@ const char* GetCollectiveName(const CollectiveParams* cp, bool nccl) {
       return nccl ? "NcclBroadcast" : "HierarchicalTreeBroadcast";
 
     case REDUCTION_COLLECTIVE:
-      return nccl ? "NcclReduce" : "RingReduce";
+      if (nccl) return "NcclReduce";
+      // When the group spans several tasks with several devices each, reduce
+      // within each task before crossing the slower inter-task links instead
+      // of running a flat ring over all devices.  `communication_hint="ring"`
+      // forces the flat ring.
+      if (cp->group.num_tasks > 1 &&
+          cp->group.group_size > cp->group.num_tasks &&
+          cp->instance.impl_details.communication_hint != "ring") {
+        return "HierarchicalTreeReduce";
+      }
+      return "RingReduce";
 
     case GATHER_COLLECTIVE:
       return nccl ? "NcclGather" : "RingGather";
@@ -652,6 +662,12 @@ void CollectiveParamResolverLocal::CompleteParamsAsync(
     CancellationManager* cancel_mgr, const StatusCallback& done) {
   VLOG(1) << "CompleteParams local " << device.name() << " for " << cp << ": "
           << cp->ToString();
+  if (TryCompleteParamsFromCache(device.name(), cp)) {
+    VLOG(1) << "CompleteParams served from cache for " << device.name()
+            << " instance " << cp->instance.instance_key;
+    done(OkStatus());
+    return;
+  }
   if (cp->run_group_initialization) {
     CompleteGroupLocal(device, &cp->group, cancel_mgr,
                        [this, device, cp, done](const Status& s) {
@@ -786,8 +802,60 @@ void CollectiveParamResolverLocal::CompleteInstanceFromInitializedIRec(
       done(s);
     });
   } else {
-    done(col_impl->InitializeCollectiveParams(cp));
+    status = col_impl->InitializeCollectiveParams(cp);
+    if (status.ok()) {
+      AddParamsToCache(device, cp);
+    }
+    done(status);
+  }
+}
+
+namespace {
+string ParamsCacheKey(int32_t group_key, int32_t instance_key,
+                      const string& device) {
+  return strings::StrCat(group_key, ";", instance_key, ";", device);
+}
+}  // namespace
+
+bool CollectiveParamResolverLocal::TryCompleteParamsFromCache(
+    const string& device, CollectiveParams* cp) {
+  const string key =
+      ParamsCacheKey(cp->group.group_key, cp->instance.instance_key, device);
+  tf_shared_lock l(params_cache_mu_);
+  auto it = params_cache_.find(key);
+  if (it == params_cache_.end()) {
+    return false;
+  }
+  const ResolvedParams& resolved = it->second;
+  if (resolved.instance.data_type != cp->instance.data_type ||
+      resolved.instance.shape != cp->instance.shape) {
+    // Fall through to full resolution, which reports mismatches against the
+    // rest of the group.
+    return false;
+  }
+  const int64_t step_id = cp->instance.step_id;
+  cp->group = resolved.group;
+  cp->instance = resolved.instance;
+  cp->instance.step_id = step_id;
+  cp->default_rank = resolved.default_rank;
+  return true;
+}
+
+void CollectiveParamResolverLocal::AddParamsToCache(
+    const string& device, const CollectiveParams* cp) {
+  if (cp->instance.type == BROADCAST_COLLECTIVE) {
+    // Broadcasts rediscover their source rank through the group on every
+    // execution and cannot be served from a cache.
+    return;
   }
+  ResolvedParams resolved;
+  resolved.group = cp->group;
+  resolved.instance = cp->instance;
+  resolved.default_rank = cp->default_rank;
+  const string key =
+      ParamsCacheKey(cp->group.group_key, cp->instance.instance_key, device);
+  mutex_lock l(params_cache_mu_);
+  params_cache_[key] = std::move(resolved);
 }
 
 void CollectiveParamResolverLocal::WaitForGroup(InstanceRec* ir,
@@ -895,6 +963,10 @@ void CollectiveParamResolverLocal::StartAbortLocal(const Status& s) {
       done(ir);
     }
   }
+  {
+    mutex_lock l(params_cache_mu_);
+    params_cache_.clear();
+  }
 }
 
 }  // namespace tensorflow
@@ -186,6 +186,27 @@ class CollectiveParamResolverLocal : public ParamResolverInterface {
   void StartAbortLocal(const Status& s)
       TF_LOCKS_EXCLUDED(status_mu_, group_mu_, instance_mu_);
 
+  // Fully-resolved params for one device of a non-broadcast instance.
+  // InstanceRecs are keyed by step_id, so without this cache every step of a
+  // high-frequency collective repeats group and instance resolution; a cached
+  // entry stays valid across steps as long as group membership is unchanged.
+  struct ResolvedParams {
+    CollGroupParams group;
+    CollInstanceParams instance;
+    int default_rank;
+  };
+
+  // If a cache entry exists for cp's group/instance keys on this device with
+  // matching dtype and shape, populates *cp from it and returns true.
+  // Reads take only a shared lock, so concurrent lookups do not serialize.
+  bool TryCompleteParamsFromCache(const string& device, CollectiveParams* cp)
+      TF_LOCKS_EXCLUDED(params_cache_mu_);
+
+  // Caches fully-resolved *cp.  No-op for broadcasts, which must rediscover
+  // their source rank through the group on every execution.
+  void AddParamsToCache(const string& device, const CollectiveParams* cp)
+      TF_LOCKS_EXCLUDED(params_cache_mu_);
+
   const bool nccl_;
   const DeviceMgr* dev_mgr_;
   DeviceResolverInterface* dev_resolver_;  // Not owned.
@@ -208,6 +229,11 @@ class CollectiveParamResolverLocal : public ParamResolverInterface {
       instance_table_ TF_GUARDED_BY(instance_mu_);
   mutex status_mu_;
   Status status_ TF_GUARDED_BY(status_mu_);
+  // Keyed by "<group_key>;<instance_key>;<device>".  Cleared on abort, which
+  // is also how group membership changes surface to this resolver.
+  mutable mutex params_cache_mu_;
+  gtl::FlatMap<string, ResolvedParams> params_cache_
+      TF_GUARDED_BY(params_cache_mu_);
 };
 
 }  // namespace tensorflow
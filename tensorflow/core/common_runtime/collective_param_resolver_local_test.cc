@@ -208,6 +208,53 @@ TEST_F(CollectiveParamResolverLocalTest, CompleteParamsReduction1Task) {
   }
 }
 
+TEST_F(CollectiveParamResolverLocalTest, CompleteParamsCachedAcrossSteps) {
+  // Resolve a reduction instance once for every device, then resolve again
+  // with a new step_id.  The second resolution is served from the resolved
+  // params cache (InstanceRecs are per-step) and must produce the same
+  // parameters.
+  for (int step_id = 0; step_id < 2; ++step_id) {
+    CollectiveParams* cps[NUM_DEVS];
+    Status statuses[NUM_DEVS];
+    Notification note[NUM_DEVS];
+    for (int i = 0; i < NUM_DEVS; ++i) {
+      cps[i] = new CollectiveParams();
+      CollectiveParams* cp = cps[i];
+      cp->group.group_key = 1;
+      cp->group.group_size = 3;
+      cp->group.device_type = DeviceType("CPU");
+      cp->group.num_tasks = 1;
+      cp->instance.step_id = step_id;
+      cp->instance.instance_key = 7;
+      cp->instance.type = REDUCTION_COLLECTIVE;
+      cp->instance.data_type = DataType(DT_FLOAT);
+      cp->instance.shape = TensorShape({5});
+      cp->instance.impl_details.subdiv_offsets.push_back(0);
+      cp->is_source = false;
+      Env::Default()->SchedClosure([this, i, cp, &note, &statuses]() {
+        string device =
+            strings::StrCat("/job:localhost/replica:0/task:0/device:CPU:", i);
+        prl_->CompleteParamsAsync(GetDeviceAttributes(device), cp,
+                                  nullptr /*CancellationManager*/,
+                                  [&statuses, &note, i](const Status& s) {
+                                    statuses[i] = s;
+                                    note[i].Notify();
+                                  });
+      });
+    }
+    for (int i = 0; i < NUM_DEVS; ++i) {
+      note[i].WaitForNotification();
+    }
+    for (int i = 0; i < NUM_DEVS; ++i) {
+      TF_ASSERT_OK(statuses[i]);
+      ASSERT_EQ(cps[i]->group.members.size(), 3);
+      EXPECT_EQ(cps[i]->default_rank, i);
+      EXPECT_EQ(cps[i]->instance.step_id, step_id);
+      cps[i]->Unref();
+    }
+  }
+}
+
 void InitializeCollectiveParamsForBroadcast(int instance_key, int device_idx,
                                             bool is_source,
                                             CollectiveParams* cp) {
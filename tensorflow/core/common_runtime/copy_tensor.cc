@@ -196,6 +196,65 @@ void CopyDeviceToDevice(CopyTensor::CopyFunction copy_function,
   }
 }
 
+// Chunk size for pipelined host staging of device-to-device copies between
+// device pairs without a direct copy function.
+constexpr int64_t kDeviceToDeviceStagingChunkBytes = 16 << 20;  // 16 MiB
+
+// Stages a device-to-device copy through host memory in chunks, instead of
+// staging the full tensor at once. The device-to-host copy of chunk i+1
+// overlaps the host-to-device copy of chunk i (copies on each device's stream
+// are issued back to back), so for large tensors the transfer approaches the
+// slower of the two link bandwidths rather than their sum of latencies.
+// `output` must already be allocated to the full shape; the caller must have
+// excluded DT_VARIANT and DT_RESOURCE tensors.
+void CopyDeviceToDeviceViaChunkedHostStaging(
+    Allocator* cpu_allocator, StringPiece edge_name,
+    DeviceContext* send_dev_context, DeviceContext* recv_dev_context,
+    Device* src, Device* dst, const Tensor* input, Tensor* output,
+    bool sync_dst_compute, StatusCallback done) {
+  const int64_t rows = input->dim_size(0);
+  const int64_t row_bytes = input->TotalBytes() / rows;
+  const int64_t rows_per_chunk =
+      std::max<int64_t>(1, kDeviceToDeviceStagingChunkBytes / row_bytes);
+
+  auto* status_cb = new ReffedStatusCallback(std::move(done));
+  core::ScopedUnref status_cb_unref(status_cb);
+  for (int64_t r = 0; r < rows; r += rows_per_chunk) {
+    const int64_t limit = std::min(rows, r + rows_per_chunk);
+    // The chunk tensors are heap-allocated so they stay alive (and keep the
+    // underlying buffers referenced) until their copies complete.
+    auto* src_chunk = new Tensor(input->Slice(r, limit));
+    auto* dst_chunk = new Tensor(output->Slice(r, limit));
+    auto* cpu_chunk =
+        new Tensor(cpu_allocator, src_chunk->dtype(), src_chunk->shape());
+    status_cb->Ref();
+    auto copy_chunk_to_dst = [recv_dev_context, dst, src_chunk, dst_chunk,
+                              cpu_chunk, sync_dst_compute,
+                              status_cb](const Status& s) {
+      delete src_chunk;
+      if (!s.ok() || !status_cb->ok()) {
+        delete cpu_chunk;
+        delete dst_chunk;
+        status_cb->UpdateStatus(s);
+        status_cb->Unref();
+        return;
+      }
+      recv_dev_context->CopyCPUTensorToDevice(
+          cpu_chunk, dst, dst_chunk,
+          [cpu_chunk, dst_chunk, status_cb](const Status& s) {
+            delete cpu_chunk;
+            delete dst_chunk;
+            status_cb->UpdateStatus(s);
+            status_cb->Unref();
+          },
+          sync_dst_compute);
+    };
+    send_dev_context->CopyDeviceTensorToCPU(src_chunk, edge_name, src,
+                                            cpu_chunk,
+                                            std::move(copy_chunk_to_dst));
+  }
+}
+
 }  // namespace
 
 // static
@@ -252,6 +311,19 @@ void CopyTensor::ViaDMA(StringPiece edge_name, DeviceContext* send_dev_context,
             << dst_device_type.type()
             << ". Falling back to copying via the host.";
 
+    if (input->dtype() != DT_VARIANT && input->dtype() != DT_RESOURCE &&
+        DMAHelper::CanUseDMA(input) && input->dims() > 0 &&
+        input->TotalBytes() > 2 * kDeviceToDeviceStagingChunkBytes) {
+      // Large dense tensors are staged through the host in chunks so the two
+      // legs of the copy overlap instead of running back to back over the
+      // full tensor.
+      *output = Tensor(out_allocator, input->dtype(), input->shape());
+      CopyDeviceToDeviceViaChunkedHostStaging(
+          cpu_allocator, edge_name, send_dev_context, recv_dev_context, src,
+          dst, input, output, sync_dst_compute, std::move(done));
+      return;
+    }
+
     Tensor* cpu_tensor =
         new Tensor(cpu_allocator, input->dtype(), input->shape());
     auto delete_and_done = [cpu_tensor,
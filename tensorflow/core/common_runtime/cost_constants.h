@@ -21,6 +21,7 @@ namespace tensorflow {
 // Types of per-request cost.
 inline constexpr char kTpuCostName[] = "tpu";
 inline constexpr char kGcuCostName[] = "gcu";
+inline constexpr char kCpuCostName[] = "cpu";
 inline constexpr char kNoOpCostName[] = "no_op";
 
 // Each type of per-request cost could have the following versions.
@@ -0,0 +1,77 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/common_runtime/cpu_cost_measurement.h"
+
+#include <ctime>
+#include <memory>
+#include <utility>
+
+#include "absl/strings/string_view.h"
+#include "absl/time/time.h"
+#include "tensorflow/core/common_runtime/cost_constants.h"
+#include "tensorflow/core/common_runtime/cost_measurement_registry.h"
+
+namespace tensorflow {
+
+namespace {
+
+// The accumulator of the innermost CpuCostMeasurement alive on this thread.
+thread_local std::shared_ptr<std::atomic<int64_t>> current_accumulator;
+
+}  // namespace
+
+CpuCostMeasurement::CpuCostMeasurement(const Context& context)
+    : CostMeasurement(context),
+      accumulated_ns_(std::make_shared<std::atomic<int64_t>>(0)),
+      previous_(std::move(current_accumulator)) {
+  current_accumulator = accumulated_ns_;
+}
+
+CpuCostMeasurement::~CpuCostMeasurement() {
+  // The measurement may be destroyed on a different thread than it was
+  // created on (e.g. batching runs cleanup on an inter-op thread). Only
+  // restore the slot this measurement actually occupies; a foreign thread's
+  // slot belongs to someone else.
+  if (current_accumulator == accumulated_ns_) {
+    current_accumulator = std::move(previous_);
+  }
+}
+
+absl::Duration CpuCostMeasurement::GetTotalCost() {
+  return absl::Nanoseconds(accumulated_ns_->load(std::memory_order_relaxed));
+}
+
+absl::string_view CpuCostMeasurement::GetCostType() const {
+  return kCpuCostName;
+}
+
+std::shared_ptr<std::atomic<int64_t>> CpuCostMeasurement::CurrentAccumulator() {
+  return current_accumulator;
+}
+
+int64_t CpuCostMeasurement::ThreadCpuTimeNanos() {
+#if defined(CLOCK_THREAD_CPUTIME_ID)
+  struct timespec ts;
+  if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0) {
+    return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+  }
+#endif
+  return -1;
+}
+
+REGISTER_COST_MEASUREMENT(kCpuCostName, CpuCostMeasurement);
+
+}  // namespace tensorflow
@@ -0,0 +1,65 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_COMMON_RUNTIME_CPU_COST_MEASUREMENT_H_
+#define TENSORFLOW_CORE_COMMON_RUNTIME_CPU_COST_MEASUREMENT_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include "absl/strings/string_view.h"
+#include "absl/time/time.h"
+#include "tensorflow/core/common_runtime/cost_measurement.h"
+
+namespace tensorflow {
+
+// Measures the kernel CPU time consumed on behalf of a request.
+//
+// While a CpuCostMeasurement is alive, it installs an accumulator in a
+// thread-local slot. When an executor step is launched from that thread, the
+// executor captures the accumulator and charges the thread-CPU time spent in
+// each kernel invocation to it, regardless of which worker thread the kernel
+// ends up running on. GetTotalCost() reports the total charged so far.
+//
+// Only kernel compute time is counted; executor bookkeeping, and platforms
+// without a per-thread CPU clock, contribute zero.
+class CpuCostMeasurement : public CostMeasurement {
+ public:
+  explicit CpuCostMeasurement(const Context& context);
+  ~CpuCostMeasurement() override;
+
+  absl::Duration GetTotalCost() override;
+  absl::string_view GetCostType() const override;
+
+  // Returns the accumulator installed by the CpuCostMeasurement active on the
+  // calling thread, or nullptr if there is none. Called by the executor when
+  // a step is launched.
+  static std::shared_ptr<std::atomic<int64_t>> CurrentAccumulator();
+
+  // Returns the CPU time consumed by the calling thread in nanoseconds, or -1
+  // if no per-thread CPU clock is available on this platform.
+  static int64_t ThreadCpuTimeNanos();
+
+ private:
+  std::shared_ptr<std::atomic<int64_t>> accumulated_ns_;
+  // The accumulator that was installed when this measurement was created;
+  // restored on destruction so that measurements may nest.
+  std::shared_ptr<std::atomic<int64_t>> previous_;
+};
+
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_COMMON_RUNTIME_CPU_COST_MEASUREMENT_H_
@@ -0,0 +1,57 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/common_runtime/cpu_cost_measurement.h"
+
+#include "tensorflow/core/common_runtime/cost_measurement.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace {
+
+TEST(CpuCostMeasurementTest, Basic) {
+  CostMeasurement::Context context;
+  CpuCostMeasurement measurement(context);
+  EXPECT_EQ(measurement.GetCostType(), "cpu");
+  EXPECT_EQ(measurement.GetTotalCost(), absl::ZeroDuration());
+}
+
+TEST(CpuCostMeasurementTest, AccumulatorInstalledWhileAlive) {
+  EXPECT_EQ(CpuCostMeasurement::CurrentAccumulator(), nullptr);
+  CostMeasurement::Context context;
+  {
+    CpuCostMeasurement measurement(context);
+    auto accumulator = CpuCostMeasurement::CurrentAccumulator();
+    ASSERT_NE(accumulator, nullptr);
+    // Simulates the executor charging kernel CPU time to the request.
+    accumulator->fetch_add(42);
+    EXPECT_EQ(measurement.GetTotalCost(), absl::Nanoseconds(42));
+  }
+  EXPECT_EQ(CpuCostMeasurement::CurrentAccumulator(), nullptr);
+}
+
+TEST(CpuCostMeasurementTest, MeasurementsNest) {
+  CostMeasurement::Context context;
+  CpuCostMeasurement outer(context);
+  auto outer_accumulator = CpuCostMeasurement::CurrentAccumulator();
+  {
+    CpuCostMeasurement inner(context);
+    EXPECT_NE(CpuCostMeasurement::CurrentAccumulator(), outer_accumulator);
+  }
+  EXPECT_EQ(CpuCostMeasurement::CurrentAccumulator(), outer_accumulator);
+}
+
+}  // namespace
+}  // namespace tensorflow
@@ -33,6 +33,16 @@ namespace {
 //  - Should EventMgrs be shared between devices on a machine with multiple
 //  devices of the same type?
 static const int kNumThreads = 2;
+
+// Busy polling is only worthwhile while the workload is completing events
+// quickly: events that spent more than this long in the queue indicate
+// compute-bound work where interval polling is cheaper.
+static const uint64 kBusyPollMaxCompletionAgeUsecs = 1000;
+
+// If no event completed within this window, treat the manager as lightly
+// loaded (or stuck behind a long-running kernel) and fall back to interval
+// polling until completions pick up again.
+static const uint64 kBusyPollRecencyWindowUsecs = 10 * 1000;
 }  // namespace
 
 namespace device_event_mgr {
@@ -100,6 +110,8 @@ EventMgr::EventMgr(se::StreamExecutor* se, const GPUOptions& gpu_options)
       polling_active_delay_usecs_(gpu_options.polling_active_delay_usecs()
                                       ? gpu_options.polling_active_delay_usecs()
                                       : 10),
+      busy_polling_enabled_(
+          gpu_options.experimental().use_event_mgr_busy_polling()),
       threadpool_(Env::Default(), "Device_Event_Manager", kNumThreads) {
   device_event_mgr::InitThreadpoolLabels(&threadpool_);
   StartPollingLoop();
@@ -109,8 +121,8 @@ EventMgr::~EventMgr() {
   StopPollingLoop();
 
   for (auto& [stream, stream_callbacks] : callbacks_) {
-    for (auto& [event, callback] : stream_callbacks) {
-      threadpool_.Schedule(std::move(callback));
+    for (auto& in_use_event : stream_callbacks) {
+      threadpool_.Schedule(std::move(in_use_event.callback));
     }
   }
   // The threadpool's destructor will block waiting for all outstanding
@@ -142,10 +154,14 @@ void EventMgr::StopPollingLoop() {
 // A polling loop to detect completion of device events.
 //
 // While one or more events is outstanding, poll for completed events.  When no
-// events are outstanding, we sleep until one is enqueued.
+// events are outstanding, we sleep until one is enqueued.  With busy polling
+// enabled, the loop spins instead of sleeping between polls while recent
+// events have been completing quickly, which takes the polling interval out of
+// the latency of callback execution and deferred deallocation.
 void EventMgr::PollLoop() {
   while (true) {
     bool events_still_pending;
+    bool busy_poll = false;
     {
       mutex_lock l(mu_);
       if (stop_polling_) {
@@ -156,15 +172,29 @@ void EventMgr::PollLoop() {
       }
       PollEvents(/*stream=*/nullptr);  // poll all streams
       events_still_pending = !callbacks_.empty();
+      if (busy_polling_enabled_ && events_still_pending) {
+        busy_poll = ShouldBusyPoll();
+      }
     }
 
-    if (events_still_pending) {
+    if (events_still_pending && !busy_poll) {
       Env::Default()->SleepForMicroseconds(polling_active_delay_usecs_);
     }
   }
   polling_stopped_->Notify();
 }
 
+bool EventMgr::ShouldBusyPoll() const {
+  // Busy-poll only while the workload looks latency-bound: the most recently
+  // completed event spent under a millisecond in the queue, and that
+  // observation is recent enough to still be representative of the events
+  // currently in flight.
+  if (last_completion_time_usecs_ == 0) return false;
+  const uint64 now_usecs = Env::Default()->NowMicros();
+  return last_completion_age_usecs_ < kBusyPollMaxCompletionAgeUsecs &&
+         now_usecs - last_completion_time_usecs_ < kBusyPollRecencyWindowUsecs;
+}
+
 void EventMgr::EnqueueCallback(se::Stream* stream, std::function<void()> func) {
   VLOG(2) << "EnqueueCallback with one or more callbacks pending on "
           << callbacks_.size() << " streams and " << free_events_.size()
@@ -181,7 +211,8 @@ void EventMgr::EnqueueCallback(se::Stream* stream, std::function<void()> func) {
   stream->ThenRecordEvent(e.get());
 
   bool was_empty = callbacks_.empty();
-  callbacks_[stream].push_back({std::move(e), std::move(func)});
+  callbacks_[stream].push_back(
+      {std::move(e), std::move(func), Env::Default()->NowMicros()});
 
   // Wake up the polling thread if it was sleeping.
   if (was_empty) {
@@ -211,7 +242,7 @@ void EventMgr::PollEvents(se::Stream* stream /*=nullptr*/) {
 
         auto it = stream_callbacks.begin();
         while (it != stream_callbacks.end()) {
-          auto& [event, callback] = *it;
+          auto& [event, callback, enqueue_time_usecs] = *it;
 
           se::Event::Status s = event->PollForStatus();
           bool keep_looping = true;
@@ -228,6 +259,9 @@ void EventMgr::PollEvents(se::Stream* stream /*=nullptr*/) {
               keep_looping = false;
               break;
             case se::Event::Status::kComplete:
+              last_completion_time_usecs_ = Env::Default()->NowMicros();
+              last_completion_age_usecs_ =
+                  last_completion_time_usecs_ - enqueue_time_usecs;
               free_events_.push_back(std::move(event));
               threadpool_.Schedule(std::move(callback));
               // std::deque::erase() does invalidate iterators, so we can't
@@ -80,6 +80,7 @@ class EventMgr {
 
   se::StreamExecutor* const exec_;
   const int32 polling_active_delay_usecs_;
+  const bool busy_polling_enabled_;
   mutex mu_;
   condition_variable events_pending_ TF_GUARDED_BY(mu_);
 
@@ -106,14 +107,29 @@ class EventMgr {
   void StartPollingLoop();
   void StopPollingLoop();
 
+  // Returns true if the polling loop should busy-poll instead of sleeping
+  // between polls.  Requires that busy polling was enabled via GPUOptions.
+  bool ShouldBusyPoll() const TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
   // A stack of unused events
   std::vector<std::unique_ptr<se::Event>> free_events_ TF_GUARDED_BY(mu_);
 
+  // A pending callback together with the event that will fire it.
+  struct InUseEvent {
+    std::unique_ptr<se::Event> event;
+    std::function<void()> callback;
+    // When the event was recorded, used by the busy-polling heuristic.
+    uint64 enqueue_time_usecs;
+  };
+
   // Callbacks waiting on their events to complete.
-  absl::flat_hash_map<
-      se::Stream*,
-      std::deque<std::pair<std::unique_ptr<se::Event>, std::function<void()>>>>
-      callbacks_ TF_GUARDED_BY(mu_);
+  absl::flat_hash_map<se::Stream*, std::deque<InUseEvent>> callbacks_
+      TF_GUARDED_BY(mu_);
+
+  // Completion observations driving the busy-polling heuristic: when the most
+  // recently completed event was retired, and how long it spent in the queue.
+  uint64 last_completion_time_usecs_ TF_GUARDED_BY(mu_) = 0;
+  uint64 last_completion_age_usecs_ TF_GUARDED_BY(mu_) = 0;
 
   bool stop_polling_ TF_GUARDED_BY(mu_);
   std::unique_ptr<Notification> polling_stopped_;
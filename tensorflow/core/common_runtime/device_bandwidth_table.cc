@@ -0,0 +1,68 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/common_runtime/device_bandwidth_table.h"
+
+namespace tensorflow {
+namespace {
+
+// Defaults for unmeasured pairs, roughly a PCIe gen3 x16 link.
+constexpr double kDefaultBandwidthGbps = 8.0;
+constexpr double kDefaultLatencyUs = 10.0;
+
+}  // namespace
+
+/* static */ DeviceBandwidthTable* DeviceBandwidthTable::Global() {
+  static DeviceBandwidthTable* table = new DeviceBandwidthTable;
+  return table;
+}
+
+void DeviceBandwidthTable::Record(const string& src_device,
+                                  const string& dst_device,
+                                  double bandwidth_gbps, double latency_us) {
+  mutex_lock l(mu_);
+  links_[{src_device, dst_device}] = {bandwidth_gbps, latency_us};
+}
+
+bool DeviceBandwidthTable::Lookup(const string& src_device,
+                                  const string& dst_device,
+                                  LinkMetrics* metrics) const {
+  mutex_lock l(mu_);
+  auto it = links_.find({src_device, dst_device});
+  if (it == links_.end()) return false;
+  *metrics = it->second;
+  return true;
+}
+
+double DeviceBandwidthTable::TransferCostEstimate(const string& src_device,
+                                                  const string& dst_device,
+                                                  int64_t bytes) const {
+  if (src_device == dst_device) return 0.0;
+  LinkMetrics metrics{kDefaultBandwidthGbps, kDefaultLatencyUs};
+  Lookup(src_device, dst_device, &metrics);
+  if (metrics.bandwidth_gbps <= 0.0) {
+    metrics.bandwidth_gbps = kDefaultBandwidthGbps;
+  }
+  // bytes / (GB/s) in microseconds.
+  return metrics.latency_us +
+         static_cast<double>(bytes) / (metrics.bandwidth_gbps * 1000.0);
+}
+
+bool DeviceBandwidthTable::empty() const {
+  mutex_lock l(mu_);
+  return links_.empty();
+}
+
+}  // namespace tensorflow
@@ -0,0 +1,68 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_COMMON_RUNTIME_DEVICE_BANDWIDTH_TABLE_H_
+#define TENSORFLOW_CORE_COMMON_RUNTIME_DEVICE_BANDWIDTH_TABLE_H_
+
+#include <string>
+#include <utility>
+
+#include "absl/container/flat_hash_map.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/thread_annotations.h"
+#include "tensorflow/core/platform/types.h"
+
+namespace tensorflow {
+
+// A process-wide table of measured (or topology-derived) device-to-device
+// link characteristics, keyed by fully-qualified device name pairs. Device
+// factories populate it once at device initialization; the placer consults it
+// to estimate the cost of cross-device edges.
+class DeviceBandwidthTable {
+ public:
+  struct LinkMetrics {
+    double bandwidth_gbps = 0.0;
+    double latency_us = 0.0;
+  };
+
+  static DeviceBandwidthTable* Global();
+
+  // Records the characteristics of the directed link from `src_device` to
+  // `dst_device`. Later calls for the same pair overwrite earlier ones.
+  void Record(const string& src_device, const string& dst_device,
+              double bandwidth_gbps, double latency_us);
+
+  // Returns true and fills `metrics` if the pair has been recorded.
+  bool Lookup(const string& src_device, const string& dst_device,
+              LinkMetrics* metrics) const;
+
+  // Estimated cost, in microseconds, of transferring `bytes` from
+  // `src_device` to `dst_device`. Transfers within a device are free;
+  // unrecorded pairs are costed with conservative PCIe-like defaults so that
+  // cross-device edges are never treated as free.
+  double TransferCostEstimate(const string& src_device,
+                              const string& dst_device, int64_t bytes) const;
+
+  bool empty() const;
+
+ private:
+  mutable mutex mu_;
+  absl::flat_hash_map<std::pair<string, string>, LinkMetrics> links_
+      TF_GUARDED_BY(mu_);
+};
+
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_COMMON_RUNTIME_DEVICE_BANDWIDTH_TABLE_H_
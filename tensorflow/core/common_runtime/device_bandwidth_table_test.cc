@@ -0,0 +1,67 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/common_runtime/device_bandwidth_table.h"
+
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace {
+
+constexpr char kGpu0[] = "/job:localhost/replica:0/task:0/device:GPU:0";
+constexpr char kGpu1[] = "/job:localhost/replica:0/task:0/device:GPU:1";
+constexpr char kGpu2[] = "/job:localhost/replica:0/task:0/device:GPU:2";
+
+TEST(DeviceBandwidthTableTest, RecordAndLookup) {
+  DeviceBandwidthTable table;
+  DeviceBandwidthTable::LinkMetrics metrics;
+  EXPECT_FALSE(table.Lookup(kGpu0, kGpu1, &metrics));
+
+  table.Record(kGpu0, kGpu1, /*bandwidth_gbps=*/80.0, /*latency_us=*/2.0);
+  ASSERT_TRUE(table.Lookup(kGpu0, kGpu1, &metrics));
+  EXPECT_EQ(metrics.bandwidth_gbps, 80.0);
+  EXPECT_EQ(metrics.latency_us, 2.0);
+
+  // Links are directed; the reverse pair is not implied.
+  EXPECT_FALSE(table.Lookup(kGpu1, kGpu0, &metrics));
+}
+
+TEST(DeviceBandwidthTableTest, TransferCostEstimate) {
+  DeviceBandwidthTable table;
+  table.Record(kGpu0, kGpu1, /*bandwidth_gbps=*/80.0, /*latency_us=*/2.0);
+
+  // Same device is free.
+  EXPECT_EQ(table.TransferCostEstimate(kGpu0, kGpu0, 1 << 20), 0.0);
+
+  // 1 MB at 80 GB/s plus 2us of latency.
+  const double cost = table.TransferCostEstimate(kGpu0, kGpu1, 1 << 20);
+  EXPECT_NEAR(cost, 2.0 + (1 << 20) / (80.0 * 1000.0), 1e-6);
+
+  // Unrecorded pairs fall back to conservative defaults and are therefore
+  // more expensive than a measured fast link.
+  EXPECT_GT(table.TransferCostEstimate(kGpu0, kGpu2, 1 << 20), cost);
+}
+
+TEST(DeviceBandwidthTableTest, LaterRecordsOverwrite) {
+  DeviceBandwidthTable table;
+  table.Record(kGpu0, kGpu1, 10.0, 10.0);
+  table.Record(kGpu0, kGpu1, 80.0, 2.0);
+  DeviceBandwidthTable::LinkMetrics metrics;
+  ASSERT_TRUE(table.Lookup(kGpu0, kGpu1, &metrics));
+  EXPECT_EQ(metrics.bandwidth_gbps, 80.0);
+}
+
+}  // namespace
+}  // namespace tensorflow
@@ -17,6 +17,7 @@ limitations under the License.
 
 #include <algorithm>
 #include <atomic>
+#include <cstring>
 #include <string>
 #include <vector>
 
@@ -40,7 +41,10 @@ limitations under the License.
 #include "tensorflow/core/common_runtime/process_util.h"
 #include "tensorflow/core/common_runtime/rendezvous_mgr.h"
 #include "tensorflow/core/common_runtime/scoped_allocator_mgr.h"
+#include "tensorflow/core/common_runtime/step_arena_allocator.h"
 #include "tensorflow/core/common_runtime/step_stats_collector.h"
+#include "tensorflow/core/framework/allocation_description.pb.h"
+#include "tensorflow/core/framework/allocator.h"
 #include "tensorflow/core/framework/function.h"
 #include "tensorflow/core/framework/graph.pb.h"
 #include "tensorflow/core/framework/graph_def_util.h"
@@ -400,7 +404,7 @@ DirectSession::~DirectSession() {
     it.second.reset(nullptr);
   }
   for (auto& it : executors_) {
-    it.second.reset();
+    it.second.executors_and_keys.reset();
   }
   callables_.clear();
   for (auto d : device_mgr_->ListDevices()) {
@@ -677,6 +681,17 @@ Status DirectSession::RunInternal(
   args.sync_on_finish = sync_on_finish_;
   args.user_intra_op_threadpool = threadpool_options.intra_op_threadpool;
   args.run_all_kernels_inline = pool == nullptr;
+  args.use_work_stealing =
+      options_.config.experimental().use_work_stealing_executor();
+  // If requested, serve small CPU allocations for this step from an arena
+  // that is released wholesale when the step (and any tensors that escaped
+  // it) are done. The arena is reference counted: this RefCountPtr holds the
+  // step's reference, and each live arena allocation holds one more.
+  core::RefCountPtr<StepArenaAllocator> small_tensor_arena;
+  if (options_.config.experimental().use_per_step_arena_allocator()) {
+    small_tensor_arena.reset(new StepArenaAllocator(cpu_allocator()));
+    args.small_tensor_arena = small_tensor_arena.get();
+  }
   args.start_time_usecs = start_time_usecs;
   args.deadline = deadline;
 
@@ -743,6 +758,7 @@ Status DirectSession::RunInternal(
 
   if (can_execute_synchronously) {
     PrivateIntraProcessRendezvous rendezvous(device_mgr_.get());
+    rendezvous.ReserveKeys(executors_and_keys->rendezvous_key_count);
     args.rendezvous = &rendezvous;
 
     const auto& item = executors_and_keys->items[0];
@@ -751,6 +767,7 @@ Status DirectSession::RunInternal(
   } else {
     core::RefCountPtr<RefCountedIntraProcessRendezvous> rendezvous(
         new RefCountedIntraProcessRendezvous(device_mgr_.get()));
+    rendezvous->ReserveKeys(executors_and_keys->rendezvous_key_count);
     args.rendezvous = rendezvous.get();
 
     // `barrier` will delete itself after the final executor finishes.
@@ -879,32 +896,35 @@ Status DirectSession::Run(const RunOptions& run_options,
 
   // Check if we already have an executor for these arguments.
   ExecutorsAndKeys* executors_and_keys;
+  const RunCallPlan* run_plan = nullptr;
   RunStateArgs run_state_args(run_options.debug_options());
   run_state_args.collective_graph_key =
       run_options.experimental().collective_graph_key();
 
   TF_RETURN_IF_ERROR(GetOrCreateExecutors(input_tensor_names, output_names,
                                           target_nodes, &executors_and_keys,
-                                          &run_state_args));
+                                          &run_state_args, &run_plan));
   {
     mutex_lock l(collective_graph_key_lock_);
     collective_graph_key_ = executors_and_keys->collective_graph_key;
   }
 
   // Configure a call frame for the step, which we use to feed and
-  // fetch values to and from the executors.
+  // fetch values to and from the executors. The cached plan maps the
+  // caller's feed order to call-frame slots.
   FunctionCallFrame call_frame(executors_and_keys->input_types,
                                executors_and_keys->output_types);
   gtl::InlinedVector<Tensor, 4> feed_args(inputs.size());
+  size_t feed_index = 0;
   for (const auto& it : inputs) {
+    const size_t slot = run_plan->feed_slots[feed_index++];
     if (it.second.dtype() == DT_RESOURCE) {
       Tensor tensor_from_handle;
       TF_RETURN_IF_ERROR(
           ResourceHandleToInputTensor(it.second, &tensor_from_handle));
-      feed_args[executors_and_keys->input_name_to_index[it.first]] =
-          tensor_from_handle;
+      feed_args[slot] = tensor_from_handle;
     } else {
-      feed_args[executors_and_keys->input_name_to_index[it.first]] = it.second;
+      feed_args[slot] = it.second;
     }
   }
   const Status s = call_frame.SetArgs(feed_args);
@@ -934,28 +954,18 @@ Status DirectSession::Run(const RunOptions& run_options,
     } else if (!s.ok()) {
       return s;
     }
-    const bool unique_outputs =
-        output_names.size() == executors_and_keys->output_name_to_index.size();
-    // first_indices[i] = j implies that j is the smallest value for which
+    // The cached plan maps the caller's fetch order to call-frame slots and
+    // precomputes the duplicate-fetch mapping: first_indices[i] = j implies
+    // that j is the smallest value for which
     // output_names[i] == output_names[j].
-    std::vector<int> first_indices;
-    if (!unique_outputs) {
-      first_indices.reserve(output_names.size());
-      for (const auto& name : output_names) {
-        first_indices.push_back(
-            std::find(output_names.begin(), output_names.end(), name) -
-            output_names.begin());
-      }
-    }
+    const std::vector<int>& first_indices = run_plan->first_indices;
     outputs->clear();
     size_t output_size = 0;
     outputs->reserve(sorted_outputs.size());
     for (int i = 0; i < output_names.size(); ++i) {
-      const string& output_name = output_names[i];
       if (first_indices.empty() || first_indices[i] == i) {
         outputs->emplace_back(
-            std::move(sorted_outputs[executors_and_keys
-                                         ->output_name_to_index[output_name]]));
+            std::move(sorted_outputs[run_plan->fetch_slots[i]]));
       } else {
         outputs->push_back((*outputs)[first_indices[i]]);
       }
@@ -967,6 +977,260 @@ Status DirectSession::Run(const RunOptions& run_options,
   return OkStatus();
 }
 
+namespace {
+
+// Wraps caller-owned memory as a TensorBuffer without taking ownership. The
+// optional `done` callback runs when the runtime drops its last reference to
+// the buffer.
+class BorrowedTensorBuffer : public TensorBuffer {
+ public:
+  BorrowedTensorBuffer(void* data, size_t len, std::function<void()> done)
+      : TensorBuffer(data), len_(len), done_(std::move(done)) {}
+
+  ~BorrowedTensorBuffer() override {
+    if (done_) {
+      done_();
+    }
+  }
+
+  size_t size() const override { return len_; }
+  TensorBuffer* root_buffer() override { return this; }
+  void FillAllocationDescription(AllocationDescription* proto) const override {
+    proto->set_requested_bytes(len_);
+    proto->set_allocator_name("borrowed");
+  }
+  bool OwnsMemory() const override { return false; }
+
+ private:
+  const size_t len_;
+  std::function<void()> done_;
+};
+
+}  // namespace
+
+// A call frame that copies each return value directly into a caller-owned
+// buffer as the corresponding `_Retval` kernel runs, instead of retaining the
+// fetched tensors until the step finishes.
+class DirectSession::BorrowedBufferCallFrame : public CallFrameInterface {
+ public:
+  // `ret_buffers` holds one destination per return-value slot; the pointed-to
+  // buffers must outlive the frame.
+  BorrowedBufferCallFrame(gtl::InlinedVector<Tensor, 4> args,
+                          const DataTypeVector& ret_types,
+                          std::vector<const BorrowedOutputBuffer*> ret_buffers)
+      : args_(std::move(args)),
+        ret_types_(ret_types),
+        ret_buffers_(std::move(ret_buffers)),
+        ret_shapes_(ret_buffers_.size()),
+        ret_set_(ret_buffers_.size(), false) {}
+
+  size_t num_args() const override { return args_.size(); }
+  size_t num_retvals() const override { return ret_types_.size(); }
+
+  Status GetArg(int index, const Tensor** val) override {
+    if (index < 0 || index >= static_cast<int>(args_.size())) {
+      return errors::Internal("Args index out of bounds: ", index);
+    }
+    *val = &args_[index];
+    return OkStatus();
+  }
+
+  Status SetRetval(int index, const Tensor& val) override {
+    if (index < 0 || index >= static_cast<int>(ret_buffers_.size())) {
+      return errors::Internal("RetVal index out of bounds: ", index);
+    }
+    if (val.dtype() != ret_types_[index]) {
+      return errors::InvalidArgument("Expected type ",
+                                     DataTypeString(ret_types_[index]),
+                                     " for return value ", index, " but got ",
+                                     DataTypeString(val.dtype()));
+    }
+    if (!DataTypeCanUseMemcpy(val.dtype())) {
+      return errors::InvalidArgument(
+          "Cannot fetch a tensor of type ", DataTypeString(val.dtype()),
+          " into a borrowed output buffer");
+    }
+    const BorrowedOutputBuffer* buffer = ret_buffers_[index];
+    const StringPiece src = val.tensor_data();
+    if (src.size() > buffer->capacity) {
+      return errors::InvalidArgument(
+          "Fetched tensor of ", src.size(), " bytes does not fit in the ",
+          buffer->capacity, "-byte borrowed output buffer for return value ",
+          index);
+    }
+    mutex_lock l(mu_);
+    if (ret_set_[index]) {
+      return errors::Internal("Retval[", index, "] has already been set.");
+    }
+    if (!src.empty()) {
+      memcpy(buffer->data, src.data(), src.size());
+    }
+    ret_shapes_[index] = val.shape();
+    ret_set_[index] = true;
+    return OkStatus();
+  }
+
+  // Returns the shape written to the `index`-th output buffer. Only valid
+  // after the step has finished.
+  Status GetRetvalShape(int index, TensorShape* shape) {
+    mutex_lock l(mu_);
+    if (!ret_set_[index]) {
+      return errors::Internal("Retval[", index, "] does not have value");
+    }
+    *shape = ret_shapes_[index];
+    return OkStatus();
+  }
+
+ private:
+  const gtl::InlinedVector<Tensor, 4> args_;
+  const DataTypeVector ret_types_;
+  // Destination buffers per return-value slot. Not owned.
+  const std::vector<const BorrowedOutputBuffer*> ret_buffers_;
+  mutex mu_;
+  std::vector<TensorShape> ret_shapes_ TF_GUARDED_BY(mu_);
+  std::vector<bool> ret_set_ TF_GUARDED_BY(mu_);
+};
+
+/* static */ Status DirectSession::MakeTensorFromBorrowedBuffer(
+    DataType dtype, const TensorShape& shape, void* data, size_t num_bytes,
+    std::function<void()> done, Tensor* out) {
+  if (!DataTypeCanUseMemcpy(dtype)) {
+    return errors::InvalidArgument(
+        "Cannot borrow a buffer for a tensor of type ", DataTypeString(dtype));
+  }
+  if (data == nullptr && num_bytes > 0) {
+    return errors::InvalidArgument(
+        "Borrowed buffer must be non-null when num_bytes > 0");
+  }
+  if (reinterpret_cast<intptr_t>(data) % Allocator::kAllocatorAlignment != 0) {
+    return errors::InvalidArgument("Borrowed buffer must be aligned to ",
+                                   Allocator::kAllocatorAlignment, " bytes");
+  }
+  const size_t expected_bytes = shape.num_elements() * DataTypeSize(dtype);
+  if (num_bytes != expected_bytes) {
+    return errors::InvalidArgument(
+        "Borrowed buffer of ", num_bytes, " bytes does not match a ",
+        DataTypeString(dtype), " tensor of shape ", shape.DebugString(), " (",
+        expected_bytes, " bytes)");
+  }
+  core::RefCountPtr<BorrowedTensorBuffer> buffer(
+      new BorrowedTensorBuffer(data, num_bytes, std::move(done)));
+  // The Tensor constructor acquires its own reference on the buffer.
+  *out = Tensor(dtype, shape, buffer.get());
+  return OkStatus();
+}
+
+Status DirectSession::RunWithBorrowedBuffers(
+    const RunOptions& run_options, const NamedTensorList& inputs,
+    const std::vector<string>& output_names,
+    const std::vector<string>& target_nodes,
+    const std::vector<BorrowedOutputBuffer>& output_buffers,
+    std::vector<TensorShape>* output_shapes, RunMetadata* run_metadata) {
+  TF_RETURN_IF_ERROR(CheckNotClosed());
+  TF_RETURN_IF_ERROR(CheckGraphCreated("RunWithBorrowedBuffers()"));
+  direct_session_runs->GetCell()->IncrementBy(1);
+
+  if (output_buffers.size() != output_names.size()) {
+    return errors::InvalidArgument("Expected ", output_names.size(),
+                                   " output buffers, but got ",
+                                   output_buffers.size());
+  }
+
+  // Extract the inputs names for this run of the session.
+  std::vector<string> input_tensor_names;
+  input_tensor_names.reserve(inputs.size());
+  size_t input_size = 0;
+  for (const auto& it : inputs) {
+    input_tensor_names.push_back(it.first);
+    input_size += it.second.AllocatedBytes();
+  }
+  metrics::RecordGraphInputTensors(input_size);
+
+  // Check if we already have an executor for these arguments.
+  ExecutorsAndKeys* executors_and_keys;
+  const RunCallPlan* run_plan = nullptr;
+  RunStateArgs run_state_args(run_options.debug_options());
+  run_state_args.collective_graph_key =
+      run_options.experimental().collective_graph_key();
+
+  TF_RETURN_IF_ERROR(GetOrCreateExecutors(input_tensor_names, output_names,
+                                          target_nodes, &executors_and_keys,
+                                          &run_state_args, &run_plan));
+  {
+    mutex_lock l(collective_graph_key_lock_);
+    collective_graph_key_ = executors_and_keys->collective_graph_key;
+  }
+
+  // With duplicate fetch names, several caller buffers would alias one
+  // call-frame slot; callers that need duplicates can pass the name once.
+  if (!run_plan->first_indices.empty()) {
+    return errors::InvalidArgument(
+        "RunWithBorrowedBuffers() does not support duplicate fetch names");
+  }
+
+  // Configure a call frame that reads feeds in place and copies each fetch
+  // directly into the caller's buffer for its slot.
+  gtl::InlinedVector<Tensor, 4> feed_args(inputs.size());
+  size_t feed_index = 0;
+  for (const auto& it : inputs) {
+    const size_t slot = run_plan->feed_slots[feed_index++];
+    if (it.second.dtype() == DT_RESOURCE) {
+      Tensor tensor_from_handle;
+      TF_RETURN_IF_ERROR(
+          ResourceHandleToInputTensor(it.second, &tensor_from_handle));
+      feed_args[slot] = std::move(tensor_from_handle);
+    } else {
+      feed_args[slot] = it.second;
+    }
+    if (feed_args[slot].dtype() != executors_and_keys->input_types[slot]) {
+      return errors::InvalidArgument(
+          "Expected tensor of type ",
+          DataTypeString(executors_and_keys->input_types[slot]), " for feed ",
+          it.first, " but got ", DataTypeString(feed_args[slot].dtype()));
+    }
+  }
+
+  std::vector<const BorrowedOutputBuffer*> ret_buffers(
+      executors_and_keys->output_types.size(), nullptr);
+  for (int i = 0; i < output_names.size(); ++i) {
+    ret_buffers[run_plan->fetch_slots[i]] = &output_buffers[i];
+  }
+  BorrowedBufferCallFrame call_frame(std::move(feed_args),
+                                     executors_and_keys->output_types,
+                                     std::move(ret_buffers));
+
+  const int64_t step_id = step_id_counter_.fetch_add(1);
+
+  if (LogMemory::IsEnabled()) {
+    LogMemory::RecordStep(step_id, run_state_args.handle);
+  }
+
+  TF_RETURN_IF_ERROR(RunInternal(step_id, run_options, &call_frame,
+                                 executors_and_keys, run_metadata,
+                                 thread::ThreadPoolOptions()));
+
+  // The fetched contents were already written into the caller's buffers by
+  // the call frame; report the shapes in the caller's fetch order.
+  size_t output_size = 0;
+  if (output_shapes != nullptr) {
+    output_shapes->clear();
+    output_shapes->resize(output_names.size());
+  }
+  for (int i = 0; i < output_names.size(); ++i) {
+    const size_t slot = run_plan->fetch_slots[i];
+    TensorShape shape;
+    TF_RETURN_IF_ERROR(call_frame.GetRetvalShape(slot, &shape));
+    output_size += shape.num_elements() *
+                   DataTypeSize(executors_and_keys->output_types[slot]);
+    if (output_shapes != nullptr) {
+      (*output_shapes)[i] = std::move(shape);
+    }
+  }
+  metrics::RecordGraphOutputTensors(output_size);
+
+  return OkStatus();
+}
+
 Status DirectSession::PRunSetup(const std::vector<string>& input_names,
                                 const std::vector<string>& output_names,
                                 const std::vector<string>& target_nodes,
@@ -1062,7 +1326,7 @@ Status DirectSession::PRun(const string& handle, const NamedTensorList& inputs,
       return errors::InvalidArgument(
           "Must run 'setup' before performing partial runs!");
     }
-    executors_and_keys = exc_it->second.get();
+    executors_and_keys = exc_it->second.executors_and_keys.get();
 
     auto prun_it = partial_runs_.find(handle);
     if (prun_it == partial_runs_.end()) {
@@ -1384,6 +1648,8 @@ Status DirectSession::CreateExecutors(
       }}));
 
   GraphOptimizer optimizer(optimizer_opts);
+  int total_sends = 0;
+  int total_recvs = 0;
   for (auto iter = graphs.begin(); iter != graphs.end(); ++iter) {
     const string& partition_name = iter->first;
     std::unique_ptr<Graph>& partition_graph = iter->second;
@@ -1443,6 +1709,16 @@ Status DirectSession::CreateExecutors(
                                          device->name(),
                                          partition_graph.get()));
 
+    // Count the Send/Recv nodes the partitioner inserted so each step's
+    // rendezvous key tables can be pre-sized.
+    for (const Node* n : partition_graph->nodes()) {
+      if (n->IsSend()) {
+        ++total_sends;
+      } else if (n->IsRecv()) {
+        ++total_recvs;
+      }
+    }
+
     item->executor = nullptr;
     item->device = device;
     auto executor_type = options_.config.experimental().executor_type();
@@ -1454,6 +1730,10 @@ Status DirectSession::CreateExecutors(
     }
   }
 
+  // A matched Send/Recv pair shares one rendezvous key, so the number of
+  // distinct keys is bounded by the larger of the two counts.
+  ek->rendezvous_key_count = std::max(total_sends, total_recvs);
+
   // Cache the mapping from input/output names to graph elements to
   // avoid recomputing it every time.
   if (!run_state_args->is_partial_run) {
@@ -1492,10 +1772,43 @@ Status DirectSession::CreateExecutors(
   return OkStatus();
 }
 
+Status DirectSession::InitializeRunCallPlan(gtl::ArraySlice<string> inputs,
+                                            gtl::ArraySlice<string> outputs,
+                                            RunCallPlan* plan) {
+  const ExecutorsAndKeys* ek = plan->executors_and_keys.get();
+  plan->feed_slots.reserve(inputs.size());
+  for (const string& input : inputs) {
+    auto it = ek->input_name_to_index.find(input);
+    if (it == ek->input_name_to_index.end()) {
+      return errors::Internal("Feed '", input,
+                              "' missing from executor cache entry.");
+    }
+    plan->feed_slots.push_back(it->second);
+  }
+  plan->fetch_slots.reserve(outputs.size());
+  for (const string& output : outputs) {
+    auto it = ek->output_name_to_index.find(output);
+    if (it == ek->output_name_to_index.end()) {
+      return errors::Internal("Fetch '", output,
+                              "' missing from executor cache entry.");
+    }
+    plan->fetch_slots.push_back(it->second);
+  }
+  // Precompute the duplicate-fetch mapping unless all fetch names are unique.
+  if (outputs.size() != ek->output_name_to_index.size()) {
+    plan->first_indices.reserve(outputs.size());
+    for (const string& name : outputs) {
+      plan->first_indices.push_back(
+          std::find(outputs.begin(), outputs.end(), name) - outputs.begin());
+    }
+  }
+  return OkStatus();
+}
+
 Status DirectSession::GetOrCreateExecutors(
     gtl::ArraySlice<string> inputs, gtl::ArraySlice<string> outputs,
     gtl::ArraySlice<string> target_nodes, ExecutorsAndKeys** executors_and_keys,
-    RunStateArgs* run_state_args) {
+    RunStateArgs* run_state_args, const RunCallPlan** run_plan) {
   int64_t handle_name_counter_value = -1;
   if (LogMemory::IsEnabled() || run_state_args->is_partial_run) {
     handle_name_counter_value = handle_name_counter_.fetch_add(1);
@@ -1523,7 +1836,8 @@ Status DirectSession::GetOrCreateExecutors(
     mutex_lock l(executor_lock_);  // could use reader lock
     auto it = executors_.find(key);
     if (it != executors_.end()) {
-      *executors_and_keys = it->second.get();
+      *executors_and_keys = it->second.executors_and_keys.get();
+      if (run_plan != nullptr) *run_plan = &it->second;
       return OkStatus();
     }
   }
@@ -1556,7 +1870,16 @@ Status DirectSession::GetOrCreateExecutors(
     mutex_lock l(executor_lock_);
     auto it = executors_.find(sorted_key);
     if (it != executors_.end()) {
-      *executors_and_keys = it->second.get();
+      // Cache an entry for the caller's ordering under the unsorted key so
+      // that subsequent calls with the same ordering hit the fast path with
+      // a ready-made plan.
+      RunCallPlan plan;
+      plan.executors_and_keys = it->second.executors_and_keys;
+      TF_RETURN_IF_ERROR(InitializeRunCallPlan(inputs, outputs, &plan));
+      auto insert_result = executors_.emplace(key, std::move(plan));
+      *executors_and_keys =
+          insert_result.first->second.executors_and_keys.get();
+      if (run_plan != nullptr) *run_plan = &insert_result.first->second;
       return OkStatus();
     }
   }
@@ -1592,16 +1915,26 @@ Status DirectSession::GetOrCreateExecutors(
 
   // Another thread may have created the entry before us, in which case we will
   // reuse the already created one.
-  auto insert_result = executors_.emplace(
-      sorted_key, std::shared_ptr<ExecutorsAndKeys>(std::move(ek)));
+  RunCallPlan sorted_plan;
+  sorted_plan.executors_and_keys = std::shared_ptr<ExecutorsAndKeys>(
+      std::move(ek));
+  TF_RETURN_IF_ERROR(
+      InitializeRunCallPlan(inputs_sorted, outputs_sorted, &sorted_plan));
+  auto insert_result = executors_.emplace(sorted_key, std::move(sorted_plan));
   if (insert_result.second) {
     functions_.push_back(std::move(func_info));
   }
 
-  // Insert the value under the original key, so the fast path lookup will work
-  // if the user uses the same order of inputs, outputs, and targets again.
-  executors_.emplace(key, insert_result.first->second);
-  *executors_and_keys = insert_result.first->second.get();
+  // Insert a plan for the caller's ordering under the original key, so the
+  // fast path lookup will work if the user uses the same order of inputs,
+  // outputs, and targets again.
+  RunCallPlan plan;
+  plan.executors_and_keys = insert_result.first->second.executors_and_keys;
+  TF_RETURN_IF_ERROR(InitializeRunCallPlan(inputs, outputs, &plan));
+  auto key_insert_result = executors_.emplace(key, std::move(plan));
+  *executors_and_keys =
+      key_insert_result.first->second.executors_and_keys.get();
+  if (run_plan != nullptr) *run_plan = &key_insert_result.first->second;
 
   return OkStatus();
 }
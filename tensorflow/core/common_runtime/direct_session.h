@@ -92,6 +92,44 @@ class DirectSession : public Session {
       RunMetadata* run_metadata,
       const thread::ThreadPoolOptions& threadpool_options) override;
 
+  // Describes a caller-owned destination buffer for a fetched tensor in
+  // `RunWithBorrowedBuffers()`. `data` must be aligned to
+  // `Allocator::kAllocatorAlignment` and remain valid until the call returns.
+  struct BorrowedOutputBuffer {
+    void* data = nullptr;
+    size_t capacity = 0;  // In bytes.
+  };
+
+  // Wraps `num_bytes` of caller-owned memory at `data` as a Tensor of the
+  // given type and shape without copying. `done` is invoked once the runtime
+  // drops its last reference to the buffer; the memory must remain valid and
+  // unmodified until then. `data` must be aligned to
+  // `Allocator::kAllocatorAlignment` and `num_bytes` must match the size
+  // implied by `dtype` and `shape`. Only memcpy-able dtypes are supported.
+  //
+  // NOTE: Experimental and subject to change.
+  static ::tensorflow::Status MakeTensorFromBorrowedBuffer(
+      DataType dtype, const TensorShape& shape, void* data, size_t num_bytes,
+      std::function<void()> done, Tensor* out);
+
+  // Like `Run()`, but writes the contents of each fetched tensor directly
+  // into the corresponding caller-provided buffer instead of returning
+  // Tensors, eliminating a copy when the caller already owns suitably sized
+  // destination memory. `output_buffers` must have one entry per name in
+  // `output_names` (duplicate fetch names are not supported), and
+  // `output_shapes`, if non-null, receives the shape written to each buffer.
+  // Fetched tensors must have memcpy-able dtypes and fit in the
+  // corresponding buffer's capacity. Feeds may be ordinary Tensors or
+  // Tensors created with `MakeTensorFromBorrowedBuffer()`.
+  //
+  // NOTE: Experimental and subject to change.
+  ::tensorflow::Status RunWithBorrowedBuffers(
+      const ::tensorflow::RunOptions& run_options,
+      const NamedTensorList& inputs, const std::vector<string>& output_names,
+      const std::vector<string>& target_nodes,
+      const std::vector<BorrowedOutputBuffer>& output_buffers,
+      std::vector<TensorShape>* output_shapes, RunMetadata* run_metadata);
+
   // NOTE: PRunSetup and PRun are added to support partial execution. This
   // feature is experimental and subject to change.
   ::tensorflow::Status PRunSetup(const std::vector<string>& input_names,
@@ -176,6 +214,34 @@ class DirectSession : public Session {
     CallableOptions callable_options;
 
     int64_t collective_graph_key = BuildGraphOptions::kNoCollectiveGraphKey;
+
+    // Upper bound on the number of distinct rendezvous keys in flight during
+    // a step, computed from the Send/Recv nodes in the partitioned graphs.
+    // Used to pre-size the per-step rendezvous key tables.
+    int rendezvous_key_count = 0;
+  };
+
+  // A fully-baked run plan for one feed/fetch cache key, i.e. one
+  // caller-supplied ordering of a feed/fetch signature. It shares the
+  // ExecutorsAndKeys with every other ordering of the same signature and
+  // additionally precomputes the mapping from the caller's feed and fetch
+  // order to call-frame slots, so steady-state Run() calls perform no
+  // name-to-index map lookups.
+  struct RunCallPlan {
+    std::shared_ptr<ExecutorsAndKeys> executors_and_keys;
+
+    // feed_slots[i] is the call-frame argument slot for the i-th feed in the
+    // caller's order.
+    std::vector<size_t> feed_slots;
+
+    // fetch_slots[i] is the call-frame return-value slot for the i-th fetch
+    // in the caller's order.
+    std::vector<size_t> fetch_slots;
+
+    // first_indices[i] = j implies that j is the smallest value for which
+    // the i-th fetch names the same tensor as the j-th fetch. Empty if all
+    // fetch names are unique.
+    std::vector<int> first_indices;
   };
 
   // A FunctionInfo object is created for every unique set of feeds/fetches.
@@ -239,11 +305,20 @@ class DirectSession : public Session {
   };
 
   // Retrieves an already existing set of executors to run 'inputs' and
-  // 'outputs', or creates and caches them for future use.
+  // 'outputs', or creates and caches them for future use. If 'run_plan' is
+  // non-null it receives the cached plan for the caller's feed/fetch
+  // ordering; the pointer stays valid until the executor cache is cleared.
   ::tensorflow::Status GetOrCreateExecutors(
       gtl::ArraySlice<string> inputs, gtl::ArraySlice<string> outputs,
       gtl::ArraySlice<string> target_nodes,
-      ExecutorsAndKeys** executors_and_keys, RunStateArgs* run_state_args);
+      ExecutorsAndKeys** executors_and_keys, RunStateArgs* run_state_args,
+      const RunCallPlan** run_plan = nullptr);
+
+  // Fills in the slot mappings of 'plan' (whose executors_and_keys must
+  // already be set) for the given feed and fetch ordering.
+  static ::tensorflow::Status InitializeRunCallPlan(
+      gtl::ArraySlice<string> inputs, gtl::ArraySlice<string> outputs,
+      RunCallPlan* plan);
 
   // Creates a set of executors to run the subgraph defined by
   // `callable_options`.
@@ -362,12 +437,14 @@ class DirectSession : public Session {
   // Holds mappings from signature to the executors that process
   // it. The reason for a level of indirection around mapped_type is
   // to guarantee address stability.
-  // The map value is a shared_ptr since multiple map keys can point to the
-  // same ExecutorsAndKey object.
-  std::unordered_map<string, std::shared_ptr<ExecutorsAndKeys>> executors_
+  // Each value holds a per-ordering RunCallPlan whose executors_and_keys is
+  // a shared_ptr since multiple map keys (orderings of one signature) point
+  // to the same ExecutorsAndKeys object.
+  std::unordered_map<string, RunCallPlan> executors_
       TF_GUARDED_BY(executor_lock_);
 
   class RunCallableCallFrame;
+  class BorrowedBufferCallFrame;
   struct Callable {
     std::shared_ptr<ExecutorsAndKeys> executors_and_keys;
     std::shared_ptr<FunctionInfo> function_info;
@@ -1067,6 +1067,99 @@ TEST(DirectSessionTest, FetchMultipleTimes) {
   }
 }
 
+TEST(DirectSessionTest, RunWithBorrowedBuffers) {
+  Graph g(OpRegistry::Global());
+  Tensor value(DT_FLOAT, TensorShape({4}));
+  test::FillValues<float>(&value, {1, 2, 3, 4});
+  Node* constant = test::graph::Constant(&g, value);
+  Node* identity = test::graph::Identity(&g, constant);
+
+  GraphDef def;
+  g.ToGraphDef(&def);
+
+  auto session = CreateSession();
+  ASSERT_TRUE(session != nullptr);
+  TF_ASSERT_OK(session->Create(def));
+  DirectSession* direct_session = static_cast<DirectSession*>(session.get());
+
+  alignas(Allocator::kAllocatorAlignment) float feed_data[4] = {10, 20, 30,
+                                                                40};
+  alignas(Allocator::kAllocatorAlignment) float fetch_data[4] = {0, 0, 0, 0};
+
+  bool feed_released = false;
+  {
+    Tensor feed;
+    TF_ASSERT_OK(DirectSession::MakeTensorFromBorrowedBuffer(
+        DT_FLOAT, TensorShape({4}), feed_data, sizeof(feed_data),
+        [&feed_released]() { feed_released = true; }, &feed));
+    // The feed wraps the caller's memory rather than copying it.
+    EXPECT_EQ(feed_data, feed.flat<float>().data());
+
+    std::vector<TensorShape> output_shapes;
+    TF_ASSERT_OK(direct_session->RunWithBorrowedBuffers(
+        RunOptions(), {{constant->name(), feed}},
+        {identity->name() + ":0"}, {},
+        {{fetch_data, sizeof(fetch_data)}}, &output_shapes,
+        nullptr /* run_metadata */));
+
+    ASSERT_EQ(1, output_shapes.size());
+    EXPECT_EQ(TensorShape({4}), output_shapes[0]);
+    for (int i = 0; i < 4; ++i) {
+      EXPECT_EQ(feed_data[i], fetch_data[i]) << i;
+    }
+    EXPECT_FALSE(feed_released);
+  }
+  // The last reference to the borrowed feed buffer is dropped once the feed
+  // Tensor and the step are gone.
+  EXPECT_TRUE(feed_released);
+}
+
+TEST(DirectSessionTest, RunWithBorrowedBuffersErrors) {
+  Graph g(OpRegistry::Global());
+  Tensor value(DT_FLOAT, TensorShape({4}));
+  test::FillValues<float>(&value, {1, 2, 3, 4});
+  Node* constant = test::graph::Constant(&g, value);
+  Node* identity = test::graph::Identity(&g, constant);
+
+  GraphDef def;
+  g.ToGraphDef(&def);
+
+  auto session = CreateSession();
+  ASSERT_TRUE(session != nullptr);
+  TF_ASSERT_OK(session->Create(def));
+  DirectSession* direct_session = static_cast<DirectSession*>(session.get());
+
+  alignas(Allocator::kAllocatorAlignment) float fetch_data[4];
+
+  // A misaligned or wrongly sized borrowed feed buffer is rejected.
+  Tensor feed;
+  Status s = DirectSession::MakeTensorFromBorrowedBuffer(
+      DT_FLOAT, TensorShape({3}), reinterpret_cast<char*>(fetch_data) + 1,
+      3 * sizeof(float), nullptr, &feed);
+  EXPECT_TRUE(errors::IsInvalidArgument(s));
+  EXPECT_TRUE(absl::StrContains(s.message(), "aligned"));
+  s = DirectSession::MakeTensorFromBorrowedBuffer(
+      DT_FLOAT, TensorShape({3}), fetch_data, sizeof(fetch_data), nullptr,
+      &feed);
+  EXPECT_TRUE(errors::IsInvalidArgument(s));
+  EXPECT_TRUE(absl::StrContains(s.message(), "does not match"));
+
+  // An undersized output buffer fails the step instead of overflowing.
+  s = direct_session->RunWithBorrowedBuffers(
+      RunOptions(), {}, {identity->name() + ":0"}, {},
+      {{fetch_data, 2 * sizeof(float)}}, nullptr, nullptr);
+  EXPECT_TRUE(errors::IsInvalidArgument(s));
+  EXPECT_TRUE(absl::StrContains(s.message(), "does not fit"));
+
+  // Duplicate fetch names would alias one output slot.
+  s = direct_session->RunWithBorrowedBuffers(
+      RunOptions(), {}, {identity->name() + ":0", identity->name() + ":0"}, {},
+      {{fetch_data, sizeof(fetch_data)}, {fetch_data, sizeof(fetch_data)}},
+      nullptr, nullptr);
+  EXPECT_TRUE(errors::IsInvalidArgument(s));
+  EXPECT_TRUE(absl::StrContains(s.message(), "duplicate fetch"));
+}
+
 TEST(DirectSessionTest, MultipleFeedTestSomeSyncRun) {
   GraphDef def;
   Graph g(OpRegistry::Global());
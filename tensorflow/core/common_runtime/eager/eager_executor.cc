@@ -32,6 +32,15 @@ bool IsAsyncWaitForRemoteFunctionEnabled() {
                                  true, &enabled));
   return enabled;
 }
+
+// Not cached so that tests (and clients) can toggle the environment variable
+// between executor constructions.
+bool IsPerDeviceQueuesEnabled() {
+  bool enabled = false;
+  TF_CHECK_OK(
+      ReadBoolFromEnvVar("TF_EAGER_PER_DEVICE_QUEUES", false, &enabled));
+  return enabled;
+}
 }  // namespace
 
 EagerExecutor::EagerExecutor(bool async, bool enable_streaming_enqueue,
@@ -46,7 +55,8 @@ EagerExecutor::EagerExecutor(bool async, bool enable_streaming_enqueue,
       enable_async_wait_for_remote_function_(
           IsAsyncWaitForRemoteFunctionEnabled()),
       enable_streaming_enqueue_(enable_streaming_enqueue),
-      in_flight_nodes_limit_(in_flight_nodes_limit) {
+      in_flight_nodes_limit_(in_flight_nodes_limit),
+      route_by_device_(async && IsPerDeviceQueuesEnabled()) {
   if (async && in_flight_nodes_limit_ > 0) {
     VLOG(4) << "EagerExecutor InFlightNodes limit is set to "
             << in_flight_nodes_limit_;
@@ -65,6 +75,15 @@ EagerExecutor::~EagerExecutor() {
 }
 
 Status EagerExecutor::ShutDown() {
+  // Shut down the per-device child executors first so that all of their
+  // nodes are drained before the main queue's final status is computed.
+  Status child_status;
+  if (route_by_device_) {
+    tf_shared_lock l(device_executors_mu_);
+    for (const auto& entry : device_executors_) {
+      child_status.Update(entry.second->ShutDown());
+    }
+  }
   {
     bool has_thread;
     Status status;
@@ -88,13 +107,16 @@ Status EagerExecutor::ShutDown() {
       }
     }
     if (!has_thread) {
+      status.Update(child_status);
       return status;
     }
   }
 
   thread_exited_notification_.WaitForNotification();
 
-  return status();
+  Status final_status = status();
+  final_status.Update(child_status);
+  return final_status;
 }
 
 const char* EagerExecutor::StateStringLocked() {
@@ -132,6 +154,17 @@ Status EagerExecutor::SyncExecute(EagerNode* node) {
 }
 
 Status EagerExecutor::AddOrExecute(std::unique_ptr<EagerNode> node) {
+  // Nodes bound to a known device run on that device's child executor, so
+  // ops targeting different devices proceed concurrently and only serialize
+  // behind nodes for the same device. Cross-device data dependencies are
+  // enforced by TensorHandle readiness, not by queue order.
+  if (route_by_device_) {
+    Device* device = node->device();
+    if (device != nullptr) {
+      return GetDeviceExecutor(device)->AddOrExecute(std::move(node));
+    }
+  }
+
   Status status;
   core::RefCountPtr<NodeItem> item(new NodeItem);
   item->id = next_node_id_++;
@@ -196,6 +229,16 @@ Status EagerExecutor::AddOrExecute(std::unique_ptr<EagerNode> node) {
 }
 
 tensorflow::Status EagerExecutor::WaitForAllPendingNodes() {
+  if (route_by_device_) {
+    Status status;
+    {
+      tf_shared_lock l(device_executors_mu_);
+      for (const auto& entry : device_executors_) {
+        status.Update(entry.second->WaitForAllPendingNodes());
+      }
+    }
+    if (!status.ok()) return status;
+  }
   tensorflow::mutex_lock l(node_queue_mutex_);
   return WaitForAllPendingNodesLocked(&l);
 }
@@ -218,6 +261,13 @@ tensorflow::Status EagerExecutor::WaitForAllPendingNodesLocked(
 }
 
 void EagerExecutor::ClearError() {
+  if (route_by_device_) {
+    tf_shared_lock l(device_executors_mu_);
+    for (const auto& entry : device_executors_) {
+      entry.second->ClearError();
+    }
+  }
+
   // TODO(iga): Check state_ and return an error if it is not kActive.
   if (ok()) return;
 
@@ -444,6 +494,30 @@ Status EagerExecutor::MoveToUnfinished(core::RefCountPtr<NodeItem> item,
   return OkStatus();
 }
 
+EagerExecutor* EagerExecutor::GetDeviceExecutor(Device* device) {
+  mutex_lock l(device_executors_mu_);
+  std::unique_ptr<EagerExecutor>& executor = device_executors_[device];
+  if (executor == nullptr) {
+    DVLOG(3) << "Create device executor for " << device->name();
+    executor = std::make_unique<EagerExecutor>(
+        /*async=*/true, enable_streaming_enqueue_, in_flight_nodes_limit_);
+    // Child executors must not route again, regardless of the environment
+    // variable.
+    executor->route_by_device_ = false;
+  }
+  return executor.get();
+}
+
+Status EagerExecutor::DeviceExecutorsStatus() const {
+  if (!route_by_device_) return OkStatus();
+  tf_shared_lock l(device_executors_mu_);
+  for (const auto& entry : device_executors_) {
+    Status status = entry.second->status();
+    if (!status.ok()) return status;
+  }
+  return OkStatus();
+}
+
 void EagerExecutor::AddCleanup(intptr_t key, std::function<void()> callback) {
   cleanups_[key].push_back(callback);
 }
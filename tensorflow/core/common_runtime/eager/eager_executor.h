@@ -79,6 +79,11 @@ class EagerNode {
 
   // Indicates whether a node failure should make the executor unusable.
   virtual bool Fatal() const { return true; }
+
+  // Returns the device this node is bound to, if known. Nodes that report a
+  // device may be routed to that device's queue when per-device queues are
+  // enabled (see EagerExecutor).
+  virtual Device* device() const { return nullptr; }
 };
 
 class AsyncEagerNode : public EagerNode {
@@ -152,7 +157,7 @@ class EagerExecutor {
 
   // Returns Status based on any errors that occurred during async execution.
   Status status() const {
-    if (ok()) return OkStatus();
+    if (ok()) return DeviceExecutorsStatus();
 
     tf_shared_lock l(node_queue_mutex_);
     return status_;
@@ -220,6 +225,14 @@ class EagerExecutor {
 
   Status WaitImpl(bool wait_all, uint64 node_id);
 
+  // Returns the child executor for `device`, creating it on first use. Only
+  // called when per-device queues are enabled.
+  EagerExecutor* GetDeviceExecutor(Device* device)
+      TF_LOCKS_EXCLUDED(device_executors_mu_);
+
+  // Returns the first non-OK status among the child executors, if any.
+  Status DeviceExecutorsStatus() const TF_LOCKS_EXCLUDED(device_executors_mu_);
+
   std::atomic<uint64> next_node_id_;
 
   mutable mutex node_queue_mutex_;
@@ -277,6 +290,20 @@ class EagerExecutor {
   // async nodes reach this number, enqueuing to the eager async queue is
   // blocked.
   const int64_t in_flight_nodes_limit_;
+
+  // When per-device queues are enabled (TF_EAGER_PER_DEVICE_QUEUES), nodes
+  // bound to a device run on a child executor dedicated to that device, so
+  // ops targeting different devices proceed concurrently. True data
+  // dependencies still synchronize through TensorHandle readiness: a node
+  // consuming an unready input blocks until its producer sets the handle.
+  // Only the relative order of nodes on the same device is preserved; nodes
+  // that do not report a device (e.g. remote and copy nodes) stay on the
+  // main queue. Child executors are created lazily and are drained by
+  // WaitForAllPendingNodes() and ShutDown().
+  bool route_by_device_;
+  mutable mutex device_executors_mu_;
+  std::unordered_map<Device*, std::unique_ptr<EagerExecutor>> device_executors_
+      TF_GUARDED_BY(device_executors_mu_);
 };
 
 inline bool EagerExecutor::Async() const { return thread_ != nullptr; }
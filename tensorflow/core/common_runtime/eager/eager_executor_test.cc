@@ -14,9 +14,12 @@ limitations under the License.
 ==============================================================================*/
 #include "tensorflow/core/common_runtime/eager/eager_executor.h"
 
+#include <functional>
 #include <memory>
 #include <utility>
 
+#include "tensorflow/core/framework/device_attributes.pb.h"
+#include "tensorflow/core/platform/notification.h"
 #include "tensorflow/core/platform/status.h"
 #include "tensorflow/core/platform/status_matchers.h"
 #include "tensorflow/core/platform/test.h"
@@ -102,6 +105,37 @@ class TestAsyncEagerNode : public AsyncEagerNode {
   Status run_return_status_;
 };
 
+// A node bound to a device, for exercising per-device queues.
+class TestDeviceBoundNode : public EagerNode {
+ public:
+  TestDeviceBoundNode(Device* device, std::function<Status()> fn)
+      : device_(device), fn_(std::move(fn)) {}
+  TestDeviceBoundNode(const TestDeviceBoundNode&) = delete;
+  TestDeviceBoundNode& operator=(const TestDeviceBoundNode&) = delete;
+
+  Status Run() override { return fn_(); }
+  void Abort(Status status) override {}
+  Device* device() const override { return device_; }
+  string DebugString() const override { return "testDeviceBoundNode"; }
+
+ private:
+  Device* device_;
+  std::function<Status()> fn_;
+};
+
+static Device* CreateTestDevice(const char* type, const char* name) {
+  class FakeDevice : public Device {
+   public:
+    explicit FakeDevice(const DeviceAttributes& attr) : Device(nullptr, attr) {}
+    Status Sync() override { return OkStatus(); }
+    Allocator* GetAllocator(AllocatorAttributes) override { return nullptr; }
+  };
+  DeviceAttributes attr;
+  attr.set_name(name);
+  attr.set_device_type(type);
+  return new FakeDevice(attr);
+}
+
 TEST(EagerExecutorTest, TestSyncExecutorWithEagerNode) {
   auto sync_executor = std::make_unique<EagerExecutor>(
       /*async=*/false, /*enable_streaming_enqueue=*/true);
@@ -281,5 +315,53 @@ TEST(EagerExecutorTest, TestAsyncExecutorAddNodesAfterShutdown) {
       async_executor->AddOrExecute(std::move(node)),
       tensorflow::testing::StatusIs(tensorflow::error::FAILED_PRECONDITION));
 }
+
+TEST(EagerExecutorTest, TestPerDeviceQueuesRunConcurrently) {
+  setenv("TF_EAGER_PER_DEVICE_QUEUES", "1", 1);
+  std::unique_ptr<Device> cpu(CreateTestDevice("CPU", "/device:CPU:0"));
+  std::unique_ptr<Device> gpu(CreateTestDevice("GPU", "/device:GPU:0"));
+  auto async_executor = std::make_unique<EagerExecutor>(
+      /*async=*/true, /*enable_streaming_enqueue=*/true);
+
+  // The first node blocks until the node targeting the other device has run,
+  // which can only happen if the two devices' queues execute concurrently.
+  Notification first_running;
+  Notification second_done;
+  TF_ASSERT_OK(async_executor->AddOrExecute(
+      std::make_unique<TestDeviceBoundNode>(cpu.get(), [&] {
+        first_running.Notify();
+        second_done.WaitForNotification();
+        return OkStatus();
+      })));
+  TF_ASSERT_OK(async_executor->AddOrExecute(
+      std::make_unique<TestDeviceBoundNode>(gpu.get(), [&] {
+        first_running.WaitForNotification();
+        second_done.Notify();
+        return OkStatus();
+      })));
+
+  TF_ASSERT_OK(async_executor->WaitForAllPendingNodes());
+  TF_ASSERT_OK(async_executor->ShutDown());
+  unsetenv("TF_EAGER_PER_DEVICE_QUEUES");
+}
+
+TEST(EagerExecutorTest, TestPerDeviceQueueErrorSurfaces) {
+  setenv("TF_EAGER_PER_DEVICE_QUEUES", "1", 1);
+  std::unique_ptr<Device> cpu(CreateTestDevice("CPU", "/device:CPU:0"));
+  auto async_executor = std::make_unique<EagerExecutor>(
+      /*async=*/true, /*enable_streaming_enqueue=*/true);
+
+  TF_ASSERT_OK(async_executor->AddOrExecute(
+      std::make_unique<TestDeviceBoundNode>(
+          cpu.get(), [] { return errors::Internal("device queue failure"); })));
+
+  auto status = async_executor->WaitForAllPendingNodes();
+  ASSERT_EQ(status.code(), tensorflow::error::INTERNAL);
+  ASSERT_EQ(async_executor->status().code(), tensorflow::error::INTERNAL);
+
+  async_executor->ClearError();
+  TF_ASSERT_OK(async_executor->status());
+  unsetenv("TF_EAGER_PER_DEVICE_QUEUES");
+}
 }  // namespace
 }  // namespace tensorflow
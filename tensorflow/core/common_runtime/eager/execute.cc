@@ -1369,14 +1369,25 @@ Status GetOrCreateKernelAndDevice(
   absl::flat_hash_map<string, const std::vector<string>*> composite_devices;
   std::unordered_map<int, DtypeAndPartialTensorShape>
       input_resource_variable_dtypes_and_shapes;
+  // Resolving the kernel def materializes a NodeDef and searches the kernel
+  // registry, both of which allocate. The result is only needed when
+  // extracting function input info or when creating a new kernel, so resolve
+  // it lazily to keep repeated executions of cached ops cheap.
   const KernelDef* kernel_def = nullptr;
-  if (!op->is_function()) {
-    const NodeDef* node_def = &op->MutableAttrs()->BuildNodeDef();
-    kernel_def = GetKernelDef(*op, node_def, device);
-  }
+  bool kernel_def_resolved = false;
+  auto resolve_kernel_def = [&]() -> const KernelDef* {
+    if (!kernel_def_resolved) {
+      if (!op->is_function()) {
+        const NodeDef* node_def = &op->MutableAttrs()->BuildNodeDef();
+        kernel_def = GetKernelDef(*op, node_def, device);
+      }
+      kernel_def_resolved = true;
+    }
+    return kernel_def;
+  };
   if (op->is_function() || ctx.RunEagerOpAsFunction()) {
     TF_RETURN_IF_ERROR(ExtractFunctionInputInfo(
-        op, kernel_def, input_device_ptrs, composite_devices,
+        op, resolve_kernel_def(), input_device_ptrs, composite_devices,
         input_resource_variable_dtypes_and_shapes));
   }
 
@@ -1479,7 +1490,7 @@ Status GetOrCreateKernelAndDevice(
       allow_control_flow_sync_execution = true;
       shape_inference_on_tfe_dialect_import = false;
       int_args_and_retvals_on_device =
-          IntArgsAndRetvalsOnDevice(op, kernel_def);
+          IntArgsAndRetvalsOnDevice(op, resolve_kernel_def());
       op = wrapped_op;
       if (int_args_and_retvals_on_device) {
         op->MutableAttrs()->Set(FunctionLibraryDefinition::kIntsOnDeviceAttr,
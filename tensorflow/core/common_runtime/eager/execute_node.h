@@ -131,6 +131,8 @@ class ExecuteNode : public EagerNode {
 
   void Abort(Status status) override {}
 
+  Device* device() const override { return kernel_->device(); }
+
   std::string DebugString() const override {
     std::string out = "[ExecuteNode]";
     strings::StrAppend(&out, " kernel: ", kernel_->name());
@@ -227,6 +229,8 @@ class AsyncExecuteNode : public EagerNode {
     }
   }
 
+  Device* device() const override { return kernel_->device(); }
+
   std::string DebugString() const override {
     std::string out = "[AsyncExecuteNode]";
     strings::StrAppend(&out, " kernel: ", kernel_->name());
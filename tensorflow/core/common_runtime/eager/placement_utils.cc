@@ -17,6 +17,7 @@ limitations under the License.
 
 #include <variant>
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/status/status.h"
 #include "tensorflow/c/eager/immediate_execution_tensor_handle.h"
 #include "tensorflow/core/common_runtime/eager/attr_builder.h"
@@ -26,6 +27,7 @@ limitations under the License.
 #include "tensorflow/core/framework/op_def.pb.h"
 #include "tensorflow/core/framework/types.pb.h"
 #include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/platform/mutex.h"
 
 namespace tensorflow {
 namespace eager {
@@ -80,12 +82,34 @@ bool IsFunction(StringPiece op_name) {
   return false;
 }
 
+// Returns whether ops with this name are eligible for CPU pinning at all.
+// This only depends on the op registry and the colocation exemption registry,
+// both of which are stable for a given op name, so the answer is memoized:
+// eager training loops execute the same op names on every step, and the
+// registry lookups (and their string allocations) otherwise run on every
+// call.
+static bool IsPinEligibleOp(StringPiece op_name) {
+  static mutex mu(LINKER_INITIALIZED);
+  static auto* cache = new absl::flat_hash_map<string, bool>();
+  {
+    tf_shared_lock l(mu);
+    auto it = cache->find(op_name);
+    if (it != cache->end()) {
+      return it->second;
+    }
+  }
+  const bool eligible = !IsFunction(op_name) && !IsColocationExempt(op_name) &&
+                        IsPinnableOp(op_name);
+  mutex_lock l(mu);
+  cache->emplace(op_name, eligible);
+  return eligible;
+}
+
 Status MaybePinSmallOpsToCpu(
     bool* result, StringPiece op_name,
     absl::Span<ImmediateExecutionTensorHandle* const> args,
     StringPiece cpu_device_name) {
-  if (IsFunction(op_name) || IsColocationExempt(op_name) ||
-      !IsPinnableOp(op_name)) {
+  if (!IsPinEligibleOp(op_name)) {
     *result = false;
     return OkStatus();
   }
@@ -0,0 +1,241 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/common_runtime/elementwise_chain_fusion_pass.h"
+
+#include <algorithm>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_join.h"
+#include "tensorflow/core/common_runtime/optimization_registry.h"
+#include "tensorflow/core/config/flag_defs.h"
+#include "tensorflow/core/config/flags.h"
+#include "tensorflow/core/framework/node_def_util.h"
+#include "tensorflow/core/graph/graph.h"
+#include "tensorflow/core/graph/node_builder.h"
+#include "tensorflow/core/platform/logging.h"
+#include "tensorflow/core/util/device_name_utils.h"
+#include "tensorflow/core/util/dump_graph.h"
+#include "tsl/platform/errors.h"
+#include "tsl/platform/status.h"
+
+namespace tensorflow {
+namespace {
+
+// Ops (and dtypes) evaluable by the _UnaryOpsComposition kernel.
+// WARN: This should be consistent with unary_ops_composition.cc.
+bool IsSupportedUnaryOp(const std::string& op, DataType dtype) {
+  // clang-format off
+  static const auto* const supported_ops =
+      new std::unordered_map<std::string, std::set<DataType>>{
+          {"Abs",        {DT_FLOAT, DT_HALF, DT_DOUBLE}},
+          {"Acos",       {DT_FLOAT,          DT_DOUBLE}},
+          {"Acosh",      {DT_FLOAT,          DT_DOUBLE}},
+          {"Asin",       {DT_FLOAT,          DT_DOUBLE}},
+          {"Asinh",      {DT_FLOAT,          DT_DOUBLE}},
+          {"Atan",       {DT_FLOAT,          DT_DOUBLE}},
+          {"Atanh",      {DT_FLOAT,          DT_DOUBLE}},
+          {"Ceil",       {DT_FLOAT, DT_HALF, DT_DOUBLE}},
+          {"Cos",        {DT_FLOAT, DT_HALF, DT_DOUBLE}},
+          {"Cosh",       {DT_FLOAT,          DT_DOUBLE}},
+          {"Expm1",      {DT_FLOAT, DT_HALF, DT_DOUBLE}},
+          {"Exp",        {DT_FLOAT, DT_HALF, DT_DOUBLE}},
+          {"Floor",      {DT_FLOAT, DT_HALF, DT_DOUBLE}},
+          {"Inv",        {DT_FLOAT, DT_HALF, DT_DOUBLE}},
+          {"Log",        {DT_FLOAT, DT_HALF, DT_DOUBLE}},
+          {"Log1p",      {DT_FLOAT, DT_HALF, DT_DOUBLE}},
+          {"Neg",        {DT_FLOAT, DT_HALF, DT_DOUBLE}},
+          {"Reciprocal", {DT_FLOAT, DT_HALF, DT_DOUBLE}},
+          {"Rint",       {DT_FLOAT,          DT_DOUBLE}},
+          {"Round",      {DT_FLOAT, DT_HALF, DT_DOUBLE}},
+          {"Rsqrt",      {DT_FLOAT, DT_HALF, DT_DOUBLE}},
+          {"Sigmoid",    {DT_FLOAT, DT_HALF, DT_DOUBLE}},
+          {"Sin",        {DT_FLOAT, DT_HALF, DT_DOUBLE}},
+          {"Sinh",       {DT_FLOAT,          DT_DOUBLE}},
+          {"Sqrt",       {DT_FLOAT, DT_HALF, DT_DOUBLE}},
+          {"Square",     {DT_FLOAT, DT_HALF, DT_DOUBLE}},
+          {"Tan",        {DT_FLOAT,          DT_DOUBLE}},
+          {"Tanh",       {DT_FLOAT, DT_HALF, DT_DOUBLE}},
+          {"Elu",        {DT_FLOAT, DT_HALF, DT_DOUBLE}},
+          {"Relu",       {DT_FLOAT, DT_HALF, DT_DOUBLE}},
+          {"Relu6",      {DT_FLOAT, DT_HALF, DT_DOUBLE}},
+          {"Selu",       {DT_FLOAT, DT_HALF, DT_DOUBLE}}};
+  // clang-format on
+  const auto it = supported_ops->find(op);
+  return it != supported_ops->end() && it->second.count(dtype) > 0;
+}
+
+// `node` has a control in- or out-edge. Fusing such a node would drop the
+// ordering constraint, so it stays out of any chain.
+bool HasControlEdges(const Node* node) {
+  for (const Edge* e : node->in_edges()) {
+    if (e->IsControlEdge()) return true;
+  }
+  for (const Edge* e : node->out_edges()) {
+    if (e->IsControlEdge()) return true;
+  }
+  return false;
+}
+
+// `node`'s assigned device is a CPU.
+bool HasCpuDevice(const Node* node) {
+  if (!node->has_assigned_device_name()) return false;
+  DeviceNameUtils::ParsedName device;
+  if (!DeviceNameUtils::ParseFullName(node->assigned_device_name(), &device))
+    return false;
+  return device.type == "CPU";
+}
+
+// `node` can be part of a fused chain with element type `dtype`.
+bool CanFuse(const Node* node, DataType dtype) {
+  DataType node_dtype;
+  if (!TryGetNodeAttr(node->attrs(), "T", &node_dtype)) return false;
+  return node_dtype == dtype && IsSupportedUnaryOp(node->type_string(), dtype) &&
+         HasCpuDevice(node) && !HasControlEdges(node);
+}
+
+// The single non-control out-edge of `node`, or nullptr if `node` has zero or
+// several non-control out-edges.
+const Edge* SingleDataOutEdge(const Node* node) {
+  const Edge* result = nullptr;
+  for (const Edge* e : node->out_edges()) {
+    if (e->IsControlEdge()) continue;
+    if (result != nullptr) return nullptr;
+    result = e;
+  }
+  return result;
+}
+
+// `node` would be absorbed into its consumer's chain, so it cannot be the
+// root (most downstream node) of a chain itself.
+bool AbsorbedByConsumer(const Node* node, DataType dtype) {
+  const Edge* out = SingleDataOutEdge(node);
+  return out != nullptr && out->dst_input() == 0 &&
+         CanFuse(out->dst(), dtype) &&
+         out->dst()->assigned_device_name() == node->assigned_device_name();
+}
+
+// Replaces `chain` (ordered from the most downstream node to the most
+// upstream one) with a single _UnaryOpsComposition node.
+Status FuseChain(Graph* graph, const std::vector<Node*>& chain,
+                 DataType dtype) {
+  Node* root = chain.front();
+  Node* tail = chain.back();
+
+  std::vector<std::string> op_names;
+  op_names.reserve(chain.size());
+  for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+    op_names.push_back((*it)->type_string());
+  }
+  VLOG(2) << "Fuse elementwise chain: root=" << root->name() << " op_names=["
+          << absl::StrJoin(op_names, ", ") << "]";
+
+  const Edge* in_edge;
+  TF_RETURN_IF_ERROR(tail->input_edge(0, &in_edge));
+
+  Node* fused;
+  TF_RETURN_IF_ERROR(
+      NodeBuilder(graph->NewName(
+                      absl::StrCat(root->name(), "/unary_ops_composition")),
+                  "_UnaryOpsComposition")
+          .Input(in_edge->src(), in_edge->src_output())
+          .Attr("T", dtype)
+          .Attr("op_names", op_names)
+          .Finalize(graph, &fused));
+  fused->set_assigned_device_name(root->assigned_device_name());
+
+  std::vector<const Edge*> out_edges(root->out_edges().begin(),
+                                     root->out_edges().end());
+  for (const Edge* e : out_edges) {
+    graph->AddEdge(fused, 0, e->dst(), e->dst_input());
+    graph->RemoveEdge(e);
+  }
+  for (Node* node : chain) {
+    graph->RemoveNode(node);
+  }
+  return OkStatus();
+}
+
+}  // namespace
+
+Status ElementwiseChainFusionPass::Run(
+    const GraphOptimizationPassOptions& options) {
+  if (!flags::Global().fuse_elementwise_chains.value()) {
+    VLOG(1) << "elementwise_chain_fusion_pass not enabled";
+    return OkStatus();
+  }
+  if (options.graph == nullptr) {
+    VLOG(1) << "No graph in elementwise_chain_fusion_pass.";
+    return OkStatus();
+  }
+  Graph* graph = options.graph->get();
+  if (VLOG_IS_ON(1)) {
+    VLOG(1) << DumpGraphToFile("before_elementwise_chain_fusion_pass", *graph,
+                               options.flib_def);
+  }
+
+  // Collect maximal chains before mutating the graph. Each chain is recorded
+  // from its most downstream node (the root) to its most upstream one.
+  std::vector<std::vector<Node*>> chains;
+  std::vector<DataType> chain_dtypes;
+  absl::flat_hash_set<Node*> fused_nodes;
+  for (Node* node : graph->op_nodes()) {
+    DataType dtype;
+    if (!TryGetNodeAttr(node->attrs(), "T", &dtype)) continue;
+    if (fused_nodes.contains(node) || !CanFuse(node, dtype) ||
+        AbsorbedByConsumer(node, dtype)) {
+      continue;
+    }
+    // `node` is the root of a (possibly trivial) chain; extend it upstream.
+    std::vector<Node*> chain = {node};
+    Node* cur = node;
+    while (true) {
+      const Edge* in_edge;
+      if (!cur->input_edge(0, &in_edge).ok()) break;
+      Node* src = in_edge->src();
+      if (fused_nodes.contains(src) || in_edge->dst_input() != 0 ||
+          SingleDataOutEdge(src) != in_edge || !CanFuse(src, dtype) ||
+          src->assigned_device_name() != node->assigned_device_name()) {
+        break;
+      }
+      chain.push_back(src);
+      cur = src;
+    }
+    if (chain.size() < 2) continue;
+    fused_nodes.insert(chain.begin(), chain.end());
+    chains.push_back(std::move(chain));
+    chain_dtypes.push_back(dtype);
+  }
+
+  for (int i = 0; i < chains.size(); ++i) {
+    TF_RETURN_IF_ERROR(FuseChain(graph, chains[i], chain_dtypes[i]));
+  }
+
+  if (VLOG_IS_ON(1)) {
+    VLOG(1) << DumpGraphToFile("after_elementwise_chain_fusion_pass", *graph,
+                               options.flib_def);
+  }
+  return OkStatus();
+}
+
+REGISTER_OPTIMIZATION(OptimizationPassRegistry::POST_REWRITE_FOR_EXEC, 4,
+                      ElementwiseChainFusionPass);
+
+}  // namespace tensorflow
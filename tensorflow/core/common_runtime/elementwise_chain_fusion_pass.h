@@ -0,0 +1,44 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_COMMON_RUNTIME_ELEMENTWISE_CHAIN_FUSION_PASS_H_
+#define TENSORFLOW_CORE_COMMON_RUNTIME_ELEMENTWISE_CHAIN_FUSION_PASS_H_
+
+#include "tensorflow/core/common_runtime/optimization_registry.h"
+
+// Fuses chains of elementwise unary ops assigned to a CPU device into a single
+// `_UnaryOpsComposition` node, which evaluates the whole chain block-at-a-time
+// without materializing the intermediate tensors.
+//
+// For example, the graph:
+//   x -> Exp -> Sqrt -> Neg -> consumers
+// where Exp and Sqrt each have a single consumer is rewritten to:
+//   x -> _UnaryOpsComposition(op_names=[Exp, Sqrt, Neg]) -> consumers
+//
+// Grappler's ArithmeticOptimizer performs the same rewrite, but it does not
+// run for graphs loaded with graph optimization disabled. This pass runs after
+// placement so chains are only fused when every node in the chain is assigned
+// to the same CPU device. Nodes with control edges are left alone.
+
+namespace tensorflow {
+
+class ElementwiseChainFusionPass : public GraphOptimizationPass {
+ public:
+  Status Run(const GraphOptimizationPassOptions& options) override;
+};
+
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_COMMON_RUNTIME_ELEMENTWISE_CHAIN_FUSION_PASS_H_
@@ -0,0 +1,161 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/common_runtime/elementwise_chain_fusion_pass.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "tensorflow/cc/framework/ops.h"
+#include "tensorflow/cc/framework/scope.h"
+#include "tensorflow/cc/ops/const_op.h"
+#include "tensorflow/cc/ops/math_ops.h"
+#include "tensorflow/core/common_runtime/optimization_registry.h"
+#include "tensorflow/core/config/flag_defs.h"
+#include "tensorflow/core/config/flags.h"
+#include "tensorflow/core/framework/node_def_util.h"
+#include "tensorflow/core/framework/op.h"
+#include "tensorflow/core/graph/graph.h"
+#include "tensorflow/core/platform/test.h"
+#include "tsl/lib/core/status_test_util.h"
+#include "tsl/platform/status.h"
+
+namespace tensorflow {
+namespace {
+
+const char kCpu0[] = "/job:localhost/replica:0/task:0/device:CPU:0";
+const char kGpu0[] = "/job:localhost/replica:0/task:0/device:GPU:0";
+
+// Return the node with name `name`, or nullptr if there is none.
+Node* GetNode(const Graph& graph, const std::string& name) {
+  for (Node* node : graph.nodes()) {
+    if (node->name() == name) return node;
+  }
+  return nullptr;
+}
+
+// Return the unique _UnaryOpsComposition node, or nullptr if there is none.
+Node* GetCompositionNode(const Graph& graph) {
+  Node* result = nullptr;
+  for (Node* node : graph.nodes()) {
+    if (node->type_string() == "_UnaryOpsComposition") {
+      CHECK(result == nullptr) << "Multiple composition nodes";
+      result = node;
+    }
+  }
+  return result;
+}
+
+// Assign every op node in `graph` to `device`.
+void AssignDevice(Graph* graph, const std::string& device) {
+  for (Node* node : graph->op_nodes()) {
+    node->set_assigned_device_name(device);
+  }
+}
+
+Status RunPass(std::unique_ptr<Graph>* graph) {
+  GraphOptimizationPassOptions options;
+  options.graph = graph;
+  ElementwiseChainFusionPass pass;
+  return pass.Run(options);
+}
+
+TEST(ElementwiseChainFusionPassTest, FusesChain) {
+  std::unique_ptr<Graph> graph(new Graph(OpRegistry::Global()));
+  {
+    Scope scope = Scope::NewRootScope().ExitOnError();
+    Output x = ops::Const(scope.WithOpName("x"), 1.0f, TensorShape({4}));
+    Output exp = ops::Exp(scope.WithOpName("exp"), x);
+    Output sqrt = ops::Sqrt(scope.WithOpName("sqrt"), exp);
+    Output neg = ops::Neg(scope.WithOpName("neg"), sqrt);
+    TF_CHECK_OK(scope.ToGraph(graph.get()));
+  }
+  AssignDevice(graph.get(), kCpu0);
+
+  flags::Global().fuse_elementwise_chains.reset(true);
+  TF_ASSERT_OK(RunPass(&graph));
+
+  EXPECT_EQ(GetNode(*graph, "exp"), nullptr);
+  EXPECT_EQ(GetNode(*graph, "sqrt"), nullptr);
+  EXPECT_EQ(GetNode(*graph, "neg"), nullptr);
+  Node* fused = GetCompositionNode(*graph);
+  ASSERT_NE(fused, nullptr);
+  EXPECT_EQ(fused->assigned_device_name(), kCpu0);
+  std::vector<string> op_names;
+  TF_ASSERT_OK(GetNodeAttr(fused->attrs(), "op_names", &op_names));
+  EXPECT_EQ(op_names, std::vector<string>({"Exp", "Sqrt", "Neg"}));
+}
+
+TEST(ElementwiseChainFusionPassTest, SkipsMultipleConsumers) {
+  std::unique_ptr<Graph> graph(new Graph(OpRegistry::Global()));
+  {
+    Scope scope = Scope::NewRootScope().ExitOnError();
+    Output x = ops::Const(scope.WithOpName("x"), 1.0f, TensorShape({4}));
+    Output exp = ops::Exp(scope.WithOpName("exp"), x);
+    // `exp` has two consumers, so it cannot be absorbed into either chain and
+    // no chain of length >= 2 exists.
+    Output sqrt = ops::Sqrt(scope.WithOpName("sqrt"), exp);
+    Output neg = ops::Neg(scope.WithOpName("neg"), exp);
+    TF_CHECK_OK(scope.ToGraph(graph.get()));
+  }
+  AssignDevice(graph.get(), kCpu0);
+
+  flags::Global().fuse_elementwise_chains.reset(true);
+  TF_ASSERT_OK(RunPass(&graph));
+
+  EXPECT_EQ(GetCompositionNode(*graph), nullptr);
+  EXPECT_NE(GetNode(*graph, "exp"), nullptr);
+  EXPECT_NE(GetNode(*graph, "sqrt"), nullptr);
+  EXPECT_NE(GetNode(*graph, "neg"), nullptr);
+}
+
+TEST(ElementwiseChainFusionPassTest, SkipsNonCpuDevice) {
+  std::unique_ptr<Graph> graph(new Graph(OpRegistry::Global()));
+  {
+    Scope scope = Scope::NewRootScope().ExitOnError();
+    Output x = ops::Const(scope.WithOpName("x"), 1.0f, TensorShape({4}));
+    Output exp = ops::Exp(scope.WithOpName("exp"), x);
+    Output sqrt = ops::Sqrt(scope.WithOpName("sqrt"), exp);
+    TF_CHECK_OK(scope.ToGraph(graph.get()));
+  }
+  AssignDevice(graph.get(), kGpu0);
+
+  flags::Global().fuse_elementwise_chains.reset(true);
+  TF_ASSERT_OK(RunPass(&graph));
+
+  EXPECT_EQ(GetCompositionNode(*graph), nullptr);
+}
+
+TEST(ElementwiseChainFusionPassTest, DisabledByDefault) {
+  std::unique_ptr<Graph> graph(new Graph(OpRegistry::Global()));
+  {
+    Scope scope = Scope::NewRootScope().ExitOnError();
+    Output x = ops::Const(scope.WithOpName("x"), 1.0f, TensorShape({4}));
+    Output exp = ops::Exp(scope.WithOpName("exp"), x);
+    Output sqrt = ops::Sqrt(scope.WithOpName("sqrt"), exp);
+    TF_CHECK_OK(scope.ToGraph(graph.get()));
+  }
+  AssignDevice(graph.get(), kCpu0);
+
+  flags::Global().fuse_elementwise_chains.reset(false);
+  TF_ASSERT_OK(RunPass(&graph));
+
+  EXPECT_EQ(GetCompositionNode(*graph), nullptr);
+  EXPECT_NE(GetNode(*graph, "exp"), nullptr);
+}
+
+}  // namespace
+}  // namespace tensorflow
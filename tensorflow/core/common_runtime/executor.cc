@@ -17,16 +17,19 @@ limitations under the License.
 
 #include <algorithm>
 #include <atomic>
+#include <deque>
 #include <memory>
 #include <utility>
 #include <vector>
 
 #include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
 #include "absl/strings/str_join.h"
 #include "absl/time/time.h"
 #include "absl/types/optional.h"
 #include "tensorflow/core/activity_watcher/activity.h"
 #include "tensorflow/core/common_runtime/costmodel_manager.h"
+#include "tensorflow/core/common_runtime/cpu_cost_measurement.h"
 #include "tensorflow/core/common_runtime/entry.h"
 #include "tensorflow/core/common_runtime/executor_factory.h"
 #include "tensorflow/core/common_runtime/graph_view.h"
@@ -50,6 +53,7 @@ limitations under the License.
 #include "tensorflow/core/framework/tensor_reference.h"
 #include "tensorflow/core/framework/types.h"
 #include "tensorflow/core/framework/types.pb.h"
+#include "tensorflow/core/graph/algorithm.h"
 #include "tensorflow/core/graph/edgeset.h"
 #include "tensorflow/core/graph/graph.h"
 #include "tensorflow/core/graph/graph_node_util.h"
@@ -58,10 +62,12 @@ limitations under the License.
 #include "tensorflow/core/lib/core/status.h"
 #include "tensorflow/core/lib/core/threadpool.h"
 #include "tensorflow/core/lib/gtl/flatmap.h"
+#include "tensorflow/core/lib/gtl/flatset.h"
 #include "tensorflow/core/lib/gtl/inlined_vector.h"
 #include "tensorflow/core/lib/gtl/manual_constructor.h"
 #include "tensorflow/core/lib/hash/hash.h"
 #include "tensorflow/core/platform/context.h"
+#include "tensorflow/core/platform/cpu_info.h"
 #include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/errors.h"
 #include "tensorflow/core/platform/logging.h"
@@ -80,6 +86,7 @@ limitations under the License.
 #include "tensorflow/core/profiler/lib/traceme_encode.h"
 #include "tensorflow/core/protobuf/error_codes.pb.h"
 #include "tensorflow/core/util/determinism.h"
+#include "tensorflow/core/util/env_var.h"
 #include "tensorflow/core/util/managed_stack_trace.h"
 #include "tensorflow/core/util/tensor_slice_reader_cache.h"
 
@@ -145,6 +152,239 @@ struct KernelTimer {
 typedef gtl::InlinedVector<TensorValue, 4> TensorValueVec;
 typedef gtl::InlinedVector<AllocatorAttributes, 4> AllocatorAttributeVec;
 
+// A sharded collection of per-worker deques of ready nodes, used when
+// `Executor::Args::use_work_stealing` is set. Each executor thread pushes
+// the nodes it makes ready onto its own deque and pops them back LIFO, which
+// keeps hot producer/consumer pairs on one core; a thread whose deque is
+// empty steals FIFO from the other deques. This bounds contention on wide
+// fan-out graphs to the (rare) steal path instead of a single shared queue.
+template <typename TaggedNode>
+class WorkStealingQueues {
+ public:
+  explicit WorkStealingQueues(int num_queues)
+      : queues_(std::max(1, num_queues)) {
+    for (auto& q : queues_) q = std::make_unique<Queue>();
+  }
+
+  // Returns the index of the queue owned by the calling thread, assigning
+  // one round-robin on first use.
+  int CurrentQueueIndex() {
+    static thread_local int assigned_index = -1;
+    if (TF_PREDICT_FALSE(assigned_index < 0)) {
+      assigned_index = next_queue_index_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return assigned_index % queues_.size();
+  }
+
+  void Push(int index, const TaggedNode& node) {
+    Queue& q = *queues_[index];
+    mutex_lock l(q.mu);
+    q.nodes.push_back(node);
+  }
+
+  // Pops the most recently pushed node from the calling thread's own queue.
+  absl::optional<TaggedNode> PopLocal(int index) {
+    Queue& q = *queues_[index];
+    mutex_lock l(q.mu);
+    if (q.nodes.empty()) return absl::nullopt;
+    TaggedNode node = q.nodes.back();
+    q.nodes.pop_back();
+    return node;
+  }
+
+  // Steals the oldest node from some other queue. Scans all queues once,
+  // starting after `index`, and returns nullopt if every queue is empty.
+  absl::optional<TaggedNode> Steal(int index) {
+    const int n = queues_.size();
+    for (int i = 1; i <= n; ++i) {
+      Queue& q = *queues_[(index + i) % n];
+      mutex_lock l(q.mu);
+      if (!q.nodes.empty()) {
+        TaggedNode node = q.nodes.front();
+        q.nodes.pop_front();
+        return node;
+      }
+    }
+    return absl::nullopt;
+  }
+
+ private:
+  struct Queue {
+    mutex mu;
+    std::deque<TaggedNode> nodes TF_GUARDED_BY(mu);
+    // Pad to a cacheline so that queues owned by different threads do not
+    // false-share.
+    char pad[64];
+  };
+  std::vector<std::unique_ptr<Queue>> queues_;
+  std::atomic<int> next_queue_index_{0};
+};
+
+// Memoizes the outputs of pure shape-computation nodes across steps.
+//
+// Serving graphs re-execute many sub-microsecond scalar ops (Shape, Size,
+// StridedSlice, Pack, ...) every step even though the input shapes rarely
+// change. At initialization time the executor identifies the nodes whose
+// outputs are a pure function of input shapes: Shape/ShapeN/Size/Rank roots,
+// plus allowlisted stateless integer ops all of whose inputs are themselves
+// shape expressions or constants. At execution time the outputs of such nodes
+// are cached keyed by the node and the actual input shapes (for roots) or the
+// actual input values (for derived nodes), and the kernel is skipped when the
+// key matches a previous step.
+//
+// The cache is opt-in via TF_EXECUTOR_SHAPE_EXPR_CACHE=true and is only built
+// for CPU executors, where input tensors can be inspected on the host.
+class ShapeExpressionCache {
+ public:
+  // Identifies the shape-expression nodes of `graph`. Returns nullptr if
+  // caching is disabled or the graph has no cacheable nodes.
+  static std::unique_ptr<ShapeExpressionCache> Create(const Graph& graph) {
+    bool enabled = false;
+    Status s =
+        ReadBoolFromEnvVar("TF_EXECUTOR_SHAPE_EXPR_CACHE", false, &enabled);
+    if (!s.ok()) {
+      LOG(ERROR) << s.message();
+    }
+    if (!enabled) return nullptr;
+    std::vector<Kind> kinds(graph.num_node_ids(), Kind::kNone);
+    // Classify in topological order (ignoring control-flow back edges) so
+    // that a node's data inputs are classified before the node itself.
+    std::vector<Node*> order;
+    GetReversePostOrder(graph, &order);
+    int num_cacheable = 0;
+    for (Node* n : order) {
+      if (!n->IsOp() || n->op_def().is_stateful()) continue;
+      if (n->IsConstant()) {
+        // Constants are valid shape-expression inputs, but caching them would
+        // only duplicate the constant.
+        kinds[n->id()] = Kind::kConstant;
+        continue;
+      }
+      bool integer_io = n->num_outputs() > 0;
+      for (int i = 0; i < n->num_outputs(); ++i) {
+        const DataType dt = n->output_type(i);
+        if (dt != DT_INT32 && dt != DT_INT64) {
+          integer_io = false;
+          break;
+        }
+      }
+      for (int i = 0; i < n->num_inputs(); ++i) {
+        if (IsRefType(n->input_type(i))) {
+          integer_io = false;
+          break;
+        }
+      }
+      if (!integer_io) continue;
+      const string& op = n->type_string();
+      if (op == "Shape" || op == "ShapeN" || op == "Size" || op == "Rank") {
+        kinds[n->id()] = Kind::kRoot;
+        ++num_cacheable;
+        continue;
+      }
+      static const gtl::FlatSet<string>* const kDerivedOps =
+          new gtl::FlatSet<string>(
+              {"StridedSlice", "Slice", "Pack", "Unpack", "ConcatV2", "Prod",
+               "Cast", "Squeeze", "ExpandDims", "Reshape", "Add", "AddV2",
+               "Sub", "Mul", "Maximum", "Minimum", "FloorDiv", "FloorMod",
+               "Identity", "GatherV2", "Range", "Fill"});
+      if (kDerivedOps->count(op) == 0) continue;
+      bool inputs_are_shape_exprs = n->num_inputs() > 0;
+      for (const Edge* e : n->in_edges()) {
+        if (e->IsControlEdge()) continue;
+        if (kinds[e->src()->id()] == Kind::kNone) {
+          inputs_are_shape_exprs = false;
+          break;
+        }
+        const DataType dt = e->src()->output_type(e->src_output());
+        if (dt != DT_INT32 && dt != DT_INT64) {
+          inputs_are_shape_exprs = false;
+          break;
+        }
+      }
+      if (inputs_are_shape_exprs) {
+        kinds[n->id()] = Kind::kDerived;
+        ++num_cacheable;
+      }
+    }
+    if (num_cacheable == 0) return nullptr;
+    VLOG(1) << "Shape-expression cache covers " << num_cacheable
+            << " of the executor's nodes";
+    return absl::WrapUnique(new ShapeExpressionCache(std::move(kinds)));
+  }
+
+  bool IsShapeExpression(int node_id) const {
+    return node_id < static_cast<int>(kinds_.size()) &&
+           kinds_[node_id] != Kind::kNone;
+  }
+
+  // Builds the memoization key for `item` from its input tensors. Returns
+  // false if the node should not be cached for these inputs, e.g. because a
+  // value-keyed input is unexpectedly large.
+  bool MakeKey(const NodeItem& item, absl::Span<const TensorValue> inputs,
+               string* key) const {
+    const Kind kind = kinds_[item.node_id];
+    key->clear();
+    absl::StrAppend(key, item.node_id);
+    for (const TensorValue& value : inputs) {
+      const Tensor* tensor = value.tensor;
+      if (tensor == nullptr || !tensor->IsInitialized()) return false;
+      absl::StrAppend(key, ";", static_cast<int>(tensor->dtype()));
+      for (int d = 0; d < tensor->dims(); ++d) {
+        absl::StrAppend(key, ",", tensor->dim_size(d));
+      }
+      if (kind == Kind::kDerived) {
+        // Derived nodes consume the small integer outputs of other shape
+        // expressions, so key on their contents.
+        if (tensor->NumElements() > kMaxInputElements) return false;
+        const StringPiece data = tensor->tensor_data();
+        absl::StrAppend(key, ":");
+        key->append(data.data(), data.size());
+      }
+    }
+    return true;
+  }
+
+  // Returns true and fills `outputs` if `key` is cached.
+  bool Lookup(const string& key, std::vector<Tensor>* outputs) {
+    mutex_lock l(mu_);
+    auto it = cache_.find(key);
+    if (it == cache_.end()) return false;
+    *outputs = it->second;
+    return true;
+  }
+
+  void Insert(const string& key, std::vector<Tensor> outputs) {
+    mutex_lock l(mu_);
+    if (cache_.size() >= kMaxEntries) {
+      // The input shapes churn too much for memoization to pay off; restart
+      // with an empty cache rather than tracking recency per entry.
+      cache_.clear();
+    }
+    cache_.emplace(key, std::move(outputs));
+  }
+
+ private:
+  enum class Kind : uint8 {
+    kNone = 0,
+    kRoot,      // Keyed by input shapes (Shape, ShapeN, Size, Rank).
+    kDerived,   // Keyed by input values.
+    kConstant,  // Valid input to a derived node; not itself cached.
+  };
+
+  // Derived nodes with more input elements than this are not cached; shape
+  // expressions operate on vectors no longer than a tensor's rank.
+  static constexpr int64_t kMaxInputElements = 64;
+  static constexpr size_t kMaxEntries = 4096;
+
+  explicit ShapeExpressionCache(std::vector<Kind> kinds)
+      : kinds_(std::move(kinds)) {}
+
+  const std::vector<Kind> kinds_;
+
+  mutex mu_;
+  gtl::FlatMap<string, std::vector<Tensor>> cache_ TF_GUARDED_BY(mu_);
+};
+
 class ExecutorImpl : public Executor {
  public:
   explicit ExecutorImpl(const LocalExecutorParams& p) : immutable_state_(p) {}
@@ -152,6 +392,11 @@ class ExecutorImpl : public Executor {
   Status Initialize(const Graph& graph) {
     TF_RETURN_IF_ERROR(immutable_state_.Initialize(graph));
     kernel_stats_.Initialize(immutable_state_.graph_view());
+    // The cache inspects input tensors on the host, so only build it for CPU
+    // executors.
+    if (immutable_state_.params().device->device_type() == DEVICE_CPU) {
+      shape_expr_cache_ = ShapeExpressionCache::Create(graph);
+    }
     return OkStatus();
   }
 
@@ -226,6 +471,10 @@ class ExecutorImpl : public Executor {
   ImmutableExecutorState immutable_state_;
   KernelStats kernel_stats_;
 
+  // Memoizes pure shape-computation nodes across steps. Null if caching is
+  // disabled or the graph has no such nodes.
+  std::unique_ptr<ShapeExpressionCache> shape_expr_cache_;
+
   ExecutorImpl(const ExecutorImpl&) = delete;
   void operator=(const ExecutorImpl&) = delete;
 };
@@ -284,7 +533,8 @@ class ExecutorState {
  public:
   ExecutorState(const Executor::Args& args,
                 const ImmutableExecutorState& immutable_state_,
-                ExecutorImpl::KernelStats* kernel_stats_);
+                ExecutorImpl::KernelStats* kernel_stats_,
+                ShapeExpressionCache* shape_expr_cache);
   ~ExecutorState();
 
   void RunAsync(Executor::DoneCallback done);
@@ -340,6 +590,15 @@ class ExecutorState {
   // REQUIRES: `!ready->empty()`.
   void ScheduleReady(TaggedNodeSeq* ready, TaggedNodeReadyQueue* inline_ready);
 
+  // Work-stealing variant of the dispatch path in `ScheduleReady`: pushes the
+  // given nodes onto the calling thread's deque and schedules worker loops
+  // that drain it, stealing from other deques when it runs dry.
+  void ScheduleWorkStealing(TaggedNodeSeq* nodes, int64_t scheduled_nsec);
+
+  // Body of a scheduled work-stealing task: processes nodes from the deque
+  // owned by `queue_index` until it and all peer deques are empty.
+  void WorkStealingLoop(int queue_index, int64_t scheduled_nsec);
+
   // A wrapper for runner_ to keep track of the pending queue length. Op
   // execution should dispatch work using this function instead of using runner_
   // directly.
@@ -389,6 +648,9 @@ class ExecutorState {
   CallFrameInterface* call_frame_;
   const ImmutableExecutorState& immutable_state_;
   ExecutorImpl::KernelStats* const kernel_stats_;
+  // Shared across the executor's steps; null if shape-expression memoization
+  // is disabled. Not owned.
+  ShapeExpressionCache* const shape_expr_cache_;
   CancellationManager* cancellation_manager_;
   tsl::CoordinationServiceAgent* coordination_service_agent_;
   absl::optional<ManagedStackTrace> stack_trace_ = absl::nullopt;
@@ -398,6 +660,20 @@ class ExecutorState {
   bool sync_on_finish_;
   const bool run_all_kernels_inline_;
 
+  // Per-step arena for small host allocations, or nullptr. Only set for CPU
+  // devices; not owned.
+  Allocator* small_tensor_arena_ = nullptr;
+
+  // Accumulator for per-request kernel CPU time, captured from the
+  // CpuCostMeasurement active on the thread that launched this step; null if
+  // no such measurement is active.
+  std::shared_ptr<std::atomic<int64_t>> cpu_cost_accumulator_;
+
+  // Non-null iff `Executor::Args::use_work_stealing` was set. Ready nodes
+  // that would otherwise be dispatched one closure at a time through `runner_`
+  // are routed through these per-worker deques instead.
+  std::unique_ptr<WorkStealingQueues<TaggedNode>> work_stealing_queues_;
+
   PropagatorStateType propagator_;
 
   // Invoked when the execution finishes.
@@ -418,7 +694,8 @@ class ExecutorState {
 template <class PropagatorStateType>
 ExecutorState<PropagatorStateType>::ExecutorState(
     const Executor::Args& args, const ImmutableExecutorState& immutable_state,
-    ExecutorImpl::KernelStats* kernel_stats)
+    ExecutorImpl::KernelStats* kernel_stats,
+    ShapeExpressionCache* shape_expr_cache)
     : vlog_(VLOG_IS_ON(1)),
       log_memory_(LogMemory::IsEnabled()),
       step_id_(args.step_id),
@@ -440,6 +717,7 @@ ExecutorState<PropagatorStateType>::ExecutorState(
       call_frame_(args.call_frame),
       immutable_state_(immutable_state),
       kernel_stats_(kernel_stats),
+      shape_expr_cache_(shape_expr_cache),
       cancellation_manager_(args.cancellation_manager),
       coordination_service_agent_(args.coordination_service_agent),
       stack_trace_(args.stack_trace),
@@ -448,6 +726,15 @@ ExecutorState<PropagatorStateType>::ExecutorState(
       run_all_kernels_inline_(args.run_all_kernels_inline),
       propagator_(immutable_state, step_id_, vlog_),
       num_outstanding_ops_(0) {
+  if (args.small_tensor_arena != nullptr &&
+      immutable_state_.params().device->device_type() == DEVICE_CPU) {
+    small_tensor_arena_ = args.small_tensor_arena;
+  }
+  cpu_cost_accumulator_ = CpuCostMeasurement::CurrentAccumulator();
+  if (args.use_work_stealing && !run_all_kernels_inline_) {
+    work_stealing_queues_ = std::make_unique<WorkStealingQueues<TaggedNode>>(
+        port::MaxParallelism());
+  }
   if (args.user_intra_op_threadpool != nullptr) {
     Device* device = immutable_state_.params().device;
     user_device_ = RenamedDevice::NewRenamedDevice(
@@ -591,6 +878,33 @@ Status ExecutorState<PropagatorStateType>::ProcessSync(
   Device* device = immutable_state_.params().device;
   const bool is_expensive = kernel_stats_->IsExpensive(item);
 
+  // If the node is a memoized shape expression and its key matches a previous
+  // step, reuse the cached outputs instead of running the kernel.
+  string shape_expr_key;
+  if (shape_expr_cache_ != nullptr &&
+      TF_PREDICT_FALSE(shape_expr_cache_->IsShapeExpression(item.node_id)) &&
+      shape_expr_cache_->MakeKey(item, params->inputs, &shape_expr_key)) {
+    std::vector<Tensor> cached;
+    if (shape_expr_cache_->Lookup(shape_expr_key, &cached)) {
+      for (int i = 0; i < item.num_outputs; ++i) {
+        ctx.set_output(i, cached[i]);
+      }
+      nodestats::SetOpEnd(stats);
+      if (outputs->size() < item.num_outputs) outputs->resize(item.num_outputs);
+      s = ProcessOutputs(item, &ctx, outputs->data(), stats);
+      nodestats::SetMemory(stats, &ctx);
+      return s;
+    }
+  }
+
+  // When a CpuCostMeasurement is attached to this step, charge the kernel's
+  // thread-CPU time to it. Two clock reads per kernel keep the overhead well
+  // below the cost of any non-trivial kernel.
+  const int64_t compute_start_cpu_ns =
+      TF_PREDICT_FALSE(cpu_cost_accumulator_ != nullptr)
+          ? CpuCostMeasurement::ThreadCpuTimeNanos()
+          : -1;
+
   if (TF_PREDICT_FALSE(MightTrace(event_collector_, is_expensive))) {
     tracing::ScopedRegion region(tracing::EventCategory::kCompute,
                                  op_kernel->name_view());
@@ -615,7 +929,26 @@ Status ExecutorState<PropagatorStateType>::ProcessSync(
   } else {
     device->Compute(op_kernel, &ctx);
   }
+  if (TF_PREDICT_FALSE(compute_start_cpu_ns >= 0)) {
+    const int64_t delta =
+        CpuCostMeasurement::ThreadCpuTimeNanos() - compute_start_cpu_ns;
+    if (delta > 0) {
+      cpu_cost_accumulator_->fetch_add(delta, std::memory_order_relaxed);
+    }
+  }
   nodestats::SetOpEnd(stats);
+  if (!shape_expr_key.empty() && ctx.status().ok()) {
+    std::vector<Tensor> computed;
+    computed.reserve(item.num_outputs);
+    for (int i = 0; i < item.num_outputs; ++i) {
+      const Tensor* out = ctx.mutable_output(i);
+      if (out == nullptr) break;
+      computed.push_back(*out);
+    }
+    if (static_cast<int>(computed.size()) == item.num_outputs) {
+      shape_expr_cache_->Insert(shape_expr_key, std::move(computed));
+    }
+  }
   if (outputs->size() < item.num_outputs) outputs->resize(item.num_outputs);
   s = ProcessOutputs(item, &ctx, outputs->data(), stats);
   nodestats::SetMemory(stats, &ctx);
@@ -770,6 +1103,7 @@ void ExecutorState<PropagatorStateType>::ProcessInline(
   params->function_library = immutable_state_.params().function_library;
   params->resource_manager = device->resource_manager();
   params->step_container = step_container_;
+  params->small_tensor_arena = small_tensor_arena_;
   params->slice_reader_cache = slice_reader_cache_;
   params->runner = &runner_;
   params->run_all_kernels_inline = run_all_kernels_inline_;
@@ -1294,6 +1628,32 @@ void ExecutorState<PropagatorStateType>::ScheduleReady(
         inline_ready->push_back(tagged_node);
       }
     }
+  } else if (work_stealing_queues_ != nullptr) {
+    if (inline_ready == nullptr) {
+      ScheduleWorkStealing(ready, scheduled_nsec);
+    } else {
+      // Inline inexpensive nodes as in the default path, and route the
+      // expensive ones through the work-stealing deques.
+      TaggedNodeSeq expensive_nodes;
+      for (auto& tagged_node : *ready) {
+        const NodeItem& item = *tagged_node.node_item;
+        if (tagged_node.get_is_dead() || !kernel_stats_->IsExpensive(item)) {
+          inline_ready->push_back(tagged_node);
+        } else {
+          expensive_nodes.push_back(tagged_node);
+        }
+      }
+      if (!expensive_nodes.empty()) {
+        if (inline_ready->empty()) {
+          // Keep one node for the current thread to avoid an idle hop.
+          inline_ready->push_back(expensive_nodes.back());
+          expensive_nodes.pop_back();
+        }
+        if (!expensive_nodes.empty()) {
+          ScheduleWorkStealing(&expensive_nodes, scheduled_nsec);
+        }
+      }
+    }
   } else {
     const TaggedNode* curr_expensive_node = nullptr;
     TaggedNodeSeq expensive_nodes;
@@ -1371,6 +1731,39 @@ void ExecutorState<PropagatorStateType>::ScheduleReady(
   ready->clear();
 }
 
+template <class PropagatorStateType>
+void ExecutorState<PropagatorStateType>::ScheduleWorkStealing(
+    TaggedNodeSeq* nodes, int64_t scheduled_nsec) {
+  const int queue_index = work_stealing_queues_->CurrentQueueIndex();
+  for (auto& tagged_node : *nodes) {
+    work_stealing_queues_->Push(queue_index, tagged_node);
+  }
+  // Schedule one worker loop per pushed node. Loops that find all deques
+  // drained (because a peer stole their work) return immediately, so this
+  // over-provisioning costs at most one empty closure per node while
+  // guaranteeing that every pushed node is eventually claimed.
+  const int num_loops = nodes->size();
+  for (int i = 0; i < num_loops; ++i) {
+    RunTask([this, scheduled_nsec]() {
+      WorkStealingLoop(work_stealing_queues_->CurrentQueueIndex(),
+                       scheduled_nsec);
+    },
+            /*sample_rate=*/num_loops);
+  }
+}
+
+template <class PropagatorStateType>
+void ExecutorState<PropagatorStateType>::WorkStealingLoop(
+    int queue_index, int64_t scheduled_nsec) {
+  while (true) {
+    absl::optional<TaggedNode> tagged_node =
+        work_stealing_queues_->PopLocal(queue_index);
+    if (!tagged_node) tagged_node = work_stealing_queues_->Steal(queue_index);
+    if (!tagged_node) return;
+    Process(*tagged_node, scheduled_nsec);
+  }
+}
+
 template <class PropagatorStateType>
 void ExecutorState<PropagatorStateType>::ScheduleFinish() {
   // Checks condition to decide if needs to invoke Finish(). If there are
@@ -1509,15 +1902,16 @@ void ExecutorState<PropagatorStateType>::Finish() {
 
 void ExecutorImpl::RunAsyncInternal(const Args& args, DoneCallback done) {
   if (OpOrderDeterminismRequired()) {
-    (new ExecutorState<OrderedPropagatorState>(args, immutable_state_,
-                                               &kernel_stats_))
+    (new ExecutorState<OrderedPropagatorState>(
+         args, immutable_state_, &kernel_stats_, shape_expr_cache_.get()))
         ->RunAsync(std::move(done));
   } else if (immutable_state_.requires_control_flow_support()) {
-    (new ExecutorState<PropagatorState>(args, immutable_state_, &kernel_stats_))
+    (new ExecutorState<PropagatorState>(args, immutable_state_, &kernel_stats_,
+                                        shape_expr_cache_.get()))
         ->RunAsync(std::move(done));
   } else {
-    (new ExecutorState<SimplePropagatorState>(args, immutable_state_,
-                                              &kernel_stats_))
+    (new ExecutorState<SimplePropagatorState>(
+         args, immutable_state_, &kernel_stats_, shape_expr_cache_.get()))
         ->RunAsync(std::move(done));
   }
 }
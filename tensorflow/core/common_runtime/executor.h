@@ -124,6 +124,17 @@ class Executor {
     // If true, all kernels will be treated as "inexpensive", and hence executed
     // on the scheduling thread.
     bool run_all_kernels_inline = false;
+
+    // If true, ready nodes are distributed over per-worker work-stealing
+    // deques instead of being handed to `runner` one closure at a time. This
+    // reduces scheduling contention for wide fan-out graphs with many small
+    // ops. Ignored when `run_all_kernels_inline` is set.
+    bool use_work_stealing = false;
+
+    // If non-null, a per-step arena allocator that kernels running on CPU
+    // devices draw small default-attribute allocations from. Not owned; must
+    // remain valid until the done callback is invoked.
+    Allocator* small_tensor_arena = nullptr;
   };
   typedef std::function<void(const Status&)> DoneCallback;
 
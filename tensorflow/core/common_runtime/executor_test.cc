@@ -16,6 +16,7 @@ limitations under the License.
 #include "tensorflow/core/common_runtime/executor.h"
 
 #include <algorithm>
+#include <cstdlib>
 
 #include "tensorflow/cc/framework/ops.h"
 #include "tensorflow/cc/ops/array_ops.h"
@@ -38,6 +39,7 @@ limitations under the License.
 #include "tensorflow/core/framework/tensor_testutil.h"
 #include "tensorflow/core/framework/versions.pb.h"
 #include "tensorflow/core/graph/algorithm.h"
+#include "tensorflow/core/graph/node_builder.h"
 #include "tensorflow/core/graph/testlib.h"
 #include "tensorflow/core/lib/core/status_test_util.h"
 #include "tensorflow/core/lib/random/simple_philox.h"
@@ -440,6 +442,48 @@ TEST_F(ExecutorTest, NoInputTensors) {
   TF_ASSERT_OK(Run(rendez_));
 }
 
+TEST_F(ExecutorTest, ShapeExpressionCache) {
+  // b = Prod(Shape(a), 0), i.e. the number of elements of `a`, computed by a
+  // pure shape-expression subgraph. With TF_EXECUTOR_SHAPE_EXPR_CACHE set,
+  // repeated steps with the same input shape are served from the memoization
+  // cache and changing the input shape must still recompute the result.
+  setenv("TF_EXECUTOR_SHAPE_EXPR_CACHE", "true", 1 /* overwrite */);
+  auto g = std::make_unique<Graph>(OpRegistry::Global());
+  auto in = test::graph::Recv(g.get(), "a", "float", ALICE, 1, BOB);
+  Node* shape;
+  TF_ASSERT_OK(NodeBuilder(g->NewName("shape"), "Shape")
+                   .Input(in)
+                   .Finalize(g.get(), &shape));
+  Node* axis = test::graph::Constant(g.get(), VI(0));
+  Node* prod;
+  TF_ASSERT_OK(NodeBuilder(g->NewName("prod"), "Prod")
+                   .Input(shape)
+                   .Input(axis)
+                   .Finalize(g.get(), &prod));
+  test::graph::Send(g.get(), prod, "b", BOB, 1, ALICE);
+  Create(std::move(g));
+  Rendezvous::Args args;
+  auto run_with_shape = [&](const TensorShape& in_shape) -> int32 {
+    Tensor input(DT_FLOAT, in_shape);
+    input.flat<float>().setZero();
+    TF_CHECK_OK(
+        rendez_->Send(Key(ALICE, kIncarnation, BOB, "a"), args, input, false));
+    TF_CHECK_OK(Run(rendez_));
+    Tensor out;
+    bool is_dead = false;
+    TF_CHECK_OK(rendez_->Recv(Key(BOB, kIncarnation, ALICE, "b"), args, &out,
+                              &is_dead));
+    return out.scalar<int32>()();
+  };
+  EXPECT_EQ(6, run_with_shape(TensorShape({2, 3})));
+  // Same shape again: served from the cache.
+  EXPECT_EQ(6, run_with_shape(TensorShape({2, 3})));
+  // A different shape must miss the cache and recompute.
+  EXPECT_EQ(20, run_with_shape(TensorShape({4, 5})));
+  EXPECT_EQ(20, run_with_shape(TensorShape({4, 5})));
+  unsetenv("TF_EXECUTOR_SHAPE_EXPR_CACHE");
+}
+
 // Create a graph that is 'depth' deep. At each level, fan-in and fan-out a
 // maximum of 'width' nodes. All nodes are no-ops and all dependencies are
 // control dependencies.
@@ -13,6 +13,10 @@ See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
 
+#if GOOGLE_CUDA
+#include "third_party/gpus/cuda/include/cuda.h"
+#endif
+
 #include "tensorflow/core/common_runtime/gpu/gpu_bfc_allocator.h"
 
 #include <cstdlib>
@@ -80,6 +84,48 @@ bool GetGarbageCollectionValue() {
       << " Using the default value \"true\".";
   return true;
 }
+
+bool GetManagedMemoryOverflowValue() {
+  const char* managed_memory_overflow =
+      std::getenv("TF_GPU_BFC_MANAGED_MEMORY_OVERFLOW");
+  if (managed_memory_overflow == nullptr) {
+    // By default, allocations beyond device capacity fail.
+    return false;
+  }
+  if (strcmp("false", managed_memory_overflow) == 0) {
+    return false;
+  } else if (strcmp("true", managed_memory_overflow) == 0) {
+    return true;
+  }
+
+  LOG(ERROR)
+      << "The TF_GPU_BFC_MANAGED_MEMORY_OVERFLOW environment variable is set"
+      << " but could not be parsed: \"" << managed_memory_overflow << "\"."
+      << " Valid values are \"true\" or \"false\"."
+      << " Using the default value \"false\".";
+  return false;
+}
+double GetGcFreeBytesWatermarkFraction() {
+  const char* watermark_string =
+      std::getenv("TF_GPU_GC_FREE_BYTES_WATERMARK_FRACTION");
+  if (watermark_string == nullptr) {
+    // By default, free regions are only reclaimed on allocation failure.
+    return 0.0;
+  }
+  char* end = nullptr;
+  double value = std::strtod(watermark_string, &end);
+  if (end != watermark_string && *end == '\0' && value >= 0.0 &&
+      value <= 1.0) {
+    return value;
+  }
+
+  LOG(ERROR)
+      << "The TF_GPU_GC_FREE_BYTES_WATERMARK_FRACTION environment variable is"
+      << " set but could not be parsed: \"" << watermark_string << "\"."
+      << " Valid values are numbers in [0.0, 1.0]."
+      << " Using the default value \"0.0\".";
+  return 0.0;
+}
 }  // anonymous namespace
 
 GPUBFCAllocator::GPUBFCAllocator(
@@ -95,7 +141,107 @@ GPUBFCAllocator::GPUBFCAllocator(
           o.garbage_collection = GetGarbageCollectionValue();
         }
         o.fragmentation_fraction = opts.fragmentation_fraction;
+        o.gc_free_bytes_watermark_fraction = GetGcFreeBytesWatermarkFraction();
         return o;
-      }()) {}
+      }()),
+      managed_memory_overflow_(GetManagedMemoryOverflowValue()) {}
+
+void* GPUBFCAllocator::AllocateManagedRaw(size_t alignment, size_t num_bytes) {
+#if GOOGLE_CUDA
+  CUdeviceptr result = 0;
+  if (cuMemAllocManaged(&result, num_bytes, CU_MEM_ATTACH_GLOBAL) !=
+      CUDA_SUCCESS) {
+    return nullptr;
+  }
+  void* ptr = reinterpret_cast<void*>(result);
+  if (reinterpret_cast<uintptr_t>(ptr) & (alignment - 1)) {
+    cuMemFree(result);
+    return nullptr;
+  }
+  return ptr;
+#else
+  return nullptr;
+#endif
+}
+
+void* GPUBFCAllocator::AllocateRaw(
+    size_t alignment, size_t num_bytes,
+    const tsl::AllocationAttributes& allocation_attr) {
+  if (!managed_memory_overflow_) {
+    return BFCAllocator::AllocateRaw(alignment, num_bytes, allocation_attr);
+  }
+  // Overflow to unified memory as soon as device memory is exhausted instead
+  // of entering the retry-with-timeout loop.
+  tsl::AllocationAttributes no_retry_attr(
+      /*retry_on_failure=*/false, allocation_attr.allocation_will_be_logged,
+      allocation_attr.freed_by_func);
+  void* ptr = BFCAllocator::AllocateRaw(alignment, num_bytes, no_retry_attr);
+  if (ptr != nullptr) {
+    return ptr;
+  }
+  ptr = AllocateManagedRaw(alignment, num_bytes);
+  if (ptr == nullptr) {
+    // Unified memory is unavailable (or itself exhausted); fall back to the
+    // normal path so the caller sees the usual retry and OOM behavior.
+    return BFCAllocator::AllocateRaw(alignment, num_bytes, allocation_attr);
+  }
+  size_t managed_bytes_in_use;
+  {
+    tsl::mutex_lock l(managed_mu_);
+    managed_ptr_bytes_.emplace(ptr, num_bytes);
+    managed_bytes_in_use_ += num_bytes;
+    managed_bytes_in_use = managed_bytes_in_use_;
+  }
+  LOG_EVERY_N_SEC(INFO, 30)
+      << Name() << " ran out of device memory; serving allocations from CUDA"
+      << " unified memory (" << managed_bytes_in_use
+      << " bytes currently in the managed overflow tier). Expect reduced"
+      << " performance while pages migrate on demand.";
+  return ptr;
+}
+
+void GPUBFCAllocator::DeallocateRaw(void* ptr) {
+  if (managed_memory_overflow_ && ptr != nullptr) {
+    bool managed = false;
+    {
+      tsl::mutex_lock l(managed_mu_);
+      auto it = managed_ptr_bytes_.find(ptr);
+      if (it != managed_ptr_bytes_.end()) {
+        managed_bytes_in_use_ -= it->second;
+        managed_ptr_bytes_.erase(it);
+        managed = true;
+      }
+    }
+    if (managed) {
+#if GOOGLE_CUDA
+      cuMemFree(reinterpret_cast<CUdeviceptr>(ptr));
+#endif
+      return;
+    }
+  }
+  BFCAllocator::DeallocateRaw(ptr);
+}
+
+size_t GPUBFCAllocator::RequestedSize(const void* ptr) const {
+  if (managed_memory_overflow_) {
+    tsl::mutex_lock l(managed_mu_);
+    auto it = managed_ptr_bytes_.find(ptr);
+    if (it != managed_ptr_bytes_.end()) {
+      return it->second;
+    }
+  }
+  return BFCAllocator::RequestedSize(ptr);
+}
+
+size_t GPUBFCAllocator::AllocatedSize(const void* ptr) const {
+  if (managed_memory_overflow_) {
+    tsl::mutex_lock l(managed_mu_);
+    auto it = managed_ptr_bytes_.find(ptr);
+    if (it != managed_ptr_bytes_.end()) {
+      return it->second;
+    }
+  }
+  return BFCAllocator::AllocatedSize(ptr);
+}
 
 }  // namespace tensorflow
@@ -19,10 +19,13 @@ limitations under the License.
 #include <memory>
 #include <optional>
 #include <string>
+#include <unordered_map>
 
 #include "tsl/framework/allocator.h"
 #include "tsl/framework/bfc_allocator.h"
 #include "tsl/platform/macros.h"
+#include "tsl/platform/mutex.h"
+#include "tsl/platform/thread_annotations.h"
 
 namespace tensorflow {
 
@@ -56,6 +59,31 @@ class GPUBFCAllocator : public tsl::BFCAllocator {
 
   GPUBFCAllocator(const GPUBFCAllocator&) = delete;
   void operator=(const GPUBFCAllocator&) = delete;
+
+  // When TF_GPU_BFC_MANAGED_MEMORY_OVERFLOW=true (CUDA only), allocations
+  // that do not fit in device memory are served from CUDA unified memory
+  // instead of failing, so models slightly over device capacity run (with the
+  // driver migrating pages on demand) instead of OOMing.
+  void* AllocateRaw(size_t alignment, size_t num_bytes,
+                    const tsl::AllocationAttributes& allocation_attr) override;
+  void DeallocateRaw(void* ptr) override;
+  size_t RequestedSize(const void* ptr) const override;
+  size_t AllocatedSize(const void* ptr) const override;
+
+ private:
+  // Returns a unified-memory allocation, or nullptr if managed overflow is
+  // unavailable or the allocation fails.
+  void* AllocateManagedRaw(size_t alignment, size_t num_bytes);
+
+  const bool managed_memory_overflow_;
+
+  // Sizes of live unified-memory allocations, keyed by pointer. Consulted on
+  // deallocation and size queries to route managed pointers away from the
+  // BFC bookkeeping, which does not know about them.
+  mutable tsl::mutex managed_mu_;
+  std::unordered_map<const void*, size_t> managed_ptr_bytes_
+      TF_GUARDED_BY(managed_mu_);
+  size_t managed_bytes_in_use_ TF_GUARDED_BY(managed_mu_) = 0;
 };
 
 }  // namespace tensorflow
@@ -48,6 +48,7 @@ limitations under the License.
 #include "xla/stream_executor/device_id_utils.h"
 #include "xla/stream_executor/gpu/gpu_init.h"
 #include "tensorflow/core/common_runtime/device/device_event_mgr.h"
+#include "tensorflow/core/common_runtime/device_bandwidth_table.h"
 #include "tensorflow/core/common_runtime/device_factory.h"
 #include "tensorflow/core/common_runtime/gpu/gpu_device.h"
 #include "tensorflow/core/common_runtime/gpu/gpu_id_manager.h"
@@ -586,6 +587,14 @@ Status BaseGPUDevice::Init(const SessionOptions& options) {
         timestamped_allocator_ ? gpu_allocator_ : nullptr, em_));
   }
 
+  int64_t graph_capture_threshold;
+  TF_RETURN_IF_ERROR(ReadInt64FromEnvVar("TF_GPU_GRAPH_CAPTURE_THRESHOLD", 0,
+                                         &graph_capture_threshold));
+  if (graph_capture_threshold > 0) {
+    step_graph_replayer_ = std::make_unique<GpuStepGraphReplayer>(
+        executor_, graph_capture_threshold);
+  }
+
   accelerator_device_info_ = new DeviceBase::AcceleratorDeviceInfo;
   accelerator_device_info_->stream = stream_->compute;
   accelerator_device_info_->default_context = device_context_;
@@ -1669,6 +1678,41 @@ Status BaseGPUDeviceFactory::CreateDevices(
   TF_RETURN_IF_ERROR(GetDeviceLocalities(
       tf_device_specs.size(), interconnect_maps, &device_localities));
 
+  // Record per-pair link estimates for the placer's communication-aware
+  // refinement pass. Peer-connected pairs get NVLink/peer-copy class numbers;
+  // everything else is assumed to bounce through host memory over PCIe. These
+  // are topology-derived estimates; Record() overwrites them if something
+  // later measures the real link.
+  {
+    DeviceBandwidthTable* bandwidth_table = DeviceBandwidthTable::Global();
+    for (int di = 0; di < tf_device_specs.size(); ++di) {
+      for (int dj = 0; dj < tf_device_specs.size(); ++dj) {
+        if (di == dj) continue;
+        const string src_name =
+            strings::StrCat(name_prefix, "/device:GPU:", di);
+        const string dst_name =
+            strings::StrCat(name_prefix, "/device:GPU:", dj);
+        bool peer_linked = false;
+        for (const InterconnectMap& im : interconnect_maps) {
+          if (im.directed_links.find(
+                  {tf_device_specs[di].platform_device_id,
+                   tf_device_specs[dj].platform_device_id}) !=
+              im.directed_links.end()) {
+            peer_linked = true;
+            break;
+          }
+        }
+        if (peer_linked) {
+          bandwidth_table->Record(src_name, dst_name, /*bandwidth_gbps=*/80.0,
+                                  /*latency_us=*/2.0);
+        } else {
+          bandwidth_table->Record(src_name, dst_name, /*bandwidth_gbps=*/10.0,
+                                  /*latency_us=*/10.0);
+        }
+      }
+    }
+  }
+
 #ifdef TF_GPU_USE_PJRT
   // After the GPU device creation loop, allocator_id_stream_tuples will be
   // populated.
@@ -45,6 +45,7 @@ limitations under the License.
 #include "tensorflow/core/common_runtime/device_factory.h"
 #include "tensorflow/core/common_runtime/gpu/gpu_event_mgr.h"
 #include "tensorflow/core/common_runtime/gpu/gpu_id_manager.h"
+#include "tensorflow/core/common_runtime/gpu/gpu_step_graph_replayer.h"
 #include "tensorflow/core/common_runtime/gpu_device_context.h"
 #include "tensorflow/core/common_runtime/local_device.h"
 #include "tensorflow/core/common_runtime/node_file_writer.h"
@@ -177,6 +178,14 @@ class BaseGPUDevice : public LocalDevice {
 
   se::Stream* compute_stream() { return stream_->compute; }
 
+  // Per-device command buffer capture/replay helper for callers that re-run
+  // an identical-shape step with stable buffer addresses (see
+  // gpu_step_graph_replayer.h for the contract). Returns nullptr unless
+  // TF_GPU_GRAPH_CAPTURE_THRESHOLD is set to a positive value.
+  GpuStepGraphReplayer* step_graph_replayer() {
+    return step_graph_replayer_.get();
+  }
+
   // Given the compute stream for a GPU or virtual GPU, return the TfDeviceId
   // for the GPU or vGPU.
   static std::optional<tsl::TfDeviceId> FindTfDeviceId(se::Stream* compute);
@@ -204,6 +213,7 @@ class BaseGPUDevice : public LocalDevice {
   EventMgr* em_ = nullptr;
   std::unique_ptr<thread::ThreadPool> thread_pool_;
   std::unique_ptr<GPUKernelTracker> kernel_tracker_;
+  std::unique_ptr<GpuStepGraphReplayer> step_graph_replayer_;
   int32 pending_cap_ = 0;
   bool timestamped_allocator_ = false;
   NodeFileWriter* node_file_writer_ = nullptr;  // not owned
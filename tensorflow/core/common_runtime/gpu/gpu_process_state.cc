@@ -40,6 +40,7 @@ limitations under the License.
 #include "tensorflow/core/common_runtime/gpu/gpu_id_manager.h"
 #include "tensorflow/core/common_runtime/gpu/gpu_virtual_mem_allocator.h"
 #include "tensorflow/core/common_runtime/pool_allocator.h"
+#include "tensorflow/core/common_runtime/sharded_allocator.h"
 #include "tensorflow/core/common_runtime/shared_counter.h"
 #include "tensorflow/core/framework/log_memory.h"
 #include "tensorflow/core/framework/tracking_allocator.h"
@@ -217,6 +218,7 @@ Allocator* GPUProcessState::GetGPUAllocator(
       gpu_bfc_allocator->SetTimingCounter(timing_counter);
     }
 
+
     // If true, checks for memory overwrites by writing
     // distinctive patterns on both ends of allocated memory.
     if (UseCudaMemoryGuardAllocator()) {
@@ -244,6 +246,45 @@ Allocator* GPUProcessState::GetGPUAllocator(
           new se::GpuCudaMallocAsyncAllocator(platform_device_id, total_bytes);
     }
 
+    // Optionally split the device memory over several BFC shards so that
+    // concurrently-allocating threads do not contend on one allocator lock.
+    // Shard 0 is the BFC allocator created above and remains the
+    // representative instance for the timing counter and memory-pressure
+    // queries; the wrapper owns all shards. Sharding is skipped when one of
+    // the debug/cudaMalloc allocator modes replaced the BFC allocator.
+    GPUBFCAllocator* bfc_allocator_ptr = gpu_bfc_allocator.get();
+    const int num_allocator_shards =
+        options.experimental().num_allocator_shards();
+    if (num_allocator_shards > 1 && gpu_bfc_allocator != nullptr &&
+        gpu_allocator == bfc_allocator_ptr) {
+      const size_t shard_bytes = total_bytes / num_allocator_shards;
+      std::vector<std::unique_ptr<Allocator>> shards;
+      shards.push_back(std::move(gpu_bfc_allocator));
+      for (int i = 1; i < num_allocator_shards; ++i) {
+        std::unique_ptr<SubAllocator> shard_sub_allocator = CreateSubAllocator(
+            options, platform_device_id, gpu_visitors_[bus_id], total_bytes,
+            peer_gpu_ids);
+        auto shard = std::make_unique<GPUBFCAllocator>(
+            std::move(shard_sub_allocator), shard_bytes,
+            strings::StrCat("GPU_", tf_device_id.value(), "_bfc_shard_", i),
+            [&] {
+              GPUBFCAllocator::Options o;
+              o.allow_growth = options.allow_growth();
+              o.allow_retry_on_failure =
+                  !options.experimental()
+                       .disallow_retry_on_allocation_failure();
+              o.fragmentation_fraction =
+                  options.experimental().internal_fragmentation_fraction();
+              return o;
+            }());
+        if (timing_counter != nullptr) {
+          shard->SetTimingCounter(timing_counter);
+        }
+        shards.push_back(std::move(shard));
+      }
+      gpu_allocator = new ShardedAllocator(std::move(shards));
+    }
+
     Allocator* recording_allocator = nullptr;
     if (process_state_->ProcessState::FLAGS_brain_gpu_record_mem_types) {
       ProcessState::MemDesc md;
@@ -258,14 +299,16 @@ Allocator* GPUProcessState::GetGPUAllocator(
     // Owning allocator is not set if `allocator_not_owned` is set.
     allocator_parts.allocator_not_owned = gpu_allocator;
     allocator_parts.counter.reset(timing_counter);
-    allocator_parts.bfc_allocator = gpu_bfc_allocator.release();
+    gpu_bfc_allocator.release();
+    allocator_parts.bfc_allocator = bfc_allocator_ptr;
     allocator_parts.sub_allocator = sub_allocator_ptr;
     allocator_parts.recording_allocator.reset(recording_allocator);
 #else
+    gpu_bfc_allocator.release();
     allocator_parts = {
         std::unique_ptr<Allocator>(gpu_allocator),
         std::unique_ptr<SharedCounter>(timing_counter),
-        gpu_bfc_allocator.release(),
+        bfc_allocator_ptr,
         sub_allocator_ptr,
         std::unique_ptr<Allocator>(recording_allocator),
     };
@@ -0,0 +1,94 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/common_runtime/gpu/gpu_staging_buffer_pool.h"
+
+#include <algorithm>
+#include <cstddef>
+
+#include "tensorflow/core/platform/logging.h"
+#include "tensorflow/core/util/env_var.h"
+
+namespace tensorflow {
+
+/* static */ GpuStagingBufferPool* GpuStagingBufferPool::singleton() {
+  static GpuStagingBufferPool* instance = new GpuStagingBufferPool;
+  return instance;
+}
+
+GpuStagingBufferPool::GpuStagingBufferPool() {
+  int64_t max_cached_bytes = 64 * 1024 * 1024;
+  Status status = ReadInt64FromEnvVar("TF_GPU_HOST_STAGING_POOL_BYTES",
+                                      max_cached_bytes, &max_cached_bytes);
+  if (!status.ok()) {
+    LOG(ERROR) << status.message();
+  }
+  max_cached_bytes_ = std::max<int64_t>(0, max_cached_bytes);
+  status = ReadInt64FromEnvVar("TF_GPU_HOST_STAGING_CHUNK_BYTES",
+                               4 * 1024 * 1024, &chunk_bytes_);
+  if (!status.ok()) {
+    LOG(ERROR) << status.message();
+  }
+  // Chunks must fit in a size class so pipelined uploads always hit the pool.
+  chunk_bytes_ =
+      std::max<int64_t>(kMinClassBytes,
+                        std::min<int64_t>(chunk_bytes_,
+                                          ClassBytes(kNumClasses - 1)));
+}
+
+/* static */ int GpuStagingBufferPool::SizeClass(size_t num_bytes) {
+  size_t class_bytes = kMinClassBytes;
+  for (int i = 0; i < kNumClasses; ++i, class_bytes <<= 1) {
+    if (num_bytes <= class_bytes) return i;
+  }
+  return -1;
+}
+
+void* GpuStagingBufferPool::Acquire(Allocator* allocator, size_t num_bytes) {
+  const int size_class = SizeClass(num_bytes);
+  if (size_class < 0) {
+    // Oversize requests bypass the cache entirely.
+    return allocator->AllocateRaw(Allocator::kAllocatorAlignment, num_bytes);
+  }
+  {
+    mutex_lock l(mu_);
+    std::vector<void*>& free_list = free_lists_[allocator].per_class[size_class];
+    if (!free_list.empty()) {
+      void* ptr = free_list.back();
+      free_list.pop_back();
+      cached_bytes_ -= ClassBytes(size_class);
+      return ptr;
+    }
+  }
+  return allocator->AllocateRaw(Allocator::kAllocatorAlignment,
+                                ClassBytes(size_class));
+}
+
+void GpuStagingBufferPool::Release(Allocator* allocator, void* ptr,
+                                   size_t num_bytes) {
+  if (ptr == nullptr) return;
+  const int size_class = SizeClass(num_bytes);
+  if (size_class >= 0) {
+    mutex_lock l(mu_);
+    if (cached_bytes_ + ClassBytes(size_class) <= max_cached_bytes_) {
+      free_lists_[allocator].per_class[size_class].push_back(ptr);
+      cached_bytes_ += ClassBytes(size_class);
+      return;
+    }
+  }
+  allocator->DeallocateRaw(ptr);
+}
+
+}  // namespace tensorflow
@@ -0,0 +1,97 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_COMMON_RUNTIME_GPU_GPU_STAGING_BUFFER_POOL_H_
+#define TENSORFLOW_CORE_COMMON_RUNTIME_GPU_GPU_STAGING_BUFFER_POOL_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "tensorflow/core/framework/allocator.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/thread_annotations.h"
+#include "tensorflow/core/platform/types.h"
+
+namespace tensorflow {
+
+// A process-wide pool of pinned host staging buffers used by CPU->GPU tensor
+// copies. Allocating pinned memory (cudaHostAlloc) is expensive and
+// serializing, so rather than allocating a fresh buffer per transfer the copy
+// path acquires buffers here; released buffers are cached in power-of-two
+// size-class free lists keyed by the allocator that produced them, up to a
+// bounded total, and reused by later transfers on any stream.
+//
+// The pool also decides when a large transfer should be broken into chunks so
+// that the DMA of one chunk overlaps the memcpy of the next into pinned
+// memory (see GPUUtil::CopyCPUTensorToGPU).
+//
+// The cache bound and chunk size may be overridden with the environment
+// variables TF_GPU_HOST_STAGING_POOL_BYTES and TF_GPU_HOST_STAGING_CHUNK_BYTES.
+class GpuStagingBufferPool {
+ public:
+  static GpuStagingBufferPool* singleton();
+
+  // Returns a buffer of at least `num_bytes` from `allocator`, reusing a
+  // cached buffer of the matching size class when one is available. Requests
+  // larger than the largest size class are passed through to `allocator`
+  // directly. Returns nullptr if the underlying allocation fails.
+  void* Acquire(Allocator* allocator, size_t num_bytes);
+
+  // Returns a buffer previously obtained from Acquire with the same
+  // `allocator` and `num_bytes`. The buffer is cached for reuse unless the
+  // pool is at its cache bound, in which case it is freed.
+  void Release(Allocator* allocator, void* ptr, size_t num_bytes);
+
+  // Byte size of the chunks used for pipelined uploads of large tensors.
+  int64_t ChunkBytes() const { return chunk_bytes_; }
+
+  // Whether a host-to-device copy of `total_bytes` is large enough that
+  // chunking it would overlap meaningful amounts of memcpy and DMA work.
+  bool ShouldChunkTransfer(int64_t total_bytes) const {
+    return total_bytes > 2 * chunk_bytes_;
+  }
+
+ private:
+  GpuStagingBufferPool();
+
+  // Size classes are powers of two from 4 KiB to 16 MiB.
+  static constexpr size_t kMinClassBytes = 4096;
+  static constexpr int kNumClasses = 13;
+
+  // Returns the smallest size class holding `num_bytes`, or -1 if the request
+  // exceeds the largest class.
+  static int SizeClass(size_t num_bytes);
+  static size_t ClassBytes(int size_class) {
+    return kMinClassBytes << size_class;
+  }
+
+  struct FreeLists {
+    std::vector<void*> per_class[kNumClasses];
+  };
+
+  mutex mu_;
+  absl::flat_hash_map<Allocator*, FreeLists> free_lists_ TF_GUARDED_BY(mu_);
+  size_t cached_bytes_ TF_GUARDED_BY(mu_) = 0;
+  size_t max_cached_bytes_;
+  int64_t chunk_bytes_;
+
+  GpuStagingBufferPool(const GpuStagingBufferPool&) = delete;
+  void operator=(const GpuStagingBufferPool&) = delete;
+};
+
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_COMMON_RUNTIME_GPU_GPU_STAGING_BUFFER_POOL_H_
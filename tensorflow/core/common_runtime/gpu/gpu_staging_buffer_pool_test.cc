@@ -0,0 +1,59 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/common_runtime/gpu/gpu_staging_buffer_pool.h"
+
+#include "tensorflow/core/framework/allocator.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace {
+
+// The pool caches by size class, not by requested size, so any allocator
+// works for exercising the caching logic.
+TEST(GpuStagingBufferPoolTest, ReusesBuffersOfSameSizeClass) {
+  GpuStagingBufferPool* pool = GpuStagingBufferPool::singleton();
+  Allocator* allocator = cpu_allocator();
+  void* first = pool->Acquire(allocator, 1000);
+  ASSERT_NE(first, nullptr);
+  pool->Release(allocator, first, 1000);
+  // 1000 and 4096 bytes round up to the same 4 KiB size class, so the second
+  // acquisition must return the cached buffer.
+  void* second = pool->Acquire(allocator, 4096);
+  EXPECT_EQ(second, first);
+  pool->Release(allocator, second, 4096);
+}
+
+TEST(GpuStagingBufferPoolTest, OversizeRequestsBypassThePool) {
+  GpuStagingBufferPool* pool = GpuStagingBufferPool::singleton();
+  Allocator* allocator = cpu_allocator();
+  // Larger than the largest (16 MiB) size class.
+  constexpr size_t kOversize = 64 * 1024 * 1024;
+  void* buffer = pool->Acquire(allocator, kOversize);
+  ASSERT_NE(buffer, nullptr);
+  pool->Release(allocator, buffer, kOversize);
+}
+
+TEST(GpuStagingBufferPoolTest, ChunksOnlyLargeTransfers) {
+  GpuStagingBufferPool* pool = GpuStagingBufferPool::singleton();
+  const int64_t chunk_bytes = pool->ChunkBytes();
+  EXPECT_GT(chunk_bytes, 0);
+  EXPECT_FALSE(pool->ShouldChunkTransfer(chunk_bytes));
+  EXPECT_FALSE(pool->ShouldChunkTransfer(2 * chunk_bytes));
+  EXPECT_TRUE(pool->ShouldChunkTransfer(4 * chunk_bytes));
+}
+
+}  // namespace
+}  // namespace tensorflow
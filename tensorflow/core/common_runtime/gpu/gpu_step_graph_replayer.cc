@@ -0,0 +1,100 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/common_runtime/gpu/gpu_step_graph_replayer.h"
+
+#include <functional>
+#include <utility>
+
+#include "xla/stream_executor/command_buffer.h"
+#include "tensorflow/core/platform/logging.h"
+
+namespace tensorflow {
+
+GpuStepGraphReplayer::GpuStepGraphReplayer(se::StreamExecutor* executor,
+                                           int capture_threshold)
+    : executor_(executor), capture_threshold_(capture_threshold) {
+  DCHECK_GT(capture_threshold, 0);
+}
+
+Status GpuStepGraphReplayer::RunOrReplay(
+    uint64 signature, se::Stream* stream,
+    const std::function<Status(se::Stream*)>& enqueue_fn) {
+  mutex_lock l(mu_);
+
+  if (signature != current_signature_) {
+    // Shapes, addresses or control flow changed: any captured work is stale.
+    if (command_buffer_.has_value()) {
+      VLOG(1) << "Invalidating captured step graph for signature "
+              << current_signature_;
+      command_buffer_.reset();
+    }
+    current_signature_ = signature;
+    consecutive_steps_ = 1;
+    return enqueue_fn(stream);
+  }
+  ++consecutive_steps_;
+
+  if (command_buffer_.has_value()) {
+    Status s = executor_->Submit(stream, *command_buffer_);
+    if (s.ok()) {
+      ++replay_count_;
+      return s;
+    }
+    // Submission failures are not expected to be transient; fall back to
+    // direct execution for the rest of the process.
+    LOG(WARNING) << "Replaying captured step graph failed, disabling capture: "
+                 << s;
+    command_buffer_.reset();
+    capture_disabled_ = true;
+    return enqueue_fn(stream);
+  }
+
+  if (capture_disabled_ || consecutive_steps_ <= capture_threshold_) {
+    return enqueue_fn(stream);
+  }
+
+  // The signature has been stable for `capture_threshold_` steps: trace this
+  // step's device work into a command buffer and run it from there, so the
+  // traced work also executes.
+  auto command_buffer = se::CommandBuffer::Trace(
+      executor_, [&](se::Stream* trace_stream) -> tsl::Status {
+        return enqueue_fn(trace_stream);
+      });
+  if (!command_buffer.ok()) {
+    // Unsupported platform or untraceable work (e.g. host callbacks). Keep
+    // running directly; the work itself was not enqueued, so do that now.
+    LOG_FIRST_N(WARNING, 1) << "Capturing step graph failed, disabling "
+                               "capture: "
+                            << command_buffer.status();
+    capture_disabled_ = true;
+    return enqueue_fn(stream);
+  }
+  command_buffer_.emplace(std::move(*command_buffer));
+  ++capture_count_;
+  Status s = executor_->Submit(stream, *command_buffer_);
+  if (!s.ok()) {
+    LOG(WARNING) << "Submitting captured step graph failed, disabling "
+                    "capture: "
+                 << s;
+    command_buffer_.reset();
+    capture_disabled_ = true;
+    return enqueue_fn(stream);
+  }
+  ++replay_count_;
+  return s;
+}
+
+}  // namespace tensorflow
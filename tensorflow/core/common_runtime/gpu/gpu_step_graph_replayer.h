@@ -0,0 +1,94 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_COMMON_RUNTIME_GPU_GPU_STEP_GRAPH_REPLAYER_H_
+#define TENSORFLOW_CORE_COMMON_RUNTIME_GPU_GPU_STEP_GRAPH_REPLAYER_H_
+
+#include <functional>
+#include <optional>
+
+#include "xla/stream_executor/command_buffer.h"
+#include "tensorflow/core/lib/core/status.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/stream_executor.h"
+#include "tensorflow/core/platform/types.h"
+
+namespace tensorflow {
+
+// Amortizes kernel launch overhead by capturing a repeated sequence of device
+// work into a stream-executor command buffer (a CUDA graph on NVIDIA GPUs)
+// and replaying it with a single submission.
+//
+// The caller describes each step with a signature that must fingerprint
+// everything the captured device work depends on: tensor shapes, input and
+// output buffer addresses, and any control-flow decisions. After
+// `capture_threshold` consecutive steps with the same signature, the next
+// step's device work is traced into a command buffer; later steps with that
+// signature replay the buffer instead of re-launching each kernel. Any change
+// of signature invalidates the capture and restarts observation.
+//
+// IMPORTANT: replay re-executes only device work at the captured buffer
+// addresses. Callers must guarantee that all device buffers touched by the
+// step are stable across steps with equal signatures (e.g. a serving loop
+// with pre-allocated inputs and outputs). Host-side work inside `enqueue_fn`
+// runs during observation and capture but NOT during replay, so `enqueue_fn`
+// must be free of host side effects that later steps depend on.
+//
+// This class is thread-compatible; concurrent steps must serialize externally
+// (the executor already serializes work on a compute stream).
+class GpuStepGraphReplayer {
+ public:
+  GpuStepGraphReplayer(se::StreamExecutor* executor, int capture_threshold);
+
+  // Runs one step: either invokes `enqueue_fn` to enqueue the step's device
+  // work on `stream`, or submits a previously captured command buffer to
+  // `stream`. `enqueue_fn` receives the stream to enqueue on, which during
+  // capture is a tracing stream rather than `stream` itself.
+  Status RunOrReplay(uint64 signature, se::Stream* stream,
+                     const std::function<Status(se::Stream*)>& enqueue_fn);
+
+  // Number of steps that were served by replaying a captured command buffer.
+  int64_t replay_count() const {
+    mutex_lock l(mu_);
+    return replay_count_;
+  }
+
+  // Number of command buffer captures (including re-captures after
+  // invalidation).
+  int64_t capture_count() const {
+    mutex_lock l(mu_);
+    return capture_count_;
+  }
+
+ private:
+  se::StreamExecutor* const executor_;  // not owned
+  const int capture_threshold_;
+
+  mutable mutex mu_;
+  // Signature of the step sequence currently being observed or replayed.
+  uint64 current_signature_ TF_GUARDED_BY(mu_) = 0;
+  // Consecutive steps seen with `current_signature_`.
+  int consecutive_steps_ TF_GUARDED_BY(mu_) = 0;
+  std::optional<se::CommandBuffer> command_buffer_ TF_GUARDED_BY(mu_);
+  // Set when the platform cannot trace this work (e.g. command buffers are
+  // unsupported); all further steps run directly.
+  bool capture_disabled_ TF_GUARDED_BY(mu_) = false;
+  int64_t replay_count_ TF_GUARDED_BY(mu_) = 0;
+  int64_t capture_count_ TF_GUARDED_BY(mu_) = 0;
+};
+
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_COMMON_RUNTIME_GPU_GPU_STEP_GRAPH_REPLAYER_H_
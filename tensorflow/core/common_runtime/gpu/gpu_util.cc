@@ -17,12 +17,14 @@ limitations under the License.
 
 #include <algorithm>
 #include <cstring>
+#include <memory>
 
 #include "tensorflow/core/common_runtime/copy_tensor.h"
 #include "tensorflow/core/common_runtime/device.h"
 #include "tensorflow/core/common_runtime/device/device_event_mgr.h"
 #include "tensorflow/core/common_runtime/dma_helper.h"
 #include "tensorflow/core/common_runtime/gpu/gpu_process_state.h"
+#include "tensorflow/core/common_runtime/gpu/gpu_staging_buffer_pool.h"
 #include "tensorflow/core/common_runtime/gpu_device_context.h"
 #include "tensorflow/core/framework/log_memory.h"
 #include "tensorflow/core/framework/tensor.h"
@@ -369,9 +371,54 @@ void GPUUtil::CopyCPUTensorToGPU(const Tensor* cpu_tensor,
       }
     }
 
-    if (do_staging) {
-      staging_buffer = host_memory_allocator->AllocateRaw(
-          tensorflow::Allocator::kAllocatorAlignment, total_bytes);
+    GpuStagingBufferPool* staging_pool = GpuStagingBufferPool::singleton();
+    if (do_staging && staging_pool->ShouldChunkTransfer(total_bytes)) {
+      // Pipeline the upload through a ring of pooled pinned chunks: while the
+      // DMA of chunk N is in flight on the stream, the memcpy of chunk N+1
+      // into pinned memory proceeds on this thread. At most two chunks are in
+      // flight at a time, so the pipeline behaves as a double buffer and its
+      // pinned footprint stays bounded.
+      struct ChunkPipeline {
+        mutex mu;
+        condition_variable cv;
+        int chunks_in_flight TF_GUARDED_BY(mu) = 0;
+      };
+      auto pipeline = std::make_shared<ChunkPipeline>();
+      const int64_t chunk_bytes = staging_pool->ChunkBytes();
+      const char* src_base = static_cast<const char*>(src_ptr);
+      for (int64_t offset = 0; offset < total_bytes; offset += chunk_bytes) {
+        const int64_t copy_bytes =
+            std::min(chunk_bytes, total_bytes - offset);
+        {
+          mutex_lock l(pipeline->mu);
+          while (pipeline->chunks_in_flight >= 2) {
+            pipeline->cv.wait(l);
+          }
+          ++pipeline->chunks_in_flight;
+        }
+        void* chunk =
+            staging_pool->Acquire(host_memory_allocator, copy_bytes);
+        std::memcpy(chunk, src_base + offset, copy_bytes);
+        DeviceMemoryBase gpu_dst_chunk(static_cast<char*>(dst_ptr) + offset,
+                                       copy_bytes);
+        recv_host_to_device_stream->ThenMemcpy(&gpu_dst_chunk, chunk,
+                                               copy_bytes);
+        dev_info->event_mgr->ThenExecute(
+            recv_host_to_device_stream,
+            [staging_pool, host_memory_allocator, chunk, copy_bytes,
+             pipeline]() {
+              staging_pool->Release(host_memory_allocator, chunk, copy_bytes);
+              mutex_lock l(pipeline->mu);
+              --pipeline->chunks_in_flight;
+              pipeline->cv.notify_one();
+            });
+      }
+      input_ref.Unref();
+      // staging_buffer stays nullptr; the chunk callbacks above return each
+      // chunk to the pool as its DMA completes.
+    } else if (do_staging) {
+      staging_buffer = staging_pool->Acquire(host_memory_allocator,
+                                             total_bytes);
       std::memcpy(staging_buffer, src_ptr, total_bytes);
       input_ref.Unref();
 
@@ -386,9 +433,12 @@ void GPUUtil::CopyCPUTensorToGPU(const Tensor* cpu_tensor,
   dev_info->event_mgr->ThenExecute(
       recv_host_to_device_stream,
       [recv_host_to_device_stream, done, input_ref, do_staging, staging_buffer,
-       host_memory_allocator]() {
+       host_memory_allocator, total_bytes]() {
         if (do_staging) {
-          host_memory_allocator->DeallocateRaw(staging_buffer);
+          if (staging_buffer != nullptr) {
+            GpuStagingBufferPool::singleton()->Release(
+                host_memory_allocator, staging_buffer, total_bytes);
+          }
         } else {
           input_ref.Unref();
         }
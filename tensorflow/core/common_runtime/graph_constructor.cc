@@ -45,14 +45,18 @@ limitations under the License.
 #include "tensorflow/core/graph/graph_debug_info_builder.h"
 #include "tensorflow/core/graph/tensor_id.h"
 #include "tensorflow/core/lib/core/errors.h"
+#include "tensorflow/core/lib/core/threadpool.h"
 #include "tensorflow/core/lib/gtl/flatmap.h"
 #include "tensorflow/core/lib/gtl/flatset.h"
 #include "tensorflow/core/lib/gtl/inlined_vector.h"
 #include "tensorflow/core/lib/strings/scanner.h"
 #include "tensorflow/core/lib/strings/str_util.h"
+#include "tensorflow/core/platform/cpu_info.h"
+#include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/errors.h"
 #include "tensorflow/core/platform/logging.h"
 #include "tensorflow/core/platform/macros.h"
+#include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/public/version.h"
 
 namespace tensorflow {
@@ -202,6 +206,7 @@ class GraphConstructor {
     TF_RETURN_IF_ERROR(ValidateInputMapAndControlDependencies());
     TF_RETURN_IF_ERROR(BuildNodeIndex());
     TF_RETURN_IF_ERROR(InitFromEdges());
+    TF_RETURN_IF_ERROR(PreValidateNodeDefs());
 
     // NOTE: Convert() invokes `consume_node_def()` on each node in the input
     // graph, so `get_node_def()` is no longer usable once it is called.
@@ -222,6 +227,13 @@ class GraphConstructor {
   Status ValidateInputMapAndControlDependencies();
   Status BuildNodeIndex();
   Status InitFromEdges();
+  // For large graphs that are not being imported into an existing graph,
+  // validates all NodeDefs against the op registry on a thread pool so that
+  // Convert() can skip the per-node ValidateNodeDef() call. Node creation and
+  // edge stitching stay sequential in Convert(): the Graph, its name index,
+  // and the topological ready-queue that detects cycles are single-threaded
+  // by design.
+  Status PreValidateNodeDefs();
   Status Convert();
   Status AddBackEdges();
   Status UpdateVersionDef();
@@ -337,6 +349,10 @@ class GraphConstructor {
   // Intermediate datastructure used to track the destinations of back edges.
   absl::flat_hash_set<int> merge_node_indices_;
 
+  // True if PreValidateNodeDefs() already validated every NodeDef, in which
+  // case Convert() skips its per-node validation.
+  bool nodes_prevalidated_ = false;
+
   // Mapping from node name to the index within node_defs_.
   struct NodeInfo {
     explicit NodeInfo(int i) : gdef_index(i), node(nullptr) {}
@@ -784,6 +800,63 @@ Status GraphConstructor::InitFromEdges() {
   return OkStatus();
 }
 
+namespace {
+
+// Minimum number of NodeDefs before PreValidateNodeDefs() spins up a thread
+// pool; below this the sequential validation in Convert() is cheaper than the
+// pool startup.
+constexpr int kMinNodesForParallelValidation = 10000;
+
+// Approximate cost of validating one NodeDef, in nanoseconds, used to shard
+// the validation loop.
+constexpr int64_t kValidateNodeDefCostNs = 5000;
+
+}  // namespace
+
+Status GraphConstructor::PreValidateNodeDefs() {
+  // The importing path validates node defs only after input remapping,
+  // prefixing and uniquification have modified them, so it cannot be
+  // validated up front.
+  if (opts_.importing || !opts_.validate_nodes) return OkStatus();
+  const int num_nodes = node_def_count();
+  if (num_nodes < kMinNodesForParallelValidation) return OkStatus();
+  const int num_threads = port::MaxParallelism();
+  if (num_threads < 2) return OkStatus();
+
+  thread::ThreadPool pool(Env::Default(), ThreadOptions(),
+                          "graph_def_validation", num_threads,
+                          /*low_latency_hint=*/false);
+  mutex mu;
+  Status status;
+  pool.ParallelFor(
+      num_nodes, kValidateNodeDefCostNs,
+      [this, &mu, &status](int64_t start, int64_t end) {
+        Status s;
+        for (int64_t n = start; n < end && s.ok(); ++n) {
+          const NodeDef& node_def = get_node_def(n);
+          const OpDef* op_def;
+          s = g_->op_registry()->LookUpOpDef(node_def.op(), &op_def);
+          if (!s.ok()) break;
+          if (opts_.add_default_attributes) {
+            // Validate against a copy with default attrs filled in; Convert()
+            // adds the defaults to the real NodeDef before building the node.
+            NodeDef with_defaults = node_def;
+            AddDefaultsToNodeDef(*op_def, &with_defaults);
+            s = ValidateNodeDef(with_defaults, *op_def);
+          } else {
+            s = ValidateNodeDef(node_def, *op_def);
+          }
+        }
+        if (!s.ok()) {
+          mutex_lock l(mu);
+          status.Update(s);
+        }
+      });
+  TF_RETURN_IF_ERROR(status);
+  nodes_prevalidated_ = true;
+  return OkStatus();
+}
+
 Status GraphConstructor::ValidateColocationConstraints(
     const NodeDef& node_def) {
   if (!opts_.validate_colocation_constraints || !opts_.importing)
@@ -1304,7 +1377,7 @@ Status GraphConstructor::Convert() {
       if (opts_.add_default_attributes) {
         AddDefaultsToNodeDef(*op_def, &node_def);
       }
-      if (opts_.validate_nodes) {
+      if (opts_.validate_nodes && !nodes_prevalidated_) {
         TF_RETURN_IF_ERROR(ValidateNodeDef(node_def, *op_def));
       }
     }
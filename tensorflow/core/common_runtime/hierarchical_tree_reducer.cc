@@ -0,0 +1,439 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/common_runtime/hierarchical_tree_reducer.h"
+
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "tensorflow/core/common_runtime/collective_rma_local.h"
+#include "tensorflow/core/common_runtime/collective_util.h"
+#include "tensorflow/core/common_runtime/dma_helper.h"
+#include "tensorflow/core/common_runtime/hierarchical_tree_broadcaster.h"
+#include "tensorflow/core/framework/allocator.h"
+#include "tensorflow/core/framework/device_base.h"
+#include "tensorflow/core/framework/op_kernel.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/lib/core/errors.h"
+#include "tensorflow/core/lib/core/notification.h"
+#include "tensorflow/core/lib/core/status.h"
+#include "tensorflow/core/lib/strings/strcat.h"
+#include "tensorflow/core/platform/types.h"
+#include "tensorflow/core/profiler/lib/traceme.h"
+
+namespace tensorflow {
+
+namespace {
+// Key to be used for BufRendezvous by HierarchicalTreeReducer.  `phase`
+// distinguishes reduce traffic from broadcast traffic, which may connect the
+// same pair of ranks within one subdiv.
+string ReduceBufKey(const string& exec_key, const char* phase, int subdiv,
+                    int src_rank, int dst_rank) {
+  return strings::StrCat(exec_key, ":", phase, ":", subdiv, ":", src_rank, ":",
+                         dst_rank);
+}
+}  // namespace
+
+HierarchicalTreeReducer::HierarchicalTreeReducer()
+    : col_ctx_(nullptr), col_params_(nullptr), done_(nullptr) {}
+
+HierarchicalTreeReducer::~HierarchicalTreeReducer() {
+  group_size_tensor_ready_.WaitForNotification();
+}
+
+int HierarchicalTreeReducer::GetDeviceTask(
+    int device_rank, const std::vector<int>& dev_per_task) {
+  int num_tasks = static_cast<int>(dev_per_task.size());
+  int task_lo = 0;
+  int task_hi = -1;
+  for (int ti = 0; ti < num_tasks; ti++) {
+    task_hi = task_lo + dev_per_task[ti];
+    if (task_lo <= device_rank && device_rank < task_hi) return ti;
+    task_lo = task_hi;
+  }
+  LOG(FATAL) << "Unexpected device rank " << device_rank << " for " << task_hi
+             << " devices";
+  return -1;
+}
+
+Status HierarchicalTreeReducer::InitializeCollectiveParams(
+    CollectiveParams* col_params) {
+  CHECK_EQ(col_params->instance.type, REDUCTION_COLLECTIVE);
+  CHECK_EQ(col_params->instance.impl_details.collective_name,
+           "HierarchicalTreeReduce");
+  const string& device_name =
+      col_params->group.members[col_params->default_rank].device.name();
+  // Start by counting the devices in each task.
+  // Precondition: device_names must be sorted so that all devices in
+  // the same task are adjacent.
+  std::vector<int> dev_per_task;
+  const string* prior_task_name = &col_params->group.members[0].task;
+  int dev_count = 1;
+  for (int di = 1; di < col_params->group.group_size; ++di) {
+    if (col_params->group.members[di].task != *prior_task_name) {
+      dev_per_task.push_back(dev_count);
+      dev_count = 1;
+      prior_task_name = &col_params->group.members[di].task;
+    } else {
+      ++dev_count;
+    }
+  }
+  dev_per_task.push_back(dev_count);
+  CHECK_EQ(col_params->group.num_tasks, dev_per_task.size());
+
+  // The reduction root is always global rank 0, so the subdiv structure is
+  // that of HierarchicalTreeBroadcaster with source_rank == 0: if there is
+  // more than one task, subdiv 0 is the inter-task exchange between the
+  // leading device of each task and subdiv ti+1 covers the devices of task
+  // ti; with one task there is a single subdiv over all devices.
+  int num_tasks = col_params->group.num_tasks;
+  int num_subdivs = num_tasks + (num_tasks > 1 ? 1 : 0);
+
+  col_params->instance.impl_details.subdiv_permutations.resize(num_subdivs);
+  col_params->subdiv_rank.reserve(num_subdivs);
+  col_params->instance.impl_details.subdiv_source_rank.reserve(num_subdivs);
+
+  // Inter-task subdiv.  The leading device of each task participates.
+  if (num_tasks > 1) {
+    const int sdi = 0;
+    std::vector<int>& perm =
+        col_params->instance.impl_details.subdiv_permutations[sdi];
+    CHECK_EQ(perm.size(), 0);
+    int device_count = 0;
+    for (int ti = 0; ti < num_tasks; ti++) {
+      perm.push_back(device_count);
+      if (col_params->group.members[device_count].device.name() ==
+          device_name) {
+        col_params->subdiv_rank.push_back(ti);
+      }
+      device_count += dev_per_task[ti];
+    }
+    if (col_params->subdiv_rank.empty()) col_params->subdiv_rank.push_back(-1);
+    col_params->instance.impl_details.subdiv_source_rank.push_back(0);
+  }
+
+  // Intra-task subdivs.  All devices in task ti participate, rooted at the
+  // task's leading device.
+  int abs_di = 0;
+  for (int ti = 0; ti < num_tasks; ti++) {
+    const int sdi = ti + (num_tasks > 1 ? 1 : 0);
+    std::vector<int>& perm =
+        col_params->instance.impl_details.subdiv_permutations[sdi];
+    CHECK_EQ(perm.size(), 0);
+    bool participate = false;
+    for (int di = 0; di < dev_per_task[ti]; di++) {
+      perm.push_back(abs_di);
+      if (col_params->group.members[abs_di].device.name() == device_name) {
+        participate = true;
+        col_params->subdiv_rank.push_back(di);
+      }
+      abs_di++;
+    }
+    if (!participate) col_params->subdiv_rank.push_back(-1);
+    col_params->instance.impl_details.subdiv_source_rank.push_back(0);
+  }
+
+  VLOG(2) << collective_util::SubdivPermDebugString(*col_params);
+  return OkStatus();
+}
+
+Status HierarchicalTreeReducer::InitializeCollectiveContext(
+    std::shared_ptr<CollectiveContext> col_ctx) {
+  CHECK(col_ctx->dev_mgr);
+  col_ctx_ = col_ctx;
+  col_params_ = col_ctx->col_params.get();
+  return collective_util::InitializeDeviceAndLocality(
+      col_ctx->dev_mgr, col_ctx->device_name, &col_ctx->device,
+      &col_ctx->device_locality);
+}
+
+void HierarchicalTreeReducer::Run(StatusCallback done) {
+  CHECK(col_ctx_);
+  CHECK(col_params_);
+  // Like RingReducer, this collective does not require non-overlapping
+  // execution with its dependencies.
+  col_ctx_->col_exec->UnblockDependencies(*col_params_);
+  done_ = std::move(done);
+
+  // Start by copying input to output if they're not already the same, i.e. if
+  // we're not computing in-place on the input tensor.
+  if ((col_ctx_->input != col_ctx_->output) &&
+      (DMAHelper::base(col_ctx_->input) != DMAHelper::base(col_ctx_->output))) {
+    // We are running in a blockable thread and the callback can't block so
+    // just wait here on the copy.
+    Notification note;
+    Status status;
+    profiler::TraceMe activity("MemCpyAsync", profiler::TraceMeLevel::kInfo);
+    CollectiveRemoteAccessLocal::MemCpyAsync(
+        col_ctx_->op_ctx->op_device_context(),
+        col_ctx_->op_ctx->op_device_context(), col_ctx_->device,
+        col_ctx_->device, col_ctx_->op_ctx->input_alloc_attr(0),
+        col_ctx_->op_ctx->output_alloc_attr(0), col_ctx_->input,
+        col_ctx_->output, 0 /*dev_to_dev_stream_index*/,
+        [&note, &status](const Status& s) {
+          status.Update(s);
+          note.Notify();
+        });
+    note.WaitForNotification();
+    if (!status.ok()) {
+      group_size_tensor_ready_.Notify();
+      done_(status);
+      return;
+    }
+  }
+
+  AllocatorAttributes attr = col_ctx_->op_ctx->output_alloc_attr(0);
+  Allocator* allocator = col_ctx_->device->GetAllocator(attr);
+  ca_.reset(MakeCollectiveAdapter(col_ctx_->output, 1 /*num_chunks*/,
+                                  allocator));
+
+  // Create an on-device scalar value from the group size for the final op.
+  if (col_params_->final_op) {
+    Tensor group_size_val = ca_->Scalar(col_params_->group.group_size);
+    if (col_params_->group.device_type != "CPU") {
+      uint64 safe_alloc_frontier = col_ctx_->device->SafeAllocFrontier(0);
+      AllocationAttributes aa;
+      std::function<uint64()> freed_by_func = [this, &safe_alloc_frontier]() {
+        safe_alloc_frontier =
+            col_ctx_->device->SafeAllocFrontier(safe_alloc_frontier);
+        return safe_alloc_frontier;
+      };
+      if (safe_alloc_frontier > 0) {
+        aa.freed_by_func = &freed_by_func;
+      }
+      group_size_tensor_ = ca_->Scalar(
+          col_ctx_->device->GetAllocator(col_ctx_->op_ctx->input_alloc_attr(0)),
+          aa);
+      DeviceContext* op_dev_ctx = col_ctx_->op_ctx->op_device_context();
+      op_dev_ctx->CopyCPUTensorToDevice(
+          &group_size_val, col_ctx_->device, &group_size_tensor_,
+          [this](const Status& s) {
+            // Runs concurrently with the reduce phases; recorded separately
+            // and folded into status_ by the root before the final op.
+            group_size_status_.Update(s);
+            group_size_tensor_ready_.Notify();
+          },
+          (safe_alloc_frontier == 0));
+    } else {
+      group_size_tensor_ = group_size_val;
+      group_size_tensor_ready_.Notify();
+    }
+  } else {
+    // Value won't be used, so no need to initialize.
+    group_size_tensor_ready_.Notify();
+  }
+
+  // Scratch buffer for receiving peer partial values during the reduce
+  // phases.  Receives are sequential, so one buffer suffices.
+  tmp_ = Tensor(allocator, col_ctx_->output->dtype(),
+                col_ctx_->output->shape());
+
+  const DeviceBase::AcceleratorDeviceInfo* gpu_info =
+      col_ctx_->device->tensorflow_accelerator_device_info();
+  if (gpu_info) {
+    // Wait for all currently queued events on the CPU compute stream to
+    // complete before proceeding.  The scratch buffer allocated above is not
+    // guaranteed to be valid (e.g. for RDMA write) unless we do.
+    profiler::TraceMe activity("WaitForQueuedEvents",
+                               profiler::TraceMeLevel::kInfo);
+    Notification note;
+    Status s = gpu_info->default_context->ThenExecute(
+        col_ctx_->device, gpu_info->stream, [&note]() { note.Notify(); });
+    if (s.ok()) {
+      note.WaitForNotification();
+    } else {
+      done_(errors::Internal(
+          "Failed to dispatch ThenExecute in HierarchicalTreeReducer"));
+      return;
+    }
+  }
+
+  RunHierarchy();
+  VLOG(2) << "device=" << col_ctx_->device_name << " return status " << status_;
+  done_(status_);
+}
+
+bool HierarchicalTreeReducer::RunHierarchy() {
+  const int num_subdivs = static_cast<int>(col_params_->subdiv_rank.size());
+  const bool multi_task = num_subdivs > 1;
+
+  // Find the intra-task subdiv this device belongs to.  With one task that is
+  // subdiv 0; otherwise it is the unique subdiv >= 1 with a valid rank.
+  int intra_sdi = 0;
+  if (multi_task) {
+    for (int si = 1; si < num_subdivs; ++si) {
+      if (col_params_->subdiv_rank[si] != -1) intra_sdi = si;
+    }
+    DCHECK_GT(intra_sdi, 0);
+  }
+
+  // Phase 1: reduce within the task, towards its leading device.
+  if (!RunTreeReduce(intra_sdi)) return false;
+
+  // Phase 2: reduce the per-task partial results across tasks, towards the
+  // leading device of task 0.
+  if (multi_task && !RunTreeReduce(0)) return false;
+
+  // The global root now holds the full reduction; apply the final op (e.g.
+  // division by group size for a mean) before redistributing, so every other
+  // device receives finalized values.
+  const int root_subdiv = multi_task ? 0 : intra_sdi;
+  if (col_params_->subdiv_rank[root_subdiv] == 0 && col_params_->final_op) {
+    profiler::TraceMe activity("FinalOp", profiler::TraceMeLevel::kInfo);
+    group_size_tensor_ready_.WaitForNotification();
+    if (!group_size_status_.ok()) {
+      status_.Update(group_size_status_);
+      return false;
+    }
+    Status s = collective_util::ComputeBinOp(
+        col_ctx_->op_ctx, col_ctx_->op_params, col_ctx_->device,
+        col_params_->final_op, col_ctx_->output, &group_size_tensor_);
+    if (!s.ok()) {
+      status_.Update(s);
+      return false;
+    }
+  }
+
+  // Phase 3: broadcast the result back to the leading device of each task.
+  if (multi_task && !RunTreeBroadcast(0)) return false;
+
+  // Phase 4: broadcast within each task.
+  return RunTreeBroadcast(intra_sdi);
+}
+
+bool HierarchicalTreeReducer::RunTreeReduce(int subdiv) {
+  const int my_rank = col_params_->subdiv_rank[subdiv];
+  if (my_rank == -1) return true;
+  profiler::TraceMe activity(
+      [&] { return strings::StrCat("TreeReduce:", subdiv); },
+      profiler::TraceMeLevel::kInfo);
+
+  // Receive and merge the partial value of each child.
+  std::vector<int> children;
+  HierarchicalTreeBroadcaster::TreeSendTo(*col_params_, subdiv, &children);
+  for (int child_rank : children) {
+    if (!DispatchRecvAndWait("red", subdiv, child_rank, my_rank, &tmp_)) {
+      return false;
+    }
+    Status s = collective_util::ComputeBinOp(
+        col_ctx_->op_ctx, col_ctx_->op_params, col_ctx_->device,
+        col_params_->merge_op, col_ctx_->output, &tmp_);
+    if (!s.ok()) {
+      status_.Update(s);
+      return false;
+    }
+  }
+
+  // Send the merged value up to the parent.
+  const int parent_rank =
+      HierarchicalTreeBroadcaster::TreeRecvFrom(*col_params_, subdiv);
+  if (parent_rank >= 0) {
+    return DispatchSendAndWait("red", subdiv, parent_rank, my_rank,
+                               col_ctx_->output);
+  }
+  return true;
+}
+
+bool HierarchicalTreeReducer::RunTreeBroadcast(int subdiv) {
+  const int my_rank = col_params_->subdiv_rank[subdiv];
+  if (my_rank == -1) return true;
+  profiler::TraceMe activity(
+      [&] { return strings::StrCat("TreeBroadcast:", subdiv); },
+      profiler::TraceMeLevel::kInfo);
+
+  // Receive the final value from the parent, unless this device is the root.
+  const int parent_rank =
+      HierarchicalTreeBroadcaster::TreeRecvFrom(*col_params_, subdiv);
+  if (parent_rank >= 0 &&
+      !DispatchRecvAndWait("bcast", subdiv, parent_rank, my_rank,
+                           col_ctx_->output)) {
+    return false;
+  }
+
+  // Forward the final value to the children.
+  std::vector<int> children;
+  HierarchicalTreeBroadcaster::TreeSendTo(*col_params_, subdiv, &children);
+  for (int child_rank : children) {
+    if (!DispatchSendAndWait("bcast", subdiv, child_rank, my_rank,
+                             col_ctx_->output)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool HierarchicalTreeReducer::DispatchSendAndWait(const char* phase,
+                                                  int subdiv, int dst_rank,
+                                                  int src_rank,
+                                                  const Tensor* src_tensor) {
+  const string send_buf_key =
+      ReduceBufKey(col_ctx_->exec_key, phase, subdiv, src_rank, dst_rank);
+  const int dst_idx =
+      col_params_->instance.impl_details.subdiv_permutations[subdiv][dst_rank];
+  VLOG(3) << "DispatchSendAndWait " << send_buf_key << " from_device "
+          << col_ctx_->device_name << " to_device "
+          << col_params_->group.members[dst_idx].device.name()
+          << " subdiv=" << subdiv << " dst_rank=" << dst_rank
+          << " dst_idx=" << dst_idx;
+  Notification note;
+  col_ctx_->col_exec->remote_access()->PostToPeer(
+      col_params_->group.members[dst_idx].device.name(),
+      col_params_->group.members[dst_idx].task, send_buf_key, col_ctx_->device,
+      col_ctx_->op_ctx->op_device_context(),
+      col_ctx_->op_ctx->output_alloc_attr(0), src_tensor,
+      col_ctx_->device_locality, col_ctx_->op_ctx->cancellation_manager(),
+      [this, &note](const Status& s) {
+        status_.Update(s);
+        note.Notify();
+      });
+  note.WaitForNotification();
+  return status_.ok();
+}
+
+bool HierarchicalTreeReducer::DispatchRecvAndWait(const char* phase,
+                                                  int subdiv, int src_rank,
+                                                  int dst_rank,
+                                                  Tensor* dst_tensor) {
+  const string recv_buf_key =
+      ReduceBufKey(col_ctx_->exec_key, phase, subdiv, src_rank, dst_rank);
+  const int src_idx =
+      col_params_->instance.impl_details.subdiv_permutations[subdiv][src_rank];
+  VLOG(3) << "DispatchRecvAndWait " << recv_buf_key << " from_device "
+          << col_params_->group.members[src_idx].device.name() << " to_device "
+          << col_ctx_->device_name << " subdiv=" << subdiv
+          << " src_rank=" << src_rank << " src_idx=" << src_idx;
+  Notification note;
+  col_ctx_->col_exec->remote_access()->RecvFromPeer(
+      col_params_->group.members[src_idx].device.name(),
+      col_params_->group.members[src_idx].task,
+      col_params_->group.members[src_idx].is_local, recv_buf_key,
+      col_ctx_->device, col_ctx_->op_ctx->op_device_context(),
+      col_ctx_->op_ctx->output_alloc_attr(0), dst_tensor,
+      col_ctx_->device_locality, 0 /*stream_index*/,
+      col_ctx_->op_ctx->cancellation_manager(),
+      [this, &note](const Status& s) {
+        status_.Update(s);
+        note.Notify();
+      });
+  note.WaitForNotification();
+  return status_.ok();
+}
+
+namespace {
+REGISTER_COLLECTIVE(HierarchicalTreeReduce, HierarchicalTreeReducer);
+}  // namespace
+
+}  // namespace tensorflow
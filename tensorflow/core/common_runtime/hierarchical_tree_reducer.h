@@ -0,0 +1,101 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_CORE_COMMON_RUNTIME_HIERARCHICAL_TREE_REDUCER_H_
+#define TENSORFLOW_CORE_COMMON_RUNTIME_HIERARCHICAL_TREE_REDUCER_H_
+
+#include <memory>
+#include <vector>
+
+#include "tensorflow/core/common_runtime/base_collective_executor.h"
+#include "tensorflow/core/framework/collective.h"
+#include "tensorflow/core/lib/core/notification.h"
+
+namespace tensorflow {
+
+// Hierarchical tree-algorithm implementation of collective all-reduce.
+//
+// When the group spans several tasks, a flat ring moves every chunk across the
+// inter-task links on every hop, wasting the fast intra-task interconnect
+// (e.g. NVLink). This implementation reduces within each task first, exchanges
+// only one partial result per task across the slow links, and then broadcasts
+// the final value back within each task.
+class HierarchicalTreeReducer : public CollectiveImplementationInterface {
+ public:
+  HierarchicalTreeReducer();
+  ~HierarchicalTreeReducer() override;
+
+  // Establishes the subdiv permutations needed for a hierarchical reduce,
+  // using the same structure as HierarchicalTreeBroadcaster with the
+  // reduction root at rank 0.  If all devices are local, establishes a single
+  // subdiv comprising all devices.  If any devices are on a different task,
+  // establishes n+1 subdivs for n tasks: the first comprises the leading
+  // device of each task, and subdiv i+1 comprises all devices of task i.
+  Status InitializeCollectiveParams(CollectiveParams* col_params) override;
+
+  Status InitializeCollectiveContext(
+      std::shared_ptr<CollectiveContext> col_ctx) override;
+
+  // Begins execution of the hierarchical reduce.
+  // Must be called in a blockable thread.
+  void Run(StatusCallback done) override;
+
+ private:
+  // Get the task to which the device at `device_rank` belongs.
+  int GetDeviceTask(int device_rank, const std::vector<int>& dev_per_task);
+
+  // Runs the phases of the hierarchy in order: intra-task tree reduce,
+  // inter-task tree reduce, final op at the root, inter-task tree broadcast,
+  // intra-task tree broadcast.  Returns false if the collective was aborted.
+  bool RunHierarchy();
+
+  // Tree-reduces `col_ctx_->output` towards rank 0 of `subdiv`: receives and
+  // merges the partial value of each child, then sends the merged value to
+  // the parent.  Returns false on error.
+  bool RunTreeReduce(int subdiv);
+
+  // Tree-broadcasts `col_ctx_->output` from rank 0 of `subdiv`.  Returns
+  // false on error.
+  bool RunTreeBroadcast(int subdiv);
+
+  // Sends `src_tensor` from this device to the device at `dst_rank` in
+  // `subdiv` and blocks until the send has been consumed.  `phase`
+  // distinguishes reduce from broadcast traffic in the rendezvous key.
+  bool DispatchSendAndWait(const char* phase, int subdiv, int dst_rank,
+                           int src_rank, const Tensor* src_tensor);
+
+  // Receives into `dst_tensor` on this device from the device at `src_rank`
+  // in `subdiv` and blocks until the value has arrived.
+  bool DispatchRecvAndWait(const char* phase, int subdiv, int src_rank,
+                           int dst_rank, Tensor* dst_tensor);
+
+  std::shared_ptr<CollectiveContext> col_ctx_;
+  const CollectiveParams* col_params_;  // Not owned
+  StatusCallback done_;
+  Status status_;
+  std::unique_ptr<CollectiveAdapter> ca_;
+  // Scratch tensor into which peer partial values are received before being
+  // merged into the output.  Receives are sequential, so one buffer suffices.
+  Tensor tmp_;
+  Tensor group_size_tensor_;
+  Notification group_size_tensor_ready_;
+  // Status of the async group-size scalar copy; folded into status_ by the
+  // root device after group_size_tensor_ready_ fires.
+  Status group_size_status_;
+
+  friend class HierarchicalTreeReducerInitParamsTest;
+};
+
+}  // namespace tensorflow
+#endif  // TENSORFLOW_CORE_COMMON_RUNTIME_HIERARCHICAL_TREE_REDUCER_H_
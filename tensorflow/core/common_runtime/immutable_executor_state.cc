@@ -19,6 +19,7 @@ limitations under the License.
 #include "tensorflow/core/framework/function.h"
 #include "tensorflow/core/framework/metrics.h"
 #include "tensorflow/core/framework/node_def_util.h"
+#include "tensorflow/core/graph/algorithm.h"
 #include "tensorflow/core/graph/edgeset.h"
 #include "tensorflow/core/graph/graph.h"
 #include "tensorflow/core/graph/graph_node_util.h"
@@ -96,6 +97,35 @@ Status ImmutableExecutorState::Initialize(const Graph& graph) {
 
   pending_ids_.resize(gview_.num_nodes());
 
+  // Allocate pending-count handles in reverse post-order rather than node-id
+  // order. A handle is a plain byte offset into its frame's PendingCounts
+  // arena, so allocating in approximate execution order packs the counters of
+  // nodes that become ready around the same time into the same cache lines.
+  // On large graphs this noticeably reduces cache misses in the activation
+  // loop of `PropagateOutputs`. Handles are still looked up through
+  // `pending_ids_[id]`, so only the memory layout changes.
+  {
+    std::vector<bool> has_handle(gview_.num_nodes(), false);
+    const auto create_handle = [this, &cf_info, &has_handle](const Node* n) {
+      size_t max_pending, max_dead;
+      GetMaxPendingCounts(n, &max_pending, &max_dead);
+      FrameInfo* frame_info = EnsureFrameInfo(cf_info.frame_names[n->id()]);
+      pending_ids_[n->id()] = frame_info->pending_counts_layout.CreateHandle(
+          max_pending, max_dead);
+      has_handle[n->id()] = true;
+    };
+    std::vector<Node*> reverse_post_order;
+    GetReversePostOrder(graph, &reverse_post_order);
+    for (const Node* n : reverse_post_order) {
+      if (!IsSink(n)) create_handle(n);
+    }
+    // The traversal only reaches nodes connected to the source node; any
+    // remaining nodes get their handles in node-id order.
+    for (const Node* n : graph.nodes()) {
+      if (!IsSink(n) && !has_handle[n->id()]) create_handle(n);
+    }
+  }
+
   // Preprocess every node in the graph to create an instance of op
   // kernel for each node.
   requires_control_flow_ = false;
@@ -197,15 +227,6 @@ Status ImmutableExecutorState::Initialize(const Graph& graph) {
     item->is_next_iteration = IsNextIteration(n);
     item->is_distributed_communication = IsDistributedCommunication(n);
 
-    // Compute the maximum values we'll store for this node in the
-    // pending counts data structure, and allocate a handle in
-    // that frame's pending counts data structure that has enough
-    // space to store these maximal count values.
-    size_t max_pending, max_dead;
-    GetMaxPendingCounts(n, &max_pending, &max_dead);
-    pending_ids_[id] =
-        frame_info->pending_counts_layout.CreateHandle(max_pending, max_dead);
-
     // See if this node is a root node, and if so, add item to root_nodes_.
     if (n->in_edges().empty()) {
       root_nodes_.push_back(item);
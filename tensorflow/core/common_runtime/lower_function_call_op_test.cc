@@ -30,6 +30,7 @@ limitations under the License.
 #include "tensorflow/core/graph/graph_def_builder.h"
 #include "tensorflow/core/lib/core/status_test_util.h"
 #include "tensorflow/core/lib/strings/str_util.h"
+#include "tensorflow/core/lib/strings/strcat.h"
 #include "tensorflow/core/platform/test.h"
 
 namespace tensorflow {
@@ -133,6 +134,93 @@ TEST(LowerFunctionCallTest, InlineFunctionCall) {
   }
 }
 
+TEST(LowerFunctionCallTest, InlineByCostSkipsLargeFunctions) {
+  using FDH = FunctionDefHelper;
+
+  // With a ratio of 1, one input and one output, only bodies of at most ten
+  // nodes are inlined (frame cost 8 + 1 arg + 1 retval).
+  setenv("TF_FUNCTION_INLINING_COST_RATIO", "1", 1 /* replace */);
+
+  std::unique_ptr<Graph> graph(new Graph(OpRegistry::Global()));
+
+  FunctionDefLibrary f_lib_proto;
+  *(f_lib_proto.add_function()) =
+      FDH::Create("AddAndMul", {"i: int32"}, {"o: int32"}, {},
+                  {{{"add"}, "Add", {"i", "i"}, {{"T", DT_INT32}}},
+                   {{"ret"}, "Mul", {"i", "i"}, {{"T", DT_INT32}}}},
+                  /*ret_def=*/{{"o", "ret:z:0"}},
+                  /*control_ret_def=*/{{"must_execute", "add"}});
+
+  // A chain of twelve Adds exceeds the inlining budget.
+  std::vector<FDH::Node> big_body;
+  string prev = "i";
+  for (int i = 0; i < 12; ++i) {
+    string name = strings::StrCat("add_", i);
+    big_body.push_back({{name}, "Add", {prev, prev}, {{"T", DT_INT32}}});
+    prev = strings::StrCat(name, ":z:0");
+  }
+  *(f_lib_proto.add_function()) =
+      FDH::Create("BigChain", {"i: int32"}, {"o: int32"}, {}, big_body,
+                  /*ret_def=*/{{"o", prev}},
+                  /*control_ret_def=*/{});
+
+  // Construct a graph:
+  //   A = Placeholder[dtype=int32]
+  //   F = PartitionedCall[f=AddAndMul](a)
+  //   G = PartitionedCall[f=BigChain](a)
+  Scope root = Scope::NewRootScope().ExitOnError();
+  TF_ASSERT_OK(root.graph()->AddFunctionLibrary(f_lib_proto));
+  auto a = ops::Placeholder(root.WithOpName("A"), DT_INT32);
+  std::vector<NodeBuilder::NodeOut> inputs({NodeBuilder::NodeOut(a.node())});
+  Node* small_call;
+  TF_ASSERT_OK(NodeBuilder("F", "PartitionedCall", &root.graph()->flib_def())
+                   .Input(inputs)
+                   .Attr("Tin", {DT_INT32})
+                   .Attr("Tout", {DT_INT32})
+                   .Attr("f", FuncAttr("AddAndMul"))
+                   .Finalize(root.graph(), &small_call));
+  TF_ASSERT_OK(root.DoShapeInference(small_call));
+  Node* big_call;
+  TF_ASSERT_OK(NodeBuilder("G", "PartitionedCall", &root.graph()->flib_def())
+                   .Input(inputs)
+                   .Attr("Tin", {DT_INT32})
+                   .Attr("Tout", {DT_INT32})
+                   .Attr("f", FuncAttr("BigChain"))
+                   .Finalize(root.graph(), &big_call));
+  TF_ASSERT_OK(root.DoShapeInference(big_call));
+
+  auto b = ops::Identity(root.WithOpName("B"), Output(small_call, 0));
+  auto c = ops::Identity(root.WithOpName("C"), Output(big_call, 0));
+
+  TF_ASSERT_OK(root.ToGraph(graph.get()));
+  TF_ASSERT_OK(Rewrite(&graph));
+
+  // The small function was inlined, the large one is still a function call.
+  int partitioned_call_count = 0;
+  int mul_count = 0;
+  for (const auto* op : graph->op_nodes()) {
+    if (op->IsPartitionedCall()) partitioned_call_count++;
+    if (op->type_string() == "Mul") mul_count++;
+  }
+
+  ASSERT_EQ(partitioned_call_count, 1);
+  ASSERT_EQ(mul_count, 1);
+
+  // Verify execution of both the inlined and the non-inlined call.
+  ClientSession session(root, SessionOptionsWithInlining());
+  {
+    ClientSession::FeedType feeds;
+    feeds.emplace(Output(a.node()), Input::Initializer(2));
+    std::vector<Tensor> out_tensors;
+    TF_ASSERT_OK(session.Run(feeds, {Output(b), Output(c)}, &out_tensors));
+    EXPECT_EQ(out_tensors.size(), 2);
+    EXPECT_EQ(out_tensors[0].scalar<int>()(), 4);
+    EXPECT_EQ(out_tensors[1].scalar<int>()(), 2 << 12);
+  }
+
+  unsetenv("TF_FUNCTION_INLINING_COST_RATIO");
+}
+
 TEST(LowerFunctionCallTest, DoNotInlineTpuOrXlaFunctions) {
   std::unique_ptr<Graph> graph(new Graph(OpRegistry::Global()));
 
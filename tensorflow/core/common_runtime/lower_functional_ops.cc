@@ -26,9 +26,11 @@ limitations under the License.
 #include "tensorflow/core/common_runtime/lower_if_op.h"
 #include "tensorflow/core/common_runtime/lower_while_op.h"
 #include "tensorflow/core/framework/node_def_util.h"
+#include "tensorflow/core/framework/function.h"
 #include "tensorflow/core/graph/graph.h"
 #include "tensorflow/core/graph/graph_node_util.h"
 #include "tensorflow/core/public/session_options.h"
+#include "tensorflow/core/util/env_var.h"
 
 namespace tensorflow {
 
@@ -81,6 +83,39 @@ bool HasArgsOrRetvals(const Graph& g) {
   return false;
 }
 
+// Cost-guided inlining policy. Inlining a function call removes the per-call
+// overhead (call frame setup and one executor hop for each _Arg and _Retval
+// kernel), but duplicating a large function body at every call site bloats
+// the graph and slows down the optimization passes that run after lowering.
+// A call is inlined when the body has at most `cost_ratio` nodes per unit of
+// per-call overhead; a non-positive ratio (the default) keeps the historical
+// behavior of inlining every call. Calls that are lowered for correctness
+// rather than performance (multi-device function calls) are always inlined.
+bool ShouldInlineFunctionCallByCost(const FunctionLibraryDefinition& flib_def,
+                                    const Node* n, int64_t cost_ratio) {
+  if (cost_ratio <= 0) return true;
+  if (LowerAsMultiDeviceFunctionIsOn(n)) return true;
+
+  const FunctionDef* fdef = nullptr;
+  if (n->IsPartitionedCall()) {
+    NameAttrList func;
+    if (!TryGetNodeAttr(n->attrs(), "f", &func)) return true;
+    fdef = flib_def.Find(func.name());
+  } else {
+    fdef = flib_def.Find(n->type_string());
+  }
+  // Missing functions are reported by the rewrite itself.
+  if (fdef == nullptr) return true;
+
+  // Frame setup amortized as a constant, plus one op per argument and return
+  // value.
+  constexpr int64_t kCallFrameCost = 8;
+  const int64_t per_call_overhead = kCallFrameCost +
+                                    fdef->signature().input_arg_size() +
+                                    fdef->signature().output_arg_size();
+  return fdef->node_def_size() <= cost_ratio * per_call_overhead;
+}
+
 const absl::flat_hash_set<std::string>& DevicePropagationOpList() {
   // Control flow ops and Identity ops which are inserted by function call
   // inlining.
@@ -126,6 +161,13 @@ Status LowerFunctionalOpsPass::Run(
                                      .optimizer_options()
                                      .do_function_inlining();
 
+  // Re-read the inlining cost ratio on every pass run so a serving binary can
+  // flip it between sessions.
+  int64_t inline_cost_ratio = 0;
+  TF_RETURN_IF_ERROR(ReadInt64FromEnvVar("TF_FUNCTION_INLINING_COST_RATIO",
+                                         /*default_val=*/0,
+                                         &inline_cost_ratio));
+
   // If graph is a function instantiation, it will have `_Arg` and `_Retval`
   // nodes for input and output tensors. Otherwise it's unsafe to remove any of
   // the nodes, because they might be later used as fetches.
@@ -170,7 +212,8 @@ Status LowerFunctionalOpsPass::Run(
 
     // Always lower function calls produced by lowering If/While nodes.
     if (IsFunctionCall(*flib_def, *n) && !used_by_xla(n) &&
-        (lower_function_calls || LowerAsMultiDeviceFunctionIsOn(n))) {
+        (lower_function_calls || LowerAsMultiDeviceFunctionIsOn(n)) &&
+        ShouldInlineFunctionCallByCost(*flib_def, n, inline_cost_ratio)) {
       TF_RETURN_IF_ERROR(RewriteFunctionCallNode(n, g, *flib_def,
                                                  keep_lowered_nodes_fetchable));
       continue;
@@ -15,6 +15,8 @@ limitations under the License.
 
 #include "tensorflow/core/common_runtime/lower_while_op.h"
 
+#include <cstdlib>
+
 #include "tensorflow/core/common_runtime/inline_function_utils.h"
 #include "tensorflow/core/framework/node_def_builder.h"
 #include "tensorflow/core/framework/types.pb.h"
@@ -30,6 +32,54 @@ using NodeOut = NodeBuilder::NodeOut;
 constexpr const char* const kLowerAsMultiDeviceFunctionAttr =
     LowerFunctionalOpsConstants::kLowerAsMultiDeviceFunctionAttr;
 
+// Set TF_WHILE_LOOP_HOIST_INVARIANTS=1 to lower loop inputs that the body
+// function returns unchanged the same way resource inputs are lowered: a
+// single constant Enter feeding cond and body directly, with no
+// Merge/Switch/NextIteration ring. The executor then shares one tensor across
+// all iterations of the frame instead of propagating it through the ring
+// every iteration.
+bool HoistLoopInvariantsEnabled() {
+  static bool enabled = [] {
+    const char* val = std::getenv("TF_WHILE_LOOP_HOIST_INVARIANTS");
+    return val != nullptr && val[0] == '1';
+  }();
+  return enabled;
+}
+
+// Set TF_WHILE_STATELESS_PARALLEL_ITERATIONS=K (K > 0) to raise the
+// parallel_iterations of lowered while loops whose cond and body functions
+// are entirely stateless to at least K. Such iterations only interact through
+// their loop-carried dataflow, so the executor may overlap up to K of them
+// without reordering any visible side effect. This recovers most of the lost
+// parallelism of map_fn-style elementwise loops, which default to a small
+// parallel_iterations value.
+int64_t StatelessParallelIterationsOverride() {
+  static int64_t value = [] {
+    const char* val = std::getenv("TF_WHILE_STATELESS_PARALLEL_ITERATIONS");
+    return val != nullptr ? strtol(val, nullptr, 10) : 0;
+  }();
+  return value;
+}
+
+// Returns true if function `fn` exists in `flib_def` and every node in its
+// body is stateless. Nested function calls are not expanded: a function's
+// signature is marked stateful when its body contains a stateful op, so the
+// op-level check covers them.
+bool IsStatelessFunction(const NameAttrList& fn,
+                         const FunctionLibraryDefinition* flib_def) {
+  const FunctionDef* fdef = flib_def->Find(fn.name());
+  if (fdef == nullptr) return false;
+  if (fdef->signature().is_stateful()) return false;
+  for (const NodeDef& node : fdef->node_def()) {
+    const OpDef* op_def = nullptr;
+    if (!flib_def->LookUpOpDef(node.op(), &op_def).ok() ||
+        op_def->is_stateful()) {
+      return false;
+    }
+  }
+  return true;
+}
+
 // Helper to convert a functional While op to its lowered form.
 //
 // Example:
@@ -132,6 +182,18 @@ class LowerWhileHelper {
   // returned as an output.
   bool IsLoopCarriedResource(int index);
 
+  // Returns true if the input at index is a non-resource tensor that the body
+  // function returns unchanged at the same output index, and hoisting of loop
+  // invariants is enabled. Such inputs are lowered like resources: a constant
+  // Enter feeding cond and body directly, with no per-iteration ring.
+  bool IsLoopInvariantInput(int index) { return loop_invariant_inputs_[index]; }
+
+  // Returns true if the input at index gets a constant Enter node and no
+  // Merge/Switch/NextIteration/Exit nodes.
+  bool IsConstantLoopInput(int index) {
+    return IsLoopCarriedResource(index) || IsLoopInvariantInput(index);
+  }
+
   // The original While op.
   Node* while_op_;
   // The call node for the cond branch.
@@ -175,6 +237,10 @@ class LowerWhileHelper {
   // in which case the mapping contains -1.
   std::vector<int> op_input_output_to_lowered_node_;
 
+  // True for inputs that the body function passes through unchanged, when
+  // `HoistLoopInvariantsEnabled()`. See `IsLoopInvariantInput`.
+  std::vector<bool> loop_invariant_inputs_;
+
   size_t num_loop_inputs_;
 };
 
@@ -211,6 +277,40 @@ LowerWhileHelper::LowerWhileHelper(Node* while_op, const NameAttrList& cond_fn,
   exit_nodes_.reserve(num_loop_inputs_);
   next_iterations_nodes_.reserve(num_loop_inputs_);
   op_input_output_to_lowered_node_.resize(num_loop_inputs_, -1);
+  loop_invariant_inputs_.resize(num_loop_inputs_, false);
+  if (HoistLoopInvariantsEnabled()) {
+    const FunctionDef* body_func = flib_def->Find(body_fn.name());
+    if (body_func != nullptr &&
+        body_func->signature().input_arg_size() ==
+            static_cast<int>(num_loop_inputs_) &&
+        body_func->signature().output_arg_size() ==
+            static_cast<int>(num_loop_inputs_)) {
+      for (int i = 0; i < static_cast<int>(num_loop_inputs_); i++) {
+        const DataType dtype = while_op_->input_type(i);
+        // Resources keep their dedicated lowering; ref tensors keep the ring.
+        if (dtype == DT_RESOURCE || IsRefType(dtype)) continue;
+        const string& arg_name = body_func->signature().input_arg(i).name();
+        const string& ret_name = body_func->signature().output_arg(i).name();
+        auto ret = body_func->ret().find(ret_name);
+        loop_invariant_inputs_[i] =
+            ret != body_func->ret().end() && ret->second == arg_name;
+      }
+      // The lowering needs at least one Merge and one Switch node for the
+      // frame's control edges (and a loop whose state is entirely invariant
+      // could never terminate anyway); if nothing would remain in the ring,
+      // fall back to the plain lowering.
+      bool has_ring_input = false;
+      for (int i = 0; i < static_cast<int>(num_loop_inputs_); i++) {
+        if (!IsLoopCarriedResource(i) && !loop_invariant_inputs_[i]) {
+          has_ring_input = true;
+          break;
+        }
+      }
+      if (!has_ring_input) {
+        loop_invariant_inputs_.assign(num_loop_inputs_, false);
+      }
+    }
+  }
 }
 
 Status LowerWhileHelper::RunInternal() {
@@ -230,7 +330,7 @@ Status LowerWhileHelper::RunInternal() {
 void LowerWhileHelper::InitializeInputOutputToLoweredNodeMap() {
   int counter = 0;
   for (int i = 0; i < num_loop_inputs_; i++) {
-    if (!IsLoopCarriedResource(i)) {
+    if (!IsConstantLoopInput(i)) {
       op_input_output_to_lowered_node_[i] = counter++;
     }
   }
@@ -251,7 +351,7 @@ Status LowerWhileHelper::CreateEnterNodes() {
             .Attr("parallel_iterations", parallel_iterations_)
             .Device(edge->src()->requested_device())
             .AssignedDevice(edge->src()->assigned_device_name());
-    if (IsLoopCarriedResource(edge->dst_input())) {
+    if (IsConstantLoopInput(edge->dst_input())) {
       builder.Attr("is_constant", true);
     }
     TF_RETURN_IF_ERROR(builder.Finalize(graph_, &enter_node));
@@ -282,7 +382,9 @@ Status LowerWhileHelper::CreateEnterNodes() {
 Status LowerWhileHelper::CreateMergeNodes() {
   for (Node* enter_node : enter_nodes_) {
     bool is_constant = enter_node->attrs().FindByString("is_constant")->b();
-    if (is_constant && enter_node->output_type(0) == DT_RESOURCE) {
+    if (is_constant) {
+      // Constant Enter nodes (loop-carried resources and hoisted loop
+      // invariants) are shared across iterations and do not get a ring.
       continue;
     }
     Node* merge_node;
@@ -299,7 +401,7 @@ Status LowerWhileHelper::CreateMergeNodes() {
 
 Status LowerWhileHelper::CreateCondFuncCallNode() {
   for (int i = 0; i < num_loop_inputs_; i++) {
-    if (IsLoopCarriedResource(i)) {
+    if (IsConstantLoopInput(i)) {
       cond_call_builder_.Input(NodeOut(enter_nodes_[i], 0));
     } else {
       cond_call_builder_.Input(
@@ -322,7 +424,7 @@ Status LowerWhileHelper::CreateCondFuncCallNode() {
 
 Status LowerWhileHelper::CreateSwitchNodes() {
   for (int i = 0; i < num_loop_inputs_; i++) {
-    if (IsLoopCarriedResource(i)) {
+    if (IsConstantLoopInput(i)) {
       continue;
     }
     string op_name;
@@ -351,7 +453,7 @@ Status LowerWhileHelper::CreateSwitchNodes() {
 
 Status LowerWhileHelper::CreateBodyFuncCallNode() {
   for (int i = 0; i < num_loop_inputs_; i++) {
-    if (IsLoopCarriedResource(i)) {
+    if (IsConstantLoopInput(i)) {
       body_call_builder_.Input(NodeOut(enter_nodes_[i], 0));
     } else {
       body_call_builder_.Input(
@@ -385,12 +487,13 @@ Status LowerWhileHelper::CreateExitNodes() {
   std::vector<NodeOut> outputs;
   outputs.reserve(num_loop_inputs_);
   for (int i = 0; i < num_loop_inputs_; i++) {
-    if (IsLoopCarriedResource(i)) {
+    if (IsConstantLoopInput(i)) {
       // Note(srbs): A resource output of this While should never be used but we
-      // need this for the IdentityN node below.
-      OutputTensor resource_tensor;
-      TF_RETURN_IF_ERROR(enter_nodes_[i]->input_tensor(0, &resource_tensor));
-      outputs.emplace_back(resource_tensor);
+      // need this for the IdentityN node below. Hoisted loop invariants leave
+      // the loop unchanged, so their output is simply the original input.
+      OutputTensor constant_tensor;
+      TF_RETURN_IF_ERROR(enter_nodes_[i]->input_tensor(0, &constant_tensor));
+      outputs.emplace_back(constant_tensor);
     } else {
       Node* exit_node;
       TF_RETURN_IF_ERROR(
@@ -445,7 +548,7 @@ Status LowerWhileHelper::CreateExitNodes() {
 Status LowerWhileHelper::CreateNextIterationNodes() {
   for (int i = 0; i < num_loop_inputs_; i++) {
     Node* next_iteration;
-    if (IsLoopCarriedResource(i)) {
+    if (IsConstantLoopInput(i)) {
       continue;
     }
     Node* merge_node = merge_nodes_[op_input_output_to_lowered_node_[i]];
@@ -474,11 +577,13 @@ Status LowerWhileHelper::UpdateConsumers() {
     if (e->IsControlEdge()) {
       graph_->AddControlEdge(lowered_while_executed_, e->dst());
     } else {
-      if (IsLoopCarriedResource(e->src_output())) {
-        OutputTensor resource;
+      if (IsConstantLoopInput(e->src_output())) {
+        // Resources and hoisted loop invariants leave the loop unchanged, so
+        // consumers can read the original input directly.
+        OutputTensor constant_input;
         TF_RETURN_IF_ERROR(
-            enter_nodes_[e->src_output()]->input_tensor(0, &resource));
-        graph_->AddEdge(resource.node, resource.index, e->dst(),
+            enter_nodes_[e->src_output()]->input_tensor(0, &constant_input));
+        graph_->AddEdge(constant_input.node, constant_input.index, e->dst(),
                         e->dst_input());
       } else {
         // Feed the outputs directly from the exit nodes so that downstream ops
@@ -538,8 +643,19 @@ Status RewriteWhileNode(Node* n, Graph* g,
     return errors::InvalidArgument("parallel_iterations must be > 0");
   }
 
+  int parallel_iterations = parallel_iterations_attr->i();
+  const int64_t stateless_override = StatelessParallelIterationsOverride();
+  if (stateless_override > parallel_iterations &&
+      IsStatelessFunction(cond_attr->func(), flib_def) &&
+      IsStatelessFunction(body_attr->func(), flib_def)) {
+    VLOG(2) << "While node " << n->name()
+            << " has stateless cond and body; raising parallel_iterations "
+            << "from " << parallel_iterations << " to " << stateless_override;
+    parallel_iterations = stateless_override;
+  }
+
   TF_RETURN_IF_ERROR(LowerWhileHelper::Run(
-      n, cond_attr->func(), body_attr->func(), parallel_iterations_attr->i(), g,
+      n, cond_attr->func(), body_attr->func(), parallel_iterations, g,
       flib_def, keep_node_fetchable));
   g->RemoveNode(n);
 
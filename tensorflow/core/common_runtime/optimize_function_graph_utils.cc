@@ -18,12 +18,14 @@ limitations under the License.
 #include <cstdlib>
 #include <iterator>
 #include <memory>
+#include <optional>
 #include <string>
 #include <type_traits>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/status/status.h"
 #include "absl/strings/str_cat.h"
 #include "absl/time/clock.h"
@@ -46,8 +48,12 @@ limitations under the License.
 #include "tensorflow/core/framework/optimized_function_graph.pb.h"
 #include "tensorflow/core/graph/graph.h"
 #include "tensorflow/core/graph/graph_node_util.h"
+#include "tensorflow/core/lib/strings/proto_serialization.h"
 #include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/fingerprint.h"
+#include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/util/debug_data_dumper.h"
+#include "tensorflow/core/util/env_var.h"
 #include "tsl/platform/env.h"
 #include "tsl/platform/errors.h"
 #include "tsl/platform/host_info.h"
@@ -253,6 +259,92 @@ string GetFileCacheName(const string& dir_name, const string& function_name,
                       tsl::port::TaskId(), "_", plain_func_name, "_",
                       fdef->node_def_size());
 }
+
+// True if the in-memory structural cache is enabled via
+// TF_FUNCTION_STRUCTURAL_CACHE. Read on each instantiation (like the file
+// cache directory) so tests can toggle it.
+bool StructuralCacheEnabled() {
+  bool enabled = false;
+  Status status = ReadBoolFromEnvVar(kFunctionStructuralCacheEnvVariableName,
+                                     false, &enabled);
+  if (!status.ok()) {
+    LOG(ERROR) << status.message();
+  }
+  return enabled;
+}
+
+// Process-wide cache of graph optimization results keyed by the structure of
+// the instantiation rather than by instantiation key. A serving binary that
+// instantiates one shared backbone under dozens of signature-specialized
+// function names maps them all to the same entry and runs the optimization
+// passes once.
+class StructuralOptimizationCache {
+ public:
+  static StructuralOptimizationCache& Global() {
+    static StructuralOptimizationCache* cache = new StructuralOptimizationCache;
+    return *cache;
+  }
+
+  std::optional<OptimizedFunctionGraph> Find(uint64 key) {
+    mutex_lock l(mu_);
+    const auto it = cache_.find(key);
+    if (it == cache_.end()) return std::nullopt;
+    return it->second;
+  }
+
+  void Insert(uint64 key, OptimizedFunctionGraph proto) {
+    mutex_lock l(mu_);
+    cache_.emplace(key, std::move(proto));
+  }
+
+ private:
+  mutex mu_;
+  absl::flat_hash_map<uint64, OptimizedFunctionGraph> cache_
+      TF_GUARDED_BY(mu_);
+};
+
+// Computes the structural cache key: the fingerprint of the function
+// definition with its name cleared (so signature-specialized clones of the
+// same body collide), the canonicalized instantiation attributes and options
+// (which cover the requested input/output devices, target and config), and
+// the device set the function is partitioned over.
+uint64 StructuralCacheKey(const FunctionDef& fdef, AttrSlice attrs,
+                          const FunctionLibraryRuntime::InstantiateOptions&
+                              options,
+                          const DeviceSet& dev_set) {
+  FunctionDef fdef_for_key = fdef;
+  fdef_for_key.mutable_signature()->clear_name();
+  string serialized;
+  SerializeToStringDeterministic(fdef_for_key, &serialized);
+  uint64 key = Fingerprint64(serialized);
+  key = FingerprintCat64(key, Fingerprint64(Canonicalize("", attrs, options)));
+  for (const Device* device : dev_set.devices()) {
+    key = FingerprintCat64(key, Fingerprint64(device->name()));
+  }
+  return key;
+}
+
+// Runs the graph optimization passes and, on success, publishes the result to
+// the structural cache when `structural_cache_key` is set.
+StatusOr<OptimizedFunctionGraphInfo> OptimizeFunctionGraphAndCacheStructurally(
+    const string& function_name, AttrSlice attrs,
+    const FunctionLibraryRuntime::InstantiateOptions& options,
+    const DeviceSet& dev_set, const FunctionLibraryDefinition* input_lib_def,
+    const std::vector<CompositeDevice*>& composite_devices, Device* cpu_device,
+    Device* default_device, Env* env,
+    std::optional<uint64> structural_cache_key) {
+  StatusOr<OptimizedFunctionGraphInfo> optimized_function_graph_info =
+      OptimizeFunctionGraph(function_name, attrs, options, dev_set,
+                            input_lib_def, composite_devices, cpu_device,
+                            default_device, env, OptimizedFunctionGraph::JIT);
+  if (optimized_function_graph_info.ok() &&
+      structural_cache_key.has_value()) {
+    StructuralOptimizationCache::Global().Insert(
+        *structural_cache_key,
+        OptimizedFunctionGraphInfo::ToProto(*optimized_function_graph_info));
+  }
+  return optimized_function_graph_info;
+}
 }  // namespace
 
 Status GetGraphAndArgRets(
@@ -652,15 +744,56 @@ StatusOr<OptimizedFunctionGraphInfo> OptimizeFunctionGraphOrReadFromFileCache(
   // (2) This function is eligible for caching and its cache exists.
   // (3) This function is eligible for caching and its cache does not exist.
 
+  // Consult the in-memory structural cache first: instantiations of the same
+  // function body under different signature-specialized names share one
+  // optimization result. Component functions are already-partitioned
+  // subgraphs and are skipped, as are instantiations that want their graphs
+  // collected.
+  std::optional<uint64> structural_cache_key;
+  if (StructuralCacheEnabled() && !options.is_component_function &&
+      options.graph_collector == nullptr) {
+    const FunctionLibraryDefinition* structural_lib_def =
+        options.lib_def == nullptr ? input_lib_def : options.lib_def;
+    const FunctionDef* structural_fdef =
+        structural_lib_def->Find(function_name);
+    if (structural_fdef != nullptr) {
+      structural_cache_key =
+          StructuralCacheKey(*structural_fdef, attrs, options, dev_set);
+      std::optional<OptimizedFunctionGraph> cached_graph =
+          StructuralOptimizationCache::Global().Find(*structural_cache_key);
+      if (cached_graph.has_value()) {
+        // The cached result was produced under a structurally identical
+        // sibling function; restore it under this function's name.
+        cached_graph->set_name(function_name);
+        StatusOr<OptimizedFunctionGraphInfo> optimized_function_graph_info =
+            OptimizedFunctionGraphInfo::FromProto(*cached_graph);
+        if (optimized_function_graph_info.ok()) {
+          metrics::UpdateFunctionGraphOptimizationSavingTime(
+              cached_graph->optimization_time_usecs(),
+              metrics::GraphOptimizationSource::kJit);
+          metrics::IncrementFunctionGraphOptimizationCacheHitCount(
+              1, metrics::GraphOptimizationSource::kJit);
+          VLOG(1) << "Restored the optimized graph for function "
+                  << function_name << " from the structural cache";
+          return optimized_function_graph_info;
+        }
+        LOG(ERROR) << "Restoring from the structural graph optimization "
+                      "cache failed; running the optimization passes "
+                      "instead. Error: "
+                   << optimized_function_graph_info.status();
+      }
+    }
+  }
+
   // Get the caching directory from Env variable.
   const string dir_name = absl::StrCat(getenv(kGraphCachingEnvVariableName));
 
   // Scenario (1): Not eligible for caching. Run the optimization passes.
   if (dir_name.empty() || options.is_component_function) {
-    return OptimizeFunctionGraph(function_name, attrs, options, dev_set,
-                                 input_lib_def, composite_devices, cpu_device,
-                                 default_device, env,
-                                 OptimizedFunctionGraph::JIT);
+    return OptimizeFunctionGraphAndCacheStructurally(
+        function_name, attrs, options, dev_set, input_lib_def,
+        composite_devices, cpu_device, default_device, env,
+        structural_cache_key);
   }
 
   const FunctionLibraryDefinition* lib_def =
@@ -706,10 +839,10 @@ StatusOr<OptimizedFunctionGraphInfo> OptimizeFunctionGraphOrReadFromFileCache(
         << "Reading from Tensorflow graph optimization cache failed. Continue "
            "to run the Tensorflow graph optimization passes instead. Error: "
         << optimized_function_graph_info.status();
-    return OptimizeFunctionGraph(function_name, attrs, options, dev_set,
-                                 input_lib_def, composite_devices, cpu_device,
-                                 default_device, env,
-                                 OptimizedFunctionGraph::JIT);
+    return OptimizeFunctionGraphAndCacheStructurally(
+        function_name, attrs, options, dev_set, input_lib_def,
+        composite_devices, cpu_device, default_device, env,
+        structural_cache_key);
   }
 
   // Scenario (3): No file cache exists for this function.
@@ -723,9 +856,10 @@ StatusOr<OptimizedFunctionGraphInfo> OptimizeFunctionGraphOrReadFromFileCache(
   absl::Time optimization_start_time = absl::Now();
   TF_ASSIGN_OR_RETURN(
       StatusOr<OptimizedFunctionGraphInfo> optimized_function_graph_info,
-      OptimizeFunctionGraph(function_name, attrs, options, dev_set,
-                            input_lib_def, composite_devices, cpu_device,
-                            default_device, env, OptimizedFunctionGraph::JIT));
+      OptimizeFunctionGraphAndCacheStructurally(
+          function_name, attrs, options, dev_set, input_lib_def,
+          composite_devices, cpu_device, default_device, env,
+          structural_cache_key));
   const absl::Duration graph_optimization_duration =
       absl::Now() - optimization_start_time;
   VLOG(3) << "Finished running the optimization passes; took "
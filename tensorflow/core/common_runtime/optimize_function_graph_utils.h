@@ -35,6 +35,13 @@ namespace tensorflow {
 // Note: if the caching location retrieved by the env variable is empty it means
 // no caching would be performed.
 static const char kGraphCachingEnvVariableName[] = "TF_GRAPH_CACHING";
+// The name of the env variable enabling the in-memory structural cache of
+// graph optimization results. When enabled, instantiations sharing the same
+// function structure (ignoring the function name), attributes and device set
+// reuse one optimization result, even when instantiated under different
+// signature-specialized function names.
+static const char kFunctionStructuralCacheEnvVariableName[] =
+    "TF_FUNCTION_STRUCTURAL_CACHE";
 // The threshold of the graph optimization duration to be cached.
 // Note: setting this threshold to 0 means to cache for every function.
 constexpr absl::Duration kCachingThresholdDuration = absl::Seconds(3);
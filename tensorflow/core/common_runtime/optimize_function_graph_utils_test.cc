@@ -245,5 +245,62 @@ TEST(OptimizeFunctionGraphTest, OptimizeFunctionGraphAndWriteToCache) {
   ASSERT_TRUE(empty_file_list.empty());
 }
 
+TEST(OptimizeFunctionGraphTest, StructuralCacheSharesResultAcrossNames) {
+  setenv(kFunctionStructuralCacheEnvVariableName, "1", 1);
+  unsetenv(kGraphCachingEnvVariableName);
+
+  FunctionLibraryRuntime::InstantiateOptions opts;
+  opts.is_multi_device_function = true;
+
+  // Two structurally identical functions under different names, as produced
+  // when a shared backbone is specialized per serving signature.
+  FunctionDefLibrary proto;
+  *(proto.add_function()) = test::function::FindDevice();
+  FunctionDef clone = test::function::FindDevice();
+  clone.mutable_signature()->set_name("FindDeviceClone");
+  *(proto.add_function()) = clone;
+  auto lib_def =
+      std::make_unique<FunctionLibraryDefinition>(OpRegistry::Global(), proto);
+
+  std::vector<std::unique_ptr<Device>> devices;
+  CreateCpuDeviceList(kDevicePrefix, 3, devices);
+  DeviceSet device_set;
+  for (const auto& device : devices) {
+    device_set.AddDevice(device.get());
+  }
+
+  const int64_t hits_before = metrics::GetFunctionGraphOptimizationCacheHitCount(
+      metrics::GraphOptimizationSource::kJit);
+
+  // The first instantiation runs the optimization passes and populates the
+  // structural cache.
+  StatusOr<OptimizedFunctionGraphInfo> first_result =
+      OptimizeFunctionGraphOrReadFromFileCache(
+          "FindDevice", {}, opts, device_set, lib_def.get(),
+          /*composite_devices=*/{}, devices[0].get(), devices[1].get(),
+          Env::Default(), /*caching_threshold_duration=*/absl::ZeroDuration());
+  TF_ASSERT_OK(first_result.status());
+  EXPECT_EQ(metrics::GetFunctionGraphOptimizationCacheHitCount(
+                metrics::GraphOptimizationSource::kJit),
+            hits_before);
+
+  // The clone shares the first function's structure, so its instantiation is
+  // served from the cache under its own name.
+  StatusOr<OptimizedFunctionGraphInfo> second_result =
+      OptimizeFunctionGraphOrReadFromFileCache(
+          "FindDeviceClone", {}, opts, device_set, lib_def.get(),
+          /*composite_devices=*/{}, devices[0].get(), devices[1].get(),
+          Env::Default(), /*caching_threshold_duration=*/absl::ZeroDuration());
+  TF_ASSERT_OK(second_result.status());
+  EXPECT_EQ(metrics::GetFunctionGraphOptimizationCacheHitCount(
+                metrics::GraphOptimizationSource::kJit),
+            hits_before + 1);
+  EXPECT_EQ(second_result->name, "FindDeviceClone");
+  EXPECT_EQ(second_result->num_return_nodes, 1);
+  EXPECT_THAT(second_result->ret_types, ElementsAre(DT_STRING));
+
+  unsetenv(kFunctionStructuralCacheEnvVariableName);
+}
+
 }  // namespace
 }  // namespace tensorflow
@@ -21,16 +21,20 @@ limitations under the License.
 
 #include "tensorflow/core/common_runtime/colocation_graph.h"
 #include "tensorflow/core/common_runtime/device.h"
+#include "tensorflow/core/common_runtime/device_bandwidth_table.h"
 #include "tensorflow/core/framework/attr_value_util.h"
 #include "tensorflow/core/framework/device_attributes.pb.h"
 #include "tensorflow/core/framework/function.h"
 #include "tensorflow/core/framework/graph.pb.h"
+#include "tensorflow/core/framework/node_def_util.h"
+#include "tensorflow/core/framework/partial_tensor_shape.h"
 #include "tensorflow/core/framework/types.h"
 #include "tensorflow/core/framework/types.pb.h"
 #include "tensorflow/core/graph/graph_node_util.h"
 #include "tensorflow/core/lib/core/errors.h"
 #include "tensorflow/core/platform/path.h"
 #include "tensorflow/core/util/dump_graph.h"
+#include "tensorflow/core/util/env_var.h"
 #include "tensorflow/core/util/port.h"
 
 namespace tensorflow {
@@ -150,6 +154,127 @@ Status AssignAndLog(int assigned_device, Node* node,
   return OkStatus();
 }
 
+// True if the communication-cost-aware refinement pass is enabled via
+// TF_PLACER_COMM_AWARE. Off by default while the heuristic matures.
+bool CommunicationAwarePlacementEnabled() {
+  static bool enabled = [] {
+    bool value = false;
+    Status status = ReadBoolFromEnvVar("TF_PLACER_COMM_AWARE", false, &value);
+    if (!status.ok()) {
+      LOG(ERROR) << status.message();
+    }
+    return value;
+  }();
+  return enabled;
+}
+
+// Fallback size for edges whose shape is unknown at placement time.
+constexpr int64_t kDefaultTensorBytes = 64 * 1024;
+
+// Estimates the number of bytes carried by `edge`, using the source node's
+// "_output_shapes" annotation when one is present and fully defined.
+int64_t EstimateEdgeBytes(const Edge* edge) {
+  if (edge->IsControlEdge()) return 0;
+  std::vector<PartialTensorShape> shapes;
+  if (TryGetNodeAttr(edge->src()->def(), "_output_shapes", &shapes) &&
+      edge->src_output() < static_cast<int>(shapes.size()) &&
+      shapes[edge->src_output()].IsFullyDefined()) {
+    const DataType dtype = edge->src()->output_type(edge->src_output());
+    const int size = DataTypeSize(dtype);
+    if (size > 0) {
+      return shapes[edge->src_output()].num_elements() * size;
+    }
+  }
+  return kDefaultTensorBytes;
+}
+
+// Whether the refinement pass may move `node` to another device of the same
+// type. Nodes with user constraints, state, colocation requirements, or
+// device-bound edge types must stay where the main passes put them.
+bool IsMovableForCommunication(const Node* node) {
+  if (!node->requested_device().empty()) return false;
+  if (node->op_def().is_stateful()) return false;
+  if (HasNodeAttr(node->def(), kColocationAttrName)) return false;
+  if (node->IsEnter() || node->IsExit() || node->IsNextIteration()) {
+    return false;
+  }
+  for (const Edge* edge : node->in_edges()) {
+    if (edge->IsControlEdge()) continue;
+    const DataType dtype = edge->src()->output_type(edge->src_output());
+    if (IsRefType(dtype) || dtype == DT_RESOURCE) return false;
+  }
+  for (const Edge* edge : node->out_edges()) {
+    if (edge->IsControlEdge()) continue;
+    const DataType dtype = node->output_type(edge->src_output());
+    if (IsRefType(dtype) || dtype == DT_RESOURCE) return false;
+  }
+  return true;
+}
+
+// Estimated communication cost of `node` if it were assigned to `device`,
+// i.e. the summed transfer-cost estimates of its data edges.
+double CommunicationCostAt(const Node* node, const string& device) {
+  const DeviceBandwidthTable* table = DeviceBandwidthTable::Global();
+  double cost = 0.0;
+  for (const Edge* edge : node->in_edges()) {
+    if (edge->IsControlEdge()) continue;
+    cost += table->TransferCostEstimate(edge->src()->assigned_device_name(),
+                                        device, EstimateEdgeBytes(edge));
+  }
+  for (const Edge* edge : node->out_edges()) {
+    if (edge->IsControlEdge()) continue;
+    cost += table->TransferCostEstimate(
+        device, edge->dst()->assigned_device_name(), EstimateEdgeBytes(edge));
+  }
+  return cost;
+}
+
+// A greedy refinement pass over the placed graph: for each unconstrained
+// node, consider moving it to the device of one of its data neighbors (same
+// device type only) and do so when the bandwidth table says the move strictly
+// reduces the node's communication cost. Runs after the main placement passes
+// so all colocation and soft-placement constraints have already been honored.
+void RefinePlacementForCommunication(Graph* graph, const DeviceSet* devices,
+                                     bool log_device_placement) {
+  if (DeviceBandwidthTable::Global()->empty()) return;
+  for (Node* node : graph->op_nodes()) {
+    if (!IsMovableForCommunication(node)) continue;
+    const string& current = node->assigned_device_name();
+    const Device* current_device = devices->FindDeviceByName(current);
+    if (current_device == nullptr) continue;
+
+    double best_cost = CommunicationCostAt(node, current);
+    const string* best_device = nullptr;
+    auto consider = [&](const Node* neighbor) {
+      const string& candidate = neighbor->assigned_device_name();
+      if (candidate == current) return;
+      const Device* candidate_device = devices->FindDeviceByName(candidate);
+      if (candidate_device == nullptr ||
+          candidate_device->device_type() != current_device->device_type()) {
+        return;
+      }
+      const double cost = CommunicationCostAt(node, candidate);
+      if (cost < best_cost) {
+        best_cost = cost;
+        best_device = &candidate;
+      }
+    };
+    for (const Edge* edge : node->in_edges()) {
+      if (!edge->IsControlEdge()) consider(edge->src());
+    }
+    for (const Edge* edge : node->out_edges()) {
+      if (!edge->IsControlEdge()) consider(edge->dst());
+    }
+
+    if (best_device != nullptr) {
+      VLOG(2) << "Communication-aware placement moved " << node->name()
+              << " from " << current << " to " << *best_device;
+      node->set_assigned_device_name(*best_device);
+      LogDeviceAssignment(node, log_device_placement);
+    }
+  }
+}
+
 }  // namespace
 
 Placer::Placer(Graph* graph, const string& function_name,
@@ -319,6 +444,12 @@ Status Placer::Run(const GraphOptimizationPassOptions& options) {
                                     log_device_placement_));
   }
 
+  // Optionally refine the placement using measured link bandwidths, now that
+  // every node has a constraint-respecting assignment.
+  if (CommunicationAwarePlacementEnabled()) {
+    RefinePlacementForCommunication(graph_, devices_, log_device_placement_);
+  }
+
   if (VLOG_IS_ON(3)) {
     DumpGraphToFile(
         strings::StrCat(options.debug_filename_prefix, "placer_output"),
@@ -62,6 +62,10 @@ class RefCountedIntraProcessRendezvous : public Rendezvous {
     device_mgr_ = device_mgr;
   }
 
+  // Pre-sizes the underlying LocalRendezvous for `num_keys` distinct
+  // rendezvous keys in flight. See LocalRendezvous::ReserveKeys.
+  inline void ReserveKeys(int num_keys) { local_.ReserveKeys(num_keys); }
+
  private:
   const DeviceMgr* device_mgr_;  // Not owned.
   LocalRendezvous local_;
@@ -93,6 +97,10 @@ class PrivateIntraProcessRendezvous : public RendezvousInterface {
                  DoneCallback done) override;
   void StartAbort(const Status& status) override;
 
+  // Pre-sizes the underlying LocalRendezvous for `num_keys` distinct
+  // rendezvous keys in flight. See LocalRendezvous::ReserveKeys.
+  inline void ReserveKeys(int num_keys) { local_.ReserveKeys(num_keys); }
+
  private:
   const DeviceMgr* device_mgr_;
   LocalRendezvous local_;
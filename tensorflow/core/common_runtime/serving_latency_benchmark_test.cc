@@ -0,0 +1,263 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// End-to-end serving latency benchmarks for common model archetypes.
+//
+// The per-op benchmarks under tensorflow/core/kernels measure kernels in
+// isolation; these benchmarks instead measure the executor, rendezvous and
+// allocator interplay of whole inference graphs under concurrency. A closed
+// loop of `Arg(n)` client threads issues Session::Run() requests against one
+// shared session, and each benchmark reports p50/p99 request latency and
+// aggregate throughput alongside the usual wall time, so scheduler or
+// allocator contention regressions show up as a p99/throughput shift as the
+// thread count grows.
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "tensorflow/cc/ops/array_ops.h"
+#include "tensorflow/cc/ops/const_op.h"
+#include "tensorflow/cc/ops/math_ops.h"
+#include "tensorflow/cc/ops/nn_ops.h"
+#include "tensorflow/core/framework/graph.pb.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/test.h"
+#include "tensorflow/core/platform/test_benchmark.h"
+#include "tensorflow/core/public/session.h"
+#include "tensorflow/core/public/session_options.h"
+
+namespace tensorflow {
+namespace {
+
+// Number of requests each client thread issues per benchmark iteration. Large
+// enough to amortize the per-iteration thread startup, small enough that the
+// benchmark converges quickly.
+constexpr int kRequestsPerThread = 16;
+
+// A canned inference graph plus the feed/fetch endpoints to drive it with.
+struct ServingModel {
+  GraphDef graph_def;
+  string feed_name;
+  Tensor feed_tensor;
+  string fetch_name;
+};
+
+Tensor FilledTensor(const TensorShape& shape, float value) {
+  Tensor tensor(DT_FLOAT, shape);
+  tensor.flat<float>().setConstant(value);
+  return tensor;
+}
+
+// A fully-connected block: x = Relu(x * W + b).
+ops::Relu DenseRelu(const ops::Scope& scope, Input x, int in_dim, int out_dim) {
+  auto w = ops::Const(scope, FilledTensor({in_dim, out_dim}, 0.01f));
+  auto b = ops::Const(scope, FilledTensor({out_dim}, 0.1f));
+  return ops::Relu(scope, ops::BiasAdd(scope, ops::MatMul(scope, x, w), b));
+}
+
+// A recommender-style MLP tower: a wide concatenated-embedding input run
+// through a few shrinking dense layers down to one logit per example.
+ServingModel MlpRecsysModel(int batch) {
+  ServingModel model;
+  ops::Scope scope = ops::Scope::NewRootScope();
+  auto input =
+      ops::Placeholder(scope.WithOpName("input"), DT_FLOAT,
+                       ops::Placeholder::Shape({batch, 256}));
+  auto h1 = DenseRelu(scope, input, 256, 512);
+  auto h2 = DenseRelu(scope, h1, 512, 256);
+  auto h3 = DenseRelu(scope, h2, 256, 64);
+  auto w_out = ops::Const(scope, FilledTensor({64, 1}, 0.01f));
+  auto logits = ops::MatMul(scope, h3, w_out);
+  auto prediction = ops::Sigmoid(scope.WithOpName("prediction"), logits);
+  TF_CHECK_OK(scope.ToGraphDef(&model.graph_def));
+  model.feed_name = "input";
+  model.feed_tensor = FilledTensor({batch, 256}, 1.0f);
+  model.fetch_name = "prediction";
+  return model;
+}
+
+// A single transformer encoder block: one-head self-attention followed by a
+// feed-forward expansion, both with residual connections. Layer normalization
+// is elided; it does not change the executor/allocator behavior this
+// benchmark studies.
+ServingModel BertEncoderBlockModel(int batch, int seq, int hidden) {
+  ServingModel model;
+  ops::Scope scope = ops::Scope::NewRootScope();
+  auto input =
+      ops::Placeholder(scope.WithOpName("input"), DT_FLOAT,
+                       ops::Placeholder::Shape({batch, seq, hidden}));
+  auto flat =
+      ops::Reshape(scope, input, ops::Const(scope, {batch * seq, hidden}));
+  auto wq = ops::Const(scope, FilledTensor({hidden, hidden}, 0.01f));
+  auto wk = ops::Const(scope, FilledTensor({hidden, hidden}, 0.01f));
+  auto wv = ops::Const(scope, FilledTensor({hidden, hidden}, 0.01f));
+  auto batched_shape = ops::Const(scope, {batch, seq, hidden});
+  auto q = ops::Reshape(scope, ops::MatMul(scope, flat, wq), batched_shape);
+  auto k = ops::Reshape(scope, ops::MatMul(scope, flat, wk), batched_shape);
+  auto v = ops::Reshape(scope, ops::MatMul(scope, flat, wv), batched_shape);
+  auto scores = ops::Mul(
+      scope, ops::BatchMatMulV2(scope, q, k, ops::BatchMatMulV2::AdjY(true)),
+      ops::Const(scope, 1.0f / std::sqrt(static_cast<float>(hidden))));
+  auto probs = ops::Softmax(scope, scores);
+  auto context = ops::Reshape(scope, ops::BatchMatMulV2(scope, probs, v),
+                              ops::Const(scope, {batch * seq, hidden}));
+  auto wo = ops::Const(scope, FilledTensor({hidden, hidden}, 0.01f));
+  auto attention = ops::Add(scope, ops::MatMul(scope, context, wo), flat);
+  auto ffn = DenseRelu(scope, attention, hidden, 4 * hidden);
+  auto w2 = ops::Const(scope, FilledTensor({4 * hidden, hidden}, 0.01f));
+  auto encoded = ops::Add(scope, ops::MatMul(scope, ffn, w2), attention);
+  auto output = ops::Reshape(scope.WithOpName("output"), encoded,
+                             ops::Const(scope, {batch, seq, hidden}));
+  TF_CHECK_OK(scope.ToGraphDef(&model.graph_def));
+  model.feed_name = "input";
+  model.feed_tensor = FilledTensor({batch, seq, hidden}, 1.0f);
+  model.fetch_name = "output";
+  return model;
+}
+
+// A residual convolution block: two 3x3 same-padded convolutions with a skip
+// connection, NHWC on the CPU.
+ServingModel ResNetBlockModel(int batch, int size, int channels) {
+  ServingModel model;
+  ops::Scope scope = ops::Scope::NewRootScope();
+  auto input =
+      ops::Placeholder(scope.WithOpName("input"), DT_FLOAT,
+                       ops::Placeholder::Shape({batch, size, size, channels}));
+  auto f1 = ops::Const(scope, FilledTensor({3, 3, channels, channels}, 0.01f));
+  auto conv1 = ops::Relu(
+      scope, ops::Conv2D(scope, input, f1, {1, 1, 1, 1}, "SAME"));
+  auto f2 = ops::Const(scope, FilledTensor({3, 3, channels, channels}, 0.01f));
+  auto conv2 = ops::Conv2D(scope, conv1, f2, {1, 1, 1, 1}, "SAME");
+  auto output =
+      ops::Relu(scope.WithOpName("output"), ops::Add(scope, conv2, input));
+  TF_CHECK_OK(scope.ToGraphDef(&model.graph_def));
+  model.feed_name = "input";
+  model.feed_tensor = FilledTensor({batch, size, size, channels}, 1.0f);
+  model.fetch_name = "output";
+  return model;
+}
+
+// Drives `model` with `state.range(0)` closed-loop client threads sharing one
+// session and reports p50/p99 request latency and aggregate throughput.
+void RunServingBenchmark(::testing::benchmark::State& state,
+                         const ServingModel& model) {
+  const int num_threads = state.range(0);
+  SessionOptions options;
+  std::unique_ptr<Session> session(NewSession(options));
+  TF_CHECK_OK(session->Create(model.graph_def));
+  const std::vector<std::pair<string, Tensor>> feeds = {
+      {model.feed_name, model.feed_tensor}};
+  const std::vector<string> fetches = {model.fetch_name};
+  {
+    // Ignore the first run, which incurs the graph partitioning and pruning
+    // overhead that a serving process pays once at startup.
+    std::vector<Tensor> outputs;
+    TF_CHECK_OK(session->Run(feeds, fetches, {}, &outputs));
+  }
+
+  mutex mu;
+  std::vector<double> latencies_usec;
+  int64_t total_requests = 0;
+  for (auto s : state) {
+    std::vector<std::unique_ptr<Thread>> clients;
+    clients.reserve(num_threads);
+    for (int t = 0; t < num_threads; ++t) {
+      clients.emplace_back(Env::Default()->StartThread(
+          {}, "serving_client",
+          [&session, &feeds, &fetches, &mu, &latencies_usec] {
+            std::vector<double> local;
+            local.reserve(kRequestsPerThread);
+            for (int r = 0; r < kRequestsPerThread; ++r) {
+              const uint64 start_usec = Env::Default()->NowMicros();
+              std::vector<Tensor> outputs;
+              TF_CHECK_OK(session->Run(feeds, fetches, {}, &outputs));
+              local.push_back(
+                  static_cast<double>(Env::Default()->NowMicros() - start_usec));
+            }
+            mutex_lock l(mu);
+            latencies_usec.insert(latencies_usec.end(), local.begin(),
+                                  local.end());
+          }));
+    }
+    // Joins the client threads.
+    clients.clear();
+    total_requests += static_cast<int64_t>(num_threads) * kRequestsPerThread;
+  }
+
+  std::sort(latencies_usec.begin(), latencies_usec.end());
+  auto percentile = [&latencies_usec](double p) -> double {
+    if (latencies_usec.empty()) return 0.0;
+    const size_t index = std::min(
+        latencies_usec.size() - 1,
+        static_cast<size_t>(p * static_cast<double>(latencies_usec.size())));
+    return latencies_usec[index];
+  };
+  state.counters["p50_usec"] = percentile(0.5);
+  state.counters["p99_usec"] = percentile(0.99);
+  state.counters["requests_per_sec"] = ::benchmark::Counter(
+      static_cast<double>(total_requests), ::benchmark::Counter::kIsRate);
+  state.SetItemsProcessed(total_requests);
+}
+
+void BM_ServingMlpRecsys(::testing::benchmark::State& state) {
+  static const ServingModel* const model =
+      new ServingModel(MlpRecsysModel(/*batch=*/8));
+  RunServingBenchmark(state, *model);
+}
+
+void BM_ServingBertEncoderBlock(::testing::benchmark::State& state) {
+  static const ServingModel* const model = new ServingModel(
+      BertEncoderBlockModel(/*batch=*/4, /*seq=*/64, /*hidden=*/128));
+  RunServingBenchmark(state, *model);
+}
+
+void BM_ServingResNetBlock(::testing::benchmark::State& state) {
+  static const ServingModel* const model = new ServingModel(
+      ResNetBlockModel(/*batch=*/4, /*size=*/28, /*channels=*/32));
+  RunServingBenchmark(state, *model);
+}
+
+BENCHMARK(BM_ServingMlpRecsys)
+    ->UseRealTime()
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->Arg(16);
+BENCHMARK(BM_ServingBertEncoderBlock)
+    ->UseRealTime()
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->Arg(16);
+BENCHMARK(BM_ServingResNetBlock)
+    ->UseRealTime()
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->Arg(16);
+
+}  // namespace
+}  // namespace tensorflow
@@ -21,6 +21,7 @@ limitations under the License.
 #include <utility>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
 #include "tensorflow/core/common_runtime/eval_const_tensor.h"
 #include "tensorflow/core/common_runtime/function_utils.h"
@@ -64,6 +65,11 @@ namespace {
 constexpr char kArgOp[] = "_Arg";
 constexpr char kRetvalOp[] = "_Retval";
 
+// Maximum number of times PropagateShapeChanges() re-infers a single node.
+// Bounds the propagation on graphs with v1 control-flow cycles, where shape
+// updates can otherwise travel around a while loop indefinitely.
+constexpr int kMaxShapePropagationVisits = 16;
+
 }  // namespace
 
 // Runs shape inference for the given node using the given ShapeRefiner.
@@ -412,6 +418,56 @@ Status ShapeRefiner::UpdateNode(const Node* node, bool relax, bool* refined) {
   return RunShapeFn(node, op_reg_data, node_ext_context);
 }
 
+Status ShapeRefiner::PropagateShapeChanges(
+    const std::vector<const Node*>& nodes, bool relax, bool* refined) {
+  *refined = false;
+
+  std::deque<const Node*> worklist;
+  absl::flat_hash_set<const Node*> in_worklist;
+  auto enqueue_fanout = [&](const Node* node) {
+    for (const Edge* e : node->out_edges()) {
+      if (e->IsControlEdge()) continue;
+      const Node* out = e->dst();
+      // Skip fan-out this refiner has never seen; it will pick up the new
+      // shapes when it is added.
+      if (node_to_context_.find(out) == node_to_context_.end()) continue;
+      if (in_worklist.insert(out).second) worklist.push_back(out);
+    }
+  };
+
+  // Re-infer the edited nodes from scratch: the edit may have changed the
+  // node itself (op, attrs or input edges), which its cached
+  // InferenceContext does not reflect. All edited contexts are erased up
+  // front so that an edit spanning several interdependent nodes does not
+  // re-infer one edited node against another's stale context.
+  for (const Node* node : nodes) {
+    node_to_context_.erase(node);
+  }
+  for (const Node* node : nodes) {
+    TF_RETURN_IF_ERROR(AddNode(node));
+    *refined = true;
+    enqueue_fanout(node);
+  }
+
+  // Propagate along affected out-edges only. A node is re-inferred when the
+  // shapes of its fan-in changed, and its own fan-out is enqueued only when
+  // its output shapes changed in turn, so untouched subgraphs keep their
+  // cached contexts.
+  absl::flat_hash_map<const Node*, int> visits;
+  while (!worklist.empty()) {
+    const Node* node = worklist.front();
+    worklist.pop_front();
+    in_worklist.erase(node);
+    if (++visits[node] > kMaxShapePropagationVisits) continue;
+    bool node_refined = false;
+    TF_RETURN_IF_ERROR(UpdateNode(node, relax, &node_refined));
+    if (!node_refined) continue;
+    *refined = true;
+    enqueue_fanout(node);
+  }
+  return OkStatus();
+}
+
 Status ShapeRefiner::EvaluateConstantTensorForEdge(
     const Node* node, int dst_idx, bool* evaluated, Tensor* result,
     InferenceContext* outer_context) {
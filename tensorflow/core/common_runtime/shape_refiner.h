@@ -113,6 +113,18 @@ class ShapeRefiner {
   // if <*refined> is set to false.
   Status UpdateNode(const Node* node, bool relax, bool* refined);
 
+  // Incrementally re-infers shapes after a graph edit. Each node in 'nodes'
+  // is re-inferred from scratch (its cached InferenceContext is rebuilt, so
+  // op, attr and input-edge changes are picked up) and shape changes are then
+  // propagated along affected out-edges via UpdateNode(), reusing the cached
+  // contexts of nodes whose fan-in shapes did not change. Nodes never added
+  // to this refiner are skipped during propagation. 'relax' has the same
+  // meaning as in UpdateNode(); pass relax=true if the edit may change shapes
+  // arbitrarily rather than only refine them. Sets '*refined' to true if any
+  // node was re-inferred.
+  Status PropagateShapeChanges(const std::vector<const Node*>& nodes,
+                               bool relax, bool* refined);
+
   // Returns the InferenceContext for 'node', if present.
   shape_inference::InferenceContext* GetContext(const Node* node) const {
     auto it = node_to_context_.find(node);
@@ -1427,6 +1427,45 @@ TEST_F(ShapeRefinerTest, IncrementalUpdates) {
   EXPECT_TRUE(SameHandle(ctx->Dim(shp, 0), ctx->Dim(shp2, 0)));
 }
 
+TEST_F(ShapeRefinerTest, PropagateShapeChanges) {
+  Scope root = Scope::NewRootScope();
+  Graph* g = root.graph();
+  Node* placeholder;
+  TF_CHECK_OK(NodeBuilder("placeholder", "Placeholder")
+                  .Attr("dtype", DT_FLOAT)
+                  .Attr("shape", PartialTensorShape())
+                  .Finalize(g, &placeholder));
+  Node* id0;
+  TF_CHECK_OK(NodeBuilder("id0", "Identity")
+                  .Attr("T", DT_FLOAT)
+                  .Input(placeholder)
+                  .Finalize(g, &id0));
+  Node* id1;
+  TF_CHECK_OK(NodeBuilder("id1", "Identity")
+                  .Attr("T", DT_FLOAT)
+                  .Input(id0)
+                  .Finalize(g, &id1));
+  ShapeRefiner m(TF_GRAPH_DEF_VERSION, OpRegistry::Global());
+  TF_ASSERT_OK(m.AddNode(placeholder));
+  TF_ASSERT_OK(m.AddNode(id0));
+  TF_ASSERT_OK(m.AddNode(id1));
+
+  shape_inference::InferenceContext* ctx = m.GetContext(id1);
+  EXPECT_EQ("?", ctx->DebugString(ctx->output(0)));
+
+  // Edit the placeholder's shape attr, as a graph rewrite would, and
+  // propagate the new shape through the affected fan-out only.
+  placeholder->AddAttr("shape", PartialTensorShape({3, 7}));
+  bool refined = false;
+  TF_ASSERT_OK(m.PropagateShapeChanges({placeholder}, /*relax=*/false,
+                                       &refined));
+  EXPECT_TRUE(refined);
+  ctx = m.GetContext(id0);
+  EXPECT_EQ("[3,7]", ctx->DebugString(ctx->output(0)));
+  ctx = m.GetContext(id1);
+  EXPECT_EQ("[3,7]", ctx->DebugString(ctx->output(0)));
+}
+
 void TestSimpleFunctionInference(bool enable_function_inference) {
   FunctionDefLibrary f_lib_proto;
   *(f_lib_proto.add_function()) = test::function::XTimesTwo();
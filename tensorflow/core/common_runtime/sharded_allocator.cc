@@ -0,0 +1,161 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/common_runtime/sharded_allocator.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "tensorflow/core/lib/hash/hash.h"
+#include "tensorflow/core/lib/strings/strcat.h"
+#include "tensorflow/core/platform/logging.h"
+
+namespace tensorflow {
+
+namespace {
+int PtrMapShardIndex(const void* ptr) {
+  return Hash64(reinterpret_cast<const char*>(&ptr), sizeof(ptr)) %
+         ShardedAllocator::kNumPtrMapShards;
+}
+}  // namespace
+
+ShardedAllocator::ShardedAllocator(
+    std::vector<std::unique_ptr<Allocator>> shards)
+    : shards_(std::move(shards)) {
+  CHECK(!shards_.empty());
+}
+
+ShardedAllocator::~ShardedAllocator() = default;
+
+string ShardedAllocator::Name() {
+  return strings::StrCat("sharded_", shards_[0]->Name());
+}
+
+int ShardedAllocator::CurrentShardIndex() {
+  static thread_local int assigned_index = -1;
+  if (TF_PREDICT_FALSE(assigned_index < 0)) {
+    assigned_index = next_shard_index_.fetch_add(1, std::memory_order_relaxed);
+  }
+  return assigned_index % shards_.size();
+}
+
+void ShardedAllocator::RecordPtrShard(const void* ptr, int shard_index) {
+  PtrMapShard& s = ptr_map_shards_[PtrMapShardIndex(ptr)];
+  mutex_lock l(s.mu);
+  s.map[ptr] = shard_index;
+}
+
+int ShardedAllocator::LookupPtrShard(const void* ptr, bool erase) const {
+  const PtrMapShard& s = ptr_map_shards_[PtrMapShardIndex(ptr)];
+  mutex_lock l(s.mu);
+  auto it = s.map.find(ptr);
+  if (it == s.map.end()) return -1;
+  int shard_index = it->second;
+  if (erase) s.map.erase(it);
+  return shard_index;
+}
+
+void* ShardedAllocator::AllocateRaw(size_t alignment, size_t num_bytes) {
+  return AllocateRaw(alignment, num_bytes, AllocationAttributes());
+}
+
+void* ShardedAllocator::AllocateRaw(
+    size_t alignment, size_t num_bytes,
+    const AllocationAttributes& allocation_attr) {
+  const int start = CurrentShardIndex();
+  // Try the calling thread's shard first; on failure (e.g. the shard is out
+  // of memory while others still have room) fall over to the other shards
+  // before reporting OOM.
+  for (int i = 0; i < static_cast<int>(shards_.size()); ++i) {
+    const int shard_index = (start + i) % shards_.size();
+    void* ptr =
+        shards_[shard_index]->AllocateRaw(alignment, num_bytes, allocation_attr);
+    if (ptr != nullptr) {
+      RecordPtrShard(ptr, shard_index);
+      return ptr;
+    }
+  }
+  return nullptr;
+}
+
+void ShardedAllocator::DeallocateRaw(void* ptr) {
+  if (ptr == nullptr) return;
+  int shard_index = LookupPtrShard(ptr, /*erase=*/true);
+  if (TF_PREDICT_FALSE(shard_index < 0)) {
+    LOG(ERROR) << "ShardedAllocator: deallocating pointer " << ptr
+               << " that was not allocated here";
+    return;
+  }
+  shards_[shard_index]->DeallocateRaw(ptr);
+}
+
+bool ShardedAllocator::TracksAllocationSizes() const {
+  return shards_[0]->TracksAllocationSizes();
+}
+
+size_t ShardedAllocator::RequestedSize(const void* ptr) const {
+  int shard_index = LookupPtrShard(ptr, /*erase=*/false);
+  if (shard_index < 0) return 0;
+  return shards_[shard_index]->RequestedSize(ptr);
+}
+
+size_t ShardedAllocator::AllocatedSize(const void* ptr) const {
+  int shard_index = LookupPtrShard(ptr, /*erase=*/false);
+  if (shard_index < 0) return 0;
+  return shards_[shard_index]->AllocatedSize(ptr);
+}
+
+absl::optional<AllocatorStats> ShardedAllocator::GetStats() {
+  absl::optional<AllocatorStats> merged;
+  for (const auto& shard : shards_) {
+    absl::optional<AllocatorStats> stats = shard->GetStats();
+    if (!stats) continue;
+    if (!merged) {
+      merged = *stats;
+      continue;
+    }
+    merged->num_allocs += stats->num_allocs;
+    merged->bytes_in_use += stats->bytes_in_use;
+    merged->peak_bytes_in_use += stats->peak_bytes_in_use;
+    merged->largest_alloc_size =
+        std::max(merged->largest_alloc_size, stats->largest_alloc_size);
+    if (stats->bytes_limit) {
+      merged->bytes_limit =
+          merged->bytes_limit.value_or(0) + *stats->bytes_limit;
+    }
+    merged->bytes_reserved += stats->bytes_reserved;
+    merged->peak_bytes_reserved += stats->peak_bytes_reserved;
+    if (stats->bytes_reservable_limit) {
+      merged->bytes_reservable_limit =
+          merged->bytes_reservable_limit.value_or(0) +
+          *stats->bytes_reservable_limit;
+    }
+  }
+  return merged;
+}
+
+bool ShardedAllocator::ClearStats() {
+  bool ok = true;
+  for (const auto& shard : shards_) {
+    ok = shard->ClearStats() && ok;
+  }
+  return ok;
+}
+
+AllocatorMemoryType ShardedAllocator::GetMemoryType() const {
+  return shards_[0]->GetMemoryType();
+}
+
+}  // namespace tensorflow
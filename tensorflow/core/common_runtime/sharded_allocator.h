@@ -0,0 +1,97 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_COMMON_RUNTIME_SHARDED_ALLOCATOR_H_
+#define TENSORFLOW_CORE_COMMON_RUNTIME_SHARDED_ALLOCATOR_H_
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "tensorflow/core/framework/allocator.h"
+#include "tensorflow/core/lib/gtl/flatmap.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/thread_annotations.h"
+#include "tensorflow/core/platform/types.h"
+
+namespace tensorflow {
+
+// An allocator that spreads requests round-robin over a set of child
+// allocators, one per calling thread. Threads that allocate concurrently end
+// up on different shards and therefore do not contend on a single allocator
+// lock; this matters for allocators like BFC that serialize all operations.
+//
+// Deallocations are routed back to the shard that served the allocation via
+// a sharded pointer-to-shard map, so a tensor may be freed from any thread.
+//
+// Thread-safe.
+class ShardedAllocator : public Allocator {
+ public:
+  // `shards` must be non-empty; the children are owned.
+  explicit ShardedAllocator(std::vector<std::unique_ptr<Allocator>> shards);
+  ~ShardedAllocator() override;
+
+  string Name() override;
+
+  void* AllocateRaw(size_t alignment, size_t num_bytes) override;
+  void* AllocateRaw(size_t alignment, size_t num_bytes,
+                    const AllocationAttributes& allocation_attr) override;
+  void DeallocateRaw(void* ptr) override;
+
+  bool TracksAllocationSizes() const override;
+  size_t RequestedSize(const void* ptr) const override;
+  size_t AllocatedSize(const void* ptr) const override;
+
+  absl::optional<AllocatorStats> GetStats() override;
+  bool ClearStats() override;
+
+  AllocatorMemoryType GetMemoryType() const override;
+
+  int num_shards() const { return shards_.size(); }
+  Allocator* shard(int i) const { return shards_[i].get(); }
+
+  // Number of buckets in the pointer-to-shard bookkeeping map.
+  static constexpr int kNumPtrMapShards = 16;
+
+ private:
+  // Shard that serves allocations made by the calling thread, assigned
+  // round-robin on first use.
+  int CurrentShardIndex();
+
+  // Records which shard served `ptr`; removed again on deallocation.
+  void RecordPtrShard(const void* ptr, int shard_index);
+  // Returns the serving shard for `ptr`, or -1 if unknown. If `erase` is
+  // true the entry is removed.
+  int LookupPtrShard(const void* ptr, bool erase) const;
+
+  const std::vector<std::unique_ptr<Allocator>> shards_;
+  std::atomic<int> next_shard_index_{0};
+
+  // Pointer-to-shard bookkeeping, itself sharded by pointer hash so that
+  // concurrent threads rarely touch the same mutex.
+  struct PtrMapShard {
+    mutable mutex mu;
+    mutable gtl::FlatMap<const void*, int> map TF_GUARDED_BY(mu);
+  };
+  PtrMapShard ptr_map_shards_[kNumPtrMapShards];
+
+  ShardedAllocator(const ShardedAllocator&) = delete;
+  void operator=(const ShardedAllocator&) = delete;
+};
+
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_COMMON_RUNTIME_SHARDED_ALLOCATOR_H_
@@ -0,0 +1,104 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/common_runtime/step_arena_allocator.h"
+
+#include <algorithm>
+
+#include "tensorflow/core/platform/logging.h"
+
+namespace tensorflow {
+
+StepArenaAllocator::StepArenaAllocator(Allocator* underlying)
+    : underlying_(underlying) {
+  DCHECK(underlying != nullptr);
+}
+
+StepArenaAllocator::~StepArenaAllocator() {
+  mutex_lock l(mu_);
+  for (const Block& block : blocks_) {
+    underlying_->DeallocateRaw(block.base);
+  }
+}
+
+void* StepArenaAllocator::AllocateRaw(size_t alignment, size_t num_bytes) {
+  if (num_bytes > kSmallAllocationBytes ||
+      alignment > Allocator::kAllocatorAlignment) {
+    void* ptr = underlying_->AllocateRaw(alignment, num_bytes);
+    if (ptr != nullptr) {
+      // The caller records *this* allocator as the deallocator of the
+      // resulting buffer, so a pass-through allocation must also keep the
+      // arena alive until it is handed back to DeallocateRaw.
+      Ref();
+    }
+    return ptr;
+  }
+  alignment = std::max(alignment, static_cast<size_t>(1));
+  void* ptr = nullptr;
+  {
+    mutex_lock l(mu_);
+    if (!blocks_.empty()) {
+      Block& block = blocks_.back();
+      size_t offset = (block.used + alignment - 1) & ~(alignment - 1);
+      if (offset + num_bytes <= kBlockBytes) {
+        ptr = block.base + offset;
+        block.used = offset + num_bytes;
+      }
+    }
+    if (ptr == nullptr) {
+      char* base = static_cast<char*>(
+          underlying_->AllocateRaw(Allocator::kAllocatorAlignment, kBlockBytes));
+      if (base == nullptr) {
+        // The underlying allocator failed; let the caller see the failure the
+        // same way it would without the arena.
+        return nullptr;
+      }
+      blocks_.push_back(Block{base, num_bytes});
+      ptr = base;
+    }
+  }
+  // Each live arena allocation keeps the arena (and hence its blocks) alive.
+  Ref();
+  return ptr;
+}
+
+void StepArenaAllocator::DeallocateRaw(void* ptr) {
+  if (ptr == nullptr) return;
+  bool owned;
+  {
+    mutex_lock l(mu_);
+    owned = OwnsPointer(ptr);
+  }
+  if (!owned) {
+    underlying_->DeallocateRaw(ptr);
+  }
+  // May destroy the arena; nothing below this line.
+  Unref();
+}
+
+bool StepArenaAllocator::OwnsPointer(const void* ptr) const {
+  const char* p = static_cast<const char*>(ptr);
+  for (const Block& block : blocks_) {
+    if (p >= block.base && p < block.base + kBlockBytes) return true;
+  }
+  return false;
+}
+
+int64_t StepArenaAllocator::num_blocks() const {
+  mutex_lock l(mu_);
+  return blocks_.size();
+}
+
+}  // namespace tensorflow
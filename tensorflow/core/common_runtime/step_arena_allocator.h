@@ -0,0 +1,91 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_COMMON_RUNTIME_STEP_ARENA_ALLOCATOR_H_
+#define TENSORFLOW_CORE_COMMON_RUNTIME_STEP_ARENA_ALLOCATOR_H_
+
+#include <vector>
+
+#include "tensorflow/core/framework/allocator.h"
+#include "tensorflow/core/lib/core/refcount.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/types.h"
+
+namespace tensorflow {
+
+// A per-step bump allocator for small host tensors.
+//
+// Allocations of at most kSmallAllocationBytes are carved out of large blocks
+// obtained from the underlying allocator; larger requests are delegated
+// unchanged. Individual deallocations of arena-served pointers are (nearly)
+// free: they only drop a reference, and the blocks themselves are returned to
+// the underlying allocator in one shot when the arena is destroyed.
+//
+// Lifetime is managed by reference counting. The creator holds the initial
+// reference and drops it at the end of the step; every live allocation
+// obtained through the arena — whether carved from a block or passed through
+// to the underlying allocator — holds one more, since the resulting buffers
+// all record this allocator as their deallocator. The blocks are therefore
+// released only once the step has finished *and* every tensor allocated
+// through the arena has been destroyed, so a tensor that escapes the step
+// (e.g. a fetched output) keeps its storage and its deallocator valid at the
+// cost of delaying the bulk release.
+//
+// Thread-safe.
+class StepArenaAllocator : public Allocator, public core::RefCounted {
+ public:
+  // Allocations larger than this are passed through to `underlying`.
+  static constexpr size_t kSmallAllocationBytes = 1024;
+
+  // `underlying` must outlive this allocator and is not owned.
+  explicit StepArenaAllocator(Allocator* underlying);
+  ~StepArenaAllocator() override;
+
+  string Name() override { return "step_arena"; }
+
+  void* AllocateRaw(size_t alignment, size_t num_bytes) override;
+  void DeallocateRaw(void* ptr) override;
+
+  AllocatorMemoryType GetMemoryType() const override {
+    return underlying_->GetMemoryType();
+  }
+
+  // Number of blocks currently owned by the arena. For tests.
+  int64_t num_blocks() const;
+
+ private:
+  // Size of the blocks requested from the underlying allocator.
+  static constexpr size_t kBlockBytes = 256 * 1024;
+
+  struct Block {
+    char* base;
+    size_t used;
+  };
+
+  // Returns true iff `ptr` lies inside one of the arena's blocks.
+  bool OwnsPointer(const void* ptr) const TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  Allocator* const underlying_;  // not owned
+
+  mutable mutex mu_;
+  std::vector<Block> blocks_ TF_GUARDED_BY(mu_);
+
+  StepArenaAllocator(const StepArenaAllocator&) = delete;
+  void operator=(const StepArenaAllocator&) = delete;
+};
+
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_COMMON_RUNTIME_STEP_ARENA_ALLOCATOR_H_
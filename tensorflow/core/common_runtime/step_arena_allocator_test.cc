@@ -0,0 +1,94 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/common_runtime/step_arena_allocator.h"
+
+#include <cstring>
+#include <vector>
+
+#include "tensorflow/core/framework/allocator.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace {
+
+TEST(StepArenaAllocatorTest, SmallAllocationsShareABlock) {
+  StepArenaAllocator* arena = new StepArenaAllocator(cpu_allocator());
+  std::vector<void*> ptrs;
+  for (int i = 0; i < 100; ++i) {
+    void* p = arena->AllocateRaw(Allocator::kAllocatorAlignment, 64);
+    ASSERT_NE(p, nullptr);
+    memset(p, 0xab, 64);
+    ptrs.push_back(p);
+  }
+  // 100 * 64 bytes fits comfortably in one arena block.
+  EXPECT_EQ(arena->num_blocks(), 1);
+  for (void* p : ptrs) arena->DeallocateRaw(p);
+  arena->Unref();
+}
+
+TEST(StepArenaAllocatorTest, LargeAllocationsAreDelegated) {
+  StepArenaAllocator* arena = new StepArenaAllocator(cpu_allocator());
+  void* p = arena->AllocateRaw(Allocator::kAllocatorAlignment, 1 << 20);
+  ASSERT_NE(p, nullptr);
+  // Delegated allocations do not create arena blocks.
+  EXPECT_EQ(arena->num_blocks(), 0);
+  arena->DeallocateRaw(p);
+  arena->Unref();
+}
+
+TEST(StepArenaAllocatorTest, EscapedAllocationKeepsArenaAlive) {
+  StepArenaAllocator* arena = new StepArenaAllocator(cpu_allocator());
+  void* p = arena->AllocateRaw(Allocator::kAllocatorAlignment, 128);
+  ASSERT_NE(p, nullptr);
+  memset(p, 0xcd, 128);
+  // Drop the step's reference while the allocation is still live; the memory
+  // must remain valid until the allocation itself is released.
+  arena->Unref();
+  for (int i = 0; i < 128; ++i) {
+    EXPECT_EQ(static_cast<unsigned char*>(p)[i], 0xcd);
+  }
+  arena->DeallocateRaw(p);  // Drops the final reference.
+}
+
+TEST(StepArenaAllocatorTest, EscapedDelegatedAllocationKeepsArenaAlive) {
+  StepArenaAllocator* arena = new StepArenaAllocator(cpu_allocator());
+  void* p = arena->AllocateRaw(Allocator::kAllocatorAlignment, 1 << 20);
+  ASSERT_NE(p, nullptr);
+  memset(p, 0xef, 1 << 20);
+  // Drop the step's reference while the delegated allocation is still live;
+  // the buffer records the arena as its deallocator, so the arena must stay
+  // alive until the allocation is handed back.
+  arena->Unref();
+  EXPECT_EQ(static_cast<unsigned char*>(p)[0], 0xef);
+  arena->DeallocateRaw(p);  // Drops the final reference.
+}
+
+TEST(StepArenaAllocatorTest, GrowsToMultipleBlocks) {
+  StepArenaAllocator* arena = new StepArenaAllocator(cpu_allocator());
+  std::vector<void*> ptrs;
+  // 1KB allocations; enough of them to spill over a single 256KB block.
+  for (int i = 0; i < 1000; ++i) {
+    void* p = arena->AllocateRaw(Allocator::kAllocatorAlignment, 1024);
+    ASSERT_NE(p, nullptr);
+    ptrs.push_back(p);
+  }
+  EXPECT_GT(arena->num_blocks(), 1);
+  for (void* p : ptrs) arena->DeallocateRaw(p);
+  arena->Unref();
+}
+
+}  // namespace
+}  // namespace tensorflow
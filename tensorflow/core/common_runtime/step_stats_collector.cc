@@ -14,8 +14,16 @@ limitations under the License.
 ==============================================================================*/
 #include "tensorflow/core/common_runtime/step_stats_collector.h"
 
+#include <cstdlib>
+#include <cstring>
 #include <memory>
 
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 #include "tensorflow/core/common_runtime/costmodel_manager.h"
 #include "tensorflow/core/framework/allocation_description.pb.h"
 #include "tensorflow/core/framework/op_kernel.h"
@@ -29,6 +37,7 @@ limitations under the License.
 #include "tensorflow/core/lib/strings/scanner.h"
 #include "tensorflow/core/lib/strings/stringprintf.h"
 #include "tensorflow/core/platform/logging.h"
+#include "tensorflow/core/platform/profile_utils/cpu_utils.h"
 
 namespace tensorflow {
 namespace {
@@ -49,8 +58,100 @@ bool IsSend(const NodeDef* node) {
   return node->op() == "_Send" || node->op() == "_HostSend";
 }
 
+#if defined(__linux__)
+int OpenPerfEventCounter(uint64 config) {
+  perf_event_attr attr = {};
+  attr.size = sizeof(attr);
+  attr.type = PERF_TYPE_HARDWARE;
+  attr.config = config;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  return syscall(__NR_perf_event_open, &attr, /*pid=*/0, /*cpu=*/-1,
+                 /*group_fd=*/-1, /*flags=*/0);
+}
+#endif
+
+// Per-thread perf event counters, opened lazily the first time a thread
+// records kernel stats. The counters run continuously; callers read them
+// before and after a kernel and take the difference. If perf events are
+// unavailable (non-Linux, or perf_event_paranoid forbids it), reads return 0
+// and only cycle counts are collected.
+struct ThreadPerfCounters {
+#if defined(__linux__)
+  ThreadPerfCounters() {
+    cache_miss_fd = OpenPerfEventCounter(PERF_COUNT_HW_CACHE_MISSES);
+    branch_miss_fd = OpenPerfEventCounter(PERF_COUNT_HW_BRANCH_MISSES);
+  }
+
+  ~ThreadPerfCounters() {
+    if (cache_miss_fd >= 0) close(cache_miss_fd);
+    if (branch_miss_fd >= 0) close(branch_miss_fd);
+  }
+
+  static uint64 ReadCounter(int fd) {
+    uint64 value = 0;
+    if (fd < 0 || read(fd, &value, sizeof(value)) != sizeof(value)) {
+      return 0;
+    }
+    return value;
+  }
+
+  uint64 CacheMisses() const { return ReadCounter(cache_miss_fd); }
+  uint64 BranchMisses() const { return ReadCounter(branch_miss_fd); }
+
+  int cache_miss_fd = -1;
+  int branch_miss_fd = -1;
+#else
+  uint64 CacheMisses() const { return 0; }
+  uint64 BranchMisses() const { return 0; }
+#endif
+};
+
+void ReadHardwareCounters(uint64* cycles, uint64* cache_misses,
+                          uint64* branch_misses) {
+  static thread_local ThreadPerfCounters counters;
+  *cycles = profile_utils::CpuUtils::GetCurrentClockCycle();
+  *cache_misses = counters.CacheMisses();
+  *branch_misses = counters.BranchMisses();
+}
+
+bool HardwareCountersEnabledFromEnv() {
+  const char* value = std::getenv("TF_OP_HARDWARE_COUNTERS");
+  return value != nullptr && strcmp(value, "1") == 0;
+}
+
 }  // namespace
 
+OpHardwareCounterRollup::OpHardwareCounterRollup()
+    : enabled_(HardwareCountersEnabledFromEnv()) {}
+
+/* static */ OpHardwareCounterRollup* OpHardwareCounterRollup::Global() {
+  static OpHardwareCounterRollup* rollup = new OpHardwareCounterRollup;
+  return rollup;
+}
+
+void OpHardwareCounterRollup::Record(const string& op_type, uint64 cycles,
+                                     uint64 cache_misses,
+                                     uint64 branch_misses) {
+  mutex_lock l(mu_);
+  OpTotals& totals = totals_[op_type];
+  totals.invocations++;
+  totals.cycles += cycles;
+  totals.cache_misses += cache_misses;
+  totals.branch_misses += branch_misses;
+}
+
+std::map<string, OpHardwareCounterRollup::OpTotals>
+OpHardwareCounterRollup::Snapshot() const {
+  mutex_lock l(mu_);
+  return totals_;
+}
+
+void OpHardwareCounterRollup::Reset() {
+  mutex_lock l(mu_);
+  totals_.clear();
+}
+
 NodeExecStatsWrapper::NodeExecStatsWrapper(
     const NodeDef* node, StepStatsCollector* step_stats_collector)
     : NodeExecStatsWrapper(std::make_unique<NodeExecStats>(), node,
@@ -122,6 +223,10 @@ void NodeExecStatsWrapper::RecordComputeStarted() {
   stats_->set_op_start_rel_micros(now_nanos / EnvTime::kMicrosToNanos -
                                   stats_->all_start_micros());
   stats_->set_op_start_rel_nanos(now_nanos - stats_->all_start_nanos());
+  if (OpHardwareCounterRollup::Global()->enabled()) {
+    ReadHardwareCounters(&compute_start_cycles_, &compute_start_cache_misses_,
+                         &compute_start_branch_misses_);
+  }
 }
 
 void NodeExecStatsWrapper::RecordComputeEnded() {
@@ -131,6 +236,20 @@ void NodeExecStatsWrapper::RecordComputeEnded() {
   stats_->set_op_end_rel_micros(now_nanos / EnvTime::kMicrosToNanos -
                                 stats_->all_start_micros());
   stats_->set_op_end_rel_nanos(now_nanos - stats_->all_start_nanos());
+  OpHardwareCounterRollup* rollup = OpHardwareCounterRollup::Global();
+  if (rollup->enabled() && compute_start_cycles_ != 0) {
+    uint64 cycles, cache_misses, branch_misses;
+    ReadHardwareCounters(&cycles, &cache_misses, &branch_misses);
+    // Asynchronous kernels may finish on a different thread than they
+    // started on, in which case the per-thread perf event deltas are
+    // meaningless; the saturating subtraction drops such samples to zero.
+    auto delta = [](uint64 end, uint64 start) -> uint64 {
+      return end > start ? end - start : 0;
+    };
+    rollup->Record(node_->op(), delta(cycles, compute_start_cycles_),
+                   delta(cache_misses, compute_start_cache_misses_),
+                   delta(branch_misses, compute_start_branch_misses_));
+  }
 }
 
 void NodeExecStatsWrapper::RecordExecutorEnded() {
@@ -15,6 +15,7 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_COMMON_RUNTIME_STEP_STATS_COLLECTOR_H_
 #define TENSORFLOW_CORE_COMMON_RUNTIME_STEP_STATS_COLLECTOR_H_
 
+#include <map>
 #include <memory>
 #include <unordered_map>
 #include <vector>
@@ -86,6 +87,45 @@ class NodeExecStatsInterface {
   virtual void SetScheduled(int64_t nanos) = 0;
 };
 
+// Optional per-kernel hardware counter collection, enabled by setting
+// TF_OP_HARDWARE_COUNTERS=1. While a step stats collector is active, each
+// kernel invocation records its elapsed CPU cycles and, on Linux, cache-miss
+// and branch-miss deltas from per-thread perf events; the deltas are
+// aggregated by op type into a process-wide rollup that can be read
+// programmatically. When the environment variable is unset, the hooks in the
+// stats path reduce to a single branch.
+class OpHardwareCounterRollup {
+ public:
+  struct OpTotals {
+    uint64 invocations = 0;
+    uint64 cycles = 0;
+    uint64 cache_misses = 0;
+    uint64 branch_misses = 0;
+  };
+
+  // Returns the process-wide rollup.
+  static OpHardwareCounterRollup* Global();
+
+  bool enabled() const { return enabled_; }
+
+  // Accumulates the counters of one kernel invocation of `op_type`.
+  void Record(const string& op_type, uint64 cycles, uint64 cache_misses,
+              uint64 branch_misses);
+
+  // Returns a snapshot of the per-op-type totals accumulated so far.
+  std::map<string, OpTotals> Snapshot() const;
+
+  // Discards all accumulated totals.
+  void Reset();
+
+ private:
+  OpHardwareCounterRollup();
+
+  const bool enabled_;
+  mutable mutex mu_;
+  std::map<string, OpTotals> totals_ TF_GUARDED_BY(mu_);
+};
+
 // Wraps NodeExecStats and adds allocation to it.
 class NodeExecStatsWrapper : public NodeExecStatsInterface {
  public:
@@ -129,6 +169,12 @@ class NodeExecStatsWrapper : public NodeExecStatsInterface {
   std::unique_ptr<NodeExecStats> stats_;
   const NodeDef* const node_;                       // Not owned.
   StepStatsCollector* const step_stats_collector_;  // Not owned.
+
+  // Hardware counter readings taken in RecordComputeStarted() and consumed by
+  // RecordComputeEnded() when `OpHardwareCounterRollup` is enabled.
+  uint64 compute_start_cycles_ = 0;
+  uint64 compute_start_cache_misses_ = 0;
+  uint64 compute_start_branch_misses_ = 0;
 };
 
 // Statistics collection interface for step execution.
@@ -53,6 +53,11 @@ class Flags {
                   "Enable a graph optimization pass that replicate each small "
                   "constant to its successors' devices. This can decrease "
                   "message passing.");
+  TF_DECLARE_FLAG(fuse_elementwise_chains, false,
+                  "Enable a graph optimization pass that fuses chains of "
+                  "elementwise unary ops on CPU into a single "
+                  "_UnaryOpsComposition kernel. This avoids materializing "
+                  "intermediate tensors between the ops in the chain.");
   // LINT.ThenChange(//tensorflow/core/config/flags_api_wrapper.cc)
 };
 
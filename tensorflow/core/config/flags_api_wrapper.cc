@@ -52,5 +52,6 @@ PYBIND11_MODULE(flags_pybind, m) {
   TF_PY_DECLARE_FLAG(tf_shape_default_int64);
   TF_PY_DECLARE_FLAG(more_stack_traces);
   TF_PY_DECLARE_FLAG(replicate_small_constants);
+  TF_PY_DECLARE_FLAG(fuse_elementwise_chains);
   // LINT.ThenChange(//tensorflow/core/config/flag_defs.h)
 };
@@ -14,12 +14,14 @@ limitations under the License.
 ==============================================================================*/
 #include "tensorflow/core/data/captured_function.h"
 
+#include <algorithm>
 #include <functional>
 #include <map>
 #include <memory>
 #include <optional>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -34,12 +36,15 @@ limitations under the License.
 #include "tensorflow/core/framework/function_handle_cache.h"
 #include "tensorflow/core/framework/op_kernel.h"
 #include "tensorflow/core/framework/stats_aggregator.h"
+#include "tensorflow/core/graph/algorithm.h"
 #include "tensorflow/core/lib/core/errors.h"
 #include "tensorflow/core/lib/random/random.h"
 #include "tensorflow/core/lib/strings/strcat.h"
 #include "tensorflow/core/platform/errors.h"
 #include "tensorflow/core/platform/notification.h"
 #include "tensorflow/core/profiler/lib/traceme.h"
+#include "tensorflow/core/public/version.h"
+#include "tensorflow/core/util/env_var.h"
 
 #if !defined(IS_MOBILE_PLATFORM)
 #include "tensorflow/core/grappler/grappler_item.h"
@@ -53,6 +58,44 @@ namespace {
 constexpr char kAllowSmallFunctionOptimizations[] =
     "allow_small_function_optimizations";
 
+// Maximum number of (non-Arg, non-Retval) nodes in a function eligible for
+// inline execution.  Larger functions amortize the FLR dispatch cost well
+// enough that the executor's scheduling is worth keeping.
+constexpr int kMaxInlineFunctionOps = 16;
+
+// Indicates whether eligible functions should be executed as a precompiled
+// inline kernel-call sequence instead of through `FunctionLibraryRuntime`.
+Status InlineFunctionExecutionEnabled(bool* enabled) {
+  return ReadBoolFromEnvVar("TF_DATA_INLINE_FUNCTION_EXECUTION",
+                            /*default_val=*/false, enabled);
+}
+
+// Ops that are cheap, synchronous, stateless, and safe to execute outside of
+// an executor.  Intentionally conservative; extend as needed.
+bool IsInlineCompatibleOp(const Node* node) {
+  static const std::unordered_set<string>* const kInlineOps =
+      new std::unordered_set<string>({
+          "Abs",        "Add",         "AddV2",
+          "Cast",       "Ceil",        "Const",
+          "Equal",      "Exp",         "ExpandDims",
+          "Fill",       "Floor",       "FloorDiv",
+          "FloorMod",   "Greater",     "GreaterEqual",
+          "Identity",   "Less",        "LessEqual",
+          "Log",        "LogicalAnd",  "LogicalNot",
+          "LogicalOr",  "Maximum",     "Minimum",
+          "Mul",        "Neg",         "NotEqual",
+          "Pack",       "Pow",         "Rank",
+          "RealDiv",    "Relu",        "Reshape",
+          "Round",      "Rsqrt",       "Select",
+          "SelectV2",   "Shape",       "Sigmoid",
+          "Sign",       "Size",        "Sqrt",
+          "Square",     "SquaredDifference",
+          "Squeeze",    "StridedSlice", "Sub",
+          "Tanh",
+      });
+  return kInlineOps->count(node->type_string()) > 0;
+}
+
 // Simplistic implementation of the `StepStatsCollectorInterface` that only
 // cares about collecting the CPU time needed to execute a captured function.
 class SimpleStepStatsCollector : public StepStatsCollectorInterface {
@@ -384,6 +427,192 @@ class BorrowedArgsCallFrame : public CallFrameBase {
 
 }  // namespace
 
+// Executes a small stateless function as a precompiled sequence of direct
+// kernel calls on the caller's thread.  This skips the per-call
+// `FunctionLibraryRuntime` machinery (call frame, executor scheduling, and
+// rendezvous), whose dispatch overhead dominates the cost of trivial
+// per-element functions such as short `tf.data` map functions.
+//
+// The plan is built once at function instantiation time and is immutable
+// afterwards, so a single instance may be used concurrently from multiple
+// threads.
+class InlineFunctionRunner {
+ public:
+  // Attempts to build an inline execution plan for the instantiated function.
+  // Leaves `*out` null (without error) if the function is not eligible, i.e.
+  // it is not a pure CPU function built from allowlisted ops.
+  static Status Create(FunctionLibraryRuntime* lib,
+                       FunctionLibraryRuntime::Handle f_handle,
+                       std::unique_ptr<InlineFunctionRunner>* out) {
+    out->reset();
+    Device* device = lib->device();
+    if (device == nullptr || device->device_type() != DEVICE_CPU) {
+      return OkStatus();
+    }
+    const FunctionBody* fn_body = lib->GetFunctionBody(f_handle);
+    if (fn_body == nullptr) return OkStatus();
+    const Graph* graph = fn_body->graph;
+    const int num_inputs = fn_body->arg_types.size();
+
+    // Checks that every op in the function is eligible before creating any
+    // kernels.
+    int num_ops = 0;
+    for (const Node* node : graph->nodes()) {
+      if (node->IsSource() || node->IsSink() || node->IsArg() ||
+          node->IsRetval()) {
+        continue;
+      }
+      if (!IsInlineCompatibleOp(node) || node->op_def().is_stateful() ||
+          !node->def().device().empty()) {
+        return OkStatus();
+      }
+      for (DataType dt : node->input_types()) {
+        if (IsRefType(dt)) return OkStatus();
+      }
+      for (DataType dt : node->output_types()) {
+        if (IsRefType(dt)) return OkStatus();
+      }
+      if (++num_ops > kMaxInlineFunctionOps) return OkStatus();
+    }
+
+    // Assigns each produced tensor a slot in a dense value table and builds
+    // one kernel per node, in topological order.  Slots [0, num_inputs) hold
+    // the function arguments (including captured inputs).
+    std::vector<Node*> order;
+    GetReversePostOrder(*graph, &order, NodeComparatorID());
+    std::vector<std::vector<int>> node_output_slots(graph->num_node_ids());
+    std::vector<KernelItem> items;
+    std::vector<int> ret_slots(fn_body->ret_nodes.size(), -1);
+    int next_slot = num_inputs;
+    for (Node* node : order) {
+      if (node->IsSource() || node->IsSink()) continue;
+      if (node->IsArg()) {
+        int index;
+        TF_RETURN_IF_ERROR(GetNodeAttr(node->def(), "index", &index));
+        node_output_slots[node->id()] = {index};
+        continue;
+      }
+      std::vector<int> input_slots(node->num_inputs(), -1);
+      for (const Edge* edge : node->in_edges()) {
+        if (edge->IsControlEdge()) continue;
+        const auto& src_slots = node_output_slots[edge->src()->id()];
+        if (edge->src_output() >= static_cast<int>(src_slots.size())) {
+          return OkStatus();
+        }
+        input_slots[edge->dst_input()] = src_slots[edge->src_output()];
+      }
+      for (int slot : input_slots) {
+        if (slot < 0) return OkStatus();
+      }
+      if (node->IsRetval()) {
+        int index;
+        TF_RETURN_IF_ERROR(GetNodeAttr(node->def(), "index", &index));
+        ret_slots[index] = input_slots[0];
+        continue;
+      }
+      KernelItem item;
+      Status status;
+      item.kernel.reset(CreateOpKernel(DEVICE_CPU, device,
+                                       device->GetAllocator({}), node->def(),
+                                       TF_GRAPH_DEF_VERSION, &status));
+      if (!status.ok()) {
+        // Fall back to regular execution.
+        VLOG(2) << "Failed to create kernel for inline execution of "
+                << node->name() << ": " << status;
+        return OkStatus();
+      }
+      item.input_slots = std::move(input_slots);
+      item.output_slots.reserve(node->num_outputs());
+      for (int i = 0; i < node->num_outputs(); ++i) {
+        item.output_slots.push_back(next_slot++);
+      }
+      node_output_slots[node->id()] = item.output_slots;
+      items.push_back(std::move(item));
+    }
+    for (int slot : ret_slots) {
+      if (slot < 0) return OkStatus();
+    }
+    out->reset(new InlineFunctionRunner(device, num_inputs, next_slot,
+                                        std::move(items),
+                                        std::move(ret_slots)));
+    return OkStatus();
+  }
+
+  // Runs the plan on `args` followed by the function's `captured` inputs and
+  // stores the results in `*rets`.  Thread-safe.
+  Status Run(const std::vector<Tensor>& args,
+             const std::vector<Tensor>& captured,
+             std::vector<Tensor>* rets) const {
+    if (static_cast<int>(args.size() + captured.size()) != num_inputs_) {
+      return errors::InvalidArgument("Expected ", num_inputs_,
+                                     " arguments but got ",
+                                     args.size() + captured.size(), ".");
+    }
+    std::vector<Tensor> slots(num_slots_);
+    std::copy(args.begin(), args.end(), slots.begin());
+    std::copy(captured.begin(), captured.end(), slots.begin() + args.size());
+
+    for (const KernelItem& item : items_) {
+      gtl::InlinedVector<TensorValue, 4> inputs;
+      inputs.reserve(item.input_slots.size());
+      for (int slot : item.input_slots) {
+        inputs.push_back(TensorValue(&slots[slot]));
+      }
+      OpKernelContext::Params params;
+      params.device = device_;
+      params.frame_iter = FrameAndIter(0, 0);
+      params.inputs = inputs;
+      params.op_kernel = item.kernel.get();
+      params.resource_manager = device_->resource_manager();
+      gtl::InlinedVector<AllocatorAttributes, 4> output_attrs(
+          item.output_slots.size());
+      for (AllocatorAttributes& attr : output_attrs) {
+        attr.set_on_host(true);
+      }
+      params.output_attr_array = output_attrs.data();
+      OpKernelContext op_ctx(&params);
+      item.kernel->Compute(&op_ctx);
+      TF_RETURN_IF_ERROR(op_ctx.status());
+      for (size_t i = 0; i < item.output_slots.size(); ++i) {
+        Tensor* output = op_ctx.mutable_output(i);
+        if (output == nullptr) {
+          return errors::Internal("Missing output ", i, " from inline kernel ",
+                                  item.kernel->name());
+        }
+        slots[item.output_slots[i]] = *output;
+      }
+    }
+
+    rets->reserve(ret_slots_.size());
+    for (int slot : ret_slots_) {
+      rets->push_back(slots[slot]);
+    }
+    return OkStatus();
+  }
+
+ private:
+  struct KernelItem {
+    std::unique_ptr<OpKernel> kernel;
+    // Index into the value table for every kernel input and output.
+    std::vector<int> input_slots;
+    std::vector<int> output_slots;
+  };
+
+  InlineFunctionRunner(Device* device, int num_inputs, int num_slots,
+                       std::vector<KernelItem> items, std::vector<int> ret_slots)
+      : device_(device),
+        num_inputs_(num_inputs),
+        num_slots_(num_slots),
+        items_(std::move(items)),
+        ret_slots_(std::move(ret_slots)) {}
+
+  Device* const device_;  // Not owned.
+  const int num_inputs_;  // Function arguments, including captured inputs.
+  const int num_slots_;
+  const std::vector<KernelItem> items_;
+  const std::vector<int> ret_slots_;
+};
+
 Status MakeIteratorFromInputElement(
     IteratorContext* ctx, const IteratorBase* parent,
     const std::vector<Tensor>& input_element, int64_t thread_index,
@@ -676,9 +905,23 @@ Status CapturedFunction::Instantiate(
 
   bool is_multi_device;
   TF_RETURN_IF_ERROR(IsMultiDevice(lib, &is_multi_device));
-  *instantiated_captured_function = absl::WrapUnique(
-      new InstantiatedCapturedFunction(lib, f_handle, std::move(ret_types),
-                                       *params.runner, this, is_multi_device));
+
+  std::unique_ptr<InlineFunctionRunner> inline_runner;
+  bool inline_enabled = false;
+  TF_RETURN_IF_ERROR(InlineFunctionExecutionEnabled(&inline_enabled));
+  if (inline_enabled && !is_multi_device) {
+    TF_RETURN_IF_ERROR(
+        InlineFunctionRunner::Create(lib, f_handle, &inline_runner));
+    if (inline_runner) {
+      VLOG(2) << "Executing function " << metadata_->func().name()
+              << " as an inline kernel-call sequence.";
+    }
+  }
+
+  *instantiated_captured_function =
+      absl::WrapUnique(new InstantiatedCapturedFunction(
+          lib, f_handle, std::move(ret_types), *params.runner, this,
+          is_multi_device, std::move(inline_runner)));
   return OkStatus();
 }
 
@@ -774,13 +1017,17 @@ Status CapturedFunction::IsMultiDevice(FunctionLibraryRuntime* flr,
 InstantiatedCapturedFunction::InstantiatedCapturedFunction(
     FunctionLibraryRuntime* lib, FunctionLibraryRuntime::Handle f_handle,
     DataTypeVector ret_types, std::function<void(std::function<void()>)> runner,
-    CapturedFunction* captured_func, bool is_multi_device)
+    CapturedFunction* captured_func, bool is_multi_device,
+    std::unique_ptr<InlineFunctionRunner> inline_runner)
     : lib_(lib),
       f_handle_(f_handle),
       ret_types_(std::move(ret_types)),
       captured_runner_(std::move(runner)),
       captured_func_(captured_func),
-      is_multi_device_(is_multi_device) {}
+      is_multi_device_(is_multi_device),
+      inline_runner_(std::move(inline_runner)) {}
+
+InstantiatedCapturedFunction::~InstantiatedCapturedFunction() = default;
 
 Status InstantiatedCapturedFunction::Run(IteratorContext* ctx,
                                          std::vector<Tensor>&& args,
@@ -795,6 +1042,9 @@ Status InstantiatedCapturedFunction::Run(
   if (!info.indices.empty()) {
     return RunShortCircuit(info, std::move(args), captured_func_, rets);
   }
+  if (inline_runner_) {
+    return inline_runner_->Run(args, captured_func_->captured_inputs(), rets);
+  }
 
   FunctionLibraryRuntime::Options f_opts;
   ScopedStepContainer step_container(
@@ -858,6 +1108,9 @@ Status InstantiatedCapturedFunction::RunWithBorrowedArgs(
   if (!info.indices.empty()) {
     return RunShortCircuit(info, args, captured_func_, rets);
   }
+  if (inline_runner_) {
+    return inline_runner_->Run(args, captured_func_->captured_inputs(), rets);
+  }
 
   FunctionLibraryRuntime::Options f_opts;
   ScopedStepContainer step_container(
@@ -913,6 +1166,9 @@ Status InstantiatedCapturedFunction::RunInstantiated(
   if (!info.indices.empty()) {
     return RunShortCircuit(info, args, captured_func_, rets);
   }
+  if (inline_runner_) {
+    return inline_runner_->Run(args, captured_func_->captured_inputs(), rets);
+  }
 
   FunctionLibraryRuntime::Options f_opts;
   ScopedStepContainer step_container(
@@ -953,6 +1209,16 @@ void InstantiatedCapturedFunction::RunAsync(
                   std::move(done)));
     return;
   }
+  if (inline_runner_) {
+    // As for short circuit above, run the `done` callback on a threadpool
+    // thread.
+    Status s =
+        inline_runner_->Run(args, captured_func_->captured_inputs(), rets);
+    (*ctx->runner())(
+        std::bind([s](FunctionLibraryRuntime::DoneCallback& done) { done(s); },
+                  std::move(done)));
+    return;
+  }
 
   // NOTE(mrry): This method does not transfer ownership of `ctx`, and it may
   // be deleted before `done` is called. Take care not to capture `ctx` in any
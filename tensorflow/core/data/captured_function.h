@@ -40,6 +40,7 @@ class ResourceMgr;
 namespace data {
 
 class CapturedFunction;
+class InlineFunctionRunner;
 class InstantiatedCapturedFunction;
 
 // Creates an iterator for a dataset which is created by applying the given
@@ -233,6 +234,8 @@ class CapturedFunction {
 // functions outside of the normal `OpKernel::Compute()` context.
 class InstantiatedCapturedFunction {
  public:
+  ~InstantiatedCapturedFunction();
+
   // Runs the instantiated captured function. This method takes ownership of
   // the tensors in `args`, in order to be able to deallocate them as early as
   // possible. Use `RunWithBorrowedArgs()` if the caller needs to retain
@@ -297,7 +300,8 @@ class InstantiatedCapturedFunction {
       FunctionLibraryRuntime* lib, FunctionLibraryRuntime::Handle f_handle,
       DataTypeVector ret_types,
       std::function<void(std::function<void()>)> runner,
-      CapturedFunction* captured_func, bool is_multi_device);
+      CapturedFunction* captured_func, bool is_multi_device,
+      std::unique_ptr<InlineFunctionRunner> inline_runner);
 
   // Determines whether a rendezvous object should be created when running the
   // instantiated function.
@@ -311,6 +315,11 @@ class InstantiatedCapturedFunction {
   std::function<void(std::function<void()>)> captured_runner_;
   CapturedFunction* const captured_func_;  // Not owned.
   const bool is_multi_device_;
+  // If non-null, the function is executed as a precompiled sequence of direct
+  // kernel calls on the caller's thread, skipping `FunctionLibraryRuntime`
+  // dispatch entirely.  Only populated for small stateless functions made of
+  // allowlisted ops.
+  const std::unique_ptr<InlineFunctionRunner> inline_runner_;
 
   InstantiatedCapturedFunction(const InstantiatedCapturedFunction&) = delete;
   void operator=(const InstantiatedCapturedFunction&) = delete;
@@ -106,6 +106,7 @@ constexpr char kSlackOpt[] = "slack";
 constexpr char kSlackPeriodOpt[] = "slack_period";
 constexpr char kMakeDeterministicOpt[] = "make_deterministic";
 constexpr char kFilterParallelizationOpt[] = "filter_parallelization";
+constexpr char kFuseDecodeJpegOpt[] = "fuse_decode_jpeg";
 constexpr char kWarmStartOpt[] = "warm_start";
 
 void DefaultOptimizationGraphRewrites(
@@ -184,6 +185,14 @@ void DefaultOptimizationGraphRewrites(
       optimization_disabled->insert(kFilterParallelizationOpt);
     }
   }
+  if (optimization_options.optional_fuse_decode_jpeg_case() ==
+      OptimizationOptions::kFuseDecodeJpeg) {
+    if (optimization_options.fuse_decode_jpeg()) {
+      optimization_enabled->insert(kFuseDecodeJpegOpt);
+    } else {
+      optimization_disabled->insert(kFuseDecodeJpegOpt);
+    }
+  }
   if (optimization_options.optional_map_fusion_case() ==
       OptimizationOptions::kMapFusion) {
     if (optimization_options.map_fusion()) {
@@ -16,6 +16,7 @@ limitations under the License.
 
 #include <array>
 #include <memory>
+#include <optional>
 #include <queue>
 #include <string>
 #include <utility>
@@ -40,9 +41,13 @@ limitations under the License.
 #include "tensorflow/core/framework/types.h"
 #include "tensorflow/core/graph/graph_def_builder.h"
 #include "tensorflow/core/lib/core/errors.h"
+#include "tensorflow/core/lib/core/threadpool.h"
 #include "tensorflow/core/lib/hash/hash.h"
 #include "tensorflow/core/lib/strings/proto_serialization.h"
+#include "tensorflow/core/platform/cpu_info.h"
+#include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/platform/regexp.h"
 #include "tensorflow/core/platform/status.h"
 #include "tensorflow/core/util/work_sharder.h"
@@ -132,6 +137,65 @@ Status ParseInputNodeName(absl::string_view input_name,
   return OkStatus();
 }
 
+// Minimum number of reachable nodes before the per-node canonicalization
+// hashes are computed in parallel rather than on demand during the serial
+// merge. Small graphs are not worth the thread fan-out.
+constexpr int kMinNodesForParallelHash = 256;
+
+// Content fingerprint of a function library: the unordered combination of the
+// deterministic proto hashes of its function definitions. Serializing every
+// function is much cheaper than structurally hashing their bodies, and the
+// result changes whenever any (possibly nested) function changes.
+uint64 FunctionLibraryFingerprint(const FunctionLibraryDefinition& flib) {
+  uint64 fp = 0;
+  for (const std::string& name : flib.ListFunctionNames()) {
+    const FunctionDef* fdef = flib.Find(name);
+    if (fdef == nullptr) continue;
+    fp = Hash64CombineUnordered(fp, DeterministicProtoHash64(*fdef));
+  }
+  return fp;
+}
+
+uint64 AttrValueMapFingerprint(const AttrValueMap& attrs) {
+  uint64 fp = 0;
+  for (const auto& attr : attrs) {
+    fp = Hash64CombineUnordered(
+        fp, Hash64Combine(Hash64(attr.first),
+                          DeterministicProtoHash64(attr.second)));
+  }
+  return fp;
+}
+
+// Process-wide cache of function body hashes, keyed by the fingerprints of
+// the function definition, its instantiation attrs, and the surrounding
+// library. Because the key is derived from content rather than pointers, the
+// cache stays valid across graphs and runs: rehashing a pipeline only walks
+// the function bodies that actually changed.
+class FunctionHashCache {
+ public:
+  static FunctionHashCache* Get() {
+    static FunctionHashCache* const cache = new FunctionHashCache;
+    return cache;
+  }
+
+  bool Lookup(uint64 key, uint64* hash) {
+    tf_shared_lock l(mu_);
+    auto it = hashes_.find(key);
+    if (it == hashes_.end()) return false;
+    *hash = it->second;
+    return true;
+  }
+
+  void Insert(uint64 key, uint64 hash) {
+    mutex_lock l(mu_);
+    hashes_.emplace(key, hash);
+  }
+
+ private:
+  mutex mu_;
+  absl::flat_hash_map<uint64, uint64> hashes_ TF_GUARDED_BY(mu_);
+};
+
 // Given a graph_def and a root_node, this class computes a fingerprint that
 // tries to capture the structure of the graph rooted at the provided node.
 // It does not at any point rely on the names of the nodes in the graph and
@@ -161,13 +225,15 @@ class GraphHasher {
                        const FunctionLibraryDefinition* flib,
                        std::shared_ptr<NodeCache> node_cache,
                        std::shared_ptr<FunctionCache> function_cache,
-                       std::shared_ptr<AttrCache> attr_cache)
+                       std::shared_ptr<AttrCache> attr_cache,
+                       std::optional<uint64> flib_fingerprint = std::nullopt)
       : graph_(graph),
         root_(root),
         flib_(flib),
         node_cache_(node_cache),
         function_cache_(function_cache),
-        attr_cache_(attr_cache) {}
+        attr_cache_(attr_cache),
+        flib_fingerprint_(flib_fingerprint) {}
 
   Status Init() {
     // Construct a map of name -> NodeDef to avoid repeated linear searches.
@@ -236,7 +302,7 @@ class GraphHasher {
       }
       nodes_[node] = node_rep;
     }
-    return OkStatus();
+    return PrefillNodeHashes();
   }
 
   Status HashRoot(uint64* hash) { return HashNode(root_, hash); }
@@ -348,6 +414,23 @@ class GraphHasher {
       *hash = iter->second;
       return OkStatus();
     }
+    TF_RETURN_IF_ERROR(ComputeNodeNonInputHash(node, hash_functions, hash));
+
+    auto result =
+        attr_cache_->emplace(std::make_pair(node, hash_functions), *hash);
+    if (!result.second) {
+      return errors::Internal(absl::StrCat(
+          "Computed the hash for non-input node: ", node->DebugString(),
+          " and hash function bool: ", hash_functions, "twice!"));
+    }
+    return OkStatus();
+  }
+
+  // Computes the hash of everything about `node` except its inputs, without
+  // consulting or updating `attr_cache_`. Thread-safe for nodes that do not
+  // reference functions (see `PrefillNodeHashes`).
+  Status ComputeNodeNonInputHash(const NodeDef* node, bool hash_functions,
+                                 uint64* hash) {
     // Hash Attrs. We get the list of attrs from the op registry and then look
     // up their values in the NodeDef attr map. This avoids looping over
     // a map which is non-deterministic.
@@ -387,13 +470,56 @@ class GraphHasher {
     uint64 device_hash = Hash64(node->device());
 
     *hash = Hash64Combine(op_hash, Hash64Combine(attrs_hash, device_hash));
+    return OkStatus();
+  }
 
-    auto result =
-        attr_cache_->emplace(std::make_pair(node, hash_functions), *hash);
-    if (!result.second) {
-      return errors::Internal(absl::StrCat(
-          "Computed the hash for non-input node: ", node->DebugString(),
-          " and hash function bool: ", hash_functions, "twice!"));
+  // Computes the per-node canonicalization hashes for the reachable nodes in
+  // parallel and seeds `attr_cache_` with the results, so that the serial
+  // dependency-order merge in `HashNode` only combines precomputed values.
+  // The per-node hash is dominated by deterministic proto serialization of
+  // the attrs, which is independent across nodes. Only nodes whose hash does
+  // not depend on function bodies are precomputed; function-referencing nodes
+  // keep the serial path (and its shared caches), and so do any nodes whose
+  // ops fail to resolve, to surface errors exactly as before.
+  Status PrefillNodeHashes() {
+    std::vector<const NodeDef*> eligible;
+    for (const auto& entry : nodes_) {
+      const NodeDef* node = entry.first;
+      if (attr_cache_->contains(std::make_pair(node, true))) continue;
+      const OpRegistrationData* reg;
+      if (!flib_->LookUp(node->op(), &reg).ok()) continue;
+      if (reg->is_function_op) continue;
+      bool references_function = false;
+      for (const auto& attr : node->attr()) {
+        if (attr.second.has_func() || attr.second.list().func_size() > 0) {
+          references_function = true;
+          break;
+        }
+      }
+      if (!references_function) eligible.push_back(node);
+    }
+    if (eligible.size() < static_cast<size_t>(kMinNodesForParallelHash)) {
+      return OkStatus();
+    }
+
+    std::vector<uint64> hashes(eligible.size(), 0);
+    std::vector<Status> statuses(eligible.size());
+    const int num_threads = port::NumSchedulableCPUs();
+    thread::ThreadPool pool(Env::Default(), "graph_hasher", num_threads);
+    constexpr int64_t kCostPerNodeCycles = 10000;
+    pool.ParallelFor(eligible.size(), kCostPerNodeCycles,
+                     [this, &eligible, &hashes, &statuses](int64_t start,
+                                                           int64_t end) {
+                       for (int64_t i = start; i < end; ++i) {
+                         // `hash_functions` is irrelevant for these nodes.
+                         statuses[i] = ComputeNodeNonInputHash(
+                             eligible[i], /*hash_functions=*/true, &hashes[i]);
+                       }
+                     });
+    for (size_t i = 0; i < eligible.size(); ++i) {
+      TF_RETURN_IF_ERROR(statuses[i]);
+      attr_cache_->emplace(std::make_pair(eligible[i], true), hashes[i]);
+      attr_cache_->emplace(std::make_pair(eligible[i], false), hashes[i]);
     }
     return OkStatus();
   }
@@ -535,6 +661,17 @@ class GraphHasher {
       return OkStatus();
     }
 
+    // Consult the process-wide cache before walking the function body. The
+    // key covers the function definition, its instantiation attrs and the
+    // whole library (so changes to nested functions invalidate it).
+    const uint64 content_key = Hash64Combine(
+        FlibFingerprint(), Hash64Combine(DeterministicProtoHash64(*fdef),
+                                         AttrValueMapFingerprint(attrs)));
+    if (FunctionHashCache::Get()->Lookup(content_key, hash)) {
+      function_cache_->emplace(fdef, *hash);
+      return OkStatus();
+    }
+
     // Convert to a GraphDef.
     std::unique_ptr<FunctionBody> fbody;
     TF_RETURN_IF_ERROR(
@@ -547,7 +684,7 @@ class GraphHasher {
     for (const auto& ret_node : fbody->ret_nodes) {
       uint64 ret_node_hash = 0;
       GraphHasher hasher(&graph_def, &ret_node->def(), flib_, node_cache_,
-                         function_cache_, attr_cache_);
+                         function_cache_, attr_cache_, flib_fingerprint_);
       TF_RETURN_IF_ERROR(hasher.Init());
       TF_RETURN_IF_ERROR(hasher.HashRoot(&ret_node_hash));
       ret_nodes_hash = Hash64Combine(ret_nodes_hash, ret_node_hash);
@@ -568,6 +705,7 @@ class GraphHasher {
       return errors::Internal(
           absl::StrCat("Computed the hash for function ", name, " twice!"));
     }
+    FunctionHashCache::Get()->Insert(content_key, *hash);
     return OkStatus();
   }
 
@@ -617,10 +755,11 @@ class GraphHasher {
       const NodeDef* this_root = &this_fbody->ret_nodes[i]->def();
       const NodeDef* that_root = &that_fbody->ret_nodes[i]->def();
       GraphHasher this_hasher(&this_graph_def, this_root, flib_, node_cache_,
-                              function_cache_, attr_cache_);
+                              function_cache_, attr_cache_, flib_fingerprint_);
       TF_RETURN_IF_ERROR(this_hasher.Init());
       GraphHasher that_hasher(&that_graph_def, that_root, that->flib_,
-                              node_cache_, function_cache_, attr_cache_);
+                              node_cache_, function_cache_, attr_cache_,
+                              that->flib_fingerprint_);
       TF_RETURN_IF_ERROR(that_hasher.Init());
       TF_RETURN_IF_ERROR(this_hasher.CheckEqual(&that_hasher));
     }
@@ -720,6 +859,16 @@ class GraphHasher {
   std::shared_ptr<NodeCache> node_cache_;
   std::shared_ptr<FunctionCache> function_cache_;
   std::shared_ptr<AttrCache> attr_cache_;
+  // Lazily computed content fingerprint of `flib_`, shared with nested
+  // hashers so each library is fingerprinted at most once per root hash.
+  std::optional<uint64> flib_fingerprint_;
+
+  uint64 FlibFingerprint() {
+    if (!flib_fingerprint_.has_value()) {
+      flib_fingerprint_ = FunctionLibraryFingerprint(*flib_);
+    }
+    return *flib_fingerprint_;
+  }
 };
 
 }  // anonymous namespace
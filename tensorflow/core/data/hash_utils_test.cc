@@ -241,6 +241,36 @@ TEST_F(DatasetHashUtilsTest, HashNodeSameGraphDifferentNames) {
   TF_EXPECT_OK(CheckSubgraphsEqual(gd, n3, gd, n6));
 }
 
+TEST_F(DatasetHashUtilsTest, HashNodeLargeGraphParallelPrefill) {
+  // Large enough to take the parallel node-hash prefill path.
+  constexpr int kChainLength = 400;
+  GraphDef gd;
+
+  NodeDef* n = gd.add_node();
+  TF_CHECK_OK(NodeDefBuilder("node_0", "Const")
+                  .Attr("value", 1)
+                  .Device("CPU:0")
+                  .Finalize(n));
+  for (int i = 1; i < kChainLength; ++i) {
+    NodeDef* add = gd.add_node();
+    TF_CHECK_OK(NodeDefBuilder(absl::StrCat("node_", i), "Add")
+                    .Device("CPU:0")
+                    .Input(absl::StrCat("node_", i - 1), 0, DT_INT32)
+                    .Input(absl::StrCat("node_", i - 1), 0, DT_INT32)
+                    .Finalize(add));
+  }
+  NodeDef* root = gd.mutable_node(kChainLength - 1);
+
+  uint64 hash1 = GetHash(gd, *root);
+  uint64 hash2 = GetHash(gd, *root);
+  EXPECT_EQ(hash1, hash2);
+
+  // Changing a node deep in the chain changes the hash.
+  gd.mutable_node(0)->mutable_attr()->at("value").set_i(2);
+  uint64 hash3 = GetHash(gd, *root);
+  EXPECT_NE(hash1, hash3);
+}
+
 TEST_F(DatasetHashUtilsTest, HashNodeDifferentGraphs) {
   GraphDef gd;
 
@@ -33,9 +33,11 @@ limitations under the License.
 #include "tensorflow/core/platform/errors.h"
 #include "tensorflow/core/platform/host_info.h"
 #include "tensorflow/core/platform/mem.h"
+#include "tensorflow/core/platform/numa.h"
 #include "tensorflow/core/platform/refcount.h"
 #include "tensorflow/core/platform/status.h"
 #include "tensorflow/core/platform/stringprintf.h"
+#include "tensorflow/core/util/env_var.h"
 
 namespace tensorflow {
 namespace data {
@@ -59,6 +61,65 @@ inline int64_t value_or_default(int64_t x, int64_t y, int64_t z) {
   return x == y ? z : x;
 }
 
+// Returns the NUMA node the input pipeline should be confined to, or
+// `port::kNUMANoAffinity` when no execution domain is configured. Controlled
+// by the `TF_DATA_NUMA_NODE` environment variable, so that input pipeline
+// threads on multi-socket hosts can be isolated to the cores of one node
+// instead of trampling the caches of the training threads.
+int DataNumaNode() {
+  static const int numa_node = [] {
+    int64_t value = port::kNUMANoAffinity;
+    Status status =
+        ReadInt64FromEnvVar("TF_DATA_NUMA_NODE", port::kNUMANoAffinity, &value);
+    if (!status.ok()) {
+      LOG(ERROR) << "Error parsing TF_DATA_NUMA_NODE: " << status;
+      return port::kNUMANoAffinity;
+    }
+    if (value == port::kNUMANoAffinity) {
+      return port::kNUMANoAffinity;
+    }
+    if (value < 0 || value >= port::NUMANumNodes()) {
+      LOG(WARNING) << "TF_DATA_NUMA_NODE is " << value << " but the host has "
+                   << port::NUMANumNodes() << " NUMA node(s); ignoring it.";
+      return port::kNUMANoAffinity;
+    }
+    return static_cast<int>(value);
+  }();
+  return numa_node;
+}
+
+// Pins the calling thread to `numa_node` the first time it runs pipeline
+// work. Buffers the pipeline produces (e.g. prefetched elements) are then
+// allocated on that node by first touch, so configuring the node the
+// consumer runs on makes the hand-off NUMA-local.
+void EnsureThreadNumaAffinity(int numa_node) {
+  static thread_local int pinned_node = port::kNUMANoAffinity;
+  if (pinned_node == numa_node) {
+    return;
+  }
+  pinned_node = numa_node;
+  port::NUMASetThreadNodeAffinity(numa_node);
+}
+
+// Starts iterator background threads (e.g. prefetch producers) that pin
+// themselves to the pipeline's NUMA node before running their work.
+class NumaPinnedThreadFactory : public ThreadFactory {
+ public:
+  explicit NumaPinnedThreadFactory(int numa_node) : numa_node_(numa_node) {}
+
+  std::unique_ptr<Thread> StartThread(const string& name,
+                                      std::function<void()> fn) override {
+    return std::unique_ptr<Thread>(Env::Default()->StartThread(
+        {}, name, [numa_node = numa_node_, fn = std::move(fn)]() {
+          EnsureThreadNumaAffinity(numa_node);
+          fn();
+        }));
+  }
+
+ private:
+  const int numa_node_;
+};
+
 void SetRootDatasetParams(const Options& options, RootDataset::Params* params) {
   if (ShouldConfigureMaxIntraOpParallelism(options)) {
     params->max_intra_op_parallelism =
@@ -177,6 +238,10 @@ class RootDataset::Iterator : public DatasetIterator<RootDataset> {
           Env::Default(), ThreadOptions{}, "data_private_threadpool",
           threadpool_size_);
     }
+    if (DataNumaNode() != port::kNUMANoAffinity) {
+      numa_thread_factory_ =
+          std::make_shared<NumaPinnedThreadFactory>(DataNumaNode());
+    }
     cancellation_manager_ = std::make_unique<CancellationManager>();
   }
 
@@ -190,6 +255,13 @@ class RootDataset::Iterator : public DatasetIterator<RootDataset> {
     // we need to pass ram_budget_manager_ to the downstream dataset operations
     ram_budget_manager_ = std::make_shared<model::RamBudgetManager>(
         dataset()->params_.ComputeInitialAutotuneRamBudget());
+    if (dataset()->params_.autotune_ram_budget_from_options > 0) {
+      // An explicit `ram_budget` in `Options` is a hard cap on the bytes
+      // buffered across the pipeline, not only an autotune target: iterators
+      // charge their buffered elements against it and producers stall when it
+      // is exceeded.
+      ram_budget_manager_->MarkBudgetAsHardLimit();
+    }
 
     if (dataset()->params_.autotune) {
       model_ = ctx->model() != nullptr ? ctx->model()
@@ -292,10 +364,29 @@ class RootDataset::Iterator : public DatasetIterator<RootDataset> {
     // been set to a valid model in `Initialize()` if autotuning is on. We
     // should simply set `params.model` to `model_` here.
     params.model = model_;
+    // Confine threads started by the iterators (e.g. prefetch producers) to
+    // the configured NUMA node. Do not override a thread factory installed
+    // by the surrounding context (e.g. tf.data service).
+    if (numa_thread_factory_ != nullptr && params.thread_factory == nullptr) {
+      params.thread_factory = numa_thread_factory_;
+    }
     if (dataset()->params_.private_threadpool_size >= 0) {
-      params.runner = [pool = thread_pool_.get()](std::function<void()> c) {
-        pool->Schedule(std::move(c));
-      };
+      const int numa_node = DataNumaNode();
+      if (numa_node != port::kNUMANoAffinity) {
+        // Pin the private threadpool threads on first use, so the pipeline
+        // only competes for the cores of its own node.
+        params.runner = [pool = thread_pool_.get(),
+                         numa_node](std::function<void()> c) {
+          pool->Schedule([numa_node, c = std::move(c)]() {
+            EnsureThreadNumaAffinity(numa_node);
+            c();
+          });
+        };
+      } else {
+        params.runner = [pool = thread_pool_.get()](std::function<void()> c) {
+          pool->Schedule(std::move(c));
+        };
+      }
       params.runner_threadpool_size = threadpool_size_;
     }
     if (dataset()->params_.max_intra_op_parallelism >= 0) {
@@ -343,6 +434,8 @@ class RootDataset::Iterator : public DatasetIterator<RootDataset> {
   int64_t max_intra_op_parallelism_;
   int64_t threadpool_size_;
   std::unique_ptr<thread::ThreadPool> thread_pool_;
+  // Set when a NUMA execution domain is configured via TF_DATA_NUMA_NODE.
+  std::shared_ptr<ThreadFactory> numa_thread_factory_;
 
   // The end time of the previous `GetNextInternal` call.
   uint64_t end_time_usec_ TF_GUARDED_BY(mu_) = 0;
@@ -49,6 +49,7 @@ limitations under the License.
 #include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/platform/status.h"
 #include "tensorflow/core/platform/statusor.h"
+#include "tensorflow/core/util/env_var.h"
 #include "tensorflow/core/platform/thread_annotations.h"
 #include "tensorflow/core/profiler/lib/traceme.h"
 #include "tensorflow/core/profiler/lib/traceme_encode.h"
@@ -77,11 +78,26 @@ StatusOr<DataTransferServerInfo> GetTransferServer(const std::string& protocol,
                           task_info.worker_address());
 }
 
+// Number of concurrent element requests a worker thread may keep in flight
+// for one task. A depth greater than one hides the latency of a slow
+// response behind the task's other outstanding requests.
+int64_t GetMaxRequestsPerTask() {
+  int64_t value;
+  Status s = ReadInt64FromEnvVar("TF_DATA_SERVICE_CLIENT_REQUESTS_PER_WORKER",
+                                 /*default_val=*/1, &value);
+  if (!s.ok()) {
+    LOG(ERROR) << s.message();
+    return 1;
+  }
+  return std::max<int64_t>(value, 1);
+}
+
 }  // namespace
 
 DataServiceClient::DataServiceClient(const DataServiceParams& params)
     : params_(params),
-      max_outstanding_requests_(params.max_outstanding_requests) {}
+      max_outstanding_requests_(params.max_outstanding_requests),
+      max_requests_per_task_(GetMaxRequestsPerTask()) {}
 
 DataServiceClient::~DataServiceClient() {
   VLOG(2) << "Destroying data service client for iteration id "
@@ -575,8 +591,10 @@ void DataServiceClient::UpdateBufferSize() TF_LOCKS_EXCLUDED(mu_) {
 
 void DataServiceClient::UpdateWorkerThreads() TF_LOCKS_EXCLUDED(mu_) {
   mutex_lock l(mu_);
-  const int64_t max_num_threads =
-      std::min<int64_t>(tasks_.size(), max_outstanding_requests_);
+  const int64_t requests_per_task =
+      IsCoordinatedRead() ? 1 : max_requests_per_task_;
+  const int64_t max_num_threads = std::min<int64_t>(
+      tasks_.size() * requests_per_task, max_outstanding_requests_);
   while (num_running_worker_threads_ < max_num_threads && !cancelled_ &&
          status_.ok()) {
     num_running_worker_threads_++;
@@ -605,7 +623,7 @@ void DataServiceClient::RunWorkerThread(std::function<void()> done)
     {
       mutex_lock l(mu_);
       if (task_to_process) {
-        task_to_process->in_use = false;
+        --task_to_process->in_flight;
         --outstanding_requests_;
         task_to_process = nullptr;
         worker_thread_cv_.notify_one();
@@ -623,7 +641,7 @@ void DataServiceClient::RunWorkerThread(std::function<void()> done)
         worker_thread_cv_.wait(l);
       }
       DCHECK(task_to_process != nullptr);
-      task_to_process->in_use = true;
+      ++task_to_process->in_flight;
       ++outstanding_requests_;
       if (IsCoordinatedRead()) {
         // Reserve a spot in the results_ queue.
@@ -644,7 +662,7 @@ void DataServiceClient::RunWorkerThread(std::function<void()> done)
       mutex_lock l(mu_);
       VLOG(1) << "Failed to get element from worker "
               << task_to_process->info.worker_address() << ": " << s;
-      task_to_process->in_use = false;
+      --task_to_process->in_flight;
       --outstanding_requests_;
       status_ = errors::CreateWithUpdatedMessage(
           s, absl::StrCat("Failed to get element from worker ",
@@ -681,21 +699,26 @@ std::shared_ptr<DataServiceClient::Task> DataServiceClient::GetTaskToProcess()
   for (int i = 0; i < tasks_.size(); ++i) {
     std::shared_ptr<Task>& task = tasks_[next_task_index_];
     if (IsCoordinatedRead() &&
-        (task->in_use ||
+        (task->in_flight > 0 ||
          current_round_ >= round_robin_round_limit_.value_or(
                                std::numeric_limits<int64_t>::max()))) {
-      VLOG(4) << "No round robin task found. in_use: " << task->in_use
+      VLOG(4) << "No round robin task found. in_flight: " << task->in_flight
               << ". current_round: " << current_round_
               << ". round_robin_round_limit: "
               << round_robin_round_limit_.value_or(-1);
       return nullptr;
     }
-    if (current_round_ < task->info.starting_round() || task->in_use ||
-        task->end_of_sequence || task->removed) {
+    // Coordinated reads must keep at most one request in flight per task to
+    // preserve the strict round order.
+    const int64_t max_in_flight =
+        IsCoordinatedRead() ? 1 : max_requests_per_task_;
+    if (current_round_ < task->info.starting_round() ||
+        task->in_flight >= max_in_flight || task->end_of_sequence ||
+        task->removed) {
       VLOG(3) << "Skipping task " << next_task_index_
               << ". starting round: " << task->info.starting_round()
               << ". current round: " << current_round_
-              << ". task->in_use: " << task->in_use
+              << ". task->in_flight: " << task->in_flight
               << ". end_of_sequence: " << task->end_of_sequence
               << ". task->removed: " << task->removed;
       AdvanceTaskIndex();
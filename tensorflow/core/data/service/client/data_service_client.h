@@ -106,8 +106,10 @@ class DataServiceClient {
     // deleted from `tasks_` on the next dispatcher heartbeat.
     bool removed = false;
     bool skipped_previous_round = false;
-    // Indicates whether a worker thread is currently processing the task.
-    bool in_use TF_GUARDED_BY(&DataServiceClient::mu_) = false;
+    // Number of worker threads currently fetching an element for the task.
+    // Coordinated reads allow at most one in-flight request per task; other
+    // reads allow up to `max_requests_per_task_`.
+    int64_t in_flight TF_GUARDED_BY(&DataServiceClient::mu_) = 0;
     // Indicates whether the worker has returned end_of_sequence for the task.
     bool end_of_sequence TF_GUARDED_BY(&DataServiceClient::mu_) = false;
     // Number of retries. The more it is retried, the longer it should wait
@@ -205,6 +207,11 @@ class DataServiceClient {
   // elements as well as completed requests which haven't yet been produced.
   int64_t max_outstanding_requests_ TF_GUARDED_BY(mu_);
 
+  // Maximum number of concurrent element requests per task. Keeping several
+  // requests in flight per worker hides the latency of a slow response behind
+  // the other outstanding ones. Coordinated reads always use 1.
+  const int64_t max_requests_per_task_;
+
   // The number of threads in `worker_threads_` which are still running.
   int64_t num_running_worker_threads_ TF_GUARDED_BY(mu_) = 0;
 
@@ -18,6 +18,7 @@ limitations under the License.
 #include <algorithm>
 #include <array>
 #include <cstdint>
+#include <deque>
 #include <memory>
 #include <optional>
 #include <string>
@@ -31,8 +32,10 @@ limitations under the License.
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/memory/memory.h"
+#include "absl/strings/match.h"
 #include "absl/strings/numbers.h"
 #include "absl/strings/str_split.h"
+#include "absl/strings/string_view.h"
 #include "absl/time/time.h"
 #include "tensorflow/core/data/dataset_utils.h"
 #include "tensorflow/core/data/hash_utils.h"
@@ -125,6 +128,31 @@ std::string DatasetsDir(const std::string& work_dir) {
   return io::JoinPath(work_dir, kDatasetsDir);
 }
 
+// How many splits to pull ahead from a split provider when choosing splits by
+// locality. Larger values improve the chance of a local match at the cost of
+// dispatcher memory and more skipped splits on dispatcher restart.
+constexpr int kLocalitySplitLookahead = 4;
+
+// The hostname of `address`, which is in the format "host" or "host:port".
+std::string HostFromAddress(absl::string_view address) {
+  size_t colon = address.rfind(':');
+  if (colon == absl::string_view::npos) {
+    return std::string(address);
+  }
+  return std::string(address.substr(0, colon));
+}
+
+// Best-effort check for whether the data behind `split` lives on `host`. A
+// split is considered local when it is a scalar string (typically a filename)
+// that mentions the host, which matches host-sharded directory layouts. A
+// filesystem-specific block location lookup could replace this heuristic.
+bool SplitIsLocalToHost(const Tensor& split, absl::string_view host) {
+  if (host.empty() || split.dtype() != DT_STRING || split.dims() != 0) {
+    return false;
+  }
+  return absl::StrContains(split.scalar<tstring>()(), host);
+}
+
 Status CreateWorkerStub(const std::string& address, const std::string& protocol,
                         std::unique_ptr<WorkerService::Stub>& stub) {
   ::grpc::ChannelArguments args;
@@ -514,20 +542,27 @@ Status DataServiceDispatcherImpl::GetSplit(const GetSplitRequest* request,
     // the previous repetitions as completed and advance to the requested
     // repetition.
     TF_RETURN_IF_ERROR(split_providers_[iteration_id][provider_index]->Reset());
+    buffered_splits_.erase({iteration_id, provider_index});
   }
   SplitProvider* split_provider =
       split_providers_[iteration_id][provider_index].get();
   DCHECK(split_provider != nullptr);
   Tensor split;
   bool end_of_splits = false;
-  TF_RETURN_IF_ERROR(split_provider->GetNext(&split, &end_of_splits));
-  TF_RETURN_IF_ERROR(RecordSplitProduced(iteration_id, repetition,
-                                         request->split_provider_index(),
-                                         end_of_splits));
+  if (config_.locality_aware_splits() && !request->worker_address().empty()) {
+    TF_RETURN_IF_ERROR(
+        GetNextLocalitySplit(*request, *split_provider, split, end_of_splits));
+  } else {
+    TF_RETURN_IF_ERROR(split_provider->GetNext(&split, &end_of_splits));
+    TF_RETURN_IF_ERROR(RecordSplitProduced(iteration_id, repetition,
+                                           request->split_provider_index(),
+                                           end_of_splits));
+  }
   response->set_end_of_splits(end_of_splits);
   if (end_of_splits) {
     // Reset the split provider to prepare for the next iteration.
     TF_RETURN_IF_ERROR(split_providers_[iteration_id][provider_index]->Reset());
+    buffered_splits_.erase({iteration_id, provider_index});
   } else {
     split.AsProtoTensorContent(response->mutable_split());
   }
@@ -535,6 +570,48 @@ Status DataServiceDispatcherImpl::GetSplit(const GetSplitRequest* request,
   return OkStatus();
 }
 
+Status DataServiceDispatcherImpl::GetNextLocalitySplit(
+    const GetSplitRequest& request, SplitProvider& split_provider,
+    Tensor& split, bool& end_of_splits) TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+  int64_t iteration_id = request.iteration_id();
+  int64_t provider_index = request.split_provider_index();
+  std::deque<Tensor>& buffer =
+      buffered_splits_[{iteration_id, provider_index}];
+  // Pull ahead so there are splits to choose between. Splits are recorded as
+  // produced when they enter the buffer, which keeps the journal consistent
+  // with the provider's position; buffered splits are skipped if the
+  // dispatcher restarts.
+  while (buffer.size() < kLocalitySplitLookahead) {
+    Tensor next;
+    bool provider_end = false;
+    TF_RETURN_IF_ERROR(split_provider.GetNext(&next, &provider_end));
+    if (provider_end) {
+      break;
+    }
+    TF_RETURN_IF_ERROR(RecordSplitProduced(iteration_id, request.repetition(),
+                                           provider_index,
+                                           /*finished=*/false));
+    buffer.push_back(std::move(next));
+  }
+  if (buffer.empty()) {
+    end_of_splits = true;
+    return RecordSplitProduced(iteration_id, request.repetition(),
+                               provider_index, /*finished=*/true);
+  }
+  const std::string host = HostFromAddress(request.worker_address());
+  auto chosen = buffer.begin();
+  for (auto it = buffer.begin(); it != buffer.end(); ++it) {
+    if (SplitIsLocalToHost(*it, host)) {
+      chosen = it;
+      break;
+    }
+  }
+  split = std::move(*chosen);
+  buffer.erase(chosen);
+  end_of_splits = false;
+  return OkStatus();
+}
+
 Status DataServiceDispatcherImpl::MakeSplitProviders(
     const std::string& dataset_id,
     std::vector<std::unique_ptr<SplitProvider>>& split_providers)
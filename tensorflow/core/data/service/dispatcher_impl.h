@@ -17,9 +17,11 @@ limitations under the License.
 #define TENSORFLOW_CORE_DATA_SERVICE_DISPATCHER_IMPL_H_
 
 #include <cstdint>
+#include <deque>
 #include <memory>
 #include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "absl/container/flat_hash_map.h"
@@ -308,6 +310,14 @@ class DataServiceDispatcherImpl {
   Status RecordSplitProduced(int64_t iteration_id, int64_t repetition,
                              int64_t split_provider_index, bool finished)
       TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  // Returns the next split for `split_provider`, preferring a buffered split
+  // that appears local to the worker at `request.worker_address()`. Buffers a
+  // small number of splits per provider to enable the locality choice; each
+  // split is recorded as produced when it is pulled from the provider.
+  Status GetNextLocalitySplit(const GetSplitRequest& request,
+                              SplitProvider& split_provider, Tensor& split,
+                              bool& end_of_splits)
+      TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
   // Applies a state update, updating both the journal and the in-memory state.
   Status Apply(const Update& update) TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
   // Applies a state update, but doesn't update the journal. Only meant to be
@@ -357,6 +367,10 @@ class DataServiceDispatcherImpl {
   // Mapping from iteration id to the split providers for the iteration.
   absl::flat_hash_map<int64_t, std::vector<std::unique_ptr<SplitProvider>>>
       split_providers_ TF_GUARDED_BY(mu_);
+  // Splits pulled from a provider but not yet handed to a worker, used for
+  // locality-aware split selection. Keyed by {iteration id, provider index}.
+  absl::flat_hash_map<std::pair<int64_t, int64_t>, std::deque<Tensor>>
+      buffered_splits_ TF_GUARDED_BY(mu_);
   // Mapping from round robin iteration id to the round the iteration is
   // currently on. This is based on the data provided by client heartbeats,
   // and may be stale.
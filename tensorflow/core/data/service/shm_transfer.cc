@@ -0,0 +1,480 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/data/service/shm_transfer.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "tensorflow/core/data/service/data_transfer.h"
+#include "tensorflow/core/data/service/worker.pb.h"
+#include "tensorflow/core/framework/dataset.pb.h"
+#include "tensorflow/core/framework/metrics.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/platform/host_info.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/numbers.h"
+#include "tensorflow/core/platform/platform.h"
+#include "tensorflow/core/platform/status.h"
+#include "tensorflow/core/platform/statusor.h"
+
+#if !defined(PLATFORM_WINDOWS)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#endif  // !PLATFORM_WINDOWS
+
+namespace tensorflow {
+namespace data {
+
+std::string ShmSegmentName(int port) {
+  return absl::StrCat("/tfdata_shm_", port);
+}
+
+// The shared memory transport is POSIX-only. On other platforms no factory is
+// registered, so building an "shm" transfer server or client fails with the
+// registry's "no factory registered" error.
+#if !defined(PLATFORM_WINDOWS)
+
+namespace {
+
+constexpr int64_t kDefaultSegmentBytes = 16 << 20;
+constexpr int kSpinIterations = 1 << 14;
+constexpr int64_t kPollSleepMicros = 50;
+// The control block occupies the first cache line of the segment; the
+// payload area starts right after it.
+constexpr int64_t kDataOffset = 64;
+
+// State machine for one request/response exchange. The client moves `kIdle`
+// to `kRequestReady`, the server answers with `kResponseReady` or `kError`,
+// and the client returns the slot to `kIdle` after consuming the payload.
+// `kShutdown` is terminal and is written by the server's destructor.
+enum ShmTransferState : uint32_t {
+  kIdle = 0,
+  kRequestReady = 1,
+  kResponseReady = 2,
+  kError = 3,
+  kShutdown = 4,
+};
+
+// Lives at the start of the shared memory segment. Lock-free atomics are
+// address-free, so they synchronize the two processes through the shared
+// mapping.
+struct ShmControlBlock {
+  std::atomic<uint32_t> state;
+  std::atomic<int32_t> error_code;
+  std::atomic<uint64_t> payload_size;
+  uint64_t data_capacity;
+};
+static_assert(sizeof(ShmControlBlock) <= kDataOffset,
+              "control block must fit before the payload area");
+
+int64_t SegmentBytes() {
+  int64_t bytes = kDefaultSegmentBytes;
+  const char* env = std::getenv("TF_DATA_SHM_SEGMENT_BYTES");
+  if (env != nullptr && strings::safe_strto64(env, &bytes)) {
+    VLOG(1) << "TF_DATA_SHM_SEGMENT_BYTES: " << bytes;
+  }
+  return bytes;
+}
+
+// Polls until the control block leaves `current` or `cancelled` becomes true,
+// spinning briefly before falling back to sleeping between polls. Returns the
+// last observed state.
+uint32_t WaitWhile(ShmControlBlock* control, uint32_t current,
+                   const std::atomic<bool>& cancelled) {
+  int iteration = 0;
+  while (true) {
+    uint32_t state = control->state.load(std::memory_order_acquire);
+    if (state != current || cancelled.load(std::memory_order_relaxed)) {
+      return state;
+    }
+    if (++iteration > kSpinIterations) {
+      Env::Default()->SleepForMicroseconds(kPollSleepMicros);
+    }
+  }
+}
+
+// A POSIX shared memory segment mapped into this process. The creating side
+// owns the segment and unlinks it on destruction.
+class ShmSegment {
+ public:
+  static Status Create(const std::string& name, int64_t bytes,
+                       std::unique_ptr<ShmSegment>* out) {
+    int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) {
+      return errors::Internal("Failed to create shared memory segment ", name,
+                              ": ", strerror(errno));
+    }
+    if (ftruncate(fd, bytes) != 0) {
+      Status s = errors::Internal("Failed to size shared memory segment ",
+                                  name, ": ", strerror(errno));
+      close(fd);
+      shm_unlink(name.c_str());
+      return s;
+    }
+    void* base =
+        mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+      shm_unlink(name.c_str());
+      return errors::Internal("Failed to map shared memory segment ", name,
+                              ": ", strerror(errno));
+    }
+    auto* control = new (base) ShmControlBlock();
+    control->data_capacity = bytes - kDataOffset;
+    control->error_code.store(0, std::memory_order_relaxed);
+    control->payload_size.store(0, std::memory_order_relaxed);
+    control->state.store(kIdle, std::memory_order_release);
+    *out = absl::WrapUnique(new ShmSegment(name, /*owner=*/true, base, bytes));
+    return OkStatus();
+  }
+
+  static Status Open(const std::string& name,
+                     std::unique_ptr<ShmSegment>* out) {
+    int fd = shm_open(name.c_str(), O_RDWR, 0);
+    if (fd < 0) {
+      return errors::Unavailable("Failed to open shared memory segment ", name,
+                                 ": ", strerror(errno));
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+      Status s = errors::Internal("Failed to stat shared memory segment ",
+                                  name, ": ", strerror(errno));
+      close(fd);
+      return s;
+    }
+    int64_t bytes = st.st_size;
+    void* base =
+        mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+      return errors::Internal("Failed to map shared memory segment ", name,
+                              ": ", strerror(errno));
+    }
+    auto segment =
+        absl::WrapUnique(new ShmSegment(name, /*owner=*/false, base, bytes));
+    if (bytes < kDataOffset ||
+        segment->control()->data_capacity !=
+            static_cast<uint64_t>(bytes - kDataOffset)) {
+      return errors::Internal("Shared memory segment ", name,
+                              " has an unexpected layout.");
+    }
+    *out = std::move(segment);
+    return OkStatus();
+  }
+
+  ~ShmSegment() {
+    munmap(base_, bytes_);
+    if (owner_) {
+      shm_unlink(name_.c_str());
+    }
+  }
+
+  ShmControlBlock* control() const {
+    return static_cast<ShmControlBlock*>(base_);
+  }
+  char* data() const { return static_cast<char*>(base_) + kDataOffset; }
+  int64_t data_capacity() const { return bytes_ - kDataOffset; }
+
+ private:
+  ShmSegment(std::string name, bool owner, void* base, int64_t bytes)
+      : name_(std::move(name)), owner_(owner), base_(base), bytes_(bytes) {}
+
+  const std::string name_;
+  const bool owner_;
+  void* const base_;
+  const int64_t bytes_;
+};
+
+class ShmDataTransferServer : public DataTransferServer {
+ public:
+  explicit ShmDataTransferServer(GetElementT get_element)
+      : get_element_(std::move(get_element)) {}
+
+  ~ShmDataTransferServer() override {
+    shutdown_.store(true, std::memory_order_relaxed);
+    if (segment_) {
+      segment_->control()->state.store(kShutdown, std::memory_order_release);
+    }
+    serve_thread_.reset();  // Joins the serving thread.
+  }
+
+  Status Start() override {
+    static std::atomic<int> counter(0);
+    port_ = static_cast<int>(getpid() % 100000) * 100 +
+            counter.fetch_add(1) % 100;
+    TF_RETURN_IF_ERROR(
+        ShmSegment::Create(ShmSegmentName(port_), SegmentBytes(), &segment_));
+    serve_thread_.reset(Env::Default()->StartThread(
+        ThreadOptions(), "tf-data-service-shm-transfer",
+        [this] { ServeLoop(); }));
+    VLOG(2) << "Started shm transfer server on segment "
+            << ShmSegmentName(port_) << ".";
+    return OkStatus();
+  }
+
+  int Port() const override { return port_; }
+
+  // Clients compare the server's hostname against their own to reject
+  // cross-host use of this protocol before attempting to map the segment.
+  StatusOr<std::string> GetCompatibilityInfo() const override {
+    return port::Hostname();
+  }
+
+ private:
+  void ServeLoop() {
+    ShmControlBlock* control = segment_->control();
+    while (!shutdown_.load(std::memory_order_relaxed)) {
+      int iteration = 0;
+      while (control->state.load(std::memory_order_acquire) !=
+             kRequestReady) {
+        if (shutdown_.load(std::memory_order_relaxed)) {
+          return;
+        }
+        if (++iteration > kSpinIterations) {
+          Env::Default()->SleepForMicroseconds(kPollSleepMicros);
+          iteration = 0;
+        }
+      }
+      HandleRequest(control);
+    }
+  }
+
+  void HandleRequest(ShmControlBlock* control) {
+    GetElementRequest req;
+    uint64_t request_size = control->payload_size.load(std::memory_order_acquire);
+    if (request_size > static_cast<uint64_t>(segment_->data_capacity()) ||
+        !req.ParseFromArray(segment_->data(), request_size)) {
+      WriteError(control,
+                 errors::InvalidArgument("Failed to parse GetElementRequest "
+                                         "from shared memory segment."));
+      return;
+    }
+    GetElementResult result;
+    Status s = get_element_(&req, &result);
+    if (!s.ok()) {
+      WriteError(control, s);
+      return;
+    }
+    GetElementResponse resp;
+    resp.set_element_index(result.element_index);
+    resp.set_end_of_sequence(result.end_of_sequence);
+    resp.set_skip_task(result.skip);
+    if (!result.end_of_sequence && !result.skip) {
+      UncompressedElement* element = resp.mutable_uncompressed();
+      for (const Tensor& component : result.components) {
+        component.AsProtoTensorContent(element->add_components());
+      }
+    }
+    size_t response_size = resp.ByteSizeLong();
+    if (response_size > static_cast<size_t>(segment_->data_capacity())) {
+      WriteError(control,
+                 errors::ResourceExhausted(
+                     "Element of ", response_size, " bytes does not fit in "
+                     "the ", segment_->data_capacity(), "-byte shared memory "
+                     "segment; increase TF_DATA_SHM_SEGMENT_BYTES."));
+      return;
+    }
+    resp.SerializeToArray(segment_->data(), response_size);
+    control->payload_size.store(response_size, std::memory_order_release);
+    control->state.store(kResponseReady, std::memory_order_release);
+  }
+
+  void WriteError(ShmControlBlock* control, const Status& s) {
+    std::string message(s.message());
+    if (message.size() > static_cast<size_t>(segment_->data_capacity())) {
+      message.resize(segment_->data_capacity());
+    }
+    std::memcpy(segment_->data(), message.data(), message.size());
+    control->payload_size.store(message.size(), std::memory_order_release);
+    control->error_code.store(static_cast<int32_t>(s.code()),
+                              std::memory_order_release);
+    control->state.store(kError, std::memory_order_release);
+  }
+
+  const GetElementT get_element_;
+  int port_ = 0;
+  std::atomic<bool> shutdown_{false};
+  std::unique_ptr<ShmSegment> segment_;
+  std::unique_ptr<Thread> serve_thread_;
+};
+
+class ShmDataTransferClient : public DataTransferClient {
+ public:
+  static Status Create(DataTransferClient::Config config,
+                       std::unique_ptr<DataTransferClient>* out) {
+    int port;
+    TF_RETURN_IF_ERROR(ParsePort(config.address, &port));
+    std::unique_ptr<ShmSegment> segment;
+    TF_RETURN_IF_ERROR(ShmSegment::Open(ShmSegmentName(port), &segment));
+    VLOG(2) << "Create ShmDataTransferClient for worker " << config.address
+            << ".";
+    *out = absl::WrapUnique(new ShmDataTransferClient(std::move(segment)));
+    return OkStatus();
+  }
+
+  Status GetElement(const GetElementRequest& req,
+                    GetElementResult& result) override {
+    VLOG(3) << "GetElement for task " << req.task_id()
+            << " from shm worker server.";
+    // One exchange is in flight at a time; the control block is a single
+    // request/response slot.
+    mutex_lock l(mu_);
+    if (cancelled_.load(std::memory_order_relaxed)) {
+      return errors::Cancelled("Client was cancelled.");
+    }
+    ShmControlBlock* control = segment_->control();
+    uint32_t state = control->state.load(std::memory_order_acquire);
+    if (state == kShutdown) {
+      return errors::Unavailable("Worker shm transfer server has shut down.");
+    }
+    if (state != kIdle) {
+      // A previous exchange was abandoned mid-flight (e.g. by cancellation),
+      // so the slot's contents can no longer be trusted.
+      return errors::Internal(
+          "Shared memory transfer slot is out of sync with the worker.");
+    }
+    size_t request_size = req.ByteSizeLong();
+    if (request_size > static_cast<size_t>(segment_->data_capacity())) {
+      return errors::InvalidArgument("GetElementRequest of ", request_size,
+                                     " bytes does not fit in the shared "
+                                     "memory segment.");
+    }
+    int64_t start_time_us = env_->NowMicros();
+    req.SerializeToArray(segment_->data(), request_size);
+    control->payload_size.store(request_size, std::memory_order_release);
+    control->state.store(kRequestReady, std::memory_order_release);
+    state = WaitWhile(control, kRequestReady, cancelled_);
+    if (state == kRequestReady) {
+      return errors::Cancelled("Client was cancelled.");
+    }
+    if (state == kShutdown) {
+      return errors::Unavailable("Worker shm transfer server has shut down.");
+    }
+    uint64_t payload_size =
+        control->payload_size.load(std::memory_order_acquire);
+    if (state == kError) {
+      Status s(static_cast<absl::StatusCode>(
+                   control->error_code.load(std::memory_order_acquire)),
+               absl::string_view(segment_->data(), payload_size));
+      control->state.store(kIdle, std::memory_order_release);
+      return s;
+    }
+    GetElementResponse resp;
+    bool parsed = resp.ParseFromArray(segment_->data(), payload_size);
+    control->state.store(kIdle, std::memory_order_release);
+    if (!parsed) {
+      return errors::Internal("Failed to parse GetElementResponse from "
+                              "shared memory segment.");
+    }
+    int64_t end_time_us = env_->NowMicros();
+    metrics::RecordTFDataServiceGetElementDuration(kShmTransferProtocol,
+                                                   end_time_us - start_time_us);
+    result.element_index = resp.element_index();
+    result.end_of_sequence = resp.end_of_sequence();
+    result.skip = resp.skip_task();
+    for (const auto& component : resp.uncompressed().components()) {
+      result.components.emplace_back();
+      if (!result.components.back().FromProto(component)) {
+        return errors::Internal("Failed to parse tensor.");
+      }
+    }
+    return OkStatus();
+  }
+
+  void TryCancel() override {
+    VLOG(2) << "Cancel ShmDataTransferClient.";
+    cancelled_.store(true, std::memory_order_relaxed);
+  }
+
+  Status CheckCompatibility(
+      const std::string& server_compatibility_info) const override {
+    if (!server_compatibility_info.empty() &&
+        server_compatibility_info != port::Hostname()) {
+      return errors::FailedPrecondition(
+          "The shm data transfer protocol requires the worker and the "
+          "trainer to run on the same host, but the worker runs on '",
+          server_compatibility_info, "' and the trainer on '",
+          port::Hostname(), "'.");
+    }
+    return OkStatus();
+  }
+
+ private:
+  explicit ShmDataTransferClient(std::unique_ptr<ShmSegment> segment)
+      : segment_(std::move(segment)) {}
+
+  static Status ParsePort(const std::string& address, int* port) {
+    size_t colon = address.rfind(':');
+    absl::string_view port_str = address;
+    if (colon != std::string::npos) {
+      port_str = absl::string_view(address).substr(colon + 1);
+    }
+    if (!strings::safe_strto32(port_str, port)) {
+      return errors::InvalidArgument("Failed to parse shm transfer server "
+                                     "port from address '", address, "'.");
+    }
+    return OkStatus();
+  }
+
+  const std::unique_ptr<ShmSegment> segment_;
+  mutex mu_;
+  std::atomic<bool> cancelled_{false};
+};
+
+class ShmTransferServerRegistrar {
+ public:
+  ShmTransferServerRegistrar() {
+    DataTransferServer::Register(
+        kShmTransferProtocol, [](DataTransferServer::GetElementT get_element,
+                                 std::shared_ptr<DataTransferServer>* out) {
+          *out = std::make_shared<ShmDataTransferServer>(
+              std::move(get_element));
+          return OkStatus();
+        });
+  }
+};
+static ShmTransferServerRegistrar shm_server_registrar;
+
+class ShmTransferClientRegistrar {
+ public:
+  ShmTransferClientRegistrar() {
+    DataTransferClient::Register(
+        kShmTransferProtocol, [](DataTransferClient::Config config,
+                                 std::unique_ptr<DataTransferClient>* out) {
+          return ShmDataTransferClient::Create(std::move(config), out);
+        });
+  }
+};
+static ShmTransferClientRegistrar shm_client_registrar;
+
+}  // namespace
+
+#endif  // !PLATFORM_WINDOWS
+
+}  // namespace data
+}  // namespace tensorflow
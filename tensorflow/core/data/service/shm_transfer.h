@@ -0,0 +1,42 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_DATA_SERVICE_SHM_TRANSFER_H_
+#define TENSORFLOW_CORE_DATA_SERVICE_SHM_TRANSFER_H_
+
+#include <string>
+
+namespace tensorflow {
+namespace data {
+
+// A shared-memory data transfer protocol for workers that run on the same
+// host as the trainer. Elements are serialized directly into a POSIX shared
+// memory segment owned by the worker, so they cross the process boundary
+// without going through a gRPC channel. The server and client are registered
+// with the `DataTransferServer`/`DataTransferClient` registries under this
+// name; select it by setting `data_transfer_protocol` in the worker config
+// and on the trainer side. Only available on POSIX platforms. Clients on a
+// different host than the server fail the compatibility check and fall back
+// to gRPC.
+constexpr const char kShmTransferProtocol[] = "shm";
+
+// Returns the name of the shared memory segment backing the transfer server
+// listening on `port`. Exposed for tests.
+std::string ShmSegmentName(int port);
+
+}  // namespace data
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_DATA_SERVICE_SHM_TRANSFER_H_
@@ -0,0 +1,133 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/data/service/shm_transfer.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/strings/match.h"
+#include "absl/strings/str_cat.h"
+#include "tensorflow/core/data/service/data_transfer.h"
+#include "tensorflow/core/data/service/worker.pb.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_testutil.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/platform/platform.h"
+#include "tensorflow/core/platform/status.h"
+#include "tensorflow/core/platform/statusor.h"
+#include "tensorflow/core/platform/test.h"
+
+#if !defined(PLATFORM_WINDOWS)
+
+namespace tensorflow {
+namespace data {
+namespace {
+
+// Serves `num_elements` scalar int64 elements, then end_of_sequence.
+DataTransferServer::GetElementT ElementGetter(int64_t num_elements) {
+  auto next_index = std::make_shared<int64_t>(0);
+  return [num_elements, next_index](const GetElementRequest* req,
+                                    GetElementResult* result) {
+    if (*next_index >= num_elements) {
+      result->end_of_sequence = true;
+      return OkStatus();
+    }
+    result->components.push_back(Tensor(*next_index));
+    result->element_index = (*next_index)++;
+    result->end_of_sequence = false;
+    return OkStatus();
+  };
+}
+
+TEST(ShmTransferTest, RoundTrip) {
+  std::shared_ptr<DataTransferServer> server;
+  TF_ASSERT_OK(DataTransferServer::Build(kShmTransferProtocol,
+                                         ElementGetter(/*num_elements=*/10),
+                                         &server));
+  TF_ASSERT_OK(server->Start());
+
+  std::unique_ptr<DataTransferClient> client;
+  TF_ASSERT_OK(DataTransferClient::Build(
+      kShmTransferProtocol,
+      {"grpc", absl::StrCat("localhost:", server->Port())}, &client));
+  TF_ASSERT_OK_AND_ASSIGN(std::string compatibility_info,
+                          server->GetCompatibilityInfo());
+  TF_ASSERT_OK(client->CheckCompatibility(compatibility_info));
+
+  GetElementRequest req;
+  for (int64_t i = 0; i < 10; ++i) {
+    GetElementResult result;
+    TF_ASSERT_OK(client->GetElement(req, result));
+    EXPECT_FALSE(result.end_of_sequence);
+    EXPECT_EQ(result.element_index, i);
+    ASSERT_EQ(result.components.size(), 1);
+    test::ExpectEqual(result.components[0], Tensor(i));
+  }
+  GetElementResult result;
+  TF_ASSERT_OK(client->GetElement(req, result));
+  EXPECT_TRUE(result.end_of_sequence);
+}
+
+TEST(ShmTransferTest, PropagatesGetElementError) {
+  std::shared_ptr<DataTransferServer> server;
+  TF_ASSERT_OK(DataTransferServer::Build(
+      kShmTransferProtocol,
+      [](const GetElementRequest* req, GetElementResult* result) {
+        return errors::NotFound("no such task");
+      },
+      &server));
+  TF_ASSERT_OK(server->Start());
+
+  std::unique_ptr<DataTransferClient> client;
+  TF_ASSERT_OK(DataTransferClient::Build(
+      kShmTransferProtocol,
+      {"grpc", absl::StrCat("localhost:", server->Port())}, &client));
+
+  GetElementRequest req;
+  GetElementResult result;
+  Status s = client->GetElement(req, result);
+  EXPECT_TRUE(errors::IsNotFound(s));
+  EXPECT_TRUE(absl::StrContains(s.message(), "no such task"));
+}
+
+TEST(ShmTransferTest, RejectsClientOnDifferentHost) {
+  std::shared_ptr<DataTransferServer> server;
+  TF_ASSERT_OK(DataTransferServer::Build(kShmTransferProtocol,
+                                         ElementGetter(/*num_elements=*/1),
+                                         &server));
+  TF_ASSERT_OK(server->Start());
+
+  std::unique_ptr<DataTransferClient> client;
+  TF_ASSERT_OK(DataTransferClient::Build(
+      kShmTransferProtocol,
+      {"grpc", absl::StrCat("localhost:", server->Port())}, &client));
+  EXPECT_TRUE(errors::IsFailedPrecondition(
+      client->CheckCompatibility("some-other-host")));
+}
+
+TEST(ShmTransferTest, MissingSegment) {
+  std::unique_ptr<DataTransferClient> client;
+  Status s = DataTransferClient::Build(kShmTransferProtocol,
+                                       {"grpc", "localhost:0"}, &client);
+  EXPECT_TRUE(errors::IsUnavailable(s));
+}
+
+}  // namespace
+}  // namespace data
+}  // namespace tensorflow
+
+#endif  // !PLATFORM_WINDOWS
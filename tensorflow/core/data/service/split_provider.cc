@@ -45,7 +45,7 @@ Status DataServiceSplitProvider::GetNext(Tensor* split, bool* end_of_splits)
       [this, split, end_of_splits]() TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
         return dispatcher_->GetSplit(iteration_id_, repetition_,
                                      split_provider_index_, *split,
-                                     *end_of_splits);
+                                     *end_of_splits, worker_address_);
       },
       "get next split",
       /*deadline_micros=*/Env::Default()->NowMicros() +
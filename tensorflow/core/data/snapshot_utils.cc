@@ -62,6 +62,7 @@ constexpr const char* const kOutputTypes = "output_types";
 constexpr const char* const kOutputShapes = "output_shapes";
 constexpr const char* const kCompression = "compression";
 constexpr const char* const kVersion = "version";
+constexpr const char* const kProjectedColumns = "projected_columns";
 constexpr const char* const kCurrentCheckpointID = "current_checkpoint_id";
 constexpr const char* const kIndex = "index";
 constexpr const char* const kStartIndex = "start_index";
@@ -128,6 +129,10 @@ Status Writer::Create(Env* env, const std::string& filename,
       *out_writer =
           std::make_unique<TFRecordWriter>(filename, compression_type);
       break;
+    case 3:
+      *out_writer =
+          std::make_unique<ColumnarWriter>(filename, compression_type, dtypes);
+      break;
     default:
       return errors::InvalidArgument("Snapshot writer version: ", version,
                                      " is not supported.");
@@ -368,10 +373,125 @@ Status CustomWriter::WriteRecord(const absl::Cord& data) {
 }
 #endif  // TF_CORD_SUPPORT
 
+ColumnarWriter::ColumnarWriter(const std::string& filename,
+                               const std::string& compression_type,
+                               const DataTypeVector& dtypes)
+    : filename_(filename),
+      compression_type_(compression_type),
+      dtypes_(dtypes),
+      footer_(std::make_unique<experimental::ColumnarSnapshotFooter>()) {}
+
+Status ColumnarWriter::Initialize(tensorflow::Env* env) {
+  if (compression_type_ != io::compression::kNone &&
+      compression_type_ != io::compression::kSnappy) {
+    return errors::InvalidArgument(
+        "Columnar snapshots compress each column chunk individually and only "
+        "support snappy or no compression; got: ", compression_type_);
+  }
+  TF_RETURN_IF_ERROR(env->NewAppendableFile(filename_, &dest_));
+  footer_->set_num_columns(dtypes_.size());
+  columns_.resize(dtypes_.size());
+  return OkStatus();
+}
+
+Status ColumnarWriter::WriteTensors(const std::vector<Tensor>& tensors) {
+  if (tensors.size() != dtypes_.size()) {
+    return errors::InvalidArgument("Expected ", dtypes_.size(),
+                                   " tensors per element but got ",
+                                   tensors.size());
+  }
+  for (int i = 0, end = tensors.size(); i < end; ++i) {
+    columns_[i].push_back(tensors[i]);
+  }
+  ++buffered_rows_;
+  if (buffered_rows_ >= kRowGroupSize) {
+    return FlushRowGroup();
+  }
+  return OkStatus();
+}
+
+Status ColumnarWriter::FlushRowGroup() {
+  if (buffered_rows_ == 0) {
+    return OkStatus();
+  }
+  experimental::ColumnarRowGroupMetadata* row_group = footer_->add_row_group();
+  row_group->set_num_rows(buffered_rows_);
+  for (auto& column : columns_) {
+    experimental::SnapshotRecord record;
+    for (const Tensor& tensor : column) {
+      tensor.AsProtoTensorContent(record.add_tensor());
+    }
+    column.clear();
+    std::string serialized;
+    if (!record.SerializeToString(&serialized)) {
+      return errors::DataLoss("Failed to serialize a column chunk of ",
+                              buffered_rows_, " rows to file: ", filename_);
+    }
+    TF_RETURN_IF_ERROR(WriteChunk(serialized, row_group->add_column()));
+  }
+  buffered_rows_ = 0;
+  return OkStatus();
+}
+
+Status ColumnarWriter::WriteChunk(const std::string& data,
+                                  experimental::ColumnarChunkMetadata* chunk) {
+  chunk->set_offset(bytes_written_);
+  chunk->set_uncompressed_size(data.size());
+  if (compression_type_ == io::compression::kSnappy) {
+    std::string compressed;
+    if (!tsl::port::Snappy_Compress(data.data(), data.size(), &compressed)) {
+      return errors::Internal("Failed to compress using snappy.");
+    }
+    chunk->set_compressed_size(compressed.size());
+    TF_RETURN_IF_ERROR(dest_->Append(compressed));
+    bytes_written_ += compressed.size();
+  } else {
+    chunk->set_compressed_size(data.size());
+    TF_RETURN_IF_ERROR(dest_->Append(data));
+    bytes_written_ += data.size();
+  }
+  return OkStatus();
+}
+
+Status ColumnarWriter::Sync() { return dest_->Sync(); }
+
+Status ColumnarWriter::Close() {
+  if (dest_ == nullptr) {
+    return OkStatus();
+  }
+  TF_RETURN_IF_ERROR(FlushRowGroup());
+  std::string footer_serialized;
+  if (!footer_->SerializeToString(&footer_serialized)) {
+    return errors::DataLoss("Failed to serialize the footer of file: ",
+                            filename_);
+  }
+  TF_RETURN_IF_ERROR(dest_->Append(footer_serialized));
+  char footer_length[kFooterLengthSize];
+  core::EncodeFixed64(footer_length, footer_serialized.size());
+  TF_RETURN_IF_ERROR(
+      dest_->Append(StringPiece(footer_length, kFooterLengthSize)));
+  TF_RETURN_IF_ERROR(dest_->Close());
+  dest_ = nullptr;
+  return OkStatus();
+}
+
+ColumnarWriter::~ColumnarWriter() {
+  Status s = Close();
+  if (!s.ok()) {
+    LOG(ERROR) << "Failed to close snapshot file " << filename_ << ": " << s;
+  }
+}
+
 Status Reader::Create(Env* env, const std::string& filename,
                       const string& compression_type, int version,
                       const DataTypeVector& dtypes,
-                      std::unique_ptr<Reader>* out_reader) {
+                      std::unique_ptr<Reader>* out_reader,
+                      const std::vector<int64_t>& projected_columns) {
+  if (!projected_columns.empty() && version != 3) {
+    return errors::InvalidArgument(
+        "Column projection is only supported by the columnar snapshot format "
+        "(version 3); got version: ", version);
+  }
   switch (version) {
     // CustomReader is able to read a legacy snapshot file format (v0) though
     // custom writer doesn't have the ability to write it any more since it is
@@ -385,6 +505,10 @@ Status Reader::Create(Env* env, const std::string& filename,
       *out_reader =
           std::make_unique<TFRecordReader>(filename, compression_type, dtypes);
       break;
+    case 3:
+      *out_reader = std::make_unique<ColumnarReader>(
+          filename, compression_type, dtypes, projected_columns);
+      break;
     default:
       return errors::InvalidArgument("Snapshot reader version: ", version,
                                      " is not supported.");
@@ -408,14 +532,16 @@ class Reader::Dataset : public DatasetBase {
           const std::string& compression, const int64_t version,
           const DataTypeVector& dtypes,
           const std::vector<PartialTensorShape>& shapes,
-          const int64_t start_index)
+          const int64_t start_index,
+          const std::vector<int64_t>& projected_columns = {})
       : DatasetBase(std::move(ctx)),
         shard_dir_(shard_dir),
         compression_(compression),
         version_(version),
         dtypes_(dtypes),
         shapes_(shapes),
-        start_index_(start_index) {}
+        start_index_(start_index),
+        projected_columns_(projected_columns) {}
 
   const DataTypeVector& output_dtypes() const override { return dtypes_; }
 
@@ -447,13 +573,18 @@ class Reader::Dataset : public DatasetBase {
     AttrValue version;
     b->BuildAttrValue(version_, &version);
 
+    AttrValue projected_columns;
+    b->BuildAttrValue(projected_columns_, &projected_columns);
+
     return b->AddDataset(
         this,
         /*inputs=*/
         {std::make_pair(0, shard_dir), std::make_pair(1, start_index)},
         /*list_inputs=*/{},
         /*attrs=*/
-        {{kCompression, compression}, {kVersion, version}},
+        {{kCompression, compression},
+         {kVersion, version},
+         {kProjectedColumns, projected_columns}},
         /*use_dataset_name=*/true, node);
   }
 
@@ -476,7 +607,8 @@ class Reader::Dataset : public DatasetBase {
       // the is_restoring bit ends up being inaccurate).
       TF_RETURN_IF_ERROR(Reader::Create(
           ctx->env(), GetCurrentFilename(), dataset()->compression_,
-          dataset()->version_, dataset()->dtypes_, &reader_));
+          dataset()->version_, dataset()->dtypes_, &reader_,
+          dataset()->projected_columns_));
       return AdvanceToStartIndex(ctx);
     }
 
@@ -516,7 +648,8 @@ class Reader::Dataset : public DatasetBase {
       TF_RETURN_IF_ERROR(ctx->env()->FileExists(GetCurrentFilename()));
       TF_RETURN_IF_ERROR(Reader::Create(
           ctx->env(), GetCurrentFilename(), dataset()->compression_,
-          dataset()->version_, dataset()->dtypes_, &reader_));
+          dataset()->version_, dataset()->dtypes_, &reader_,
+          dataset()->projected_columns_));
       return AdvanceToStartIndex(ctx);
     }
 
@@ -526,7 +659,8 @@ class Reader::Dataset : public DatasetBase {
       current_checkpoint_id_++;
       TF_RETURN_IF_ERROR(env->FileExists(GetCurrentFilename()));
       return Reader::Create(env, GetCurrentFilename(), dataset()->compression_,
-                            dataset()->version_, dataset()->dtypes_, &reader_);
+                            dataset()->version_, dataset()->dtypes_, &reader_,
+                            dataset()->projected_columns_);
     }
 
     std::string GetCurrentFilename() {
@@ -558,6 +692,7 @@ class Reader::Dataset : public DatasetBase {
   const DataTypeVector dtypes_;
   const std::vector<PartialTensorShape> shapes_;
   const int64_t start_index_;
+  const std::vector<int64_t> projected_columns_;
 };
 
 Reader::DatasetOp::DatasetOp(OpKernelConstruction* ctx) : DatasetOpKernel(ctx) {
@@ -565,6 +700,9 @@ Reader::DatasetOp::DatasetOp(OpKernelConstruction* ctx) : DatasetOpKernel(ctx) {
   OP_REQUIRES_OK(ctx, ctx->GetAttr(kOutputShapes, &output_shapes_));
   OP_REQUIRES_OK(ctx, ctx->GetAttr(kCompression, &compression_));
   OP_REQUIRES_OK(ctx, ctx->GetAttr(kVersion, &version_));
+  if (ctx->HasAttr(kProjectedColumns)) {
+    OP_REQUIRES_OK(ctx, ctx->GetAttr(kProjectedColumns, &projected_columns_));
+  }
 }
 
 void Reader::DatasetOp::MakeDataset(OpKernelContext* ctx,
@@ -575,9 +713,9 @@ void Reader::DatasetOp::MakeDataset(OpKernelContext* ctx,
   int64_t start_index;
   OP_REQUIRES_OK(ctx, ParseScalarArgument(ctx, "start_index", &start_index));
 
-  *output =
-      new Reader::Dataset(DatasetContext(ctx), shard_dir, compression_,
-                          version_, output_types_, output_shapes_, start_index);
+  *output = new Reader::Dataset(DatasetContext(ctx), shard_dir, compression_,
+                                version_, output_types_, output_shapes_,
+                                start_index, projected_columns_);
 }
 
 class Reader::NestedDataset : public DatasetBase {
@@ -696,13 +834,11 @@ void Reader::NestedDatasetOp::MakeDataset(OpKernelContext* ctx,
   (*output)->Initialize(/*metadata=*/{});
 }
 
-Status Reader::MakeNestedDataset(Env* env,
-                                 const std::vector<std::string>& shard_dirs,
-                                 const string& compression_type, int version,
-                                 const DataTypeVector& dtypes,
-                                 const std::vector<PartialTensorShape>& shapes,
-                                 const int64_t start_index,
-                                 DatasetBase** output) {
+Status Reader::MakeNestedDataset(
+    Env* env, const std::vector<std::string>& shard_dirs,
+    const string& compression_type, int version, const DataTypeVector& dtypes,
+    const std::vector<PartialTensorShape>& shapes, const int64_t start_index,
+    DatasetBase** output, const std::vector<int64_t>& projected_columns) {
   std::vector<DatasetBase*> datasets;
 
   datasets.reserve(shard_dirs.size());
@@ -719,7 +855,7 @@ Status Reader::MakeNestedDataset(Env* env,
                         {"SnapshotDatasetReader",
                          strings::StrCat("SnapshotDatasetReader/_", i)})),
                     shard_dirs.at(i), compression_type, version, dtypes, shapes,
-                    dataset_start_index));
+                    dataset_start_index, projected_columns));
     datasets.back()->Initialize(/*metadata=*/{});
   }
 
@@ -1012,6 +1148,142 @@ Status CustomReader::ReadRecord(absl::Cord* record) {
 }
 #endif  // TF_CORD_SUPPORT
 
+ColumnarReader::ColumnarReader(const std::string& filename,
+                               const string& compression_type,
+                               const DataTypeVector& dtypes,
+                               const std::vector<int64_t>& projected_columns)
+    : filename_(filename),
+      compression_type_(compression_type),
+      dtypes_(dtypes),
+      selected_columns_(projected_columns),
+      projected_(!projected_columns.empty()) {}
+
+ColumnarReader::~ColumnarReader() = default;
+
+Status ColumnarReader::Initialize(Env* env) {
+  if (compression_type_ != io::compression::kNone &&
+      compression_type_ != io::compression::kSnappy) {
+    return errors::InvalidArgument(
+        "Columnar snapshots only support snappy or no compression; got: ",
+        compression_type_);
+  }
+  TF_RETURN_IF_ERROR(env->NewRandomAccessFile(filename_, &file_));
+  uint64 file_size;
+  TF_RETURN_IF_ERROR(env->GetFileSize(filename_, &file_size));
+  if (file_size < ColumnarWriter::kFooterLengthSize) {
+    return errors::DataLoss("File is too small to be a columnar snapshot: ",
+                            filename_);
+  }
+  char length_scratch[ColumnarWriter::kFooterLengthSize];
+  StringPiece result;
+  TF_RETURN_IF_ERROR(file_->Read(file_size - ColumnarWriter::kFooterLengthSize,
+                                 ColumnarWriter::kFooterLengthSize, &result,
+                                 length_scratch));
+  uint64 footer_size = core::DecodeFixed64(result.data());
+  if (footer_size + ColumnarWriter::kFooterLengthSize > file_size) {
+    return errors::DataLoss("Corrupt footer length in columnar snapshot: ",
+                            filename_);
+  }
+  std::string footer_scratch(footer_size, '\0');
+  TF_RETURN_IF_ERROR(
+      file_->Read(file_size - ColumnarWriter::kFooterLengthSize - footer_size,
+                  footer_size, &result, &footer_scratch[0]));
+  footer_ = std::make_unique<experimental::ColumnarSnapshotFooter>();
+  if (!footer_->ParseFromArray(result.data(), result.size())) {
+    return errors::DataLoss("Unable to parse the footer of columnar snapshot: ",
+                            filename_);
+  }
+  if (!projected_) {
+    selected_columns_.reserve(footer_->num_columns());
+    for (int64_t i = 0; i < footer_->num_columns(); ++i) {
+      selected_columns_.push_back(i);
+    }
+  } else {
+    for (int64_t column : selected_columns_) {
+      if (column < 0 || column >= footer_->num_columns()) {
+        return errors::InvalidArgument("Projected column ", column,
+                                       " is out of range; snapshot has ",
+                                       footer_->num_columns(), " columns.");
+      }
+    }
+  }
+  columns_.resize(selected_columns_.size());
+  return OkStatus();
+}
+
+Status ColumnarReader::ReadTensors(std::vector<Tensor>* read_tensors) {
+  if (group_ < 0 ||
+      (!columns_.empty() &&
+       row_in_group_ >= static_cast<int64_t>(columns_[0].size()))) {
+    TF_RETURN_IF_ERROR(LoadRowGroup(group_ + 1));
+  }
+  read_tensors->clear();
+  read_tensors->reserve(columns_.size());
+  for (const auto& column : columns_) {
+    read_tensors->push_back(column[row_in_group_]);
+  }
+  ++row_in_group_;
+  return OkStatus();
+}
+
+Status ColumnarReader::LoadRowGroup(int64_t group_index) {
+  if (group_index >= footer_->row_group_size()) {
+    return errors::OutOfRange("No more row groups in columnar snapshot: ",
+                              filename_);
+  }
+  const experimental::ColumnarRowGroupMetadata& row_group =
+      footer_->row_group(group_index);
+  for (int i = 0, end = selected_columns_.size(); i < end; ++i) {
+    const int64_t column_index = selected_columns_[i];
+    if (column_index >= row_group.column_size()) {
+      return errors::DataLoss("Row group ", group_index, " only has ",
+                              row_group.column_size(), " columns; expected ",
+                              footer_->num_columns(), ".");
+    }
+    std::string data;
+    TF_RETURN_IF_ERROR(ReadChunk(row_group.column(column_index), &data));
+    experimental::SnapshotRecord record;
+    if (!record.ParseFromString(data)) {
+      return errors::DataLoss("Unable to parse a column chunk of snapshot: ",
+                              filename_);
+    }
+    if (record.tensor_size() != row_group.num_rows()) {
+      return errors::DataLoss("Column chunk has ", record.tensor_size(),
+                              " values; expected ", row_group.num_rows(), ".");
+    }
+    columns_[i].clear();
+    columns_[i].reserve(record.tensor_size());
+    for (const auto& tensor_proto : record.tensor()) {
+      Tensor tensor;
+      if (!tensor.FromProto(tensor_proto)) {
+        return errors::DataLoss("Unable to parse tensor from proto.");
+      }
+      columns_[i].push_back(std::move(tensor));
+    }
+  }
+  group_ = group_index;
+  row_in_group_ = 0;
+  return OkStatus();
+}
+
+Status ColumnarReader::ReadChunk(
+    const experimental::ColumnarChunkMetadata& chunk, std::string* data) {
+  std::string scratch(chunk.compressed_size(), '\0');
+  StringPiece result;
+  TF_RETURN_IF_ERROR(file_->Read(chunk.offset(), chunk.compressed_size(),
+                                 &result, &scratch[0]));
+  if (compression_type_ == io::compression::kSnappy) {
+    data->resize(chunk.uncompressed_size());
+    if (!tsl::port::Snappy_Uncompress(result.data(), result.size(),
+                                      &(*data)[0])) {
+      return errors::Internal("Failed to perform snappy decompression.");
+    }
+  } else {
+    data->assign(result.data(), result.size());
+  }
+  return OkStatus();
+}
+
 Status WriteMetadataFile(Env* env, const string& dir,
                          const experimental::SnapshotMetadataRecord* metadata) {
   string metadata_filename = io::JoinPath(dir, kMetadataFilename);
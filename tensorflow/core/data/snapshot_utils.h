@@ -47,6 +47,8 @@ namespace data {
 
 namespace experimental {
 
+class ColumnarChunkMetadata;
+class ColumnarSnapshotFooter;
 class SnapshotMetadataRecord;
 class SnapshotTensorMetadata;
 
@@ -175,6 +177,56 @@ class CustomWriter : public Writer {
   int num_complex_ = 0;
 };
 
+// Writes snapshots in a columnar format (version 3). Elements are buffered
+// into row groups; each component ("column") of a row group is serialized and
+// compressed as a separate chunk, and a footer index of chunk locations is
+// written when the file is closed. Readers can therefore fetch only the
+// columns a job actually uses instead of scanning full rows. Compression is
+// applied per chunk, so only Snappy (or no) compression is supported: column
+// pruning requires chunk-level random access, which stream-wide compression
+// does not allow.
+class ColumnarWriter : public Writer {
+ public:
+  static constexpr const size_t kFooterLengthSize = sizeof(uint64);
+  static constexpr const int64_t kRowGroupSize = 1024;
+
+  ColumnarWriter(const std::string& filename,
+                 const std::string& compression_type,
+                 const DataTypeVector& dtypes);
+
+  Status WriteTensors(const std::vector<Tensor>& tensors) override;
+
+  Status Sync() override;
+
+  Status Close() override;
+
+  ~ColumnarWriter() override;
+
+ protected:
+  Status Initialize(tensorflow::Env* env) override;
+
+ private:
+  // Writes the buffered rows out as one chunk per column and records their
+  // locations in the footer.
+  Status FlushRowGroup();
+
+  // Compresses `data` if requested, appends it to the file, and fills in
+  // `chunk` with its location.
+  Status WriteChunk(const std::string& data,
+                    experimental::ColumnarChunkMetadata* chunk);
+
+  const std::string filename_;
+  const std::string compression_type_;
+  const DataTypeVector dtypes_;
+
+  std::unique_ptr<WritableFile> dest_;
+  uint64 bytes_written_ = 0;
+  int64_t buffered_rows_ = 0;
+  // Buffered values of the current row group, one vector per column.
+  std::vector<std::vector<Tensor>> columns_;
+  std::unique_ptr<experimental::ColumnarSnapshotFooter> footer_;
+};
+
 // Interface class for reading snapshot files previous written with Writer.
 class Reader {
  public:
@@ -192,6 +244,7 @@ class Reader {
     std::vector<PartialTensorShape> output_shapes_;
     std::string compression_;
     int64_t version_;
+    std::vector<int64_t> projected_columns_;
   };
 
   // Op kernel that creates an instance of `Reader::NestedDataset` needed to
@@ -211,22 +264,29 @@ class Reader {
   // Creates a new Reader object that reads data from `filename`. Note that
   // the `version`, `compression_type`, and `dtypes` arguments passed into
   // `Writer` and `Reader` must be the same for the reading to succeed.
+  //
+  // If `projected_columns` is non-empty, only those element components are
+  // read, in the given order, and `dtypes` must describe the projected
+  // components. Projection is only supported by the columnar format
+  // (version 3); other versions return InvalidArgument.
   static Status Create(Env* env, const std::string& filename,
                        const string& compression_type, int version,
                        const DataTypeVector& dtypes,
-                       std::unique_ptr<Reader>* out_reader);
+                       std::unique_ptr<Reader>* out_reader,
+                       const std::vector<int64_t>& projected_columns = {});
 
   // Returns a nested dataset for a set of given snapshot file names.
   //
   // This function takes a vector of snapshot files, and returns a nested
   // dataset. Each element within the nested dataset is itself a dataset, and
   // contains all the elements written out to each individual snapshot file.
-  static Status MakeNestedDataset(Env* env,
-                                  const std::vector<std::string>& shard_dirs,
-                                  const string& compression_type, int version,
-                                  const DataTypeVector& dtypes,
-                                  const std::vector<PartialTensorShape>& shapes,
-                                  int64_t start_index, DatasetBase** output);
+  //
+  // `projected_columns` follows the same contract as in `Reader::Create`.
+  static Status MakeNestedDataset(
+      Env* env, const std::vector<std::string>& shard_dirs,
+      const string& compression_type, int version, const DataTypeVector& dtypes,
+      const std::vector<PartialTensorShape>& shapes, int64_t start_index,
+      DatasetBase** output, const std::vector<int64_t>& projected_columns = {});
 
   // Returns a nested dataset for the given datasets.
   static void MakeNestedDataset(const std::vector<DatasetBase*>& datasets,
@@ -358,6 +418,50 @@ class CustomReader : public Reader {
   std::vector<bool> simple_tensor_mask_;  // true for simple, false for complex.
 };
 
+// Reads snapshots previously written with `ColumnarWriter`. If
+// `projected_columns` is non-empty, only the chunks of the selected columns
+// are read and decompressed; the chunks of all other columns are skipped
+// entirely, which is the point of the columnar layout.
+class ColumnarReader : public Reader {
+ public:
+  ColumnarReader(const std::string& filename, const string& compression_type,
+                 const DataTypeVector& dtypes,
+                 const std::vector<int64_t>& projected_columns = {});
+
+  Status ReadTensors(std::vector<Tensor>* read_tensors) override;
+
+  ~ColumnarReader() override;
+
+ protected:
+  Status Initialize(Env* env) override;
+
+ private:
+  // Reads and decompresses the selected column chunks of row group
+  // `group_index` into `columns_`.
+  Status LoadRowGroup(int64_t group_index);
+
+  // Reads the bytes of `chunk` from the file and decompresses them into
+  // `*data`.
+  Status ReadChunk(const experimental::ColumnarChunkMetadata& chunk,
+                   std::string* data);
+
+  const std::string filename_;
+  const string compression_type_;
+  const DataTypeVector dtypes_;
+  // Column indices to materialize, in output order; covers all columns when
+  // no projection was requested.
+  std::vector<int64_t> selected_columns_;
+  const bool projected_;
+
+  std::unique_ptr<RandomAccessFile> file_;
+  std::unique_ptr<experimental::ColumnarSnapshotFooter> footer_;
+  // Materialized values of the current row group, one vector per selected
+  // column.
+  std::vector<std::vector<Tensor>> columns_;
+  int64_t group_ = -1;
+  int64_t row_in_group_ = 0;
+};
+
 // Writes snapshot metadata to the given directory.
 Status WriteMetadataFile(Env* env, const string& dir,
                          const experimental::SnapshotMetadataRecord* metadata);
@@ -19,8 +19,10 @@ limitations under the License.
 #include <string>
 #include <vector>
 
+#include "absl/status/status.h"
 #include "tensorflow/core/data/service/test_util.h"
 #include "tensorflow/core/framework/tensor.pb.h"
+#include "tensorflow/core/platform/strcat.h"
 #include "tensorflow/core/lib/core/status_test_util.h"
 #include "tensorflow/core/lib/io/compression.h"
 #include "tensorflow/core/platform/env.h"
@@ -97,6 +99,65 @@ TEST(SnapshotUtilTest, CombinationRoundTripTest) {
   SnapshotRoundTrip(io::compression::kNone, 2);
   SnapshotRoundTrip(io::compression::kGzip, 2);
   SnapshotRoundTrip(io::compression::kSnappy, 2);
+
+  // The columnar format compresses each column chunk individually, so only
+  // snappy and uncompressed files are supported.
+  SnapshotRoundTrip(io::compression::kNone, 3);
+  SnapshotRoundTrip(io::compression::kSnappy, 3);
+}
+
+TEST(SnapshotUtilTest, ColumnarGzipUnsupported) {
+  std::string filename;
+  EXPECT_TRUE(Env::Default()->LocalTempFilename(&filename));
+  std::unique_ptr<Writer> writer;
+  EXPECT_TRUE(absl::IsInvalidArgument(
+      Writer::Create(Env::Default(), filename, io::compression::kGzip, 3,
+                     {DT_FLOAT}, &writer)));
+}
+
+TEST(SnapshotUtilTest, ColumnarProjectionReadsSelectedColumns) {
+  const int64_t kNumElements = 2000;  // Spans more than one row group.
+  std::string filename;
+  EXPECT_TRUE(Env::Default()->LocalTempFilename(&filename));
+
+  DataTypeVector dtypes = {DT_INT64, DT_STRING, DT_INT64};
+  std::unique_ptr<Writer> writer;
+  TF_ASSERT_OK(Writer::Create(Env::Default(), filename,
+                              io::compression::kSnappy, 3, dtypes, &writer));
+  for (int64_t i = 0; i < kNumElements; ++i) {
+    Tensor feature_a(static_cast<int64_t>(i));
+    Tensor feature_b(tstring(strings::StrCat("feature_", i)));
+    Tensor feature_c(static_cast<int64_t>(i * 2));
+    TF_ASSERT_OK(writer->WriteTensors({feature_a, feature_b, feature_c}));
+  }
+  TF_ASSERT_OK(writer->Close());
+
+  // Read back only the last and first columns, in that order.
+  std::unique_ptr<Reader> reader;
+  TF_ASSERT_OK(Reader::Create(Env::Default(), filename,
+                              io::compression::kSnappy, 3,
+                              {DT_INT64, DT_INT64}, &reader,
+                              /*projected_columns=*/{2, 0}));
+  for (int64_t i = 0; i < kNumElements; ++i) {
+    std::vector<Tensor> read_tensors;
+    TF_ASSERT_OK(reader->ReadTensors(&read_tensors));
+    ASSERT_EQ(read_tensors.size(), 2);
+    EXPECT_EQ(read_tensors[0].scalar<int64_t>()(), i * 2);
+    EXPECT_EQ(read_tensors[1].scalar<int64_t>()(), i);
+  }
+  std::vector<Tensor> unused;
+  EXPECT_TRUE(absl::IsOutOfRange(reader->ReadTensors(&unused)));
+
+  TF_ASSERT_OK(Env::Default()->DeleteFile(filename));
+}
+
+TEST(SnapshotUtilTest, ProjectionRequiresColumnarFormat) {
+  std::string filename;
+  EXPECT_TRUE(Env::Default()->LocalTempFilename(&filename));
+  std::unique_ptr<Reader> reader;
+  EXPECT_TRUE(absl::IsInvalidArgument(
+      Reader::Create(Env::Default(), filename, io::compression::kSnappy, 2,
+                     {DT_INT64}, &reader, /*projected_columns=*/{0})));
 }
 
 TEST(SnapshotUtilTest, MetadataFileRoundTrip) {
@@ -165,6 +165,16 @@ Status RemoteMgr::SerializeRemoteTensorHandle(
   out->set_op_device(in->op_device() ? in->op_device()->name() : "");
   out->set_device(device_name);
   out->set_dtype(in->dtype);
+  // Piggyback the shape when it is already known locally, so that the
+  // receiving worker can create a shape-ready handle without resolving the
+  // shape through an extra RPC. Checking readiness first keeps this
+  // non-blocking.
+  if (in->dtype != DT_RESOURCE && in->IsReady()) {
+    TensorShape shape;
+    if (in->Shape(&shape).ok()) {
+      shape.AsProto(out->mutable_tensor_shape());
+    }
+  }
   if (serialize_resource_dtype_and_shape) {
     std::vector<DtypeAndPartialTensorShape> resource_dtypes_and_shapes;
     TF_RETURN_IF_ERROR(
@@ -193,9 +203,20 @@ Status RemoteMgr::DeserializeRemoteTensorHandle(const RemoteTensorHandle& in,
         in.op_device().empty() ? in.device() : in.op_device();
     TF_RETURN_IF_ERROR(
         parent_->FindDeviceFromName(device_name.c_str(), &device));
-    *out = TensorHandle::CreateLazyRemoteHandle(in.op_id(), in.output_num(),
-                                                in.dtype(), device,
-                                                /*is_ready=*/true, parent_);
+    if (in.has_tensor_shape()) {
+      // The sender piggybacked the shape; create the handle unready and set
+      // the shape immediately so dependent ops never block on resolution.
+      *out = TensorHandle::CreateLazyRemoteHandle(in.op_id(), in.output_num(),
+                                                  in.dtype(), device,
+                                                  /*is_ready=*/false, parent_);
+      TF_RETURN_IF_ERROR((*out)->SetRemoteShape(TensorShape(in.tensor_shape()),
+                                                device,
+                                                parent_->GetContextViewId()));
+    } else {
+      *out = TensorHandle::CreateLazyRemoteHandle(in.op_id(), in.output_num(),
+                                                  in.dtype(), device,
+                                                  /*is_ready=*/true, parent_);
+    }
     std::vector<DtypeAndPartialTensorShape> dtypes_and_shapes;
     if (!GetMirroredResourceShape(RemoteTensorHandleInternal(in),
                                   &dtypes_and_shapes)
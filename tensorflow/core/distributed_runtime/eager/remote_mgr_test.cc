@@ -108,6 +108,26 @@ TEST_F(RemoteMgrTest, SerializeRemoteTensorHandle) {
   handle->Unref();
 }
 
+TEST_F(RemoteMgrTest, SerializeRemoteTensorHandlePiggybacksShape) {
+  RemoteMgr remote_mgr(false, ctx_);
+  const TensorShape shape({2, 3});
+  Tensor t(DT_FLOAT, shape);
+
+  TensorHandle* handle = TensorHandle::CreateLocalHandle(
+      std::move(t), local_device_, local_device_, ctx_);
+  TF_ASSERT_OK(handle->AddUnshapedRemoteMirror(remote_device_, /*op_id=*/4,
+                                               /*output_num=*/0, "", ctx_));
+  TF_ASSERT_OK(
+      handle->SetRemoteShape(shape, remote_device_, ctx_->GetContextViewId()));
+  RemoteTensorHandle remote_handle;
+  TF_ASSERT_OK(remote_mgr.SerializeRemoteTensorHandle(
+      handle, /*wait_until_ready=*/true, &remote_handle, remote_device_,
+      remote_device_->name()));
+  ASSERT_TRUE(remote_handle.has_tensor_shape());
+  EXPECT_EQ(shape, TensorShape(remote_handle.tensor_shape()));
+  handle->Unref();
+}
+
 TEST_F(RemoteMgrTest, InvalidateRemoteMirrorWithClusterUpdate) {
   RemoteMgr remote_mgr(false, ctx_);
   Tensor t(DT_FLOAT, TensorShape({0}));
@@ -43,8 +43,10 @@ limitations under the License.
 #include "tensorflow/core/graph/graph_partition.h"
 #include "tensorflow/core/graph/validate.h"
 #include "tensorflow/core/lib/core/errors.h"
+#include "tensorflow/core/lib/strings/strcat.h"
 #include "tensorflow/core/lib/strings/stringprintf.h"
 #include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/fingerprint.h"
 #include "tensorflow/core/platform/logging.h"
 #include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/platform/tracing.h"
@@ -65,6 +67,11 @@ GraphMgr::GraphMgr(const WorkerEnv* worker_env, const DeviceMgr* device_mgr)
   if (!status.ok()) {
     LOG(ERROR) << status.message();
   }
+  status = ReadBoolFromEnvVar("TF_WORKER_REUSE_GRAPH_REGISTRATIONS", false,
+                              &reuse_registrations_);
+  if (!status.ok()) {
+    LOG(ERROR) << status.message();
+  }
 }
 
 GraphMgr::~GraphMgr() {
@@ -291,6 +298,30 @@ Status GraphMgr::InitItem(const string& handle, const GraphDef& gdef,
   return OkStatus();
 }
 
+// Returns a fingerprint identifying the contents of a registration request.
+// Two registrations with the same fingerprint build identical partitions and
+// executors, so the corresponding item can be shared between them. The
+// `session` and `cluster_flr` pointers are part of the identity because the
+// item's executors and rendezvous factory are bound to both. Serialization of
+// the request protos is not guaranteed to be deterministic; a spurious
+// difference only costs a cache miss.
+static uint64 RegistrationFingerprint(
+    const GraphDef& gdef, const GraphOptions& graph_options,
+    const DebugOptions& debug_options, const ConfigProto& config_proto,
+    int64_t collective_graph_key, WorkerSession* session,
+    DistributedFunctionLibraryRuntime* cluster_flr) {
+  string buf;
+  buf.reserve(gdef.ByteSizeLong() + 256);
+  gdef.AppendToString(&buf);
+  graph_options.AppendToString(&buf);
+  debug_options.AppendToString(&buf);
+  config_proto.AppendToString(&buf);
+  strings::StrAppend(&buf, "|", collective_graph_key, "|",
+                     reinterpret_cast<uintptr_t>(session), "|",
+                     reinterpret_cast<uintptr_t>(cluster_flr));
+  return Fingerprint64(buf);
+}
+
 Status GraphMgr::Register(const string& handle, const GraphDef& gdef,
                           const GraphOptions& graph_options,
                           const DebugOptions& debug_options,
@@ -298,6 +329,27 @@ Status GraphMgr::Register(const string& handle, const GraphDef& gdef,
                           int64_t collective_graph_key, WorkerSession* session,
                           DistributedFunctionLibraryRuntime* cluster_flr,
                           string* graph_handle) {
+  uint64 fingerprint = 0;
+  if (reuse_registrations_) {
+    fingerprint =
+        RegistrationFingerprint(gdef, graph_options, debug_options,
+                                config_proto, collective_graph_key, session,
+                                cluster_flr);
+    mutex_lock l(mu_);
+    auto iter = fingerprint_table_.find(fingerprint);
+    if (iter != fingerprint_table_.end()) {
+      // An identical registration is already instantiated; hand out a new
+      // handle to the existing item instead of re-partitioning the graph.
+      Item* item = iter->second;
+      item->Ref();
+      item->num_handles++;
+      *graph_handle =
+          strings::Printf("%016llx", static_cast<long long>(++next_id_));
+      CHECK(table_.insert({*graph_handle, item}).second);
+      return OkStatus();
+    }
+  }
+
   Item* item = new Item;
   Status s = InitItem(handle, gdef, graph_options, debug_options, config_proto,
                       collective_graph_key, session, cluster_flr, item);
@@ -312,7 +364,15 @@ Status GraphMgr::Register(const string& handle, const GraphDef& gdef,
     *graph_handle =
         strings::Printf("%016llx", static_cast<long long>(++next_id_));
     item->handle = *graph_handle;
+    item->fingerprint = fingerprint;
+    item->num_handles = 1;
     CHECK(table_.insert({*graph_handle, item}).second);
+    if (reuse_registrations_) {
+      // If a concurrent registration for the same contents won the race, keep
+      // the existing entry; both items are valid and the loser simply is not
+      // shared with later registrations.
+      fingerprint_table_.emplace(fingerprint, item);
+    }
   }
   return OkStatus();
 }
@@ -329,6 +389,12 @@ Status GraphMgr::Deregister(const string& handle) {
     }
     item = iter->second;
     table_.erase(iter);
+    if (--item->num_handles == 0 && item->fingerprint != 0) {
+      auto fp_iter = fingerprint_table_.find(item->fingerprint);
+      if (fp_iter != fingerprint_table_.end() && fp_iter->second == item) {
+        fingerprint_table_.erase(fp_iter);
+      }
+    }
   }
   item->Unref();
   return OkStatus();
@@ -340,9 +406,11 @@ Status GraphMgr::DeregisterAll() {
   {
     mutex_lock l(mu_);
     for (const auto& entry : table_) {
+      entry.second->num_handles--;
       items.push_back(entry.second);
     }
     table_.clear();
+    fingerprint_table_.clear();
   }
   for (auto item : items) {
     item->Unref();
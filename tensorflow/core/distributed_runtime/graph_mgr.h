@@ -135,6 +135,15 @@ class GraphMgr {
     // Graph handle.
     string handle;
 
+    // Fingerprint of the registration request that produced this item, used
+    // to share the item between identical registrations. Zero if the item is
+    // not eligible for sharing.
+    uint64 fingerprint = 0;
+
+    // Number of handles in `table_` that currently map to this item.
+    // Guarded by GraphMgr::mu_.
+    int num_handles = 0;
+
     std::unique_ptr<FunctionLibraryDefinition> lib_def;
     // Owns the FunctionLibraryRuntime objects needed to execute functions, one
     // per device.
@@ -169,6 +178,15 @@ class GraphMgr {
   // mechanism to gc these graphs.
   std::unordered_map<string, Item*> table_;
 
+  // If true, registrations whose request contents are identical share one
+  // item (and hence one set of partitions and executors) instead of being
+  // re-partitioned and re-instantiated from scratch.
+  bool reuse_registrations_ = false;
+
+  // Non-owning table mapping registration fingerprints to registered items.
+  // An entry is removed once no handle in `table_` maps to its item anymore.
+  std::unordered_map<uint64, Item*> fingerprint_table_ TF_GUARDED_BY(mu_);
+
   void StartParallelExecutors(
       const string& handle, int64_t step_id, Item* item, Rendezvous* rendezvous,
       CollectiveExecutor::Handle* ce_handle, StepStatsCollector* collector,
@@ -1544,12 +1544,26 @@ Status MasterSession::StartStep(const BuildGraphOptions& opts, bool is_partial,
                                 ReffedClientGraph** out_rcg,
                                 int64_t* out_count) {
   const uint64 hash = HashBuildGraphOptions(opts);
+  // TODO(suharshs): We cache partial run graphs and run graphs separately
+  // because there is preprocessing that needs to only be run for partial
+  // run calls.
+  RCGMap* m = is_partial ? &partial_run_graphs_ : &run_graphs_;
+  {
+    // Steady-state steps reuse an already-built graph, so take only a shared
+    // lock for the lookup; concurrent steps then don't serialize here. The
+    // refcount and execution count are atomics, and the maps are only mutated
+    // under the exclusive lock below.
+    tf_shared_lock l(mu_);
+    auto iter = m->find(hash);
+    if (iter != m->end()) {
+      *out_rcg = iter->second;
+      (*out_rcg)->Ref();
+      *out_count = (*out_rcg)->get_and_increment_execution_count();
+      return OkStatus();
+    }
+  }
   {
     mutex_lock l(mu_);
-    // TODO(suharshs): We cache partial run graphs and run graphs separately
-    // because there is preprocessing that needs to only be run for partial
-    // run calls.
-    RCGMap* m = is_partial ? &partial_run_graphs_ : &run_graphs_;
     auto iter = m->find(hash);
     if (iter == m->end()) {
       // We have not seen this subgraph before. Build the subgraph and
@@ -1591,7 +1605,9 @@ void MasterSession::ClearRunsTable(std::vector<ReffedClientGraph*>* to_unref,
 uint64 MasterSession::NewStepId(int64_t graph_key) {
   if (graph_key == BuildGraphOptions::kNoCollectiveGraphKey) {
     // StepId must leave the most-significant 7 bits empty for future use.
-    return random::New64() & (((1uLL << 56) - 1) | (1uLL << 56));
+    // Uses the per-thread generator so that concurrent steps do not contend
+    // on the global RNG mutex.
+    return random::ThreadLocalNew64() & (((1uLL << 56) - 1) | (1uLL << 56));
   } else {
     uint64 step_id = env_->collective_executor_mgr->NextStepId(graph_key);
     int32_t retry_count = 0;
@@ -24,6 +24,7 @@ limitations under the License.
 #include "tensorflow/core/framework/tensor.h"
 #include "tensorflow/core/framework/tensor.pb.h"
 #include "tensorflow/core/framework/versions.pb.h"
+#include "tensorflow/core/platform/protobuf.h"
 #include "tensorflow/core/protobuf/config.pb.h"
 #include "tensorflow/core/protobuf/master.pb.h"
 #include "tensorflow/core/protobuf/worker.pb.h"
@@ -169,6 +170,8 @@ class InMemoryRunStepRequest : public MutableRunStepRequestWrapper {
 // client and master in different address spaces.
 class MutableProtoRunStepRequest : public MutableRunStepRequestWrapper {
  public:
+  MutableProtoRunStepRequest();
+
   // RunStepRequestWrapper methods.
   const string& session_handle() const override;
   const string& partial_run_handle() const override;
@@ -196,7 +199,11 @@ class MutableProtoRunStepRequest : public MutableRunStepRequestWrapper {
   void set_store_errors_in_response_body(bool store_errors) override;
 
  private:
-  RunStepRequest request_;
+  // The request and its submessages are allocated on a wrapper-owned arena:
+  // the feed submessages churn on every step, and arena allocation keeps
+  // their bookkeeping off the heap.
+  protobuf::Arena arena_;
+  RunStepRequest* const request_;
   friend class MasterInterface;
 };
 
@@ -391,6 +398,8 @@ class InMemoryRunGraphRequest : public MutableRunGraphRequestWrapper {
 
 class MutableProtoRunGraphRequest : public MutableRunGraphRequestWrapper {
  public:
+  MutableProtoRunGraphRequest();
+
   // RunGraphRequestWrapper methods.
   const string& session_handle() const override;
   bool create_worker_session_called() const override;
@@ -427,7 +436,10 @@ class MutableProtoRunGraphRequest : public MutableRunGraphRequestWrapper {
   void set_request_id(int64_t request_id) override;
 
  private:
-  RunGraphRequest request_;
+  // Arena-allocated for the same reason as MutableProtoRunStepRequest: the
+  // per-step send submessages dominate the proto churn.
+  protobuf::Arena arena_;
+  RunGraphRequest* const request_;
 };
 
 class ProtoRunGraphRequest : public RunGraphRequestWrapper {
@@ -551,6 +563,8 @@ class InMemoryRunGraphResponse : public MutableRunGraphResponseWrapper {
 // Proto-based message wrapper for use on the client side of the RunGraph RPC.
 class OwnedProtoRunGraphResponse : public MutableRunGraphResponseWrapper {
  public:
+  OwnedProtoRunGraphResponse();
+
   // MutableRunGraphResponseWrapper methods.
   size_t num_recvs() const override;
   const string& recv_key(size_t i) const override;
@@ -570,7 +584,9 @@ class OwnedProtoRunGraphResponse : public MutableRunGraphResponseWrapper {
   RunGraphResponse* get_proto() override;
 
  private:
-  RunGraphResponse response_;
+  // Arena-allocated; the recv submessages are rebuilt on every step.
+  protobuf::Arena arena_;
+  RunGraphResponse* const response_;
 };
 
 // Proto-based message wrapper for use on the server side of the RunGraph RPC.
@@ -693,6 +709,8 @@ class InMemoryRunStepResponse : public MutableRunStepResponseWrapper {
 // Proto-based message wrapper for use on the client side of the RunStep RPC.
 class OwnedProtoRunStepResponse : public MutableRunStepResponseWrapper {
  public:
+  OwnedProtoRunStepResponse();
+
   // MutableRunStepResponseWrapper methods.
   size_t num_tensors() const override;
   const string& tensor_name(size_t i) const override;
@@ -710,7 +728,10 @@ class OwnedProtoRunStepResponse : public MutableRunStepResponseWrapper {
   RunStepResponse* get_proto() override;
 
  private:
-  RunStepResponse response_;
+  // Arena-allocated; the fetched tensor submessages are rebuilt on every
+  // step.
+  protobuf::Arena arena_;
+  RunStepResponse* const response_;
 };
 
 // Proto-based message wrapper for use on the server side of the RunStep RPC.
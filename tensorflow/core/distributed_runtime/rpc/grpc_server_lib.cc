@@ -251,6 +251,32 @@ Status GrpcServer::Init(const GrpcServerOptions& opts) {
                            GetServerCredentials(server_def_), &bound_port_);
   builder.SetMaxMessageSize(std::numeric_limits<int32>::max());
 
+  // Mirror the client-side compression setup in GetChannelArguments(). The
+  // channel arguments only cover request payloads; without a server-side
+  // default the (much larger) RecvTensor response bytes always go out raw.
+  // gRPC negotiates accepted encodings per peer, so a worker pair only
+  // exchanges compressed payloads when both ends enable it, and peers that
+  // do not advertise the algorithm keep receiving uncompressed responses.
+  const RPCOptions& rpc_options = config.rpc_options();
+  if (rpc_options.compression_algorithm() == "deflate") {
+    builder.SetDefaultCompressionAlgorithm(GRPC_COMPRESS_DEFLATE);
+    builder.SetDefaultCompressionLevel(static_cast<grpc_compression_level>(
+        rpc_options.compression_level()));
+    VLOG(5) << "Setting default server GRPC compression : algo='"
+            << rpc_options.compression_algorithm()
+            << "' level=" << rpc_options.compression_level();
+  } else if (rpc_options.compression_algorithm() == "gzip") {
+    builder.SetDefaultCompressionAlgorithm(GRPC_COMPRESS_GZIP);
+    builder.SetDefaultCompressionLevel(static_cast<grpc_compression_level>(
+        rpc_options.compression_level()));
+    VLOG(5) << "Setting default server GRPC compression : algo='"
+            << rpc_options.compression_algorithm()
+            << "' level=" << rpc_options.compression_level();
+  } else if (!rpc_options.compression_algorithm().empty()) {
+    LOG(ERROR) << "Invalid compression algorithm: "
+               << rpc_options.compression_algorithm();
+  }
+
   bool reuse_port = false;
   const Status status =
       ReadBoolFromEnvVar("TF_GRPC_REUSE_PORT", false, &reuse_port);
@@ -30,6 +30,28 @@ namespace tensorflow {
 
 namespace {
 
+// Forwards to an EagerClientCache owned by the worker cache. Handing each
+// caller a thin wrapper instead of its own cache lets every eager context
+// share one set of gRPC clients per remote target: the underlying channels,
+// completion-queue threads and streaming enqueue dispatchers are multiplexed
+// across contexts (per-context streams are keyed by context id inside the
+// shared clients), so transfer overhead does not scale with the number of
+// contexts.
+class SharedEagerClientCache : public eager::EagerClientCache {
+ public:
+  explicit SharedEagerClientCache(
+      std::shared_ptr<eager::EagerClientCache> cache)
+      : cache_(std::move(cache)) {}
+
+  Status GetClient(const string& target,
+                   core::RefCountPtr<eager::EagerClient>* client) override {
+    return cache_->GetClient(target, client);
+  }
+
+ private:
+  std::shared_ptr<eager::EagerClientCache> cache_;
+};
+
 class GrpcWorkerCache : public WorkerCachePartial {
  public:
   explicit GrpcWorkerCache(std::shared_ptr<GrpcChannelCache> channel_cache,
@@ -40,7 +62,16 @@ class GrpcWorkerCache : public WorkerCachePartial {
         local_worker_(local_worker),
         channel_cache_(channel_cache),
         worker_env_(worker_env),
-        next_round_robin_assignment_(0) {}
+        next_round_robin_assignment_(0) {
+    bool warmup_channels = false;
+    Status status = ReadBoolFromEnvVar("TF_GRPC_WORKER_CACHE_WARMUP_CHANNELS",
+                                       false, &warmup_channels);
+    if (!status.ok()) {
+      LOG(ERROR) << "Error parsing TF_GRPC_WORKER_CACHE_WARMUP_CHANNELS: "
+                 << status;
+    }
+    if (warmup_channels) WarmupChannels();
+  }
 
   void ListWorkers(std::vector<string>* workers) const override {
     channel_cache_->ListWorkers(workers);
@@ -77,7 +108,13 @@ class GrpcWorkerCache : public WorkerCachePartial {
 
   Status GetEagerClientCache(
       std::unique_ptr<eager::EagerClientCache>* eager_client_cache) override {
-    eager_client_cache->reset(eager::NewGrpcEagerClientCache(channel_cache_));
+    mutex_lock l(eager_cache_mu_);
+    if (shared_eager_client_cache_ == nullptr) {
+      shared_eager_client_cache_.reset(
+          eager::NewGrpcEagerClientCache(channel_cache_));
+    }
+    eager_client_cache->reset(
+        new SharedEagerClientCache(shared_eager_client_cache_));
     return OkStatus();
   }
 
@@ -97,6 +134,28 @@ class GrpcWorkerCache : public WorkerCachePartial {
   }
 
  private:
+  // Eagerly creates the channels for all known remote workers and starts
+  // connection establishment, so the first RPC to each worker does not pay
+  // the channel creation and TCP handshake latency on the critical path.
+  void WarmupChannels() {
+    std::vector<string> workers;
+    channel_cache_->ListWorkers(&workers);
+    for (const string& target : workers) {
+      if (target == local_target_) continue;
+      SharedGrpcChannelPtr first = channel_cache_->FindWorkerChannel(target);
+      if (!first) continue;
+      // When RPCOptions.num_channels_per_target configures multiple channels
+      // per target, the channel cache hands them out round-robin. Cycle until
+      // the first channel comes around again so that every channel starts
+      // connecting.
+      SharedGrpcChannelPtr channel = first;
+      do {
+        channel->GetState(/*try_to_connect=*/true);
+        channel = channel_cache_->FindWorkerChannel(target);
+      } while (channel != first);
+    }
+  }
+
   size_t AssignWorkerToThread(const string& target) {
     // Round-robin target assignment, but keeps the same target on the same
     // polling thread always, as this is important for gRPC performance
@@ -122,6 +181,12 @@ class GrpcWorkerCache : public WorkerCachePartial {
   std::unordered_map<std::string, size_t> target_assignments_
       TF_GUARDED_BY(assignment_mu_);
   size_t next_round_robin_assignment_ TF_GUARDED_BY(assignment_mu_);
+
+  // Lazily created on the first GetEagerClientCache() call and shared by all
+  // subsequent callers through SharedEagerClientCache wrappers.
+  mutex eager_cache_mu_;
+  std::shared_ptr<eager::EagerClientCache> shared_eager_client_cache_
+      TF_GUARDED_BY(eager_cache_mu_);
 };
 
 }  // namespace
@@ -62,6 +62,56 @@ TEST(GrpcWorkerCacheTest, NewGrpcWorkerCache) {
   EXPECT_EQ(wi, local_wi.get());
 }
 
+TEST(GrpcWorkerCacheTest, WarmupChannels) {
+  setenv("TF_GRPC_WORKER_CACHE_WARMUP_CHANNELS", "true", /*overwrite=*/1);
+  GrpcChannelSpec spec;
+  TF_ASSERT_OK(
+      spec.AddHostPortsJob("worker", {{0, "a:0"}, {1, "b:1"}, {2, "c:2"}}));
+  ChannelCreationFunction channel_func =
+      ConvertToChannelCreationFunction(NewHostPortGrpcChannel);
+  auto channel_cache = std::shared_ptr<GrpcChannelCache>(
+      NewGrpcChannelCache(spec, channel_func));
+  std::unique_ptr<GrpcWorkerEnv> grpc_worker_env(CreateGrpcWorkerEnv());
+
+  // Warm-up runs at construction; workers must still resolve as usual
+  // afterwards.
+  std::unique_ptr<WorkerCacheInterface> worker_cache(
+      NewGrpcWorkerCache(channel_cache, grpc_worker_env.get()));
+  WorkerInterface* wi =
+      worker_cache->GetOrCreateWorker("/job:worker/replica:0/task:0");
+  EXPECT_NE(wi, nullptr);
+  worker_cache->ReleaseWorker("/job:worker/replica:0/task:0", wi);
+  unsetenv("TF_GRPC_WORKER_CACHE_WARMUP_CHANNELS");
+}
+
+TEST(GrpcWorkerCacheTest, SharedEagerClientCache) {
+  GrpcChannelSpec spec;
+  TF_ASSERT_OK(
+      spec.AddHostPortsJob("worker", {{0, "a:0"}, {1, "b:1"}, {2, "c:2"}}));
+  ChannelCreationFunction channel_func =
+      ConvertToChannelCreationFunction(NewHostPortGrpcChannel);
+  auto channel_cache = std::shared_ptr<GrpcChannelCache>(
+      NewGrpcChannelCache(spec, channel_func));
+  std::unique_ptr<GrpcWorkerEnv> grpc_worker_env(CreateGrpcWorkerEnv());
+  std::unique_ptr<WorkerCacheInterface> worker_cache(
+      NewGrpcWorkerCache(channel_cache, grpc_worker_env.get()));
+
+  // Each caller gets its own cache object, but clients for the same target
+  // are shared between them, so channels and streams are multiplexed across
+  // eager contexts.
+  std::unique_ptr<eager::EagerClientCache> cache1;
+  std::unique_ptr<eager::EagerClientCache> cache2;
+  TF_ASSERT_OK(worker_cache->GetEagerClientCache(&cache1));
+  TF_ASSERT_OK(worker_cache->GetEagerClientCache(&cache2));
+  core::RefCountPtr<eager::EagerClient> client1;
+  core::RefCountPtr<eager::EagerClient> client2;
+  TF_ASSERT_OK(
+      cache1->GetClient("/job:worker/replica:0/task:0", &client1));
+  TF_ASSERT_OK(
+      cache2->GetClient("/job:worker/replica:0/task:0", &client2));
+  EXPECT_EQ(client1.get(), client2.get());
+}
+
 TEST(GrpcWorkerCacheTest, DestructWorkerCacheInThreadPool) {
   GrpcChannelSpec spec;
   TF_ASSERT_OK(
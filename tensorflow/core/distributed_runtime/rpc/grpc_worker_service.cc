@@ -15,9 +15,11 @@ limitations under the License.
 
 #include "tensorflow/core/distributed_runtime/rpc/grpc_worker_service.h"
 
+#include <atomic>
 #include <deque>
 #include <memory>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "grpcpp/alarm.h"
@@ -48,6 +50,7 @@ limitations under the License.
 #include "tensorflow/core/lib/gtl/map_util.h"
 #include "tensorflow/core/lib/strings/strcat.h"
 #include "tensorflow/core/lib/strings/stringprintf.h"
+#include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/logging.h"
 #include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/platform/tracing.h"
@@ -148,6 +151,7 @@ class GrpcWorkerServiceThread {
     SETUP_FOR_REQUEST(RunGraph, 100, true);
     SETUP_FOR_REQUEST(CleanupGraph, 100, false);
     SETUP_FOR_REQUEST(MarkRecvFinished, 10, false);
+    SETUP_FOR_REQUEST(RecvTensorBatch, 10, true);
 
     // TODO(ncteisen): Determine a better policy for enqueuing the
     // appropriate number of each request type.
@@ -284,6 +288,25 @@ class GrpcWorkerServiceThread {
     EnqueueRecvTensorRequestRaw();
   }
 
+  void RecvTensorBatchHandler(
+      WorkerCall<RecvTensorBatchRequest, RecvTensorBatchResponse>* call) {
+    Schedule([this, call]() {
+      CallOptions* call_opts = new CallOptions;
+      call->SetCancelCallback([call_opts]() { call_opts->StartCancel(); });
+      worker_->RecvTensorBatchAsync(
+          call_opts, &call->request, &call->response,
+          [call, call_opts](const Status& s) {
+            call->ClearCancelCallback();
+            delete call_opts;
+            if (!s.ok()) {
+              VLOG(3) << "Bad response from RecvTensorBatch:" << s;
+            }
+            call->SendResponse(ToGrpcStatus(s));
+          });
+    });
+    ENQUEUE_REQUEST(RecvTensorBatch, true);
+  }
+
   void RecvBufHandler(WorkerCall<RecvBufRequest, RecvBufResponse>* call) {
     Schedule([this, call]() {
       CallOptions* call_opts = new CallOptions;
@@ -554,6 +577,125 @@ void GrpcWorker::GrpcRecvTensorAsync(CallOptions* opts,
       });
 }
 
+// RecvTensorBatchAsync: answers several RecvTensor requests from the same
+// client with one response message. Sub-requests resolve against the
+// rendezvous independently and may complete in any order; every sub-response
+// slot is preallocated so concurrent completions write to disjoint protos.
+// Tensors travel in proto form: the batch path targets the many-small-tensors
+// pattern, where per-call overhead rather than tensor encoding dominates.
+void GrpcWorker::RecvTensorBatchAsync(CallOptions* opts,
+                                      const RecvTensorBatchRequest* request,
+                                      RecvTensorBatchResponse* response,
+                                      StatusCallback done) {
+  VLOG(3) << "GrpcRecvTensorBatchAsync: " << request->requests_size()
+          << " sub-requests";
+  const int num_requests = request->requests_size();
+  if (num_requests == 0) {
+    done(OkStatus());
+    return;
+  }
+  for (int i = 0; i < num_requests; ++i) response->add_responses();
+
+  // Aggregates sub-request completions: keeps the first error and invokes
+  // `done` once every sub-request has finished.
+  struct BatchState {
+    explicit BatchState(int n) : pending(n) {}
+    std::atomic<int> pending;
+    mutex mu;
+    Status status TF_GUARDED_BY(mu);
+  };
+  auto* state = new BatchState(num_requests);
+  auto sub_done = [state, done](const Status& s) {
+    if (!s.ok()) {
+      mutex_lock l(state->mu);
+      if (state->status.ok()) state->status = s;
+    }
+    if (state->pending.fetch_sub(1) == 1) {
+      Status status;
+      {
+        mutex_lock l(state->mu);
+        status = state->status;
+      }
+      done(status);
+      delete state;
+    }
+  };
+
+  // An RPC cancellation aborts every step involved in the batch; see
+  // GrpcRecvTensorAsync for why transient network failures must abort rather
+  // than hang the step.
+  opts->SetCancelCallback([this, request]() {
+    std::unordered_set<int64_t> aborted_steps;
+    for (const RecvTensorRequest& req : request->requests()) {
+      if (aborted_steps.insert(req.step_id()).second) {
+        LOG(WARNING) << "RecvTensorBatch cancelled for " << req.step_id();
+        AbortStep(req.step_id());
+      }
+    }
+  });
+
+  for (int i = 0; i < num_requests; ++i) {
+    const RecvTensorRequest& req = request->requests(i);
+    RecvTensorResponse* resp = response->mutable_responses(i);
+
+    Status s = recent_request_ids_.TrackUnique(
+        req.request_id(), "RecvTensorBatch (GrpcWorker)", req);
+    Rendezvous::ParsedKey parsed;
+    if (s.ok()) {
+      s = Rendezvous::ParseKey(req.rendezvous_key(), &parsed);
+    }
+    Device* src_dev = nullptr;
+    if (s.ok()) {
+      s = PrepareRecvTensor(parsed, &src_dev);
+    }
+    if (!s.ok()) {
+      sub_done(s);
+      continue;
+    }
+
+    env_->rendezvous_mgr->RecvLocalAsync(
+        req.step_id(), parsed,
+        [src_dev, resp, sub_done](const Status& status,
+                                  const Rendezvous::Args& send_args,
+                                  const Rendezvous::Args& recv_args,
+                                  const Tensor& val, const bool is_dead) {
+          if (!status.ok()) {
+            sub_done(status);
+            return;
+          }
+          resp->set_is_dead(is_dead);
+          resp->set_send_start_micros(Env::Default()->NowMicros());
+
+          const bool on_host = send_args.alloc_attrs.on_host();
+          if (!src_dev->tensorflow_accelerator_device_info() || on_host) {
+            val.AsProtoTensorContent(resp->mutable_tensor());
+            sub_done(status);
+            return;
+          }
+
+          // Device tensor: copy to host before serializing.
+          DeviceContext* send_dev_context = send_args.device_context;
+          AllocatorAttributes alloc_attrs;
+          alloc_attrs.set_gpu_compatible(true);
+          alloc_attrs.set_on_host(true);
+          Allocator* alloc = src_dev->GetAllocator(alloc_attrs);
+          Tensor* copy = new Tensor(alloc, val.dtype(), val.shape());
+          CHECK(send_dev_context)
+              << "send dev name: " << src_dev->name()
+              << " gpu_info: " << src_dev->tensorflow_accelerator_device_info();
+          CopyDeviceToHost(&val, alloc, alloc, "RecvTensorBatch", src_dev, copy,
+                           send_dev_context,
+                           [resp, copy, sub_done](const Status& s) {
+                             if (s.ok()) {
+                               copy->AsProtoTensorContent(resp->mutable_tensor());
+                             }
+                             delete copy;
+                             sub_done(s);
+                           });
+        });
+  }
+}
+
 namespace {
 // If RecvBufRespExtra.tensor_content is a single large string, then gRPC
 // can stall on the recv side when the string buffer needs to be enlarged,
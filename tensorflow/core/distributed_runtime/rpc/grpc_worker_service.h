@@ -51,6 +51,15 @@ class GrpcWorker : public Worker {
                                    ::grpc::ByteBuffer* response,
                                    StatusCallback done);
 
+  // Answers a batch of RecvTensor requests with a single response message,
+  // amortizing per-RPC overhead when many small tensors are fetched from the
+  // same worker. Tensors are returned in proto form rather than the raw
+  // encoding used by `GrpcRecvTensorAsync`.
+  virtual void RecvTensorBatchAsync(CallOptions* opts,
+                                    const RecvTensorBatchRequest* request,
+                                    RecvTensorBatchResponse* response,
+                                    StatusCallback done);
+
   void LoggingAsync(const LoggingRequest* request, LoggingResponse* response,
                     StatusCallback done) override;
 
@@ -15,6 +15,9 @@ limitations under the License.
 
 #include "tensorflow/core/distributed_runtime/rpc/rpc_rendezvous_mgr.h"
 
+#include <unordered_map>
+#include <utility>
+
 #include "tensorflow/core/common_runtime/device.h"
 #include "tensorflow/core/common_runtime/device_mgr.h"
 #include "tensorflow/core/common_runtime/dma_helper.h"
@@ -31,11 +34,76 @@ limitations under the License.
 #include "tensorflow/core/platform/macros.h"
 #include "tensorflow/core/platform/notification.h"
 #include "tensorflow/core/platform/types.h"
+#include "tensorflow/core/util/env_var.h"
 
 namespace tensorflow {
 
 namespace {
 
+// True if the receive side should retain the destination tensor for each
+// rendezvous key and pre-post it into the next RecvTensor call, so the
+// response parser writes the wire bytes straight into the retained buffer
+// instead of a fresh allocation (RDMA-style receive-into). Off by default:
+// reuse assumes the consumer of the previous step's tensor drops its
+// reference before the next step's bytes arrive, which holds for
+// step-synchronized training loops with stable shapes.
+bool RecvIntoPrePostedBuffersEnabled() {
+  static bool enabled = [] {
+    bool value = false;
+    Status status = ReadBoolFromEnvVar("TF_RPC_RECV_INTO", false, &value);
+    if (!status.ok()) {
+      LOG(ERROR) << status.message();
+    }
+    return value;
+  }();
+  return enabled;
+}
+
+// Retains the host tensor most recently received for each rendezvous key so
+// its buffer can be pre-posted to the next receive of the same key. Keys are
+// stable across steps (the step id travels separately in RecvTensorRequest),
+// so repeated-shape training steps hit the same entry every step.
+class RecvBufferRegistry {
+ public:
+  static RecvBufferRegistry* Global() {
+    static RecvBufferRegistry* registry = new RecvBufferRegistry;
+    return registry;
+  }
+
+  // Moves the buffer retained for `key` into *out and returns true iff the
+  // registry holds the only reference to it, i.e. the previous consumer has
+  // released the tensor and its storage is safe to overwrite.
+  bool Acquire(const string& key, Tensor* out) {
+    mutex_lock l(mu_);
+    auto it = buffers_.find(key);
+    if (it == buffers_.end() || !it->second.RefCountIsOne()) {
+      return false;
+    }
+    *out = std::move(it->second);
+    buffers_.erase(it);
+    return true;
+  }
+
+  // Retains `tensor` as the pre-postable buffer for `key`. Only simple-type
+  // tensors can be received in place by the fast parse path.
+  void Cache(const string& key, const Tensor& tensor) {
+    if (!DataTypeCanUseMemcpy(tensor.dtype()) || tensor.NumElements() == 0) {
+      return;
+    }
+    mutex_lock l(mu_);
+    if (buffers_.size() >= kMaxBuffers && buffers_.count(key) == 0) {
+      return;
+    }
+    buffers_[key] = tensor;
+  }
+
+ private:
+  static constexpr int kMaxBuffers = 1000;
+
+  mutex mu_;
+  std::unordered_map<string, Tensor> buffers_ TF_GUARDED_BY(mu_);
+};
+
 class RpcRemoteRendezvous : public BaseRemoteRendezvous {
  public:
   RpcRemoteRendezvous(const WorkerEnv* env, int64_t step_id)
@@ -136,8 +204,20 @@ class RpcRecvTensorCall : public BaseRecvTensorCall {
   // Start the main RecvTensor call, checking for an async abort.
   void StartRTCall(std::function<void()> recv_done) {
     resp_.InitAlloc(dst_device_, alloc_attrs_);
+    // Only host-memory destinations go through the in-place fast parse path.
+    const bool recv_into =
+        RecvIntoPrePostedBuffersEnabled() &&
+        (alloc_attrs_.on_host() ||
+         dst_device_->attributes().device_type() == "CPU");
+    if (recv_into) {
+      Tensor buffer;
+      if (RecvBufferRegistry::Global()->Acquire(req_.rendezvous_key(),
+                                                &buffer)) {
+        resp_.PrePostTensor(std::move(buffer));
+      }
+    }
     auto abort_checked = std::make_shared<Notification>();
-    auto cb = [this, abort_checked,
+    auto cb = [this, abort_checked, recv_into,
                recv_done = std::move(recv_done)](const Status& s) {
       // Make sure the Rendezvous abort checking is finished before running the
       // callback, which might destroy the current call object.
@@ -145,6 +225,9 @@ class RpcRecvTensorCall : public BaseRecvTensorCall {
       if (!s.ok()) {
         mutex_lock l(mu_);
         status_.Update(s);
+      } else if (recv_into && !resp_.metadata().is_dead()) {
+        RecvBufferRegistry::Global()->Cache(req_.rendezvous_key(),
+                                            resp_.tensor());
       }
       recv_done();
     };
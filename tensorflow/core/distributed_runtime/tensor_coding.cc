@@ -31,6 +31,8 @@ void TensorResponse::Clear() {
   alloc_attrs_ = AllocatorAttributes();
   allocator_ = nullptr;
   already_used_ = false;
+  preposted_tensor_ = Tensor();
+  has_preposted_tensor_ = false;
   ClearTensor();
 }
 
@@ -50,6 +52,11 @@ void TensorResponse::InitAlloc(DeviceBase* d, const AllocatorAttributes& aa) {
   allocator_ = device_->GetAllocator(alloc_attrs_);
 }
 
+void TensorResponse::PrePostTensor(Tensor tensor) {
+  preposted_tensor_ = std::move(tensor);
+  has_preposted_tensor_ = true;
+}
+
 Status TensorResponse::InitFrom(RecvTensorResponse* response) {
   Status s;
   meta_.Swap(response);
@@ -195,7 +202,17 @@ bool TensorResponse::ParseTensorSubmessage(
         if (!ReadVarintSizeAsInt(input, &num_bytes)) return false;
         seen_tensor_content = true;
         TensorShape shape(tensor_meta->tensor_shape());
-        Tensor t(allocator_, tensor_meta->dtype(), shape);
+        Tensor t;
+        if (has_preposted_tensor_ &&
+            preposted_tensor_.dtype() == tensor_meta->dtype() &&
+            preposted_tensor_.shape() == shape) {
+          // Receive directly into the caller's pre-posted storage.
+          t = std::move(preposted_tensor_);
+        } else {
+          t = Tensor(allocator_, tensor_meta->dtype(), shape);
+        }
+        preposted_tensor_ = Tensor();
+        has_preposted_tensor_ = false;
         StringPiece buf = t.tensor_data();
         if (static_cast<size_t>(num_bytes) != buf.size()) return false;
         // TODO(jeff,sanjay): Figure out a way to avoid this copy if
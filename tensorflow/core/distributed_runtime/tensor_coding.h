@@ -45,6 +45,17 @@ class TensorResponse {
   // Initialize memory allocation related members.
   void InitAlloc(DeviceBase* d, const AllocatorAttributes& aa);
 
+  // Pre-post a destination tensor for the next ParseFrom call.  If the
+  // incoming tensor has the same dtype and shape, its contents are written
+  // directly into `tensor`'s existing backing storage instead of a freshly
+  // allocated buffer, so a caller that keeps `tensor` alive can reuse one
+  // allocation across repeated receives of the same shape.  On a dtype or
+  // shape mismatch the pre-posted tensor is discarded and parsing falls
+  // back to allocating as usual.  Only effective on the host fast path;
+  // callers must not read the previous contents of `tensor` concurrently
+  // with parsing.
+  void PrePostTensor(Tensor tensor);
+
   // Source provides a way for a particular RPC implementation to provide
   // received data to ParseFrom.
   class Source {
@@ -102,6 +113,8 @@ class TensorResponse {
   Allocator* allocator_ = nullptr;
   bool already_used_ = false;
   Tensor tensor_;
+  Tensor preposted_tensor_;
+  bool has_preposted_tensor_ = false;
   RecvTensorResponse meta_;
 };
 
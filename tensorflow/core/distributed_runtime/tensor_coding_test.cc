@@ -156,6 +156,52 @@ TEST_F(TensorResponseTest, Simple) {
 
 TEST_F(TensorResponseTest, StringTensor) { DoTestForStrings(DT_STRING); }
 
+TEST_F(TensorResponseTest, PrePostedTensorIsReceivedInPlace) {
+  Tensor src(DT_FLOAT, TensorShape({2, 3}));
+  test::FillValues<float>(&src, {1, 2, 3, 4, 5, 6});
+  RecvTensorResponse proto;
+  src.AsProtoTensorContent(proto.mutable_tensor());
+  string encoded;
+  proto.AppendToString(&encoded);
+  StringSource source(&encoded, 1024);
+
+  TensorResponse response;
+  DummyDevice cpu_device(Env::Default());
+  response.InitAlloc(&cpu_device, AllocatorAttributes());
+
+  Tensor preposted(DT_FLOAT, TensorShape({2, 3}));
+  const void* preposted_data = preposted.tensor_data().data();
+  response.PrePostTensor(std::move(preposted));
+
+  Status s = response.ParseFrom(&source);
+  EXPECT_TRUE(s.ok());
+  EXPECT_EQ(response.tensor().tensor_data().data(), preposted_data);
+  test::ExpectTensorEqual<float>(response.tensor(), src);
+}
+
+TEST_F(TensorResponseTest, MismatchedPrePostedTensorFallsBack) {
+  Tensor src(DT_FLOAT, TensorShape({2, 3}));
+  test::FillValues<float>(&src, {1, 2, 3, 4, 5, 6});
+  RecvTensorResponse proto;
+  src.AsProtoTensorContent(proto.mutable_tensor());
+  string encoded;
+  proto.AppendToString(&encoded);
+  StringSource source(&encoded, 1024);
+
+  TensorResponse response;
+  DummyDevice cpu_device(Env::Default());
+  response.InitAlloc(&cpu_device, AllocatorAttributes());
+
+  Tensor preposted(DT_FLOAT, TensorShape({3, 3}));
+  const void* preposted_data = preposted.tensor_data().data();
+  response.PrePostTensor(std::move(preposted));
+
+  Status s = response.ParseFrom(&source);
+  EXPECT_TRUE(s.ok());
+  EXPECT_NE(response.tensor().tensor_data().data(), preposted_data);
+  test::ExpectTensorEqual<float>(response.tensor(), src);
+}
+
 string MakeFloatTensorTestCase(int num_elems) {
   std::vector<int8> v(num_elems);
   for (int i = 0; i < num_elems; i++) {
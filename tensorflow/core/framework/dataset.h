@@ -1475,18 +1475,36 @@ class DatasetBaseIterator : public IteratorBase {
   // has dequeued an element from an internal buffer.
   void RecordBufferDequeue(IteratorContext* ctx,
                            const std::vector<Tensor>& element) {
-    if (collect_resource_usage(ctx)) {
-      node_->record_buffer_event(-GetAllocatedBytes(element), -1);
+    const bool collect = collect_resource_usage(ctx);
+    const bool enforce_ram_budget = EnforceRamBudget(ctx);
+    if (!collect && !enforce_ram_budget) {
+      return;
+    }
+    const int64_t allocated_bytes = GetAllocatedBytes(element);
+    if (collect) {
+      node_->record_buffer_event(-allocated_bytes, -1);
       DCHECK_GE(node_->buffered_elements(), 0);
     }
+    if (enforce_ram_budget) {
+      ctx->ram_budget_manager()->RecordBufferedBytes(-allocated_bytes);
+    }
   }
 
   // When modeling is enabled, this method records the fact that this iterator
   // has enqueued an element in an internal buffer.
   void RecordBufferEnqueue(IteratorContext* ctx,
                            const std::vector<Tensor>& element) {
-    if (collect_resource_usage(ctx)) {
-      node_->record_buffer_event(GetAllocatedBytes(element), 1);
+    const bool collect = collect_resource_usage(ctx);
+    const bool enforce_ram_budget = EnforceRamBudget(ctx);
+    if (!collect && !enforce_ram_budget) {
+      return;
+    }
+    const int64_t allocated_bytes = GetAllocatedBytes(element);
+    if (collect) {
+      node_->record_buffer_event(allocated_bytes, 1);
+    }
+    if (enforce_ram_budget) {
+      ctx->ram_budget_manager()->RecordBufferedBytes(allocated_bytes);
     }
   }
 
@@ -1532,6 +1550,13 @@ class DatasetBaseIterator : public IteratorBase {
     return ctx->model() && node_;
   }
 
+  // Whether buffered elements should be charged against the pipeline-wide ram
+  // budget, i.e. the budget was explicitly configured as a hard limit.
+  bool EnforceRamBudget(IteratorContext* ctx) {
+    return ctx->ram_budget_manager() != nullptr &&
+           ctx->ram_budget_manager()->IsBudgetHardLimit();
+  }
+
   string traceme_metadata_;
   BaseParams params_;
 };
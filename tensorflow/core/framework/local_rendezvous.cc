@@ -15,7 +15,9 @@ limitations under the License.
 
 #include "tensorflow/core/framework/local_rendezvous.h"
 
+#include <atomic>
 #include <memory>
+#include <new>
 #include <string>
 #include <utility>
 
@@ -30,6 +32,7 @@ limitations under the License.
 #include "tensorflow/core/lib/strings/numbers.h"
 #include "tensorflow/core/lib/strings/str_util.h"
 #include "tensorflow/core/platform/logging.h"
+#include "tensorflow/core/platform/mem.h"
 #include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/platform/refcount.h"
 #include "tensorflow/core/platform/types.h"
@@ -78,6 +81,10 @@ struct LocalRendezvous::Item {
   // Link to next item in an ItemQueue.
   Item* next = nullptr;
 
+  // For kSend items parked in a bucket's fast_send_slot: the hash of the
+  // full rendezvous key, used by RecvAsync to match without the lock.
+  uint64 key_hash = 0;
+
   // The validity of `send_state` or `recv_state` is determined by `type ==
   // kSend` or `type == kRecv` respectively.
   union {
@@ -106,6 +113,56 @@ struct LocalRendezvous::Item {
   }
 };
 
+template <typename... Args>
+LocalRendezvous::Item* LocalRendezvous::AllocateItem(Args&&... args) {
+  void* storage = nullptr;
+  {
+    mutex_lock l(item_freelist_mu_);
+    if (item_freelist_ != nullptr) {
+      storage = item_freelist_;
+      item_freelist_ = item_freelist_->next;
+      --item_freelist_size_;
+    }
+  }
+  if (storage == nullptr) {
+    storage = port::Malloc(sizeof(Item));
+  }
+  return new (storage) Item(std::forward<Args>(args)...);
+}
+
+void LocalRendezvous::ReleaseItem(Item* item) {
+  // Steal the item's owner reference first: destroying the item's tensor or
+  // waiter closure may drop other references to the rendezvous, and the
+  // freelist must not be touched after the last reference is gone.
+  tsl::core::RefCountPtr<Rendezvous> rc_owner = std::move(item->rc_owner);
+  item->~Item();
+  auto* block = reinterpret_cast<ItemFreeBlock*>(item);
+  bool recycled = false;
+  {
+    mutex_lock l(item_freelist_mu_);
+    if (item_freelist_size_ < kMaxRecycledItems) {
+      block->next = item_freelist_;
+      item_freelist_ = block;
+      ++item_freelist_size_;
+      recycled = true;
+    }
+  }
+  if (!recycled) {
+    port::Free(block);
+  }
+  // `rc_owner` is released here, which may destruct the rendezvous.
+}
+
+void LocalRendezvous::ReserveKeys(int num_keys) {
+  if (num_keys <= 0) return;
+  const int keys_per_bucket = num_keys / num_buckets_ + 1;
+  for (int i = 0; i < num_buckets_; ++i) {
+    auto& bucket = table_buckets_[i];
+    mutex_lock l(bucket.mu);
+    bucket.table.reserve(keys_per_bucket);
+  }
+}
+
 void LocalRendezvous::ItemQueue::push_back(Item* item) {
   if (TF_PREDICT_TRUE(head == nullptr)) {
     // The queue is empty.
@@ -118,6 +175,17 @@ void LocalRendezvous::ItemQueue::push_back(Item* item) {
   }
 }
 
+void LocalRendezvous::ItemQueue::push_front(Item* item) {
+  if (head == nullptr) {
+    head = item;
+    tail = item;
+  } else {
+    DCHECK_EQ(head->type, item->type);
+    item->next = head;
+    head = item;
+  }
+}
+
 LocalRendezvous::~LocalRendezvous() {
   // Before destroying this rendezvous instance, make sure all the done-callback
   // calls have finished and the tensors have been released from the queue.
@@ -131,23 +199,26 @@ LocalRendezvous::~LocalRendezvous() {
             l, std::chrono::milliseconds(50));
       }
     }
-    if (!bucket.table.empty()) {
+    if (!bucket.table.empty() ||
+        bucket.fast_send_slot.load(std::memory_order_acquire) != nullptr) {
       table_not_empty = true;
     }
   }
   if (table_not_empty) {
     DoAbort(absl::CancelledError("LocalRendezvous deleted"));
   }
+  mutex_lock l(item_freelist_mu_);
+  while (item_freelist_ != nullptr) {
+    ItemFreeBlock* block = item_freelist_;
+    item_freelist_ = block->next;
+    port::Free(block);
+  }
 }
 
-namespace {
-uint64 KeyHash(const StringPiece& k) { return Hash64(k.data(), k.size()); }
-}  // namespace
-
 Status LocalRendezvous::Send(const Rendezvous::ParsedKey& key,
                              const Rendezvous::Args& send_args,
                              const Tensor& val, const bool is_dead) {
-  uint64 key_hash = KeyHash(key.FullKey());
+  uint64 key_hash = key.FullKeyHash();
   DVLOG(2) << "Send " << this << " " << key_hash << " " << key.FullKey();
 
   if (is_dead) {
@@ -164,6 +235,54 @@ Status LocalRendezvous::Send(const Rendezvous::ParsedKey& key,
 
   int bucket_index = key_hash % num_buckets_;
   auto& bucket = table_buckets_[bucket_index];
+
+  // Lock-free fast path: when no recv is in flight and no send is queued in
+  // this bucket, park the message in the bucket's single-item slot with a CAS
+  // and let the matching RecvAsync claim it without taking the bucket lock.
+  // See the comments on TableBucket for the protocol. The `table_sends` check
+  // keeps per-key FIFO: an older send of the same key may sit in the table
+  // (queued while a recv was pending), and this send must line up behind it.
+  if (bucket.recv_waiters.load(std::memory_order_seq_cst) == 0 &&
+      bucket.table_sends.load(std::memory_order_seq_cst) == 0 &&
+      bucket.fast_send_slot.load(std::memory_order_relaxed) == nullptr) {
+    activity_watcher::ActivityScope activity_scope(
+        [&]() {
+          return std::make_unique<activity_watcher::Activity>(
+              "LocalRendezvous::Send",
+              activity_watcher::ActivityCategory::kRendezvous,
+              activity_watcher::Activity::Attributes{
+                  {"Rendezvous", absl::StrFormat("%p", this)},
+                  {"key", std::string(key.FullKey())},
+                  {"key_hash", absl::StrCat(key_hash)},
+              });
+        },
+        /*level=*/1);
+    Item* item = AllocateItem(tsl::core::GetNewRef(rc_owner_), send_args, val,
+                              is_dead, std::move(activity_scope));
+    item->key_hash = key_hash;
+    Item* expected = nullptr;
+    if (bucket.fast_send_slot.compare_exchange_strong(
+            expected, item, std::memory_order_seq_cst)) {
+      if (bucket.recv_waiters.load(std::memory_order_seq_cst) == 0 &&
+          bucket.table_sends.load(std::memory_order_seq_cst) == 0) {
+        DVLOG(2) << "Parked Send Item (key:" << key.FullKey() << "). ";
+        return OkStatus();
+      }
+      // A recv or a table-bound send raced in between the initial check and
+      // the CAS. Take the item back (unless a recv already claimed it) and go
+      // through the locked path so a waiter is not left behind a parked send
+      // and send ordering stays consistent with the table.
+      Item* parked = item;
+      if (!bucket.fast_send_slot.compare_exchange_strong(
+              parked, nullptr, std::memory_order_seq_cst)) {
+        return OkStatus();
+      }
+      return EnqueueSendItem(bucket, key_hash, item);
+    }
+    // Lost the race for the slot to another send; fall back to the table.
+    return EnqueueSendItem(bucket, key_hash, item);
+  }
+
   bucket.mu.lock();
 
   auto it = bucket.table.insert({key_hash, ItemQueue()}).first;
@@ -188,8 +307,9 @@ Status LocalRendezvous::Send(const Rendezvous::ParsedKey& key,
               });
         },
         /*level=*/1);
-    queue->push_back(new Item(std::move(rc_owner), send_args, val, is_dead,
-                              std::move(activity_scope)));
+    queue->push_back(AllocateItem(std::move(rc_owner), send_args, val, is_dead,
+                                  std::move(activity_scope)));
+    bucket.table_sends.fetch_add(1, std::memory_order_seq_cst);
     bucket.mu.unlock();
     return OkStatus();
   }
@@ -205,6 +325,7 @@ Status LocalRendezvous::Send(const Rendezvous::ParsedKey& key,
   } else {
     queue->head = item->next;
   }
+  bucket.recv_waiters.fetch_sub(1, std::memory_order_seq_cst);
   bucket.pending_callback_counter++;
   // Invoke the done-callback, without holding the lock.
   bucket.mu.unlock();
@@ -218,15 +339,60 @@ Status LocalRendezvous::Send(const Rendezvous::ParsedKey& key,
       bucket.pending_callback_cond_var.notify_all();
     }
   }
-  // Delete the item at last since it may unref and destruct the rendezvous.
-  delete item;
+  // Release the item at last since it may unref and destruct the rendezvous.
+  ReleaseItem(item);
+  return OkStatus();
+}
+
+Status LocalRendezvous::EnqueueSendItem(TableBucket& bucket, uint64 key_hash,
+                                        Item* item) {
+  DCHECK_EQ(item->type, Item::kSend);
+  bucket.mu.lock();
+  auto it = bucket.table.insert({key_hash, ItemQueue()}).first;
+  ItemQueue* queue = &it->second;
+  if (queue->head == nullptr || queue->head->type == Item::kSend) {
+    // `item` came out of the fast slot, so it predates any send of the same
+    // key that was queued in the table while the slot was occupied.
+    queue->push_front(item);
+    bucket.table_sends.fetch_add(1, std::memory_order_seq_cst);
+    bucket.mu.unlock();
+    return OkStatus();
+  }
+
+  // There is an earliest waiter to consume this message.
+  Item* waiter = queue->head;
+  if (waiter->next == nullptr) {
+    bucket.table.erase(it);
+  } else {
+    queue->head = waiter->next;
+  }
+  bucket.recv_waiters.fetch_sub(1, std::memory_order_seq_cst);
+  bucket.pending_callback_counter++;
+  // Invoke the done-callback, without holding the lock.
+  bucket.mu.unlock();
+
+  DCHECK_EQ(waiter->type, Item::kRecv);
+  (*waiter->recv_state.waiter)(OkStatus(), item->args, waiter->args,
+                               *item->send_state.value,
+                               item->send_state.is_dead);
+  {
+    mutex_lock l(bucket.mu);
+    bucket.pending_callback_counter--;
+    if (bucket.pending_callback_counter == 0) {
+      bucket.pending_callback_cond_var.notify_all();
+    }
+  }
+  // Release the items at last since they may unref and destruct the
+  // rendezvous.
+  ReleaseItem(waiter);
+  ReleaseItem(item);
   return OkStatus();
 }
 
 void LocalRendezvous::RecvAsync(const Rendezvous::ParsedKey& key,
                                 const Rendezvous::Args& recv_args,
                                 Rendezvous::DoneCallback done) {
-  uint64 key_hash = KeyHash(key.FullKey());
+  uint64 key_hash = key.FullKeyHash();
   DVLOG(2) << "Recv " << this << " " << key_hash << " " << key.FullKey();
   tsl::core::RefCountPtr<Rendezvous> rc_keep_alive;
 
@@ -239,6 +405,41 @@ void LocalRendezvous::RecvAsync(const Rendezvous::ParsedKey& key,
 
   int bucket_index = key_hash % num_buckets_;
   auto& bucket = table_buckets_[bucket_index];
+
+  // Count this recv before inspecting the fast slot so that a concurrent
+  // Send either sees the count and uses the locked path, or parks its item
+  // early enough for the load below to observe it (see TableBucket).
+  bucket.recv_waiters.fetch_add(1, std::memory_order_seq_cst);
+
+  // Lock-free fast path: claim a parked send without the bucket lock. A
+  // parked item for a different key is left untouched: claiming it would
+  // make it momentarily invisible to both the slot and `table_sends`, so a
+  // younger send of the same key could be consumed ahead of it. The occupied
+  // slot already forces later sends onto the locked path, and the parked
+  // item predates every table entry, so leaving it in place preserves
+  // per-key send FIFO while this recv proceeds to the table below.
+  Item* parked = bucket.fast_send_slot.load(std::memory_order_seq_cst);
+  if (parked != nullptr && parked->key_hash == key_hash &&
+      bucket.fast_send_slot.compare_exchange_strong(
+          parked, nullptr, std::memory_order_seq_cst)) {
+    if (TF_PREDICT_TRUE(parked->key_hash == key_hash)) {
+      bucket.recv_waiters.fetch_sub(1, std::memory_order_seq_cst);
+      DVLOG(2) << "Consume parked Send Item (key:" << key.FullKey() << "). ";
+      DCHECK_EQ(parked->type, Item::kSend);
+      done(OkStatus(), parked->args, recv_args, *parked->send_state.value,
+           parked->send_state.is_dead);
+      // Release the item at last since it may unref and destruct the
+      // rendezvous.
+      ReleaseItem(parked);
+      return;
+    }
+    // Between the key check and the CAS, the matching item was claimed by a
+    // concurrent recv, recycled through the freelist, and re-parked as a
+    // send for a different key at the same address. Reinsert the claimed
+    // item through the locked path and fall through to the table.
+    EnqueueSendItem(bucket, parked->key_hash, parked).IgnoreError();
+  }
+
   bucket.mu.lock();
 
   auto it = bucket.table.insert({key_hash, ItemQueue()}).first;
@@ -289,15 +490,17 @@ void LocalRendezvous::RecvAsync(const Rendezvous::ParsedKey& key,
         }
 
         if (item != nullptr) {
+          bucket.recv_waiters.fetch_sub(1, std::memory_order_seq_cst);
           (*item->recv_state.waiter)(
               StatusGroup::MakeDerived(
                   errors::Cancelled("RecvAsync is cancelled.")),
               Rendezvous::Args(), item->args, Tensor(), /*is_dead=*/false);
-          delete item;
+          ReleaseItem(item);
         }
       });
     }
     if (already_cancelled) {
+      bucket.recv_waiters.fetch_sub(1, std::memory_order_seq_cst);
       bucket.mu.unlock();
       done(StatusGroup::MakeDerived(
                errors::Cancelled("RecvAsync is cancelled.")),
@@ -326,7 +529,7 @@ void LocalRendezvous::RecvAsync(const Rendezvous::ParsedKey& key,
       // NOTE(mrry): We must wrap `done` with code that deregisters the
       // cancellation callback before calling the `done` callback, because the
       // cancellation manager may no longer be live after `done` is called.
-      queue->push_back(new Item(
+      queue->push_back(AllocateItem(
           std::move(rc_owner), recv_args,
           [this, cm, token, done = std::move(done)](
               const Status& s, const Rendezvous::Args& send_args,
@@ -342,8 +545,9 @@ void LocalRendezvous::RecvAsync(const Rendezvous::ParsedKey& key,
           },
           token, std::move(activity_scope)));
     } else {
-      queue->push_back(new Item(std::move(rc_owner), recv_args, std::move(done),
-                                token, std::move(activity_scope)));
+      queue->push_back(AllocateItem(std::move(rc_owner), recv_args,
+                                    std::move(done), token,
+                                    std::move(activity_scope)));
     }
 
     bucket.mu.unlock();
@@ -362,6 +566,8 @@ void LocalRendezvous::RecvAsync(const Rendezvous::ParsedKey& key,
   } else {
     queue->head = item->next;
   }
+  bucket.table_sends.fetch_sub(1, std::memory_order_seq_cst);
+  bucket.recv_waiters.fetch_sub(1, std::memory_order_seq_cst);
   bucket.pending_callback_counter++;
   // Invoke the done-callback, without holding the lock.
   bucket.mu.unlock();
@@ -376,8 +582,8 @@ void LocalRendezvous::RecvAsync(const Rendezvous::ParsedKey& key,
       bucket.pending_callback_cond_var.notify_all();
     }
   }
-  // Delete the item at last since it may unref and destruct the rendezvous.
-  delete item;
+  // Release the item at last since it may unref and destruct the rendezvous.
+  ReleaseItem(item);
 }
 
 mutex& LocalRendezvous::aborted_rendezs_mu_ = *new mutex();
@@ -403,10 +609,18 @@ void LocalRendezvous::DoAbort(const Status& status) {
   }
   LOG(WARNING) << "Local rendezvous is aborting with status: " << status;
 
-  // Keeps one Item to make sure the current rendezvous won't be destructed.
-  std::unique_ptr<Item> to_delete;
+  // Steals one owner reference from the first released item to make sure the
+  // current rendezvous won't be destructed while the buckets are drained.
+  tsl::core::RefCountPtr<Rendezvous> keep_alive;
   for (int i = 0; i < num_buckets_; ++i) {
     auto& bucket = table_buckets_[i];
+    Item* parked = bucket.fast_send_slot.exchange(nullptr);
+    if (parked != nullptr) {
+      LOG(INFO) << "Local rendezvous parked send item cancelled. Key hash: "
+                << parked->key_hash;
+      if (keep_alive == nullptr) keep_alive = std::move(parked->rc_owner);
+      ReleaseItem(parked);
+    }
     Table table;
     {
       mutex_lock l(bucket.mu);
@@ -417,21 +631,26 @@ void LocalRendezvous::DoAbort(const Status& status) {
       while (item != nullptr) {
         switch (item->type) {
           case Item::kRecv:
+            bucket.recv_waiters.fetch_sub(1, std::memory_order_seq_cst);
             (*item->recv_state.waiter)(status, Rendezvous::Args(),
                                        Rendezvous::Args(), Tensor(), false);
             LOG(INFO) << "Local rendezvous recv item cancelled. Key hash: "
                       << p.first;
             break;
           case Item::kSend:
+            bucket.table_sends.fetch_sub(1, std::memory_order_seq_cst);
             LOG(INFO) << "Local rendezvous send item cancelled. Key hash: "
                       << p.first;
             break;
         }
-        to_delete.reset(item);
-        item = item->next;
+        Item* next = item->next;
+        if (keep_alive == nullptr) keep_alive = std::move(item->rc_owner);
+        ReleaseItem(item);
+        item = next;
       }
     }
   }
+  // `keep_alive` is released here, which may destruct the rendezvous.
 }
 
 Status LocalRendezvous::status() {
@@ -16,6 +16,7 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_FRAMEWORK_LOCAL_RENDEZVOUS_H_
 #define TENSORFLOW_CORE_FRAMEWORK_LOCAL_RENDEZVOUS_H_
 
+#include <atomic>
 #include <memory>
 #include <optional>
 #include <vector>
@@ -58,6 +59,12 @@ class LocalRendezvous {
   void StartAbort(const Status& status);
   Status status();
 
+  // Pre-sizes each bucket's key table for approximately `num_keys` distinct
+  // rendezvous keys in flight, so callers that know the number of sends and
+  // recvs in a step (e.g. from the partitioned graphs) avoid growing the
+  // tables while messages are queued.
+  void ReserveKeys(int num_keys);
+
   // Releases all the references to the aborted rendezvous. Used in unit tests.
   static void ReleaseAbortedRendezvous() {
     mutex_lock l(aborted_rendezs_mu_);
@@ -77,6 +84,7 @@ class LocalRendezvous {
   //   [item.type == kRecv]* meaning each item is a waiter.
   struct ItemQueue {
     void push_back(Item* item);
+    void push_front(Item* item);
 
     Item* head = nullptr;
     Item* tail = nullptr;
@@ -96,10 +104,55 @@ class LocalRendezvous {
     // Track the number of pening callbacks using a counter.
     int pending_callback_counter TF_GUARDED_BY(mu) = 0;
     condition_variable pending_callback_cond_var TF_GUARDED_BY(mu);
+
+    // Lock-free fast path for the common send-then-recv handoff. A Send that
+    // finds no recv waiter in the bucket parks its item here with a single
+    // CAS; the matching RecvAsync claims it with another CAS, so neither side
+    // takes `mu`. `recv_waiters` counts recvs that are in flight or parked in
+    // `table`; `table_sends` counts send items resident in `table` (updated
+    // under `mu`). Send only uses the slot when both are zero, and re-checks
+    // after publishing (Dekker-style, all seq_cst) so a racing recv is never
+    // left waiting behind a parked send. Gating on `table_sends` preserves
+    // per-key FIFO between sends: a send must not overtake an older send of
+    // the same key that was forced into the table by a recv that has since
+    // completed.
+    std::atomic<Item*> fast_send_slot{nullptr};
+    std::atomic<int> recv_waiters{0};
+    std::atomic<int> table_sends{0};
   };
 
+  // Inserts `item` (a kSend item for `key_hash`) into the bucket's table
+  // under the lock, or hands it to a parked recv waiter. Shared by the
+  // fast-path rollbacks in Send and RecvAsync.
+  Status EnqueueSendItem(TableBucket& bucket, uint64 key_hash, Item* item);
+
+  // Items (and the closures they carry) are allocated and freed once per
+  // message, which shows up as allocator churn at high send rates. Their
+  // storage is therefore recycled through a small freelist. The freelist is
+  // per-rendezvous, so with the usual one rendezvous per step it is
+  // step-scoped and dies with the step.
+  struct ItemFreeBlock {
+    ItemFreeBlock* next;
+  };
+
+  // Constructs an Item, reusing recycled storage when available.
+  template <typename... Args>
+  Item* AllocateItem(Args&&... args);
+
+  // Destroys `item` and returns its storage to the freelist. May release the
+  // last reference to the owner rendezvous, so callers must not touch `this`
+  // afterwards (same contract as deleting the item).
+  void ReleaseItem(Item* item);
+
+  static constexpr int kMaxRecycledItems = 128;
+
   // Immutable set of buckets. This uses less memory than std::vector.
   const std::unique_ptr<TableBucket[]> table_buckets_;
+
+  mutex item_freelist_mu_;
+  ItemFreeBlock* item_freelist_ TF_GUARDED_BY(item_freelist_mu_) = nullptr;
+  int item_freelist_size_ TF_GUARDED_BY(item_freelist_mu_) = 0;
+
   mutex mu_;
   Status status_ TF_GUARDED_BY(mu_);
 
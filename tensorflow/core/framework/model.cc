@@ -280,6 +280,23 @@ inline bool IsAsyncInterleaveManyNode(const Node* node) {
 // Wrapper for the square function to reduce verbosity.
 inline double Square(double x) { return x * x; }
 
+// Returns the sum of the tunable parallelism parameter values in the tree
+// rooted in the given node, i.e. the number of cores the pipeline may use
+// concurrently for processing.
+inline double TotalTunableParallelism(std::shared_ptr<Node> node) {
+  double total_parallelism = 0.0;
+  Node::NodeVector nodes = node->CollectNodes(TraversalOrder::BFS, IsAnyNode);
+  nodes.push_back(node);
+  for (const auto& current_node : nodes) {
+    for (const auto& pair : current_node->CollectNodeTunableParameters()) {
+      if (pair.second->name == kParallelism) {
+        total_parallelism += pair.second->value;
+      }
+    }
+  }
+  return total_parallelism;
+}
+
 // Collects "essential" parallelism parameters and buffer size parameters in the
 // tree rooted in the given node. Which parallelism parameters are essential is
 // determined by the relative processing time spent in the corresponding
@@ -2776,6 +2793,7 @@ void Model::OptimizeStageBasedAsyncInterleaveManyNodes(
   ModelTiming model_timing(snapshot);
   ModelTimingPriorityQueue priority_queue(model_timing);
   NodeParallelismParameters node_parallelism;
+  double total_parallelism = TotalTunableParallelism(snapshot);
   while (!cancellation_manager->IsCancelled()) {
     StatusOr<std::pair<double, Node*>> critical_root_status =
         priority_queue.PopSlowestStageRoot();
@@ -2794,6 +2812,18 @@ void Model::OptimizeStageBasedAsyncInterleaveManyNodes(
       continue;
     }
     parallelism_parameter->value += 1.0;
+    total_parallelism += 1.0;
+    if (total_parallelism > optimization_params.cpu_budget()) {
+      // Increasing the parallelism by 1 exceeded the CPU budget. Reduce it
+      // back and stop optimization; the budget caps the pipeline's total
+      // parallelism so that it does not steal cores from co-scheduled work.
+      parallelism_parameter->value -= 1.0;
+      // Removes the `<index>` of `[<index>]` to reduce the number of labels.
+      metrics::RecordTFDataAutotuneStoppingCriteria(strings::StrCat(
+          "cpu_budget_exceeded:",
+          RemoveArrayIndices(critical_root.second->long_name())));
+      break;
+    }
     if (TotalMaximumBufferedBytes(snapshot) >
         optimization_params.ram_budget()) {
       // Increasing the parallelism by 1 exceeded ram budget. Reduce it back and
@@ -2856,6 +2886,10 @@ void Model::OptimizeStageBasedNonAsyncInterleaveManyNodes(
     }
     pair.second->value = pair.second->min;
   }
+  // Account for all parallelism in the snapshot, including async interleave
+  // many nodes tuned separately, so that the CPU budget caps the pipeline as
+  // a whole.
+  double total_parallelism = TotalTunableParallelism(snapshot);
   ModelTiming model_timing(snapshot);
   ModelTimingPriorityQueue priority_queue(model_timing);
   StatusOr<std::pair<double, Node*>> critical_root_status =
@@ -2886,6 +2920,18 @@ void Model::OptimizeStageBasedNonAsyncInterleaveManyNodes(
       break;
     }
     parallelism_parameter->value += 1.0;
+    total_parallelism += 1.0;
+    if (total_parallelism > optimization_params.cpu_budget()) {
+      // Increasing the parallelism by 1 exceeded the CPU budget. Reduce it
+      // back and stop optimization; the budget caps the pipeline's total
+      // parallelism so that it does not steal cores from co-scheduled work.
+      parallelism_parameter->value -= 1.0;
+      // Removes the `<index>` of `[<index>]` to reduce the number of labels.
+      metrics::RecordTFDataAutotuneStoppingCriteria(strings::StrCat(
+          "cpu_budget_exceeded:",
+          RemoveArrayIndices(critical_root.second->long_name())));
+      break;
+    }
     if (cancellation_manager->IsCancelled() ||
         TotalMaximumBufferedBytes(snapshot) >
             optimization_params.ram_budget()) {
@@ -16,6 +16,7 @@ limitations under the License.
 #define TENSORFLOW_CORE_FRAMEWORK_MODEL_H_
 
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <deque>
 #include <functional>
@@ -236,6 +237,41 @@ class RamBudgetManager {
     VLOG(2) << "Updated ram budget to " << budget;
   }
 
+  // Marks the budget as a hard limit on the total number of bytes buffered
+  // across the pipeline. Called when the budget comes from an explicit
+  // `ram_budget` setting in `Options` rather than from an autotune heuristic.
+  void MarkBudgetAsHardLimit() {
+    hard_limit_.store(true, std::memory_order_relaxed);
+  }
+
+  bool IsBudgetHardLimit() const {
+    return hard_limit_.load(std::memory_order_relaxed);
+  }
+
+  // Adjusts the number of bytes currently held in pipeline buffers. Called
+  // with a positive delta when an element is enqueued in any internal buffer
+  // and with a negative delta when it is dequeued.
+  void RecordBufferedBytes(int64_t delta_bytes) {
+    buffered_bytes_.fetch_add(delta_bytes, std::memory_order_relaxed);
+  }
+
+  int64_t TotalBufferedBytes() const {
+    return buffered_bytes_.load(std::memory_order_relaxed);
+  }
+
+  // Whether a producer that already holds at least one buffered element
+  // should wait for the pipeline to drain before buffering more. Producers
+  // whose buffers are empty must keep producing regardless of the budget, so
+  // the stages closest to the consumer always make progress and the pipeline
+  // cannot deadlock on the byte cap.
+  bool ShouldStallProducer() const {
+    if (!IsBudgetHardLimit()) {
+      return false;
+    }
+    tf_shared_lock l(mu_);
+    return buffered_bytes_.load(std::memory_order_relaxed) >= budget_;
+  }
+
  private:
   mutable mutex mu_;
   int64_t budget_ TF_GUARDED_BY(mu_) = 0;
@@ -243,6 +279,12 @@ class RamBudgetManager {
   int64_t legacy_prefetch_allocated_ TF_GUARDED_BY(mu_) = 0;
   // Number of bytes allocated by the model.
   int64_t model_allocated_ TF_GUARDED_BY(mu_) = 0;
+  // Whether `budget_` is a hard cap on `buffered_bytes_`.
+  std::atomic<bool> hard_limit_{false};
+  // Number of bytes currently held in the internal buffers of all iterators
+  // sharing this manager, as reported by `RecordBufferEnqueue` and
+  // `RecordBufferDequeue`.
+  std::atomic<int64_t> buffered_bytes_{0};
 };
 
 // Abstract representation of a TensorFlow input pipeline node. It collects
@@ -2618,6 +2618,73 @@ TEST_F(ModelTimingTest, OptimizeStageBased_OneStage) {
   EXPECT_EQ(5, GetNode(/*node_id=*/1)->parameter_value("parallelism"));
 }
 
+TEST_F(ModelTimingTest, OptimizeStageBased_CappedByCpuBudget) {
+  BuildModelFromProto(R"pb(
+    nodes: {
+      key: 1
+      value: {
+        id: 1
+        name: "ParallelMapV2"
+        autotune: true
+        num_elements: 97
+        buffered_elements: 3
+        processing_time: 5000
+        bytes_produced: 10000
+        node_class: ASYNC_KNOWN_RATIO
+        ratio: 1
+        inputs: 2
+        parameters: {
+          name: "parallelism"
+          value: 4
+          min: 1
+          max: 16
+          tunable: true
+        }
+      }
+    }
+    nodes: {
+      key: 2
+      value: {
+        id: 2
+        name: "Map"
+        autotune: true
+        num_elements: 100
+        processing_time: 3000
+        node_class: KNOWN_RATIO
+        ratio: 1
+        inputs: 3
+      }
+    }
+    nodes: {
+      key: 3
+      value: {
+        id: 3
+        name: "SSTable"
+        autotune: true
+        num_elements: 100
+        processing_time: 1000
+        node_class: KNOWN_RATIO
+      }
+    }
+    output: 1
+  )pb");
+
+  CellReader<int64_t> cell_reader(
+      "/tensorflow/data/autotune_stopping_criteria");
+  CancellationManager cancellation_manager;
+  RamBudgetManager ram_budget_manager(0);
+  model_->Optimize(AutotuneAlgorithm::STAGE_BASED, CpuBudgetFunc(3),
+                   /*ram_budget_share=*/1.0,
+                   /*fixed_ram_budget=*/1000,
+                   /*model_input_time=*/50, ram_budget_manager,
+                   &cancellation_manager);
+
+  // The CPU budget is set to 3. Otherwise, the expected parallelism value is
+  // 5.
+  EXPECT_EQ(3, GetNode(/*node_id=*/1)->parameter_value("parallelism"));
+  EXPECT_EQ(cell_reader.Read("cpu_budget_exceeded:ParallelMapV2(id:1)"), 1);
+}
+
 TEST_F(ModelTimingTest, OptimizeStageBased_CappedByParameterMax) {
   BuildModelFromProto(R"pb(
     nodes: {
@@ -2739,7 +2806,7 @@ TEST_F(ModelTimingTest, OptimizeStageBased_TwoStages) {
 
   CancellationManager cancellation_manager;
   RamBudgetManager ram_budget_manager(0);
-  model_->Optimize(AutotuneAlgorithm::STAGE_BASED, CpuBudgetFunc(5),
+  model_->Optimize(AutotuneAlgorithm::STAGE_BASED, CpuBudgetFunc(20),
                    /*ram_budget_share=*/1.0,
                    /*fixed_ram_budget=*/1000,
                    /*model_input_time=*/50, ram_budget_manager,
@@ -2973,7 +3040,7 @@ TEST_F(ModelTimingTest, OptimizeStageBased_TwoStages_RamBudgetExceeded) {
   CancellationManager cancellation_manager;
   RamBudgetManager ram_budget_manager(0);
   // Not enough RAM, the original `parallelism` should not change.
-  model_->Optimize(AutotuneAlgorithm::STAGE_BASED, CpuBudgetFunc(10),
+  model_->Optimize(AutotuneAlgorithm::STAGE_BASED, CpuBudgetFunc(40),
                    /*ram_budget_share=*/1.0,
                    /*fixed_ram_budget=*/0,
                    /*model_input_time=*/100, ram_budget_manager,
@@ -2984,7 +3051,7 @@ TEST_F(ModelTimingTest, OptimizeStageBased_TwoStages_RamBudgetExceeded) {
                 "ram_budget_exceeded:ParallelMapV2[]_Arbitrary[]_Stuff(id:2)"),
             1);
   // Has enough RAM, the original `parallelism` should increase.
-  model_->Optimize(AutotuneAlgorithm::STAGE_BASED, CpuBudgetFunc(10),
+  model_->Optimize(AutotuneAlgorithm::STAGE_BASED, CpuBudgetFunc(40),
                    /*ram_budget_share=*/1.0,
                    /*fixed_ram_budget=*/100000,
                    /*model_input_time=*/0, ram_budget_manager,
@@ -2996,7 +3063,7 @@ TEST_F(ModelTimingTest, OptimizeStageBased_TwoStages_RamBudgetExceeded) {
           "parameter_max_exceeded:ParallelMapV2[]_Arbitrary[]_Stuff(id:2)"),
       1);
   // Not enough RAM, the original `parallelism` should not change.
-  model_->Optimize(AutotuneAlgorithm::STAGE_BASED, CpuBudgetFunc(10),
+  model_->Optimize(AutotuneAlgorithm::STAGE_BASED, CpuBudgetFunc(40),
                    /*ram_budget_share=*/1.0,
                    /*fixed_ram_budget=*/100,
                    /*model_input_time=*/0, ram_budget_manager,
@@ -3548,6 +3615,26 @@ TEST(RamBudgetManagerTest, RequestAllocationsWithBudgetAdjustment) {
   EXPECT_TRUE(rbm.RequestLegacyPrefetchBytes(4));
 }
 
+TEST(RamBudgetManagerTest, HardLimitBufferedBytes) {
+  RamBudgetManager rbm(10);
+  // Without a hard limit the buffered-bytes ledger never stalls producers.
+  rbm.RecordBufferedBytes(20);
+  EXPECT_EQ(rbm.TotalBufferedBytes(), 20);
+  EXPECT_FALSE(rbm.ShouldStallProducer());
+  rbm.MarkBudgetAsHardLimit();
+  EXPECT_TRUE(rbm.IsBudgetHardLimit());
+  EXPECT_TRUE(rbm.ShouldStallProducer());
+  // Dequeues release budget.
+  rbm.RecordBufferedBytes(-15);
+  EXPECT_EQ(rbm.TotalBufferedBytes(), 5);
+  EXPECT_FALSE(rbm.ShouldStallProducer());
+  // Raising the budget also unblocks producers.
+  rbm.RecordBufferedBytes(15);
+  EXPECT_TRUE(rbm.ShouldStallProducer());
+  rbm.UpdateBudget(30);
+  EXPECT_FALSE(rbm.ShouldStallProducer());
+}
+
 }  // namespace
 }  // namespace model
 }  // namespace data
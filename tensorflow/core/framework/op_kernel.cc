@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "tensorflow/core/framework/op_kernel.h"
 
+#include <atomic>
 #include <cstdlib>
 #include <cstring>
 #include <mutex>  // NOLINT
@@ -377,6 +378,11 @@ Allocator* OpKernelContext::get_allocator(AllocatorAttributes attr) {
   if (TF_PREDICT_FALSE(attr.scope_id > 0)) {
     allocator = params_->device->GetScopedAllocator(attr, step_id());
     CHECK(allocator);
+  } else if (params_->small_tensor_arena != nullptr && attr.value == 0) {
+    // Route default-attribute allocations through the per-step arena; the
+    // arena itself delegates anything larger than its small-tensor threshold
+    // to the device allocator.
+    allocator = params_->small_tensor_arena;
   } else {
     allocator = params_->device->GetAllocator(attr);
   }
@@ -1154,6 +1160,9 @@ struct KernelRegistry {
   mutex mu;
   std::unordered_multimap<string, KernelRegistration> registry
       TF_GUARDED_BY(mu);
+  // Set when the registry is frozen (see kFrozenKernelRegistryEnvVar). Once
+  // frozen, the registry is immutable and lookups skip `mu` entirely.
+  std::atomic<bool> frozen{false};
 };
 
 #if defined(_WIN32)
@@ -1255,6 +1264,29 @@ static string Key(StringPiece op_type, const DeviceType& device_type,
                          label);
 }
 
+// When this environment variable is set to "1", the kernel registry is frozen
+// the first time a kernel is looked up: the dispatch table is rehashed to a
+// low load factor so lookups are a single hash and (almost always) a single
+// key compare, and subsequent lookups skip the registration mutex entirely.
+// Intended for serving binaries, where all kernels are linked in and no
+// registrations happen after startup; registering a kernel after the freeze
+// is a fatal error.
+constexpr char kFrozenKernelRegistryEnvVar[] = "TF_KERNEL_REGISTRY_FROZEN";
+
+void MaybeFreezeRegistry(KernelRegistry* registry) {
+  if (!absl::StrContains(
+          absl::NullSafeStringView(getenv(kFrozenKernelRegistryEnvVar)), "1")) {
+    return;
+  }
+  mutex_lock l(registry->mu);
+  // Shorten collision chains before making the table read-only. With the
+  // static initializers and any dynamic kernel libraries already run, this is
+  // the last time the table is touched.
+  registry->registry.max_load_factor(0.5);
+  registry->registry.rehash(registry->registry.size() * 2);
+  registry->frozen.store(true, std::memory_order_release);
+}
+
 // Provide a way for users to disable JIT kernels for a transitional period.
 // Until this is removed, this function also removes the JIT label that is added
 // to JIT kernels during the static registration, to allow them to be found
@@ -1322,6 +1354,10 @@ static KernelRegistry* GlobalKernelRegistryTyped() {
   // temporary fallback as part of the initial release of JIT kernels.
   static absl::once_flag setup_or_disable_jit;
   absl::call_once(setup_or_disable_jit, SetupOrDisableJit, registry);
+  // The first lookup acts as registry finalization: in frozen mode, no
+  // registrations may arrive past this point.
+  static absl::once_flag freeze_registry;
+  absl::call_once(freeze_registry, MaybeFreezeRegistry, registry);
   return registry;
 }
 
@@ -1344,6 +1380,15 @@ void OpKernelRegistrar::InitInternal(const KernelDef* kernel_def,
   auto global_registry =
       reinterpret_cast<KernelRegistry*>(GlobalKernelRegistry());
   mutex_lock l(global_registry->mu);
+  if (global_registry->frozen.load(std::memory_order_acquire)) {
+    // Lock-free readers may be scanning the table concurrently; mutating it
+    // now would be a data race, so a late registration cannot be honored.
+    LOG(FATAL) << "OpKernel registration for '" << kernel_def->op()  // Crash OK
+               << "' arrived after the kernel registry was frozen ("
+               << kFrozenKernelRegistryEnvVar
+               << " is set). Link all kernels into the binary or unset the "
+                  "frozen-registry mode.";
+  }
   global_registry->registry.emplace(
       key,
       KernelRegistration(*kernel_def, kernel_class_name, std::move(factory)));
@@ -1381,7 +1426,7 @@ Status FindKernelRegistration(
     bool has_experimental_debug_info,
     const NodeDef_ExperimentalDebugInfo& experimental_debug_info,
     StringPiece node_op, AttrSlice node_attrs, const KernelRegistration** reg,
-    bool* was_attr_mismatch) {
+    bool* was_attr_mismatch) TF_NO_THREAD_SAFETY_ANALYSIS {
   *reg = nullptr;
   *was_attr_mismatch = false;
 
@@ -1389,7 +1434,11 @@ Status FindKernelRegistration(
 
   const string key = Key(node_op, device_type, label);
   auto typed_registry = GlobalKernelRegistryTyped();
-  tf_shared_lock lock(typed_registry->mu);
+  // A frozen registry is immutable, so the mutex can be skipped on lookup.
+  absl::optional<tf_shared_lock> lock;
+  if (!typed_registry->frozen.load(std::memory_order_acquire)) {
+    lock.emplace(typed_registry->mu);
+  }
   auto regs = typed_registry->registry.equal_range(key);
   for (auto iter = regs.first; iter != regs.second; ++iter) {
     // If there is a kernel registered for the op and device_type,
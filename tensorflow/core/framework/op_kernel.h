@@ -629,6 +629,11 @@ class OpKernelContext {
     // stored in this container..
     ScopedStepContainer* step_container = nullptr;
 
+    // If non-null, a per-step arena that small host allocations with default
+    // allocator attributes are served from instead of the device allocator.
+    // Not owned; reset wholesale by the executor at the end of the step.
+    Allocator* small_tensor_arena = nullptr;
+
     // Mechanism used by this op kernel invocation to communicate with
     // computations running on other devices.
     RendezvousInterface* rendezvous = nullptr;
@@ -738,6 +743,13 @@ class OpKernelContext {
   // TODO(mrry): Convert this to return Status.
   const Tensor& input(int index) const;
 
+  // Like input(), but validates its argument only in debug builds. The input
+  // slots are resolved by the executor before Compute() runs, so this is a
+  // direct indexed load. Intended for kernels whose Compute() is short enough
+  // that the CHECKs in input() show up in profiles.
+  // REQUIRES: 0 <= index < num_inputs() && !IsRefType(input_dtype(index))
+  const Tensor& input_unchecked(int index) const;
+
   // Returns an immutable input tensor in "tensor" by index. May only be used
   // for non-Ref inputs. For Ref inputs use mutable_input below.
   // REQUIRES: !IsRefType(input_dtype(index))
@@ -1022,6 +1034,14 @@ class OpKernelContext {
   void set_output(int index, const Tensor& tensor);
   void set_output(int index, Tensor&& tensor);
 
+  // Like set_output(int, Tensor&&), but validates its arguments only in debug
+  // builds. Intended for kernels whose Compute() is short enough that the
+  // CHECKs in set_output() show up in profiles.
+  // REQUIRES: 0 <= index < num_outputs() &&
+  //           !IsRefType(expected_output_dtype(index)) &&
+  //           set_output()/allocate_output() not already called for 'index'
+  void set_output_unchecked(int index, Tensor&& tensor);
+
   // To output a reference.  Caller retains ownership of mu and tensor_for_ref,
   // and they must outlive all uses within the step. See comment above.
   // REQUIRES: IsRefType(expected_output_dtype(index))
@@ -1603,6 +1623,25 @@ inline MemoryType OpKernelContext::output_memory_type(int index) const {
   return op_kernel().output_memory_types()[index];
 }
 
+inline const Tensor& OpKernelContext::input_unchecked(int index) const {
+  DCHECK_GE(index, 0);
+  DCHECK_LT(index, num_inputs());
+  DCHECK(!input_is_ref(index));
+  return *params_->inputs[index].tensor;
+}
+
+inline void OpKernelContext::set_output_unchecked(int index, Tensor&& tensor) {
+  DCHECK_GE(index, 0);
+  DCHECK_LT(index, num_outputs());
+  DCHECK(!IsRefType(params_->op_kernel->output_type(index)));
+  DCHECK_EQ(outputs_[index].tensor, nullptr);
+  if (TF_PREDICT_TRUE(!maybe_set_output_by_allocate_and_copy(index, tensor))) {
+    // Input can be forwarded to output; set output at `index` to this tensor.
+    outputs_[index] = TensorValue(new Tensor(std::move(tensor)));
+    maybe_track_allocations_for_set_output(*outputs_[index].tensor);
+  }
+}
+
 inline bool OpKernelContext::input_is_ref(int index) const {
   const TensorValue& value(params_->inputs[index]);
   return value.is_ref();
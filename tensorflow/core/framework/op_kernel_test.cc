@@ -524,6 +524,36 @@ TEST_F(OpKernelTest, AllocateOutput) {
   EXPECT_THAT(s.message(), ::testing::ContainsRegex("bad index=1"));
 }
 
+TEST_F(OpKernelTest, UncheckedAccessors) {
+  Env* env = Env::Default();
+  OpKernelContext::Params params;
+  DummyDevice device(env);
+  params.device = &device;
+  Status status;
+  std::unique_ptr<OpKernel> op(
+      CreateOpKernel(DEVICE_CPU, params.device, cpu_allocator(),
+                     CreateNodeDef("Test1", {DT_FLOAT, DT_INT32}),
+                     TF_GRAPH_DEF_VERSION, &status));
+  EXPECT_TRUE(status.ok());
+  params.op_kernel = op.get();
+  Tensor a(DT_FLOAT, TensorShape({}));
+  a.scalar<float>()() = 42.0f;
+  Tensor b(DT_INT32, TensorShape({}));
+  gtl::InlinedVector<TensorValue, 4> inputs{TensorValue(&a), TensorValue(&b)};
+  params.inputs = inputs;
+  auto ctx = std::make_unique<OpKernelContext>(&params);
+
+  // input_unchecked() resolves to the same tensors as input().
+  EXPECT_EQ(ctx->input_unchecked(0).scalar<float>()(), 42.0f);
+  EXPECT_EQ(ctx->input_unchecked(1).dtype(), DT_INT32);
+
+  Tensor out(DT_FLOAT, TensorShape({}));
+  out.scalar<float>()() = 7.0f;
+  ctx->set_output_unchecked(0, std::move(out));
+  ASSERT_NE(ctx->mutable_output(0), nullptr);
+  EXPECT_EQ(ctx->mutable_output(0)->scalar<float>()(), 7.0f);
+}
+
 // A mock device that mimics the behavior of scoped allocator upon calling
 // GetAllocator with a positive scope_id.
 class ScopedAllocatorDevice : public DeviceBase {
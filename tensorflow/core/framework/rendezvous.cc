@@ -47,9 +47,17 @@ Rendezvous::ParsedKey& Rendezvous::ParsedKey::operator=(const ParsedKey& b) {
   dst = b.dst;
   edge_name = StringPiece(buf_.data() + (b.edge_name.data() - b_base),
                           b.edge_name.size());
+  hash_ = b.hash_;
   return *this;
 }
 
+uint64 Rendezvous::ParsedKey::FullKeyHash() const {
+  if (hash_ == 0) {
+    hash_ = Hash64(buf_.data(), buf_.size());
+  }
+  return hash_;
+}
+
 /*  static */
 string Rendezvous::CreateKey(const string& src_device, uint64 src_incarnation,
                              const string& dst_device, const string& name,
@@ -86,6 +94,9 @@ static StringPiece ConsumeNextPart(StringPiece* s, char delim) {
 
 /* static */
 Status Rendezvous::ParseKey(StringPiece key, ParsedKey* out) {
+  // The key contents may have changed even when the caller reused buf_
+  // directly, so the cached hash is invalid either way.
+  out->hash_ = 0;
   if (key.data() == out->buf_.data()) {
     // Caller used our buf_ string directly, so we don't need to copy.  (The
     // SendOp and RecvOp implementations do this, for example).
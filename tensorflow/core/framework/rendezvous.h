@@ -71,11 +71,17 @@ class RendezvousInterface {
     ParsedKey& operator=(const ParsedKey& b);
     StringPiece FullKey() const { return buf_; }
 
+    // Hash of FullKey(), computed lazily and then cached. Rendezvous
+    // implementations that hash the key on every Send/Recv use this to
+    // avoid re-hashing a key that is parsed once and reused many times.
+    uint64 FullKeyHash() const;
+
    private:
     friend class Rendezvous;
     friend class SendOp;
     friend class RecvOp;
     std::string buf_;
+    mutable uint64 hash_ = 0;  // 0 means "not computed yet".
   };
 
   // The caller is a tensor producer and it sends a message (a tensor
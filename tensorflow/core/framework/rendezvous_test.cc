@@ -126,6 +126,19 @@ TEST_F(LocalRendezvousTest, SendRecv) {
   EXPECT_EQ("hello", V(val));
 }
 
+// Covers the recycling of Item storage: after the first exchange every
+// send/recv pair should run entirely on the rendezvous' freelist.
+TEST_F(LocalRendezvousTest, RepeatedSendRecv) {
+  Rendezvous::Args args;
+  for (int i = 0; i < 1000; ++i) {
+    TF_ASSERT_OK(rendez_->Send(KeyFoo(), args, V(strings::StrCat(i)), false));
+    Tensor val(DT_STRING);
+    bool is_dead = false;
+    TF_ASSERT_OK(rendez_->Recv(KeyFoo(), args, &val, &is_dead));
+    EXPECT_EQ(strings::StrCat(i), V(val));
+  }
+}
+
 TEST_F(LocalRendezvousTest, RecvSend) {
   SchedClosure([this]() {
     Env::Default()->SleepForMicroseconds(10000);
@@ -356,6 +369,64 @@ TEST_F(LocalRendezvousTest, MultiSends) {
   }
 }
 
+// Two sends queued on one key must be received in the order they were sent,
+// even when the first send was forced into the table by an unrelated pending
+// recv and the second send arrives after that recv completed. The default
+// rendezvous has a single bucket, so KeyFoo and KeyBar deterministically
+// share the bucket state that gates the lock-free send slot.
+TEST_F(LocalRendezvousTest, SendsStayOrderedAfterUnrelatedRecv) {
+  Rendezvous::Args args;
+  Notification bar_received;
+  rendez_->RecvAsync(
+      KeyBar(), args,
+      [&bar_received](const Status& s, const Rendezvous::Args&,
+                      const Rendezvous::Args&, const Tensor&, bool) {
+        TF_ASSERT_OK(s);
+        bar_received.Notify();
+      });
+  // The pending KeyBar recv forces this send onto the locked table path.
+  TF_ASSERT_OK(rendez_->Send(KeyFoo(), args, V("first"), false));
+  TF_ASSERT_OK(rendez_->Send(KeyBar(), args, V("bar"), false));
+  bar_received.WaitForNotification();
+  // With no recv in flight anymore, this send is eligible for the lock-free
+  // slot; it must still line up behind the older send queued in the table.
+  TF_ASSERT_OK(rendez_->Send(KeyFoo(), args, V("second"), false));
+  Tensor val(DT_STRING);
+  bool is_dead = false;
+  TF_ASSERT_OK(rendez_->Recv(KeyFoo(), args, &val, &is_dead));
+  EXPECT_EQ("first", V(val));
+  TF_ASSERT_OK(rendez_->Recv(KeyFoo(), args, &val, &is_dead));
+  EXPECT_EQ("second", V(val));
+}
+
+// A recv for one key must not disturb a send parked in the lock-free slot for
+// another key: the parked send stays claimable in order, ahead of any younger
+// same-key send that the pending recv forces into the table. As above, the
+// single-bucket default rendezvous makes the interleaving deterministic.
+TEST_F(LocalRendezvousTest, MismatchedRecvLeavesParkedSendInPlace) {
+  Rendezvous::Args args;
+  // No recv in flight and an empty table: this send parks in the slot.
+  TF_ASSERT_OK(rendez_->Send(KeyFoo(), args, V("first"), false));
+  Notification bar_received;
+  rendez_->RecvAsync(
+      KeyBar(), args,
+      [&bar_received](const Status& s, const Rendezvous::Args&,
+                      const Rendezvous::Args&, const Tensor&, bool) {
+        TF_ASSERT_OK(s);
+        bar_received.Notify();
+      });
+  // The pending KeyBar recv forces this send onto the locked table path.
+  TF_ASSERT_OK(rendez_->Send(KeyFoo(), args, V("second"), false));
+  Tensor val(DT_STRING);
+  bool is_dead = false;
+  TF_ASSERT_OK(rendez_->Recv(KeyFoo(), args, &val, &is_dead));
+  EXPECT_EQ("first", V(val));
+  TF_ASSERT_OK(rendez_->Recv(KeyFoo(), args, &val, &is_dead));
+  EXPECT_EQ("second", V(val));
+  TF_ASSERT_OK(rendez_->Send(KeyBar(), args, V("bar"), false));
+  bar_received.WaitForNotification();
+}
+
 TEST_F(LocalRendezvousTest, RecvAbort) {
   rendez_->Ref();
   SchedClosure([this]() {
@@ -16,6 +16,8 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_FRAMEWORK_RESOURCE_HANDLE_H_
 #define TENSORFLOW_CORE_FRAMEWORK_RESOURCE_HANDLE_H_
 
+#include <atomic>
+#include <memory>
 #include <string>
 
 #include "tensorflow/core/framework/resource_base.h"
@@ -24,6 +26,7 @@ limitations under the License.
 #include "tensorflow/core/framework/types.pb.h"
 #include "tensorflow/core/platform/casts.h"
 #include "tensorflow/core/platform/intrusive_ptr.h"
+#include "tensorflow/core/platform/refcount.h"
 #include "tensorflow/core/platform/statusor.h"
 #include "tensorflow/core/platform/tensor_coding.h"
 #include "tensorflow/core/platform/types.h"
@@ -58,16 +61,25 @@ class ResourceHandle {
 
   // Container in which this resource is placed.
   const std::string& container() const { return container_; }
-  void set_container(const std::string& container) { container_ = container; }
+  void set_container(const std::string& container) {
+    container_ = container;
+    ResetMgrLookupCache();
+  }
 
   // Unique name of this resource.
   const std::string& name() const { return name_; }
-  void set_name(const std::string& name) { name_ = name; }
+  void set_name(const std::string& name) {
+    name_ = name;
+    ResetMgrLookupCache();
+  }
 
   // Hash code for the type of the resource. Is only valid in the same device
   // and in the same execution.
   uint64 hash_code() const { return hash_code_; }
-  void set_hash_code(uint64 hash_code) { hash_code_ = hash_code; }
+  void set_hash_code(uint64 hash_code) {
+    hash_code_ = hash_code;
+    ResetMgrLookupCache();
+  }
 
   // For debug-only, the name of the type pointed to by this handle, if
   // available.
@@ -173,7 +185,35 @@ class ResourceHandle {
   // Generates unique IDs (e.g. for names of anonymous variables)
   static int64_t GenerateUniqueId();
 
+  // Transient memo of the last successful `ResourceMgr` lookup through this
+  // handle, maintained by `ResourceMgr` so that repeated lookups of the same
+  // resource can bypass its lock and maps. Copies of a handle share the memo;
+  // it is never serialized. See `ResourceMgr::Lookup(const ResourceHandle&)`.
+  struct MgrLookupCache {
+    enum State : int { kEmpty = 0, kFilling = 1, kFilled = 2 };
+    // Transitions kEmpty -> kFilling -> kFilled at most once. The fields
+    // below are written before the transition to kFilled and are immutable
+    // afterwards.
+    std::atomic<int> state{kEmpty};
+    // Hash code of the resource type the memo was filled for.
+    uint64 type_hash_code = 0;
+    // Value of the resource manager's removal generation when the memo was
+    // filled; a mismatch means the memo may be stale.
+    int64_t generation = 0;
+    core::WeakPtr<ResourceBase> resource;
+  };
+  MgrLookupCache* mgr_lookup_cache() const { return mgr_lookup_cache_.get(); }
+
  private:
+  // Drops any memoized lookup result when a field that identifies the
+  // resource changes.
+  void ResetMgrLookupCache() {
+    if (mgr_lookup_cache_->state.load(std::memory_order_acquire) !=
+        MgrLookupCache::kEmpty) {
+      mgr_lookup_cache_ = std::make_shared<MgrLookupCache>();
+    }
+  }
+
   std::string device_;
   std::string container_;
   std::string name_;
@@ -186,6 +226,8 @@ class ResourceHandle {
   // a "weak-ref" mode, only containing the name of the resource (conceptually a
   // weak reference).
   core::IntrusivePtr<ResourceBase> resource_;
+  std::shared_ptr<MgrLookupCache> mgr_lookup_cache_ =
+      std::make_shared<MgrLookupCache>();
   static std::atomic<int64_t> current_id_;
 };
 
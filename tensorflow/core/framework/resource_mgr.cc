@@ -143,6 +143,7 @@ void ResourceMgr::Clear() {
     mutex_lock l(mu_);
     tmp_containers = std::move(containers_);
     containers_.clear();  // reinitialize after move.
+    removal_generation_.fetch_add(1, std::memory_order_acq_rel);
   }
   for (const auto& p : tmp_containers) {
     delete p.second;
@@ -225,9 +226,57 @@ Status ResourceMgr::DoCreate(const string& container_name, TypeIndex type,
 
 Status ResourceMgr::Lookup(const ResourceHandle& handle,
                            ResourceBase** resource) const {
-  tf_shared_lock l(mu_);
-  return DoLookup(handle.container(), handle.hash_code(),
-                  /*type_name=*/"ResourceBase", handle.name(), resource);
+  if (core::RefCountPtr<ResourceBase> cached =
+          LookupFromCache(handle, handle.hash_code())) {
+    *resource = cached.release();
+    return OkStatus();
+  }
+  const int64_t generation =
+      removal_generation_.load(std::memory_order_acquire);
+  {
+    tf_shared_lock l(mu_);
+    TF_RETURN_IF_ERROR(DoLookup(handle.container(), handle.hash_code(),
+                                /*type_name=*/"ResourceBase", handle.name(),
+                                resource));
+  }
+  FillLookupCache(handle, handle.hash_code(), generation, *resource);
+  return OkStatus();
+}
+
+core::RefCountPtr<ResourceBase> ResourceMgr::LookupFromCache(
+    const ResourceHandle& handle, uint64 type_hash_code) const {
+  ResourceHandle::MgrLookupCache* cache = handle.mgr_lookup_cache();
+  if (cache == nullptr ||
+      cache->state.load(std::memory_order_acquire) !=
+          ResourceHandle::MgrLookupCache::kFilled ||
+      cache->type_hash_code != type_hash_code ||
+      cache->generation !=
+          removal_generation_.load(std::memory_order_acquire)) {
+    return nullptr;
+  }
+  // The weak reference guarantees that a destroyed resource is never
+  // returned, even if the memo went stale without a generation bump (e.g. an
+  // unowned resource that expired).
+  return cache->resource.GetNewRef();
+}
+
+void ResourceMgr::FillLookupCache(const ResourceHandle& handle,
+                                  uint64 type_hash_code, int64_t generation,
+                                  ResourceBase* resource) const {
+  ResourceHandle::MgrLookupCache* cache = handle.mgr_lookup_cache();
+  if (cache == nullptr) return;
+  int expected = ResourceHandle::MgrLookupCache::kEmpty;
+  if (!cache->state.compare_exchange_strong(
+          expected, ResourceHandle::MgrLookupCache::kFilling,
+          std::memory_order_acq_rel)) {
+    // Already filled (possibly stale) or being filled by another thread.
+    return;
+  }
+  cache->type_hash_code = type_hash_code;
+  cache->generation = generation;
+  cache->resource = core::WeakPtr<ResourceBase>(resource);
+  cache->state.store(ResourceHandle::MgrLookupCache::kFilled,
+                     std::memory_order_release);
 }
 
 Status ResourceMgr::DoLookup(const string& container, TypeIndex type,
@@ -277,6 +326,7 @@ Status ResourceMgr::PopResourceAndName(const string& container,
   }
   std::swap(resource_and_name, iter->second);
   b->erase(iter);
+  removal_generation_.fetch_add(1, std::memory_order_acq_rel);
   return OkStatus();
 }
 
@@ -326,6 +376,7 @@ Status ResourceMgr::Cleanup(const string& container) {
     }
     b = iter->second;
     containers_.erase(iter);
+    removal_generation_.fetch_add(1, std::memory_order_acq_rel);
   }
   CHECK(b != nullptr);
   delete b;
@@ -16,6 +16,7 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_FRAMEWORK_RESOURCE_MGR_H_
 #define TENSORFLOW_CORE_FRAMEWORK_RESOURCE_MGR_H_
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <typeindex>
@@ -194,6 +195,18 @@ class ResourceMgr {
   Status Lookup(const ResourceHandle& handle,
                 ResourceBase** resource) const TF_MUST_USE_RESULT;
 
+  // Variant of the typed Lookup above that memoizes the result in "handle",
+  // so that repeated lookups of the same resource through the same handle (or
+  // copies of it) bypass the lock and the maps entirely. The memo is a weak
+  // reference validated against a removal generation counter, so a resource
+  // that has been deleted or replaced is never returned from it.
+  //
+  // REQUIRES: std::is_base_of<ResourceBase, T>
+  // REQUIRES: resource != nullptr
+  template <typename T, bool use_dynamic_cast = false>
+  Status Lookup(const ResourceHandle& handle,
+                T** resource) const TF_MUST_USE_RESULT;
+
   // Similar to Lookup, but looks up multiple resources at once, with only a
   // single lock acquisition.  If containers_and_names[i] is uninitialized
   // then this function does not modify resources[i].
@@ -275,6 +288,10 @@ class ResourceMgr {
   const std::string default_container_;
   mutable mutex mu_;
   absl::flat_hash_map<string, Container*> containers_ TF_GUARDED_BY(mu_);
+  // Incremented whenever a resource is removed from the maps (Delete, Cleanup
+  // or Clear). Lookup memos recorded in resource handles are only trusted
+  // while the generation they were filled under is still current.
+  std::atomic<int64_t> removal_generation_{1};
 
   template <typename T, bool use_dynamic_cast = false>
   Status LookupInternal(const std::string& container, const std::string& name,
@@ -284,6 +301,19 @@ class ResourceMgr {
                         const std::string& name, ResourceBase** resource) const
       TF_SHARED_LOCKS_REQUIRED(mu_) TF_MUST_USE_RESULT;
 
+  // Returns a new reference to the resource memoized in "handle" for the type
+  // with "type_hash_code", or nullptr if the memo is empty, is for a
+  // different type, may be stale, or refers to a destroyed resource.
+  core::RefCountPtr<ResourceBase> LookupFromCache(const ResourceHandle& handle,
+                                                  uint64 type_hash_code) const;
+
+  // Memoizes in "handle" that looking it up for the type with
+  // "type_hash_code" found "resource", where "generation" is the removal
+  // generation read before the lookup. A handle is filled at most once; later
+  // calls are no-ops.
+  void FillLookupCache(const ResourceHandle& handle, uint64 type_hash_code,
+                       int64_t generation, ResourceBase* resource) const;
+
   Status DoCreate(const std::string& container, TypeIndex type,
                   const std::string& name, ResourceBase* resource,
                   bool owns_resource)
@@ -707,6 +737,29 @@ Status ResourceMgr::LookupInternal(const std::string& container,
   return s;
 }
 
+template <typename T, bool use_dynamic_cast>
+Status ResourceMgr::Lookup(const ResourceHandle& handle, T** resource) const {
+  CheckDeriveFromResourceBase<T>();
+  const uint64 type_hash_code = TypeIndex::Make<T>().hash_code();
+  if (core::RefCountPtr<ResourceBase> cached =
+          LookupFromCache(handle, type_hash_code)) {
+    T* cast = TypeCastFunctor<T, use_dynamic_cast>::Cast(cached.get());
+    if (cast != nullptr) {
+      cached.release();
+      *resource = cast;
+      return OkStatus();
+    }
+  }
+  // Read the generation before the lookup, so that a removal racing with the
+  // lookup leaves the memo stale rather than wrong.
+  const int64_t generation =
+      removal_generation_.load(std::memory_order_acquire);
+  TF_RETURN_IF_ERROR((Lookup<T, use_dynamic_cast>(handle.container(),
+                                                  handle.name(), resource)));
+  FillLookupCache(handle, type_hash_code, generation, *resource);
+  return OkStatus();
+}
+
 template <typename T, bool use_dynamic_cast>
 Status ResourceMgr::LookupOrCreate(const std::string& container,
                                    const std::string& name, T** resource,
@@ -806,8 +859,7 @@ Status LookupResource(OpKernelContext* ctx, const ResourceHandle& p,
     return OkStatus();
   }
 
-  return ctx->resource_manager()->Lookup<T, use_dynamic_cast>(p.container(),
-                                                              p.name(), value);
+  return ctx->resource_manager()->Lookup<T, use_dynamic_cast>(p, value);
 }
 
 // Finds the resource as "*value" from the handle. This is a type-erased
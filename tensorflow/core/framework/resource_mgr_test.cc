@@ -144,6 +144,57 @@ TEST(ResourceMgrTest, Basic) {
   TF_CHECK_OK(rm.Cleanup("bar"));
 }
 
+TEST(ResourceMgrTest, CachedLookupByHandle) {
+  ResourceMgr rm;
+  TF_CHECK_OK(rm.Create("foo", "bar", new Resource("cat")));
+
+  ResourceHandle handle;
+  handle.set_container("foo");
+  handle.set_name("bar");
+  handle.set_hash_code(TypeIndex::Make<Resource>().hash_code());
+
+  // The first lookup fills the handle's memo; the second one is served from
+  // it. Both must return the same resource.
+  Resource* first = nullptr;
+  TF_CHECK_OK(rm.Lookup(handle, &first));
+  Resource* second = nullptr;
+  TF_CHECK_OK(rm.Lookup(handle, &second));
+  EXPECT_EQ(first, second);
+  EXPECT_EQ("R/cat", second->DebugString());
+  first->Unref();
+  second->Unref();
+
+  // A copy of the handle shares the memo.
+  ResourceHandle copy = handle;
+  Resource* from_copy = nullptr;
+  TF_CHECK_OK(rm.Lookup(copy, &from_copy));
+  EXPECT_EQ("R/cat", from_copy->DebugString());
+  from_copy->Unref();
+
+  // Deleting the resource must invalidate the memo.
+  TF_CHECK_OK(rm.Delete<Resource>("foo", "bar"));
+  Resource* gone = nullptr;
+  HasError(rm.Lookup(handle, &gone), error::NOT_FOUND, "Resource foo/bar");
+
+  // Re-creating the resource under the same name must make lookups through
+  // the same handle see the new resource, not the memoized one.
+  TF_CHECK_OK(rm.Create("foo", "bar", new Resource("kitty")));
+  Resource* recreated = nullptr;
+  TF_CHECK_OK(rm.Lookup(handle, &recreated));
+  EXPECT_EQ("R/kitty", recreated->DebugString());
+  recreated->Unref();
+
+  // The untyped lookup keyed by the handle's hash code also works.
+  ResourceBase* untyped = nullptr;
+  TF_CHECK_OK(rm.Lookup(handle, &untyped));
+  EXPECT_EQ("R/kitty", untyped->DebugString());
+  untyped->Unref();
+
+  // Mutating a field that identifies the resource drops the memo.
+  handle.set_name("other");
+  HasError(rm.Lookup(handle, &gone), error::NOT_FOUND, "Resource foo/other");
+}
+
 TEST(ResourceMgrTest, CreateUnowned) {
   core::RefCountPtr<Resource> cat{new Resource("cat")};
   core::RefCountPtr<Resource> kitty{new Resource("kitty")};
@@ -421,27 +421,32 @@ void RunHandlerThreadPool::SetThreadWorkSources(
           thread_work_sources[i]);
     }
   } else {
-    thread_data_[tid].new_thread_work_sources->emplace_back(
-        thread_work_sources[start_request_idx]);
-    // The number of shards for the queue. Threads in each shard will
-    // prioritize different thread_work_sources. Increase the number of shards
-    // could decrease the contention in the queue. For example, when
-    // num_shards == 1: thread_work_sources are ordered as start_request_idx,
-    // 0, 1, 2, 3, 4 ... for all threads. When num_shards == 2:
-    // thread_work_sources are order as start_request_idx, 0, 2, 4 ... 1, 3,
-    // 5... for half of the threads and start_request_idx, 1, 3, 5 ... 0, 2,
-    // 4... for the other half of the threads.
-    static const int num_shards =
-        ParamFromEnvWithDefault("TF_RUN_HANDLER_QUEUE_SHARDS", 1);
-    int token = tid % num_shards;
-    for (int i = 0; i < num_shards; ++i) {
-      for (int j = token; j < thread_work_sources.size(); j += num_shards) {
-        if (j != start_request_idx) {
-          thread_data_[tid].new_thread_work_sources->emplace_back(
-              thread_work_sources[j]);
+    // The list may be empty for a thread that is reserved for a priority
+    // class with no active requests; the thread then waits until a new
+    // version assigns it work.
+    if (!thread_work_sources.empty()) {
+      thread_data_[tid].new_thread_work_sources->emplace_back(
+          thread_work_sources[start_request_idx]);
+      // The number of shards for the queue. Threads in each shard will
+      // prioritize different thread_work_sources. Increase the number of
+      // shards could decrease the contention in the queue. For example, when
+      // num_shards == 1: thread_work_sources are ordered as start_request_idx,
+      // 0, 1, 2, 3, 4 ... for all threads. When num_shards == 2:
+      // thread_work_sources are order as start_request_idx, 0, 2, 4 ... 1, 3,
+      // 5... for half of the threads and start_request_idx, 1, 3, 5 ... 0, 2,
+      // 4... for the other half of the threads.
+      static const int num_shards =
+          ParamFromEnvWithDefault("TF_RUN_HANDLER_QUEUE_SHARDS", 1);
+      int token = tid % num_shards;
+      for (int i = 0; i < num_shards; ++i) {
+        for (int j = token; j < thread_work_sources.size(); j += num_shards) {
+          if (j != start_request_idx) {
+            thread_data_[tid].new_thread_work_sources->emplace_back(
+                thread_work_sources[j]);
+          }
         }
+        token = (token + 1) % num_shards;
       }
-      token = (token + 1) % num_shards;
     }
     thread_data_[tid].sources_not_empty.notify_all();
   }
@@ -778,6 +783,11 @@ class RunHandlerPool::Impl {
   explicit Impl(int num_inter_op_threads, int num_intra_op_threads)
       : max_handlers_(static_cast<int32>(ParamFromEnvWithDefault(
             "TF_RUN_HANDLER_MAX_CONCURRENT_HANDLERS", kMaxConcurrentHandlers))),
+        high_priority_threshold_(static_cast<int64_t>(ParamFromEnvWithDefault(
+            "TF_RUN_HANDLER_HIGH_PRIORITY_THRESHOLD", 1))),
+        num_reserved_high_priority_threads_(
+            static_cast<int32>(ParamFromEnvWithDefault(
+                "TF_RUN_HANDLER_NUM_HIGH_PRIORITY_RESERVED_THREADS", 0))),
         waiters_mu_(
             ParamFromEnvWithDefault("TF_RUN_HANDLER_NUM_SUB_THREAD_POOL", 2)),
         queue_waiters_(
@@ -843,6 +853,7 @@ class RunHandlerPool::Impl {
                         kMaxConcurrentHandlers))));
     uint64 version;
     int num_active_requests;
+    int num_high_priority_requests = 0;
     RunHandler::Impl* handler_impl;
     {
       mutex_lock l(mu_);
@@ -885,11 +896,15 @@ class RunHandlerPool::Impl {
           --it;
         }
         (*thread_work_sources)[i] = (*it)->tws();
+        if ((*it)->priority() >= high_priority_threshold_) {
+          ++num_high_priority_requests;
+        }
         ++it;
       }
       version = ++version_;
     }
-    RecomputePoolStats(num_active_requests, version, *thread_work_sources);
+    RecomputePoolStats(num_active_requests, num_high_priority_requests, version,
+                       *thread_work_sources);
     return std::unique_ptr<RunHandler>(new RunHandler(handler_impl));
   }
 
@@ -936,7 +951,7 @@ class RunHandlerPool::Impl {
 
  private:
   void RecomputePoolStats(
-      int num_active_requests, uint64 version,
+      int num_active_requests, int num_high_priority_requests, uint64 version,
       const Eigen::MaxSizeVector<internal::ThreadWorkSource*>&
           thread_work_sources);
 
@@ -948,6 +963,14 @@ class RunHandlerPool::Impl {
   // inference).
   const int max_handlers_;
 
+  // Requests with priority at or above this threshold belong to the latency
+  // critical class and may run on the reserved threads below.
+  const int64_t high_priority_threshold_;
+
+  // Number of blocking threads that only serve the latency critical class.
+  // Zero (the default) disables the reservation.
+  const int num_reserved_high_priority_threads_;
+
   Eigen::MaxSizeVector<mutex> waiters_mu_;
   Eigen::MaxSizeVector<internal::Waiter> queue_waiters_;
 
@@ -972,7 +995,7 @@ class RunHandlerPool::Impl {
 };
 
 void RunHandlerPool::Impl::RecomputePoolStats(
-    int num_active_requests, uint64 version,
+    int num_active_requests, int num_high_priority_requests, uint64 version,
     const Eigen::MaxSizeVector<internal::ThreadWorkSource*>&
         thread_work_sources) {
   if (num_active_requests == 0) return;
@@ -995,13 +1018,45 @@ void RunHandlerPool::Impl::RecomputePoolStats(
   int num_blocking_threads = run_handler_thread_pool()->NumBlockingThreads();
   int num_non_blocking_threads = num_threads - num_blocking_threads;
 
+  // The first `num_reserved_threads` blocking threads only see the work
+  // sources of latency critical requests, which occupy the prefix of
+  // `thread_work_sources` since the active handlers are sorted by priority.
+  // Batch requests can thus never occupy all blocking threads at once. At
+  // least one blocking thread always serves every class so that low priority
+  // requests cannot starve.
+  int num_reserved_threads = 0;
+  if (num_reserved_high_priority_threads_ > 0 && num_blocking_threads > 1) {
+    num_reserved_threads = std::min(num_reserved_high_priority_threads_,
+                                    num_blocking_threads - 1);
+  }
+  if (num_reserved_threads > 0) {
+    Eigen::MaxSizeVector<internal::ThreadWorkSource*> high_priority_sources(
+        std::max(num_high_priority_requests, 1));
+    high_priority_sources.resize(num_high_priority_requests);
+    for (int i = 0; i < num_high_priority_requests; ++i) {
+      high_priority_sources[i] = thread_work_sources[i];
+    }
+    std::vector<int> reserved_idx_list(num_reserved_threads, 0);
+    if (num_high_priority_requests > 0) {
+      reserved_idx_list = ChooseRequestsWithExponentialDistribution(
+          num_high_priority_requests, num_reserved_threads);
+    }
+    for (int i = 0; i < num_reserved_threads; ++i) {
+      VLOG(2) << "Set high priority work for tid=" << i
+              << " with start_request_idx=" << reserved_idx_list[i];
+      run_handler_thread_pool()->SetThreadWorkSources(
+          i, reserved_idx_list[i], version, high_priority_sources);
+    }
+  }
+
   std::vector<int> request_idx_list = ChooseRequestsWithExponentialDistribution(
-      num_active_requests, num_blocking_threads);
-  for (int i = 0; i < num_blocking_threads; ++i) {
-    VLOG(2) << "Set work for tid=" << i
-            << " with start_request_idx=" << request_idx_list[i];
+      num_active_requests, num_blocking_threads - num_reserved_threads);
+  for (int i = num_reserved_threads; i < num_blocking_threads; ++i) {
+    VLOG(2) << "Set work for tid=" << i << " with start_request_idx="
+            << request_idx_list[i - num_reserved_threads];
     run_handler_thread_pool()->SetThreadWorkSources(
-        i, request_idx_list[i], version, thread_work_sources);
+        i, request_idx_list[i - num_reserved_threads], version,
+        thread_work_sources);
   }
 
   request_idx_list = ChooseRequestsWithExponentialDistribution(
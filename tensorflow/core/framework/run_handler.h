@@ -63,6 +63,14 @@ class RunHandlerPool {
   // unique_ptr is destroyed.
   //
   // Will block unless there is an inactive handler.
+  //
+  // 'options.priority()' determines the scheduling class of the request.
+  // Active handlers are served in priority order, and requests with priority
+  // at or above TF_RUN_HANDLER_HIGH_PRIORITY_THRESHOLD (default 1) are
+  // latency critical: when TF_RUN_HANDLER_NUM_HIGH_PRIORITY_RESERVED_THREADS
+  // (default 0) is set, that many inter-op threads only serve the latency
+  // critical class, so its tail latency does not degrade when lower priority
+  // batch requests share the pool.
   std::unique_ptr<RunHandler> Get(
       int64_t step_id = 0, int64_t timeout_in_ms = 0,
       const RunOptions::Experimental::RunHandlerPoolOptions& options =
@@ -31,6 +31,7 @@ limitations under the License.
 #include "tensorflow/core/lib/strings/strcat.h"
 #include "tensorflow/core/platform/blocking_counter.h"
 #include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/notification.h"
 #include "tensorflow/core/platform/logging.h"
 #include "tensorflow/core/platform/test.h"
 #include "tensorflow/core/public/session.h"
@@ -113,6 +114,47 @@ TEST(RunHandlerUtilTest, PrioritySchedulingTest) {
   EXPECT_EQ(sorted_active_list[3], 1);
 }
 
+TEST(RunHandlerUtilTest, HighPriorityReservedThreadsTest) {
+  // Reserve one of the two blocking threads for requests with priority >= 1.
+  setenv("TF_RUN_HANDLER_NUM_HIGH_PRIORITY_RESERVED_THREADS", "1", true);
+  setenv("TF_RUN_HANDLER_HIGH_PRIORITY_THRESHOLD", "1", true);
+
+  int num_threads = 2;
+  std::unique_ptr<RunHandlerPool> pool(
+      new RunHandlerPool(num_threads, num_threads));
+
+  RunOptions::Experimental::RunHandlerPoolOptions options =
+      RunOptions::Experimental::RunHandlerPoolOptions();
+  options.set_priority(0);
+  auto batch_handler = pool->Get(/*step_id=*/1, /*timeout_in_ms=*/0, options);
+
+  // Enqueue more blocking batch work than there are unreserved threads and
+  // block it; only the unreserved thread may pick it up.
+  Notification release_batch;
+  BlockingCounter batch_counter(num_threads);
+  for (int i = 0; i < num_threads; ++i) {
+    batch_handler->ScheduleInterOpClosure([&release_batch, &batch_counter]() {
+      release_batch.WaitForNotification();
+      batch_counter.DecrementCount();
+    });
+  }
+
+  // A latency critical request must still make progress on the reserved
+  // thread while the batch work has the rest of the pool blocked.
+  options.set_priority(2);
+  auto online_handler = pool->Get(/*step_id=*/2, /*timeout_in_ms=*/0, options);
+  Notification online_done;
+  online_handler->ScheduleInterOpClosure(
+      [&online_done]() { online_done.Notify(); });
+  online_done.WaitForNotification();
+
+  release_batch.Notify();
+  batch_counter.Wait();
+
+  unsetenv("TF_RUN_HANDLER_NUM_HIGH_PRIORITY_RESERVED_THREADS");
+  unsetenv("TF_RUN_HANDLER_HIGH_PRIORITY_THRESHOLD");
+}
+
 TEST(RunHandlerThreadPool, EnqueueTask) {
   Eigen::MaxSizeVector<mutex> waiters_mu(2);
   waiters_mu.resize(2);
@@ -159,6 +159,48 @@ class Buffer : public BufferBase {
   void operator=(const Buffer&) = delete;
 };
 
+// Upper bound on the payload size for which a tensor's elements are stored
+// inline in the buffer object itself, see SmallBuffer below. Covers scalars
+// and small shape vectors of every numeric type.
+constexpr size_t kMaxInlineTensorBytes = 16;
+
+// Typed ref-counted buffer whose payload lives inline in the buffer object,
+// so small host tensors cost a single heap allocation instead of one for the
+// buffer object plus one from the allocator for the payload. The buffer is
+// still an ordinary refcounted TensorBuffer, so buffer sharing (CopyFrom,
+// Slice) and the executor's ref accounting are unaffected. Only used for
+// trivial element types; the storage is deliberately left uninitialized to
+// match Buffer's semantics.
+template <typename T>
+class SmallBuffer : public TensorBuffer {
+ public:
+  explicit SmallBuffer(int64_t n) : TensorBuffer(&storage_[0]), elem_(n) {}
+
+  size_t size() const override { return sizeof(T) * elem_; }
+  TensorBuffer* root_buffer() override { return this; }
+  bool GetAllocatedBytes(size_t* out_bytes) const override {
+    *out_bytes = sizeof(storage_);
+    return true;
+  }
+  void FillAllocationDescription(AllocationDescription* proto) const override {
+    proto->set_requested_bytes(size());
+    proto->set_allocator_name("SmallBuffer");
+    proto->set_ptr(reinterpret_cast<uintptr_t>(data()));
+  }
+  AllocatorMemoryType GetMemoryType() const override {
+    return AllocatorMemoryType::kHostPageable;
+  }
+
+ private:
+  alignas(Allocator::kAllocatorAlignment) char storage_[kMaxInlineTensorBytes];
+  int64_t elem_;
+
+  ~SmallBuffer() override = default;
+
+  SmallBuffer(const SmallBuffer&) = delete;
+  void operator=(const SmallBuffer&) = delete;
+};
+
 void LogUnexpectedSize(int64_t actual, int64_t expected) {
   LOG(ERROR) << "Input size was " << actual << " and expected " << expected;
 }
@@ -584,6 +626,25 @@ Buffer<T>::~Buffer() {
   }
 }
 
+// Returns a buffer holding `n` elements of type T allocated from `a`.
+// Payloads of at most kMaxInlineTensorBytes are stored inline in the buffer
+// object when the element type is trivial and `a` hands out plain pageable
+// host memory without tracking allocation sizes, so allocator accounting,
+// device memory, and element construction semantics are unchanged.
+template <typename T>
+TensorBuffer* AllocateBuffer(Allocator* a, int64_t n,
+                             const AllocationAttributes& allocation_attr) {
+  if constexpr (std::is_trivially_copyable<T>::value &&
+                std::is_trivially_destructible<T>::value) {
+    if (n > 0 && sizeof(T) * static_cast<uint64_t>(n) <= kMaxInlineTensorBytes &&
+        !a->AllocatesOpaqueHandle() && !a->TracksAllocationSizes() &&
+        a->GetMemoryType() == AllocatorMemoryType::kHostPageable) {
+      return new SmallBuffer<T>(n);
+    }
+  }
+  return new Buffer<T>(a, n, allocation_attr);
+}
+
 // Allocates a T[n] buffer. Fills in the buffer with repeated values
 // in "in".  If "in" has less values than "n", fills the rest of T[n]
 // with the last value. If "in" has no values, fills T[n] with the
@@ -969,7 +1030,8 @@ Tensor::Tensor(Allocator* a, DataType type, const TensorShape& shape)
   set_dtype(type);
   CHECK_NOTNULL(a);
   if (shape_.num_elements() > 0 || a->AllocatesOpaqueHandle()) {
-    CASES(type, buf_ = new Buffer<T>(a, shape.num_elements()));
+    CASES(type, buf_ = AllocateBuffer<T>(a, shape.num_elements(),
+                                         AllocationAttributes()));
   }
   if (MemoryLoggingEnabled() && buf_ != nullptr && buf_->data() != nullptr) {
     LogMemory::RecordTensorAllocation("Unknown", LogMemory::UNKNOWN_STEP_ID,
@@ -983,7 +1045,8 @@ Tensor::Tensor(Allocator* a, DataType type, const TensorShape& shape,
   set_dtype(type);
   CHECK_NOTNULL(a);
   if (shape_.num_elements() > 0 || a->AllocatesOpaqueHandle()) {
-    CASES(type, buf_ = new Buffer<T>(a, shape.num_elements(), allocation_attr));
+    CASES(type,
+          buf_ = AllocateBuffer<T>(a, shape.num_elements(), allocation_attr));
   }
   if (MemoryLoggingEnabled() && !allocation_attr.allocation_will_be_logged &&
       buf_ != nullptr && buf_->data() != nullptr) {
@@ -1401,6 +1401,32 @@ TEST(Tensor, SharesBufferWith) {
   EXPECT_TRUE(a.SharesBufferWith(copy));
 }
 
+TEST(Tensor, SmallTensorKeepsBufferSemantics) {
+  // Small host tensors are stored inline in their buffer object; the usual
+  // buffer-sharing and alignment contracts must still hold.
+  Tensor scalar(DT_INT32, TensorShape({}));
+  scalar.scalar<int32>()() = 42;
+  EXPECT_TRUE(scalar.IsAligned());
+  EXPECT_TRUE(scalar.RefCountIsOne());
+
+  Tensor copy(scalar);
+  EXPECT_TRUE(scalar.SharesBufferWith(copy));
+  EXPECT_FALSE(scalar.RefCountIsOne());
+  copy.scalar<int32>()() = 7;
+  EXPECT_EQ(scalar.scalar<int32>()(), 7);
+
+  Tensor shape_vec(DT_INT64, TensorShape({2}));
+  shape_vec.vec<int64_t>()(0) = 3;
+  shape_vec.vec<int64_t>()(1) = 4;
+  Tensor slice = shape_vec.Slice(1, 2);
+  EXPECT_EQ(slice.vec<int64_t>()(0), 4);
+  shape_vec.vec<int64_t>()(1) = 5;
+  EXPECT_EQ(slice.vec<int64_t>()(0), 5);
+
+  EXPECT_EQ(scalar.TotalBytes(), sizeof(int32));
+  EXPECT_GE(scalar.AllocatedBytes(), sizeof(int32));
+}
+
 TEST(TensorFromProto, CompressedTensorProto) {
   int size = 100;
   TensorShape shape({size});
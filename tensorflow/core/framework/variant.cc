@@ -59,7 +59,8 @@ void EncodeVariant(const VariantTensorDataProto& value,
 
 template <>
 bool DecodeVariant(VariantTensorData* data, VariantTensorDataProto* value) {
-  data->ToProto(value);
+  // `data` is consumed by decoding, so move its strings rather than copy.
+  data->MoveToProto(value);
   return true;
 }
 
@@ -92,10 +93,15 @@ bool DecodeVariantList(std::unique_ptr<port::StringListDecoder> d,
     if (variant_array[i].is_empty()) {
       variant_array[i] = VariantTensorDataProto();
     }
-    // TODO(ebrevdo): Replace with StringPiece?  Any way to make this a
-    // zero-copy operation that keeps a reference to the data in d?
-    string str(d->Data(sizes[i]), sizes[i]);
-    if (!variant_array[i].Decode(std::move(str))) return false;
+    VariantTensorDataProto* t = variant_array[i].get<VariantTensorDataProto>();
+    if (t != nullptr) {
+      // Common transport case: parse the proto directly from the decoder's
+      // buffer instead of copying the bytes into a temporary string first.
+      if (!t->ParseFromArray(d->Data(sizes[i]), sizes[i])) return false;
+    } else {
+      string str(d->Data(sizes[i]), sizes[i]);
+      if (!variant_array[i].Decode(std::move(str))) return false;
+    }
     if (!DecodeUnaryVariant(&variant_array[i])) {
       LOG(ERROR) << "Could not decode variant with type_name: \""
                  << variant_array[i].TypeName()
@@ -46,6 +46,9 @@ class VariantTensorData {
   // Name of the type of objects being serialized.
   const std::string& type_name() const { return type_name_; }
   void set_type_name(const std::string& type_name) { type_name_ = type_name; }
+  void set_type_name(std::string&& type_name) {
+    type_name_ = std::move(type_name);
+  }
 
   template <typename T, bool = std::is_pod<typename std::decay<T>::type>::value>
   struct PODResolver {};
@@ -62,6 +65,9 @@ class VariantTensorData {
     return GetMetadata(value, PODResolver<T>());
   }
 
+  // Move overload to avoid copying potentially large serialized metadata.
+  void set_metadata(std::string&& value) { metadata_ = std::move(value); }
+
   std::string& metadata_string() { return metadata_; }
 
   const std::string& metadata_string() const { return metadata_; }
@@ -79,6 +85,9 @@ class VariantTensorData {
 
   // Conversion to and from VariantTensorDataProto
   void ToProto(VariantTensorDataProto* proto) const;
+  // Like ToProto, but moves the metadata and type name into the proto
+  // instead of copying them, leaving this object empty.
+  void MoveToProto(VariantTensorDataProto* proto);
   // This allows optimizations via std::move.
   bool FromProto(VariantTensorDataProto proto);
   bool FromConstProto(const VariantTensorDataProto& proto);
@@ -493,6 +493,26 @@ TEST(VariantTest, TensorProto) {
   EXPECT_EQ(x.get<TensorProto>()->tensor_shape().unknown_rank(), true);
 }
 
+TEST(VariantTest, VariantTensorDataMoveToProto) {
+  VariantTensorData data;
+  data.set_type_name("foo");
+  data.set_metadata(std::string("serialized-metadata"));
+  Tensor t(DT_FLOAT, TensorShape({2}));
+  t.flat<float>().setZero();
+  *data.add_tensors() = t;
+
+  VariantTensorDataProto proto;
+  data.MoveToProto(&proto);
+
+  EXPECT_EQ(proto.type_name(), "foo");
+  EXPECT_EQ(proto.metadata(), "serialized-metadata");
+  EXPECT_EQ(proto.tensors_size(), 1);
+  // MoveToProto consumes the VariantTensorData.
+  EXPECT_TRUE(data.type_name().empty());
+  EXPECT_TRUE(data.metadata_string().empty());
+  EXPECT_EQ(data.tensors_size(), 0);
+}
+
 template <bool BIG>
 void TestCopyValue() {
   Variant x, y;
@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "tensorflow/core/graph/graph_partition.h"
 
+#include <algorithm>
 #include <deque>
 #include <memory>
 #include <queue>
@@ -86,6 +87,42 @@ struct RecvInfo {
 
 typedef absl::flat_hash_map<DupRecvKey, RecvInfo> DupRecvTable;
 
+// Identifies the source node of a data transfer into a particular partition.
+// Used (when opts.coalesce_control_transfers is set) to find an existing data
+// transfer that a control edge from the same source node can piggyback on.
+struct TransferSrcKey {
+  int src_node_id;      // Edge's src node id
+  GraphDef* dst_graph;  // Edge's dst node is in this subgraph
+
+  template <typename H>
+  friend H AbslHashValue(H h, const TransferSrcKey& c) {
+    return H::combine(std::move(h), c.src_node_id,
+                      reinterpret_cast<std::uintptr_t>(c.dst_graph));
+  }
+
+  friend bool operator==(const TransferSrcKey& x, const TransferSrcKey& y) {
+    return (x.src_node_id == y.src_node_id) && (x.dst_graph == y.dst_graph);
+  }
+};
+
+// Maps the source of a data transfer to the DupRecvTable entry of that
+// transfer.
+typedef absl::flat_hash_map<TransferSrcKey, DupRecvKey> DataRecvBySrcTable;
+
+// State of one packed component transfer (see
+// opts.pack_composite_transfers): the dst-partition unpack node serving the
+// component tensors, the recv node feeding it, and the src output slots
+// packed, in unpack output order.
+struct PackedTransferInfo {
+  NodeDef* unpack = nullptr;
+  NodeDef* real_recv = nullptr;
+  std::vector<int> slots;
+};
+
+// Maps (src node, dst partition) to its packed component transfer.
+typedef absl::flat_hash_map<TransferSrcKey, PackedTransferInfo>
+    PackedTransferTable;
+
 // A map used to store memory types for the inputs/outputs of every node.
 // The key is a pair of ints consisting of a node id and input/output index.
 // TODO(power): migrate back to std::pair when absl::Hash is fixed for MSVC.
@@ -144,6 +181,23 @@ bool NeedSameDeviceSendRecv(const Edge* edge, const GraphInfo& info) {
   return false;
 }
 
+// Return true iff 'edge' may participate in a packed component transfer:
+// a cross-partition data edge carrying a non-ref tensor between CPU-placed
+// nodes (the pack/unpack kernels are CPU-only).
+bool IsPackableEdge(const Edge* edge, const PartitionOptions& opts,
+                    const GraphInfo& info) {
+  if (edge->IsControlEdge()) return false;
+  const Node* src = edge->src();
+  const Node* dst = edge->dst();
+  if (!src->IsOp() || !dst->IsOp()) return false;
+  if (opts.node_to_loc(src) == opts.node_to_loc(dst)) return false;
+  // Packing moves tensors by value inside a variant, so ref outputs keep
+  // their own per-edge transfer.
+  if (IsRefType(src->output_type(edge->src_output()))) return false;
+  return info.device_types[src->id()] == DEVICE_CPU &&
+         info.device_types[dst->id()] == DEVICE_CPU;
+}
+
 // Return true iff (dst, dst_input) is specified on host memory.
 bool IsDstInputOnHost(const Edge* edge, const GraphInfo& info) {
   const Node* dst = edge->dst();
@@ -336,6 +390,69 @@ NodeDef* AddDummyConst(const PartitionOptions& opts, GraphDef* gdef,
   return result;
 }
 
+// Adds the nodes of one packed component transfer: a _PackComponents node in
+// the src partition feeding one send/recv pair that carries a variant, and a
+// _UnpackComponents node in the dst partition that restores the component
+// tensors.  'edge' is a representative packed edge, used for device names,
+// send/recv attrs and debug info; 'slots' holds the src output slots to pack.
+Status AddPackedTransfer(const PartitionOptions& opts, const GraphInfo& g_info,
+                         GraphDef* src_graph, GraphDef* dst_graph,
+                         const Edge* edge, const std::vector<int>& slots,
+                         PackedTransferInfo* info) {
+  const Node* src = edge->src();
+  const Node* dst = edge->dst();
+
+  DataTypeVector component_types;
+  component_types.reserve(slots.size());
+  std::vector<NodeDefBuilder::NodeOut> components;
+  components.reserve(slots.size());
+  for (int slot : slots) {
+    component_types.push_back(src->output_type(slot));
+    components.emplace_back(src->name(), slot, src->output_type(slot));
+  }
+
+  // Pack the components in the source partition.
+  NodeDefBuilder pack_builder(opts.new_name(src->name()), "_PackComponents",
+                              NodeDebugInfo(*src));
+  pack_builder.Device(src->assigned_device_name())
+      .Input(components)
+      .Attr("T_components", component_types);
+  NodeDef* pack = src_graph->add_node();
+  TF_RETURN_IF_ERROR(pack_builder.Finalize(pack, /*consume=*/true));
+
+  const string tensor_name_attr =
+      strings::StrCat("packed_edge_", edge->id(), "_", src->name());
+
+  NodeDefBuilder::NodeOut send_from(pack->name(), 0, DT_VARIANT);
+  Status status;
+  AddSend(opts, g_info, src_graph, edge, send_from, /*start_time=*/0,
+          tensor_name_attr, &status);
+  TF_RETURN_IF_ERROR(status);
+
+  // The recv is built directly rather than through AddRecv() since it carries
+  // the packed variant, not the representative edge's tensor type.
+  NodeDefBuilder recv_builder(opts.new_name(src->name()), "_Recv",
+                              NodeDebugInfo(*src));
+  SetSendRecvAttrs(opts, edge, tensor_name_attr, &recv_builder);
+  recv_builder.Device(dst->assigned_device_name())
+      .Attr("tensor_type", DT_VARIANT);
+  NodeDef* recv = dst_graph->add_node();
+  TF_RETURN_IF_ERROR(recv_builder.Finalize(recv, /*consume=*/true));
+  info->real_recv = recv;
+
+  // Restore the components in the destination partition.
+  NodeDefBuilder unpack_builder(opts.new_name(src->name()),
+                                "_UnpackComponents", NodeDebugInfo(*src));
+  unpack_builder.Device(dst->assigned_device_name())
+      .Input(recv->name(), 0, DT_VARIANT)
+      .Attr("T_components", component_types);
+  NodeDef* unpack = dst_graph->add_node();
+  TF_RETURN_IF_ERROR(unpack_builder.Finalize(unpack, /*consume=*/true));
+  info->unpack = unpack;
+  info->slots = slots;
+  return OkStatus();
+}
+
 // A dummy node for scheduling.
 NodeDef* AddControlTrigger(const PartitionOptions& opts, GraphDef* gdef,
                            const string& assigned_device_name, int64_t epoch,
@@ -994,6 +1111,43 @@ Status Partition(const PartitionOptions& opts, Graph* g,
   string dstp;
   std::vector<const Edge*> inputs;
   DupRecvTable dup_recv(3);
+  DataRecvBySrcTable data_recv_by_src;
+  // Control edges that still need a new transfer are deferred (per dst node)
+  // so that those sharing a source partition can be packed into one transfer.
+  // Only used if opts.coalesce_control_transfers is set.
+  std::vector<std::pair<GraphDef*, std::vector<const Edge*>>>
+      deferred_control_edges;
+  const bool coalesce_control_transfers =
+      opts.coalesce_control_transfers && !opts.scheduling_for_recvs;
+  const bool pack_composite_transfers =
+      opts.pack_composite_transfers && !opts.scheduling_for_recvs &&
+      !opts.need_to_record_start_times &&
+      opts.get_tensor_name_attr == nullptr && opts.should_cast == nullptr;
+  PackedTransferTable packed_transfers;
+  // Output slots of each (src node, dst partition) pair that qualify for a
+  // packed component transfer; only pairs where at least two distinct
+  // outputs cross to the same partition are packed.
+  absl::flat_hash_map<TransferSrcKey, std::vector<int>> packable_slots;
+  if (pack_composite_transfers) {
+    for (const Edge* edge : g->edges()) {
+      if (!IsPackableEdge(edge, opts, g_info)) continue;
+      GraphDef* dst_graph = &(*partitions)[opts.node_to_loc(edge->dst())];
+      std::vector<int>& slots =
+          packable_slots[TransferSrcKey{edge->src()->id(), dst_graph}];
+      if (std::find(slots.begin(), slots.end(), edge->src_output()) ==
+          slots.end()) {
+        slots.push_back(edge->src_output());
+      }
+    }
+    for (auto it = packable_slots.begin(); it != packable_slots.end();) {
+      if (it->second.size() < 2) {
+        packable_slots.erase(it++);
+      } else {
+        std::sort(it->second.begin(), it->second.end());
+        ++it;
+      }
+    }
+  }
   // For a node dst, 'ref_recvs' remembers the recvs introduced by a ref
   // edge to dst. 'ref_control_inputs' remembers the inputs by a non-ref
   // edge to dst. We will add a control edge for every pair in
@@ -1029,6 +1183,7 @@ Status Partition(const PartitionOptions& opts, Graph* g,
     inputs.resize(dst->num_inputs(), nullptr);
     ref_recvs.clear();
     ref_control_inputs.clear();
+    deferred_control_edges.clear();
     const Edge* control_flow_edge = nullptr;
     int32_t num_control_flow_edges = 0;
     int32_t num_input_edges = 0;
@@ -1115,6 +1270,68 @@ Status Partition(const PartitionOptions& opts, Graph* g,
         continue;
       }
 
+      if (pack_composite_transfers && !edge->IsControlEdge()) {
+        TransferSrcKey pack_key{src->id(), dst_graph};
+        auto slots_iter = packable_slots.find(pack_key);
+        if (slots_iter != packable_slots.end()) {
+          PackedTransferInfo& packed = packed_transfers[pack_key];
+          if (packed.unpack == nullptr) {
+            // First packed edge of this (src, partition) pair: create the
+            // pack/send/recv/unpack nodes that carry all of the components.
+            status = AddPackedTransfer(opts, g_info, src_graph, dst_graph,
+                                       edge, slots_iter->second, &packed);
+            if (!status.ok()) return status;
+            if (control_flow_edge != nullptr) {
+              // Redirect the control edge to the real recv, as for an
+              // unpacked cross-device transfer.
+              --num_control_flow_edges;
+              Graph::AddInput(packed.real_recv,
+                              control_flow_edge->src()->name(),
+                              Graph::kControlSlot);
+            }
+            ++num_data;
+          }
+          const int component_index =
+              std::find(packed.slots.begin(), packed.slots.end(),
+                        edge->src_output()) -
+              packed.slots.begin();
+          Graph::AddInput(dst_def, packed.unpack->name(), component_index);
+          ref_control_inputs.push_back(packed.unpack->name());
+          continue;
+        }
+      }
+
+      if (coalesce_control_transfers && edge->IsControlEdge()) {
+        // If a tensor produced by src is already being transferred to this
+        // partition, completion of the recv implies that src has finished, so
+        // the data transfer doubles as the control signal and no dummy tensor
+        // needs to be sent.
+        auto data_iter =
+            data_recv_by_src.find(TransferSrcKey{src->id(), dst_graph});
+        if (data_iter != data_recv_by_src.end()) {
+          auto recv_iter = dup_recv.find(data_iter->second);
+          DCHECK(recv_iter != dup_recv.end());
+          const string& recv_node_name = recv_iter->second.recv->name();
+          Graph::AddInput(dst_def, recv_node_name, Graph::kControlSlot);
+          ref_control_inputs.push_back(recv_node_name);
+          continue;
+        }
+        // Otherwise defer the edge; control edges of dst from the same source
+        // partition share one transfer. They are processed after this loop.
+        bool deferred = false;
+        for (auto& entry : deferred_control_edges) {
+          if (entry.first == src_graph) {
+            entry.second.push_back(edge);
+            deferred = true;
+            break;
+          }
+        }
+        if (!deferred) {
+          deferred_control_edges.push_back({src_graph, {edge}});
+        }
+        continue;
+      }
+
       NodeDefBuilder::NodeOut send_from;
       if (edge->IsControlEdge()) {
         // Insert a dummy const node that will generate a tiny
@@ -1188,6 +1405,9 @@ Status Partition(const PartitionOptions& opts, Graph* g,
         // NOTE(yuanbyu): Collapsing ref edges requires extreme care so
         // for now we don't do it.
         dup_recv[key] = {recv, real_recv, recv_start_time};
+        if (coalesce_control_transfers && !edge->IsControlEdge()) {
+          data_recv_by_src.emplace(TransferSrcKey{src->id(), dst_graph}, key);
+        }
         ref_control_inputs.push_back(recv->name());
       }
 
@@ -1200,6 +1420,66 @@ Status Partition(const PartitionOptions& opts, Graph* g,
       }
     }
 
+    // Create the deferred cross-device control transfers, one per source
+    // partition, with the transferred dummy tensor depending on all of the
+    // control edge sources from that partition.
+    for (const auto& [src_graph, edges] : deferred_control_edges) {
+      const Edge* edge = edges[0];
+      const Node* src = edge->src();
+      VLOG(1) << "Send/Recv control: " << src->assigned_device_name() << "["
+              << src->name() << "] -> " << dst->assigned_device_name() << "["
+              << dst->name() << "] (packing " << edges.size() << " edges)";
+      // Insert a dummy const node that will generate a tiny data element to
+      // be sent from send to recv, gated on all of the packed control edges.
+      NodeDef* dummy = AddDummyConst(opts, src_graph, edge, &status);
+      if (!status.ok()) return status;
+      for (const Edge* packed_edge : edges) {
+        Graph::AddInput(dummy, packed_edge->src()->name(),
+                        Graph::kControlSlot);
+      }
+      NodeDefBuilder::NodeOut send_from;
+      send_from.Reset(dummy->name(), 0, DT_FLOAT);
+
+      string tensor_name_attr;
+      if (opts.get_tensor_name_attr) {
+        tensor_name_attr = opts.get_tensor_name_attr(edge);
+      } else {
+        tensor_name_attr =
+            strings::StrCat("edge_", edge->id(), "_", edge->src()->name());
+      }
+
+      NodeDef* send = AddSend(opts, g_info, src_graph, edge, send_from,
+                              /*start_time=*/0, tensor_name_attr, &status);
+      if (!status.ok()) return status;
+
+      NodeDef* real_recv = nullptr;
+      NodeDef* recv = AddRecv(opts, g_info, dst_graph, edge, &real_recv,
+                              tensor_name_attr, &status);
+      if (!status.ok()) return status;
+
+      // Fix up the control flow edge, as for the non-deferred case above.
+      if (src_graph == dst_graph) {
+        Graph::AddInput(real_recv, send->name(), Graph::kControlSlot);
+      } else if (control_flow_edge != nullptr && num_control_flow_edges > 0) {
+        --num_control_flow_edges;
+        Graph::AddInput(real_recv, control_flow_edge->src()->name(),
+                        Graph::kControlSlot);
+      }
+
+      if (edges.size() == 1) {
+        // A lone control edge keeps the usual bookkeeping so that later
+        // consumers in this partition can still reuse the transfer. Packed
+        // transfers are not reusable since they depend on several sources.
+        const bool on_host = IsDstInputOnHost(edge, g_info);
+        DupRecvKey key{src->id(), edge->src_output(), dst_graph, on_host};
+        dup_recv[key] = {recv, real_recv, /*start_time=*/0};
+      }
+      ref_control_inputs.push_back(recv->name());
+
+      ++num_control;
+      Graph::AddInput(dst_def, recv->name(), Graph::kControlSlot);
+    }
+
     // Add control edges from 'ref_control_inputs' to 'ref_recvs'.
     // NOTE(yuanbyu): Adding these control edges should not introduce
     // deadlocks. 'dst' has implicit "read" nodes that, when we split
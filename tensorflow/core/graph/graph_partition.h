@@ -80,6 +80,27 @@ struct PartitionOptions {
   // Optional customized function to compute the "tensor_name" attr value of
   // Send/Recv ops inserted during partitioning.
   std::function<string(const Edge*)> get_tensor_name_attr = nullptr;
+
+  // If true, reduce the number of cross-device transfers inserted for
+  // control edges:
+  //  - A control edge whose source tensor is already being transferred to
+  //    the destination partition reuses that data transfer as the control
+  //    signal instead of sending a dummy tensor through its own Send/Recv
+  //    pair.
+  //  - The remaining control edges of a node coming from the same source
+  //    partition are packed into a single dummy tensor transfer.
+  // This changes which Send/Recv nodes are created (not the semantics of the
+  // partitioned graph) and is ignored when 'scheduling_for_recvs' is set.
+  bool coalesce_control_transfers = false;
+
+  // If true, when several outputs of one node are consumed by the same
+  // destination partition (e.g. the component tensors of a ragged or sparse
+  // tensor, expanded into separate outputs), pack them into a single variant
+  // transfer carried by one Send/Recv pair instead of one pair per output.
+  // Only applies to non-ref data edges between CPU-placed nodes, and is
+  // ignored when 'scheduling_for_recvs', 'need_to_record_start_times',
+  // 'get_tensor_name_attr' or 'should_cast' is set.
+  bool pack_composite_transfers = false;
 };
 
 // Partition "input" graph into a set of graphs, one per location.
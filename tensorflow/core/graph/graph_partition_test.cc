@@ -83,7 +83,9 @@ string DeviceName(const Node* node) {
 }
 
 void Partition(const GraphDef& graph_def,
-               std::unordered_map<string, GraphDef>* partitions) {
+               std::unordered_map<string, GraphDef>* partitions,
+               bool coalesce_control_transfers = false,
+               bool pack_composite_transfers = false) {
   Graph g(OpRegistry::Global());
   GraphConstructorOptions opts;
   TF_CHECK_OK(ConvertGraphDefToGraph(opts, graph_def, &g));
@@ -103,6 +105,8 @@ void Partition(const GraphDef& graph_def,
   popts.get_incarnation = [](const string& name) {
     return (name[0] - 'A') + 100;
   };
+  popts.coalesce_control_transfers = coalesce_control_transfers;
+  popts.pack_composite_transfers = pack_composite_transfers;
   Status s = Partition(popts, &g, partitions);
   CHECK(s.ok()) << s;
 
@@ -171,6 +175,10 @@ REGISTER_OP("Combine")
     .Input("b: float")
     .Output("o: float")
     .SetShapeFn(shape_inference::UnknownShape);
+REGISTER_OP("FloatPairInput")
+    .Output("a: float")
+    .Output("b: float")
+    .SetShapeFn(shape_inference::UnknownShape);
 
 Output ConstructOp(const Scope& scope, const string& op_type,
                    const gtl::ArraySlice<Input>& inputs) {
@@ -202,6 +210,10 @@ Output Combine(const Scope& scope, Input a, Input b) {
   return ConstructOp(scope, "Combine", {std::move(a), std::move(b)});
 }
 
+Output FloatPairInput(const Scope& scope) {
+  return ConstructOp(scope, "FloatPairInput", {});
+}
+
 std::string FormatStackTrace(const GraphDebugInfo::StackTrace& stack_trace,
                              const GraphDebugInfo& debug_info) {
   std::string result;
@@ -395,6 +407,107 @@ TEST_F(GraphPartitionTest, CrossDevice_DataControl) {
   ExpectMatchB();
 }
 
+TEST_F(GraphPartitionTest, CrossDevice_DataControl_Coalesced) {
+  auto a1 = FloatInput(in_.WithOpName("A1"));
+  auto b1 = FloatInput(in_.WithOpName("B1"));
+  Combine(in_.WithOpName("B2"), a1, b1);
+  FloatInput(in_.WithOpName("B3").WithControlDependencies(a1));
+
+  Partition(ToGraphDef(), &partitions_, /*coalesce_control_transfers=*/true);
+  EXPECT_EQ(2, partitions_.size());
+
+  string a = "/job:a/replica:0/task:0/cpu:0";
+  string b = "/job:a/replica:0/task:0/cpu:1";
+  a1 = FloatInput(scope_a_.WithOpName("A1"));
+  // The control edge A1 -> B3 rides on the data transfer of A1's output, so
+  // no dummy const and no second send/recv pair are created.
+  _Send(scope_a_.WithOpName("A1/_0"), a1, "edge_1_A1", a, 82, b);
+  ExpectMatchA();
+
+  auto recv =
+      _Recv(scope_b_.WithOpName("A1/_1"), DT_FLOAT, "edge_1_A1", a, 82, b);
+  b1 = FloatInput(scope_b_.WithOpName("B1"));
+  Combine(scope_b_.WithOpName("B2"), recv, b1);
+  FloatInput(scope_b_.WithOpName("B3").WithControlDependencies(recv));
+  ExpectMatchB();
+}
+
+TEST_F(GraphPartitionTest, CrossDeviceControl_Packed) {
+  auto a1 = FloatInput(in_.WithOpName("A1"));
+  auto a2 = FloatInput(in_.WithOpName("A2"));
+  FloatInput(
+      in_.WithOpName("B1").WithControlDependencies({a1.op(), a2.op()}));
+
+  Partition(ToGraphDef(), &partitions_, /*coalesce_control_transfers=*/true);
+  EXPECT_EQ(2, partitions_.size());
+
+  // Both control edges come from the same source partition, so they must be
+  // packed into a single transfer: one dummy const gated on both A1 and A2,
+  // one send and one recv.
+  string a = "/job:a/replica:0/task:0/cpu:0";
+  string b = "/job:a/replica:0/task:0/cpu:1";
+  int num_sends = 0;
+  const NodeDef* dummy = nullptr;
+  for (const NodeDef& ndef : partitions_[a].node()) {
+    if (ndef.op() == "_Send") ++num_sends;
+    if (ndef.op() == "Const") dummy = &ndef;
+  }
+  EXPECT_EQ(1, num_sends);
+  ASSERT_TRUE(dummy != nullptr);
+  EXPECT_THAT(dummy->input(),
+              ::testing::UnorderedElementsAre("^A1", "^A2"));
+
+  int num_recvs = 0;
+  for (const NodeDef& ndef : partitions_[b].node()) {
+    if (ndef.op() == "_Recv") ++num_recvs;
+  }
+  EXPECT_EQ(1, num_recvs);
+}
+
+TEST_F(GraphPartitionTest, CrossDeviceData_PackedComponents) {
+  auto a1 = FloatPairInput(in_.WithOpName("A1"));
+  auto b1 = FloatInput(in_.WithOpName("B1"));
+  Combine(in_.WithOpName("B2"), Output(a1.node(), 0), b1);
+  Combine(in_.WithOpName("B3"), Output(a1.node(), 1), b1);
+
+  Partition(ToGraphDef(), &partitions_, /*coalesce_control_transfers=*/false,
+            /*pack_composite_transfers=*/true);
+  EXPECT_EQ(2, partitions_.size());
+
+  // Both outputs of A1 cross to partition b, so they must be packed into a
+  // single transfer: one _PackComponents feeding one send on the a side, one
+  // recv feeding one _UnpackComponents on the b side.
+  string a = "/job:a/replica:0/task:0/cpu:0";
+  string b = "/job:a/replica:0/task:0/cpu:1";
+  int num_sends = 0;
+  const NodeDef* pack = nullptr;
+  for (const NodeDef& ndef : partitions_[a].node()) {
+    if (ndef.op() == "_Send" || ndef.op() == "_HostSend") ++num_sends;
+    if (ndef.op() == "_PackComponents") pack = &ndef;
+  }
+  EXPECT_EQ(1, num_sends);
+  ASSERT_TRUE(pack != nullptr);
+  EXPECT_THAT(pack->input(), ::testing::ElementsAre("A1", "A1:1"));
+
+  int num_recvs = 0;
+  const NodeDef* unpack = nullptr;
+  for (const NodeDef& ndef : partitions_[b].node()) {
+    if (ndef.op() == "_Recv" || ndef.op() == "_HostRecv") ++num_recvs;
+    if (ndef.op() == "_UnpackComponents") unpack = &ndef;
+  }
+  EXPECT_EQ(1, num_recvs);
+  ASSERT_TRUE(unpack != nullptr);
+
+  // B2 and B3 read their A1 components from the unpack node, in slot order.
+  for (const NodeDef& ndef : partitions_[b].node()) {
+    if (ndef.name() == "B2") {
+      EXPECT_EQ(unpack->name(), ndef.input(0));
+    } else if (ndef.name() == "B3") {
+      EXPECT_EQ(strings::StrCat(unpack->name(), ":1"), ndef.input(0));
+    }
+  }
+}
+
 TEST_F(GraphPartitionTest, CrossDeviceLoopSimple) {
   auto a1 = BoolInput(in_.WithOpName("A1"));
   auto a2 = ::tensorflow::ops::internal::Enter(in_.WithOpName("A2"), a1, "foo");
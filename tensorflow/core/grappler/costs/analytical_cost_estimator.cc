@@ -22,6 +22,7 @@ limitations under the License.
 #include "tensorflow/core/framework/tensor_shape.pb.h"
 #include "tensorflow/core/graph/types.h"
 #include "tensorflow/core/grappler/costs/graph_properties.h"
+#include "tensorflow/core/grappler/costs/measured_cost_estimator.h"
 #include "tensorflow/core/grappler/costs/op_performance_data.pb.h"
 #include "tensorflow/core/grappler/costs/utils.h"
 #include "tensorflow/core/grappler/costs/virtual_placer.h"
@@ -113,11 +114,27 @@ Status AddCostNode(ReadyNodeManager* node_manager, const OpContext& op_context,
 
 }  // namespace
 
+namespace {
+
+// Returns the default per-node estimator. When a calibration table is
+// provided through TF_GRAPPLER_COST_CALIBRATION_FILE, measured costs are
+// consulted before the analytic fallback.
+std::unique_ptr<OpLevelCostEstimator> CreateDefaultNodeEstimator() {
+  std::unique_ptr<OpLevelCostEstimator> estimator =
+      MeasuredCostEstimator::MaybeCreateFromEnv();
+  if (estimator != nullptr) {
+    return estimator;
+  }
+  return std::make_unique<OpLevelCostEstimator>();
+}
+
+}  // namespace
+
 AnalyticalCostEstimator::AnalyticalCostEstimator(
     Cluster* cluster, bool use_static_shapes,
     bool use_aggressive_shape_inference)
     : AnalyticalCostEstimator(
-          cluster, std::make_unique<OpLevelCostEstimator>(),
+          cluster, CreateDefaultNodeEstimator(),
           ReadyNodeManagerFactory("FirstReady"), use_static_shapes,
           use_aggressive_shape_inference) {}
 
@@ -0,0 +1,169 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/grappler/costs/measured_cost_estimator.h"
+
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/framework/types.pb.h"
+#include "tensorflow/core/grappler/clusters/cluster.h"
+#include "tensorflow/core/grappler/costs/utils.h"
+#include "tensorflow/core/grappler/grappler_item.h"
+#include "tensorflow/core/lib/strings/strcat.h"
+#include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/protobuf/config.pb.h"
+
+namespace tensorflow {
+namespace grappler {
+
+string OpCostCalibrationTable::Signature(const OpInfo& op_info) {
+  string signature = strings::StrCat(op_info.op(), "#", op_info.device().type());
+  for (const auto& input : op_info.inputs()) {
+    strings::StrAppend(&signature, "#", DataType_Name(input.dtype()),
+                       PartialTensorShape::DebugString(input.shape()));
+  }
+  return signature;
+}
+
+void OpCostCalibrationTable::Merge(const OpPerformanceList& list) {
+  for (const auto& perf : list.op_performance()) {
+    if (perf.compute_cost() <= 0) {
+      continue;
+    }
+    Record(perf.op(), perf.compute_cost());
+  }
+}
+
+void OpCostCalibrationTable::Record(const OpInfo& op_info,
+                                    int64_t compute_cost_ns) {
+  const string signature = Signature(op_info);
+  mutex_lock l(mu_);
+  Entry& entry = entries_[signature];
+  if (entry.count == 0) {
+    entry.op = op_info;
+  }
+  entry.total_ns += compute_cost_ns;
+  entry.count++;
+}
+
+bool OpCostCalibrationTable::Lookup(const OpInfo& op_info,
+                                    int64_t* compute_cost_ns) const {
+  const string signature = Signature(op_info);
+  mutex_lock l(mu_);
+  auto it = entries_.find(signature);
+  if (it == entries_.end()) {
+    return false;
+  }
+  *compute_cost_ns = it->second.total_ns / it->second.count;
+  return true;
+}
+
+Status OpCostCalibrationTable::LoadFromFile(Env* env, const string& path) {
+  OpPerformanceList list;
+  Status status = ReadTextProto(env, path, &list);
+  if (!status.ok()) {
+    // Also accept the binary encoding, e.g. for tables produced on hosts
+    // where the text format would be impractically large.
+    TF_RETURN_IF_ERROR(ReadBinaryProto(env, path, &list));
+  }
+  Merge(list);
+  return OkStatus();
+}
+
+Status OpCostCalibrationTable::SaveToFile(Env* env, const string& path) const {
+  return WriteTextProto(env, path, ToProto());
+}
+
+OpPerformanceList OpCostCalibrationTable::ToProto() const {
+  OpPerformanceList list;
+  mutex_lock l(mu_);
+  for (const auto& entry : entries_) {
+    OpPerformance* perf = list.add_op_performance();
+    *perf->mutable_op() = entry.second.op;
+    perf->set_compute_cost(entry.second.total_ns / entry.second.count);
+  }
+  return list;
+}
+
+int64_t OpCostCalibrationTable::num_entries() const {
+  mutex_lock l(mu_);
+  return entries_.size();
+}
+
+Status CalibrateFromCluster(Cluster* cluster, const GrapplerItem& item,
+                            int measurement_steps,
+                            OpCostCalibrationTable* table) {
+  if (measurement_steps < 1) {
+    return errors::InvalidArgument("measurement_steps must be positive, got ",
+                                   measurement_steps);
+  }
+  TF_RETURN_IF_ERROR(cluster->Initialize(item));
+  // Discard the first step: it triggers the warmup and therefore takes much
+  // longer than a normal step.
+  RunMetadata warmup_metadata;
+  TF_RETURN_IF_ERROR(
+      cluster->Run(item.graph, item.feed, item.fetch, &warmup_metadata));
+  for (int step = 0; step < measurement_steps; ++step) {
+    RunMetadata metadata;
+    TF_RETURN_IF_ERROR(
+        cluster->Run(item.graph, item.feed, item.fetch, &metadata));
+    table->Merge(
+        CostGraphToOpPerformanceData(metadata.cost_graph(), item.graph));
+  }
+  return OkStatus();
+}
+
+MeasuredCostEstimator::MeasuredCostEstimator(
+    std::shared_ptr<const OpCostCalibrationTable> table)
+    : table_(std::move(table)) {}
+
+std::unique_ptr<MeasuredCostEstimator>
+MeasuredCostEstimator::MaybeCreateFromEnv() {
+  const char* path = std::getenv("TF_GRAPPLER_COST_CALIBRATION_FILE");
+  if (path == nullptr || path[0] == '\0') {
+    return nullptr;
+  }
+  auto table = std::make_shared<OpCostCalibrationTable>();
+  Status status = table->LoadFromFile(Env::Default(), path);
+  if (!status.ok()) {
+    LOG(WARNING) << "Failed to load cost calibration table from " << path
+                 << ": " << status;
+    return nullptr;
+  }
+  VLOG(1) << "Loaded cost calibration table from " << path << " with "
+          << table->num_entries() << " entries.";
+  return std::make_unique<MeasuredCostEstimator>(std::move(table));
+}
+
+Costs MeasuredCostEstimator::PredictCosts(const OpContext& op_context) const {
+  int64_t compute_cost_ns = 0;
+  if (table_ != nullptr && table_->Lookup(op_context.op_info, &compute_cost_ns)) {
+    Costs costs;
+    costs.execution_time = Costs::NanoSeconds(compute_cost_ns);
+    costs.compute_time = costs.execution_time;
+    costs.memory_time = Costs::Duration::zero();
+    costs.num_ops_total = 1;
+    costs.inaccurate = false;
+    return costs;
+  }
+  return OpLevelCostEstimator::PredictCosts(op_context);
+}
+
+}  // end namespace grappler
+}  // end namespace tensorflow
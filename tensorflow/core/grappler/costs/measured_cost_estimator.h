@@ -0,0 +1,108 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_GRAPPLER_COSTS_MEASURED_COST_ESTIMATOR_H_
+#define TENSORFLOW_CORE_GRAPPLER_COSTS_MEASURED_COST_ESTIMATOR_H_
+
+#include <memory>
+#include <string>
+
+#include "absl/container/flat_hash_map.h"
+#include "tensorflow/core/grappler/costs/cost_estimator.h"
+#include "tensorflow/core/grappler/costs/op_context.h"
+#include "tensorflow/core/grappler/costs/op_level_cost_estimator.h"
+#include "tensorflow/core/grappler/costs/op_performance_data.pb.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/status.h"
+#include "tensorflow/core/platform/thread_annotations.h"
+#include "tensorflow/core/platform/types.h"
+
+namespace tensorflow {
+namespace grappler {
+
+class Cluster;
+struct GrapplerItem;
+
+// A table of op costs measured on an actual host, keyed by the op, the device
+// type, and the dtype and shape of each input. Thread-safe. Persisted as an
+// OpPerformanceList proto, with OpPerformance.compute_cost holding the
+// measured time in nanoseconds.
+class OpCostCalibrationTable {
+ public:
+  // Returns the lookup key for `op_info`.
+  static string Signature(const OpInfo& op_info);
+
+  // Folds the measured entries of `list` into the table. Entries with
+  // non-positive compute_cost are skipped; repeated measurements of the same
+  // signature are averaged.
+  void Merge(const OpPerformanceList& list);
+
+  // Records one measurement of `op_info` taking `compute_cost_ns`.
+  void Record(const OpInfo& op_info, int64_t compute_cost_ns);
+
+  // Returns true and sets `*compute_cost_ns` to the average measured cost if
+  // the table has a measurement matching `op_info`.
+  bool Lookup(const OpInfo& op_info, int64_t* compute_cost_ns) const;
+
+  Status LoadFromFile(Env* env, const string& path);
+  Status SaveToFile(Env* env, const string& path) const;
+  OpPerformanceList ToProto() const;
+
+  int64_t num_entries() const;
+
+ private:
+  struct Entry {
+    // The op of the first measurement, kept for serialization.
+    OpInfo op;
+    int64_t total_ns = 0;
+    int64_t count = 0;
+  };
+
+  mutable mutex mu_;
+  absl::flat_hash_map<string, Entry> entries_ TF_GUARDED_BY(mu_);
+};
+
+// Runs `item` on `cluster` for `measurement_steps` steps (after one discarded
+// warmup step) and folds the per-node measured costs into `table`. The
+// cluster must execute for real (e.g. SingleMachine); a virtual cluster would
+// calibrate the table with the analytic guesses it is meant to replace.
+Status CalibrateFromCluster(Cluster* cluster, const GrapplerItem& item,
+                            int measurement_steps,
+                            OpCostCalibrationTable* table);
+
+// An OpLevelCostEstimator that returns the measured cost when the calibration
+// table has an entry for the op/shape signature, and falls back to the
+// analytic roofline estimate otherwise.
+class MeasuredCostEstimator : public OpLevelCostEstimator {
+ public:
+  explicit MeasuredCostEstimator(
+      std::shared_ptr<const OpCostCalibrationTable> table);
+
+  // Returns an estimator backed by the calibration table named by the
+  // TF_GRAPPLER_COST_CALIBRATION_FILE environment variable, or nullptr if the
+  // variable is unset or the file cannot be read.
+  static std::unique_ptr<MeasuredCostEstimator> MaybeCreateFromEnv();
+
+  Costs PredictCosts(const OpContext& op_context) const override;
+
+ private:
+  const std::shared_ptr<const OpCostCalibrationTable> table_;
+};
+
+}  // end namespace grappler
+}  // end namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_GRAPPLER_COSTS_MEASURED_COST_ESTIMATOR_H_
@@ -0,0 +1,98 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/grappler/costs/measured_cost_estimator.h"
+
+#include <memory>
+
+#include "tensorflow/core/framework/types.pb.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/path.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace grappler {
+namespace {
+
+OpInfo MakeMatMulInfo(int m, int k, int n) {
+  OpInfo op_info;
+  op_info.set_op("MatMul");
+  op_info.mutable_device()->set_type("CPU");
+  auto* lhs = op_info.add_inputs();
+  lhs->set_dtype(DT_FLOAT);
+  lhs->mutable_shape()->add_dim()->set_size(m);
+  lhs->mutable_shape()->add_dim()->set_size(k);
+  auto* rhs = op_info.add_inputs();
+  rhs->set_dtype(DT_FLOAT);
+  rhs->mutable_shape()->add_dim()->set_size(k);
+  rhs->mutable_shape()->add_dim()->set_size(n);
+  return op_info;
+}
+
+TEST(OpCostCalibrationTableTest, RecordAndLookup) {
+  OpCostCalibrationTable table;
+  int64_t cost = 0;
+  EXPECT_FALSE(table.Lookup(MakeMatMulInfo(32, 64, 32), &cost));
+
+  // Repeated measurements of the same signature are averaged.
+  table.Record(MakeMatMulInfo(32, 64, 32), 1000);
+  table.Record(MakeMatMulInfo(32, 64, 32), 3000);
+  EXPECT_TRUE(table.Lookup(MakeMatMulInfo(32, 64, 32), &cost));
+  EXPECT_EQ(cost, 2000);
+
+  // A different shape is a different entry.
+  EXPECT_FALSE(table.Lookup(MakeMatMulInfo(32, 64, 64), &cost));
+  EXPECT_EQ(table.num_entries(), 1);
+}
+
+TEST(OpCostCalibrationTableTest, SaveAndLoadRoundTrip) {
+  OpCostCalibrationTable table;
+  table.Record(MakeMatMulInfo(32, 64, 32), 1000);
+  table.Record(MakeMatMulInfo(128, 128, 128), 50000);
+
+  const string path = io::JoinPath(testing::TmpDir(), "calibration.pbtxt");
+  TF_ASSERT_OK(table.SaveToFile(Env::Default(), path));
+
+  OpCostCalibrationTable loaded;
+  TF_ASSERT_OK(loaded.LoadFromFile(Env::Default(), path));
+  EXPECT_EQ(loaded.num_entries(), 2);
+  int64_t cost = 0;
+  EXPECT_TRUE(loaded.Lookup(MakeMatMulInfo(128, 128, 128), &cost));
+  EXPECT_EQ(cost, 50000);
+}
+
+TEST(MeasuredCostEstimatorTest, MeasuredCostBeforeAnalyticFallback) {
+  auto table = std::make_shared<OpCostCalibrationTable>();
+  table->Record(MakeMatMulInfo(32, 64, 32), 12345);
+  MeasuredCostEstimator estimator(table);
+
+  OpContext calibrated;
+  calibrated.op_info = MakeMatMulInfo(32, 64, 32);
+  Costs costs = estimator.PredictCosts(calibrated);
+  EXPECT_EQ(costs.execution_time, Costs::NanoSeconds(12345));
+  EXPECT_FALSE(costs.inaccurate);
+
+  // A signature missing from the table falls back to the analytic estimate.
+  OpContext uncalibrated;
+  uncalibrated.op_info = MakeMatMulInfo(512, 512, 512);
+  Costs analytic_costs = estimator.PredictCosts(uncalibrated);
+  EXPECT_GT(analytic_costs.execution_time, Costs::Duration::zero());
+  EXPECT_NE(analytic_costs.execution_time, Costs::NanoSeconds(12345));
+}
+
+}  // namespace
+}  // end namespace grappler
+}  // end namespace tensorflow
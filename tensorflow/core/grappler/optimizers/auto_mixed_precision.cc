@@ -43,6 +43,7 @@ limitations under the License.
 #include "tensorflow/core/lib/strings/numbers.h"
 #include "tensorflow/core/lib/strings/str_util.h"
 #include "tensorflow/core/lib/strings/strcat.h"
+#include "tensorflow/core/platform/cpu_info.h"
 #include "tensorflow/core/platform/logging.h"
 #include "tensorflow/core/platform/status.h"
 #include "tensorflow/core/platform/statusor.h"
@@ -1097,6 +1098,8 @@ class AutoMixedPrecisionImpl {
       std::vector<NodeTypeIdEdge>* implicit_fp32_edges) const;
   void AddAllowlistOps(absl::flat_hash_set<int>* allow_set) const;
   void RemoveAllowsetWithFp32(absl::flat_hash_set<int>* allow_set) const;
+  void RemoveAllowsetWithoutNetBenefit(
+      absl::flat_hash_set<int>* allow_set) const;
   void PropagateDenyFwdThroughClearAndInfer(
       absl::flat_hash_set<int>* deny_set) const;
   void ForceColorMatchBetweenTensorListOps(
@@ -1140,6 +1143,7 @@ class AutoMixedPrecisionImpl {
   GraphTypeTopologyView graph_type_view_;
   bool force_all_fp16_;
   bool treat_infer_as_deny_;
+  bool cast_aware_;
   AutoMixedPrecisionMode mode_;
   gtl::FlatSet<string> f16_allowlist_;
   gtl::FlatSet<string> f16_denylist_;
@@ -1395,6 +1399,13 @@ Status AutoMixedPrecisionImpl::Optimize() {
   treat_infer_as_deny_ = optimization_level == "TREAT_INFER_AS_DENY";
   VLOG(2) << "Optimization Level: " << optimization_level;
 
+  // Opt-in cost-aware planning: demote allow regions whose boundary cast
+  // overhead is expected to outweigh the f16 speedup.
+  cast_aware_ = false;
+  TF_RETURN_IF_ERROR(
+      ReadBoolFromEnvVar("TF_AUTO_MIXED_PRECISION_GRAPH_REWRITE_CAST_AWARE",
+                         /*default_val=*/false, &cast_aware_));
+
   std::unique_ptr<AutoMixedPrecisionLists> mp_lists =
       get_mixed_precision_lists();
   f16_allowlist_ = mp_lists->AllowList();
@@ -1534,6 +1545,13 @@ Status AutoMixedPrecisionImpl::Optimize() {
   RemoveAllowsetWithFp32(&allow_set);
   VLOG(2) << "Finished pass 6";
 
+  if (cast_aware_ && !force_all_fp16_ && !ShouldIgnorePerformance()) {
+    VLOG(2) << "Beginning pass 7 to remove allow regions whose boundary cast "
+               "overhead outweighs the expected f16 benefit";
+    RemoveAllowsetWithoutNetBenefit(&allow_set);
+    VLOG(2) << "Finished pass 7";
+  }
+
   VLOG(2) << "Forcing color match between data structure ops";
   for (const auto& cluster : tensor_list_clusters) {
     ForceColorMatchBetweenTensorListOps(cluster, &allow_set, &deny_set);
@@ -1908,6 +1926,80 @@ void AutoMixedPrecisionImpl::RemoveAllowsetWithFp32(
   }
 }
 
+// Demotes connected regions of the allow set whose conversion is unlikely to
+// pay for itself. Converting a region costs one Cast on every float32 edge
+// crossing its boundary; the benefit comes from the allowlist
+// (performance-critical) ops inside it. Regions that contain no allowlist op,
+// or whose boundary cast count exceeds the allowlist op count by more than a
+// configurable ratio, are reverted to float32 so we do not trade matmul time
+// for cast time.
+void AutoMixedPrecisionImpl::RemoveAllowsetWithoutNetBenefit(
+    absl::flat_hash_set<int>* allow_set) const {
+  static const float cast_overhead_ratio = [] {
+    float ratio = 2.0f;
+    TF_CHECK_OK(ReadFloatFromEnvVar(
+        "TF_AUTO_MIXED_PRECISION_GRAPH_REWRITE_CAST_OVERHEAD_RATIO",
+        /*default_val=*/2.0f, &ratio));
+    return ratio;
+  }();
+  absl::flat_hash_set<int> visited;
+  std::vector<int> component;
+  std::vector<int> stack;
+  for (int root_idx = 0; root_idx < graph_type_view_.num_nodes(); ++root_idx) {
+    if (!allow_set->count(root_idx) || visited.count(root_idx)) continue;
+    component.clear();
+    stack.assign(1, root_idx);
+    visited.insert(root_idx);
+    int num_allowlist_ops = 0;
+    int num_boundary_casts = 0;
+    while (!stack.empty()) {
+      int idx = stack.back();
+      stack.pop_back();
+      component.push_back(idx);
+      const NodeTypeId& item = *graph_type_view_.GetNode(idx);
+      if (f16_allowlist_.count(item.node->op())) {
+        ++num_allowlist_ops;
+      }
+      const auto visit_neighbor = [&](int neighbor) {
+        if (allow_set->count(neighbor)) {
+          if (visited.insert(neighbor).second) {
+            stack.push_back(neighbor);
+          }
+        } else if (IsFloat32(*graph_type_view_.GetNode(neighbor))) {
+          // A Cast will be inserted on this boundary edge.
+          ++num_boundary_casts;
+        }
+      };
+      for (const int fanin : graph_type_view_.GetFanin(idx)) {
+        visit_neighbor(fanin);
+      }
+      for (const int fanout : graph_type_view_.GetFanout(idx)) {
+        visit_neighbor(fanout);
+      }
+    }
+    if (num_allowlist_ops > 0 &&
+        static_cast<float>(num_boundary_casts) <=
+            cast_overhead_ratio * static_cast<float>(num_allowlist_ops)) {
+      continue;
+    }
+    VLOG(1) << "Demoting allow region of " << component.size()
+            << " node types (" << num_allowlist_ops << " allowlist ops, "
+            << num_boundary_casts
+            << " boundary casts): conversion is not expected to be "
+               "profitable";
+    for (const int idx : component) {
+      allow_set->erase(idx);
+      if (VLOG_IS_ON(2)) {
+        const NodeTypeId& item = *graph_type_view_.GetNode(idx);
+        VLOG(2) << "UnPainting type " << item.type_attr.DebugString()
+                << " of node " << item.node->name()
+                << " ALLOW because its region's cast overhead outweighs the "
+                   "f16 benefit";
+      }
+    }
+  }
+}
+
 // Forces NextIteration nodes and their output Merge node(s) to have the same
 // color. Specifically, it removes them all from allow_set if any of the Merge
 // nodes is not in allow_set, otherwise it adds the NextIteration node to
@@ -2274,6 +2366,29 @@ int GetNumGPUs(const Cluster& cluster) {
   return num_gpus;
 }
 
+// Returns true if this host executes bfloat16 matmuls natively (AMX-BF16 on
+// Sapphire Rapids, AVX512-BF16 on Cooper Lake). On older hosts oneDNN
+// emulates bf16 through fp32 upconversion, which generally loses to plain
+// fp32 once the inserted Casts are paid for.
+bool HasNativeBf16Support() {
+  return port::TestCPUFeature(port::CPUFeature::AMX_BF16) ||
+         port::TestCPUFeature(port::CPUFeature::AVX512_BF16);
+}
+
+// If true, the bf16 rewrite is skipped on hosts without native bf16
+// execution units, so one saved artifact can be deployed fleet-wide: capable
+// hosts convert at graph-optimization time, older hosts keep running fp32.
+bool RequireNativeBf16() {
+  static bool is_enabled = [] {
+    bool ret = false;
+    TF_CHECK_OK(ReadBoolFromEnvVar(
+        "TF_AUTO_MIXED_PRECISION_GRAPH_REWRITE_REQUIRE_NATIVE_BF16",
+        /*default_val=*/false, &ret));
+    return ret;
+  }();
+  return is_enabled;
+}
+
 }  // end namespace
 
 Status AutoMixedPrecision::Optimize(Cluster* cluster, const GrapplerItem& item,
@@ -2297,6 +2412,15 @@ Status AutoMixedPrecision::Optimize(Cluster* cluster, const GrapplerItem& item,
   // Start by copying input graph to output.
   *output = item.graph;
 
+  if (mode_ == AutoMixedPrecisionMode::BF16 && RequireNativeBf16() &&
+      !HasNativeBf16Support() && !ShouldIgnorePerformance()) {
+    LOG(WARNING) << "Skipping " << name()
+                 << " graph optimizer: this host has no native bfloat16 "
+                    "support (AMX-BF16 or AVX512-BF16); the graph will run "
+                    "in float32";
+    return OkStatus();
+  }
+
   int num_gpus = GetNumGPUs(*cluster);
   if (num_gpus < 1 && mode_ == AutoMixedPrecisionMode::CUDA) {
     // AutoMixedPrecision is currently only tuned for GPU.
@@ -1309,6 +1309,43 @@ TEST_F(AutoMixedPrecisionCpuTest, Simple) {
   }
 }
 
+TEST_F(AutoMixedPrecisionCpuTest, CastAwareSkipsUnprofitableRegion) {
+  // With cast-aware planning enabled, a region with a single allowlist op
+  // surrounded by many float32 boundaries is not converted, so no Casts are
+  // inserted at all.
+  setenv("TF_AUTO_MIXED_PRECISION_GRAPH_REWRITE_CAST_AWARE", "1",
+         1 /* replace */);
+  tensorflow::Scope s = tensorflow::Scope::NewRootScope().WithDevice(
+      "/job:localhost/replica:0/task:0/device:CPU:0");
+  Output input = ops::Const(s.WithOpName("input"), 1.f / 32, {32, 32});
+  Output deny1 = ops::Exp(s.WithOpName("deny1"), input);
+  Output clr1 = ops::Relu(s.WithOpName("clr1"), deny1);
+  Output infer1 = ops::Sqrt(s.WithOpName("infer1"), clr1);
+  Output clr2 = ops::Relu(s.WithOpName("clr2"), infer1);
+  Output allow1 = ops::MatMul(s.WithOpName("allow1"), clr2, clr2);
+  Output clr3 = ops::Relu(s.WithOpName("clr3"), allow1);
+  Output infer2 = ops::Log(s.WithOpName("infer2"), clr3);
+  Output clr4 = ops::Relu(s.WithOpName("clr4"), infer2);
+  Output deny2 = ops::SparseMatMul(s.WithOpName("deny2"), clr4, clr4);
+  Output clr5 = ops::Relu(s.WithOpName("clr5"), deny2);
+  Output fetch = ops::Identity(s.WithOpName("fetch"), clr5);
+
+  GrapplerItem item;
+  item.fetch = {"fetch"};
+  TF_CHECK_OK(s.ToGraphDef(&item.graph));
+
+  AutoMixedPrecision optimizer{AutoMixedPrecisionMode::CPU};
+  GraphDef output;
+  TF_ASSERT_OK(optimizer.Optimize(virtual_cluster_.get(), item, &output));
+  unsetenv("TF_AUTO_MIXED_PRECISION_GRAPH_REWRITE_CAST_AWARE");
+
+  VLOG(1) << output.DebugString();
+
+  EXPECT_EQ(output.node_size(), item.graph.node_size());
+  GraphView output_view(&output);
+  EXPECT_EQ(output_view.GetNode("allow1")->attr().at("T").type(), DT_FLOAT);
+}
+
 TEST_F(AutoMixedPrecisionCpuTest, MixedFanout) {
   // Test when an FP16 allowed node has a mixed fanout of FP16 allowed node and
   // FP32 node.
@@ -25,6 +25,7 @@ limitations under the License.
 #include "absl/strings/substitute.h"
 #include "tensorflow/core/framework/allocator.h"
 #include "tensorflow/core/framework/attr_value.pb.h"
+#include "tensorflow/core/framework/attr_value_util.h"
 #include "tensorflow/core/framework/function.pb.h"
 #include "tensorflow/core/framework/node_def.pb.h"
 #include "tensorflow/core/framework/node_def_util.h"
@@ -45,10 +46,13 @@ limitations under the License.
 #include "tensorflow/core/grappler/utils/symbolic_shapes.h"
 #include "tensorflow/core/lib/core/errors.h"
 #include "tensorflow/core/lib/core/stringpiece.h"
+#include "tensorflow/core/lib/core/threadpool.h"
 #include "tensorflow/core/lib/gtl/cleanup.h"
 #include "tensorflow/core/lib/gtl/inlined_vector.h"
+#include "tensorflow/core/lib/hash/hash.h"
 #include "tensorflow/core/lib/strings/numbers.h"
 #include "tensorflow/core/lib/strings/strcat.h"
+#include "tensorflow/core/platform/blocking_counter.h"
 #include "tensorflow/core/platform/cpu_info.h"
 #include "tensorflow/core/platform/denormal.h"
 #include "tensorflow/core/platform/env.h"
@@ -1516,15 +1520,21 @@ Status ConstantFolding::FoldMergeNode(NodeDef* node, GraphDef* output_graph) {
 }
 
 Status ConstantFolding::FoldNode(NodeDef* node, GraphDef* output_graph,
-                                 bool* result_too_large) {
-  *result_too_large = false;
+                                 bool* result_too_large,
+                                 std::vector<NodeDef>* evaluated_const_nodes) {
   if (IsMerge(*node)) {
+    *result_too_large = false;
     return FoldMergeNode(node, output_graph);
   }
 
-  std::vector<NodeDef> const_nodes;
-  TF_RETURN_IF_ERROR(
-      EvaluateOneFoldable(*node, &const_nodes, result_too_large));
+  std::vector<NodeDef> evaluated_here;
+  if (evaluated_const_nodes == nullptr) {
+    *result_too_large = false;
+    TF_RETURN_IF_ERROR(
+        EvaluateOneFoldable(*node, &evaluated_here, result_too_large));
+    evaluated_const_nodes = &evaluated_here;
+  }
+  std::vector<NodeDef>& const_nodes = *evaluated_const_nodes;
   VLOG(2) << "Folded node: " << SummarizeNodeDef(*node);
 
   NodeDef* constant_output = nullptr;
@@ -1641,6 +1651,50 @@ Status ConstantFolding::FoldNode(NodeDef* node, GraphDef* output_graph,
   return OkStatus();
 }
 
+uint64 ConstantFolding::FoldableNodeFingerprint(const NodeDef& node) {
+  uint64 h = Hash64(node.op());
+  h = Hash64Combine(Hash64(node.device()), h);
+  for (const auto& input : node.input()) {
+    const TensorId input_tensor = ParseTensorName(input);
+    uint64 input_hash = Hash64Combine(
+        Hash64(input_tensor.node().data(), input_tensor.node().size()),
+        std::hash<int>()(input_tensor.index()));
+    h = Hash64CombineUnordered(input_hash, h);
+  }
+  for (const auto& attr : node.attr()) {
+    uint64 attr_hash =
+        Hash64Combine(Hash64(attr.first), FastAttrValueHash(attr.second));
+    h = Hash64CombineUnordered(attr_hash, h);
+  }
+  return h;
+}
+
+bool ConstantFolding::SameFoldableExpression(const NodeDef& node,
+                                             const NodeDef& other) {
+  if (node.op() != other.op() || node.device() != other.device() ||
+      node.input_size() != other.input_size() ||
+      node.attr_size() != other.attr_size()) {
+    return false;
+  }
+  // Inputs are compared verbatim: the inputs of a foldable node are constants
+  // that do not change while the graph is folded, so equal input names imply
+  // equal input values.
+  for (int i = 0; i < node.input_size(); ++i) {
+    if (node.input(i) != other.input(i)) {
+      return false;
+    }
+  }
+  for (const auto& attr : node.attr()) {
+    auto it = other.attr().find(attr.first);
+    if (it == other.attr().end() ||
+        !AreAttrValuesEqual(attr.second, it->second,
+                            /*allow_false_negatives=*/true)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 Status ConstantFolding::FoldGraph(
     const GraphProperties& properties, GraphDef* optimized_graph,
     absl::flat_hash_set<string>* nodes_to_not_simplify) {
@@ -1655,30 +1709,132 @@ Status ConstantFolding::FoldGraph(
       queue.push_back(graph_->mutable_node(i));
     }
   }
-  while (!queue.empty()) {
-    NodeDef* node = queue.front();
-    queue.pop_front();
-    if (processed_nodes.count(node->name())) {
-      continue;
-    }
-    // We need to record a copy of output nodes before FoldNode() modifies it.
-    // We also need to ensure that the fanout is sorted deterministically.
-    std::vector<NodeDef*> fanout =
-        node_map_->GetOutputsOrderedByNodeName(node->name());
+  // Evaluation state for one node of the current batch.
+  struct Evaluation {
+    NodeDef* node;
+    Status status;
     bool result_too_large = false;
-    Status s = FoldNode(node, optimized_graph, &result_too_large);
-    processed_nodes.insert(node->name());
-    if (!s.ok()) {
-      VLOG(1) << "Failed to fold node " << node->DebugString()
-              << "\nError message: " << s;
-      if (result_too_large) {
-        nodes_to_not_simplify->emplace(node->name());
+    // Whether `const_nodes` holds the evaluated outputs of `node`, either
+    // from a fresh evaluation or from a memoized identical subexpression.
+    bool evaluated = false;
+    std::vector<NodeDef> const_nodes;
+    uint64 fingerprint = 0;
+  };
+  // Nodes in the queue never feed each other: a non-merge node only becomes
+  // foldable once all its regular inputs are constant, and its fanout is only
+  // enqueued after it has been folded. Each batch drained from the queue can
+  // therefore be evaluated concurrently, with the graph mutations applied
+  // serially afterwards in the original queue order, which folds exactly the
+  // same nodes in exactly the same order as a one-by-one traversal.
+  std::unique_ptr<thread::ThreadPool> eval_pool;
+  absl::flat_hash_map<uint64, FoldedSubexpression> folded_subexpressions;
+  while (!queue.empty()) {
+    std::vector<Evaluation> batch;
+    batch.reserve(queue.size());
+    absl::flat_hash_set<string> batch_names;
+    while (!queue.empty()) {
+      NodeDef* node = queue.front();
+      queue.pop_front();
+      if (processed_nodes.count(node->name()) ||
+          !batch_names.insert(node->name()).second) {
+        continue;
+      }
+      batch.push_back({node});
+    }
+    // Reuse the outputs of identical subexpressions folded earlier and
+    // collect the nodes that still have to be evaluated.
+    std::vector<Evaluation*> to_evaluate;
+    for (Evaluation& eval : batch) {
+      if (IsMerge(*eval.node)) {
+        // Merge nodes forward one of their inputs instead of being evaluated.
+        continue;
+      }
+      eval.fingerprint = FoldableNodeFingerprint(*eval.node);
+      auto it = folded_subexpressions.find(eval.fingerprint);
+      if (it != folded_subexpressions.end() &&
+          SameFoldableExpression(*eval.node, it->second.representative)) {
+        // Rename the memoized outputs for this node.
+        eval.const_nodes = it->second.const_nodes;
+        for (int i = 0, end = eval.const_nodes.size(); i < end; ++i) {
+          if (eval.const_nodes[i].name().empty()) {
+            // Dead output.
+            continue;
+          }
+          string node_name = OptimizedNodeName(*eval.node, "-folded");
+          if (end > 1) {
+            node_name = strings::StrCat(node_name, "-", i);
+          }
+          eval.const_nodes[i].set_name(node_name);
+        }
+        eval.evaluated = true;
+        continue;
+      }
+      to_evaluate.push_back(&eval);
+    }
+    if (to_evaluate.size() > 1 && eval_pool == nullptr) {
+      eval_pool.reset(new thread::ThreadPool(Env::Default(),
+                                             "constant_folding_eval",
+                                             port::NumSchedulableCPUs()));
+    }
+    if (to_evaluate.size() <= 1) {
+      for (Evaluation* eval : to_evaluate) {
+        eval->status = EvaluateOneFoldable(*eval->node, &eval->const_nodes,
+                                           &eval->result_too_large);
+        eval->evaluated = true;
       }
     } else {
-      for (auto& fanout_node : fanout) {
-        if (IsFoldable(*fanout_node, &properties) &&
-            !nodes_to_not_simplify->count(fanout_node->name())) {
-          queue.push_back(fanout_node);
+      BlockingCounter pending(to_evaluate.size());
+      for (Evaluation* eval : to_evaluate) {
+        eval_pool->Schedule([this, eval, &pending]() {
+          // Match the flush-to-zero and round-to-nearest environment that
+          // Optimize() establishes on the calling thread.
+          port::ScopedFlushDenormal flush;
+          port::ScopedSetRound round(FE_TONEAREST);
+          eval->status = EvaluateOneFoldable(*eval->node, &eval->const_nodes,
+                                             &eval->result_too_large);
+          eval->evaluated = true;
+          pending.DecrementCount();
+        });
+      }
+      pending.Wait();
+    }
+    // Memoize the newly evaluated expressions before folding mutates the
+    // nodes and their outputs.
+    for (Evaluation* eval : to_evaluate) {
+      if (eval->status.ok() &&
+          folded_subexpressions.find(eval->fingerprint) ==
+              folded_subexpressions.end()) {
+        folded_subexpressions.emplace(
+            eval->fingerprint,
+            FoldedSubexpression{*eval->node, eval->const_nodes});
+      }
+    }
+    for (Evaluation& eval : batch) {
+      NodeDef* node = eval.node;
+      // We need to record a copy of output nodes before FoldNode() modifies
+      // it. We also need to ensure that the fanout is sorted
+      // deterministically.
+      std::vector<NodeDef*> fanout =
+          node_map_->GetOutputsOrderedByNodeName(node->name());
+      bool result_too_large = eval.result_too_large;
+      Status s = eval.status;
+      if (s.ok()) {
+        s = FoldNode(node, optimized_graph, &result_too_large,
+                     eval.evaluated ? &eval.const_nodes : nullptr);
+      }
+      processed_nodes.insert(node->name());
+      if (!s.ok()) {
+        VLOG(1) << "Failed to fold node " << node->DebugString()
+                << "\nError message: " << s;
+        if (result_too_large) {
+          nodes_to_not_simplify->emplace(node->name());
+        }
+      } else {
+        for (auto& fanout_node : fanout) {
+          if (IsFoldable(*fanout_node, &properties) &&
+              !nodes_to_not_simplify->count(fanout_node->name())) {
+            queue.push_back(fanout_node);
+          }
         }
       }
     }
@@ -96,8 +96,30 @@ class ConstantFolding : public GraphOptimizer {
                              bool* result_too_large);
 
   Status FoldMergeNode(NodeDef* node, GraphDef* output_graph);
+  // Folds `node`. If `evaluated_const_nodes` is non-null it holds the
+  // already-evaluated constant outputs of `node` and no evaluation is
+  // performed here; the vector may be mutated to forward control dependencies.
   Status FoldNode(NodeDef* node, GraphDef* output_graph,
-                  bool* result_too_large);
+                  bool* result_too_large,
+                  std::vector<NodeDef>* evaluated_const_nodes);
+
+  // Memoized evaluation of one foldable expression, shared between nodes that
+  // compute the same op with the same attrs over the same constant inputs.
+  struct FoldedSubexpression {
+    // Snapshot of the first node that evaluated to `const_nodes`, taken
+    // before folding mutated it. Used to rule out fingerprint collisions.
+    NodeDef representative;
+    std::vector<NodeDef> const_nodes;
+  };
+
+  // Computes a fingerprint of the expression evaluated by a foldable
+  // non-merge node from its op, device, inputs and attrs, using the same
+  // hash-consing scheme as `CommonSubgraphElimination`.
+  static uint64 FoldableNodeFingerprint(const NodeDef& node);
+
+  // Whether `node` and `other` evaluate the same expression, i.e. a
+  // fingerprint match is not a collision.
+  static bool SameFoldableExpression(const NodeDef& node, const NodeDef& other);
 
   bool IsOnes(const NodeDef& node) const;
   bool IsZeros(const NodeDef& node) const;
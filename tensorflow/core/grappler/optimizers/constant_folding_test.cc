@@ -313,6 +313,47 @@ TEST_F(ConstantFoldingTest, SimpleFolding) {
   test::ExpectTensorEqual<float>(tensors_expected[0], tensors[0]);
 }
 
+TEST_F(ConstantFoldingTest, RepeatedSubexpressions) {
+  // Identical foldable subexpressions share a single evaluation; all copies
+  // must still fold to the correct constant.
+  tensorflow::Scope s = tensorflow::Scope::NewRootScope();
+
+  Output a = ops::Const(s.WithOpName("a"), 1.0f, {2});
+  Output b = ops::Const(s.WithOpName("b"), 2.0f, {2});
+  Output x = ops::Placeholder(s.WithOpName("x"), DT_FLOAT,
+                              ops::Placeholder::Shape(TensorShape({2})));
+  Output add1 = ops::Add(s.WithOpName("add1"), a, b);
+  Output add2 = ops::Add(s.WithOpName("add2"), a, b);
+  Output mul1 = ops::Mul(s.WithOpName("mul1"), add1, x);
+  Output mul2 = ops::Mul(s.WithOpName("mul2"), add2, x);
+
+  GrapplerItem item;
+  item.fetch = {"mul1", "mul2"};
+  TF_CHECK_OK(s.ToGraphDef(&item.graph));
+
+  ConstantFolding optimizer(/*cpu_device=*/nullptr);
+  GraphDef output;
+  Status status = optimizer.Optimize(/*cluster=*/nullptr, item, &output);
+  TF_EXPECT_OK(status);
+
+  int found = 0;
+  for (const auto& node : output.node()) {
+    if (node.name() == "add1" || node.name() == "add2") {
+      ++found;
+      EXPECT_EQ("Const", node.op());
+    }
+  }
+  EXPECT_EQ(2, found);
+
+  auto x_t = GenerateRandomTensor<DT_FLOAT>(TensorShape({2}));
+  auto tensors_expected = EvaluateNodes(item.graph, item.fetch, {{"x", x_t}});
+  auto tensors = EvaluateNodes(output, item.fetch, {{"x", x_t}});
+  ASSERT_EQ(2, tensors.size());
+  for (int i = 0; i < 2; ++i) {
+    test::ExpectTensorEqual<float>(tensors_expected[i], tensors[i]);
+  }
+}
+
 TEST_F(ConstantFoldingTest, AddTree) {
   tensorflow::Scope s = tensorflow::Scope::NewRootScope();
 
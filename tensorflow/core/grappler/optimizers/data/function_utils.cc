@@ -230,6 +230,57 @@ bool IsNodeStateful(const FunctionLibraryDefinition& library,
   return true;
 }
 
+const FunctionDef* MaybeUnwrapFunctionCall(
+    const FunctionLibraryDefinition& library,
+    const FunctionDef& function_def) {
+  const FunctionDef* current = &function_def;
+  // Bound the descent to guard against malformed cyclic libraries.
+  constexpr int kMaxUnwrapDepth = 10;
+  for (int depth = 0; depth < kMaxUnwrapDepth; ++depth) {
+    if (current->node_def_size() != 1) return current;
+    const NodeDef& call = current->node_def(0);
+    if (call.op() != "PartitionedCall" &&
+        call.op() != "StatefulPartitionedCall") {
+      return current;
+    }
+    auto func_attr_it = call.attr().find("f");
+    if (func_attr_it == call.attr().end() ||
+        !func_attr_it->second.has_func()) {
+      return current;
+    }
+    const FunctionDef* inner = library.Find(func_attr_it->second.func().name());
+    if (inner == nullptr) return current;
+    const OpDef& signature = current->signature();
+    if (signature.input_arg_size() != inner->signature().input_arg_size() ||
+        signature.output_arg_size() != inner->signature().output_arg_size()) {
+      return current;
+    }
+    // All arguments must be forwarded to the call unchanged, in order. A
+    // control input would mean the wrapper does more than delegate.
+    if (call.input_size() != signature.input_arg_size()) return current;
+    bool is_trivial = true;
+    for (int i = 0; i < signature.input_arg_size(); ++i) {
+      if (call.input(i) != signature.input_arg(i).name()) {
+        is_trivial = false;
+        break;
+      }
+    }
+    if (!is_trivial) return current;
+    // All call outputs must be returned unchanged, in order.
+    for (int i = 0; i < signature.output_arg_size(); ++i) {
+      auto ret_it = current->ret().find(signature.output_arg(i).name());
+      if (ret_it == current->ret().end() ||
+          ret_it->second != strings::StrCat(call.name(), ":output:", i)) {
+        is_trivial = false;
+        break;
+      }
+    }
+    if (!is_trivial) return current;
+    current = inner;
+  }
+  return current;
+}
+
 }  // namespace function_utils
 }  // namespace grappler
 }  // namespace tensorflow
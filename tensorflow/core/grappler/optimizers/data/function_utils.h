@@ -121,6 +121,16 @@ bool IsFunctionStateful(const FunctionLibraryDefinition& library,
 bool IsNodeStateful(const FunctionLibraryDefinition& library,
                     const NodeDef& node, bool skip_assert = false);
 
+// If `function_def` is a trivial wrapper around another library function --
+// i.e. its body is a single PartitionedCall or StatefulPartitionedCall whose
+// operands are the function's arguments in order and whose outputs are
+// returned unchanged -- returns the wrapped function. Otherwise returns
+// `function_def`. Nested wrappers are followed. Dataset UDFs built from
+// `tf.function`s commonly have this shape, which hides the real function body
+// from fusion optimizations.
+const FunctionDef* MaybeUnwrapFunctionCall(
+    const FunctionLibraryDefinition& library, const FunctionDef& function_def);
+
 }  // end namespace function_utils
 }  // end namespace grappler
 }  // end namespace tensorflow
@@ -858,6 +858,35 @@ TEST(FunctionUtilsTest, IsFunctionStateful) {
   EXPECT_FALSE(IsFunctionStateful(while_lib, *while_function));
   EXPECT_FALSE(IsFunctionStateful(while_lib, *while_function, true));
 }
+
+TEST(FunctionUtilsTest, MaybeUnwrapFunctionCall) {
+  GraphDef graph_def;
+  FunctionDef* inner = graph_def.mutable_library()->add_function();
+  *inner = test::function::XTimesTwo();
+
+  FunctionDef* wrapper = graph_def.mutable_library()->add_function();
+  *wrapper = FunctionDefHelper::Create(
+      "Wrapper", {"x: float"}, {"y: float"}, {},
+      {{{"call"},
+        "StatefulPartitionedCall",
+        {"x"},
+        {{"Tin", DataTypeSlice{DT_FLOAT}},
+         {"Tout", DataTypeSlice{DT_FLOAT}},
+         {"f",
+          FunctionDefHelper::FunctionRef("XTimesTwo", {{"T", DT_FLOAT}})}}}},
+      {{"y", "call:output:0"}});
+
+  FunctionLibraryDefinition lib_def(OpRegistry::Global(), graph_def.library());
+
+  // A trivial wrapper is replaced by the function it delegates to.
+  const FunctionDef* unwrapped =
+      MaybeUnwrapFunctionCall(lib_def, *lib_def.Find("Wrapper"));
+  EXPECT_EQ(unwrapped->signature().name(), "XTimesTwo");
+
+  // A function with a real body is returned unchanged.
+  const FunctionDef* not_a_wrapper = lib_def.Find("XTimesTwo");
+  EXPECT_EQ(MaybeUnwrapFunctionCall(lib_def, *not_a_wrapper), not_a_wrapper);
+}
 }  // namespace
 }  // namespace function_utils
 }  // namespace grappler
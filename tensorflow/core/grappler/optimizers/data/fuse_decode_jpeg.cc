@@ -0,0 +1,308 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/grappler/optimizers/data/fuse_decode_jpeg.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "tensorflow/core/framework/attr_value.pb.h"
+#include "tensorflow/core/framework/function.pb.h"
+#include "tensorflow/core/framework/node_def.pb.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor.pb.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/framework/types.pb.h"
+#include "tensorflow/core/grappler/clusters/cluster.h"
+#include "tensorflow/core/grappler/grappler_item.h"
+#include "tensorflow/core/grappler/optimizers/custom_graph_optimizer_registry.h"
+#include "tensorflow/core/grappler/optimizers/data/function_utils.h"
+#include "tensorflow/core/lib/strings/strcat.h"
+#include "tensorflow/core/platform/protobuf.h"
+
+namespace tensorflow {
+namespace grappler {
+namespace {
+
+constexpr char kDecodeJpegOp[] = "DecodeJpeg";
+constexpr char kDecodeAndCropJpegOp[] = "DecodeAndCropJpeg";
+constexpr char kSliceOp[] = "Slice";
+constexpr char kConstOp[] = "Const";
+constexpr char kExpandDimsOp[] = "ExpandDims";
+
+// Attributes shared by DecodeJpeg and DecodeAndCropJpeg.
+constexpr const char* kDecodeAttrs[] = {"channels",
+                                        "ratio",
+                                        "fancy_upscaling",
+                                        "try_recover_truncated",
+                                        "acceptable_fraction",
+                                        "dct_method"};
+
+string NodeNameOfInput(const string& input) {
+  if (!input.empty() && input[0] == '^') {
+    return input.substr(1);
+  }
+  return function_utils::FunctionDefTensorDesc(input).node_name;
+}
+
+// Counts how many node inputs and function outputs reference any output of
+// the node with the given name.
+int CountReferences(const FunctionDef& function, const string& node_name) {
+  int count = 0;
+  for (const NodeDef& node : function.node_def()) {
+    for (const string& input : node.input()) {
+      if (NodeNameOfInput(input) == node_name) ++count;
+    }
+  }
+  for (const auto& ret : function.ret()) {
+    if (NodeNameOfInput(ret.second) == node_name) ++count;
+  }
+  return count;
+}
+
+// Returns the index of the node producing `input`, or -1 if `input` is a
+// function argument.
+int FindProducer(const string& input, const FunctionDef& function) {
+  return function_utils::FindFunctionNodeWithName(NodeNameOfInput(input),
+                                                  function);
+}
+
+// If `input` is produced by a Const node holding a 1-D int32 or int64 tensor,
+// stores its values and returns true.
+bool GetConstIntVector(const FunctionDef& function, const string& input,
+                       std::vector<int64_t>* values) {
+  int index = FindProducer(input, function);
+  if (index == -1) return false;
+  const NodeDef& node = function.node_def(index);
+  if (node.op() != kConstOp) return false;
+  auto it = node.attr().find("value");
+  if (it == node.attr().end()) return false;
+  Tensor tensor;
+  if (!tensor.FromProto(it->second.tensor())) return false;
+  if (tensor.dims() != 1) return false;
+  values->clear();
+  values->reserve(tensor.NumElements());
+  if (tensor.dtype() == DT_INT32) {
+    for (int64_t i = 0; i < tensor.NumElements(); ++i) {
+      values->push_back(tensor.vec<int32>()(i));
+    }
+  } else if (tensor.dtype() == DT_INT64) {
+    for (int64_t i = 0; i < tensor.NumElements(); ++i) {
+      values->push_back(tensor.vec<int64_t>()(i));
+    }
+  } else {
+    return false;
+  }
+  return true;
+}
+
+// Removes the node with the given name from the function, if present.
+void RemoveNode(const string& node_name, FunctionDef* function) {
+  int index = function_utils::FindFunctionNodeWithName(node_name, *function);
+  if (index != -1) {
+    function->mutable_node_def()->DeleteSubrange(index, 1);
+  }
+}
+
+// Rewrites one DecodeJpeg -> Slice pattern in `function` into
+// DecodeAndCropJpeg.  Returns true if a rewrite was performed.
+bool FuseCropOnce(FunctionDef* function) {
+  for (int i = 0; i < function->node_def_size(); ++i) {
+    const NodeDef& slice = function->node_def(i);
+    if (slice.op() != kSliceOp || slice.input_size() < 3) continue;
+
+    int decode_index = FindProducer(slice.input(0), *function);
+    if (decode_index == -1) continue;
+    // Copy the nodes: adding nodes below may reallocate the repeated field.
+    const NodeDef decode = function->node_def(decode_index);
+    if (decode.op() != kDecodeJpegOp) continue;
+    // The decoded full image must have no other consumers, otherwise it is
+    // still needed at full resolution.
+    if (CountReferences(*function, decode.name()) != 1) continue;
+
+    std::vector<int64_t> begin;
+    std::vector<int64_t> size;
+    if (!GetConstIntVector(*function, slice.input(1), &begin) ||
+        !GetConstIntVector(*function, slice.input(2), &size)) {
+      continue;
+    }
+    if (begin.size() != 3 || size.size() != 3) continue;
+    // The crop must keep all channels and have a statically known extent.
+    if (begin[0] < 0 || begin[1] < 0 || begin[2] != 0) continue;
+    if (size[0] <= 0 || size[1] <= 0 || size[2] != -1) continue;
+
+    const string slice_name = slice.name();
+    // Only rewrite references in the canonical "node:output:position" (or
+    // position-less) form, so no dangling reference can survive the removal
+    // of the slice node below.
+    bool all_references_canonical = true;
+    const string canonical_ref = strings::StrCat(slice_name, ":output:0");
+    const string short_ref = strings::StrCat(slice_name, ":output");
+    auto is_canonical = [&](const string& input) {
+      return NodeNameOfInput(input) != slice_name ||
+             input == canonical_ref || input == short_ref;
+    };
+    for (const NodeDef& node : function->node_def()) {
+      for (const string& input : node.input()) {
+        if (!is_canonical(input)) all_references_canonical = false;
+      }
+    }
+    for (const auto& ret : function->ret()) {
+      if (!is_canonical(ret.second)) all_references_canonical = false;
+    }
+    if (!all_references_canonical) continue;
+
+    // Materialize the crop window as [y, x, height, width].
+    Tensor window(DT_INT32, TensorShape({4}));
+    window.vec<int32>()(0) = begin[0];
+    window.vec<int32>()(1) = begin[1];
+    window.vec<int32>()(2) = size[0];
+    window.vec<int32>()(3) = size[1];
+    AttrValue dtype_attr;
+    dtype_attr.set_type(DT_INT32);
+    AttrValue value_attr;
+    window.AsProtoTensorContent(value_attr.mutable_tensor());
+    NodeDef* crop_window = function_utils::AddNode(
+        /*name=*/"", kConstOp, /*inputs=*/{},
+        {{"dtype", dtype_attr}, {"value", value_attr}}, function);
+    function_utils::SetUniqueFunctionNodeName(
+        strings::StrCat(decode.name(), "/crop_window"), function, crop_window);
+    const string crop_window_name = crop_window->name();
+
+    NodeDef* fused = function_utils::AddNode(
+        /*name=*/"", kDecodeAndCropJpegOp,
+        {decode.input(0), strings::StrCat(crop_window_name, ":output:0")},
+        /*attributes=*/{}, function);
+    function_utils::SetUniqueFunctionNodeName(
+        strings::StrCat(decode.name(), "/fused"), function, fused);
+    for (const char* attr_name : kDecodeAttrs) {
+      auto it = decode.attr().find(attr_name);
+      if (it != decode.attr().end()) {
+        (*fused->mutable_attr())[attr_name] = it->second;
+      }
+    }
+
+    const string fused_name = fused->name();
+    function_utils::ReplaceReferences(
+        canonical_ref, strings::StrCat(fused_name, ":image:0"), function);
+    function_utils::ReplaceReferences(
+        short_ref, strings::StrCat(fused_name, ":image"), function);
+    RemoveNode(slice_name, function);
+    RemoveNode(decode.name(), function);
+    return true;
+  }
+  return false;
+}
+
+// If a DecodeAndCropJpeg with a constant crop window feeds (possibly through
+// ExpandDims) a Resize op with a constant target size at most half the crop
+// in both dimensions, decodes at the largest DCT scaling ratio that still
+// covers the target and shrinks the crop window accordingly.  Returns true if
+// a rewrite was performed.
+bool FuseRatioOnce(FunctionDef* function) {
+  for (int i = 0; i < function->node_def_size(); ++i) {
+    const NodeDef& resize = function->node_def(i);
+    if (resize.op() != "ResizeBilinear" &&
+        resize.op() != "ResizeNearestNeighbor" &&
+        resize.op() != "ResizeArea") {
+      continue;
+    }
+    if (resize.input_size() < 2) continue;
+
+    int producer_index = FindProducer(resize.input(0), *function);
+    if (producer_index == -1) continue;
+    int decode_index = producer_index;
+    if (function->node_def(producer_index).op() == kExpandDimsOp) {
+      const NodeDef& expand = function->node_def(producer_index);
+      if (CountReferences(*function, expand.name()) != 1) continue;
+      decode_index = FindProducer(expand.input(0), *function);
+      if (decode_index == -1) continue;
+    }
+    NodeDef* decode = function->mutable_node_def(decode_index);
+    if (decode->op() != kDecodeAndCropJpegOp) continue;
+    auto ratio_it = decode->attr().find("ratio");
+    if (ratio_it != decode->attr().end() && ratio_it->second.i() != 1) {
+      continue;
+    }
+    if (CountReferences(*function, decode->name()) != 1) continue;
+
+    // The crop window must be a constant consumed only by this decode so it
+    // can be rescaled in place.
+    int window_index = FindProducer(decode->input(1), *function);
+    if (window_index == -1) continue;
+    std::vector<int64_t> window;
+    if (!GetConstIntVector(*function, decode->input(1), &window)) continue;
+    if (window.size() != 4) continue;
+    if (CountReferences(*function,
+                        function->node_def(window_index).name()) != 1) {
+      continue;
+    }
+
+    std::vector<int64_t> target;
+    if (!GetConstIntVector(*function, resize.input(1), &target)) continue;
+    if (target.size() != 2 || target[0] <= 0 || target[1] <= 0) continue;
+
+    const int64_t height = window[2];
+    const int64_t width = window[3];
+    int64_t ratio = 0;
+    for (int64_t r : {8, 4, 2}) {
+      if (height / r >= target[0] && width / r >= target[1]) {
+        ratio = r;
+        break;
+      }
+    }
+    if (ratio == 0) continue;
+
+    // Rescale the crop window into the coordinates of the scaled decode,
+    // rounding the extent up so the target region stays covered.
+    Tensor scaled_window(DT_INT32, TensorShape({4}));
+    scaled_window.vec<int32>()(0) = window[0] / ratio;
+    scaled_window.vec<int32>()(1) = window[1] / ratio;
+    scaled_window.vec<int32>()(2) = (window[2] + ratio - 1) / ratio;
+    scaled_window.vec<int32>()(3) = (window[3] + ratio - 1) / ratio;
+    NodeDef* window_node = function->mutable_node_def(window_index);
+    scaled_window.AsProtoTensorContent(
+        (*window_node->mutable_attr())["value"].mutable_tensor());
+    (*window_node->mutable_attr())["dtype"].set_type(DT_INT32);
+    (*decode->mutable_attr())["ratio"].set_i(ratio);
+    return true;
+  }
+  return false;
+}
+
+}  // namespace
+
+Status FuseDecodeJpeg::OptimizeAndCollectStats(Cluster* cluster,
+                                               const GrapplerItem& item,
+                                               GraphDef* output,
+                                               OptimizationStats* stats) {
+  *output = item.graph;
+  for (FunctionDef& function :
+       *output->mutable_library()->mutable_function()) {
+    while (FuseCropOnce(&function)) {
+      stats->num_changes++;
+    }
+    while (FuseRatioOnce(&function)) {
+      stats->num_changes++;
+    }
+  }
+  return OkStatus();
+}
+
+REGISTER_GRAPH_OPTIMIZER_AS(FuseDecodeJpeg, "fuse_decode_jpeg");
+
+}  // namespace grappler
+}  // namespace tensorflow
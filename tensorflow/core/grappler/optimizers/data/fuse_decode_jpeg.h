@@ -0,0 +1,56 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_GRAPPLER_OPTIMIZERS_DATA_FUSE_DECODE_JPEG_H_
+#define TENSORFLOW_CORE_GRAPPLER_OPTIMIZERS_DATA_FUSE_DECODE_JPEG_H_
+
+#include "tensorflow/core/grappler/optimizers/data/optimizer_base.h"
+
+namespace tensorflow {
+namespace grappler {
+
+// This optimization rewrites DecodeJpeg -> Slice (crop) patterns inside
+// dataset functions into DecodeAndCropJpeg, which decodes only the cropped
+// region through libjpeg's region-of-interest API.  When the cropped image is
+// then downscaled by a constant factor of two or more with a Resize op, the
+// decode additionally uses libjpeg's 1/2, 1/4 or 1/8 DCT scaling via the
+// `ratio` attr, so most DCT coefficients are never fully decoded.
+//
+// The crop fusion is exact; DCT scaling produces a slightly different (but
+// spec-compliant) downscaled image than resizing the full-resolution decode,
+// which is why this optimization is opt-in.
+class FuseDecodeJpeg : public TFDataOptimizerBase {
+ public:
+  FuseDecodeJpeg() = default;
+  ~FuseDecodeJpeg() override = default;
+
+  string name() const override { return "fuse_decode_jpeg"; };
+
+  bool UsesFunctionLibrary() const override { return true; }
+
+  Status Init(
+      const tensorflow::RewriterConfig_CustomGraphOptimizer* config) override {
+    return OkStatus();
+  }
+
+  Status OptimizeAndCollectStats(Cluster* cluster, const GrapplerItem& item,
+                                 GraphDef* output,
+                                 OptimizationStats* stats) override;
+};
+
+}  // namespace grappler
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_GRAPPLER_OPTIMIZERS_DATA_FUSE_DECODE_JPEG_H_
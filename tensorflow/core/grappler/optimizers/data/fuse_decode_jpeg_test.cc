@@ -0,0 +1,159 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/grappler/optimizers/data/fuse_decode_jpeg.h"
+
+#include "tensorflow/core/framework/function.h"
+#include "tensorflow/core/framework/function_testlib.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_testutil.h"
+#include "tensorflow/core/grappler/grappler_item.h"
+#include "tensorflow/core/grappler/optimizers/data/function_utils.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace grappler {
+namespace {
+
+using FDH = FunctionDefHelper;
+
+// Returns the crop window tensor fed to the DecodeAndCropJpeg node in
+// `function`.
+Tensor GetCropWindow(const FunctionDef& function) {
+  int fused_index =
+      function_utils::FindFunctionNodeWithOp("DecodeAndCropJpeg", function);
+  CHECK_NE(fused_index, -1);
+  const NodeDef& fused = function.node_def(fused_index);
+  function_utils::FunctionDefTensorDesc desc(fused.input(1));
+  int window_index =
+      function_utils::FindFunctionNodeWithName(desc.node_name, function);
+  CHECK_NE(window_index, -1);
+  Tensor window;
+  CHECK(window.FromProto(
+      function.node_def(window_index).attr().at("value").tensor()));
+  return window;
+}
+
+TEST(FuseDecodeJpegTest, FusesDecodeAndCrop) {
+  FunctionDef function = FDH::Create(
+      "decode_crop", {"contents: string"}, {"image: uint8"}, {},
+      {
+          {{"decode"}, "DecodeJpeg", {"contents"}, {{"channels", 3}}},
+          FDH::Const<int32>("begin", {4, 8, 0}),
+          FDH::Const<int32>("size", {100, 200, -1}),
+          {{"crop"},
+           "Slice",
+           {"decode:image:0", "begin:output:0", "size:output:0"},
+           {{"T", DT_UINT8}, {"Index", DT_INT32}}},
+      },
+      {{"image", "crop:output:0"}});
+
+  GrapplerItem item;
+  *item.graph.mutable_library()->add_function() = function;
+
+  FuseDecodeJpeg optimizer;
+  GraphDef output;
+  TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &output));
+
+  const FunctionDef& rewritten = output.library().function(0);
+  EXPECT_TRUE(
+      function_utils::ContainsFunctionNodeWithOp("DecodeAndCropJpeg",
+                                                 rewritten));
+  EXPECT_FALSE(
+      function_utils::ContainsFunctionNodeWithOp("DecodeJpeg", rewritten));
+  EXPECT_FALSE(function_utils::ContainsFunctionNodeWithOp("Slice", rewritten));
+  test::ExpectTensorEqual<int32>(GetCropWindow(rewritten),
+                                 test::AsTensor<int32>({4, 8, 100, 200}));
+}
+
+TEST(FuseDecodeJpegTest, UsesDctScalingForConstantDownscale) {
+  FunctionDef function = FDH::Create(
+      "decode_crop_resize", {"contents: string"}, {"image: float"}, {},
+      {
+          {{"decode"}, "DecodeJpeg", {"contents"}, {{"channels", 3}}},
+          FDH::Const<int32>("begin", {4, 8, 0}),
+          FDH::Const<int32>("size", {100, 200, -1}),
+          {{"crop"},
+           "Slice",
+           {"decode:image:0", "begin:output:0", "size:output:0"},
+           {{"T", DT_UINT8}, {"Index", DT_INT32}}},
+          FDH::Const<int32>("axis", 0),
+          {{"expand"},
+           "ExpandDims",
+           {"crop:output:0", "axis:output:0"},
+           {{"T", DT_UINT8}, {"Tdim", DT_INT32}}},
+          FDH::Const<int32>("target", {25, 50}),
+          {{"resize"},
+           "ResizeBilinear",
+           {"expand:output:0", "target:output:0"},
+           {{"T", DT_UINT8}}},
+      },
+      {{"image", "resize:resized_images:0"}});
+
+  GrapplerItem item;
+  *item.graph.mutable_library()->add_function() = function;
+
+  FuseDecodeJpeg optimizer;
+  GraphDef output;
+  TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &output));
+
+  const FunctionDef& rewritten = output.library().function(0);
+  int fused_index =
+      function_utils::FindFunctionNodeWithOp("DecodeAndCropJpeg", rewritten);
+  ASSERT_NE(fused_index, -1);
+  // The 100x200 crop feeding a 25x50 resize decodes at 1/4 DCT scaling, with
+  // the crop window rescaled into the coordinates of the scaled image.
+  EXPECT_EQ(rewritten.node_def(fused_index).attr().at("ratio").i(), 4);
+  test::ExpectTensorEqual<int32>(GetCropWindow(rewritten),
+                                 test::AsTensor<int32>({1, 2, 25, 50}));
+  // The resize stays in place to produce the exact target size.
+  EXPECT_TRUE(
+      function_utils::ContainsFunctionNodeWithOp("ResizeBilinear", rewritten));
+}
+
+TEST(FuseDecodeJpegTest, DoesNotFuseDecodeWithOtherConsumers) {
+  FunctionDef function = FDH::Create(
+      "decode_crop_shared", {"contents: string"},
+      {"image: uint8", "full: uint8"}, {},
+      {
+          {{"decode"}, "DecodeJpeg", {"contents"}, {{"channels", 3}}},
+          FDH::Const<int32>("begin", {4, 8, 0}),
+          FDH::Const<int32>("size", {100, 200, -1}),
+          {{"crop"},
+           "Slice",
+           {"decode:image:0", "begin:output:0", "size:output:0"},
+           {{"T", DT_UINT8}, {"Index", DT_INT32}}},
+      },
+      {{"image", "crop:output:0"}, {"full", "decode:image:0"}});
+
+  GrapplerItem item;
+  *item.graph.mutable_library()->add_function() = function;
+
+  FuseDecodeJpeg optimizer;
+  GraphDef output;
+  TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &output));
+
+  const FunctionDef& rewritten = output.library().function(0);
+  EXPECT_TRUE(
+      function_utils::ContainsFunctionNodeWithOp("DecodeJpeg", rewritten));
+  EXPECT_FALSE(
+      function_utils::ContainsFunctionNodeWithOp("DecodeAndCropJpeg",
+                                                 rewritten));
+}
+
+}  // namespace
+}  // namespace grappler
+}  // namespace tensorflow
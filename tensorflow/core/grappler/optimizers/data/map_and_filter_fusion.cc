@@ -29,6 +29,7 @@ limitations under the License.
 #include "tensorflow/core/grappler/mutable_graph_view.h"
 #include "tensorflow/core/grappler/op_types.h"
 #include "tensorflow/core/grappler/optimizers/custom_graph_optimizer_registry.h"
+#include "tensorflow/core/grappler/optimizers/data/function_utils.h"
 #include "tensorflow/core/grappler/optimizers/data/fusion_utils.h"
 #include "tensorflow/core/grappler/optimizers/data/graph_utils.h"
 #include "tensorflow/core/grappler/utils.h"
@@ -195,6 +196,12 @@ Status MapAndFilterFusion::OptimizeAndCollectStats(Cluster* cluster,
         function_library.Find(parent_fun.func().name());
     const auto& fun = filter_node->attr().at("predicate");
     const FunctionDef* filter_func = function_library.Find(fun.func().name());
+    // UDFs built from `tf.function`s are often trivial wrappers around the
+    // real function; unwrap them so the fused function skips the indirection.
+    map_func =
+        function_utils::MaybeUnwrapFunctionCall(function_library, *map_func);
+    filter_func =
+        function_utils::MaybeUnwrapFunctionCall(function_library, *filter_func);
     if (!fusion_utils::CanCompose(map_func->signature(),
                                   filter_func->signature())) {
       VLOG(1) << "Can't fuse map and filter because the output signature of "
@@ -23,6 +23,7 @@ limitations under the License.
 #include "tensorflow/core/grappler/mutable_graph_view.h"
 #include "tensorflow/core/grappler/op_types.h"
 #include "tensorflow/core/grappler/optimizers/custom_graph_optimizer_registry.h"
+#include "tensorflow/core/grappler/optimizers/data/function_utils.h"
 #include "tensorflow/core/grappler/optimizers/data/fusion_utils.h"
 #include "tensorflow/core/grappler/optimizers/data/graph_utils.h"
 #include "tensorflow/core/grappler/utils.h"
@@ -108,6 +109,12 @@ Status MapFusion::OptimizeAndCollectStats(Cluster* cluster,
     const auto& fun = map_node->attr().at("f");
     const FunctionDef* func = function_library.Find(fun.func().name());
 
+    // UDFs built from `tf.function`s are often trivial wrappers around the
+    // real function; unwrap them so the fused function skips the indirection.
+    parent_func =
+        function_utils::MaybeUnwrapFunctionCall(function_library, *parent_func);
+    func = function_utils::MaybeUnwrapFunctionCall(function_library, *func);
+
     if (!fusion_utils::CanCompose(parent_func->signature(),
                                   func->signature())) {
       VLOG(1) << "Can't fuse two maps because the output signature of the "
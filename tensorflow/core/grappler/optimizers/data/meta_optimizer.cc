@@ -38,7 +38,7 @@ using ConfigMap =
     std::map<string, tensorflow::RewriterConfig_CustomGraphOptimizer>;
 
 // tf.data optimizations, in the order we want to perform them.
-constexpr std::array<const char*, 21> kTFDataOptimizations = {
+constexpr std::array<const char*, 23> kTFDataOptimizations = {
     "noop_elimination",
     "disable_intra_op_parallelism",
     "use_private_thread_pool",
@@ -46,6 +46,13 @@ constexpr std::array<const char*, 21> kTFDataOptimizations = {
     "map_fusion",
     "filter_fusion",
     "map_and_filter_fusion",
+    // Run map fusion a second time: map_and_filter_fusion rewrites
+    // map->filter->map chains into map->filter->map'->map, and only another
+    // map fusion round can collapse the two trailing maps.
+    "map_fusion",
+    // Runs after map fusion so decode->crop->resize chains that started in
+    // separate maps have been merged into one function.
+    "fuse_decode_jpeg",
     "map_parallelization",
     "map_and_batch_fusion",
     "batch_parallelization",
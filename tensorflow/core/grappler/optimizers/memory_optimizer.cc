@@ -43,6 +43,7 @@ limitations under the License.
 #include "tensorflow/core/lib/strings/str_util.h"
 #include "tensorflow/core/protobuf/rewriter_config.pb.h"
 #include "tensorflow/core/util/device_name_utils.h"
+#include "tensorflow/core/util/env_var.h"
 
 namespace tensorflow {
 namespace grappler {
@@ -86,6 +87,30 @@ std::unordered_set<string> GetCheapToRecomputeOps() {
   return cheap_ops;
 }
 
+// True if `node` is in the recomputation targets name scope, meaning its name
+// either begins with or contains the name scope. Defaults to "gradients/"
+// which will match any node name that begins with "gradients/" or contains
+// "/gradients/".
+bool IsRecomputationTarget(const NodeDef& node,
+                           const string& recomputation_targets_name_scope) {
+  return absl::StartsWith(node.name(), recomputation_targets_name_scope) ||
+         static_cast<int>(
+             node.name().find("/" + recomputation_targets_name_scope)) != -1;
+}
+
+// Per-device memory budget (in bytes) under which the automatic
+// rematerialization planner tries to bound peak memory, set via
+// TF_GRAPPLER_REMAT_BUDGET_BYTES. Zero (the default) disables the planner.
+int64_t RematerializationBudgetBytes() {
+  int64_t budget = 0;
+  Status status =
+      ReadInt64FromEnvVar("TF_GRAPPLER_REMAT_BUDGET_BYTES", 0, &budget);
+  if (!status.ok()) {
+    LOG(ERROR) << status.message();
+  }
+  return budget;
+}
+
 // Find recomputable ops which feed into target nodes.
 std::unordered_set<const NodeDef*> FindCandidateRecomputeNodes(
     const NodeMap& node_map, const GraphDef* graph,
@@ -461,15 +486,8 @@ void RecomputationRewritingPass(RewriterConfig::MemOptType optimization_level,
   }
   std::function<bool(const NodeDef&)> is_target =
       [&recomputation_targets_name_scope](const NodeDef& node) {
-        // Nodes whose inputs we may want to recompute. This matches node names
-        // that contain recomputation_targets_name_scope as a name scope,
-        // meaning it either begins with or contains the name scope.
-        // Defaults to "gradients/" which will match any node names that begins
-        // with "gradients/" or contains "/gradients/".
-        return absl::StartsWith(node.name(),
-                                recomputation_targets_name_scope) ||
-               static_cast<int>(node.name().find(
-                   "/" + recomputation_targets_name_scope)) != -1;
+        // Nodes whose inputs we may want to recompute.
+        return IsRecomputationTarget(node, recomputation_targets_name_scope);
       };
 
   if (optimization_level == RewriterConfig::RECOMPUTATION_HEURISTICS ||
@@ -512,6 +530,89 @@ void RecomputationRewritingPass(RewriterConfig::MemOptType optimization_level,
   }
 }
 
+// Automatic rematerialization planner. Uses the statically inferred memory
+// timeline to find devices whose peak usage exceeds `budget_bytes`, then
+// marks the producers of the largest tensors live at the peak with the
+// recompute hint, largest first, until the estimated savings cover the
+// excess. The regular recomputation rewriting pass then re-derives those
+// tensors from their inputs where the gradients need them, trading bounded
+// recompute work for peak memory. Returns true if any node was annotated.
+bool AnnotateRematerializationCandidates(
+    Cluster* cluster, GrapplerItem* item, int64_t budget_bytes,
+    const string& recomputation_targets_name_scope) {
+  GraphMemory memory(*item);
+  Status s = memory.InferStatically(cluster->GetDevices());
+  if (!s.ok()) {
+    VLOG(1) << "Failed to infer memory usage: " << s.message();
+    return false;
+  }
+
+  NodeMap node_map(&item->graph);
+  std::unordered_set<string> feeds;
+  for (const auto& feed : item->feed) {
+    feeds.insert(NodeName(feed.first));
+  }
+
+  bool annotated = false;
+  for (const auto& device : cluster->GetDevices()) {
+    const GraphMemory::MemoryUsage& mem_usage =
+        memory.GetPeakMemoryUsage(device.first);
+    if (mem_usage.used_memory <= budget_bytes) {
+      continue;
+    }
+    int64_t required_savings = mem_usage.used_memory - budget_bytes;
+
+    // Free the largest tensors first: each recomputation adds trigger and
+    // copy nodes, so fewer, bigger checkpoints keep the rewrite (and the
+    // recompute FLOPs) bounded.
+    std::vector<const GraphMemory::LiveTensor*> live_tensors;
+    live_tensors.reserve(mem_usage.live_tensors.size());
+    for (const auto& live : mem_usage.live_tensors) {
+      live_tensors.push_back(&live);
+    }
+    std::sort(live_tensors.begin(), live_tensors.end(),
+              [](const GraphMemory::LiveTensor* a,
+                 const GraphMemory::LiveTensor* b) {
+                return a->memory_used > b->memory_used;
+              });
+
+    for (const GraphMemory::LiveTensor* live : live_tensors) {
+      NodeDef* producer = node_map.GetNode(live->node);
+      if (producer == nullptr ||
+          producer->attr().count(kRecomputeHint) > 0 ||
+          feeds.count(producer->name()) > 0 ||
+          IsRecomputationTarget(*producer,
+                                recomputation_targets_name_scope) ||
+          IsPersistent(*producer) || !IsFreeOfSideEffect(*producer) ||
+          ModifiesFrameInfo(*producer)) {
+        continue;
+      }
+      // Only annotate producers whose output the gradients actually consume;
+      // the rewriting pass could not recompute anything else.
+      bool feeds_target = false;
+      for (const NodeDef* output : node_map.GetOutputs(producer->name())) {
+        if (IsRecomputationTarget(*output,
+                                  recomputation_targets_name_scope)) {
+          feeds_target = true;
+          break;
+        }
+      }
+      if (!feeds_target) {
+        continue;
+      }
+      VLOG(1) << "Will rematerialize " << producer->name() << " to free "
+              << live->memory_used << " bytes on " << device.first;
+      (*producer->mutable_attr())[kRecomputeHint].set_i(1);
+      annotated = true;
+      required_savings -= static_cast<int64_t>(live->memory_used);
+      if (required_savings <= 0) {
+        break;
+      }
+    }
+  }
+  return annotated;
+}
+
 bool SchedulingPass(Cluster* cluster, std::unique_ptr<GraphMemory>* memory_ptr,
                     GrapplerItem* item) {
   // Look for AddN nodes (and equivalent) and record input names.
@@ -1387,6 +1488,7 @@ Status MemoryOptimizer::Optimize(Cluster* cluster, const GrapplerItem& item,
       (optimization_level_ == RewriterConfig::RECOMPUTATION_HEURISTICS ||
        optimization_level_ == RewriterConfig::HEURISTICS ||
        optimization_level_ == RewriterConfig::MANUAL);
+  const int64_t remat_budget = RematerializationBudgetBytes();
   if (!run_recomputation_pass && nodes_to_relax.empty() && item.fetch.empty()) {
     return errors::Aborted("Nothing to do.");
   }
@@ -1394,10 +1496,20 @@ Status MemoryOptimizer::Optimize(Cluster* cluster, const GrapplerItem& item,
   GrapplerItem optimized_item(item);
   RelaxAssignNodes(nodes_to_relax, &optimized_item.graph);
 
-  if (run_recomputation_pass) {
-    RecomputationRewritingPass(optimization_level_,
-                               recomputation_targets_name_scope_,
-                               &optimized_item.graph, item);
+  // When a rematerialization budget is set, derive recompute hints from the
+  // inferred memory timeline; the rewriting pass below applies them like
+  // manual annotations.
+  bool annotated_remat_candidates = false;
+  if (remat_budget > 0 && cluster != nullptr && !item.fetch.empty()) {
+    annotated_remat_candidates = AnnotateRematerializationCandidates(
+        cluster, &optimized_item, remat_budget,
+        recomputation_targets_name_scope_);
+  }
+
+  if (run_recomputation_pass || annotated_remat_candidates) {
+    RecomputationRewritingPass(
+        run_recomputation_pass ? optimization_level_ : RewriterConfig::MANUAL,
+        recomputation_targets_name_scope_, &optimized_item.graph, item);
   }
 
   std::unordered_set<string> skip_list;
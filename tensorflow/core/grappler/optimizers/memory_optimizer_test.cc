@@ -20,6 +20,7 @@ limitations under the License.
 #include <utility>
 #include <vector>
 
+#include "absl/strings/match.h"
 #include "tensorflow/cc/ops/standard_ops.h"
 #include "tensorflow/core/framework/graph.pb.h"
 #include "tensorflow/core/framework/node_def.pb.h"
@@ -448,6 +449,39 @@ TEST_F(MemoryOptimizerTest, AccumulationRewrites) {
   }
 }
 
+TEST_F(MemoryOptimizerTest, BudgetDrivenRematerialization) {
+  setenv("TF_GRAPPLER_REMAT_BUDGET_BYTES", "16384", 1);
+  tensorflow::Scope s = tensorflow::Scope::NewRootScope();
+  Output a = ops::RandomNormal(s.WithOpName("a").WithDevice("/cpu:0"),
+                               {128, 128, 8}, DT_FLOAT);
+  Output b = ops::Square(s.WithOpName("b").WithDevice("/cpu:0"), a);
+  Output c = ops::Sqrt(s.WithOpName("c").WithDevice("/cpu:0"), b);
+  Output d = ops::AddN(s.WithOpName("gradients/d").WithDevice("/cpu:0"), {c});
+  Output e =
+      ops::AddN(s.WithOpName("gradients/e").WithDevice("/cpu:0"), {d, b});
+
+  GrapplerItem item;
+  TF_CHECK_OK(s.ToGraphDef(&item.graph));
+  item.fetch = {"gradients/e"};
+
+  std::unique_ptr<VirtualCluster> cluster(CreateVirtualCluster());
+  MemoryOptimizer optimizer(RewriterConfig::MANUAL);
+  GraphDef output;
+  Status status = optimizer.Optimize(cluster.get(), item, &output);
+  TF_EXPECT_OK(status);
+
+  // The planner should have checkpointed at least one large forward tensor
+  // and introduced a recomputed copy feeding the gradient nodes.
+  bool found_recomputed_node = false;
+  for (const auto& node : output.node()) {
+    if (absl::StartsWith(node.name(), "Recomputed/")) {
+      found_recomputed_node = true;
+    }
+  }
+  EXPECT_TRUE(found_recomputed_node);
+  unsetenv("TF_GRAPPLER_REMAT_BUDGET_BYTES");
+}
+
 class RelaxAllocatorConstraintsTest : public GrapplerTest {};
 
 TEST_F(RelaxAllocatorConstraintsTest, SameDevice) {
@@ -0,0 +1,183 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/grappler/optimizers/multi_tensor_apply.h"
+
+#include <map>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_join.h"
+#include "tensorflow/core/framework/attr_value.pb.h"
+#include "tensorflow/core/framework/attr_value_util.h"
+#include "tensorflow/core/framework/node_def.pb.h"
+#include "tensorflow/core/grappler/grappler_item.h"
+#include "tensorflow/core/grappler/optimizers/custom_graph_optimizer_registry.h"
+#include "tensorflow/core/grappler/utils.h"
+
+namespace tensorflow {
+namespace grappler {
+namespace {
+
+// Describes how to pack one resource apply op: which of its inputs are
+// variable resources, which are shared scalar hyperparameters, and which are
+// per-variable dense inputs (gradients/deltas).
+struct PackableApplySpec {
+  const char* packed_op;
+  std::vector<int> var_inputs;
+  std::vector<int> scalar_inputs;
+  std::vector<int> dense_inputs;
+  std::vector<const char*> attrs;
+};
+
+const std::map<string, PackableApplySpec>& PackableApplySpecs() {
+  static const auto* specs = new std::map<string, PackableApplySpec>{
+      {"ResourceApplyAdam",
+       {"_ResourceApplyAdamPacked",
+        /*var_inputs=*/{0, 1, 2},
+        /*scalar_inputs=*/{3, 4, 5, 6, 7, 8},
+        /*dense_inputs=*/{9},
+        /*attrs=*/{"T", "use_locking", "use_nesterov"}}},
+      {"ResourceApplyGradientDescent",
+       {"_ResourceApplyGradientDescentPacked",
+        /*var_inputs=*/{0},
+        /*scalar_inputs=*/{1},
+        /*dense_inputs=*/{2},
+        /*attrs=*/{"T", "use_locking"}}},
+  };
+  return *specs;
+}
+
+bool HasControlInput(const NodeDef& node) {
+  for (const string& input : node.input()) {
+    if (IsControlInput(input)) return true;
+  }
+  return false;
+}
+
+// Key under which apply nodes may be grouped: same op and device, same attr
+// values, and the same hyperparameter input tensors.
+string GroupKey(const NodeDef& node, const PackableApplySpec& spec) {
+  std::vector<string> parts = {node.op(), node.device()};
+  for (const char* attr : spec.attrs) {
+    const auto it = node.attr().find(attr);
+    parts.push_back(it == node.attr().end() ? "" : SummarizeAttrValue(it->second));
+  }
+  for (int index : spec.scalar_inputs) {
+    parts.push_back(node.input(index));
+  }
+  return absl::StrJoin(parts, "|");
+}
+
+}  // namespace
+
+Status MultiTensorApply::Optimize(Cluster* cluster, const GrapplerItem& item,
+                                  GraphDef* output) {
+  *output = item.graph;
+  const std::unordered_set<string> nodes_to_preserve = item.NodesToPreserve();
+
+  // Collect groupable apply nodes. Nodes with control inputs are left alone:
+  // resource apply ops have no data outputs, so excluding control inputs
+  // guarantees no group member can depend on another.
+  absl::flat_hash_map<string, std::vector<int>> groups;
+  for (int i = 0; i < output->node_size(); ++i) {
+    const NodeDef& node = output->node(i);
+    const auto spec_it = PackableApplySpecs().find(node.op());
+    if (spec_it == PackableApplySpecs().end()) continue;
+    if (nodes_to_preserve.count(node.name()) > 0) continue;
+    if (HasControlInput(node)) continue;
+    groups[GroupKey(node, spec_it->second)].push_back(i);
+  }
+
+  absl::flat_hash_set<int> packed_nodes;
+  absl::flat_hash_map<string, string> replaced_control_deps;
+  for (const auto& group : groups) {
+    const std::vector<int>& members = group.second;
+    if (members.size() < 2) continue;
+    const NodeDef& first = output->node(members[0]);
+    const PackableApplySpec& spec = PackableApplySpecs().at(first.op());
+
+    NodeDef* packed = output->add_node();
+    packed->set_name(AddPrefixToNodeName(first.name(), "MultiTensorApply"));
+    packed->set_op(spec.packed_op);
+    packed->set_device(first.device());
+    for (int index : spec.var_inputs) {
+      for (int member : members) {
+        packed->add_input(output->node(member).input(index));
+      }
+    }
+    for (int index : spec.scalar_inputs) {
+      packed->add_input(first.input(index));
+    }
+    for (int index : spec.dense_inputs) {
+      for (int member : members) {
+        packed->add_input(output->node(member).input(index));
+      }
+    }
+    for (const char* attr : spec.attrs) {
+      const auto it = first.attr().find(attr);
+      if (it != first.attr().end()) {
+        (*packed->mutable_attr())[attr] = it->second;
+      }
+    }
+    AttrValue num_packed;
+    num_packed.set_i(members.size());
+    (*packed->mutable_attr())["N"] = num_packed;
+
+    for (int member : members) {
+      packed_nodes.insert(member);
+      replaced_control_deps[absl::StrCat("^", output->node(member).name())] =
+          absl::StrCat("^", packed->name());
+    }
+  }
+
+  if (packed_nodes.empty()) return OkStatus();
+
+  // Redirect control dependencies on the packed members and drop the members.
+  GraphDef packed_graph;
+  packed_graph.mutable_node()->Reserve(output->node_size() -
+                                       packed_nodes.size());
+  for (int i = 0; i < output->node_size(); ++i) {
+    if (packed_nodes.contains(i)) continue;
+    NodeDef* node = packed_graph.add_node();
+    node->Swap(output->mutable_node(i));
+    absl::flat_hash_set<string> control_deps;
+    int pos = 0;
+    for (int j = 0; j < node->input_size(); ++j) {
+      string input = node->input(j);
+      if (IsControlInput(input)) {
+        const auto it = replaced_control_deps.find(input);
+        if (it != replaced_control_deps.end()) input = it->second;
+        // Redirection can produce duplicate control inputs; keep one.
+        if (!control_deps.insert(input).second) continue;
+      }
+      node->set_input(pos++, input);
+    }
+    node->mutable_input()->DeleteSubrange(pos, node->input_size() - pos);
+  }
+  *packed_graph.mutable_library() = output->library();
+  *packed_graph.mutable_versions() = output->versions();
+  *output = std::move(packed_graph);
+  return OkStatus();
+}
+
+REGISTER_GRAPH_OPTIMIZER_AS(MultiTensorApply, "multi_tensor_apply");
+
+}  // namespace grappler
+}  // namespace tensorflow
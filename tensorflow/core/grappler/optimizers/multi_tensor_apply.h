@@ -0,0 +1,59 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_GRAPPLER_OPTIMIZERS_MULTI_TENSOR_APPLY_H_
+#define TENSORFLOW_CORE_GRAPPLER_OPTIMIZERS_MULTI_TENSOR_APPLY_H_
+
+#include "tensorflow/core/grappler/optimizers/custom_graph_optimizer.h"
+#include "tensorflow/core/lib/core/status.h"
+
+namespace tensorflow {
+namespace grappler {
+
+// Groups compatible ResourceApply* optimizer update nodes into packed apply
+// ops (_ResourceApplyAdamPacked, _ResourceApplyGradientDescentPacked), so a
+// training step with hundreds of variables issues a handful of fused apply
+// ops instead of one tiny op per variable.
+//
+// Nodes are grouped only when they run the same update (same op, dtype,
+// device, attributes and hyperparameter input tensors) and carry no control
+// inputs; since the resource apply ops have no data outputs, the latter
+// guarantees the grouped nodes are mutually independent. Control dependencies
+// *on* the grouped nodes are redirected to the packed node.
+//
+// Registered as the custom graph optimizer "multi_tensor_apply"; enable it
+// through RewriterConfig.custom_optimizers.
+class MultiTensorApply : public CustomGraphOptimizer {
+ public:
+  MultiTensorApply() = default;
+  ~MultiTensorApply() override = default;
+
+  string name() const override { return "multi_tensor_apply"; };
+
+  bool UsesFunctionLibrary() const override { return false; }
+
+  Status Init(const tensorflow::RewriterConfig_CustomGraphOptimizer* config =
+                  nullptr) override {
+    return OkStatus();
+  }
+
+  Status Optimize(Cluster* cluster, const GrapplerItem& item,
+                  GraphDef* output) override;
+};
+
+}  // namespace grappler
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_GRAPPLER_OPTIMIZERS_MULTI_TENSOR_APPLY_H_
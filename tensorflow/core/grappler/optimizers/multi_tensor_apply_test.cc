@@ -0,0 +1,165 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/grappler/optimizers/multi_tensor_apply.h"
+
+#include "tensorflow/core/framework/function_testlib.h"
+#include "tensorflow/core/framework/node_def.pb.h"
+#include "tensorflow/core/framework/tensor_testutil.h"
+#include "tensorflow/core/grappler/grappler_item.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace grappler {
+namespace {
+
+using test::function::GDef;
+using test::function::NDef;
+
+constexpr char kDevice[] = "/job:localhost/replica:0/task:0/device:CPU:0";
+
+NodeDef VarHandle(const string& name) {
+  TensorShapeProto shape_proto;
+  shape_proto.add_dim()->set_size(2);
+  return NDef(name, "VarHandleOp", {},
+              {{"dtype", DT_FLOAT}, {"shape", shape_proto}}, kDevice);
+}
+
+NodeDef ScalarConst(const string& name, float value) {
+  return NDef(name, "Const", {},
+              {{"dtype", DT_FLOAT}, {"value", test::AsScalar<float>(value)}},
+              kDevice);
+}
+
+NodeDef ApplyGradientDescent(const string& name, const string& var,
+                             const string& alpha, const string& delta) {
+  return NDef(name, "ResourceApplyGradientDescent", {var, alpha, delta},
+              {{"T", DT_FLOAT}, {"use_locking", false}}, kDevice);
+}
+
+const NodeDef* FindNodeWithOp(const GraphDef& graph, const string& op) {
+  for (const NodeDef& node : graph.node()) {
+    if (node.op() == op) return &node;
+  }
+  return nullptr;
+}
+
+int CountNodesWithOp(const GraphDef& graph, const string& op) {
+  int count = 0;
+  for (const NodeDef& node : graph.node()) {
+    if (node.op() == op) count++;
+  }
+  return count;
+}
+
+TEST(MultiTensorApplyTest, PacksCompatibleApplies) {
+  GrapplerItem item;
+  item.graph = GDef(
+      {VarHandle("var0"), VarHandle("var1"), ScalarConst("lr", 0.1f),
+       NDef("delta0", "Const",
+            {},
+            {{"dtype", DT_FLOAT}, {"value", test::AsTensor<float>({1., 2.})}},
+            kDevice),
+       NDef("delta1", "Const",
+            {},
+            {{"dtype", DT_FLOAT}, {"value", test::AsTensor<float>({3., 4.})}},
+            kDevice),
+       ApplyGradientDescent("apply0", "var0", "lr", "delta0"),
+       ApplyGradientDescent("apply1", "var1", "lr", "delta1"),
+       NDef("train", "NoOp", {"^apply0", "^apply1"}, {}, kDevice)},
+      {});
+  item.fetch = {"train"};
+
+  MultiTensorApply optimizer;
+  GraphDef output;
+  TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &output));
+
+  EXPECT_EQ(CountNodesWithOp(output, "ResourceApplyGradientDescent"), 0);
+  const NodeDef* packed =
+      FindNodeWithOp(output, "_ResourceApplyGradientDescentPacked");
+  ASSERT_NE(packed, nullptr);
+  EXPECT_EQ(packed->attr().at("N").i(), 2);
+  ASSERT_EQ(packed->input_size(), 5);
+  EXPECT_EQ(packed->input(0), "var0");
+  EXPECT_EQ(packed->input(1), "var1");
+  EXPECT_EQ(packed->input(2), "lr");
+  EXPECT_EQ(packed->input(3), "delta0");
+  EXPECT_EQ(packed->input(4), "delta1");
+
+  // The control dependencies of the train op collapse onto the packed node.
+  const NodeDef* train = FindNodeWithOp(output, "NoOp");
+  ASSERT_NE(train, nullptr);
+  ASSERT_EQ(train->input_size(), 1);
+  EXPECT_EQ(train->input(0), "^" + packed->name());
+}
+
+TEST(MultiTensorApplyTest, DoesNotPackDifferentHyperparameters) {
+  GrapplerItem item;
+  item.graph = GDef(
+      {VarHandle("var0"), VarHandle("var1"), ScalarConst("lr0", 0.1f),
+       ScalarConst("lr1", 0.2f),
+       NDef("delta0", "Const",
+            {},
+            {{"dtype", DT_FLOAT}, {"value", test::AsTensor<float>({1., 2.})}},
+            kDevice),
+       NDef("delta1", "Const",
+            {},
+            {{"dtype", DT_FLOAT}, {"value", test::AsTensor<float>({3., 4.})}},
+            kDevice),
+       ApplyGradientDescent("apply0", "var0", "lr0", "delta0"),
+       ApplyGradientDescent("apply1", "var1", "lr1", "delta1"),
+       NDef("train", "NoOp", {"^apply0", "^apply1"}, {}, kDevice)},
+      {});
+  item.fetch = {"train"};
+
+  MultiTensorApply optimizer;
+  GraphDef output;
+  TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &output));
+
+  EXPECT_EQ(CountNodesWithOp(output, "ResourceApplyGradientDescent"), 2);
+  EXPECT_EQ(FindNodeWithOp(output, "_ResourceApplyGradientDescentPacked"),
+            nullptr);
+}
+
+TEST(MultiTensorApplyTest, DoesNotPackAppliesWithControlInputs) {
+  GrapplerItem item;
+  NodeDef gated = ApplyGradientDescent("apply1", "var1", "lr", "delta1");
+  gated.add_input("^apply0");
+  item.graph = GDef(
+      {VarHandle("var0"), VarHandle("var1"), ScalarConst("lr", 0.1f),
+       NDef("delta0", "Const",
+            {},
+            {{"dtype", DT_FLOAT}, {"value", test::AsTensor<float>({1., 2.})}},
+            kDevice),
+       NDef("delta1", "Const",
+            {},
+            {{"dtype", DT_FLOAT}, {"value", test::AsTensor<float>({3., 4.})}},
+            kDevice),
+       ApplyGradientDescent("apply0", "var0", "lr", "delta0"), gated,
+       NDef("train", "NoOp", {"^apply1"}, {}, kDevice)},
+      {});
+  item.fetch = {"train"};
+
+  MultiTensorApply optimizer;
+  GraphDef output;
+  TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &output));
+
+  EXPECT_EQ(CountNodesWithOp(output, "ResourceApplyGradientDescent"), 2);
+}
+
+}  // namespace
+}  // namespace grappler
+}  // namespace tensorflow
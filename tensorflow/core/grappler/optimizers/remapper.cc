@@ -37,6 +37,7 @@ limitations under the License.
 #include "tensorflow/core/grappler/utils/pattern_utils.h"
 #include "tensorflow/core/grappler/utils/symbolic_shapes.h"
 #include "tensorflow/core/grappler/utils/topological_sort.h"
+#include "tensorflow/core/graph/tensor_id.h"
 #include "tensorflow/core/lib/core/errors.h"
 #include "tensorflow/core/platform/logging.h"
 #include "tensorflow/core/protobuf/rewriter_config.pb.h"
@@ -72,6 +73,12 @@ namespace grappler {
 //   (1) FusedBatchNorm + <Activation>
 //   (2) FusedBatchNorm + SideInput + <Activation>
 //
+// Conv2D + FusedBatchNorm[is_training=false] -> Conv2D + BiasAdd
+//   Folds the normalization into the convolution filter when the filter and
+//   all four batch norm statistics are constants, so that constant folding
+//   removes the batch norm arithmetic from frozen inference graphs entirely.
+//   Opt-in via the TF_REMAPPER_FOLD_FROZEN_BATCH_NORM environment variable.
+//
 // Sigmoid + Mul -> _MklSwish  // This fusion only works on Intel CPU.
 //
 //
@@ -92,6 +99,7 @@ constexpr char kFusedDepthwiseConv2dNative[] = "_FusedDepthwiseConv2dNative";
 constexpr char kFusedBatchNormEx[] = "_FusedBatchNormEx";
 constexpr char kFusedBatchNormGradEx[] = "_FusedBatchNormGradEx";
 constexpr char kTensorToHashBucket[] = "_TensorToHashBucketFast";
+constexpr char kBatchStringToHashBucket[] = "_BatchStringToHashBucketFast";
 constexpr char kLeakyRelu[] = "LeakyRelu";
 constexpr char kMklFusedMish[] = "_MklFusedMish";
 constexpr char kRelu[] = "Relu";
@@ -167,6 +175,15 @@ struct TensorToHashBucket {
   int string_to_hash_bucket = kMissingIndex;
 };
 
+// Float MatMul with constant weights that can be replaced with the
+// dynamically quantized eight-bit _DynamicQuantizedMatMul.
+struct DynamicQuantizedMatMul {
+  DynamicQuantizedMatMul() = default;
+  explicit DynamicQuantizedMatMul(int matmul) : matmul(matmul) {}
+
+  int matmul = kMissingIndex;
+};
+
 // Pad followed by Conv3D/FusedConv3D
 struct PadWithConv3D {
   PadWithConv3D() = default;
@@ -386,6 +403,31 @@ bool BlasLtMatmulEnabled() {
   return is_enabled;
 }
 
+// Unlike the other toggles this one is re-read on every optimizer run, so a
+// serving binary can flip it between sessions.
+bool DynamicQuantizedMatMulEnabled() {
+  bool is_enabled = false;
+  TF_CHECK_OK(tensorflow::ReadBoolFromEnvVar(
+      "TF_USE_DYNAMIC_QUANTIZED_MATMUL", /*default_val=*/false, &is_enabled));
+  return is_enabled;
+}
+
+bool BatchStringToHashBucketEnabled() {
+  bool is_enabled = false;
+  TF_CHECK_OK(tensorflow::ReadBoolFromEnvVar(
+      "TF_USE_BATCH_STRING_TO_HASH_BUCKET", /*default_val=*/false,
+      &is_enabled));
+  return is_enabled;
+}
+
+bool FoldFrozenBatchNormEnabled() {
+  bool is_enabled = false;
+  TF_CHECK_OK(tensorflow::ReadBoolFromEnvVar(
+      "TF_REMAPPER_FOLD_FROZEN_BATCH_NORM", /*default_val=*/false,
+      &is_enabled));
+  return is_enabled;
+}
+
 bool IsGpuCompatibleDataFormat(const RemapperContext& ctx,
                                const NodeDef* conv2d) {
   DCHECK(IsConv2D(*conv2d)) << "Expected Conv2D op";
@@ -1090,6 +1132,62 @@ bool IsAddWithNoBroadcast(const RemapperContext& ctx, const NodeDef& node) {
   return false;
 }
 
+// Conv2D + FusedBatchNorm in inference mode where the filter and all four
+// batch norm statistics are statically known constants, so the normalization
+// can be folded into the convolution weights instead of fused into the kernel.
+// The pattern is also matched through a trailing Activation and Add node:
+// those nodes are visited before the batch norm, and the fold has to win over
+// the kernel fusions rooted at them.
+bool FindConv2DWithBatchNormWeightFold(const RemapperContext& ctx,
+                                       int node_index,
+                                       ContractionWithBatchNorm* matched) {
+  const auto* node_view = ctx.graph_view.GetNode(node_index);
+  const auto* node_def = node_view->node();
+
+  // Walk down a trailing Activation and Add to the FusedBatchNorm they
+  // consume; both are left in place for the regular contraction fusions.
+  if (IsSupportedActivation(*node_def, nullptr)) {
+    if (node_view->NumRegularFanins() < 1) return false;
+    node_view = node_view->GetRegularFanin(0).node_view();
+    node_def = node_view->node();
+  }
+  if (IsAdd(*node_def)) {
+    if (node_view->NumRegularFanins() < 2) return false;
+    const auto* add_fanin_0 = node_view->GetRegularFanin(0).node_view();
+    const auto* add_fanin_1 = node_view->GetRegularFanin(1).node_view();
+    if (IsFusedBatchNorm(*add_fanin_0->node())) {
+      node_view = add_fanin_0;
+    } else if (IsFusedBatchNorm(*add_fanin_1->node())) {
+      node_view = add_fanin_1;
+    } else {
+      return false;
+    }
+    node_def = node_view->node();
+  }
+
+  // The folded expressions are materialized by constant folding in float.
+  if (GetDataTypeFromAttr(*node_def, "T") != DT_FLOAT) return false;
+
+  if (!FindConv2DWithBatchNorm(ctx, node_view->node_index(), matched))
+    return false;
+
+  // The fold only pays off if every rewritten input has a statically known
+  // value: scale, offset, mean and variance for the batch norm and the filter
+  // for the convolution.
+  const auto& props = ctx.graph_properties.GetInputProperties(node_def->name());
+  if (props.size() != 5 || !props[1].has_value() || !props[2].has_value() ||
+      !props[3].has_value() || !props[4].has_value()) {
+    return false;
+  }
+  const auto* conv2d_node_def =
+      ctx.graph_view.GetNode(matched->contraction)->node();
+  const auto& conv2d_props =
+      ctx.graph_properties.GetInputProperties(conv2d_node_def->name());
+  if (conv2d_props.size() < 2 || !conv2d_props[1].has_value()) return false;
+
+  return true;
+}
+
 bool FindPadWithConv3D(const RemapperContext& ctx, int node_index,
                        PadWithConv3D* matched) {
   if (!IsMKLEnabled()) return false;
@@ -1572,9 +1670,11 @@ bool FindMatMulBiasAddAndGelu(RemapperContext* ctx, int node_index,
                               std::map<string, int>* matched_nodes_map,
                               std::set<int>* remove_node_indices,
                               bool* is_gelu_approximate) {
-  // Gelu fusion is enabled with oneDNN or cublasLt or cuDNN library.
+  // Gelu fusion is enabled with oneDNN, cublasLt or cuDNN library, and with
+  // the Eigen based _FusedMatMul kernel for nodes placed on CPU.
   if (!IsMKLEnabled() && !BlasLtMatmulEnabled() &&
-      !RuntimeFusionEnabled(cluster))
+      !RuntimeFusionEnabled(cluster) &&
+      !NodeIsOnCpu(ctx->graph_view.GetNode(node_index)->node()))
     return false;
 
   using utils::MatchingDirection;
@@ -1691,7 +1791,9 @@ bool FindMatMulBiasAddAndGelu(RemapperContext* ctx, int node_index,
         ctx->graph_view.GetNode(matched_nodes_map->at("matmul"))->node();
     DataType matmul_dtype = GetDataTypeFromAttr(*matmul_node, "T");
 
-    bool cpu_ok = IsMKLEnabled() && IsCpuCompatibleMatMul(*ctx, matmul_node);
+    // The Eigen based _FusedMatMul kernel supports the Gelu epilogues, so the
+    // fusion does not require oneDNN on CPU.
+    bool cpu_ok = IsCpuCompatibleMatMul(*ctx, matmul_node);
     // Currently, the fusion is not supported on CPU for transpose_a in the
     // MatMul op.
     cpu_ok = cpu_ok && matmul_node->attr().contains("transpose_a") &&
@@ -1728,7 +1830,9 @@ bool FindMatMulBiasAddAndGelu(RemapperContext* ctx, int node_index,
 
     // matmul_node is already the _FusedMatMul and we don't need to check its
     // data type again.
-    if (!IsMKLEnabled() && !NodeIsOnGpu(matmul_node)) return false;
+    if (!IsMKLEnabled() && !NodeIsOnGpu(matmul_node) &&
+        !NodeIsOnCpu(matmul_node))
+      return false;
 
     // Currently, the fusion is not supported on CPU for transpose_a in the
     // MatMul op.
@@ -1762,6 +1866,116 @@ bool FindMatMulBiasAddAndGelu(RemapperContext* ctx, int node_index,
   return (found_gelu_exact || found_gelu_approximate);
 }
 
+// Finds the scaled dot-product attention subgraph
+//   BatchMatMul(Softmax(Mul(BatchMatMul(query, key), scale)), value)
+// so that it can be replaced with a single _FusedAttention node, which
+// computes the same result without materializing the full score matrix.
+bool HasTrueBoolAttr(const NodeDef& node, const string& name) {
+  return node.attr().contains(name) && node.attr().at(name).b();
+}
+
+bool FindFusedAttention(RemapperContext* ctx, int node_index,
+                        std::map<string, int>* matched_nodes_map,
+                        std::set<int>* remove_node_indices, float* scale,
+                        bool* transpose_key) {
+  using utils::MatchingDirection;
+  using utils::NodeStatus;
+
+  // The CPU kernel registered for _FusedAttention is float-only.
+  const auto* output_node_view = ctx->graph_view.GetNode(node_index);
+  const auto* output_node_def = output_node_view->node();
+  if (!NodeIsOnCpu(output_node_def)) return false;
+  if (!HasDataType(output_node_def, DT_FLOAT)) return false;
+
+  // `Mul` is commutative, so try the scale constant in either position.
+  // clang-format off
+  utils::OpTypePattern attention_pattern_scale_last =
+    {"BatchMatMulV2|BatchMatMul", "output", NodeStatus::kReplace,
+      {
+        {"Softmax", "softmax", NodeStatus::kRemove,
+          {
+            {"Mul", "scale_mul", NodeStatus::kRemove,
+              {
+                {"BatchMatMulV2|BatchMatMul", "qk_matmul", NodeStatus::kRemove,
+                  {
+                    {"*", "query", NodeStatus::kRemain},
+                    {"*", "key", NodeStatus::kRemain}
+                  }
+                },
+                {"Const", "scale", NodeStatus::kRemain}
+              }
+            }
+          }
+        },
+        {"*", "value", NodeStatus::kRemain}
+      }
+    };
+  utils::OpTypePattern attention_pattern_scale_first =
+    {"BatchMatMulV2|BatchMatMul", "output", NodeStatus::kReplace,
+      {
+        {"Softmax", "softmax", NodeStatus::kRemove,
+          {
+            {"Mul", "scale_mul", NodeStatus::kRemove,
+              {
+                {"Const", "scale", NodeStatus::kRemain},
+                {"BatchMatMulV2|BatchMatMul", "qk_matmul", NodeStatus::kRemove,
+                  {
+                    {"*", "query", NodeStatus::kRemain},
+                    {"*", "key", NodeStatus::kRemain}
+                  }
+                }
+              }
+            }
+          }
+        },
+        {"*", "value", NodeStatus::kRemain}
+      }
+    };
+  // clang-format on
+
+  utils::SubGraphMatcher<MatchingDirection::kFollowInputs> graph_matcher(
+      &(ctx->graph_view));
+  matched_nodes_map->clear();
+  remove_node_indices->clear();
+  bool found_op_type_match = graph_matcher.GetMatchedNodes(
+      attention_pattern_scale_last, ctx->nodes_to_preserve,
+      ctx->graph_view.GetNode(node_index), matched_nodes_map,
+      remove_node_indices);
+  if (!found_op_type_match) {
+    matched_nodes_map->clear();
+    remove_node_indices->clear();
+    found_op_type_match = graph_matcher.GetMatchedNodes(
+        attention_pattern_scale_first, ctx->nodes_to_preserve,
+        ctx->graph_view.GetNode(node_index), matched_nodes_map,
+        remove_node_indices);
+  }
+  if (!found_op_type_match) return false;
+
+  // The fused kernel handles a transposed key operand but not a transposed
+  // query, and the softmax output feeding the second BatchMatMul is never
+  // transposed.
+  const NodeDef* qk_matmul =
+      ctx->graph_view.GetNode(matched_nodes_map->at("qk_matmul"))->node();
+  if (HasTrueBoolAttr(*qk_matmul, "adj_x")) return false;
+  if (HasTrueBoolAttr(*output_node_def, "adj_x") ||
+      HasTrueBoolAttr(*output_node_def, "adj_y")) {
+    return false;
+  }
+  *transpose_key = HasTrueBoolAttr(*qk_matmul, "adj_y");
+
+  // Only fuse when the scale is a scalar constant; its value is folded into
+  // the fused node's attribute.
+  const NodeDef* scale_node =
+      ctx->graph_view.GetNode(matched_nodes_map->at("scale"))->node();
+  Tensor scale_tensor;
+  if (!scale_tensor.FromProto(scale_node->attr().at("value").tensor()) ||
+      scale_tensor.NumElements() != 1 || scale_tensor.dtype() != DT_FLOAT) {
+    return false;
+  }
+  *scale = scale_tensor.flat<float>()(0);
+  return true;
+}
+
 bool FindMulAndMaximum(RemapperContext* ctx, int node_index,
                        std::map<string, int>* matched_nodes_map,
                        std::set<int>* remove_node_indices, float* alpha) {
@@ -2670,6 +2884,41 @@ bool FindTensorToHashBucket(const RemapperContext& ctx, int node_index,
   return true;
 }
 
+bool FindDynamicQuantizedMatMul(const RemapperContext& ctx, int node_index,
+                                DynamicQuantizedMatMul* matched) {
+  // Root of the pattern must be an untransposed fp32 MatMul on CPU.
+  const auto* node_view = ctx.graph_view.GetNode(node_index);
+  const auto* node_def = node_view->node();
+
+  if (!IsMatMul(*node_def) || !NodeIsOnCpu(node_def) ||
+      !HasDataType(node_def, DT_FLOAT)) {
+    return false;
+  }
+
+  bool transpose_a;
+  bool transpose_b;
+  if (!GetNodeAttr(*node_def, "transpose_a", &transpose_a).ok() ||
+      transpose_a) {
+    return false;
+  }
+  if (!GetNodeAttr(*node_def, "transpose_b", &transpose_b).ok() ||
+      transpose_b) {
+    return false;
+  }
+
+  if (node_view->NumRegularFanins() < 2) return false;
+
+  // The weights must be constant so the kernel can quantize them once and
+  // reuse the quantization across calls.
+  const auto& regular_fanin_1 = node_view->GetRegularFanin(1);
+  const auto* weights_node_def = regular_fanin_1.node_view()->node();
+  if (!IsConstant(*weights_node_def)) return false;
+
+  matched->matmul = node_index;
+
+  return true;
+}
+
 bool FindFusedBatchMatMul(RemapperContext* ctx, int node_index,
                           std::map<string, int>* matched_nodes_map,
                           std::set<int>* remove_node_indices,
@@ -3633,6 +3882,43 @@ Status AddFusedMatMulBiasAddAndGelu(
   return OkStatus();
 }
 
+Status AddFusedAttentionNode(RemapperContext* ctx,
+                             const std::map<string, int>& matched_nodes_map,
+                             const std::set<int>& remove_node_indices,
+                             std::vector<bool>* invalidated_nodes,
+                             std::vector<bool>* nodes_to_delete, float scale,
+                             bool transpose_key) {
+  auto* output_node =
+      ctx->graph_view.GetNode(matched_nodes_map.at("output"))->node();
+  auto* qk_matmul_node =
+      ctx->graph_view.GetNode(matched_nodes_map.at("qk_matmul"))->node();
+
+  NodeDef fused_node;
+  // Fused node should have the name of terminal node of the fusion.
+  fused_node.set_name(output_node->name());
+  fused_node.set_op("_FusedAttention");
+  fused_node.set_device(output_node->device());
+  fused_node.add_input(qk_matmul_node->input(0));
+  fused_node.add_input(qk_matmul_node->input(1));
+  fused_node.add_input(output_node->input(1));
+  auto* attr = fused_node.mutable_attr();
+  (*attr)["T"] = output_node->attr().at("T");
+  SetAttrValue(scale, &(*attr)["scale"]);
+  SetAttrValue(transpose_key, &(*attr)["transpose_key"]);
+
+  utils::Mutation* mutation = ctx->graph_view.GetMutationBuilder();
+  Status status;
+  mutation->AddNode(std::move(fused_node), &status);
+  TF_RETURN_IF_ERROR(status);
+  TF_RETURN_IF_ERROR(mutation->Apply());
+  (*invalidated_nodes)[matched_nodes_map.at("output")] = true;
+
+  for (const auto& node_idx : remove_node_indices) {
+    (*nodes_to_delete)[node_idx] = true;
+  }
+  return OkStatus();
+}
+
 Status AddMklLayerNorm(RemapperContext* ctx,
                        const std::map<string, int>& matched_nodes_map,
                        const std::set<int>& remove_node_indices,
@@ -4071,6 +4357,132 @@ Status AddBatchNormNodes(RemapperContext* ctx, const FusedBatchNorm& matched) {
   return mutation->Apply();
 }
 
+Status AddFoldedConv2DWithBatchNorm(RemapperContext* ctx,
+                                    const ContractionWithBatchNorm& matched) {
+  const GraphDef* graph = ctx->graph_view.graph();
+  const NodeDef& fused_node = graph->node(matched.fused_batch_norm);
+  const NodeDef& conv_node = graph->node(matched.contraction);
+  VLOG(2) << "Folding frozen batch norm into Conv2D weights:"
+          << " batch_norm=" << fused_node.name()
+          << " conv2d=" << conv_node.name();
+
+  const string& scale = fused_node.input(1);
+  const string& offset = fused_node.input(2);
+  const string& mean = fused_node.input(3);
+  const string& variance = fused_node.input(4);
+  const string& filter = conv_node.input(1);
+
+  utils::Mutation* mutation = ctx->graph_view.GetMutationBuilder();
+  Status status;
+
+  float epsilon = 0.0f;
+  if (fused_node.attr().count("epsilon")) {
+    epsilon = fused_node.attr().at("epsilon").f();
+  }
+  DataType dtype = fused_node.attr().at("T").type();
+  Tensor value(dtype, TensorShape());
+  value.scalar<float>()() = epsilon;
+  NodeDef variance_epsilon;
+  const string variance_epsilon_name =
+      AddPrefixToNodeName("Epsilon", fused_node.name());
+  TF_RETURN_IF_ERROR(ConstantFolding::CreateNodeDef(
+      variance_epsilon_name, TensorValue(&value), &variance_epsilon));
+  variance_epsilon.set_device(fused_node.device());
+  mutation->AddNode(std::move(variance_epsilon), &status);
+  TF_RETURN_IF_ERROR(status);
+
+  NodeDef variance_plus_epsilon;
+  const string variance_plus_epsilon_name =
+      AddPrefixToNodeName("VarPlusEpsilon", fused_node.name());
+  variance_plus_epsilon.set_name(variance_plus_epsilon_name);
+  variance_plus_epsilon.set_op("Add");
+  (*variance_plus_epsilon.mutable_attr())["T"].set_type(dtype);
+  variance_plus_epsilon.set_device(fused_node.device());
+  *variance_plus_epsilon.add_input() = variance;
+  *variance_plus_epsilon.add_input() = variance_epsilon_name;
+  mutation->AddNode(std::move(variance_plus_epsilon), &status);
+  TF_RETURN_IF_ERROR(status);
+
+  NodeDef inv;
+  const string inv_name = AddPrefixToNodeName("Inv", fused_node.name());
+  inv.set_name(inv_name);
+  inv.set_op("Rsqrt");
+  inv.set_device(fused_node.device());
+  (*inv.mutable_attr())["T"].set_type(dtype);
+  *inv.add_input() = variance_plus_epsilon_name;
+  mutation->AddNode(std::move(inv), &status);
+  TF_RETURN_IF_ERROR(status);
+
+  NodeDef scaled;
+  const string scaled_name = AddPrefixToNodeName("Scaled", fused_node.name());
+  scaled.set_name(scaled_name);
+  scaled.set_op("Mul");
+  scaled.set_device(fused_node.device());
+  (*scaled.mutable_attr())["T"].set_type(dtype);
+  *scaled.add_input() = inv_name;
+  *scaled.add_input() = scale;
+  mutation->AddNode(std::move(scaled), &status);
+  TF_RETURN_IF_ERROR(status);
+
+  // The Conv2D filter is laid out as [H, W, in_channels, out_channels]
+  // regardless of the data format, so multiplying by the per-output-channel
+  // scaling vector broadcasts along the last dimension.
+  NodeDef scaled_filter;
+  const string scaled_filter_name =
+      AddPrefixToNodeName("ScaledFilter", fused_node.name());
+  scaled_filter.set_name(scaled_filter_name);
+  scaled_filter.set_op("Mul");
+  scaled_filter.set_device(fused_node.device());
+  (*scaled_filter.mutable_attr())["T"].set_type(dtype);
+  *scaled_filter.add_input() = filter;
+  *scaled_filter.add_input() = scaled_name;
+  mutation->AddNode(std::move(scaled_filter), &status);
+  TF_RETURN_IF_ERROR(status);
+
+  NodeDef scaled_mean;
+  const string scaled_mean_name =
+      AddPrefixToNodeName("ScaledMean", fused_node.name());
+  scaled_mean.set_name(scaled_mean_name);
+  scaled_mean.set_op("Mul");
+  scaled_mean.set_device(fused_node.device());
+  (*scaled_mean.mutable_attr())["T"].set_type(dtype);
+  *scaled_mean.add_input() = mean;
+  *scaled_mean.add_input() = scaled_name;
+  mutation->AddNode(std::move(scaled_mean), &status);
+  TF_RETURN_IF_ERROR(status);
+
+  NodeDef bias;
+  const string bias_name = AddPrefixToNodeName("Offset", fused_node.name());
+  bias.set_name(bias_name);
+  bias.set_op("Sub");
+  bias.set_device(fused_node.device());
+  (*bias.mutable_attr())["T"].set_type(dtype);
+  *bias.add_input() = offset;
+  *bias.add_input() = scaled_mean_name;
+  mutation->AddNode(std::move(bias), &status);
+  TF_RETURN_IF_ERROR(status);
+
+  // Point the convolution at the rescaled filter and collapse the batch norm
+  // itself into a BiasAdd, keeping its name so fanouts stay valid. Downstream
+  // Add/Activation nodes then fuse through the regular contraction patterns.
+  auto* conv_node_view = ctx->graph_view.GetNode(matched.contraction);
+  mutation->AddOrUpdateRegularFanin(conv_node_view, 1,
+                                    TensorId(scaled_filter_name, 0));
+
+  NodeDef bias_add;
+  bias_add.set_name(fused_node.name());
+  bias_add.set_op("BiasAdd");
+  bias_add.set_device(fused_node.device());
+  *bias_add.add_input() = fused_node.input(0);
+  *bias_add.add_input() = bias_name;
+  (*bias_add.mutable_attr())["T"].set_type(dtype);
+  (*bias_add.mutable_attr())[kDataFormat] = fused_node.attr().at(kDataFormat);
+  mutation->AddNode(std::move(bias_add), &status);
+  TF_RETURN_IF_ERROR(status);
+
+  return mutation->Apply();
+}
+
 Status AddTensorToHashBucketNode(RemapperContext* ctx,
                                  const TensorToHashBucket& matched,
                                  std::vector<bool>* invalidated_nodes,
@@ -4109,6 +4521,103 @@ Status AddTensorToHashBucketNode(RemapperContext* ctx,
   return OkStatus();
 }
 
+// Groups independent StringToHashBucketFast nodes on the same device into
+// _BatchStringToHashBucketFast nodes, so feature-column graphs issue one
+// kernel for many categorical features instead of one per feature. Only nodes
+// without control edges and outside the preserve set are grouped; group size
+// is capped to keep the fused node's fanin manageable.
+Status AddBatchStringToHashBucketNodes(RemapperContext* ctx, int num_nodes,
+                                       std::vector<bool>* invalidated_nodes,
+                                       std::vector<bool>* nodes_to_delete) {
+  constexpr int kMaxGroupSize = 64;
+  const GraphDef* graph = ctx->graph_view.graph();
+  std::map<string, std::vector<int>> nodes_by_device;
+  for (int i = 0; i < num_nodes; ++i) {
+    if ((*invalidated_nodes)[i] || (*nodes_to_delete)[i]) continue;
+    const auto* node_view = ctx->graph_view.GetNode(i);
+    const auto* node_def = node_view->node();
+    if (!IsStringToHashBucketFast(*node_def) ||
+        HasControlFaninOrFanout(*node_view) ||
+        IsInPreserveSet(*ctx, node_def) ||
+        node_view->NumRegularFanins() != 1) {
+      continue;
+    }
+    nodes_by_device[node_def->device()].push_back(i);
+  }
+
+  utils::Mutation* mutation = ctx->graph_view.GetMutationBuilder();
+  bool rewrote = false;
+  for (auto& entry : nodes_by_device) {
+    const std::vector<int>& members = entry.second;
+    for (int start = 0; start < static_cast<int>(members.size());
+         start += kMaxGroupSize) {
+      const int group_size = std::min<int>(kMaxGroupSize,
+                                           members.size() - start);
+      if (group_size < 2) break;
+      const NodeDef& first = graph->node(members[start]);
+      const string fused_name = absl::StrCat(first.name(), "/_batched");
+      VLOG(2) << "Group " << group_size
+              << " StringToHashBucketFast nodes into " << fused_name
+              << " on device=" << first.device();
+
+      NodeDef fused_op;
+      fused_op.set_name(fused_name);
+      fused_op.set_op(kBatchStringToHashBucket);
+      fused_op.set_device(first.device());
+      auto* attr = fused_op.mutable_attr();
+      (*attr)["N"].set_i(group_size);
+      auto* num_buckets = (*attr)["num_buckets"].mutable_list();
+      for (int j = 0; j < group_size; ++j) {
+        const NodeDef& member = graph->node(members[start + j]);
+        fused_op.add_input(member.input(0));
+        num_buckets->add_i(member.attr().at("num_buckets").i());
+      }
+      Status status;
+      mutation->AddNode(std::move(fused_op), &status);
+      TF_RETURN_IF_ERROR(status);
+
+      for (int j = 0; j < group_size; ++j) {
+        const int member_index = members[start + j];
+        const auto* member_view = ctx->graph_view.GetNode(member_index);
+        for (const auto& fanout : member_view->GetRegularFanout(0)) {
+          mutation->AddOrUpdateRegularFanin(fanout.node_view(), fanout.index(),
+                                            TensorId(fused_name, j));
+        }
+        (*nodes_to_delete)[member_index] = true;
+      }
+      rewrote = true;
+    }
+  }
+  if (rewrote) {
+    TF_RETURN_IF_ERROR(mutation->Apply());
+  }
+  return OkStatus();
+}
+
+Status AddDynamicQuantizedMatMulNode(RemapperContext* ctx,
+                                     const DynamicQuantizedMatMul& matched,
+                                     std::vector<bool>* invalidated_nodes) {
+  const GraphDef* graph = ctx->graph_view.graph();
+  const NodeDef& matmul = graph->node(matched.matmul);
+  VLOG(2) << "Replace MatMul with _DynamicQuantizedMatMul:"
+          << " matmul=" << matmul.name();
+
+  // The replacement is one-to-one: same name, inputs and attributes, only the
+  // op changes, so existing control dependencies are preserved.
+  NodeDef quantized_op = matmul;
+  quantized_op.set_op("_DynamicQuantizedMatMul");
+
+  utils::Mutation* mutation = ctx->graph_view.GetMutationBuilder();
+  Status status;
+  mutation->AddNode(std::move(quantized_op), &status);
+  TF_RETURN_IF_ERROR(status);
+  TF_RETURN_IF_ERROR(mutation->Apply());
+
+  (*invalidated_nodes)[matched.matmul] = true;
+
+  return OkStatus();
+}
+
 Status AddFusedBatchMatMul(RemapperContext* ctx,
                            const std::map<string, int>& matched_nodes_map,
                            const std::set<int>& remove_node_indices,
@@ -4616,6 +5125,9 @@ Status Remapper::Optimize(Cluster* cluster, const GrapplerItem& item,
   bool allow_non_differentiable_rewrites =
       item.optimization_options().allow_non_differentiable_rewrites;
 
+  const bool dynamic_quantized_matmul_enabled = DynamicQuantizedMatMulEnabled();
+  const bool fold_frozen_batch_norm_enabled = FoldFrozenBatchNormEnabled();
+
   for (int i = num_nodes - 1; i >= 0; --i) {
     // Check if node was invalidated by one of the previous remaps.
     if (invalidated_nodes[i] || nodes_to_delete[i]) {
@@ -4634,6 +5146,18 @@ Status Remapper::Optimize(Cluster* cluster, const GrapplerItem& item,
       ctx.inferred_graph_properties = true;
     }
 
+    // Fold a frozen Conv2D+FusedBatchNorm reachable from this node into the
+    // convolution weights before any kernel fusion can claim the batch norm.
+    // No `continue` here: the remaining Conv2D+BiasAdd(+Add)(+Activation)
+    // chain goes through the regular contraction fusions below. Opt-in via
+    // the TF_REMAPPER_FOLD_FROZEN_BATCH_NORM environment variable since the
+    // folded weights round differently from the fused kernel.
+    ContractionWithBatchNorm fold_batch_norm;
+    if (allow_non_differentiable_rewrites && fold_frozen_batch_norm_enabled &&
+        FindConv2DWithBatchNormWeightFold(ctx, i, &fold_batch_norm)) {
+      TF_RETURN_IF_ERROR(AddFoldedConv2DWithBatchNorm(&ctx, fold_batch_norm));
+    }
+
     ContractionWithBiasAddAndAdd contract_with_bias_and_add;
     ContractionWithActivation contract_with_activation;
     ContractionWithBiasAndAddActivation contract_with_bias_and_add_activation;
@@ -4836,6 +5360,22 @@ Status Remapper::Optimize(Cluster* cluster, const GrapplerItem& item,
       continue;
     }
 
+    // Remap BatchMatMul + Mul(scale) + Softmax + BatchMatMul, i.e. scaled
+    // dot-product attention, into the _FusedAttention op, which avoids
+    // materializing the full attention score matrix.
+    matched_nodes_map.clear();
+    remove_node_indices.clear();
+    float attention_scale = 1.0;
+    bool attention_transpose_key = false;
+    if (allow_non_differentiable_rewrites &&
+        FindFusedAttention(&ctx, i, &matched_nodes_map, &remove_node_indices,
+                           &attention_scale, &attention_transpose_key)) {
+      TF_RETURN_IF_ERROR(AddFusedAttentionNode(
+          &ctx, matched_nodes_map, remove_node_indices, &invalidated_nodes,
+          &nodes_to_delete, attention_scale, attention_transpose_key));
+      continue;
+    }
+
     // Remap {Conv2D,DepthwiseConv2D,MatMul}+BiasAdd into the
     // _Fused{Conv2D,DepthwiseConv2dNative,MatMul}
     ContractionWithBiasAdd contract_with_bias;
@@ -4923,6 +5463,18 @@ Status Remapper::Optimize(Cluster* cluster, const GrapplerItem& item,
       continue;
     }
 
+    // Replace fp32 MatMul with constant weights by the dynamically quantized
+    // eight-bit _DynamicQuantizedMatMul. Opt-in via the
+    // TF_USE_DYNAMIC_QUANTIZED_MATMUL environment variable since the
+    // quantization changes the numerics.
+    DynamicQuantizedMatMul dynamic_quantized_matmul;
+    if (allow_non_differentiable_rewrites && dynamic_quantized_matmul_enabled &&
+        FindDynamicQuantizedMatMul(ctx, i, &dynamic_quantized_matmul)) {
+      TF_RETURN_IF_ERROR(AddDynamicQuantizedMatMulNode(
+          &ctx, dynamic_quantized_matmul, &invalidated_nodes));
+      continue;
+    }
+
     // During inference, most of the inputs to FusedBatchNorm are constant, and
     // we can therefore replace the op with a much cheaper set of primitives.
     FusedBatchNorm fused_batch_norm;
@@ -4932,6 +5484,14 @@ Status Remapper::Optimize(Cluster* cluster, const GrapplerItem& item,
     }
   }
 
+  // Group independent StringToHashBucketFast nodes into batched kernels.
+  // Opt-in via the TF_USE_BATCH_STRING_TO_HASH_BUCKET environment variable
+  // since the grouping reshapes feature-column graphs wholesale.
+  if (allow_non_differentiable_rewrites && BatchStringToHashBucketEnabled()) {
+    TF_RETURN_IF_ERROR(AddBatchStringToHashBucketNodes(
+        &ctx, num_nodes, &invalidated_nodes, &nodes_to_delete));
+  }
+
   // Remove invalidated nodes.
   utils::Mutation* mutation = ctx.graph_view.GetMutationBuilder();
   for (int i = 0; i < num_nodes; ++i) {
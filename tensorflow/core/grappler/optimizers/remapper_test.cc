@@ -1607,6 +1607,220 @@ TEST_F(RemapperTensorToHashBucketTest, I32) { RunTest<DT_INT32>(); }
 
 TEST_F(RemapperTensorToHashBucketTest, I64) { RunTest<DT_INT64>(); }
 
+class RemapperBatchStringToHashBucketTest : public RemapperTest {
+ protected:
+  void SetUp() override {
+    RemapperTest::SetUp();
+    setenv("TF_USE_BATCH_STRING_TO_HASH_BUCKET", "1", 1 /* replace */);
+  }
+
+  void TearDown() override { unsetenv("TF_USE_BATCH_STRING_TO_HASH_BUCKET"); }
+};
+
+TEST_F(RemapperBatchStringToHashBucketTest, GroupsSiblingFeatures) {
+  using ::tensorflow::ops::Placeholder;
+
+  tensorflow::Scope s = tensorflow::Scope::NewRootScope();
+
+  auto input_shape = ops::Placeholder::Shape({4});
+  auto feature_a = Placeholder(s.WithOpName("feature_a"), DT_STRING,
+                               input_shape);
+  auto feature_b = Placeholder(s.WithOpName("feature_b"), DT_STRING,
+                               input_shape);
+  auto bucket_a =
+      ops::StringToHashBucketFast(s.WithOpName("bucket_a"), feature_a, 100);
+  auto bucket_b =
+      ops::StringToHashBucketFast(s.WithOpName("bucket_b"), feature_b, 200);
+  auto fetch_a = ops::Identity(s.WithOpName("fetch_a"), bucket_a);
+  auto fetch_b = ops::Identity(s.WithOpName("fetch_b"), bucket_b);
+
+  Tensor input_t(DT_STRING, TensorShape({4}));
+  for (int i = 0; i < 4; ++i) {
+    input_t.flat<tstring>()(i) = absl::StrCat("feature_value_", i);
+  }
+
+  GrapplerItem item;
+  item.fetch = {"fetch_a", "fetch_b"};
+  item.feed = {{"feature_a", input_t}, {"feature_b", input_t}};
+  TF_ASSERT_OK(s.ToGraphDef(&item.graph));
+  for (int i = 0; i < item.graph.node_size(); ++i) {
+    item.graph.mutable_node(i)->set_device("/device:CPU:0");
+  }
+
+  Remapper optimizer(RewriterConfig::ON);
+  GraphDef output;
+  TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &output));
+
+  int found = 0;
+  for (const NodeDef& node : output.node()) {
+    if (node.op() == "_BatchStringToHashBucketFast") {
+      EXPECT_EQ(node.attr().at("N").i(), 2);
+      ASSERT_EQ(node.attr().at("num_buckets").list().i_size(), 2);
+      found++;
+    }
+    EXPECT_NE(node.op(), "StringToHashBucketFast");
+  }
+  EXPECT_EQ(found, 1);
+
+  auto tensors_expected = EvaluateNodes(item.graph, item.fetch, item.feed);
+  ASSERT_EQ(tensors_expected.size(), 2);
+  auto tensors = EvaluateNodes(output, item.fetch, item.feed);
+  ASSERT_EQ(tensors.size(), 2);
+  test::ExpectTensorEqual<int64_t>(tensors[0], tensors_expected[0]);
+  test::ExpectTensorEqual<int64_t>(tensors[1], tensors_expected[1]);
+}
+
+class RemapperDynamicQuantizedMatMulTest : public RemapperTest {
+ protected:
+  void SetUp() override {
+    RemapperTest::SetUp();
+    // The rewrite changes the numerics, so it is opt-in.
+    setenv("TF_USE_DYNAMIC_QUANTIZED_MATMUL", "1", 1 /* replace */);
+  }
+
+  void TearDown() override { unsetenv("TF_USE_DYNAMIC_QUANTIZED_MATMUL"); }
+};
+
+TEST_F(RemapperDynamicQuantizedMatMulTest, MatMulWithConstWeights) {
+  using ::tensorflow::ops::Placeholder;
+
+  tensorflow::Scope s = tensorflow::Scope::NewRootScope();
+
+  auto input_shape = ops::Placeholder::Shape({4, 8});
+  auto input = Placeholder(s.WithOpName("input"), DT_FLOAT, input_shape);
+  auto weights_t = GenerateRandomTensor<DT_FLOAT>({8, 16});
+  auto weights = ops::Const(s.WithOpName("weights"), Input::Initializer(weights_t));
+  auto matmul = ops::MatMul(s.WithOpName("matmul"), input, weights);
+  auto fetch = ops::Identity(s.WithOpName("fetch"), matmul);
+
+  auto input_t = GenerateRandomTensor<DT_FLOAT>({4, 8});
+
+  GrapplerItem item;
+  item.fetch = {"fetch"};
+  item.feed = {{"input", input_t}};
+  TF_ASSERT_OK(s.ToGraphDef(&item.graph));
+
+  // The rewrite is CPU-only.
+  for (int i = 0; i < item.graph.node_size(); ++i) {
+    item.graph.mutable_node(i)->set_device("/device:CPU:0");
+  }
+
+  Remapper optimizer(RewriterConfig::ON);
+  GraphDef output;
+  TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &output));
+
+  int found = 0;
+  for (const NodeDef& node : output.node()) {
+    if (node.name() == "matmul") {
+      EXPECT_EQ(node.op(), "_DynamicQuantizedMatMul");
+      ASSERT_GE(node.input_size(), 2);
+      EXPECT_EQ(node.input(0), "input");
+      EXPECT_EQ(node.input(1), "weights");
+      found++;
+    }
+  }
+  EXPECT_EQ(found, 1);
+
+  auto tensors_expected = EvaluateNodes(item.graph, item.fetch, item.feed);
+  ASSERT_EQ(tensors_expected.size(), 1);
+  auto tensors = EvaluateNodes(output, item.fetch, item.feed);
+  ASSERT_EQ(tensors.size(), 1);
+  test::ExpectTensorNear<float>(tensors[0], tensors_expected[0], 0.1);
+}
+
+TEST_F(RemapperDynamicQuantizedMatMulTest, NoRewriteForTransposedMatMul) {
+  using ::tensorflow::ops::Placeholder;
+
+  tensorflow::Scope s = tensorflow::Scope::NewRootScope();
+
+  auto input_shape = ops::Placeholder::Shape({4, 8});
+  auto input = Placeholder(s.WithOpName("input"), DT_FLOAT, input_shape);
+  auto weights_t = GenerateRandomTensor<DT_FLOAT>({16, 8});
+  auto weights = ops::Const(s.WithOpName("weights"), Input::Initializer(weights_t));
+  auto matmul = ops::MatMul(s.WithOpName("matmul"), input, weights,
+                            ops::MatMul::TransposeB(true));
+  auto fetch = ops::Identity(s.WithOpName("fetch"), matmul);
+
+  GrapplerItem item;
+  item.fetch = {"fetch"};
+  TF_ASSERT_OK(s.ToGraphDef(&item.graph));
+
+  for (int i = 0; i < item.graph.node_size(); ++i) {
+    item.graph.mutable_node(i)->set_device("/device:CPU:0");
+  }
+
+  Remapper optimizer(RewriterConfig::ON);
+  GraphDef output;
+  TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &output));
+
+  for (const NodeDef& node : output.node()) {
+    if (node.name() == "matmul") {
+      EXPECT_EQ(node.op(), "MatMul");
+    }
+  }
+}
+
+TEST_F(RemapperTest, FuseAttention) {
+  if (GetNumAvailableGPUs() > 0) {
+    GTEST_SKIP() << "_FusedAttention is only registered on CPU";
+  }
+  using ::tensorflow::ops::Placeholder;
+
+  tensorflow::Scope s = tensorflow::Scope::NewRootScope();
+
+  auto query_shape = ops::Placeholder::Shape({1, 2, 8, 16});
+  auto query = Placeholder(s.WithOpName("query"), DT_FLOAT, query_shape);
+  auto key = Placeholder(s.WithOpName("key"), DT_FLOAT, query_shape);
+  auto value = Placeholder(s.WithOpName("value"), DT_FLOAT, query_shape);
+
+  auto qk = ops::BatchMatMulV2(s.WithOpName("qk"), query, key,
+                               ops::BatchMatMulV2::AdjY(true));
+  auto scale = ops::Const(s.WithOpName("scale"), 0.25f, {});
+  auto scaled = ops::Mul(s.WithOpName("scaled"), qk, scale);
+  auto probs = ops::Softmax(s.WithOpName("probs"), scaled);
+  auto attention = ops::BatchMatMulV2(s.WithOpName("attention"), probs, value);
+  auto fetch = ops::Identity(s.WithOpName("fetch"), attention);
+
+  auto query_t = GenerateRandomTensor<DT_FLOAT>({1, 2, 8, 16});
+  auto key_t = GenerateRandomTensor<DT_FLOAT>({1, 2, 8, 16});
+  auto value_t = GenerateRandomTensor<DT_FLOAT>({1, 2, 8, 16});
+
+  GrapplerItem item;
+  item.fetch = {"fetch"};
+  item.feed = {{"query", query_t}, {"key", key_t}, {"value", value_t}};
+  TF_ASSERT_OK(s.ToGraphDef(&item.graph));
+
+  // Place all nodes on CPU.
+  for (int i = 0; i < item.graph.node_size(); ++i) {
+    item.graph.mutable_node(i)->set_device("/device:CPU:0");
+  }
+
+  Remapper optimizer(RewriterConfig::ON);
+  GraphDef output;
+  TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &output));
+
+  int found = 0;
+  for (const NodeDef& node : output.node()) {
+    if (node.name() == "attention") {
+      EXPECT_EQ(node.op(), "_FusedAttention");
+      ASSERT_GE(node.input_size(), 3);
+      EXPECT_EQ(node.input(0), "query");
+      EXPECT_EQ(node.input(1), "key");
+      EXPECT_EQ(node.input(2), "value");
+      EXPECT_EQ(node.attr().at("scale").f(), 0.25f);
+      EXPECT_EQ(node.attr().at("transpose_key").b(), true);
+      found++;
+    }
+  }
+  EXPECT_EQ(found, 1);
+
+  auto tensors_expected = EvaluateNodes(item.graph, item.fetch, item.feed);
+  ASSERT_EQ(tensors_expected.size(), 1);
+  auto tensors = EvaluateNodes(output, item.fetch, item.feed);
+  ASSERT_EQ(tensors.size(), 1);
+  test::ExpectClose(tensors[0], tensors_expected[0], 1e-6, 1e-5);
+}
+
 class RemapperFuseMatMulWithBiasTest : public RemapperTest {
  public:
   template <DataType DTYPE>
@@ -2111,6 +2325,150 @@ TEST_F(RemapperTest, FuseConv2DWithBatchNormAndActivation) {
   }
 }
 
+class RemapperFoldFrozenBatchNormTest : public RemapperTest {
+ protected:
+  void SetUp() override {
+    RemapperTest::SetUp();
+    // The folded weights round differently from the fused kernel, so the
+    // rewrite is opt-in.
+    setenv("TF_REMAPPER_FOLD_FROZEN_BATCH_NORM", "1", 1 /* replace */);
+  }
+
+  void TearDown() override { unsetenv("TF_REMAPPER_FOLD_FROZEN_BATCH_NORM"); }
+};
+
+TEST_F(RemapperFoldFrozenBatchNormTest, FoldConv2DWithBatchNorm) {
+  using ops::Placeholder;
+
+  tensorflow::Scope s = tensorflow::Scope::NewRootScope();
+
+  auto input_shape = ops::Placeholder::Shape({8, 32, 32, 3});
+  auto input = Placeholder(s.WithOpName("input"), DT_FLOAT, input_shape);
+  auto filter_t = GenerateRandomTensor<DT_FLOAT>({1, 1, 3, 128});
+  auto filter = ops::Const(s.WithOpName("filter"), Input::Initializer(filter_t));
+  auto scale_t = GenerateRandomTensor<DT_FLOAT>({128});
+  auto scale = ops::Const(s.WithOpName("scale"), Input::Initializer(scale_t));
+  auto offset_t = GenerateRandomTensor<DT_FLOAT>({128});
+  auto offset = ops::Const(s.WithOpName("offset"), Input::Initializer(offset_t));
+  auto mean_t = GenerateRandomTensor<DT_FLOAT>({128});
+  auto mean = ops::Const(s.WithOpName("mean"), Input::Initializer(mean_t));
+  auto variance_t = GenerateRandomTensor<DT_FLOAT>({128});
+  auto variance =
+      ops::Const(s.WithOpName("variance"), Input::Initializer(variance_t));
+
+  std::vector<int> strides = {1, 1, 1, 1};
+  auto conv =
+      ops::Conv2D(s.WithOpName("conv"), input, filter, strides, "SAME");
+  ops::FusedBatchNorm::Attrs attrs;
+  attrs = attrs.IsTraining(false);
+  auto batch_norm = ops::FusedBatchNorm(s.WithOpName("batch_norm"), conv, scale,
+                                        offset, mean, variance, attrs);
+  auto fetch = ops::Identity(s.WithOpName("fetch"), batch_norm.y);
+
+  auto input_t = GenerateRandomTensor<DT_FLOAT>({8, 32, 32, 3});
+
+  GrapplerItem item;
+  item.fetch = {"fetch"};
+  item.feed = {{"input", input_t}};
+  TF_ASSERT_OK(s.ToGraphDef(&item.graph));
+
+  // Place all nodes on CPU.
+  for (int i = 0; i < item.graph.node_size(); ++i) {
+    item.graph.mutable_node(i)->set_device("/device:CPU:0");
+  }
+
+  Remapper optimizer(RewriterConfig::ON);
+  GraphDef output;
+  TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &output));
+
+  int found = 0;
+  for (const NodeDef& node : output.node()) {
+    EXPECT_NE(node.op(), "FusedBatchNorm");
+    if (node.name() == "batch_norm/ScaledFilter") {
+      EXPECT_EQ(node.op(), "Mul");
+      EXPECT_EQ(node.input(0), "filter");
+      found++;
+    }
+  }
+  EXPECT_EQ(found, 1);
+
+  auto tensors_expected = EvaluateNodes(item.graph, item.fetch, item.feed);
+  ASSERT_EQ(tensors_expected.size(), 1);
+  auto tensors = EvaluateNodes(output, item.fetch, item.feed);
+  ASSERT_EQ(tensors.size(), 1);
+  test::ExpectClose(tensors[0], tensors_expected[0], 1e-6, 1e-4);
+}
+
+TEST_F(RemapperFoldFrozenBatchNormTest, FoldConv2DWithBatchNormAddAndRelu) {
+  using ops::Placeholder;
+
+  tensorflow::Scope s = tensorflow::Scope::NewRootScope();
+
+  auto input_shape = ops::Placeholder::Shape({8, 32, 32, 3});
+  auto input = Placeholder(s.WithOpName("input"), DT_FLOAT, input_shape);
+  auto side_input = Placeholder(s.WithOpName("side_input"), DT_FLOAT,
+                                ops::Placeholder::Shape({8, 32, 32, 128}));
+  auto filter_t = GenerateRandomTensor<DT_FLOAT>({1, 1, 3, 128});
+  auto filter = ops::Const(s.WithOpName("filter"), Input::Initializer(filter_t));
+  auto scale_t = GenerateRandomTensor<DT_FLOAT>({128});
+  auto scale = ops::Const(s.WithOpName("scale"), Input::Initializer(scale_t));
+  auto offset_t = GenerateRandomTensor<DT_FLOAT>({128});
+  auto offset = ops::Const(s.WithOpName("offset"), Input::Initializer(offset_t));
+  auto mean_t = GenerateRandomTensor<DT_FLOAT>({128});
+  auto mean = ops::Const(s.WithOpName("mean"), Input::Initializer(mean_t));
+  auto variance_t = GenerateRandomTensor<DT_FLOAT>({128});
+  auto variance =
+      ops::Const(s.WithOpName("variance"), Input::Initializer(variance_t));
+
+  std::vector<int> strides = {1, 1, 1, 1};
+  auto conv =
+      ops::Conv2D(s.WithOpName("conv"), input, filter, strides, "SAME");
+  ops::FusedBatchNorm::Attrs attrs;
+  attrs = attrs.IsTraining(false);
+  auto batch_norm = ops::FusedBatchNorm(s.WithOpName("batch_norm"), conv, scale,
+                                        offset, mean, variance, attrs);
+  auto add = ops::Add(s.WithOpName("add"), batch_norm.y, side_input);
+  auto relu = ops::Relu(s.WithOpName("relu"), add);
+  auto fetch = ops::Identity(s.WithOpName("fetch"), relu);
+
+  auto input_t = GenerateRandomTensor<DT_FLOAT>({8, 32, 32, 3});
+  auto side_input_t = GenerateRandomTensor<DT_FLOAT>({8, 32, 32, 128});
+
+  GrapplerItem item;
+  item.fetch = {"fetch"};
+  item.feed = {{"input", input_t}, {"side_input", side_input_t}};
+  TF_ASSERT_OK(s.ToGraphDef(&item.graph));
+
+  // Place all nodes on CPU.
+  for (int i = 0; i < item.graph.node_size(); ++i) {
+    item.graph.mutable_node(i)->set_device("/device:CPU:0");
+  }
+
+  Remapper optimizer(RewriterConfig::ON);
+  GraphDef output;
+  TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &output));
+
+  // The batch norm must be folded away even though the fusions rooted at the
+  // Relu and Add nodes are matched first.
+  int found = 0;
+  for (const NodeDef& node : output.node()) {
+    EXPECT_NE(node.op(), "FusedBatchNorm");
+    EXPECT_NE(node.op(), "_FusedBatchNormEx");
+    if (node.name() == "batch_norm/ScaledFilter") {
+      EXPECT_EQ(node.op(), "Mul");
+      EXPECT_EQ(node.input(0), "filter");
+      found++;
+    }
+  }
+  EXPECT_EQ(found, 1);
+
+  auto tensors_expected = EvaluateNodes(item.graph, item.fetch, item.feed);
+  ASSERT_EQ(tensors_expected.size(), 1);
+  auto tensors = EvaluateNodes(output, item.fetch, item.feed);
+  ASSERT_EQ(tensors.size(), 1);
+  test::ExpectClose(tensors[0], tensors_expected[0], 1e-6, 1e-4);
+}
+
 #ifdef INTEL_MKL
 TEST_F(RemapperTest, FuseConv3DWithBiasAndAddN) {
   if (!IsMKLEnabled()) GTEST_SKIP() << "Test only applicable to oneDNN.";
@@ -19,6 +19,7 @@ limitations under the License.
 #include "tensorflow/core/framework/graph.pb.h"
 #include "tensorflow/core/framework/node_def_builder.h"
 #include "tensorflow/core/framework/node_def_util.h"
+#include "tensorflow/core/framework/tensor.h"
 #include "tensorflow/core/graph/graph.h"
 #include "tensorflow/core/grappler/costs/graph_properties.h"
 #include "tensorflow/core/grappler/grappler_item.h"
@@ -889,12 +890,228 @@ class UnaryElementwiseRewriter : public ScopedAllocatorOptimizer::Rewriter {
   }
 };
 
+// Rewrites an eligible ConcatV2 node in place into a _ScopedAllocatorConcat
+// whose producers write their outputs directly into consecutive slices of a
+// single pre-allocated backing tensor, eliminating the copy otherwise
+// performed by ConcatV2.  Unlike UnaryElementwiseRewriter, which coalesces a
+// set of logically parallel ops feeding a collective, this rewriter applies
+// to each ConcatV2 node independently, so it reports AppliesToSingleNode.
+//
+// The rewrite is valid only when the memory layout of the backing tensor is
+// identical to that of the ConcatV2 output:
+//   1. the concat axis is a constant 0, i.e. the outermost dimension, and
+//   2. every input's byte size is a multiple of Allocator::kAllocatorAlignment
+//      so that ScopedAllocatorMgr::PopulateFields introduces no padding
+//      between fields.
+// Inherits from UnaryElementwiseRewriter in order to reuse its
+// ScopedAllocator construction and input vetting logic.
+class ConcatRewriter : public UnaryElementwiseRewriter {
+ public:
+  ~ConcatRewriter() override {}
+
+  bool AppliesToSingleNode() const override { return true; }
+
+  Status Rewrite(ScopedAllocatorOptimizer* sa_opti, int64_t invocation_count,
+                 GraphDef* graph, const string& op_name,
+                 const std::vector<NodeDef*>& nodes, bool* applied) override {
+    *applied = false;
+    for (NodeDef* concat : nodes) {
+      bool rewritten = false;
+      LOG_WARNING_AND_RETURN_IF_ERROR(MaybeRewriteConcat(
+          sa_opti, invocation_count, graph, concat, &rewritten));
+      *applied = *applied || rewritten;
+    }
+    return OkStatus();
+  }
+
+ private:
+  // Returns true iff `node` is a Const holding the scalar value 0.
+  bool IsZeroAxis(const NodeDef& node) {
+    if (!IsConstant(node)) return false;
+    TensorProto proto;
+    if (!GetNodeAttr(AttrSlice(node), "value", &proto).ok()) return false;
+    Tensor axis;
+    if (!axis.FromProto(proto) || axis.NumElements() != 1) return false;
+    if (axis.dtype() == DT_INT32) return axis.scalar<int32>()() == 0;
+    if (axis.dtype() == DT_INT64) return axis.scalar<int64_t>()() == 0;
+    return false;
+  }
+
+  // Rewrites `concat` if it is eligible.  Ineligibility is not an error: the
+  // node simply keeps its ConcatV2 implementation and *applied stays false.
+  Status MaybeRewriteConcat(ScopedAllocatorOptimizer* sa_opti,
+                            int64_t invocation_count, GraphDef* graph,
+                            NodeDef* concat, bool* applied) {
+    VLOG(1) << "ConcatRewriter::MaybeRewriteConcat " << concat->name();
+    NodeMap* node_map = sa_opti->node_map();
+    AttrSlice concat_attrs = AttrSlice(*concat);
+    DataType dtype;
+    int num_inputs;
+    LOG_WARNING_AND_RETURN_IF_ERROR(GetNodeAttr(concat_attrs, "T", &dtype));
+    LOG_WARNING_AND_RETURN_IF_ERROR(GetNodeAttr(concat_attrs, "N",
+                                                &num_inputs));
+    if (num_inputs < 2 || DataTypeSize(dtype) == 0 ||
+        (Allocator::kAllocatorAlignment % DataTypeSize(dtype)) != 0) {
+      return OkStatus();
+    }
+    // Split the existing inputs into data and control edges.  The last data
+    // input of ConcatV2 is the axis.
+    std::vector<string> data_inputs;
+    std::vector<string> control_inputs;
+    for (const string& input_name : concat->input()) {
+      if (IsControlInput(input_name)) {
+        control_inputs.push_back(input_name);
+      } else {
+        data_inputs.push_back(input_name);
+      }
+    }
+    if (static_cast<int>(data_inputs.size()) != num_inputs + 1) {
+      return errors::Internal("Node ", concat->name(), " expected ",
+                              num_inputs + 1, " data inputs but has ",
+                              data_inputs.size());
+    }
+    NodeDef* axis_node = node_map->GetNode(data_inputs.back());
+    if (axis_node == nullptr || !IsZeroAxis(*axis_node)) {
+      VLOG(2) << "Skipping " << concat->name()
+              << ": concat axis is not a constant 0";
+      return OkStatus();
+    }
+    // The output shape must be fully known: it becomes the static shape of
+    // the _ScopedAllocatorConcat result.
+    if (!graph_properties_->HasOutputProperties(concat->name())) {
+      VLOG(2) << "Skipping " << concat->name() << ": no output properties";
+      return OkStatus();
+    }
+    const auto& concat_props =
+        graph_properties_->GetOutputProperties(concat->name());
+    if (concat_props.size() != 1 ||
+        !TensorShape::IsValid(concat_props[0].shape()) ||
+        concat_props[0].shape().unknown_rank()) {
+      VLOG(2) << "Skipping " << concat->name() << ": output shape not known";
+      return OkStatus();
+    }
+    TensorShape output_shape(concat_props[0].shape());
+
+    // Vet the producers of each input.
+    std::vector<InputDesc> inputs;
+    std::vector<TensorShape> input_shapes;
+    inputs.reserve(num_inputs);
+    input_shapes.reserve(num_inputs);
+    absl::flat_hash_set<string> seen_producers;
+    int64_t total_elements = 0;
+    for (int i = 0; i < num_inputs; ++i) {
+      int output_slot = 0;
+      string producer_name = ParseNodeName(data_inputs[i], &output_slot);
+      NodeDef* producer = node_map->GetNode(producer_name);
+      if (producer == nullptr) {
+        return errors::Internal("Did not find node ", producer_name);
+      }
+      // The producer must allocate its output through the standard
+      // AllocatorAttributes mechanism, on the same device as the concat, and
+      // must not straddle a frame boundary.
+      if (producer->device() != concat->device() || IsConstant(*producer) ||
+          IsArg(*producer) || IsExit(*producer) ||
+          ModifiesFrameInfo(*producer)) {
+        VLOG(2) << "Skipping " << concat->name() << ": input " << producer_name
+                << " of type " << producer->op() << " is not rewritable";
+        return OkStatus();
+      }
+      // A producer whose output has other consumers, or that appears twice,
+      // would need its field tensor to outlive the backing tensor, so be
+      // conservative and require the concat to be the sole consumer.
+      const auto& producer_outputs = node_map->GetOutputs(producer_name);
+      if (producer_outputs.size() != 1 ||
+          *producer_outputs.begin() != concat ||
+          !seen_producers.insert(producer_name).second) {
+        VLOG(2) << "Skipping " << concat->name() << ": input " << producer_name
+                << " has consumers other than the concat";
+        return OkStatus();
+      }
+      if (!graph_properties_->HasOutputProperties(producer_name)) {
+        VLOG(2) << "Skipping " << concat->name() << ": input " << producer_name
+                << " lacks output properties";
+        return OkStatus();
+      }
+      const auto& producer_props =
+          graph_properties_->GetOutputProperties(producer_name);
+      if (producer_props.size() != 1 || producer_props[0].dtype() != dtype ||
+          !TensorShape::IsValid(producer_props[0].shape()) ||
+          producer_props[0].shape().unknown_rank()) {
+        VLOG(2) << "Skipping " << concat->name() << ": shape of input "
+                << producer_name << " not fully known";
+        return OkStatus();
+      }
+      TensorShape input_shape(producer_props[0].shape());
+      // Without this, PopulateFields would insert alignment padding between
+      // fields and the backing tensor would no longer have the same layout as
+      // the concat output.
+      if ((input_shape.num_elements() * DataTypeSize(dtype)) %
+              Allocator::kAllocatorAlignment !=
+          0) {
+        VLOG(2) << "Skipping " << concat->name() << ": input " << producer_name
+                << " byte size is not a multiple of kAllocatorAlignment";
+        return OkStatus();
+      }
+      total_elements += input_shape.num_elements();
+      input_shapes.push_back(std::move(input_shape));
+      inputs.emplace_back(producer, output_slot, concat);
+    }
+    if (total_elements != output_shape.num_elements()) {
+      VLOG(2) << "Skipping " << concat->name()
+              << ": input sizes do not add up to the output size";
+      return OkStatus();
+    }
+    LOG_WARNING_AND_RETURN_IF_ERROR(CheckExistingScopedAllocator(inputs));
+
+    std::vector<NodeDef*> producers;
+    producers.reserve(inputs.size());
+    for (const InputDesc& nd : inputs) {
+      producers.push_back(nd.from_node_def);
+    }
+    int sa_id = sa_opti->NewScopedAllocatorId(num_inputs);
+    string sa_name =
+        strings::StrCat("scoped_allocator_", sa_id, "_", invocation_count);
+    TensorShape sa_shape({total_elements});
+    LOG_WARNING_AND_RETURN_IF_ERROR(ConstructScopedAllocatorNode(
+        sa_opti, graph, node_map, producers, concat->device(), dtype, sa_id,
+        sa_name, input_shapes, inputs, sa_shape));
+
+    // Turn the ConcatV2 node into a _ScopedAllocatorConcat in place, so that
+    // none of its consumers need rewiring.  The axis input is dropped and the
+    // backing tensor becomes input 0; `reshape` restores the static output
+    // shape, which is exact because the fields are unpadded.
+    node_map->RemoveOutput(axis_node->name(), concat->name());
+    concat->set_op("_ScopedAllocatorConcat");
+    concat->clear_input();
+    concat->add_input(sa_name);
+    for (int i = 0; i < num_inputs; ++i) {
+      concat->add_input(data_inputs[i]);
+    }
+    for (const string& input_name : control_inputs) {
+      concat->add_input(input_name);
+    }
+    node_map->AddOutput(sa_name, concat->name());
+    concat->mutable_attr()->erase("Tidx");
+    AddNodeAttr("sa_name", sa_name, concat);
+    AddNodeAttr("id", sa_id, concat);
+    AddNodeAttr("shape", output_shape, concat);
+    AddNodeAttr("reshape", true, concat);
+
+    VLOG(1) << "Rewrote " << concat->name() << " into _ScopedAllocatorConcat "
+            << "with backing tensor " << sa_name;
+    *applied = true;
+    return OkStatus();
+  }
+};
+
 ScopedAllocatorOptimizer::ScopedAllocatorOptimizer(
     RewriterConfig::Toggle opt_level, const ScopedAllocatorOptions& opts)
     : opt_level_(opt_level) {
   VLOG(1) << "ScopedAllocatorOptimizer::ScopedAllocatorOptimizer";
   Rewriter* r = new UnaryElementwiseRewriter();
   to_delete_.push_back(r);
+  Rewriter* concat_rewriter = new ConcatRewriter();
+  to_delete_.push_back(concat_rewriter);
   if (opts.enable_op_size() == 0) {
     // Opts handled by default:
     for (const auto& op_name : {"CollectiveReduce"}) {
@@ -904,7 +1121,7 @@ ScopedAllocatorOptimizer::ScopedAllocatorOptimizer(
   } else {
     for (const auto& op_name : opts.enable_op()) {
       op_name_set_.insert(op_name);
-      rewriters_[op_name] = r;
+      rewriters_[op_name] = (op_name == "ConcatV2") ? concat_rewriter : r;
     }
   }
 }
@@ -1127,11 +1344,12 @@ Status ScopedAllocatorOptimizer::ProcessGraphDef(
                                          &op_name, invocation_count](Tree* t) {
           VLOG(2) << "applied to tree node " << t->edge_ << " at depth "
                   << t->depth_ << " of size " << t->nodes_.size();
-          if (t->nodes_.size() > 1) {
+          const bool applies_to_single_node = rewriter->AppliesToSingleNode();
+          if (t->nodes_.size() > 1 || applies_to_single_node) {
             std::vector<std::vector<NodeDef*>> loop_groups;
             PartitionByLoopStructure(frame_view, t->nodes_, &loop_groups);
             for (auto& lg : loop_groups) {
-              if (lg.size() > 1) {
+              if (lg.size() > 1 || applies_to_single_node) {
                 bool applied = false;
                 Status s = OrderNodeSet(&lg);
                 TF_RETURN_IF_ERROR(s);
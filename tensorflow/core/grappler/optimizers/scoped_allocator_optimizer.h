@@ -93,6 +93,11 @@ class ScopedAllocatorOptimizer : public GraphOptimizer {
                            const std::vector<NodeDef*>& nodes,
                            bool* applied) = 0;
 
+    // If true, Rewrite is invoked even for groups containing a single node.
+    // Rewriters that coalesce the inputs of one op, rather than a set of
+    // parallel ops, should override this.
+    virtual bool AppliesToSingleNode() const { return false; }
+
     void SetGraphProperties(const GraphProperties& graph_properties) {
       graph_properties_ = &graph_properties;
       CHECK(graph_properties_);
@@ -267,6 +267,44 @@ class ScopedAllocatorOptimizerTest : public ::testing::Test {
     TF_CHECK_OK(s.ToGraphDef(graph_def));
   }
 
+  // Constructs the following graph.
+  //
+  // a and b are Const ops.  a1 and a2 are Abs ops whose outputs feed only the
+  // axis-0 ConcatV2 op.  The input shapes are chosen so that each input's byte
+  // size is a multiple of Allocator::kAllocatorAlignment.
+  //
+  // The intended optimization is to have a1 and a2 allocate from a new
+  // ScopedAllocator and to turn concat into a _ScopedAllocatorConcat that
+  // merely forwards the backing tensor, eliminating the concat copy.
+  /*
+          a    b
+          |    |
+          a1   a2
+           \  /
+          concat
+  */
+  void BuildConcatGraph(GraphDef* graph_def) {
+    Scope s = Scope::NewRootScope();
+    s = s.WithDevice("/job:localhost/replica:0/task:0/device:CPU:0");
+
+    Output a = ops::Const<float>(s.WithOpName("a"), -1.0, {2, 16});
+    Output b = ops::Const<float>(s.WithOpName("b"), -2.0, {2, 16});
+    Output a1 = ops::Abs(s.WithOpName("a1"), a);
+    Output a2 = ops::Abs(s.WithOpName("a2"), b);
+    Output axis = ops::Const<int32>(s.WithOpName("axis"), 0, {});
+    Output concat = ops::Concat(s.WithOpName("concat"), {a1, a2}, axis);
+    TF_CHECK_OK(s.ToGraphDef(graph_def));
+
+    TensorShapeProto shape_proto;
+    shape_proto.add_dim()->set_size(2);
+    shape_proto.add_dim()->set_size(16);
+    for (NodeDef& n : *graph_def->mutable_node()) {
+      if (n.op() == "Abs") {
+        AddNodeAttr("_output_shapes", {shape_proto}, &n);
+      }
+    }
+  }
+
   void SetShapes(GraphDef* graph_def) {
     TensorShapeProto shape_proto;
     shape_proto.add_dim()->set_size(2);
@@ -283,7 +321,8 @@ class ScopedAllocatorOptimizerTest : public ::testing::Test {
   // returns the outputs specified by `output_names` in `outputs`.
   void ExecuteGraph(const GraphDef& graph_def,
                     const std::vector<string>& output_names,
-                    std::vector<Tensor>* outputs) {
+                    std::vector<Tensor>* outputs,
+                    const std::vector<string>& enable_ops = {"Abs"}) {
     // Turn off all optimization except the ScopedAllocatorOptimizer
     // to avoid anything that would alter the expected graph input/output,
     // e.g. by constant folding away all calculations.
@@ -297,7 +336,9 @@ class ScopedAllocatorOptimizerTest : public ::testing::Test {
     RewriterConfig* rwcfg = gopt->mutable_rewrite_options();
     rwcfg->clear_optimizers();
     (*rwcfg->add_optimizers()) = "scoped_allocator";
-    rwcfg->mutable_scoped_allocator_opts()->add_enable_op("Abs");
+    for (const string& op_name : enable_ops) {
+      rwcfg->mutable_scoped_allocator_opts()->add_enable_op(op_name);
+    }
     std::unique_ptr<Session> session(CreateSession(graph_def, config));
 
     std::vector<std::pair<string, Tensor>> inputs;
@@ -596,6 +637,51 @@ TEST_F(ScopedAllocatorOptimizerTest, ConstInput) {
   }
   EXPECT_EQ(num_identity_ops, 2);
 }
+
+// Tests that an axis-0 ConcatV2 whose producers are exclusively consumed by it
+// is rewritten in place into a _ScopedAllocatorConcat over a new backing
+// tensor.
+TEST_F(ScopedAllocatorOptimizerTest, ConcatRewrite) {
+  GrapplerItem item;
+  BuildConcatGraph(&item.graph);
+
+  ScopedAllocatorOptions opts;
+  opts.add_enable_op("ConcatV2");
+  ScopedAllocatorOptimizer sao(RewriterConfig::ON, opts);
+
+  GraphDef optimized_graph;
+  TF_ASSERT_OK(sao.Optimize(nullptr /*cluster*/, item, &optimized_graph));
+
+  // Examine the resulting graph def.  The concat node keeps its name but is
+  // now a _ScopedAllocatorConcat whose first input is the backing tensor, and
+  // both producers allocate from the new ScopedAllocator.
+  NodeMap node_map(&optimized_graph);
+  NodeDef* concat = nullptr;
+  GetNode(&node_map, "concat", &concat);
+  EXPECT_EQ(concat->op(), "_ScopedAllocatorConcat");
+  NodeDef* sa_node = ValidateSAControlInput(&optimized_graph, &node_map, "a1");
+  EXPECT_TRUE(ValidateSAControlInput(&optimized_graph, &node_map, "a2"));
+  ASSERT_EQ(concat->input_size(), 3);
+  EXPECT_EQ(concat->input(0), sa_node->name());
+  EXPECT_EQ(concat->input(1), "a1");
+  EXPECT_EQ(concat->input(2), "a2");
+}
+
+// Builds the same graph as ConcatRewrite but also executes it and validates
+// the output.
+TEST_F(ScopedAllocatorOptimizerTest, ConcatExecute) {
+  GraphDef graph_def;
+  BuildConcatGraph(&graph_def);
+  std::vector<Tensor> outputs;
+  ExecuteGraph(graph_def, /*output_names=*/{"concat:0"}, &outputs,
+               /*enable_ops=*/{"ConcatV2"});
+  // abs(a) stacked on abs(b).
+  std::vector<float> expected(64);
+  for (int i = 0; i < 64; ++i) {
+    expected[i] = (i < 32) ? 1.0 : 2.0;
+  }
+  ValidateValues(outputs, /*expected=*/{expected});
+}
 #endif  // ENABLE_MKL
 
 }  // namespace
@@ -24,6 +24,7 @@ limitations under the License.
 #include "tensorflow/core/framework/variant.h"
 #include "tensorflow/core/framework/variant_encode_decode.h"
 #include "tensorflow/core/framework/variant_tensor_data.h"
+#include "tensorflow/core/kernels/string_tensor_arena.h"
 #include "tensorflow/core/lib/core/errors.h"
 #include "tensorflow/core/lib/core/status.h"
 #include "tensorflow/core/lib/strings/stringprintf.h"
@@ -163,18 +164,20 @@ class AsStringOp : public OpKernel {
       return;
     }
 
-    Tensor* output_tensor = nullptr;
-    OP_REQUIRES_OK(context,
-                   context->allocate_output("output", input_tensor->shape(),
-                                            &output_tensor));
-    auto output_flat = output_tensor->flat<tstring>();
-
-#define ENCODE_TYPE(type, T, enc_str)                                     \
-  case (type): {                                                          \
-    const auto& input_flat = input_tensor->flat<T>();                     \
-    for (int i = 0; i < input_flat.size(); ++i) {                         \
-      output_flat(i) = strings::Printf((enc_str.c_str()), input_flat(i)); \
-    }                                                                     \
+    // Batch all the formatted strings into one character arena rather than
+    // heap-allocating each output element separately. `scratch` is reused
+    // across elements so formatting does not allocate either.
+    StringTensorArena arena(input_tensor->NumElements());
+    string scratch;
+
+#define ENCODE_TYPE(type, T, enc_str)                      \
+  case (type): {                                           \
+    const auto& input_flat = input_tensor->flat<T>();      \
+    for (int i = 0; i < input_flat.size(); ++i) {          \
+      scratch.clear();                                     \
+      strings::Appendf(&scratch, (enc_str.c_str()), input_flat(i)); \
+      arena.Add(scratch);                                  \
+    }                                                      \
   } break
 
     switch (dtype) {
@@ -191,48 +194,58 @@ class AsStringOp : public OpKernel {
       case (DT_BOOL): {
         const auto& input_flat = input_tensor->flat<bool>();
         for (int i = 0; i < input_flat.size(); ++i) {
-          output_flat(i) = (input_flat(i)) ? "true" : "false";
+          arena.Add((input_flat(i)) ? "true" : "false");
         }
       } break;
       case (DT_STRING): {
         const auto& input_flat = input_tensor->flat<tstring>();
         for (int i = 0; i < input_flat.size(); ++i) {
-          output_flat(i) = strings::Printf(format_.c_str(),
-                                           StringPiece(input_flat(i)).data());
+          scratch.clear();
+          strings::Appendf(&scratch, format_.c_str(),
+                           StringPiece(input_flat(i)).data());
+          arena.Add(scratch);
         }
       } break;
       case (DT_VARIANT): {
         const auto& input_flat = input_tensor->flat<Variant>();
         for (int i = 0; i < input_flat.size(); ++i) {
-          output_flat(i) = input_flat(i).DebugString();
+          arena.Add(input_flat(i).DebugString());
         }
       } break;
       case (DT_HALF): {
         const auto& input_flat = input_tensor->flat<Eigen::half>();
         for (int i = 0; i < input_flat.size(); ++i) {
-          output_flat(i) = strings::Printf(format_.c_str(),
-                                           static_cast<float>(input_flat(i)));
+          scratch.clear();
+          strings::Appendf(&scratch, format_.c_str(),
+                           static_cast<float>(input_flat(i)));
+          arena.Add(scratch);
         }
       } break;
       case (DT_BFLOAT16): {
         const auto& input_flat = input_tensor->flat<bfloat16>();
         for (int i = 0; i < input_flat.size(); ++i) {
-          output_flat(i) = strings::Printf(format_.c_str(),
-                                           static_cast<float>(input_flat(i)));
+          scratch.clear();
+          strings::Appendf(&scratch, format_.c_str(),
+                           static_cast<float>(input_flat(i)));
+          arena.Add(scratch);
         }
       } break;
       case (DT_COMPLEX64): {
         const auto& input_flat = input_tensor->flat<complex64>();
         for (int i = 0; i < input_flat.size(); ++i) {
-          output_flat(i) = strings::Printf(
-              format_.c_str(), input_flat(i).real(), input_flat(i).imag());
+          scratch.clear();
+          strings::Appendf(&scratch, format_.c_str(), input_flat(i).real(),
+                           input_flat(i).imag());
+          arena.Add(scratch);
         }
       } break;
       case (DT_COMPLEX128): {
         const auto& input_flat = input_tensor->flat<complex128>();
         for (int i = 0; i < input_flat.size(); ++i) {
-          output_flat(i) = strings::Printf(
-              format_.c_str(), input_flat(i).real(), input_flat(i).imag());
+          scratch.clear();
+          strings::Appendf(&scratch, format_.c_str(), input_flat(i).real(),
+                           input_flat(i).imag());
+          arena.Add(scratch);
         }
       } break;
       default:
@@ -243,6 +256,11 @@ class AsStringOp : public OpKernel {
     }
 
 #undef ENCODE_TYPE
+
+    Tensor output_tensor;
+    OP_REQUIRES_OK(context,
+                   arena.Finalize(input_tensor->shape(), &output_tensor));
+    context->set_output(0, output_tensor);
   }
 
  private:
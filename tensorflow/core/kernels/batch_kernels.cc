@@ -295,6 +295,10 @@ BatchFunctionKernel::BatchFunctionKernel(OpKernelConstruction* c)
                                &low_priority_allowed_batch_sizes_));
   OP_REQUIRES_OK(c, c->GetAttr("low_priority_max_enqueued_batches",
                                &low_priority_max_enqueued_batches_));
+  if (c->HasAttr("shape_bucket_boundaries")) {
+    OP_REQUIRES_OK(
+        c, c->GetAttr("shape_bucket_boundaries", &shape_bucket_boundaries_));
+  }
 
   OP_REQUIRES_OK(c, c->GetAttr("f", &func_));
 
@@ -331,6 +335,7 @@ BatchFunctionKernel::BatchFunctionKernel(OpKernelConstruction* c)
   }
 
   OP_REQUIRES_OK(c, ValidateAllowedBatchSizes());
+  OP_REQUIRES_OK(c, ValidateShapeBucketBoundaries());
 }
 
 bool BatchFunctionKernel::IsExpensive() { return false; }
@@ -435,6 +440,9 @@ void BatchFunctionKernel::ComputeAsync(OpKernelContext* c, DoneCallback done) {
     };
   }
 
+  string batcher_queue;
+  OP_REQUIRES_OK_ASYNC(c, GetBatcherQueueName(c, &batcher_queue), done);
+
   BatchResource* br;
   OP_REQUIRES_OK_ASYNC(c,
                        c->resource_manager()->LookupOrCreate(
@@ -447,11 +455,11 @@ void BatchFunctionKernel::ComputeAsync(OpKernelContext* c, DoneCallback done) {
   };
   Status status;
   if (serving::ShouldWarmupAllBatchSizes(c)) {
-    status = br->RegisterWarmupInputs(guid, c, batcher_queue_,
+    status = br->RegisterWarmupInputs(guid, c, batcher_queue,
                                       create_batch_task_fn, done);
   } else {
     status =
-        br->RegisterInput(guid, c, batcher_queue_, create_batch_task_fn, done);
+        br->RegisterInput(guid, c, batcher_queue, create_batch_task_fn, done);
   }
   br->Unref();
   OP_REQUIRES_OK_ASYNC(c, status, done);
@@ -559,6 +567,46 @@ Status BatchFunctionKernel::ValidateAllowedBatchSizes() const {
   return OkStatus();
 }
 
+Status BatchFunctionKernel::ValidateShapeBucketBoundaries() const {
+  int32_t last_boundary = 0;
+  for (const int32_t boundary : shape_bucket_boundaries_) {
+    if (boundary <= last_boundary) {
+      return errors::InvalidArgument(
+          "shape_bucket_boundaries entries must be positive and strictly "
+          "increasing");
+    }
+    last_boundary = boundary;
+  }
+  return OkStatus();
+}
+
+Status BatchFunctionKernel::GetBatcherQueueName(OpKernelContext* c,
+                                                string* queue_name) const {
+  if (shape_bucket_boundaries_.empty()) {
+    *queue_name = batcher_queue_;
+    return OkStatus();
+  }
+  // Bucket by the largest second (non-batch) dimension among the inputs, so
+  // that variable-length requests are only batched with requests of similar
+  // length and the padding added when concatenating them is bounded by the
+  // bucket width.
+  OpInputList in_tensors;
+  TF_RETURN_IF_ERROR(c->input_list("in_tensors", &in_tensors));
+  int64_t max_secondary_dim = 0;
+  for (const Tensor& t : in_tensors) {
+    if (t.dims() >= 2) {
+      max_secondary_dim = std::max(max_secondary_dim, t.dim_size(1));
+    }
+  }
+  // Requests larger than the last boundary go to an overflow bucket.
+  const int64_t bucket =
+      std::lower_bound(shape_bucket_boundaries_.begin(),
+                       shape_bucket_boundaries_.end(), max_secondary_dim) -
+      shape_bucket_boundaries_.begin();
+  *queue_name = absl::StrCat(batcher_queue_, "/shape_bucket_", bucket);
+  return OkStatus();
+}
+
 // Initialize vars by reading from op-kernel-construction.
 // Vars
 // - enable_adaptive_batch_threads_
@@ -79,6 +79,17 @@ class BatchFunctionKernel : public AsyncOpKernel {
   // to `max_batch_size_`.
   Status ValidateAllowedBatchSizes() const;
 
+  // Validates 'shape_bucket_boundaries_'. The entries must be positive and
+  // strictly increasing.
+  Status ValidateShapeBucketBoundaries() const;
+
+  // Returns the name of the batcher queue the request in `c` should be
+  // enqueued to. When 'shape_bucket_boundaries_' is non-empty, this is
+  // `batcher_queue_` plus a suffix identifying the shape bucket the request
+  // falls into, so that only requests from the same bucket are batched
+  // together.
+  Status GetBatcherQueueName(OpKernelContext* c, string* queue_name) const;
+
   // Creates the function handle if it isn't initialized yet; and re-use it
   // afterwards.
   Status GetOrCreateFunctionHandle(OpKernelContext* c,
@@ -109,6 +120,7 @@ class BatchFunctionKernel : public AsyncOpKernel {
   int32 low_priority_batch_timeout_micros_;
   int32 low_priority_max_enqueued_batches_;
   std::vector<int32> low_priority_allowed_batch_sizes_;
+  std::vector<int32> shape_bucket_boundaries_;
   NameAttrList func_;
   absl::optional<FunctionLibraryRuntime::Handle> fhandle_ TF_GUARDED_BY(mu_);
   bool enable_large_batch_splitting_;
@@ -52,6 +52,48 @@ TEST_P(BatchFunctionKernelTest, EnableAdaptiveScheduler) {
 
 INSTANTIATE_TEST_SUITE_P(Params, BatchFunctionKernelTest, ::testing::Bool());
 
+class BatchFunctionKernelShapeBucketTest : public OpsTestBase {
+ public:
+  // Init test fixture with a batch kernel instance using the given shape
+  // bucket boundaries.
+  Status Init(const std::vector<int32> &shape_bucket_boundaries) {
+    std::vector<DataType> input_dtypes({DataType::DT_INT64});
+    NameAttrList f;
+    f.set_name("func_to_batch");
+    TF_RETURN_IF_ERROR(
+        NodeDefBuilder("batch_fn", "BatchFunction")
+            .Attr("max_batch_size", 32)
+            .Attr("num_batch_threads", 8)
+            .Attr("batch_timeout_micros", 1000)
+            .Attr("Tin", input_dtypes)
+            .Input(std::vector<NodeDefBuilder::NodeOut>{
+                NodeDefBuilder::NodeOut({"n1", 0, DataType::DT_INT64})})
+            .Attr("Tcaptured", std::vector<DataType>{})
+            .Input(std::vector<NodeDefBuilder::NodeOut>{})
+            .Attr("Tout", std::vector<DataType>{DataType::DT_INT64})
+            .Attr("f", f)
+            .Attr("shape_bucket_boundaries", shape_bucket_boundaries)
+            .Finalize(node_def()));
+    return InitOp();
+  }
+};
+
+TEST_F(BatchFunctionKernelShapeBucketTest, ValidBoundaries) {
+  TF_EXPECT_OK(Init({16, 32, 64}));
+}
+
+TEST_F(BatchFunctionKernelShapeBucketTest, EmptyBoundaries) {
+  TF_EXPECT_OK(Init({}));
+}
+
+TEST_F(BatchFunctionKernelShapeBucketTest, NonIncreasingBoundaries) {
+  EXPECT_FALSE(Init({16, 16, 32}).ok());
+}
+
+TEST_F(BatchFunctionKernelShapeBucketTest, NonPositiveBoundaries) {
+  EXPECT_FALSE(Init({0, 16}).ok());
+}
+
 class BatchFunctionKernelParallelWarmupTestState : public OpsTestBase {
  public:
   // Init test fixture with a batch kernel instance.
@@ -52,6 +52,7 @@ limitations under the License.
 #include "tensorflow/core/platform/status.h"
 #include "tensorflow/core/profiler/lib/traceme.h"
 #include "tensorflow/core/profiler/lib/traceme_encode.h"
+#include "tensorflow/core/util/env_var.h"
 #include "tensorflow/core/util/incremental_barrier.h"
 #include "tsl/platform/errors.h"
 #include "tsl/platform/statusor.h"
@@ -266,6 +267,60 @@ using ::tensorflow::concat_split_util::Concat;
 using ::tensorflow::concat_split_util::Split;
 using TensorMatrix = std::vector<std::vector<Tensor>>;
 
+// Whether `ConcatInputTensors` may assemble batches as views of the request
+// tensors instead of copying them into a freshly allocated buffer.
+bool ZeroCopyBatchAssemblyEnabled() {
+  static const bool enabled = [] {
+    bool value = false;
+    TF_CHECK_OK(ReadBoolFromEnvVar("TF_BATCH_ZERO_COPY_CONCAT",
+                                   /*default_val=*/false, &value));
+    return value;
+  }();
+  return enabled;
+}
+
+// Assembles the batch's input tensors as views of existing memory when no
+// copy is needed: a batch holding a single task reuses the task's tensors
+// directly, and a batch made entirely of adjacent splits of one invocation
+// slices the original (pre-split) tensors. Returns true and fills
+// `concatenated_tensors` on success; leaves it untouched otherwise. The
+// views share refcounted buffers with the tasks, so downstream in-place
+// forwarding is automatically disabled for them.
+bool MaybeGetBatchInputViews(const BatchResourceBase::BatchT& batch,
+                             std::vector<Tensor>* concatenated_tensors) {
+  const int num_inputs = batch.task(0).inputs.size();
+  std::vector<Tensor> views;
+  views.reserve(num_inputs);
+  if (batch.num_tasks() == 1) {
+    for (int i = 0; i < num_inputs; ++i) {
+      const Tensor& input = batch.task(0).inputs.at(i);
+      if (!input.IsAligned()) return false;
+      views.push_back(input);
+    }
+  } else {
+    // All tasks must be adjacent splits of the same invocation, in order.
+    const auto& source = batch.task(0).split_source_inputs;
+    if (source == nullptr) return false;
+    const int64_t start = batch.task(0).split_source_offset;
+    int64_t offset = start;
+    for (int t = 0; t < batch.num_tasks(); ++t) {
+      const BatchResourceBase::BatchTask& task = batch.task(t);
+      if (task.split_source_inputs != source ||
+          task.split_source_offset != offset) {
+        return false;
+      }
+      offset += task.size();
+    }
+    for (int i = 0; i < num_inputs; ++i) {
+      Tensor view = (*source)[i].Slice(start, offset);
+      if (!view.IsAligned()) return false;
+      views.push_back(std::move(view));
+    }
+  }
+  *concatenated_tensors = std::move(views);
+  return true;
+}
+
 string GetTensorNamesAndShapesString(const OpKernelContext* context,
                                      const OpInputList& tensors) {
   std::stringstream out;
@@ -590,6 +645,14 @@ Status BatchResourceBase::ConcatInputTensors(
   RecordBatchSize(batch.size(), GetModelName(context),
                   context->op_kernel().name());
 
+  // When no padding is needed, try to hand the batch to the kernel as a view
+  // of the request tensors, skipping the concat memcpy entirely.
+  if (!just_for_warmup && padding_amount == 0 &&
+      ZeroCopyBatchAssemblyEnabled() &&
+      MaybeGetBatchInputViews(batch, concatenated_tensors)) {
+    return OkStatus();
+  }
+
   // All tasks should have the same number of input edges.
   const int num_inputs = batch.task(0).inputs.size();
   concatenated_tensors->reserve(num_inputs);
@@ -731,6 +794,18 @@ Status BatchResourceBase::ConcatInputTensors(
                 std::back_inserter(output_task.inputs));
     }
   }
+
+  // Record the split lineage so that `ConcatInputTensors` can reassemble
+  // adjacent splits as a slice of the original inputs instead of copying.
+  auto split_source =
+      std::make_shared<const std::vector<Tensor>>(input_task.inputs);
+  int64_t split_offset = 0;
+  for (int j = 0; j < output_tasks->size(); ++j) {
+    BatchTask& output_task = *((*output_tasks)[j]);
+    output_task.split_source_inputs = split_source;
+    output_task.split_source_offset = split_offset;
+    split_offset += output_task_sizes[j];
+  }
   return OkStatus();
 }
 
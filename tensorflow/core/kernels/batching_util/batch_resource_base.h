@@ -78,6 +78,14 @@ class BatchResourceBase : public ResourceBase {
     // invocation.
     int split_index = 0;
 
+    // When this task was produced by `SplitInputTask`, the inputs of the
+    // original (pre-split) task and this task's starting row within them.
+    // `ConcatInputTensors` uses these to reassemble adjacent splits of the
+    // same invocation as a slice of the original tensors instead of copying.
+    // Shared by all splits of the invocation; null for unsplit tasks.
+    std::shared_ptr<const std::vector<Tensor>> split_source_inputs;
+    int64_t split_source_offset = 0;
+
     // Two-dimensional tensor matrix, ownership shared by:
     // 1) each split of task (to fill one row in this matrix)
     // and
@@ -94,6 +94,18 @@ class CheckNumericsOp<CPUDevice, T> : public OpKernel {
     auto in = context->input(0).flat<T>();
     const T* data = in.data();
     const int64_t size = in.size();
+    if (size == 0) return;
+
+    // Fast path: almost every tensor passing through this op is entirely
+    // finite, and that can be established with a single vectorized (and, for
+    // large tensors, sharded) classify-and-reduce pass. Only abnormal tensors
+    // fall through to the branchy per-element scan below, which exists to
+    // compose the error message.
+    Eigen::TensorFixedSize<bool, Eigen::Sizes<>, Eigen::RowMajor> all_finite;
+    all_finite.device(context->eigen_device<CPUDevice>()) =
+        in.isfinite().all();
+    if (TF_PREDICT_TRUE(all_finite())) return;
+
     // Check to see if any element of the tensor is NaN or Inf.
     int fp_props = std::accumulate(
         data, data + size, 0,
@@ -0,0 +1,134 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_KERNELS_CHUNKED_COPY_H_
+#define TENSORFLOW_CORE_KERNELS_CHUNKED_COPY_H_
+
+// A size-aware copy engine shared by the data-movement kernels (Concat, Pack,
+// Split). Copies small enough to stay cache-resident use plain memcpy; copies
+// whose output exceeds the last-level cache use non-temporal (streaming)
+// stores so the output does not evict the working set it is about to be
+// consumed with, and large contiguous copies are chunked across the intra-op
+// thread pool.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "unsupported/Eigen/CXX11/Tensor"  // from @eigen_archive
+#include "tensorflow/core/framework/device_base.h"
+#include "tensorflow/core/util/work_sharder.h"
+
+namespace tensorflow {
+
+// Fallback when Eigen cannot determine the last-level cache size.
+constexpr int64_t kDefaultLastLevelCacheBytes = 16 << 20;
+
+// Streaming stores only pay off when a slice is long enough to amortize the
+// unaligned head/tail handling.
+constexpr int64_t kMinNontemporalSliceBytes = 2048;
+
+inline int64_t LastLevelCacheBytes() {
+  static const int64_t cache_bytes = [] {
+    const std::ptrdiff_t l3 = Eigen::l3CacheSize();
+    return l3 > 0 ? static_cast<int64_t>(l3) : kDefaultLastLevelCacheBytes;
+  }();
+  return cache_bytes;
+}
+
+// Returns true if a copy producing `total_output_bytes` should bypass the
+// caches: an output larger than the LLC cannot be consumed from cache anyway,
+// so writing it through only evicts useful data.
+inline bool CopyBypassesCaches(int64_t total_output_bytes) {
+  return total_output_bytes > LastLevelCacheBytes();
+}
+
+// memcpy variant using non-temporal stores where the hardware supports them.
+// The destination contents are in memory (not cache) when this returns.
+inline void NontemporalMemcpy(void* dst, const void* src, size_t n) {
+#if defined(__SSE2__)
+  char* d = static_cast<char*>(dst);
+  const char* s = static_cast<const char*>(src);
+  // Streaming stores require a 16-byte aligned destination; copy the
+  // unaligned head conventionally.
+  size_t head = (16 - (reinterpret_cast<uintptr_t>(d) & 15)) & 15;
+  head = std::min(head, n);
+  if (head > 0) {
+    memcpy(d, s, head);
+    d += head;
+    s += head;
+    n -= head;
+  }
+  while (n >= 64) {
+    const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s));
+    const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 16));
+    const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 32));
+    const __m128i e = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 48));
+    _mm_stream_si128(reinterpret_cast<__m128i*>(d), a);
+    _mm_stream_si128(reinterpret_cast<__m128i*>(d + 16), b);
+    _mm_stream_si128(reinterpret_cast<__m128i*>(d + 32), c);
+    _mm_stream_si128(reinterpret_cast<__m128i*>(d + 48), e);
+    d += 64;
+    s += 64;
+    n -= 64;
+  }
+  if (n > 0) {
+    memcpy(d, s, n);
+  }
+  // Make the streaming stores visible to other cores before the copy is
+  // reported complete.
+  _mm_sfence();
+#else
+  memcpy(dst, src, n);
+#endif  // defined(__SSE2__)
+}
+
+// memcpy that streams past the caches when `bypass_caches` is set and the
+// slice is long enough for streaming to pay off.
+inline void SizeAwareMemcpy(void* dst, const void* src, size_t n,
+                            bool bypass_caches) {
+  if (bypass_caches && n >= static_cast<size_t>(kMinNontemporalSliceBytes)) {
+    NontemporalMemcpy(dst, src, n);
+  } else {
+    memcpy(dst, src, n);
+  }
+}
+
+// Copies a contiguous range, chunked across the intra-op thread pool, using
+// non-temporal stores when the range exceeds the last-level cache.
+inline void ChunkedParallelCopy(DeviceBase* d, char* dst, const char* src,
+                                size_t n) {
+  const bool bypass_caches = CopyBypassesCaches(static_cast<int64_t>(n));
+  auto* worker_threads = d->tensorflow_cpu_worker_threads();
+  if (worker_threads == nullptr || worker_threads->num_threads <= 1 ||
+      !bypass_caches) {
+    SizeAwareMemcpy(dst, src, n, bypass_caches);
+    return;
+  }
+  Shard(worker_threads->num_threads, worker_threads->workers,
+        static_cast<int64_t>(n), /*cost_per_unit=*/1,
+        [dst, src, bypass_caches](int64_t start, int64_t end) {
+          SizeAwareMemcpy(dst + start, src + start,
+                          static_cast<size_t>(end - start), bypass_caches);
+        });
+}
+
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_KERNELS_CHUNKED_COPY_H_
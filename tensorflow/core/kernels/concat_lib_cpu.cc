@@ -20,6 +20,7 @@ limitations under the License.
 #include <vector>
 
 #include "tensorflow/core/framework/register_types.h"
+#include "tensorflow/core/kernels/chunked_copy.h"
 #include "tensorflow/core/kernels/concat_lib.h"
 
 namespace tensorflow {
@@ -27,18 +28,23 @@ namespace tensorflow {
 namespace {
 template <typename T>
 struct MemCpyCopier {
+  explicit MemCpyCopier(bool bypass_caches) : bypass_caches(bypass_caches) {}
   inline void Copy(T* dst, const T* src, int input_index, size_t n) {
     if (DataTypeCanUseMemcpy(DataTypeToEnum<T>::v())) {
-      memcpy(dst, src, n * sizeof(T));
+      SizeAwareMemcpy(dst, src, n * sizeof(T), bypass_caches);
     } else {
       for (size_t k = 0; k < n; ++k) {
         *dst++ = *src++;
       }
     }
   }
+  // True when the full output exceeds the last-level cache, in which case
+  // large slices are copied with non-temporal stores.
+  const bool bypass_caches;
 };
 template <>
 struct MemCpyCopier<ResourceHandle> {
+  explicit MemCpyCopier(bool bypass_caches) {}
   inline void Copy(ResourceHandle* dst, const ResourceHandle* src,
                    int input_index, size_t n) {
     for (size_t k = 0; k < n; ++k) {
@@ -104,7 +110,10 @@ void ConcatCPU(
         inputs,
     typename TTypes<T, 2>::Matrix* output) {
   int64_t cost_per_unit = EstimateBytesPerElement<T>(inputs);
-  ConcatCPUImpl<T>(d, inputs, cost_per_unit, MemCpyCopier<T>(), output);
+  const bool bypass_caches =
+      CopyBypassesCaches(output->size() * static_cast<int64_t>(sizeof(T)));
+  ConcatCPUImpl<T>(d, inputs, cost_per_unit, MemCpyCopier<T>(bypass_caches),
+                   output);
 }
 
 #define REGISTER(T)                                                            \
@@ -20,6 +20,7 @@ limitations under the License.
 
 #include <vector>
 #include "tensorflow/core/framework/register_types.h"
+#include "tensorflow/core/kernels/chunked_copy.h"
 #include "tensorflow/core/kernels/concat_lib.h"
 #include "tensorflow/core/util/work_sharder.h"
 
@@ -51,7 +52,12 @@ void ConcatCPUImpl(
   const int64_t estimated_total_cost = output->size() * cost_per_unit;
 
   auto worker_threads = d->tensorflow_cpu_worker_threads();
-  int num_threads = std::min(4, worker_threads->num_threads);
+  // Four threads saturate a cache-resident concat; once the output spills
+  // past the last-level cache the copy is memory-bound and more threads keep
+  // helping until the bandwidth limit, so raise the cap for those.
+  const int max_copy_threads =
+      CopyBypassesCaches(estimated_total_cost) ? 16 : 4;
+  int num_threads = std::min(max_copy_threads, worker_threads->num_threads);
   num_threads = static_cast<int>(
       std::min<int64_t>(num_threads, estimated_total_cost / 16384));
   // Single threaded mode.
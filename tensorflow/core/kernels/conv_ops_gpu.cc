@@ -19,6 +19,7 @@ limitations under the License.
 
 #include "tensorflow/core/profiler/lib/scoped_annotation.h"
 #include "tensorflow/core/protobuf/autotuning.pb.h"
+#include "tensorflow/core/util/autotune_maps/autotune_serialize.h"
 #include "tensorflow/core/util/proto/proto_utils.h"
 #include "tensorflow/core/util/use_cudnn.h"
 
@@ -61,6 +62,52 @@ bool ComputeInNhwcEnabled(DataType data_type, se::Stream* stream,
 #endif  // GOOGLE_CUDA
 }
 
+/*static*/ DnnScratchCache* DnnScratchCache::GetForStream(se::Stream* stream) {
+  static const int64_t capacity_bytes =
+      GetDnnWorkspaceLimit("TF_CUDNN_WORKSPACE_CACHE_MB", 0);
+  if (capacity_bytes <= 0 || stream == nullptr) return nullptr;
+  static mutex* shards_mu = new mutex;
+  static auto* shards = new std::map<se::Stream*, DnnScratchCache*>;
+  mutex_lock l(*shards_mu);
+  auto it = shards->find(stream);
+  if (it == shards->end()) {
+    it = shards->emplace(stream, new DnnScratchCache(capacity_bytes)).first;
+  }
+  return it->second;
+}
+
+bool DnnScratchCache::Acquire(int64_t byte_size, Tensor* out) {
+  mutex_lock l(mu_);
+  auto it = entries_.find(byte_size);
+  if (it == entries_.end()) return false;
+  *out = std::move(it->second.tensor);
+  cached_bytes_ -= byte_size;
+  entries_.erase(it);
+  return true;
+}
+
+void DnnScratchCache::Release(Tensor tensor) {
+  const int64_t byte_size = tensor.NumElements();
+  if (byte_size <= 0 || byte_size > capacity_bytes_) return;
+  mutex_lock l(mu_);
+  entries_.emplace(byte_size, Entry{std::move(tensor), next_tick_++});
+  cached_bytes_ += byte_size;
+  while (cached_bytes_ > capacity_bytes_) {
+    auto lru = entries_.begin();
+    for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+      if (it->second.last_use < lru->second.last_use) lru = it;
+    }
+    cached_bytes_ -= lru->first;
+    entries_.erase(lru);
+  }
+}
+
+void DnnScratchCache::Clear() {
+  mutex_lock l(mu_);
+  entries_.clear();
+  cached_bytes_ = 0;
+}
+
 // Finds the best convolution algorithm for the given ConvLaunch (cuda
 // convolution on the stream) and parameters, by running all possible
 // algorithms and measuring execution time.
@@ -84,6 +131,17 @@ StatusOr<AutotuneEntry<se::dnn::FusedConvOp>> AutotuneFusedConv(
   AutotuneEntry<se::dnn::FusedConvOp> autotune_entry;
   auto* stream = ctx->op_device_context()->stream();
 
+  if (!autotune_map->Find(params, &autotune_entry)) {
+    // On the first miss, pull in any persisted autotune results (no-op unless
+    // TF_AUTOTUNE_PERSISTENT_CACHE_DIR is set) and re-check the map before
+    // paying for an autotuning sweep.
+    Status load_status = LoadPersistentAutotuneMaps();
+    if (!load_status.ok()) {
+      LOG_FIRST_N(WARNING, 1)
+          << "Failed to load persisted autotune results: " << load_status;
+    }
+  }
+
   if (!autotune_map->Find(params, &autotune_entry)) {
     profiler::ScopedAnnotation trace("cudnn_autotuning");
 
@@ -171,6 +229,7 @@ StatusOr<AutotuneEntry<se::dnn::FusedConvOp>> AutotuneFusedConv(
     }
 
     autotune_map->Insert(params, autotune_entry);
+    RequestPersistentAutotuneMapsSave();
   }
   return autotune_entry;
 #else
@@ -246,6 +305,17 @@ StatusOr<AutotuneEntry<se::dnn::ConvOp>> AutotuneUnfusedConv(
 
   auto* stream = ctx->op_device_context()->stream();
 
+  if (!autotune_map->Find(conv_parameters, &autotune_entry)) {
+    // On the first miss, pull in any persisted autotune results (no-op unless
+    // TF_AUTOTUNE_PERSISTENT_CACHE_DIR is set) and re-check the map before
+    // paying for an autotuning sweep.
+    Status load_status = LoadPersistentAutotuneMaps();
+    if (!load_status.ok()) {
+      LOG_FIRST_N(WARNING, 1)
+          << "Failed to load persisted autotune results: " << load_status;
+    }
+  }
+
   if (!autotune_map->Find(conv_parameters, &autotune_entry)) {
     profiler::ScopedAnnotation annotation("cudnn_autotuning");
 
@@ -399,6 +469,7 @@ StatusOr<AutotuneEntry<se::dnn::ConvOp>> AutotuneUnfusedConv(
 #endif
 
     autotune_map->Insert(conv_parameters, autotune_entry);
+    RequestPersistentAutotuneMapsSave();
   }
 
   return autotune_entry;
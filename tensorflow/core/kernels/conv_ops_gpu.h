@@ -18,6 +18,7 @@ limitations under the License.
 
 #if GOOGLE_CUDA || TENSORFLOW_USE_ROCM
 
+#include <map>
 #include <tuple>
 #include <unordered_map>
 
@@ -27,6 +28,7 @@ limitations under the License.
 #include "tensorflow/core/kernels/gpu_utils.h"
 #include "tensorflow/core/lib/gtl/inlined_vector.h"
 #include "tensorflow/core/lib/hash/hash.h"
+#include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/util/autotune_maps/conv_parameters.h"
 #include "tensorflow/core/util/tensor_format.h"
 
@@ -44,12 +46,61 @@ int64 GetDnnWorkspaceLimit(const string& envvar_in_mb,
 // Call the Dnn workspace limit from TF_CUDNN_WORKSPACE_LIMIT_IN_MB or default.
 int64 GetDnnWorkspaceLimitOrDefault();
 
+// Process-wide cache of Dnn workspace tensors, sharded per compute stream.
+// Cached entries keep their backing BFC allocation alive, so repeated
+// convolutions needing the same workspace size skip the allocator round-trip
+// entirely. Reuse is safe because a buffer is only handed out again for work
+// enqueued on the same stream that used it last, which serializes the two
+// uses. The cache is disabled unless TF_CUDNN_WORKSPACE_CACHE_MB is set to a
+// positive per-stream byte cap; eviction is least-recently-used once the cap
+// is exceeded, and the whole shard is dropped back to the BFC allocator when
+// a workspace allocation fails under memory pressure.
+class DnnScratchCache {
+ public:
+  // Returns the cache shard for `stream`, or nullptr if caching is disabled.
+  static DnnScratchCache* GetForStream(se::Stream* stream);
+
+  // Moves a cached tensor of exactly `byte_size` usable bytes into `*out`.
+  // Returns false on a cache miss.
+  bool Acquire(int64_t byte_size, Tensor* out);
+
+  // Returns `tensor` to the cache, evicting least-recently-used entries if
+  // the byte cap is now exceeded.
+  void Release(Tensor tensor);
+
+  // Drops all cached entries, returning their memory to the allocator.
+  void Clear();
+
+ private:
+  explicit DnnScratchCache(int64_t capacity_bytes)
+      : capacity_bytes_(capacity_bytes) {}
+
+  struct Entry {
+    Tensor tensor;
+    int64_t last_use;
+  };
+
+  const int64_t capacity_bytes_;
+  mutex mu_;
+  int64_t next_tick_ TF_GUARDED_BY(mu_) = 0;
+  int64_t cached_bytes_ TF_GUARDED_BY(mu_) = 0;
+  // Keyed by usable byte size; Dnn workspace sizes repeat exactly for a given
+  // convolution shape and algorithm, so exact-size matching suffices.
+  std::multimap<int64_t, Entry> entries_ TF_GUARDED_BY(mu_);
+};
+
 // A class to provide scratch-space allocator for Stream-Executor Cudnn
 // callback. TensorFlow is responsible for releasing the temporary buffers after
 // the kernel finishes.
 class DnnScratchAllocator : public se::ScratchAllocator {
  public:
-  virtual ~DnnScratchAllocator() {}
+  virtual ~DnnScratchAllocator() {
+    if (cache_ != nullptr) {
+      for (Tensor& tensor : allocated_tensors_) {
+        cache_->Release(std::move(tensor));
+      }
+    }
+  }
   DnnScratchAllocator(int64_t memory_limit, OpKernelContext* context)
       : memory_limit_(memory_limit), total_byte_size_(0), context_(context) {}
   int64 GetMemoryLimitInBytes() override { return memory_limit_; }
@@ -66,16 +117,30 @@ class DnnScratchAllocator : public se::ScratchAllocator {
                                       ") exceeds the max memory limit (",
                                       memory_limit_, ").")};
     }
-    AllocationAttributes allocation_attr;
-    allocation_attr.retry_on_failure = false;
-    Status allocation_status(context_->allocate_temp(
-        DT_UINT8, TensorShape({byte_size}), &temporary_memory,
-        AllocatorAttributes(), allocation_attr));
-    if (!allocation_status.ok()) {
-      return tsl::Status{
-          absl::StatusCode::kUnavailable,
-          absl::StrCat("Failed to allocate the requested memory size (",
-                       byte_size, ").")};
+    if (cache_ == nullptr && context_->op_device_context() != nullptr) {
+      cache_ = DnnScratchCache::GetForStream(
+          context_->op_device_context()->stream());
+    }
+    if (cache_ == nullptr || !cache_->Acquire(byte_size, &temporary_memory)) {
+      AllocationAttributes allocation_attr;
+      allocation_attr.retry_on_failure = false;
+      Status allocation_status(context_->allocate_temp(
+          DT_UINT8, TensorShape({byte_size}), &temporary_memory,
+          AllocatorAttributes(), allocation_attr));
+      if (!allocation_status.ok() && cache_ != nullptr) {
+        // Memory pressure: hand the cached workspaces back to the BFC
+        // allocator and retry once.
+        cache_->Clear();
+        allocation_status = context_->allocate_temp(
+            DT_UINT8, TensorShape({byte_size}), &temporary_memory,
+            AllocatorAttributes(), allocation_attr);
+      }
+      if (!allocation_status.ok()) {
+        return tsl::Status{
+            absl::StatusCode::kUnavailable,
+            absl::StrCat("Failed to allocate the requested memory size (",
+                         byte_size, ").")};
+      }
     }
     // Hold the reference of the allocated tensors until the end of the
     // allocator.
@@ -92,6 +157,7 @@ class DnnScratchAllocator : public se::ScratchAllocator {
   int64 total_byte_size_;
   OpKernelContext* context_;
   std::vector<Tensor> allocated_tensors_;
+  DnnScratchCache* cache_ = nullptr;
 };
 
 typedef Eigen::GpuDevice GPUDevice;
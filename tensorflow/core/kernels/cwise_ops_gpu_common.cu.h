@@ -29,6 +29,7 @@ limitations under the License.
 #include "tensorflow/core/kernels/cwise_ops.h"
 #include "tensorflow/core/platform/logging.h"
 #include "tensorflow/core/platform/types.h"
+#include "tensorflow/core/util/gpu_kernel_helper.h"
 namespace tensorflow {
 namespace functor {
 
@@ -36,11 +37,44 @@ typedef Eigen::GpuDevice GPUDevice;
 typedef std::complex<float> complex64;
 typedef std::complex<double> complex128;
 
+// Tensors at or below this element count take the flat small-tensor kernels
+// below instead of the Eigen executor. For the microsecond-scale elementwise
+// ops of autoregressive decode loops this skips the per-launch expression
+// setup on the host and replaces the full-occupancy grid with a few small
+// blocks; the kernel launch itself remains, so this trims rather than removes
+// the per-op overhead.
+constexpr int kSmallCwiseElements = 4096;
+constexpr int kSmallCwiseThreads = 128;
+
+template <typename Func, typename Tout, typename Tin>
+__global__ void SmallUnaryOpKernel(int n, const Tin* in, Tout* out,
+                                   Func func) {
+  GPU_1D_KERNEL_LOOP(i, n) { out[i] = func(in[i]); }
+}
+
+template <typename Func, typename Tout, typename Tin>
+__global__ void SmallBinaryOpKernel(int n, const Tin* in0, const Tin* in1,
+                                    Tout* out, Func func) {
+  GPU_1D_KERNEL_LOOP(i, n) { out[i] = func(in0[i], in1[i]); }
+}
+
 // Partial specialization of UnaryFunctor<Device=GPUDevice, Functor>.
 template <typename Functor>
 struct UnaryFunctor<GPUDevice, Functor> {
   void operator()(const GPUDevice& d, typename Functor::tout_type out,
                   typename Functor::tin_type in) {
+    const int64_t size = out.size();
+    if (size > 0 && size <= kSmallCwiseElements) {
+      const int blocks =
+          (size + kSmallCwiseThreads - 1) / kSmallCwiseThreads;
+      TF_CHECK_OK(GpuLaunchKernel(
+          SmallUnaryOpKernel<typename Functor::func,
+                             typename Functor::out_type,
+                             typename Functor::in_type>,
+          blocks, kSmallCwiseThreads, 0, d.stream(), static_cast<int>(size),
+          in.data(), out.data(), typename Functor::func()));
+      return;
+    }
     MaybeWith32BitIndexing<GPUDevice>(
         [&](auto out32, auto in32) {
           out32.device(d) = in32.unaryExpr(typename Functor::func());
@@ -55,6 +89,18 @@ struct BinaryFunctor<GPUDevice, Functor, NDIMS, has_errors> {
   void operator()(const GPUDevice& d, typename Functor::tout_type out,
                   typename Functor::tin_type in0,
                   typename Functor::tin_type in1, bool* error) {
+    const int64_t size = out.size();
+    if (size > 0 && size <= kSmallCwiseElements) {
+      const int blocks =
+          (size + kSmallCwiseThreads - 1) / kSmallCwiseThreads;
+      TF_CHECK_OK(GpuLaunchKernel(
+          SmallBinaryOpKernel<typename Functor::func,
+                              typename Functor::out_type,
+                              typename Functor::in_type>,
+          blocks, kSmallCwiseThreads, 0, d.stream(), static_cast<int>(size),
+          in0.data(), in1.data(), out.data(), typename Functor::func()));
+      return;
+    }
     MaybeWith32BitIndexing<GPUDevice>(
         [&](auto out32, auto in0_32, auto in1_32) {
           out32.device(d) = in0_32.binaryExpr(in1_32, typename Functor::func());
@@ -69,6 +115,16 @@ struct BinaryFunctor<GPUDevice, Functor, NDIMS, has_errors> {
     typedef typename Functor::in_type Tin;
     typedef typename Functor::func Binary;
     typedef typename Eigen::internal::scalar_left<Tout, Tin, Binary> Unary;
+    const int64_t size = out.size();
+    if (size > 0 && size <= kSmallCwiseElements) {
+      const int blocks =
+          (size + kSmallCwiseThreads - 1) / kSmallCwiseThreads;
+      TF_CHECK_OK(GpuLaunchKernel(SmallUnaryOpKernel<Unary, Tout, Tin>, blocks,
+                                  kSmallCwiseThreads, 0, d.stream(),
+                                  static_cast<int>(size), in.data(), out.data(),
+                                  Unary(scalar.data())));
+      return;
+    }
     MaybeWith32BitIndexing<GPUDevice>(
         [&](auto out32, auto in32) {
           out32.device(d) = in32.unaryExpr(Unary(scalar.data()));
@@ -83,6 +139,16 @@ struct BinaryFunctor<GPUDevice, Functor, NDIMS, has_errors> {
     typedef typename Functor::in_type Tin;
     typedef typename Functor::func Binary;
     typedef typename Eigen::internal::scalar_right<Tout, Tin, Binary> Unary;
+    const int64_t size = out.size();
+    if (size > 0 && size <= kSmallCwiseElements) {
+      const int blocks =
+          (size + kSmallCwiseThreads - 1) / kSmallCwiseThreads;
+      TF_CHECK_OK(GpuLaunchKernel(SmallUnaryOpKernel<Unary, Tout, Tin>, blocks,
+                                  kSmallCwiseThreads, 0, d.stream(),
+                                  static_cast<int>(size), in.data(), out.data(),
+                                  Unary(scalar.data())));
+      return;
+    }
     MaybeWith32BitIndexing<GPUDevice>(
         [&](auto out32, auto in32) {
           out32.device(d) = in32.unaryExpr(Unary(scalar.data()));
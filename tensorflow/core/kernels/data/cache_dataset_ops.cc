@@ -930,14 +930,20 @@ class CacheDatasetOp::MemoryDatasetBase : public DatasetBase {
             index_(0) {}
 
       Status Initialize(IteratorContext* ctx) override {
+        mutex_lock l(mu_);
+        // This iterator is only created once the cache has been completed,
+        // so the frozen snapshot is always available. Holding it privately
+        // lets `GetNextInternal` read elements without contending on the
+        // shared cache's lock with other concurrent readers.
+        cache_data_ = cache_->Finalized();
+        DCHECK(cache_data_ != nullptr);
         // The memory allocated for the cache is owned by the parent
         // dataset but performance modeling uses the iterator abstraction and
         // thus we record the memory allocated for the cache here. The caveat
         // is that this is incorrect if there are concurrent instances of this
         // iterator.
-        tf_shared_lock l(mu_);
-        for (size_t i = 0; i < cache_->size(); ++i) {
-          RecordBufferEnqueue(ctx, cache_->at(i));
+        for (size_t i = 0; i < cache_data_->size(); ++i) {
+          RecordBufferEnqueue(ctx, cache_data_->at(i));
         }
         return OkStatus();
       }
@@ -946,8 +952,10 @@ class CacheDatasetOp::MemoryDatasetBase : public DatasetBase {
                              std::vector<Tensor>* out_tensors,
                              bool* end_of_sequence) override {
         mutex_lock l(mu_);
-        if (index_ < cache_->size()) {
-          const std::vector<Tensor>& cache_tensors = cache_->at(index_);
+        if (index_ < cache_data_->size()) {
+          // The inserted Tensors alias the cached buffers rather than
+          // copying them.
+          const std::vector<Tensor>& cache_tensors = cache_data_->at(index_);
           out_tensors->insert(out_tensors->begin(), cache_tensors.begin(),
                               cache_tensors.end());
           index_++;
@@ -979,7 +987,7 @@ class CacheDatasetOp::MemoryDatasetBase : public DatasetBase {
         {
           // kIndex will not be set if we are restoring from a checkpoint
           // written by a MemoryWriterIterator that has completed its cache.
-          int64_t temp = cache_->size();
+          int64_t temp = cache_data_->size();
           if (reader->Contains(prefix(), kIndex)) {
             TF_RETURN_IF_ERROR(reader->ReadScalar(prefix(), kIndex, &temp));
           }
@@ -991,6 +999,10 @@ class CacheDatasetOp::MemoryDatasetBase : public DatasetBase {
      private:
       mutex mu_;
       MemoryCache* const cache_ TF_GUARDED_BY(mu_);  // not owned.
+      // Immutable snapshot of the completed cache, shared zero-copy with
+      // other readers. Set once in `Initialize`.
+      std::shared_ptr<const MemoryCache::Elements> cache_data_
+          TF_GUARDED_BY(mu_);
       size_t index_ TF_GUARDED_BY(mu_);
     };  // MemoryReaderIterator
 
@@ -14,6 +14,10 @@ limitations under the License.
 ==============================================================================*/
 #include "tensorflow/core/kernels/data/cache_ops.h"
 
+#include <memory>
+#include <utility>
+#include <vector>
+
 #include "tensorflow/core/data/dataset_utils.h"
 #include "tensorflow/core/framework/dataset.h"
 #include "tensorflow/core/framework/partial_tensor_shape.h"
@@ -33,10 +37,10 @@ constexpr char kMemoryCache[] = "MemoryCache";
 
 string MemoryCacheManager::DebugString() const { return kMemoryCache; }
 
-void MemoryCache::Complete(std::vector<std::vector<Tensor>>&& cache) {
+void MemoryCache::Complete(Elements&& cache) {
   mutex_lock l(mu_);
   if (!completed_) {
-    cache_ = std::move(cache);
+    cache_ = std::make_shared<const Elements>(std::move(cache));
     completed_ = true;
   }
 }
@@ -49,22 +53,32 @@ bool MemoryCache::IsCompleted() {
 void MemoryCache::Reset() {
   mutex_lock l(mu_);
   completed_ = false;
-  cache_.clear();
+  // Readers holding a `Finalized()` snapshot keep the old storage alive;
+  // subsequent readers start from an empty cache.
+  cache_ = std::make_shared<Elements>();
 }
 
 const std::vector<Tensor>& MemoryCache::at(int64_t index) {
   tf_shared_lock l(mu_);
-  DCHECK(index < cache_.size());
-  return cache_[index];
+  DCHECK(index < cache_->size());
+  return (*cache_)[index];
 }
 
 size_t MemoryCache::size() {
   tf_shared_lock l(mu_);
-  return cache_.size();
+  return cache_->size();
+}
+
+const MemoryCache::Elements& MemoryCache::data() {
+  tf_shared_lock l(mu_);
+  return *cache_;
 }
 
-const std::vector<std::vector<Tensor>>& MemoryCache::data() {
+std::shared_ptr<const MemoryCache::Elements> MemoryCache::Finalized() {
   tf_shared_lock l(mu_);
+  if (!completed_) {
+    return nullptr;
+  }
   return cache_;
 }
 
@@ -16,6 +16,9 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_KERNELS_DATA_CACHE_OPS_H_
 #define TENSORFLOW_CORE_KERNELS_DATA_CACHE_OPS_H_
 
+#include <memory>
+#include <vector>
+
 #include "tensorflow/core/data/dataset_utils.h"
 #include "tensorflow/core/framework/resource_mgr.h"
 
@@ -25,14 +28,18 @@ namespace data {
 // A thread-safe data structure for caching dataset elements.
 //
 // The expected use is that a single `MemoryWriterIterator` populates the
-// cache with dataset elements. Once all elements are cached, the cache can
-// be used by one or more `MemoryReaderIterator`s.
+// cache with dataset elements. Once all elements are cached, the cache
+// freezes into an immutable snapshot that can be used by one or more
+// `MemoryReaderIterator`s without further synchronization.
 class MemoryCache {
  public:
+  using Elements = std::vector<std::vector<Tensor>>;
+
   MemoryCache() = default;
 
-  // Marks the cache as completed.
-  void Complete(std::vector<std::vector<Tensor>>&& cache);
+  // Marks the cache as completed, freezing `cache` into an immutable
+  // snapshot.
+  void Complete(Elements&& cache);
 
   // Returns whether the cache is completed.
   bool IsCompleted();
@@ -48,13 +55,20 @@ class MemoryCache {
 
   // Returns a reference to the cache's data. The returned reference will be
   // invalidated by any call to Reset().
-  const std::vector<std::vector<Tensor>>& data();
+  const Elements& data();
+
+  // Returns the completed cache as an immutable snapshot, or nullptr if the
+  // cache has not been completed yet. A reader that holds the snapshot can
+  // access elements without taking any lock, and the snapshot remains valid
+  // even if the cache is subsequently `Reset()`.
+  std::shared_ptr<const Elements> Finalized();
 
  private:
   mutex mu_;
   // Determines whether all elements of the dataset have been cached.
   bool completed_ TF_GUARDED_BY(mu_) = false;
-  std::vector<std::vector<Tensor>> cache_ TF_GUARDED_BY(mu_);
+  std::shared_ptr<const Elements> cache_ TF_GUARDED_BY(mu_) =
+      std::make_shared<Elements>();
 };
 
 // A resource wrapping a shared instance of a memory cache.
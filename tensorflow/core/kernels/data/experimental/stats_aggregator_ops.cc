@@ -12,7 +12,12 @@ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <map>
 #include <memory>
+#include <thread>
 
 #include "tensorflow/core/framework/op_kernel.h"
 #include "tensorflow/core/framework/op_requires.h"
@@ -51,8 +56,9 @@ class StatsAggregatorImpl : public StatsAggregator {
 
   void AddToHistogram(const string& name, gtl::ArraySlice<double> values,
                       const int64_t steps) override {
-    mutex_lock l(mu_);
-    histogram::Histogram& histogram = histograms_[name];
+    HistogramShard& shard = GetShard();
+    mutex_lock l(shard.mu);
+    histogram::Histogram& histogram = shard.histograms[name];
     for (double value : values) {
       histogram.Add(value);
     }
@@ -65,16 +71,42 @@ class StatsAggregatorImpl : public StatsAggregator {
   }
 
   void EncodeToProto(Summary* out_summary) override {
-    mutex_lock l(mu_);
-    for (const auto& pair : histograms_) {
-      const string& name = pair.first;
-      const histogram::Histogram& histogram = pair.second;
-
+    // Merges the per-shard histograms for each name. All shards use the
+    // default bucket boundaries, so the encoded protos (with zero buckets
+    // preserved) are merged bucket-by-bucket and re-encoded once.
+    std::map<string, HistogramProto> merged;
+    for (HistogramShard& shard : shards_) {
+      mutex_lock l(shard.mu);
+      for (const auto& pair : shard.histograms) {
+        HistogramProto proto;
+        pair.second.EncodeToProto(&proto, true /* preserve zero buckets */);
+        auto it = merged.find(pair.first);
+        if (it == merged.end()) {
+          merged[pair.first] = std::move(proto);
+          continue;
+        }
+        HistogramProto& to = it->second;
+        to.set_min(std::min(to.min(), proto.min()));
+        to.set_max(std::max(to.max(), proto.max()));
+        to.set_num(to.num() + proto.num());
+        to.set_sum(to.sum() + proto.sum());
+        to.set_sum_squares(to.sum_squares() + proto.sum_squares());
+        for (int i = 0; i < to.bucket_size(); ++i) {
+          to.set_bucket(i, to.bucket(i) + proto.bucket(i));
+        }
+      }
+    }
+    for (const auto& pair : merged) {
+      histogram::Histogram histogram;
+      if (!histogram.DecodeFromProto(pair.second)) {
+        continue;
+      }
       Summary::Value* value = out_summary->add_value();
-      value->set_tag(name);
+      value->set_tag(pair.first);
       histogram.EncodeToProto(value->mutable_histo(),
                               false /* doesn't preserve zero buckets */);
     }
+    mutex_lock l(mu_);
     for (const auto& pair : scalars_) {
       Summary::Value* value = out_summary->add_value();
       value->set_tag(pair.first);
@@ -106,9 +138,25 @@ class StatsAggregatorImpl : public StatsAggregator {
   }
 
  private:
+  // Histogram recording is sharded by thread so that the many dataset-op
+  // threads of a large pipeline do not serialize on a single aggregator lock;
+  // the shards are only merged on EncodeToProto.
+  static constexpr int kNumShards = 16;
+
+  struct HistogramShard {
+    mutex mu;
+    std::unordered_map<string, histogram::Histogram> histograms
+        TF_GUARDED_BY(mu);
+  };
+
+  HistogramShard& GetShard() {
+    const size_t shard =
+        std::hash<std::thread::id>{}(std::this_thread::get_id()) % kNumShards;
+    return shards_[shard];
+  }
+
+  std::array<HistogramShard, kNumShards> shards_;
   mutex mu_;
-  std::unordered_map<string, histogram::Histogram> histograms_
-      TF_GUARDED_BY(mu_);
   std::unordered_map<string, float> scalars_ TF_GUARDED_BY(mu_);
   StatsAggregatorImpl(const StatsAggregatorImpl&) = delete;
   void operator=(const StatsAggregatorImpl&) = delete;
@@ -105,6 +105,19 @@ std::vector<GetNextTestCase<MapDatasetParams>> GetNextTestCases() {
 
 ITERATOR_GET_NEXT_TEST_P(MapDatasetOpTest, MapDatasetParams, GetNextTestCases())
 
+TEST_F(MapDatasetOpTest, InlineFunctionExecution) {
+  // `XTimesTwo` consists solely of inline-compatible ops (Const, Cast, Mul),
+  // so with inline function execution enabled the map function is run as a
+  // direct kernel-call sequence instead of through the FLR.
+  setenv("TF_DATA_INLINE_FUNCTION_EXECUTION", "1", /*overwrite=*/1);
+  auto dataset_params = MapDatasetParams1();
+  TF_ASSERT_OK(Initialize(dataset_params));
+  TF_ASSERT_OK(CheckIteratorGetNext(
+      CreateTensors<int64_t>(TensorShape({}), {{0}, {12}, {24}, {36}}),
+      /*compare_order=*/true));
+  unsetenv("TF_DATA_INLINE_FUNCTION_EXECUTION");
+}
+
 TEST_F(MapDatasetOpTest, DatasetNodeName) {
   auto dataset_params = MapDatasetParams1();
   TF_ASSERT_OK(Initialize(dataset_params));
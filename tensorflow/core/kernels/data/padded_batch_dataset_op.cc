@@ -14,6 +14,9 @@ limitations under the License.
 ==============================================================================*/
 #include "tensorflow/core/kernels/data/padded_batch_dataset_op.h"
 
+#include <algorithm>
+#include <cstring>
+
 #include "tensorflow/core/data/dataset_utils.h"
 #include "tensorflow/core/data/name_utils.h"
 #include "tensorflow/core/framework/dataset.h"
@@ -25,6 +28,7 @@ limitations under the License.
 #include "tensorflow/core/lib/gtl/cleanup.h"
 #include "tensorflow/core/platform/blocking_counter.h"
 #include "tensorflow/core/platform/macros.h"
+#include "tensorflow/core/platform/stringpiece.h"
 #include "tensorflow/core/platform/stringprintf.h"
 #include "tensorflow/core/util/batch_util.h"
 
@@ -336,24 +340,75 @@ class PaddedBatchDatasetOp::Dataset : public DatasetBase {
           }
         }
 
+        // The shape of one padded slice of the output component.
+        TensorShape component_shape({});
+        for (int i = 1; i < batch_component_shape.dims(); ++i) {
+          TF_RETURN_IF_ERROR(component_shape.AddDimWithStatus(
+              batch_component_shape.dim_size(i)));
+        }
+
         // 2. Copy each batch element to the appropriate location in
         // the output component tensor.
         out_tensors->emplace_back(ctx->allocator({}),
                                   output_dtypes()[component_index],
                                   batch_component_shape);
         Tensor& batch_component = out_tensors->back();
-        TF_RETURN_IF_ERROR(batch_util::SetElementZero(
-            &batch_component, dataset()->padding_values_[component_index]));
+
+        // If the padding of every element lives in a contiguous tail of its
+        // slice -- the element shape matches the padded shape in all but the
+        // leading dimension -- and the padding value is all-zero bytes, the
+        // batch-wide fill below can be elided: each element copy writes the
+        // element's bytes and then zeroes only the actually-padded tail of
+        // its slice, instead of pre-filling the whole output tensor.
+        const Tensor& padding_value =
+            dataset()->padding_values_[component_index];
+        bool contiguous_tail_padding =
+            DataTypeCanUseMemcpy(padding_value.dtype());
+        if (contiguous_tail_padding) {
+          const StringPiece padding_bytes = padding_value.tensor_data();
+          contiguous_tail_padding =
+              std::all_of(padding_bytes.begin(), padding_bytes.end(),
+                          [](char c) { return c == 0; });
+        }
+        if (contiguous_tail_padding) {
+          for (int64_t i = 0; i < num_batch_elements; ++i) {
+            const TensorShape& element_shape =
+                batch_elements[i][component_index].shape();
+            for (int dim = 1; dim < element_shape.dims(); ++dim) {
+              if (element_shape.dim_size(dim) !=
+                  component_shape.dim_size(dim)) {
+                contiguous_tail_padding = false;
+                break;
+              }
+            }
+            if (!contiguous_tail_padding) break;
+          }
+        }
+        if (!contiguous_tail_padding) {
+          TF_RETURN_IF_ERROR(
+              batch_util::SetElementZero(&batch_component, padding_value));
+        }
+        const int64_t slice_bytes =
+            component_shape.num_elements() *
+            DataTypeSize(batch_component.dtype());
 
         // Build the output tuple component by copying one slice from each input
         // element in the batch.
-        TensorShape component_shape({});
-        for (int i = 1; i < batch_component_shape.dims(); ++i) {
-          TF_RETURN_IF_ERROR(component_shape.AddDimWithStatus(
-              batch_component_shape.dim_size(i)));
-        }
         auto copy_element_fn = [component_index, &batch_elements,
-                                &batch_component, &component_shape](int index) {
+                                &batch_component, &component_shape,
+                                contiguous_tail_padding,
+                                slice_bytes](int index) {
+          if (contiguous_tail_padding) {
+            const StringPiece element_bytes =
+                batch_elements[index][component_index].tensor_data();
+            char* const slice_start =
+                static_cast<char*>(batch_component.data()) +
+                index * slice_bytes;
+            memcpy(slice_start, element_bytes.data(), element_bytes.size());
+            memset(slice_start + element_bytes.size(), 0,
+                   slice_bytes - element_bytes.size());
+            return OkStatus();
+          }
           // Take the fast path if possible.
           if (batch_elements[index][component_index].shape() ==
               component_shape) {
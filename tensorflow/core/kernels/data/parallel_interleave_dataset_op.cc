@@ -49,6 +49,7 @@ limitations under the License.
 #include "tensorflow/core/platform/stringprintf.h"
 #include "tensorflow/core/profiler/lib/traceme.h"
 #include "tensorflow/core/profiler/lib/traceme_encode.h"
+#include "tensorflow/core/util/env_var.h"
 
 namespace tensorflow {
 namespace data {
@@ -372,6 +373,9 @@ class ParallelInterleaveDatasetOp::Dataset : public DatasetBase {
     Status Initialize(IteratorContext* ctx) override {
       mutex_lock l(*mu_);
       interleave_depth_ = ctx->interleave_depth();
+      TF_RETURN_IF_ERROR(
+          ReadBoolFromEnvVar("TF_DATA_PARALLEL_INTERLEAVE_WORK_STEALING",
+                             /*default_val=*/false, &work_stealing_enabled_));
 
       // Note that if `ctx->thread_pool()` is non-null, then instead of creating
       // a dedicated thread pool of size `num_threads`, computation will be
@@ -946,6 +950,7 @@ class ParallelInterleaveDatasetOp::Dataset : public DatasetBase {
       while (true) {
         int element_index;
         element.reset();
+        std::shared_ptr<Element> stolen_element;
         // Find an element to process.
         {
           mutex_lock l(*mu_);
@@ -970,6 +975,14 @@ class ParallelInterleaveDatasetOp::Dataset : public DatasetBase {
             if (element) {
               break;
             }
+            // If there is no current element to process, steal future work
+            // instead of going idle. This keeps workers busy when a straggler
+            // cycle element (e.g. a slow shard) would otherwise leave them
+            // waiting.
+            if (work_stealing_enabled_ &&
+                TryStealFutureWork(ctx.get(), &stolen_element)) {
+              break;
+            }
             DecrementCurrentActiveWorkers();
             WaitWorkerThread(ctx.get(), &current_workers_cond_var_, &l);
             IncrementCurrentActiveWorkers();
@@ -978,8 +991,24 @@ class ParallelInterleaveDatasetOp::Dataset : public DatasetBase {
             done();
             return;
           }
-          VLOG(3) << "Current worker woke up to process " << element->id;
-          element->active = true;
+          if (element) {
+            VLOG(3) << "Current worker woke up to process " << element->id;
+            element->active = true;
+          }
+        }
+        if (stolen_element) {
+          // Process the stolen element the way a future worker would.
+          ProcessElement(ctx.get(), stolen_element);
+          mutex_lock l(*mu_);
+          stolen_element->active = false;
+          if (stolen_element->cycle_index != -1) {
+            // The element was promoted to the current cycle while we were
+            // processing it.
+            stolen_element->cond_var.notify_one();
+            elements_to_process_.push_back(stolen_element->cycle_index);
+            current_workers_cond_var_.notify_one();
+          }
+          continue;
         }
         // Loop on the element until we fill its results buffer or reach end of
         // input for the element.
@@ -1026,24 +1055,33 @@ class ParallelInterleaveDatasetOp::Dataset : public DatasetBase {
               elements_to_process_.push_back(element->cycle_index);
               current_workers_cond_var_.notify_one();
             }
+            element.reset();
           }
           while (!cancelled_ && (future_elements_.size() >=
                                      dataset()->prefetch_input_elements_ ||
                                  wait_for_checkpoint_)) {
+            // If the future buffer is full, steal current work instead of
+            // going idle.
+            if (work_stealing_enabled_ && !wait_for_checkpoint_ &&
+                TryStealCurrentWork(&element)) {
+              break;
+            }
             WaitWorkerThread(ctx.get(), &future_workers_cond_var_, &l);
           }
           if (cancelled_) {
             done();
             return;
           }
-          element = MakeElement(ctx.get());
           if (!element) {
-            done();
-            return;
+            element = MakeElement(ctx.get());
+            if (!element) {
+              done();
+              return;
+            }
+            VLOG(3) << "Future worker created element " << element->id;
+            element->active = true;
+            future_elements_.push_back(element);
           }
-          VLOG(3) << "Future worker created element " << element->id;
-          element->active = true;
-          future_elements_.push_back(element);
         }
         ProcessElement(ctx.get(), element);
       }
@@ -1197,6 +1235,49 @@ class ParallelInterleaveDatasetOp::Dataset : public DatasetBase {
              element->results.size() < dataset()->buffer_output_elements_;
     }
 
+    // Attempts to claim a new future element on behalf of an otherwise idle
+    // current worker. Returns true on success, in which case `out_element` is
+    // marked active and appended to `future_elements_`. The output order
+    // observed by `GetNextInternal` is unaffected because results are always
+    // consumed by cycle position; work stealing only changes which thread
+    // produces them.
+    bool TryStealFutureWork(IteratorContext* ctx,
+                            std::shared_ptr<Element>* out_element)
+        TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+      if (wait_for_checkpoint_ || end_of_input_ ||
+          future_elements_.size() >= dataset()->prefetch_input_elements_) {
+        return false;
+      }
+      auto element = MakeElement(ctx);
+      if (!element) {
+        return false;
+      }
+      VLOG(3) << "Current worker stole future element " << element->id;
+      element->active = true;
+      future_elements_.push_back(element);
+      *out_element = std::move(element);
+      return true;
+    }
+
+    // Attempts to claim an unprocessed current element on behalf of an
+    // otherwise idle future worker. Returns true on success, in which case
+    // `out_element` is marked active.
+    bool TryStealCurrentWork(std::shared_ptr<Element>* out_element)
+        TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+      while (!elements_to_process_.empty()) {
+        int index = elements_to_process_.front();
+        elements_to_process_.pop_front();
+        auto& e = current_elements_[index];
+        if (NeedsProcessing(e) && !e->active) {
+          VLOG(3) << "Future worker stole current element " << e->id;
+          e->active = true;
+          *out_element = e;
+          return true;
+        }
+      }
+      return false;
+    }
+
     inline void IncrementCurrentWorkers() TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
       num_current_workers_++;
     }
@@ -1663,6 +1744,11 @@ class ParallelInterleaveDatasetOp::Dataset : public DatasetBase {
     // Determines whether outputs can be produced in deterministic order.
     const bool deterministic_;
 
+    // Whether idle workers may steal work across the current/future worker
+    // split. Controlled by the TF_DATA_PARALLEL_INTERLEAVE_WORK_STEALING
+    // environment variable.
+    bool work_stealing_enabled_ TF_GUARDED_BY(mu_) = false;
+
     // Controls cancellation of `input_impl_`. Must be ordered before
     // `input_impl_` so that `input_impl_` is destroyed first.
     std::unique_ptr<CancellationManager> cancellation_manager_;
@@ -634,6 +634,19 @@ GetNextTestCases() {
 ITERATOR_GET_NEXT_TEST_P(ParallelInterleaveDatasetOpTest,
                          ParallelInterleaveDatasetParams, GetNextTestCases());
 
+// Work stealing only changes which worker thread produces results, so the
+// deterministic output order must be preserved.
+TEST_F(ParallelInterleaveDatasetOpTest, WorkStealingDeterministic) {
+  setenv("TF_DATA_PARALLEL_INTERLEAVE_WORK_STEALING", "1", /*overwrite=*/1);
+  auto dataset_params = ParallelInterleaveDatasetParams2();
+  TF_ASSERT_OK(Initialize(dataset_params));
+  TF_ASSERT_OK(CheckIteratorGetNext(
+      CreateTensors<int64_t>(TensorShape{1},
+                             {{0}, {3}, {1}, {4}, {2}, {5}, {6}, {7}, {8}}),
+      /*compare_order=*/true));
+  unsetenv("TF_DATA_PARALLEL_INTERLEAVE_WORK_STEALING");
+}
+
 // TODO(b/241923343): The next 2 tests are brittle because they directly inspect
 // the GraphDefs to check the value of `cycle_length` when the
 // `ParallelInterleave` is serialized to a graph. Revisit this test when we
@@ -14,6 +14,7 @@ limitations under the License.
 ==============================================================================*/
 #include "tensorflow/core/kernels/data/parallel_map_dataset_op.h"
 
+#include <atomic>
 #include <deque>
 #include <functional>
 #include <memory>
@@ -38,6 +39,7 @@ limitations under the License.
 #include "tensorflow/core/profiler/lib/traceme.h"
 #include "tensorflow/core/profiler/lib/traceme_encode.h"
 #include "tensorflow/core/protobuf/error_codes.pb.h"
+#include "tensorflow/core/util/batch_util.h"
 
 namespace tensorflow {
 namespace data {
@@ -60,6 +62,8 @@ namespace data {
 /* static */ constexpr const char* const ParallelMapDatasetOp::kSloppy;
 /* static */ constexpr const char* const
     ParallelMapDatasetOp::kPreserveCardinality;
+/* static */ constexpr const char* const
+    ParallelMapDatasetOp::kVectorizationBlockSize;
 
 namespace {
 
@@ -84,17 +88,19 @@ class ParallelMapDatasetOp::Dataset : public DatasetBase {
           const std::vector<PartialTensorShape>& output_shapes,
           DeterminismPolicy deterministic,
           std::unique_ptr<CapturedFunction> captured_func,
-          bool preserve_cardinality, int op_version)
+          bool preserve_cardinality, int op_version,
+          int64_t vectorization_block_size = 0)
       : Dataset(DatasetContext(ctx), input, num_parallel_calls, output_types,
                 output_shapes, deterministic, std::move(captured_func),
-                preserve_cardinality, op_version) {}
+                preserve_cardinality, op_version, vectorization_block_size) {}
 
   Dataset(DatasetContext dataset_context, const DatasetBase* input,
           int64_t num_parallel_calls, const DataTypeVector& output_types,
           const std::vector<PartialTensorShape>& output_shapes,
           DeterminismPolicy deterministic,
           std::unique_ptr<CapturedFunction> captured_func,
-          bool preserve_cardinality, int op_version)
+          bool preserve_cardinality, int op_version,
+          int64_t vectorization_block_size = 0)
       : DatasetBase(std::move(dataset_context)),
         input_(input),
         num_parallel_calls_(num_parallel_calls),
@@ -103,7 +109,8 @@ class ParallelMapDatasetOp::Dataset : public DatasetBase {
         deterministic_(deterministic),
         preserve_cardinality_(preserve_cardinality),
         captured_func_(std::move(captured_func)),
-        op_version_(op_version) {
+        op_version_(op_version),
+        vectorization_block_size_(vectorization_block_size) {
     input_->Ref();
   }
 
@@ -212,6 +219,12 @@ class ParallelMapDatasetOp::Dataset : public DatasetBase {
       AttrValue deterministic_attr;
       b->BuildAttrValue(deterministic_.String(), &deterministic_attr);
       attrs.emplace_back(kDeterministic, deterministic_attr);
+
+      AttrValue vectorization_block_size_attr;
+      b->BuildAttrValue(vectorization_block_size_,
+                        &vectorization_block_size_attr);
+      attrs.emplace_back(kVectorizationBlockSize,
+                         vectorization_block_size_attr);
     }
 
     // Attr: preserve_cardinality
@@ -240,7 +253,8 @@ class ParallelMapDatasetOp::Dataset : public DatasetBase {
           deterministic_(params.dataset->deterministic_.IsDeterministic() ||
                          params.dataset->deterministic_.IsDefault()),
           preserve_cardinality_(params.dataset->preserve_cardinality_),
-          autotune_(params.dataset->num_parallel_calls_ == model::kAutotune) {}
+          autotune_(params.dataset->num_parallel_calls_ == model::kAutotune),
+          block_size_(params.dataset->vectorization_block_size_) {}
 
     ~Iterator() override {
       CancelThreads(/*wait=*/true);
@@ -530,6 +544,177 @@ class ParallelMapDatasetOp::Dataset : public DatasetBase {
       }
     }
 
+    // Marks the block's call finished and wakes up anyone waiting on any of
+    // its results.
+    void BatchCompleted(
+        const std::shared_ptr<IteratorContext>& ctx,
+        const std::vector<std::shared_ptr<InvocationResult>>& results)
+        TF_LOCKS_EXCLUDED(*mu_) {
+      mutex_lock l(*mu_);
+      num_calls_--;
+      for (const auto& result : results) {
+        result->notification.Notify();
+      }
+      cond_var_->notify_all();
+    }
+
+    // Returns true if all elements have the same number of components and
+    // matching component dtypes and shapes, i.e. they can be stacked on a new
+    // leading dimension.
+    static bool InputsAreStackable(
+        const std::vector<std::vector<Tensor>>& elements) {
+      const std::vector<Tensor>& first = elements.front();
+      for (const std::vector<Tensor>& element : elements) {
+        if (element.size() != first.size()) {
+          return false;
+        }
+        for (size_t c = 0; c < element.size(); ++c) {
+          if (element[c].dtype() != first[c].dtype() ||
+              element[c].shape() != first[c].shape()) {
+            return false;
+          }
+        }
+      }
+      return true;
+    }
+
+    // Stacks `elements` on a new leading dimension of size `elements->size()`
+    // into `batched`, consuming the elements.
+    Status StackInputs(IteratorContext* ctx,
+                       std::vector<std::vector<Tensor>>* elements,
+                       std::vector<Tensor>* batched) {
+      const size_t num_components = elements->front().size();
+      batched->reserve(num_components);
+      for (size_t c = 0; c < num_components; ++c) {
+        TensorShape shape = elements->front()[c].shape();
+        shape.InsertDim(0, elements->size());
+        Tensor component(ctx->allocator({}), elements->front()[c].dtype(),
+                         shape);
+        for (size_t i = 0; i < elements->size(); ++i) {
+          TF_RETURN_IF_ERROR(batch_util::CopyElementToSlice(
+              std::move((*elements)[i][c]), &component, i));
+        }
+        batched->push_back(std::move(component));
+      }
+      return OkStatus();
+    }
+
+    // Splits the batched function outputs back into `num_elements` per-element
+    // results by slicing off the leading dimension.
+    Status UnstackOutputs(
+        IteratorContext* ctx, const std::vector<Tensor>& batched,
+        size_t num_elements,
+        const std::vector<std::shared_ptr<InvocationResult>>& results) {
+      for (const Tensor& component : batched) {
+        if (component.dims() == 0 ||
+            component.dim_size(0) != static_cast<int64_t>(num_elements)) {
+          return errors::InvalidArgument(
+              "The map function is not vectorized: expected every output to "
+              "have a leading dimension of size ",
+              num_elements, " but got an output of shape ",
+              component.shape().DebugString(),
+              ". Unset `vectorization_block_size` or make the function "
+              "shape-polymorphic in its leading dimension.");
+        }
+      }
+      for (size_t i = 0; i < num_elements; ++i) {
+        results[i]->return_values.reserve(batched.size());
+        for (const Tensor& component : batched) {
+          TensorShape shape = component.shape();
+          shape.RemoveDim(0);
+          Tensor element(ctx->allocator({}), component.dtype(), shape);
+          TF_RETURN_IF_ERROR(
+              batch_util::CopySliceToElement(component, &element, i));
+          results[i]->return_values.push_back(std::move(element));
+        }
+      }
+      return OkStatus();
+    }
+
+    // Applies the map function to a block of up to `block_size_` consecutive
+    // input elements with a single call, stacking the inputs on a new leading
+    // dimension and unstacking the outputs into the per-element `results`.
+    // Falls back to one call per element when the inputs are ragged or the
+    // block is cut short by the end of the input.
+    void CallBatchedFunction(
+        const std::shared_ptr<IteratorContext>& ctx,
+        const std::vector<std::shared_ptr<InvocationResult>>& results)
+        TF_LOCKS_EXCLUDED(*mu_) {
+      profiler::TraceMe traceme([&] {
+        return profiler::TraceMeEncode("ParallelMapProduceBlock",
+                                       {{"element_id", results[0]->uid}});
+      });
+      std::vector<std::vector<Tensor>> input_elements;
+      input_elements.reserve(results.size());
+      for (const auto& result : results) {
+        std::vector<Tensor> input_element;
+        result->status = input_impl_->GetNext(ctx.get(), &input_element,
+                                              &result->end_of_input);
+        result->checkpoint.Merge(ctx->checkpoint());
+        if (result->end_of_input || !result->status.ok()) {
+          break;
+        }
+        input_elements.push_back(std::move(input_element));
+      }
+      const size_t num_elements = input_elements.size();
+      // Results past the first end-of-input (or error) represent positions
+      // beyond the end of the input.
+      for (size_t i = num_elements + 1; i < results.size(); ++i) {
+        results[i]->end_of_input = true;
+      }
+      if (num_elements == 0) {
+        BatchCompleted(ctx, results);
+        return;
+      }
+      if (num_elements == results.size() &&
+          InputsAreStackable(input_elements)) {
+        std::vector<Tensor> batched_inputs;
+        Status status = StackInputs(ctx.get(), &input_elements,
+                                    &batched_inputs);
+        if (!status.ok()) {
+          for (size_t i = 0; i < num_elements; ++i) {
+            results[i]->status = status;
+          }
+          BatchCompleted(ctx, results);
+          return;
+        }
+        auto batched_outputs = std::make_shared<std::vector<Tensor>>();
+        auto done = [this, ctx, results, batched_outputs,
+                     num_elements](Status status) {
+          if (status.ok()) {
+            status = UnstackOutputs(ctx.get(), *batched_outputs, num_elements,
+                                    results);
+          }
+          for (size_t i = 0; i < num_elements; ++i) {
+            results[i]->status.Update(status);
+            RecordBufferEnqueue(ctx.get(), results[i]->return_values);
+          }
+          BatchCompleted(ctx, results);
+        };
+        instantiated_captured_func_->RunAsync(
+            ctx.get(), std::move(batched_inputs), batched_outputs.get(),
+            std::move(done), model_node());
+        return;
+      }
+      // Ragged or short block: apply the function once per element, completing
+      // the block when the last element finishes.
+      auto remaining = std::make_shared<std::atomic<int64_t>>(num_elements);
+      for (size_t i = 0; i < num_elements; ++i) {
+        std::shared_ptr<InvocationResult> result = results[i];
+        auto element_done = [this, ctx, results, result,
+                             remaining](Status status) {
+          result->status.Update(status);
+          RecordBufferEnqueue(ctx.get(), result->return_values);
+          if (remaining->fetch_sub(1) == 1) {
+            BatchCompleted(ctx, results);
+          }
+        };
+        instantiated_captured_func_->RunAsync(
+            ctx.get(), std::move(input_elements[i]), &result->return_values,
+            std::move(element_done), model_node());
+      }
+    }
+
     Status ProcessResult(IteratorContext* ctx,
                          const std::shared_ptr<InvocationResult>& result,
                          std::vector<Tensor>* out_tensors,
@@ -571,9 +756,14 @@ class ParallelMapDatasetOp::Dataset : public DatasetBase {
       }
       auto busy = [this]() TF_EXCLUSIVE_LOCKS_REQUIRED(*mu_) -> bool {
         int64_t num_parallel_calls = num_parallel_calls_->value;
+        // In block mode each call produces `block_size_` elements, so the
+        // result buffer is sized accordingly.
+        int64_t max_buffered_results =
+            num_parallel_calls * std::max<int64_t>(int64_t{1}, block_size_);
         return num_calls_ >= num_parallel_calls ||
-               invocation_results_.size() >= num_parallel_calls;
+               invocation_results_.size() >= max_buffered_results;
       };
+      std::vector<std::vector<std::shared_ptr<InvocationResult>>> new_blocks;
       while (true) {
         {
           mutex_lock l(*mu_);
@@ -586,10 +776,25 @@ class ParallelMapDatasetOp::Dataset : public DatasetBase {
             return;
           }
           while (!busy()) {
-            invocation_results_.push_back(
-                std::make_shared<InvocationResult>(ctx.get()));
-            new_calls.push_back(invocation_results_.back());
-            num_calls_++;
+            if (block_size_ > 1) {
+              // One call covers a block of `block_size_` consecutive
+              // elements, each with its own result so that consumers,
+              // checkpointing, and ordering are oblivious to the blocking.
+              std::vector<std::shared_ptr<InvocationResult>> block;
+              block.reserve(block_size_);
+              for (int64_t i = 0; i < block_size_; ++i) {
+                invocation_results_.push_back(
+                    std::make_shared<InvocationResult>(ctx.get()));
+                block.push_back(invocation_results_.back());
+              }
+              new_blocks.push_back(std::move(block));
+              num_calls_++;
+            } else {
+              invocation_results_.push_back(
+                  std::make_shared<InvocationResult>(ctx.get()));
+              new_calls.push_back(invocation_results_.back());
+              num_calls_++;
+            }
           }
           cond_var_->notify_all();
         }
@@ -597,6 +802,10 @@ class ParallelMapDatasetOp::Dataset : public DatasetBase {
           CallFunction(ctx, call);
         }
         new_calls.clear();
+        for (const auto& block : new_blocks) {
+          CallBatchedFunction(ctx, block);
+        }
+        new_blocks.clear();
       }
     }
 
@@ -707,6 +916,8 @@ class ParallelMapDatasetOp::Dataset : public DatasetBase {
     const bool deterministic_;
     const bool preserve_cardinality_;
     const bool autotune_;
+    // If > 1, the map function is applied to blocks of this many elements.
+    const int64_t block_size_;
     // Counts the number of outstanding calls.
     int64_t num_calls_ TF_GUARDED_BY(*mu_) = 0;
     // Controls cancellation of `input_impl_`. Must be ordered before
@@ -741,6 +952,9 @@ class ParallelMapDatasetOp::Dataset : public DatasetBase {
   const bool preserve_cardinality_;
   const std::unique_ptr<CapturedFunction> captured_func_;
   const int op_version_;
+  // If > 1, the map function is applied to blocks of this many input elements
+  // stacked on a new leading dimension whenever their shapes allow it.
+  const int64_t vectorization_block_size_;
   // This is used for random access provided by Get().
   mutable std::unique_ptr<InstantiatedCapturedFunction>
       instantiated_captured_func_;
@@ -770,6 +984,14 @@ ParallelMapDatasetOp::ParallelMapDatasetOp(OpKernelConstruction* ctx)
     OP_REQUIRES_OK(ctx, ctx->GetAttr(kDeterministic, &deterministic));
     OP_REQUIRES_OK(
         ctx, DeterminismPolicy::FromString(deterministic, &deterministic_));
+    if (ctx->HasAttr(kVectorizationBlockSize)) {
+      OP_REQUIRES_OK(ctx, ctx->GetAttr(kVectorizationBlockSize,
+                                       &vectorization_block_size_));
+      OP_REQUIRES(ctx, vectorization_block_size_ >= 0,
+                  errors::InvalidArgument(
+                      "vectorization_block_size must be non-negative, got ",
+                      vectorization_block_size_));
+    }
   }
   OP_REQUIRES_OK(ctx,
                  ctx->GetAttr(kPreserveCardinality, &preserve_cardinality_));
@@ -804,7 +1026,8 @@ void ParallelMapDatasetOp::MakeDataset(OpKernelContext* ctx, DatasetBase* input,
   *output =
       new Dataset(ctx, input, num_parallel_calls, output_types_, output_shapes_,
                   deterministic_, std::move(captured_func),
-                  preserve_cardinality_, op_version_);
+                  preserve_cardinality_, op_version_,
+                  vectorization_block_size_);
 }
 
 std::unique_ptr<DatasetBase> MakeDataServiceUncompressDataset(
@@ -76,10 +76,16 @@ class ParallelMapDatasetParams : public DatasetParams {
                     {"use_inter_op_parallelism", use_inter_op_parallelism_},
                     {"deterministic", deterministic_},
                     {"preserve_cardinality", preserve_cardinality_},
+                    {"vectorization_block_size", vectorization_block_size_},
                     {"metadata", ""}};
     return OkStatus();
   }
 
+  ParallelMapDatasetParams& set_vectorization_block_size(int64_t block_size) {
+    vectorization_block_size_ = block_size;
+    return *this;
+  }
+
   string dataset_type() const override {
     return ParallelMapDatasetOp::kDatasetType;
   }
@@ -95,6 +101,7 @@ class ParallelMapDatasetParams : public DatasetParams {
   bool use_inter_op_parallelism_;
   std::string deterministic_;
   bool preserve_cardinality_;
+  int64_t vectorization_block_size_ = 0;
 };
 
 class ParallelMapDatasetOpTest : public DatasetOpsTestBase {};
@@ -251,6 +258,44 @@ ParallelMapDatasetParams ParallelMapDatasetParams8() {
       /*node_name=*/kNodeName);
 }
 
+// Applies the map function to blocks of 2 elements stacked on a new leading
+// dimension; the range has 4 elements, so both blocks are full.
+ParallelMapDatasetParams ParallelMapDatasetParamsVectorized() {
+  return ParallelMapDatasetParams(
+             RangeDatasetParams(0, 10, 3),
+             /*other_arguments=*/{},
+             /*num_parallel_calls=*/2,
+             /*func=*/MapFunc("XTimesTwo", DT_INT64),
+             /*func_lib*/ {test::function::XTimesTwo()},
+             /*type_arguments=*/{},
+             /*output_dtypes=*/{DT_INT64},
+             /*output_shapes=*/{PartialTensorShape({})},
+             /*use_inter_op_parallelism=*/true,
+             /*deterministic=*/DeterminismPolicy::kDeterministic,
+             /*preserve_cardinality=*/false,
+             /*node_name=*/kNodeName)
+      .set_vectorization_block_size(2);
+}
+
+// The block size does not divide the number of elements, so the final block
+// of 1 element falls back to a per-element function call.
+ParallelMapDatasetParams ParallelMapDatasetParamsVectorizedShortBlock() {
+  return ParallelMapDatasetParams(
+             RangeDatasetParams(0, 10, 3),
+             /*other_arguments=*/{},
+             /*num_parallel_calls=*/1,
+             /*func=*/MapFunc("XTimesTwo", DT_INT64),
+             /*func_lib*/ {test::function::XTimesTwo()},
+             /*type_arguments=*/{},
+             /*output_dtypes=*/{DT_INT64},
+             /*output_shapes=*/{PartialTensorShape({})},
+             /*use_inter_op_parallelism=*/true,
+             /*deterministic=*/DeterminismPolicy::kDeterministic,
+             /*preserve_cardinality=*/false,
+             /*node_name=*/kNodeName)
+      .set_vectorization_block_size(3);
+}
+
 ParallelMapDatasetParams ParallelMapDatasetParamsWithInvalidNumParallelCalls() {
   return ParallelMapDatasetParams(
       RangeDatasetParams(0, 10, 3),
@@ -292,6 +337,14 @@ std::vector<GetNextTestCase<ParallelMapDatasetParams>> GetNextTestCases() {
            ParallelMapDatasetParams6(),
            /*expected_outputs=*/
            CreateTensors<int64_t>(TensorShape{}, {{0}, {12}, {24}, {36}}),
+           /*compare_order=*/true},
+          {/*dataset_params=*/ParallelMapDatasetParamsVectorized(),
+           /*expected_outputs=*/
+           CreateTensors<int64_t>(TensorShape{}, {{0}, {6}, {12}, {18}}),
+           /*compare_order=*/true},
+          {/*dataset_params=*/ParallelMapDatasetParamsVectorizedShortBlock(),
+           /*expected_outputs=*/
+           CreateTensors<int64_t>(TensorShape{}, {{0}, {6}, {12}, {18}}),
            /*compare_order=*/true}};
 }
 
@@ -15,7 +15,9 @@ limitations under the License.
 
 #include "tensorflow/core/kernels/data/prefetch_autotuner.h"
 
+#include <algorithm>
 #include <cstdint>
+#include <iterator>
 
 #include "tensorflow/core/data/dataset_utils.h"
 #include "tensorflow/core/framework/model.h"
@@ -27,6 +29,7 @@ PrefetchAutotuner::PrefetchAutotuner(
     int64_t initial_buffer_size, int64_t buffer_size_min,
     std::shared_ptr<model::RamBudgetManager> ram_budget_manager)
     : buffer_limit_(initial_buffer_size),
+      buffer_size_min_(buffer_size_min),
       ram_budget_manager_(ram_budget_manager) {
   if (initial_buffer_size == model::kAutotune) {
     mode_ = Mode::kUpswing;
@@ -39,6 +42,24 @@ namespace {
 // limits less than the threshold, an exponential increase is used, while for
 // limits greater than or equal to the threshold, a linear increase is used.
 size_t kBufferLimitThreshold = 2048;
+
+// Number of consumption observations between downward adjustments of the
+// buffer limit.
+const int64_t kAdjustmentWindow = 64;
+
+// The median consumer inter-arrival gap must be at least this many times the
+// median production time before the buffer limit is lowered.
+const int64_t kShrinkLatencyRatio = 2;
+
+// Index of the log2(microsecond) histogram bucket for `micros`.
+int LatencyBucket(int64_t micros, int num_buckets) {
+  int bucket = 0;
+  while (micros > 1 && bucket < num_buckets - 1) {
+    micros >>= 1;
+    ++bucket;
+  }
+  return bucket;
+}
 }  // namespace
 
 void PrefetchAutotuner::SetElementSize(int64_t element_size_bytes) {
@@ -60,9 +81,124 @@ void PrefetchAutotuner::SetElementSize(int64_t element_size_bytes) {
   }
 
   element_size_bytes_ = element_size_bytes;
+  // If the first-seen element already puts the buffer over the element-bytes
+  // budget, clamp the limit right away.
+  if (element_bytes_budget_ > 0) {
+    int64_t max_limit = MaxBufferLimitForBudget(buffer_limit_);
+    if (max_limit < buffer_limit_) {
+      int64_t delta_bytes = (max_limit - buffer_limit_) * element_size_bytes;
+      if (!ram_budget_manager_ ||
+          ram_budget_manager_->RequestLegacyPrefetchBytes(delta_bytes)) {
+        buffer_limit_ = max_limit;
+      }
+    }
+  }
+}
+
+void PrefetchAutotuner::SetElementBytesBudget(int64_t bytes) {
+  element_bytes_budget_ = bytes;
+}
+
+void PrefetchAutotuner::RecordConsumption(size_t current_buffer_size,
+                                          uint64 now_us) {
+  if (mode_ == Mode::kDisabled) {
+    return;
+  }
+  if (last_consumption_us_ != 0 && now_us > last_consumption_us_) {
+    consumer_gap_hist_[LatencyBucket(now_us - last_consumption_us_,
+                                     kNumLatencyBuckets)]++;
+  }
+  last_consumption_us_ = now_us;
+  if (current_buffer_size == 0) {
+    ++window_empty_events_;
+  }
+  if (++window_consumptions_ >= kAdjustmentWindow) {
+    MaybeShrinkBuffer();
+    window_consumptions_ = 0;
+    window_empty_events_ = 0;
+    std::fill(std::begin(consumer_gap_hist_), std::end(consumer_gap_hist_), 0);
+    std::fill(std::begin(producer_time_hist_), std::end(producer_time_hist_),
+              0);
+  }
+  UpdateStateMachine(current_buffer_size);
+}
+
+void PrefetchAutotuner::RecordEmpty() {
+  if (mode_ == Mode::kDisabled) {
+    return;
+  }
+  // A blocked consumer is not a consumption: it contributes an empty event to
+  // the shrink controller's window but no inter-arrival sample.
+  ++window_empty_events_;
+  UpdateStateMachine(0);
+}
+
+void PrefetchAutotuner::RecordProduction(int64_t production_time_us) {
+  if (mode_ == Mode::kDisabled) {
+    return;
+  }
+  producer_time_hist_[LatencyBucket(production_time_us, kNumLatencyBuckets)]++;
+}
+
+int64_t PrefetchAutotuner::MaxBufferLimitForBudget(
+    int64_t attempted_limit) const {
+  if (element_bytes_budget_ <= 0 || !element_size_bytes_.has_value() ||
+      *element_size_bytes_ <= 0) {
+    return attempted_limit;
+  }
+  return std::min(attempted_limit,
+                  std::max(int64_t{1},
+                           element_bytes_budget_ / *element_size_bytes_));
 }
 
-void PrefetchAutotuner::RecordConsumption(size_t current_buffer_size) {
+int64_t PrefetchAutotuner::HistogramMedian(const int64_t* hist) {
+  int64_t total = 0;
+  for (int i = 0; i < kNumLatencyBuckets; ++i) total += hist[i];
+  if (total == 0) {
+    return -1;
+  }
+  int64_t seen = 0;
+  for (int i = 0; i < kNumLatencyBuckets; ++i) {
+    seen += hist[i];
+    if (seen * 2 >= total) {
+      return int64_t{1} << i;
+    }
+  }
+  return int64_t{1} << (kNumLatencyBuckets - 1);
+}
+
+void PrefetchAutotuner::MaybeShrinkBuffer() {
+  if (window_empty_events_ > 0 || !element_size_bytes_.has_value()) {
+    return;
+  }
+  const int64_t consumer_gap_us = HistogramMedian(consumer_gap_hist_);
+  const int64_t producer_time_us = HistogramMedian(producer_time_hist_);
+  if (consumer_gap_us < 0 || producer_time_us < 0) {
+    return;
+  }
+  // Only shrink when the consumer is comfortably slower than the producer: a
+  // smaller buffer then still absorbs production jitter without stalling.
+  if (consumer_gap_us < kShrinkLatencyRatio * producer_time_us) {
+    return;
+  }
+  const int64_t min_limit = std::max(int64_t{1}, buffer_size_min_);
+  const int64_t new_limit =
+      std::max(min_limit,
+               buffer_limit_ - std::max(int64_t{1}, buffer_limit_ / 4));
+  if (new_limit >= buffer_limit_) {
+    return;
+  }
+  // Negative delta: returns the freed bytes to the budget.
+  int64_t delta_bytes = (new_limit - buffer_limit_) * *element_size_bytes_;
+  if (!ram_budget_manager_ ||
+      ram_budget_manager_->RequestLegacyPrefetchBytes(delta_bytes)) {
+    buffer_limit_ = new_limit;
+    // Let the state machine re-validate the smaller buffer before growing.
+    mode_ = Mode::kUpswing;
+  }
+}
+
+void PrefetchAutotuner::UpdateStateMachine(size_t current_buffer_size) {
   switch (mode_) {
     case Mode::kDisabled:
       return;
@@ -85,6 +221,13 @@ void PrefetchAutotuner::RecordConsumption(size_t current_buffer_size) {
         } else {
           attempt_new_buffer_limit = buffer_limit_ * 2;
         }
+        attempt_new_buffer_limit =
+            MaxBufferLimitForBudget(attempt_new_buffer_limit);
+        if (attempt_new_buffer_limit <= buffer_limit_) {
+          // The element-bytes budget does not allow further growth.
+          mode_ = Mode::kUpswing;
+          return;
+        }
         int64_t delta_bytes =
             (attempt_new_buffer_limit - buffer_limit_) * element_size_bytes;
 
@@ -21,6 +21,7 @@ limitations under the License.
 #include <optional>
 
 #include "tensorflow/core/framework/model.h"
+#include "tensorflow/core/platform/env_time.h"
 #include "tensorflow/core/platform/types.h"
 
 namespace tensorflow {
@@ -38,8 +39,14 @@ namespace data {
 // if the prefetching thread is able to successfully fill the buffer at its
 // current size.
 //
-// Note: in the current implementation, we never decrease the buffer_limit().
-// This should change in the future!
+// In addition to the buffer-empty state machine, the autotuner keeps coarse
+// log-scale histograms of consumer inter-arrival gaps and element production
+// times. When a full window of consumptions passes without a buffer-empty
+// event and the consumer is much slower than the producer, the buffer limit is
+// lowered again and the freed bytes are returned to the RAM budget, so
+// pipelines that oscillate between starving and hoarding settle at a bounded
+// buffer size. An optional element-bytes budget additionally caps
+// `buffer_limit() * element size`.
 //
 // PrefetchAutotuner is NOT thread safe.
 class PrefetchAutotuner {
@@ -55,8 +62,18 @@ class PrefetchAutotuner {
   // Sets the element size to use for predicting memory usage. Element size must
   // be set before the autotuner can increase the buffer size.
   void SetElementSize(int64_t element_size_bytes);
-  void RecordConsumption(size_t current_buffer_size);
-  void RecordEmpty() { RecordConsumption(0); }
+  // Caps `buffer_limit() * element size` at `bytes`. 0 removes the cap.
+  void SetElementBytesBudget(int64_t bytes);
+  void RecordConsumption(size_t current_buffer_size) {
+    RecordConsumption(current_buffer_size, EnvTime::NowMicros());
+  }
+  // As above, with an explicit timestamp; exposed for testing the
+  // latency-based controller with a synthetic clock.
+  void RecordConsumption(size_t current_buffer_size, uint64 now_us);
+  void RecordEmpty();
+  // Records that the producer spent `production_time_us` microseconds
+  // computing the most recently enqueued element.
+  void RecordProduction(int64_t production_time_us);
 
  private:
   // PrefetchAutotuner operates as a state machine.
@@ -73,11 +90,36 @@ class PrefetchAutotuner {
     kDownswing,
   };
 
+  // Number of log2(microsecond) buckets in the latency histograms.
+  static constexpr int kNumLatencyBuckets = 32;
+
+  // Runs the buffer-empty state machine on a consumption observation.
+  void UpdateStateMachine(size_t current_buffer_size);
+  // Lowers the buffer limit if a full adjustment window passed without a
+  // buffer-empty event and consumption is much slower than production.
+  void MaybeShrinkBuffer();
+  // Largest buffer limit that keeps `buffer_limit_ * element size` within the
+  // element-bytes budget; buffer_limit_ if no budget or element size yet.
+  int64_t MaxBufferLimitForBudget(int64_t attempted_limit) const;
+  // Representative microsecond value of the histogram's median bucket, or -1
+  // if the histogram is empty.
+  static int64_t HistogramMedian(const int64_t* hist);
+
   int64_t buffer_limit_;
+  const int64_t buffer_size_min_;
   // Estimated per-element size.
   std::optional<int64_t> element_size_bytes_;
+  // Upper bound on `buffer_limit_ * element size`; 0 means unbounded.
+  int64_t element_bytes_budget_ = 0;
   Mode mode_ = Mode::kDisabled;
   std::shared_ptr<model::RamBudgetManager> ram_budget_manager_;
+
+  // Latency tracking for the shrink controller, reset every window.
+  int64_t consumer_gap_hist_[kNumLatencyBuckets] = {};
+  int64_t producer_time_hist_[kNumLatencyBuckets] = {};
+  int64_t window_consumptions_ = 0;
+  int64_t window_empty_events_ = 0;
+  uint64 last_consumption_us_ = 0;
 };
 
 }  // namespace data
@@ -158,6 +158,51 @@ TEST(PrefetchAutotuner, RespectRamManagerWhenThereIsModelAllocation) {
   EXPECT_EQ(16, t.buffer_limit());
 }
 
+TEST(PrefetchAutotuner, RespectElementBytesBudget) {
+  auto ram_manager = std::make_shared<model::RamBudgetManager>(/*budget=*/1000);
+  PrefetchAutotuner t(model::kAutotune, 0, ram_manager);
+  t.SetElementBytesBudget(4);
+  t.SetElementSize(1);
+  t.RecordConsumption(0);
+  t.RecordConsumption(1);
+  t.RecordConsumption(0);
+  EXPECT_EQ(2, t.buffer_limit());
+  t.RecordConsumption(2);
+  t.RecordConsumption(0);
+  EXPECT_EQ(4, t.buffer_limit());
+  // The element-bytes budget is exhausted: the limit stays at 4 even though
+  // the RAM budget would allow further growth.
+  t.RecordConsumption(4);
+  t.RecordConsumption(0);
+  EXPECT_EQ(4, t.buffer_limit());
+}
+
+TEST(PrefetchAutotuner, ShrinkWhenConsumerSlow) {
+  auto ram_manager = std::make_shared<model::RamBudgetManager>(/*budget=*/1000);
+  PrefetchAutotuner t(model::kAutotune, 0, ram_manager);
+  t.SetElementSize(1);
+  // Grow the buffer to 8 via buffer-empty events.
+  t.RecordConsumption(0);
+  t.RecordConsumption(1);
+  t.RecordConsumption(0);
+  t.RecordConsumption(2);
+  t.RecordConsumption(0);
+  t.RecordConsumption(4);
+  t.RecordConsumption(0);
+  EXPECT_EQ(8, t.buffer_limit());
+  // Now the producer takes 1us per element while the consumer shows up every
+  // 1000us and the buffer never runs empty. After a full adjustment window of
+  // such observations, the limit should come back down.
+  uint64 now_us = 1000000;
+  for (int i = 0; i < 200; ++i) {
+    t.RecordProduction(1);
+    now_us += 1000;
+    t.RecordConsumption(4, now_us);
+  }
+  EXPECT_LT(t.buffer_limit(), 8);
+  EXPECT_GE(t.buffer_limit(), 1);
+}
+
 }  // namespace
 }  // namespace data
 }  // namespace tensorflow
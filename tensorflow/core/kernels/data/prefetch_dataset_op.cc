@@ -15,6 +15,8 @@ limitations under the License.
 #include "tensorflow/core/kernels/data/prefetch_dataset_op.h"
 
 #include <algorithm>
+#include <chrono>
+#include <cstring>
 #include <deque>
 #include <limits>
 #include <string>
@@ -28,6 +30,7 @@ limitations under the License.
 #include "tensorflow/core/framework/partial_tensor_shape.h"
 #include "tensorflow/core/framework/stats_aggregator.h"
 #include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/types.h"
 #include "tensorflow/core/kernels/data/prefetch_autotuner.h"
 #include "tensorflow/core/lib/gtl/cleanup.h"
 #include "tensorflow/core/lib/strings/str_util.h"
@@ -37,6 +40,7 @@ limitations under the License.
 #include "tensorflow/core/profiler/lib/traceme.h"
 #include "tensorflow/core/profiler/lib/traceme_encode.h"
 #include "tensorflow/core/protobuf/error_codes.pb.h"
+#include "tensorflow/core/util/env_var.h"
 
 namespace tensorflow {
 namespace data {
@@ -57,12 +61,71 @@ namespace {
 
 // Determines the fraction of slack time by which to delay prefetching of data.
 constexpr double kSleepFactor = 0.2;
+// How often a producer stalled on the pipeline-wide ram budget re-checks the
+// budget. Dequeues elsewhere in the pipeline release budget without signaling
+// this iterator's condition variable, so the wait must time out.
+constexpr int kRamBudgetPollPeriodMillis = 10;
 constexpr char kBuffer[] = "buffer";
 constexpr char kStatus[] = "status";
 constexpr char kSizeSuffix[] = ".size";
 constexpr char kCodeSuffix[] = ".code";
 constexpr char kErrorMessageSuffix[] = ".error_message";
 
+// Per-prefetch cap, in bytes, on `buffer limit * element size` for the legacy
+// autotuner. 0 (the default) leaves the buffer bounded only by the RAM budget.
+int64_t PrefetchElementBytesBudget() {
+  static const int64_t budget = []() {
+    int64_t bytes;
+    Status s = ReadInt64FromEnvVar("TF_DATA_PREFETCH_BYTES_BUDGET",
+                                   /*default_val=*/0, &bytes);
+    if (!s.ok()) LOG(ERROR) << s;
+    return bytes;
+  }();
+  return budget;
+}
+
+// When TF_DATA_PREFETCH_PINNED_STAGING=true, the prefetch thread re-stages
+// each buffered element in GPU-compatible (pinned) host memory. The
+// host-to-device copy that consumes the element can then run as asynchronous
+// DMA and overlap the training step, instead of synchronously staging
+// pageable memory. Only useful when the iterator feeds a GPU; the extra host
+// copy is wasted work otherwise, hence the opt-in.
+bool PrefetchPinnedStagingEnabled() {
+  static const bool enabled = []() {
+    bool value = false;
+    Status s = ReadBoolFromEnvVar("TF_DATA_PREFETCH_PINNED_STAGING",
+                                  /*default_val=*/false, &value);
+    if (!s.ok()) LOG(ERROR) << s;
+    return value;
+  }();
+  return enabled;
+}
+
+// Replaces every memcpy-able tensor in `tensors` with a copy allocated from
+// the device's GPU-compatible host allocator. Leaves tensors of
+// non-DMA-copyable dtypes (strings, variants, resources) untouched.
+void StageInPinnedMemory(IteratorContext* ctx, std::vector<Tensor>* tensors) {
+  AllocatorAttributes attrs;
+  attrs.set_gpu_compatible(true);
+  attrs.set_on_host(true);
+  Allocator* allocator = ctx->allocator(attrs);
+  if (allocator == nullptr) {
+    return;
+  }
+  for (Tensor& tensor : *tensors) {
+    if (!DataTypeCanUseMemcpy(tensor.dtype())) {
+      continue;
+    }
+    Tensor staged(allocator, tensor.dtype(), tensor.shape());
+    if (staged.NumElements() > 0) {
+      auto src = tensor.tensor_data();
+      std::memcpy(const_cast<char*>(staged.tensor_data().data()), src.data(),
+                  src.size());
+    }
+    tensor = std::move(staged);
+  }
+}
+
 }  // namespace
 
 class PrefetchDatasetOp::Dataset : public DatasetBase {
@@ -170,6 +233,7 @@ class PrefetchDatasetOp::Dataset : public DatasetBase {
       auto_tuner_ = std::make_unique<PrefetchAutotuner>(
           dataset()->buffer_size_, dataset()->buffer_size_min_,
           ctx->ram_budget_manager());
+      auto_tuner_->SetElementBytesBudget(PrefetchElementBytesBudget());
       interleave_depth_ = ctx->interleave_depth();
 
       if (buffer_size_->value == model::kAutotune) {
@@ -507,9 +571,19 @@ class PrefetchDatasetOp::Dataset : public DatasetBase {
         // 1. Wait for a slot in the buffer.
         {
           mutex_lock l(*mu_);
-          while (!cancelled_ && buffer_.size() >= buffer_limit()) {
+          while (!cancelled_ &&
+                 (buffer_.size() >= buffer_limit() ||
+                  (!buffer_.empty() && ctx->ram_budget_manager() != nullptr &&
+                   ctx->ram_budget_manager()->ShouldStallProducer()))) {
             RecordStop(ctx.get());
-            cond_var_->wait(l);
+            if (buffer_.size() >= buffer_limit()) {
+              cond_var_->wait(l);
+            } else {
+              // Stalled on the pipeline-wide ram budget; poll since budget
+              // may be released by other iterators.
+              cond_var_->wait_for(
+                  l, std::chrono::milliseconds(kRamBudgetPollPeriodMillis));
+            }
             RecordStart(ctx.get());
           }
 
@@ -536,6 +610,7 @@ class PrefetchDatasetOp::Dataset : public DatasetBase {
         mutex_lock input_l(input_mu_);
         bool end_of_sequence = false;
         BufferElement buffer_element(ctx.get());
+        const uint64 production_start_us = EnvTime::NowMicros();
         {
           profiler::TraceMe traceme(
               [&] {
@@ -553,12 +628,20 @@ class PrefetchDatasetOp::Dataset : public DatasetBase {
           cond_var_->notify_all();
           return;
         }
+        if (buffer_element.status.ok() && PrefetchPinnedStagingEnabled()) {
+          StageInPinnedMemory(ctx.get(), &buffer_element.value);
+        }
 
         // 3. Signal that the element has been produced.
         {
           mutex_lock l(*mu_);
           RecordBufferEnqueue(ctx.get(), buffer_element.value);
           buffer_element.created_us = EnvTime::NowMicros();
+          if (legacy_autotune_) {
+            auto_tuner_->RecordProduction(
+                static_cast<int64_t>(buffer_element.created_us -
+                                     production_start_us));
+          }
           buffer_.push_back(std::move(buffer_element));
           cond_var_->notify_all();
         }
@@ -15,6 +15,7 @@ limitations under the License.
 #include "tensorflow/core/kernels/data/shuffle_dataset_op.h"
 
 #include <cstdint>
+#include <cstdlib>
 #include <deque>
 #include <memory>
 #include <numeric>
@@ -23,20 +24,25 @@ limitations under the License.
 #include <utility>
 #include <vector>
 
+#include "absl/container/flat_hash_set.h"
 #include "tensorflow/core/data/dataset_utils.h"
 #include "tensorflow/core/data/name_utils.h"
 #include "tensorflow/core/data/serialization_utils.h"
+#include "tensorflow/core/data/snapshot_utils.h"
 #include "tensorflow/core/framework/dataset.h"
 #include "tensorflow/core/framework/partial_tensor_shape.h"
 #include "tensorflow/core/framework/resource_mgr.h"
 #include "tensorflow/core/framework/tensor.h"
 #include "tensorflow/core/kernels/data/random_seed_ops.h"
 #include "tensorflow/core/lib/core/errors.h"
+#include "tensorflow/core/lib/io/compression.h"
+#include "tensorflow/core/lib/io/path.h"
 #include "tensorflow/core/lib/random/philox_random.h"
 #include "tensorflow/core/lib/random/random.h"
 #include "tensorflow/core/lib/random/random_distributions.h"
 #include "tensorflow/core/platform/errors.h"
 #include "tensorflow/core/platform/stringprintf.h"
+#include "tensorflow/core/util/env_var.h"
 
 namespace tensorflow {
 namespace data {
@@ -62,6 +68,17 @@ namespace data {
 const int64_t kLogIntervalMicros = 10 * 1000000;  // 10 seconds.
 const int64_t kMaxEpochsInBuffer = 3;
 
+// When this environment variable names a directory, full-dataset shuffles
+// (buffer_size equal to the cardinality) spill to disk: the input is streamed
+// into randomly assigned bucket files under the directory, and each bucket is
+// then shuffled in RAM, so peak memory is bounded by the largest bucket
+// instead of the whole dataset.
+constexpr char kSpillDirectoryEnvVar[] = "TF_DATA_SHUFFLE_SPILL_DIRECTORY";
+constexpr char kSpillNumBucketsEnvVar[] = "TF_DATA_SHUFFLE_SPILL_NUM_BUCKETS";
+constexpr char kSpillDiskBudgetEnvVar[] =
+    "TF_DATA_SHUFFLE_SPILL_DISK_BUDGET_BYTES";
+constexpr int64_t kDefaultSpillNumBuckets = 64;
+
 constexpr char kNumRandomSamples[] = "num_random_samples";
 constexpr char kDataProduced[] = "data_produced";
 constexpr char kEndOfInputSequence[] = "end_of_input_sequence";
@@ -197,12 +214,50 @@ class ShuffleDatasetOpBase::ShuffleDatasetBase : public DatasetBase {
       }
     }
 
+    ~Iterator() override {
+      // Join the bucket prefetch thread before deleting its input files.
+      spill_prefetch_thread_.reset();
+      mutex_lock l(mu_);
+      if (!spill_dir_.empty()) {
+        int64_t undeleted_files, undeleted_dirs;
+        Status s = Env::Default()->DeleteRecursively(
+            spill_dir_, &undeleted_files, &undeleted_dirs);
+        if (!s.ok()) {
+          LOG(WARNING) << "Failed to delete shuffle spill directory "
+                       << spill_dir_ << ": " << s;
+        }
+      }
+    }
+
     bool SymbolicCheckpointCompatible() const override { return true; }
 
     Status Initialize(IteratorContext* ctx) override {
       mutex_lock l(mu_);
       seed_generator_->GenerateSeeds(&seed_, &seed2_);
       ResetRngs();
+      const char* spill_root = std::getenv(kSpillDirectoryEnvVar);
+      if (spill_root != nullptr && *spill_root != '\0') {
+        if (IsShuffleAll() && dataset()->count_ == 1) {
+          spill_enabled_ = true;
+          spill_root_ = spill_root;
+          TF_RETURN_IF_ERROR(ReadInt64FromEnvVar(kSpillNumBucketsEnvVar,
+                                                 kDefaultSpillNumBuckets,
+                                                 &spill_num_buckets_));
+          if (spill_num_buckets_ < 1) {
+            return errors::InvalidArgument(kSpillNumBucketsEnvVar,
+                                           " must be positive, got ",
+                                           spill_num_buckets_);
+          }
+          TF_RETURN_IF_ERROR(ReadInt64FromEnvVar(
+              kSpillDiskBudgetEnvVar, 0, &spill_disk_budget_bytes_));
+        } else {
+          LOG(WARNING) << kSpillDirectoryEnvVar
+                       << " is set, but spill-to-disk shuffle only applies to "
+                          "full-dataset shuffles (buffer_size equal to the "
+                          "dataset cardinality) without a fused repeat; using "
+                          "the in-memory shuffle buffer.";
+        }
+      }
       return OkStatus();
     }
 
@@ -210,6 +265,9 @@ class ShuffleDatasetOpBase::ShuffleDatasetBase : public DatasetBase {
                            std::vector<Tensor>* out_tensors,
                            bool* end_of_sequence) override {
       mutex_lock l(mu_);
+      if (spill_enabled_) {
+        return SpillGetNext(ctx, out_tensors, end_of_sequence);
+      }
       TF_RETURN_IF_ERROR(FillBuffer(ctx));
       if (num_elements_ == 0) {
         DCHECK(input_impl_ == nullptr);
@@ -229,6 +287,8 @@ class ShuffleDatasetOpBase::ShuffleDatasetBase : public DatasetBase {
       this->RecordBufferDequeue(ctx, *out_tensors);
       std::swap(buffer_->at(index),
                 buffer_->at(slices_.front()->start % buffer_->size()));
+      checkpoint_indices_.insert(index);
+      checkpoint_indices_.insert(slices_.front()->start % buffer_->size());
       slices_.front()->start++;
       num_elements_--;
       return OkStatus();
@@ -252,6 +312,12 @@ class ShuffleDatasetOpBase::ShuffleDatasetBase : public DatasetBase {
     Status SaveInternal(SerializationContext* ctx,
                         IteratorStateWriter* writer) override {
       mutex_lock l(mu_);
+      if (spill_enabled_) {
+        return errors::Unimplemented(
+            "Checkpointing is not supported for the spill-to-disk shuffle "
+            "(enabled by ",
+            kSpillDirectoryEnvVar, ").");
+      }
       // Save state needed to restore the random number generators.
       TF_RETURN_IF_ERROR(
           writer->WriteScalar(prefix(), kEpochNumRandomSamples,
@@ -273,8 +339,18 @@ class ShuffleDatasetOpBase::ShuffleDatasetBase : public DatasetBase {
       TF_RETURN_IF_ERROR(writer->WriteScalar(prefix(), kEpoch, epoch_));
       TF_RETURN_IF_ERROR(
           writer->WriteScalar(prefix(), kNumElements, num_elements_));
-      TF_RETURN_IF_ERROR(WriteElementsToCheckpoint(
-          writer, absl::StrCat(prefix(), kColon, "buffer"), *buffer_));
+      if (ctx->symbolic_checkpoint()) {
+        // When writing into a MemoryCheckpoint the previously written buffer
+        // elements are retained across saves, so only the slots mutated since
+        // the last save need to be rewritten.
+        TF_RETURN_IF_ERROR(UpdateCheckpointElements(
+            writer, absl::StrCat(prefix(), kColon, "buffer"), *buffer_,
+            checkpoint_indices_));
+        checkpoint_indices_.clear();
+      } else {
+        TF_RETURN_IF_ERROR(WriteElementsToCheckpoint(
+            writer, absl::StrCat(prefix(), kColon, "buffer"), *buffer_));
+      }
       TF_RETURN_IF_ERROR(
           writer->WriteScalar(prefix(), kSlicesSize, slices_.size()));
       for (size_t i = 0; i < slices_.size(); ++i) {
@@ -300,6 +376,12 @@ class ShuffleDatasetOpBase::ShuffleDatasetBase : public DatasetBase {
     Status RestoreInternal(IteratorContext* ctx,
                            IteratorStateReader* reader) override {
       mutex_lock l(mu_);
+      if (spill_enabled_) {
+        return errors::Unimplemented(
+            "Checkpointing is not supported for the spill-to-disk shuffle "
+            "(enabled by ",
+            kSpillDirectoryEnvVar, ").");
+      }
       // Restore the random number generators.
       int64_t num_random_samples;
       TF_RETURN_IF_ERROR(reader->ReadScalar(prefix(), kEpochNumRandomSamples,
@@ -339,6 +421,12 @@ class ShuffleDatasetOpBase::ShuffleDatasetBase : public DatasetBase {
       TF_RETURN_IF_ERROR(ReadElementsFromCheckpoint(
           ctx, reader, absl::StrCat(prefix(), kColon, "buffer"),
           buffer_.get()));
+      // The first save after a restore may write into a fresh checkpoint, so
+      // every restored slot must be treated as dirty.
+      checkpoint_indices_.clear();
+      for (size_t i = 0; i < buffer_->size(); ++i) {
+        checkpoint_indices_.insert(i);
+      }
       for (const auto& element : *buffer_) {
         RecordBufferEnqueue(ctx, element);
       }
@@ -502,9 +590,11 @@ class ShuffleDatasetOpBase::ShuffleDatasetBase : public DatasetBase {
       this->RecordBufferEnqueue(ctx, element);
       if (num_elements_ == buffer_->size()) {
         DCHECK(IsShuffleAll());
+        checkpoint_indices_.insert(buffer_->size());
         buffer_->push_back(element);
       } else {
         size_t index = slices_.back()->end % buffer_->size();
+        checkpoint_indices_.insert(index);
         buffer_->at(index) = std::move(element);
       }
       num_elements_++;
@@ -526,10 +616,182 @@ class ShuffleDatasetOpBase::ShuffleDatasetBase : public DatasetBase {
       return absl::StrCat(dataset()->buffer_size_);
     }
 
+    // A bucket of the on-disk partition, loaded back into memory. `status`
+    // carries any error hit while reading the bucket file so that the
+    // prefetch thread can report failures to the consumer.
+    struct SpillBucket {
+      Status status;
+      std::vector<std::vector<Tensor>> elements;
+    };
+
+    // Serves elements of the two-pass external shuffle. The first call
+    // partitions the entire input into `spill_num_buckets_` files with
+    // uniformly random bucket assignment; afterwards buckets are read back
+    // one at a time (with single-bucket read-ahead) and shuffled in memory,
+    // so peak memory is bounded by the largest bucket.
+    Status SpillGetNext(IteratorContext* ctx, std::vector<Tensor>* out_tensors,
+                        bool* end_of_sequence)
+        TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+      if (!spill_partitioned_) {
+        TF_RETURN_IF_ERROR(SpillPartitionInput(ctx));
+        spill_partitioned_ = true;
+      }
+      while (spill_bucket_pos_ >= spill_current_bucket_.size()) {
+        if (spill_next_bucket_ >= spill_num_buckets_) {
+          *end_of_sequence = true;
+          return OkStatus();
+        }
+        TF_RETURN_IF_ERROR(TakeNextSpillBucket(ctx));
+      }
+      *out_tensors = std::move(spill_current_bucket_[spill_bucket_pos_++]);
+      *end_of_sequence = false;
+      return OkStatus();
+    }
+
+    // Streams the entire input into one TFRecord file per bucket, assigning
+    // each element to a bucket uniformly at random.
+    Status SpillPartitionInput(IteratorContext* ctx)
+        TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+      spill_dir_ = io::JoinPath(
+          spill_root_,
+          absl::StrCat("tf_data_shuffle_spill_", random::New64()));
+      TF_RETURN_IF_ERROR(ctx->env()->RecursivelyCreateDir(spill_dir_));
+      std::vector<std::unique_ptr<snapshot_util::TFRecordWriter>> writers;
+      writers.reserve(spill_num_buckets_);
+      for (int64_t i = 0; i < spill_num_buckets_; ++i) {
+        writers.push_back(std::make_unique<snapshot_util::TFRecordWriter>(
+            SpillBucketFilename(i), io::compression::kNone));
+        TF_RETURN_IF_ERROR(writers.back()->Initialize(ctx->env()));
+      }
+      TF_RETURN_IF_ERROR(this->dataset()->input_->MakeIterator(
+          ctx, this, this->prefix(), &input_impl_));
+      int64_t start_micros = EnvTime::NowMicros();
+      int64_t num_log_entries = 0;
+      while (true) {
+        if (EnvTime::NowMicros() >
+            ((num_log_entries + 1) * kLogIntervalMicros) + start_micros) {
+          num_log_entries++;
+          LOG_EVERY_N_SEC(INFO, 10)
+              << dataset()->metadata().name() << ": "
+              << "Partitioning input into shuffle spill buckets (this may "
+                 "take a while): "
+              << spill_bytes_written_ << " bytes written";
+        }
+        std::vector<Tensor> element;
+        bool end_of_input_sequence = false;
+        TF_RETURN_IF_ERROR(
+            input_impl_->GetNext(ctx, &element, &end_of_input_sequence));
+        if (end_of_input_sequence) {
+          break;
+        }
+        for (const Tensor& t : element) {
+          spill_bytes_written_ += t.TotalBytes();
+        }
+        if (spill_disk_budget_bytes_ > 0 &&
+            spill_bytes_written_ > spill_disk_budget_bytes_) {
+          return errors::ResourceExhausted(
+              "Shuffle spill would exceed the disk budget of ",
+              spill_disk_budget_bytes_, " bytes (set by ",
+              kSpillDiskBudgetEnvVar, ").");
+        }
+        int64_t bucket = Random() % spill_num_buckets_;
+        TF_RETURN_IF_ERROR(writers[bucket]->WriteTensors(element));
+      }
+      input_impl_.reset();
+      for (auto& writer : writers) {
+        TF_RETURN_IF_ERROR(writer->Close());
+      }
+      if (num_log_entries > 0) {
+        LOG(INFO) << "Shuffle spill partitioning finished: "
+                  << spill_bytes_written_ << " bytes in " << spill_num_buckets_
+                  << " buckets.";
+      }
+      return OkStatus();
+    }
+
+    // Makes the next bucket current: collects the prefetched bucket if a
+    // prefetch is in flight (otherwise reads it synchronously), kicks off the
+    // read of the following bucket, and shuffles the elements in memory.
+    Status TakeNextSpillBucket(IteratorContext* ctx)
+        TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+      std::unique_ptr<SpillBucket> bucket;
+      if (spill_prefetch_thread_) {
+        {
+          mutex_lock l(spill_prefetch_mu_);
+          while (spill_prefetch_pending_) {
+            spill_prefetch_cv_.wait(l);
+          }
+          bucket = std::move(spill_prefetched_bucket_);
+        }
+        spill_prefetch_thread_.reset();
+      } else {
+        bucket = std::make_unique<SpillBucket>();
+        bucket->status = LoadSpillBucket(
+            ctx->env(), SpillBucketFilename(spill_next_bucket_),
+            &bucket->elements);
+      }
+      spill_next_bucket_++;
+      TF_RETURN_IF_ERROR(bucket->status);
+      if (spill_next_bucket_ < spill_num_buckets_) {
+        StartSpillPrefetch(ctx->env(), spill_next_bucket_);
+      }
+      spill_current_bucket_ = std::move(bucket->elements);
+      // Fisher-Yates shuffle of the in-memory bucket.
+      for (int64_t i = spill_current_bucket_.size() - 1; i > 0; --i) {
+        int64_t j = Random() % (i + 1);
+        std::swap(spill_current_bucket_[i], spill_current_bucket_[j]);
+      }
+      spill_bucket_pos_ = 0;
+      return OkStatus();
+    }
+
+    Status LoadSpillBucket(Env* env, const std::string& filename,
+                           std::vector<std::vector<Tensor>>* out) {
+      snapshot_util::TFRecordReader reader(filename, io::compression::kNone,
+                                           dataset()->output_dtypes());
+      TF_RETURN_IF_ERROR(reader.Initialize(env));
+      while (true) {
+        std::vector<Tensor> element;
+        Status s = reader.ReadTensors(&element);
+        if (errors::IsOutOfRange(s)) {
+          return OkStatus();
+        }
+        TF_RETURN_IF_ERROR(s);
+        out->push_back(std::move(element));
+      }
+    }
+
+    void StartSpillPrefetch(Env* env, int64_t bucket)
+        TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+      std::string filename = SpillBucketFilename(bucket);
+      {
+        mutex_lock l(spill_prefetch_mu_);
+        spill_prefetch_pending_ = true;
+      }
+      spill_prefetch_thread_.reset(env->StartThread(
+          {}, "tf_data_shuffle_spill_prefetch", [this, env, filename]() {
+            auto bucket = std::make_unique<SpillBucket>();
+            bucket->status =
+                LoadSpillBucket(env, filename, &bucket->elements);
+            mutex_lock l(spill_prefetch_mu_);
+            spill_prefetched_bucket_ = std::move(bucket);
+            spill_prefetch_pending_ = false;
+            spill_prefetch_cv_.notify_all();
+          }));
+    }
+
+    std::string SpillBucketFilename(int64_t bucket) const {
+      return io::JoinPath(spill_dir_,
+                          absl::StrCat("bucket_", bucket, ".tfrecord"));
+    }
+
     mutex mu_;
     SeedGenerator* const seed_generator_ TF_GUARDED_BY(mu_);  // Not owned.
     std::unique_ptr<std::vector<std::vector<Tensor>>> buffer_
         TF_GUARDED_BY(mu_);
+    // Slots of `buffer_` mutated since the last SaveInternal; lets symbolic
+    // checkpoints rewrite only the changed elements.
+    absl::flat_hash_set<int64_t> checkpoint_indices_ TF_GUARDED_BY(mu_);
     std::unique_ptr<IteratorBase> input_impl_ TF_GUARDED_BY(mu_) = nullptr;
     int64_t epoch_ TF_GUARDED_BY(mu_) = 0;
     int64_t num_elements_ TF_GUARDED_BY(mu_) = 0;
@@ -545,6 +807,27 @@ class ShuffleDatasetOpBase::ShuffleDatasetBase : public DatasetBase {
         TF_GUARDED_BY(mu_);
     int64_t num_random_samples_ TF_GUARDED_BY(mu_) = 0;
     bool data_produced_ TF_GUARDED_BY(mu_) = false;
+
+    // State of the optional spill-to-disk shuffle. `spill_dir_` outlives mu_
+    // sections only in the destructor, after the prefetch thread has joined.
+    bool spill_enabled_ TF_GUARDED_BY(mu_) = false;
+    bool spill_partitioned_ TF_GUARDED_BY(mu_) = false;
+    std::string spill_root_ TF_GUARDED_BY(mu_);
+    std::string spill_dir_ TF_GUARDED_BY(mu_);
+    int64_t spill_num_buckets_ TF_GUARDED_BY(mu_) = 0;
+    int64_t spill_disk_budget_bytes_ TF_GUARDED_BY(mu_) = 0;
+    int64_t spill_bytes_written_ TF_GUARDED_BY(mu_) = 0;
+    int64_t spill_next_bucket_ TF_GUARDED_BY(mu_) = 0;
+    std::vector<std::vector<Tensor>> spill_current_bucket_ TF_GUARDED_BY(mu_);
+    size_t spill_bucket_pos_ TF_GUARDED_BY(mu_) = 0;
+    // Guards hand-off of the read-ahead bucket between the prefetch thread
+    // and the consumer; a separate mutex so the thread never contends on mu_.
+    mutex spill_prefetch_mu_;
+    condition_variable spill_prefetch_cv_;
+    bool spill_prefetch_pending_ TF_GUARDED_BY(spill_prefetch_mu_) = false;
+    std::unique_ptr<SpillBucket> spill_prefetched_bucket_
+        TF_GUARDED_BY(spill_prefetch_mu_);
+    std::unique_ptr<Thread> spill_prefetch_thread_;
   };
 
   const DatasetBase* const input_;
@@ -14,16 +14,26 @@ limitations under the License.
 ==============================================================================*/
 #include "tensorflow/core/kernels/data/text_line_dataset_op.h"
 
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
 #include "tensorflow/core/data/name_utils.h"
 #include "tensorflow/core/data/utils.h"
 #include "tensorflow/core/framework/metrics.h"
 #include "tensorflow/core/framework/partial_tensor_shape.h"
 #include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/lib/core/threadpool.h"
 #include "tensorflow/core/lib/io/buffered_inputstream.h"
 #include "tensorflow/core/lib/io/inputbuffer.h"
 #include "tensorflow/core/lib/io/random_inputstream.h"
 #include "tensorflow/core/lib/io/zlib_compression_options.h"
 #include "tensorflow/core/lib/io/zlib_inputstream.h"
+#include "tensorflow/core/platform/blocking_counter.h"
+#include "tensorflow/core/platform/stringpiece.h"
+#include "tsl/util/env_var.h"
 
 namespace tensorflow {
 namespace data {
@@ -38,6 +48,31 @@ constexpr char kGZIP[] = "GZIP";
 constexpr char kCurrentFileIndex[] = "current_file_index";
 constexpr char kCurrentPos[] = "current_pos";
 
+// Number of worker threads for block-parallel line decode, or 0 (the default)
+// if the mode is disabled. When enabled, uncompressed files are split into
+// byte ranges snapped to newline boundaries and decoded concurrently, with
+// line order preserved.
+int64_t ParallelBlockDecodeThreads() {
+  static int64_t num_threads = []() {
+    int64_t value;
+    TF_CHECK_OK(tsl::ReadInt64FromEnvVar("TF_TEXT_LINE_PARALLEL_BLOCK_DECODE",
+                                         /*default_val=*/0, &value));
+    return value;
+  }();
+  return num_threads;
+}
+
+// Nominal byte-range size each block decode worker handles per round.
+int64_t ParallelBlockSizeBytes() {
+  static int64_t block_size = []() {
+    int64_t value;
+    TF_CHECK_OK(tsl::ReadInt64FromEnvVar("TF_TEXT_LINE_PARALLEL_BLOCK_SIZE",
+                                         /*default_val=*/8 << 20, &value));
+    return std::max<int64_t>(value, 64 << 10);
+  }();
+  return block_size;
+}
+
 class TextLineDatasetOp::Dataset : public DatasetBase {
  public:
   Dataset(OpKernelContext* ctx, std::vector<string> filenames,
@@ -98,16 +133,27 @@ class TextLineDatasetOp::Dataset : public DatasetBase {
     explicit Iterator(const Params& params)
         : DatasetIterator<Dataset>(params) {}
 
+    ~Iterator() override {
+      mutex_lock l(mu_);
+      // In-flight block decode workers read through `file_`; wait for them
+      // before the members are destroyed.
+      if (pending_round_) {
+        pending_round_->counter.Wait();
+      }
+    }
+
     Status GetNextInternal(IteratorContext* ctx,
                            std::vector<Tensor>* out_tensors,
                            bool* end_of_sequence) override {
       mutex_lock l(mu_);
       do {
         // We are currently processing a file, so try to read the next line.
-        if (buffered_input_stream_) {
+        if (buffered_input_stream_ || parallel_active_) {
           Tensor line_contents(tstring{});
           tstring& line_contents_str = line_contents.scalar<tstring>()();
-          Status s = buffered_input_stream_->ReadLine(&line_contents_str);
+          Status s = parallel_active_
+                         ? ReadLineParallelLocked(&line_contents_str)
+                         : buffered_input_stream_->ReadLine(&line_contents_str);
 
           if (s.ok()) {
             // Produce the line as output.
@@ -149,12 +195,19 @@ class TextLineDatasetOp::Dataset : public DatasetBase {
       mutex_lock l(mu_);
       TF_RETURN_IF_ERROR(writer->WriteScalar(prefix(), kCurrentFileIndex,
                                              current_file_index_));
-      // `buffered_input_stream_` is empty if
+      // No stream is open if
       // 1. GetNext has not been called even once.
       // 2. All files have been read and iterator has been exhausted.
+      //
+      // Both modes save the raw byte offset of the first line the consumer
+      // has not yet received, so checkpoints are interchangeable between the
+      // serial and block-parallel modes.
       if (buffered_input_stream_) {
         TF_RETURN_IF_ERROR(writer->WriteScalar(prefix(), kCurrentPos,
                                                buffered_input_stream_->Tell()));
+      } else if (parallel_active_) {
+        TF_RETURN_IF_ERROR(writer->WriteScalar(
+            prefix(), kCurrentPos, static_cast<int64_t>(consumed_offset_)));
       }
       return OkStatus();
     }
@@ -175,7 +228,12 @@ class TextLineDatasetOp::Dataset : public DatasetBase {
             reader->ReadScalar(prefix(), kCurrentPos, &current_pos));
 
         TF_RETURN_IF_ERROR(SetupStreamsLocked(ctx->env()));
-        TF_RETURN_IF_ERROR(buffered_input_stream_->Seek(current_pos));
+        if (parallel_active_) {
+          next_block_offset_ = current_pos;
+          consumed_offset_ = current_pos;
+        } else {
+          TF_RETURN_IF_ERROR(buffered_input_stream_->Seek(current_pos));
+        }
       }
       return OkStatus();
     }
@@ -190,9 +248,30 @@ class TextLineDatasetOp::Dataset : public DatasetBase {
       }
 
       // Actually move on to next file.
-      TF_RETURN_IF_ERROR(env->NewRandomAccessFile(
-          TranslateFileName(dataset()->filenames_[current_file_index_]),
-          &file_));
+      const std::string translated_filename =
+          TranslateFileName(dataset()->filenames_[current_file_index_]);
+      TF_RETURN_IF_ERROR(
+          env->NewRandomAccessFile(translated_filename, &file_));
+
+      // Block-parallel decode splits uncompressed files into byte ranges
+      // snapped to newline boundaries and decodes them concurrently;
+      // compressed streams cannot be read from arbitrary offsets.
+      const int64_t num_decode_threads = ParallelBlockDecodeThreads();
+      if (num_decode_threads > 1 && !dataset()->use_compression_) {
+        TF_RETURN_IF_ERROR(env->GetFileSize(translated_filename, &file_size_));
+        if (!block_pool_) {
+          block_pool_ = std::make_unique<thread::ThreadPool>(
+              env, "text_line_block_decode", num_decode_threads);
+        }
+        next_block_offset_ = 0;
+        consumed_offset_ = 0;
+        ready_lines_.clear();
+        ready_line_sizes_.clear();
+        next_ready_line_ = 0;
+        parallel_active_ = true;
+        return OkStatus();
+      }
+
       input_stream_ =
           std::make_unique<io::RandomAccessInputStream>(file_.get(), false);
 
@@ -212,12 +291,173 @@ class TextLineDatasetOp::Dataset : public DatasetBase {
 
     // Resets all reader streams.
     void ResetStreamsLocked() TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+      if (pending_round_) {
+        // In-flight workers read through `file_`; wait for them before the
+        // file is closed.
+        pending_round_->counter.Wait();
+        pending_round_.reset();
+      }
+      parallel_active_ = false;
+      ready_lines_.clear();
+      ready_line_sizes_.clear();
+      next_ready_line_ = 0;
       input_stream_.reset();
       zlib_input_stream_.reset();
       buffered_input_stream_.reset();
       file_.reset();
     }
 
+    // A round of concurrently decoded blocks. Workers only touch their own
+    // slot, so no locking is needed beyond the completion counter.
+    struct BlockRound {
+      explicit BlockRound(int num_blocks)
+          : lines(num_blocks),
+            line_sizes(num_blocks),
+            end_offsets(num_blocks, 0),
+            statuses(num_blocks),
+            counter(num_blocks) {}
+      std::vector<std::vector<tstring>> lines;
+      // Raw byte size of each line including its newline, for checkpointing.
+      std::vector<std::vector<uint32>> line_sizes;
+      // Offset just past the last byte each block consumed (0 if none).
+      std::vector<uint64> end_offsets;
+      std::vector<Status> statuses;
+      BlockingCounter counter;
+    };
+
+    // Decodes the lines starting in [start, limit). Unless
+    // `include_first_line` is set, bytes up to and including the first
+    // newline at offset >= start - 1 belong to the previous block and are
+    // skipped. The line straddling `limit` belongs to this block, so reads
+    // may extend past `limit` until its newline (or EOF).
+    static Status DecodeBlock(RandomAccessFile* file, uint64 start,
+                              uint64 limit, uint64 file_size,
+                              bool include_first_line,
+                              std::vector<tstring>* lines,
+                              std::vector<uint32>* line_sizes,
+                              uint64* end_offset) {
+      *end_offset = 0;
+      if (start >= limit || start >= file_size) return OkStatus();
+      constexpr uint64 kChunkSize = 256 << 10;
+      tstring buffer;
+      bool skipping = !include_first_line;
+      // Start one byte early so a newline immediately before `start` is seen
+      // and the line beginning exactly at `start` is not dropped.
+      uint64 pos = skipping && start > 0 ? start - 1 : start;
+      uint64 line_start = pos;
+      tstring current_line;
+      while (pos < file_size) {
+        const uint64 chunk_size = std::min(kChunkSize, file_size - pos);
+        StringPiece chunk;
+        buffer.resize_uninitialized(chunk_size);
+        Status s = file->Read(pos, chunk_size, &chunk, buffer.mdata());
+        if (!s.ok() && !errors::IsOutOfRange(s)) return s;
+        for (size_t i = 0; i < chunk.size(); ++i) {
+          const uint64 offset = pos + i;
+          const char c = chunk[i];
+          if (skipping) {
+            // Line starts must lie before `limit`; if none is found by then,
+            // the whole range is inside one line owned by a previous block.
+            if (offset >= limit) return OkStatus();
+            if (c == '\n') {
+              skipping = false;
+              line_start = offset + 1;
+            }
+            continue;
+          }
+          if (c == '\n') {
+            if (!current_line.empty() && current_line.back() == '\r') {
+              current_line.resize(current_line.size() - 1);
+            }
+            lines->push_back(std::move(current_line));
+            current_line.clear();
+            line_sizes->push_back(static_cast<uint32>(offset + 1 - line_start));
+            *end_offset = offset + 1;
+            if (offset + 1 >= limit) return OkStatus();
+            line_start = offset + 1;
+          } else {
+            current_line.push_back(c);
+          }
+        }
+        pos += chunk.size();
+        if (chunk.size() < chunk_size) break;  // premature EOF
+      }
+      // Final line without a trailing newline.
+      if (!skipping && pos > line_start) {
+        if (!current_line.empty() && current_line.back() == '\r') {
+          current_line.resize(current_line.size() - 1);
+        }
+        lines->push_back(std::move(current_line));
+        line_sizes->push_back(static_cast<uint32>(pos - line_start));
+        *end_offset = pos;
+      }
+      return OkStatus();
+    }
+
+    // Schedules one round of block decodes starting at `next_block_offset_`.
+    void LaunchRoundLocked() TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+      const int num_blocks = static_cast<int>(ParallelBlockDecodeThreads());
+      const uint64 block_size = static_cast<uint64>(ParallelBlockSizeBytes());
+      const uint64 round_start = next_block_offset_;
+      pending_round_ = std::make_unique<BlockRound>(num_blocks);
+      BlockRound* round = pending_round_.get();
+      RandomAccessFile* file = file_.get();
+      const uint64 file_size = file_size_;
+      for (int i = 0; i < num_blocks; ++i) {
+        const uint64 start = round_start + i * block_size;
+        const uint64 limit = std::min(start + block_size, file_size);
+        block_pool_->Schedule([file, start, limit, file_size, round, i]() {
+          round->statuses[i] = DecodeBlock(
+              file, start, limit, file_size,
+              /*include_first_line=*/i == 0, &round->lines[i],
+              &round->line_sizes[i], &round->end_offsets[i]);
+          round->counter.DecrementCount();
+        });
+      }
+    }
+
+    // Returns the next line in file order, waiting for and draining decode
+    // rounds as needed. Returns OutOfRange at end of file.
+    Status ReadLineParallelLocked(tstring* line)
+        TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+      while (next_ready_line_ == ready_lines_.size()) {
+        if (!pending_round_) {
+          if (next_block_offset_ >= file_size_) {
+            return errors::OutOfRange("eof");
+          }
+          LaunchRoundLocked();
+        }
+        pending_round_->counter.Wait();
+        std::unique_ptr<BlockRound> round = std::move(pending_round_);
+        for (const Status& s : round->statuses) {
+          TF_RETURN_IF_ERROR(s);
+        }
+        ready_lines_.clear();
+        ready_line_sizes_.clear();
+        next_ready_line_ = 0;
+        for (size_t i = 0; i < round->lines.size(); ++i) {
+          std::move(round->lines[i].begin(), round->lines[i].end(),
+                    std::back_inserter(ready_lines_));
+          ready_line_sizes_.insert(ready_line_sizes_.end(),
+                                   round->line_sizes[i].begin(),
+                                   round->line_sizes[i].end());
+          next_block_offset_ =
+              std::max(next_block_offset_, round->end_offsets[i]);
+        }
+        if (ready_lines_.empty() && next_block_offset_ >= file_size_) {
+          return errors::OutOfRange("eof");
+        }
+        // Overlap the next round's decode with consumption of this one.
+        if (next_block_offset_ < file_size_) {
+          LaunchRoundLocked();
+        }
+      }
+      *line = std::move(ready_lines_[next_ready_line_]);
+      consumed_offset_ += ready_line_sizes_[next_ready_line_];
+      ++next_ready_line_;
+      return OkStatus();
+    }
+
     mutex mu_;
     std::unique_ptr<io::RandomAccessInputStream> input_stream_
         TF_GUARDED_BY(mu_);
@@ -227,6 +467,20 @@ class TextLineDatasetOp::Dataset : public DatasetBase {
     size_t current_file_index_ TF_GUARDED_BY(mu_) = 0;
     std::unique_ptr<RandomAccessFile> file_
         TF_GUARDED_BY(mu_);  // must outlive input_stream_
+
+    // Block-parallel decode state; only used when `parallel_active_`.
+    bool parallel_active_ TF_GUARDED_BY(mu_) = false;
+    uint64 file_size_ TF_GUARDED_BY(mu_) = 0;
+    // Next byte of the file to be claimed by a decode round.
+    uint64 next_block_offset_ TF_GUARDED_BY(mu_) = 0;
+    // Byte offset of the first line the consumer has not yet received.
+    uint64 consumed_offset_ TF_GUARDED_BY(mu_) = 0;
+    // Decoded lines awaiting consumption, in file order.
+    std::vector<tstring> ready_lines_ TF_GUARDED_BY(mu_);
+    std::vector<uint32> ready_line_sizes_ TF_GUARDED_BY(mu_);
+    size_t next_ready_line_ TF_GUARDED_BY(mu_) = 0;
+    std::unique_ptr<BlockRound> pending_round_ TF_GUARDED_BY(mu_);
+    std::unique_ptr<thread::ThreadPool> block_pool_ TF_GUARDED_BY(mu_);
   };
 
   const std::vector<string> filenames_;
@@ -25,6 +25,11 @@ limitations under the License.
 #include "tensorflow/core/lib/io/record_reader.h"
 #include "tensorflow/core/lib/io/zlib_compression_options.h"
 #include "tensorflow/core/lib/io/zlib_inputstream.h"
+#include "tensorflow/core/util/env_var.h"
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif  // __linux__
 
 namespace tensorflow {
 namespace data {
@@ -46,6 +51,21 @@ constexpr char kS3FsPrefix[] = "s3://";
 constexpr int64_t kCloudTpuBlockSize = 127LL << 20;  // 127MB.
 constexpr int64_t kS3BlockSize = kCloudTpuBlockSize;
 
+// When TF_DATA_TFRECORD_MMAP=1, uncompressed TFRecord files are mmap'ed and
+// records are sliced out of the mapped region instead of being read through
+// a buffered stream, eliminating the per-record read path for files on fast
+// local storage. Falls back to the streaming reader when mapping fails
+// (e.g. for non-local filesystems).
+bool MmapRecordReaderEnabled() {
+  static const bool enabled = [] {
+    bool value = false;
+    TF_CHECK_OK(
+        ReadBoolFromEnvVar("TF_DATA_TFRECORD_MMAP", false, &value));
+    return value;
+  }();
+  return enabled;
+}
+
 bool is_cloud_tpu_gcs_fs() {
 #if (defined(PLATFORM_CLOUD_TPU) && defined(TPU_GCS_FS)) || \
     defined(LIBTPU_ON_GCE)
@@ -134,11 +154,20 @@ class TFRecordDatasetOp::Dataset : public DatasetBase {
       mutex_lock l(mu_);
       do {
         // We are currently processing a file, so try to read the next record.
-        if (reader_) {
+        if (reader_ || mmap_reader_) {
           out_tensors->emplace_back(ctx->allocator({}), DT_STRING,
                                     TensorShape({}));
-          Status s =
-              reader_->ReadRecord(&out_tensors->back().scalar<tstring>()());
+          Status s;
+          if (mmap_reader_) {
+            StringPiece record;
+            s = mmap_reader_->ReadRecord(&mmap_offset_, &record);
+            if (s.ok()) {
+              out_tensors->back().scalar<tstring>()().assign(record.data(),
+                                                             record.size());
+            }
+          } else {
+            s = reader_->ReadRecord(&out_tensors->back().scalar<tstring>()());
+          }
           if (s.ok()) {
             static monitoring::CounterCell* bytes_counter =
                 metrics::GetTFDataBytesReadCounter(kDatasetType);
@@ -180,10 +209,17 @@ class TFRecordDatasetOp::Dataset : public DatasetBase {
       do {
         // We are currently processing a file, so try to skip reading
         // the next (num_to_skip - *num_skipped) record.
-        if (reader_) {
+        if (reader_ || mmap_reader_) {
           int last_num_skipped;
-          Status s = reader_->SkipRecords(num_to_skip - *num_skipped,
+          Status s;
+          if (mmap_reader_) {
+            s = mmap_reader_->SkipRecords(&mmap_offset_,
+                                          num_to_skip - *num_skipped,
                                           &last_num_skipped);
+          } else {
+            s = reader_->SkipRecords(num_to_skip - *num_skipped,
+                                     &last_num_skipped);
+          }
           *num_skipped += last_num_skipped;
           if (s.ok()) {
             *end_of_sequence = false;
@@ -229,6 +265,9 @@ class TFRecordDatasetOp::Dataset : public DatasetBase {
       if (reader_) {
         TF_RETURN_IF_ERROR(
             writer->WriteScalar(prefix(), kOffset, reader_->TellOffset()));
+      } else if (mmap_reader_) {
+        TF_RETURN_IF_ERROR(writer->WriteScalar(prefix(), kOffset,
+                                               static_cast<int64_t>(mmap_offset_)));
       }
       return OkStatus();
     }
@@ -245,7 +284,7 @@ class TFRecordDatasetOp::Dataset : public DatasetBase {
         int64_t offset;
         TF_RETURN_IF_ERROR(reader->ReadScalar(prefix(), kOffset, &offset));
         TF_RETURN_IF_ERROR(SetupStreamsLocked(ctx->env()));
-        TF_RETURN_IF_ERROR(reader_->SeekOffset(offset));
+        TF_RETURN_IF_ERROR(SeekOffsetLocked(offset));
       }
       return OkStatus();
     }
@@ -260,9 +299,31 @@ class TFRecordDatasetOp::Dataset : public DatasetBase {
       }
 
       // Actually move on to next file.
-      TF_RETURN_IF_ERROR(env->NewRandomAccessFile(
-          TranslateFileName(dataset()->filenames_[current_file_index_]),
-          &file_));
+      const string filename =
+          TranslateFileName(dataset()->filenames_[current_file_index_]);
+      if (MmapRecordReaderEnabled() && dataset()->compression_type_.empty()) {
+        Status s = env->NewReadOnlyMemoryRegionFromFile(filename, &mmap_region_);
+        if (s.ok()) {
+#if defined(__linux__)
+          // The file is consumed front to back; prime the page cache ahead
+          // of the reader.
+          madvise(const_cast<void*>(mmap_region_->data()),
+                  mmap_region_->length(), MADV_SEQUENTIAL | MADV_WILLNEED);
+#endif  // __linux__
+          mmap_reader_ = std::make_unique<io::MemoryRegionRecordReader>(
+              StringPiece(static_cast<const char*>(mmap_region_->data()),
+                          mmap_region_->length()));
+          mmap_offset_ = 0;
+          if (!dataset()->byte_offsets_.empty()) {
+            mmap_offset_ = dataset()->byte_offsets_[current_file_index_];
+          }
+          return OkStatus();
+        }
+        // Fall back to the streaming reader, e.g. when the filesystem does
+        // not support memory mapping.
+        mmap_region_.reset();
+      }
+      TF_RETURN_IF_ERROR(env->NewRandomAccessFile(filename, &file_));
       reader_ = std::make_unique<io::SequentialRecordReader>(
           file_.get(), dataset()->options_);
       if (!dataset()->byte_offsets_.empty()) {
@@ -272,10 +333,22 @@ class TFRecordDatasetOp::Dataset : public DatasetBase {
       return OkStatus();
     }
 
+    // Seeks the active reader to `offset`.
+    Status SeekOffsetLocked(uint64 offset) TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+      if (mmap_reader_) {
+        mmap_offset_ = offset;
+        return OkStatus();
+      }
+      return reader_->SeekOffset(offset);
+    }
+
     // Resets all reader streams.
     void ResetStreamsLocked() TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
       reader_.reset();
       file_.reset();
+      mmap_reader_.reset();
+      mmap_region_.reset();
+      mmap_offset_ = 0;
     }
 
     mutex mu_;
@@ -285,6 +358,14 @@ class TFRecordDatasetOp::Dataset : public DatasetBase {
     // we must destroy `reader_` before `file_`.
     std::unique_ptr<RandomAccessFile> file_ TF_GUARDED_BY(mu_);
     std::unique_ptr<io::SequentialRecordReader> reader_ TF_GUARDED_BY(mu_);
+
+    // Used instead of `file_`/`reader_` when the current file is mmap'ed;
+    // `mmap_reader_` returns views into `mmap_region_`, which must outlive
+    // it.
+    std::unique_ptr<ReadOnlyMemoryRegion> mmap_region_ TF_GUARDED_BY(mu_);
+    std::unique_ptr<io::MemoryRegionRecordReader> mmap_reader_
+        TF_GUARDED_BY(mu_);
+    uint64 mmap_offset_ TF_GUARDED_BY(mu_) = 0;
   };
 
   const std::vector<string> filenames_;
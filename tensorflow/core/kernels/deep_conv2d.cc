@@ -20,8 +20,16 @@ limitations under the License.
 
 #include <stdlib.h>
 
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
 #include "tensorflow/core/framework/op_kernel.h"
 #include "tensorflow/core/kernels/winograd_transform.h"
+#include "tensorflow/core/lib/hash/hash.h"
+#include "tensorflow/core/lib/strings/strcat.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/util/env_var.h"
 #include "tensorflow/core/util/work_sharder.h"
 
 namespace tensorflow {
@@ -931,6 +939,55 @@ struct ComputeConv2D {
   }
 };
 
+// Returns true if transformed and packed filters should be memoized in a
+// process-wide cache keyed by the filter contents. Enabled by setting the
+// 'TF_USE_CONV2D_PACKED_FILTER_CACHE' environment variable. Intended for
+// inference servers whose filters are constant: with hundreds of conv layers
+// and concurrent sessions the per-execution transform and pack work is
+// redundant, and memoizing it also removes the first-inference latency spike
+// of each additional session. The cache is not evicted, so it should not be
+// enabled when filters change between executions (e.g. training).
+static bool UsePackedFilterCache() {
+  static bool cached_result = [] {
+    bool result = false;
+    TF_CHECK_OK(tensorflow::ReadBoolFromEnvVar(
+        "TF_USE_CONV2D_PACKED_FILTER_CACHE",
+        /*default_val=*/false, &result));
+    return result;
+  }();
+  return cached_result;
+}
+
+namespace {
+
+// Process-wide cache of packed filters, shared read-only by all sessions.
+struct PackedFilterCache {
+  mutex mu;
+  std::unordered_map<string, std::shared_ptr<const std::vector<Tensor>>>
+      entries TF_GUARDED_BY(mu);
+
+  static PackedFilterCache* Global() {
+    static PackedFilterCache* cache = new PackedFilterCache;
+    return cache;
+  }
+};
+
+// Returns the cache key for looking up the packed filters of a convolution
+// with arguments 'args' over the 'filter_size' filter values at 'filter'.
+// The filter contents are part of the key, so a stale entry can never be
+// returned for a filter whose values changed in place.
+template <typename T>
+string PackedFilterCacheKey(const Conv2DArgs& args, const T* filter,
+                            int64_t filter_size) {
+  const uint64 fingerprint = Hash64(reinterpret_cast<const char*>(filter),
+                                    filter_size * sizeof(T));
+  return strings::StrCat(fingerprint, "_", args.filter_rows, "_",
+                         args.filter_cols, "_", args.in_depth, "_",
+                         args.out_depth);
+}
+
+}  // namespace
+
 namespace functor {
 
 // Conv2D operation specialized for deep convolutions (i.e. large
@@ -975,24 +1032,53 @@ struct DeepConv2D<CPUDevice, T> {
         std::max(int64_t{0}, args.filter_cols - base_filter_rows);
     const int64_t filter_shards_col = 1 + (filter_residual_col + 2 - 1) / 2;
 
-    // Allocate buffer for transformed filters.
-    Tensor filter_transform;
-    OP_REQUIRES_OK(
-        ctx, ctx->allocate_temp(
-                 DataTypeToEnum<T>::value,
-                 TensorShape({tile_rows, tile_cols, out_depth,
-                              filter_shards_row, filter_shards_col, in_depth}),
-                 &filter_transform));
-    T* filter_transform_data = filter_transform.template flat<T>().data();
-
-    // Transform filters.
-    TransformFilters<T>()(ctx, args, transform.get(), filter_shards_row,
-                          filter_shards_col, filter, filter_transform_data);
-
-    // Pack filters.
     std::vector<Tensor> packed_filters(tile_spatial_size);
-    PackFilters<T>()(ctx, args, tile_spatial_size, filter_shards_row,
-                     filter_shards_col, filter_transform_data, &packed_filters);
+    string cache_key;
+    bool found_in_cache = false;
+    if (UsePackedFilterCache()) {
+      const int64_t filter_size =
+          args.filter_rows * args.filter_cols * in_depth * out_depth;
+      cache_key = PackedFilterCacheKey<T>(args, filter, filter_size);
+      PackedFilterCache* cache = PackedFilterCache::Global();
+      mutex_lock l(cache->mu);
+      auto it = cache->entries.find(cache_key);
+      if (it != cache->entries.end()) {
+        // Tensors share their underlying buffers, so this only copies
+        // references to the read-only packed filters.
+        packed_filters = *it->second;
+        found_in_cache = true;
+      }
+    }
+
+    if (!found_in_cache) {
+      // Allocate buffer for transformed filters.
+      Tensor filter_transform;
+      OP_REQUIRES_OK(
+          ctx,
+          ctx->allocate_temp(
+              DataTypeToEnum<T>::value,
+              TensorShape({tile_rows, tile_cols, out_depth, filter_shards_row,
+                           filter_shards_col, in_depth}),
+              &filter_transform));
+      T* filter_transform_data = filter_transform.template flat<T>().data();
+
+      // Transform filters.
+      TransformFilters<T>()(ctx, args, transform.get(), filter_shards_row,
+                            filter_shards_col, filter, filter_transform_data);
+
+      // Pack filters.
+      PackFilters<T>()(ctx, args, tile_spatial_size, filter_shards_row,
+                       filter_shards_col, filter_transform_data,
+                       &packed_filters);
+
+      if (UsePackedFilterCache()) {
+        PackedFilterCache* cache = PackedFilterCache::Global();
+        mutex_lock l(cache->mu);
+        cache->entries.emplace(
+            cache_key,
+            std::make_shared<const std::vector<Tensor>>(packed_filters));
+      }
+    }
 
     // Allocate buffer for tile transform matrix.
     Tensor tile_transform_matrix_tensor;
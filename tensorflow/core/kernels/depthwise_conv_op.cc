@@ -156,16 +156,71 @@ struct DepthwiseConv2DKernel {
   }
 };
 
+// Zero-copy kernel for the case when 'in_depth' is a multiple of the vector
+// register width and 'depth_multiplier' is one. The input rows then already
+// have the layout the vector loop needs, so the per-patch buffer copy is
+// skipped entirely and the packet loads read straight from the input image.
+// Processes up to kColBlockSize adjacent output columns per call so that each
+// loaded filter register is reused across the columns (register blocking);
+// boundary taps that fall into the padding contribute zero and are skipped.
+template <typename T>
+struct DepthwiseConv2DDirectKernel {
+  typedef typename Eigen::internal::packet_traits<T>::type Packet;
+
+  // Number of adjacent output columns accumulated per filter register load.
+  static constexpr int64_t kColBlockSize = 4;
+
+  static void Run(const DepthwiseArgs& args, const int64_t out_r,
+                  const int64_t out_c_start, const int64_t num_cols,
+                  const T* filter, const T* input, T* output) {
+    static const int64_t kPacketSize = (sizeof(Packet) / sizeof(T));
+
+    const int64_t depth = args.out_depth;  // == in_depth for this kernel.
+    const int64_t in_row_size = args.in_cols * depth;
+    const int64_t in_r_start = out_r * args.stride - args.pad_rows;
+    const int64_t in_c_start = out_c_start * args.stride - args.pad_cols;
+    const int64_t base_output_index =
+        (out_r * args.out_cols + out_c_start) * depth;
+
+    for (int64_t i = 0; i < depth; i += kPacketSize) {
+      Packet vaccum[kColBlockSize];
+      for (int64_t n = 0; n < num_cols; ++n) {
+        vaccum[n] = Eigen::internal::pset1<Packet>(static_cast<T>(0));
+      }
+      for (int64_t f_r = 0; f_r < args.filter_rows; ++f_r) {
+        const int64_t in_r = in_r_start + f_r;
+        if (in_r < 0 || in_r >= args.in_rows) continue;
+        const T* input_row = input + in_r * in_row_size + i;
+        const T* filter_row = filter + f_r * args.filter_cols * depth + i;
+        for (int64_t f_c = 0; f_c < args.filter_cols; ++f_c) {
+          const auto filter_block =
+              Eigen::internal::ploadu<Packet>(filter_row + f_c * depth);
+          for (int64_t n = 0; n < num_cols; ++n) {
+            const int64_t in_c = in_c_start + n * args.stride + f_c;
+            if (in_c < 0 || in_c >= args.in_cols) continue;
+            const auto data_block =
+                Eigen::internal::ploadu<Packet>(input_row + in_c * depth);
+            vaccum[n] = Eigen::internal::pmadd<Packet>(filter_block,
+                                                       data_block, vaccum[n]);
+          }
+        }
+      }
+      for (int64_t n = 0; n < num_cols; ++n) {
+        Eigen::internal::pstoreu<T>(output + base_output_index + n * depth + i,
+                                    vaccum[n]);
+      }
+    }
+  }
+};
+
 // Computes the depthwise conv2d of 'input' by 'depthwise_filter' and stores
 // the result in 'output'. This implementation trades off copying small patches
 // of the input to achieve better data alignment, which enables vectorized
 // load/store and multiply-add operations (see comments at InputBufferCopyOp and
-// DepthwiseConv2DKernel for details).
+// DepthwiseConv2DKernel for details). When the input depth is already
+// register-aligned and the depth multiplier is one, the copy is skipped and
+// DepthwiseConv2DDirectKernel reads the input in place.
 //
-// TODO(andydavis) Evaluate the performance of processing multiple input
-// patches in the inner loop.
-// TODO(andydavis) Consider a zero-copy implementation for the case when
-// 'in_depth' is a multiple of register width, and 'depth_multipler' is one.
 // TODO(andydavis) Evaluate the performance of alternative implementations.
 template <typename T>
 struct LaunchDepthwiseConvOp<CPUDevice, T> {
@@ -200,9 +255,16 @@ struct LaunchDepthwiseConvOp<CPUDevice, T> {
     const T* filter_data =
         pad_filter ? padded_filter.template flat<T>().data() : depthwise_filter;
 
+    // The direct kernel reads the input in place; it requires no padded
+    // filter ('pad_filter' is false when the depth is register-aligned and
+    // the depth multiplier is one, so 'filter_data' is the original
+    // HWC-contiguous filter) and no input buffer.
+    const bool use_direct_kernel =
+        args.depth_multiplier == 1 && (args.in_depth % kPacketSize) == 0;
+
     // Computes one shard of depthwise conv2d output.
-    auto shard = [&ctx, &args, &input, &filter_data, &output, data_format](
-                     int64_t start, int64_t limit) {
+    auto shard = [&ctx, &args, &input, &filter_data, &output, data_format,
+                  use_direct_kernel](int64_t start, int64_t limit) {
       static const int64_t kPacketSize = (sizeof(Packet) / sizeof(T));
       const int64_t input_image_size =
           args.in_rows * args.in_cols * args.in_depth;
@@ -212,14 +274,18 @@ struct LaunchDepthwiseConvOp<CPUDevice, T> {
       const int64_t padded_filter_inner_dim_size =
           ((args.out_depth + kPacketSize - 1) / kPacketSize) * kPacketSize;
 
-      // Allocate buffer for local input regions.
+      // Allocate buffer for local input regions (unused by the direct
+      // kernel).
       Tensor input_buffer;
-      OP_REQUIRES_OK(
-          ctx, ctx->allocate_temp(DataTypeToEnum<T>::value,
-                                  TensorShape({filter_spatial_size,
-                                               padded_filter_inner_dim_size}),
-                                  &input_buffer));
-      T* input_buffer_data = input_buffer.template flat<T>().data();
+      T* input_buffer_data = nullptr;
+      if (!use_direct_kernel) {
+        OP_REQUIRES_OK(
+            ctx, ctx->allocate_temp(DataTypeToEnum<T>::value,
+                                    TensorShape({filter_spatial_size,
+                                                 padded_filter_inner_dim_size}),
+                                    &input_buffer));
+        input_buffer_data = input_buffer.template flat<T>().data();
+      }
 
       for (int64_t i = start; i < limit; ++i) {
         const int64_t b = i / args.out_rows;
@@ -228,6 +294,20 @@ struct LaunchDepthwiseConvOp<CPUDevice, T> {
 
         const int64_t out_r = i % args.out_rows;
 
+        if (use_direct_kernel) {
+          constexpr int64_t kColBlockSize =
+              DepthwiseConv2DDirectKernel<T>::kColBlockSize;
+          for (int64_t out_c = 0; out_c < args.out_cols;
+               out_c += kColBlockSize) {
+            const int64_t num_cols =
+                std::min(kColBlockSize, args.out_cols - out_c);
+            DepthwiseConv2DDirectKernel<T>::Run(args, out_r, out_c, num_cols,
+                                                filter_data, input + in_base,
+                                                output + out_base);
+          }
+          continue;
+        }
+
         for (int64_t out_c = 0; out_c < args.out_cols; ++out_c) {
           // Populate 'input_buffer_data' with data from local input region.
           functor::DepthwiseInputCopyOp<T>()(args, padded_filter_inner_dim_size,
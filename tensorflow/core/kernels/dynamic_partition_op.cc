@@ -15,7 +15,9 @@ limitations under the License.
 
 // See docs in ../ops/data_flow_ops.cc.
 
+#include <algorithm>
 #include <vector>
+
 #include "tensorflow/core/framework/bounds_check.h"
 #include "tensorflow/core/framework/op_kernel.h"
 #include "tensorflow/core/framework/register_types.h"
@@ -23,6 +25,7 @@ limitations under the License.
 #include "tensorflow/core/framework/types.h"
 #include "tensorflow/core/lib/gtl/inlined_vector.h"
 #include "tensorflow/core/util/util.h"
+#include "tensorflow/core/util/work_sharder.h"
 
 namespace tensorflow {
 
@@ -39,9 +42,16 @@ class DynamicPartitionOp_Shared : public OpKernel {
     //   in the graph?
   }
 
-  void ValidateAndAllocateOutputs(OpKernelContext* c, const Tensor** data,
-                                  const Tensor** partitions,
-                                  OpOutputList* Tout) {
+  // Validates the partition ids, counts the occurrences of each id per block
+  // (phase one of the two-phase compaction) and allocates the outputs from the
+  // per-partition totals. The per-block counts are returned so that the copy
+  // phase can derive each block's starting offset into every output; a single
+  // block is used when the input is too small to shard.
+  void ValidateAndAllocateOutputs(
+      OpKernelContext* c, const Tensor** data, const Tensor** partitions,
+      OpOutputList* Tout,
+      std::vector<gtl::InlinedVector<int64_t, 32>>* block_counts,
+      int64_t* block_size) {
     OP_REQUIRES_OK(c, c->input("data", data));
     OP_REQUIRES_OK(c, c->input("partitions", partitions));
     OP_REQUIRES(
@@ -52,17 +62,65 @@ class DynamicPartitionOp_Shared : public OpKernel {
             "got data.shape = ", (*data)->shape().DebugString(),
             ", partitions.shape = ", (*partitions)->shape().DebugString()));
 
-    // Count how many occurrences of each partition id we have in partitions
-    gtl::InlinedVector<int, 32> partition_count(num_partitions_);
     auto e_partitions = (*partitions)->flat<int32>();
     const int64_t N = e_partitions.dimension(0);
-    for (int64_t i = 0; i < N; i++) {
-      const int32_t p = internal::SubtleMustCopy(e_partitions(i));
-      OP_REQUIRES(c, FastBoundsCheck(p, num_partitions_),
-                  errors::InvalidArgument(
-                      "partitions", SliceDebugString((*partitions)->shape(), i),
-                      " = ", p, " is not in [0, ", num_partitions_, ")"));
-      partition_count[p]++;
+    auto* worker_threads = c->device()->tensorflow_cpu_worker_threads();
+    const int64_t num_blocks = std::max<int64_t>(
+        1, std::min<int64_t>(worker_threads->num_threads,
+                             N / kMinElementsPerBlock));
+    *block_size = (N + num_blocks - 1) / num_blocks;
+    block_counts->assign(num_blocks,
+                         gtl::InlinedVector<int64_t, 32>(num_partitions_));
+
+    // Count how many occurrences of each partition id we have in partitions.
+    if (num_blocks == 1) {
+      auto& counts = (*block_counts)[0];
+      for (int64_t i = 0; i < N; i++) {
+        const int32_t p = internal::SubtleMustCopy(e_partitions(i));
+        OP_REQUIRES(c, FastBoundsCheck(p, num_partitions_),
+                    errors::InvalidArgument(
+                        "partitions",
+                        SliceDebugString((*partitions)->shape(), i), " = ", p,
+                        " is not in [0, ", num_partitions_, ")"));
+        counts[p]++;
+      }
+    } else {
+      // The first out-of-range index seen by each block, or -1.
+      std::vector<int64_t> invalid_index(num_blocks, -1);
+      Shard(worker_threads->num_threads, worker_threads->workers, num_blocks,
+            *block_size, [&](int64_t begin, int64_t end) {
+              for (int64_t b = begin; b < end; ++b) {
+                auto& counts = (*block_counts)[b];
+                const int64_t block_begin = b * *block_size;
+                const int64_t block_end =
+                    std::min(block_begin + *block_size, N);
+                for (int64_t i = block_begin; i < block_end; ++i) {
+                  const int32_t p = internal::SubtleMustCopy(e_partitions(i));
+                  if (!FastBoundsCheck(p, num_partitions_)) {
+                    invalid_index[b] = i;
+                    break;
+                  }
+                  counts[p]++;
+                }
+              }
+            });
+      for (int64_t b = 0; b < num_blocks; ++b) {
+        const int64_t i = invalid_index[b];
+        if (i < 0) continue;
+        const int32_t p = internal::SubtleMustCopy(e_partitions(i));
+        OP_REQUIRES(c, false,
+                    errors::InvalidArgument(
+                        "partitions",
+                        SliceDebugString((*partitions)->shape(), i), " = ", p,
+                        " is not in [0, ", num_partitions_, ")"));
+      }
+    }
+
+    gtl::InlinedVector<int64_t, 32> partition_count(num_partitions_);
+    for (const auto& counts : *block_counts) {
+      for (int p = 0; p < num_partitions_; p++) {
+        partition_count[p] += counts[p];
+      }
     }
 
     // Allocate output tensors of the right size
@@ -79,6 +137,10 @@ class DynamicPartitionOp_Shared : public OpKernel {
   }
 
  protected:
+  // Minimum number of partition ids each block of the two-phase parallel path
+  // should process; below this the sharding overhead dominates.
+  static constexpr int64_t kMinElementsPerBlock = 1 << 14;
+
   int num_partitions_;
 };
 
@@ -91,13 +153,32 @@ class DynamicPartitionOp : public DynamicPartitionOp_Shared {
     const Tensor* data;
     const Tensor* partitions;
     OpOutputList outputs;
-    ValidateAndAllocateOutputs(c, &data, &partitions, &outputs);
+    std::vector<gtl::InlinedVector<int64_t, 32>> block_counts;
+    int64_t block_size = 0;
+    ValidateAndAllocateOutputs(c, &data, &partitions, &outputs, &block_counts,
+                               &block_size);
     if (!c->status().ok()) return;
     if (num_partitions_ == 0 || data->NumElements() == 0) return;
 
     auto e_partitions = partitions->flat<int32>();
     const int64_t N = e_partitions.dimension(0);
-    gtl::InlinedVector<int, 32> output_index(num_partitions_);
+    const int64_t num_blocks = block_counts.size();
+
+    // Phase two: each block scatters its elements starting at per-partition
+    // offsets obtained by an exclusive scan of the block counts, so the blocks
+    // write disjoint ranges of every output. A block records the first index
+    // at which the partition ids no longer match the counting phase (which can
+    // only happen if the input was asynchronously overwritten).
+    std::vector<gtl::InlinedVector<int64_t, 32>> block_offsets(
+        num_blocks, gtl::InlinedVector<int64_t, 32>(num_partitions_));
+    gtl::InlinedVector<int64_t, 32> running(num_partitions_);
+    for (int64_t b = 0; b < num_blocks; ++b) {
+      for (int p = 0; p < num_partitions_; p++) {
+        block_offsets[b][p] = running[p];
+        running[p] += block_counts[b][p];
+      }
+    }
+    std::vector<int64_t> invalid_index(num_blocks, -1);
 
     if (partitions->dims() == data->dims()) {
       // Walk through data and copy the data to the appropriate output tensor
@@ -109,18 +190,29 @@ class DynamicPartitionOp : public DynamicPartitionOp_Shared {
       for (int p = 0; p < num_partitions_; p++) {
         out_vec.push_back(outputs[p]->vec<T>());
       }
-      for (int64_t i = 0; i < N; i++) {
-        const int32_t p = internal::SubtleMustCopy(e_partitions(i));
-        OP_REQUIRES(
-            c, FastBoundsCheck(p, num_partitions_),
-            errors::InvalidArgument("indices[", i, "] is out of range"));
-        auto oi = output_index[p];
-        OP_REQUIRES(c, FastBoundsCheck(oi, out_vec[p].size()),
-                    errors::InvalidArgument(
-                        "out_vec[", p, "] size: ", out_vec[p].size(),
-                        " is not LTE output_index[", p, "] : ", oi));
-        out_vec[p](oi) = data_flat(i);
-        output_index[p]++;
+      auto copy_blocks = [&](int64_t begin, int64_t end) {
+        for (int64_t b = begin; b < end; ++b) {
+          gtl::InlinedVector<int64_t, 32> output_index(block_offsets[b]);
+          const int64_t block_begin = b * block_size;
+          const int64_t block_end = std::min(block_begin + block_size, N);
+          for (int64_t i = block_begin; i < block_end; ++i) {
+            const int32_t p = internal::SubtleMustCopy(e_partitions(i));
+            if (!FastBoundsCheck(p, num_partitions_) ||
+                !FastBoundsCheck(output_index[p], out_vec[p].size())) {
+              invalid_index[b] = i;
+              break;
+            }
+            out_vec[p](output_index[p]) = data_flat(i);
+            output_index[p]++;
+          }
+        }
+      };
+      if (num_blocks == 1) {
+        copy_blocks(0, 1);
+      } else {
+        auto* worker_threads = c->device()->tensorflow_cpu_worker_threads();
+        Shard(worker_threads->num_threads, worker_threads->workers, num_blocks,
+              block_size, copy_blocks);
       }
     } else {
       // If data has extra dimensions, use Eigen slices
@@ -136,25 +228,45 @@ class DynamicPartitionOp : public DynamicPartitionOp_Shared {
       const int64_t slice_size = data->NumElements() / N;
       const auto data_flat = data->shaped<T, 2>({N, slice_size});
       Eigen::DSizes<Eigen::DenseIndex, 2> sizes(1, slice_size);
-      for (int64_t i = 0; i < N; i++) {
-        // outputs[p][output_index[p]++] = data[i]
-        const int32_t p = internal::SubtleMustCopy(e_partitions(i));
-        OP_REQUIRES(
-            c, FastBoundsCheck(p, num_partitions_),
-            errors::InvalidArgument("indices[", i,
-                                    "] has been asynchronously overwritten and "
-                                    "is no longer in range!"));
-        auto oi = output_index[p];
-        OP_REQUIRES(c, FastBoundsCheck(oi, out_flat[p].dimension(0)),
-                    errors::InvalidArgument("Size of output_index: ", oi,
-                                            " is no longer in range."));
-        Eigen::DSizes<Eigen::DenseIndex, 2> out_indices(oi, 0);
-        Eigen::DSizes<Eigen::DenseIndex, 2> data_indices(i, 0);
-        out_flat[p].slice(out_indices, sizes) =
-            data_flat.slice(data_indices, sizes);
-        output_index[p]++;
+      auto copy_blocks = [&](int64_t begin, int64_t end) {
+        for (int64_t b = begin; b < end; ++b) {
+          gtl::InlinedVector<int64_t, 32> output_index(block_offsets[b]);
+          const int64_t block_begin = b * block_size;
+          const int64_t block_end = std::min(block_begin + block_size, N);
+          for (int64_t i = block_begin; i < block_end; ++i) {
+            // outputs[p][output_index[p]++] = data[i]
+            const int32_t p = internal::SubtleMustCopy(e_partitions(i));
+            if (!FastBoundsCheck(p, num_partitions_) ||
+                !FastBoundsCheck(output_index[p], out_flat[p].dimension(0))) {
+              invalid_index[b] = i;
+              break;
+            }
+            Eigen::DSizes<Eigen::DenseIndex, 2> out_indices(output_index[p],
+                                                            0);
+            Eigen::DSizes<Eigen::DenseIndex, 2> data_indices(i, 0);
+            out_flat[p].slice(out_indices, sizes) =
+                data_flat.slice(data_indices, sizes);
+            output_index[p]++;
+          }
+        }
+      };
+      if (num_blocks == 1) {
+        copy_blocks(0, 1);
+      } else {
+        auto* worker_threads = c->device()->tensorflow_cpu_worker_threads();
+        // Account for the cost of copying a slice per partition id.
+        Shard(worker_threads->num_threads, worker_threads->workers, num_blocks,
+              block_size * slice_size, copy_blocks);
       }
     }
+
+    for (int64_t b = 0; b < num_blocks; ++b) {
+      OP_REQUIRES(c, invalid_index[b] < 0,
+                  errors::InvalidArgument(
+                      "indices[", invalid_index[b],
+                      "] has been asynchronously overwritten and "
+                      "is no longer in range!"));
+    }
   }
 };
 
@@ -0,0 +1,203 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// CPU kernel for the _FusedAttention op, which computes
+// softmax(scale * query x key^T) x value without materializing the full
+// score matrix. Keys are processed in tiles with an online softmax, keeping
+// the working set per query block at O(tile size) instead of O(seq_k).
+
+#define EIGEN_USE_THREADS
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "Eigen/Core"  // from @eigen_archive
+#include "tensorflow/core/framework/op_kernel.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/lib/core/errors.h"
+#include "tensorflow/core/util/work_sharder.h"
+
+namespace tensorflow {
+
+namespace {
+
+// Tile sizes for query rows and key columns. Chosen so that a
+// kQueryBlock x kKeyBlock score tile plus the key and value tiles stay
+// comfortably within the L2 cache for typical head dimensions (64-128).
+constexpr int64_t kQueryBlock = 64;
+constexpr int64_t kKeyBlock = 128;
+
+using Matrix =
+    Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+using ConstMatrixMap = Eigen::Map<const Matrix>;
+using MatrixMap = Eigen::Map<Matrix>;
+
+// Computes attention for one [seq_q, head_dim] query slab against the
+// corresponding key and value slabs. `key` is [seq_k, head_dim] if
+// `transpose_key`, else [head_dim, seq_k].
+void ComputeAttentionSlab(const ConstMatrixMap& query,
+                          const ConstMatrixMap& key,
+                          const ConstMatrixMap& value, float scale,
+                          bool transpose_key, MatrixMap output) {
+  const int64_t seq_q = query.rows();
+  const int64_t seq_k = transpose_key ? key.rows() : key.cols();
+
+  Eigen::VectorXf row_max(kQueryBlock);
+  Eigen::VectorXf row_sum(kQueryBlock);
+  Matrix scores(kQueryBlock, kKeyBlock);
+
+  for (int64_t q_start = 0; q_start < seq_q; q_start += kQueryBlock) {
+    const int64_t q_rows = std::min(kQueryBlock, seq_q - q_start);
+    auto query_block = query.middleRows(q_start, q_rows);
+    auto output_block = output.middleRows(q_start, q_rows);
+    output_block.setZero();
+    row_max.head(q_rows).setConstant(-std::numeric_limits<float>::infinity());
+    row_sum.head(q_rows).setZero();
+
+    for (int64_t k_start = 0; k_start < seq_k; k_start += kKeyBlock) {
+      const int64_t k_cols = std::min(kKeyBlock, seq_k - k_start);
+      auto score_block = scores.topLeftCorner(q_rows, k_cols);
+      if (transpose_key) {
+        score_block.noalias() =
+            scale * (query_block * key.middleRows(k_start, k_cols).transpose());
+      } else {
+        score_block.noalias() =
+            scale * (query_block * key.middleCols(k_start, k_cols));
+      }
+
+      for (int64_t r = 0; r < q_rows; ++r) {
+        const float block_max = score_block.row(r).maxCoeff();
+        const float new_max = std::max(row_max(r), block_max);
+        const float correction = std::exp(row_max(r) - new_max);
+        score_block.row(r) = (score_block.row(r).array() - new_max).exp();
+        row_sum(r) = row_sum(r) * correction + score_block.row(r).sum();
+        output_block.row(r) *= correction;
+        row_max(r) = new_max;
+      }
+      output_block.noalias() +=
+          score_block * value.middleRows(k_start, k_cols);
+    }
+
+    for (int64_t r = 0; r < q_rows; ++r) {
+      output_block.row(r) /= row_sum(r);
+    }
+  }
+}
+
+}  // namespace
+
+class FusedAttentionOp : public OpKernel {
+ public:
+  explicit FusedAttentionOp(OpKernelConstruction* context)
+      : OpKernel(context) {
+    OP_REQUIRES_OK(context, context->GetAttr("scale", &scale_));
+    OP_REQUIRES_OK(context, context->GetAttr("transpose_key", &transpose_key_));
+  }
+
+  void Compute(OpKernelContext* context) override {
+    const Tensor& query = context->input(0);
+    const Tensor& key = context->input(1);
+    const Tensor& value = context->input(2);
+
+    OP_REQUIRES(context,
+                query.dims() >= 2 && key.dims() == query.dims() &&
+                    value.dims() == query.dims(),
+                errors::InvalidArgument(
+                    "query, key and value must have the same rank >= 2, got ",
+                    query.dims(), ", ", key.dims(), " and ", value.dims()));
+    const int64_t seq_q = query.dim_size(query.dims() - 2);
+    const int64_t head_dim = query.dim_size(query.dims() - 1);
+    const int64_t seq_k = transpose_key_ ? key.dim_size(key.dims() - 2)
+                                         : key.dim_size(key.dims() - 1);
+    const int64_t key_head_dim = transpose_key_
+                                     ? key.dim_size(key.dims() - 1)
+                                     : key.dim_size(key.dims() - 2);
+    const int64_t value_dim = value.dim_size(value.dims() - 1);
+    OP_REQUIRES(context, key_head_dim == head_dim,
+                errors::InvalidArgument("query and key have incompatible "
+                                        "head dimensions: ",
+                                        head_dim, " vs. ", key_head_dim));
+    OP_REQUIRES(
+        context, value.dim_size(value.dims() - 2) == seq_k,
+        errors::InvalidArgument("key and value have incompatible sequence "
+                                "lengths: ",
+                                seq_k, " vs. ",
+                                value.dim_size(value.dims() - 2)));
+
+    int64_t batch = 1;
+    for (int d = 0; d < query.dims() - 2; ++d) {
+      OP_REQUIRES(context,
+                  key.dim_size(d) == query.dim_size(d) &&
+                      value.dim_size(d) == query.dim_size(d),
+                  errors::InvalidArgument(
+                      "query, key and value must have identical batch "
+                      "dimensions, got shapes ",
+                      query.shape().DebugString(), ", ",
+                      key.shape().DebugString(), " and ",
+                      value.shape().DebugString()));
+      batch *= query.dim_size(d);
+    }
+
+    TensorShape output_shape = query.shape();
+    output_shape.set_dim(output_shape.dims() - 1, value_dim);
+    Tensor* output = nullptr;
+    OP_REQUIRES_OK(context,
+                   context->allocate_output(0, output_shape, &output));
+    if (output->NumElements() == 0) return;
+
+    const float* query_data = query.flat<float>().data();
+    const float* key_data = key.flat<float>().data();
+    const float* value_data = value.flat<float>().data();
+    float* output_data = output->flat<float>().data();
+    const int64_t query_slab = seq_q * head_dim;
+    const int64_t key_slab = seq_k * head_dim;
+    const int64_t value_slab = seq_k * value_dim;
+    const int64_t output_slab = seq_q * value_dim;
+    const float scale = scale_;
+    const bool transpose_key = transpose_key_;
+
+    auto worker_threads = context->device()->tensorflow_cpu_worker_threads();
+    const int64_t cost_per_slab = seq_q * seq_k * (head_dim + value_dim);
+    Shard(worker_threads->num_threads, worker_threads->workers, batch,
+          cost_per_slab, [&](int64_t start, int64_t limit) {
+            for (int64_t b = start; b < limit; ++b) {
+              ConstMatrixMap query_slab_map(query_data + b * query_slab, seq_q,
+                                            head_dim);
+              ConstMatrixMap key_slab_map(
+                  key_data + b * key_slab, transpose_key ? seq_k : head_dim,
+                  transpose_key ? head_dim : seq_k);
+              ConstMatrixMap value_slab_map(value_data + b * value_slab, seq_k,
+                                            value_dim);
+              MatrixMap output_slab_map(output_data + b * output_slab, seq_q,
+                                        value_dim);
+              ComputeAttentionSlab(query_slab_map, key_slab_map,
+                                   value_slab_map, scale, transpose_key,
+                                   output_slab_map);
+            }
+          });
+  }
+
+ private:
+  float scale_;
+  bool transpose_key_;
+};
+
+REGISTER_KERNEL_BUILDER(
+    Name("_FusedAttention").Device(DEVICE_CPU).TypeConstraint<float>("T"),
+    FusedAttentionOp);
+
+}  // namespace tensorflow
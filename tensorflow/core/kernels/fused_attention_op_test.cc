@@ -0,0 +1,163 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "tensorflow/core/framework/fake_input.h"
+#include "tensorflow/core/framework/node_def_builder.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_testutil.h"
+#include "tensorflow/core/framework/types.h"
+#include "tensorflow/core/kernels/ops_testutil.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace {
+
+class FusedAttentionOpTest : public OpsTestBase {
+ protected:
+  void MakeOp(float scale, bool transpose_key) {
+    TF_ASSERT_OK(NodeDefBuilder("fused_attention", "_FusedAttention")
+                     .Input(FakeInput(DT_FLOAT))
+                     .Input(FakeInput(DT_FLOAT))
+                     .Input(FakeInput(DT_FLOAT))
+                     .Attr("scale", scale)
+                     .Attr("transpose_key", transpose_key)
+                     .Finalize(node_def()));
+    TF_ASSERT_OK(InitOp());
+  }
+
+  // Reference softmax(scale * Q K^T) V with full score materialization, for
+  // one batch of `seq_q` x `head_dim` queries against `seq_k` keys. `key` is
+  // in [seq_k, head_dim] layout.
+  static std::vector<float> ReferenceAttention(
+      const std::vector<float>& query, const std::vector<float>& key,
+      const std::vector<float>& value, int64_t seq_q, int64_t seq_k,
+      int64_t head_dim, int64_t value_dim, float scale) {
+    std::vector<float> output(seq_q * value_dim, 0.0f);
+    for (int64_t i = 0; i < seq_q; ++i) {
+      std::vector<float> scores(seq_k);
+      float max_score = -std::numeric_limits<float>::infinity();
+      for (int64_t j = 0; j < seq_k; ++j) {
+        float dot = 0.0f;
+        for (int64_t d = 0; d < head_dim; ++d) {
+          dot += query[i * head_dim + d] * key[j * head_dim + d];
+        }
+        scores[j] = scale * dot;
+        max_score = std::max(max_score, scores[j]);
+      }
+      float sum = 0.0f;
+      for (int64_t j = 0; j < seq_k; ++j) {
+        scores[j] = std::exp(scores[j] - max_score);
+        sum += scores[j];
+      }
+      for (int64_t j = 0; j < seq_k; ++j) {
+        for (int64_t d = 0; d < value_dim; ++d) {
+          output[i * value_dim + d] +=
+              scores[j] / sum * value[j * value_dim + d];
+        }
+      }
+    }
+    return output;
+  }
+};
+
+TEST_F(FusedAttentionOpTest, MatchesReference) {
+  // Sequence lengths straddle the kernel's internal tile sizes so the online
+  // softmax spans multiple key tiles and a ragged final tile.
+  constexpr int64_t kSeqQ = 70;
+  constexpr int64_t kSeqK = 260;
+  constexpr int64_t kHeadDim = 16;
+  constexpr float kScale = 0.25f;
+  MakeOp(kScale, /*transpose_key=*/true);
+
+  std::vector<float> query(kSeqQ * kHeadDim);
+  std::vector<float> key(kSeqK * kHeadDim);
+  std::vector<float> value(kSeqK * kHeadDim);
+  for (size_t i = 0; i < query.size(); ++i) {
+    query[i] = std::sin(0.1f * i);
+  }
+  for (size_t i = 0; i < key.size(); ++i) {
+    key[i] = std::cos(0.05f * i);
+    value[i] = std::sin(0.02f * i + 1.0f);
+  }
+
+  AddInputFromArray<float>(TensorShape({1, kSeqQ, kHeadDim}), query);
+  AddInputFromArray<float>(TensorShape({1, kSeqK, kHeadDim}), key);
+  AddInputFromArray<float>(TensorShape({1, kSeqK, kHeadDim}), value);
+  TF_ASSERT_OK(RunOpKernel());
+
+  std::vector<float> expected = ReferenceAttention(
+      query, key, value, kSeqQ, kSeqK, kHeadDim, kHeadDim, kScale);
+  Tensor expected_tensor(DT_FLOAT, TensorShape({1, kSeqQ, kHeadDim}));
+  std::copy(expected.begin(), expected.end(),
+            expected_tensor.flat<float>().data());
+  test::ExpectTensorNear<float>(expected_tensor, *GetOutput(0), 1e-5);
+}
+
+TEST_F(FusedAttentionOpTest, UntransposedKeyLayout) {
+  constexpr int64_t kSeqQ = 3;
+  constexpr int64_t kSeqK = 5;
+  constexpr int64_t kHeadDim = 4;
+  constexpr float kScale = 0.5f;
+  MakeOp(kScale, /*transpose_key=*/false);
+
+  std::vector<float> query(kSeqQ * kHeadDim);
+  std::vector<float> key(kSeqK * kHeadDim);
+  std::vector<float> value(kSeqK * kHeadDim);
+  for (size_t i = 0; i < query.size(); ++i) query[i] = 0.3f * i - 1.0f;
+  for (size_t i = 0; i < key.size(); ++i) key[i] = 0.1f * i;
+  for (size_t i = 0; i < value.size(); ++i) value[i] = 0.2f * i - 2.0f;
+
+  // The op expects [head_dim, seq_k] layout when transpose_key is false.
+  std::vector<float> key_transposed(key.size());
+  for (int64_t j = 0; j < kSeqK; ++j) {
+    for (int64_t d = 0; d < kHeadDim; ++d) {
+      key_transposed[d * kSeqK + j] = key[j * kHeadDim + d];
+    }
+  }
+
+  // Duplicate each input along a leading batch dimension of two.
+  std::vector<float> batched_query(query);
+  batched_query.insert(batched_query.end(), query.begin(), query.end());
+  std::vector<float> batched_key(key_transposed);
+  batched_key.insert(batched_key.end(), key_transposed.begin(),
+                     key_transposed.end());
+  std::vector<float> batched_value(value);
+  batched_value.insert(batched_value.end(), value.begin(), value.end());
+
+  AddInputFromArray<float>(TensorShape({2, 1, kSeqQ, kHeadDim}),
+                           batched_query);
+  AddInputFromArray<float>(TensorShape({2, 1, kHeadDim, kSeqK}), batched_key);
+  AddInputFromArray<float>(TensorShape({2, 1, kSeqK, kHeadDim}),
+                           batched_value);
+  TF_ASSERT_OK(RunOpKernel());
+
+  std::vector<float> expected = ReferenceAttention(
+      query, key, value, kSeqQ, kSeqK, kHeadDim, kHeadDim, kScale);
+  Tensor expected_tensor(DT_FLOAT, TensorShape({2, 1, kSeqQ, kHeadDim}));
+  for (int b = 0; b < 2; ++b) {
+    std::copy(expected.begin(), expected.end(),
+              expected_tensor.flat<float>().data() + b * expected.size());
+  }
+  test::ExpectTensorNear<float>(expected_tensor, *GetOutput(0), 1e-5);
+}
+
+}  // namespace
+}  // namespace tensorflow
@@ -118,6 +118,35 @@ struct Elu {
   };
 };
 
+// Applies `GeluExact`, 0.5 * x * (1 + erf(x / sqrt(2))), to the passed input
+// expression.
+struct GeluExact {
+  template <typename XprType>
+  static auto apply(XprType expr) {
+    using Scalar = typename XprType::Scalar;
+    return expr * expr.constant(static_cast<Scalar>(0.5)) *
+           (expr.constant(static_cast<Scalar>(1)) +
+            (expr * expr.constant(static_cast<Scalar>(0.7071067811865476)))
+                .erf());
+  };
+};
+
+// Applies `GeluApproximate`,
+// 0.5 * x * (1 + tanh(sqrt(2 / pi) * (x + 0.044715 * x^3))), to the passed
+// input expression.
+struct GeluApproximate {
+  template <typename XprType>
+  static auto apply(XprType expr) {
+    using Scalar = typename XprType::Scalar;
+    return expr * expr.constant(static_cast<Scalar>(0.5)) *
+           (expr.constant(static_cast<Scalar>(1)) +
+            ((expr + expr * expr * expr *
+                         expr.constant(static_cast<Scalar>(0.044715))) *
+             expr.constant(static_cast<Scalar>(0.7978845608028654)))
+                .tanh());
+  };
+};
+
 // Applies `LeakyRelu` to the passed input expression.
 struct LeakyRelu {
   template <typename XprType>
@@ -143,7 +172,9 @@ struct BiasAddArgs {
            fusion == FusedComputationType::kBiasAddWithRelu ||
            fusion == FusedComputationType::kBiasAddWithRelu6 ||
            fusion == FusedComputationType::kBiasAddWithElu ||
-           fusion == FusedComputationType::kBiasAddWithLeakyRelu;
+           fusion == FusedComputationType::kBiasAddWithLeakyRelu ||
+           fusion == FusedComputationType::kBiasAddWithGeluApproximate ||
+           fusion == FusedComputationType::kBiasAddWithGeluExact;
   }
 };
 
@@ -360,6 +391,10 @@ using WithBiasAddAndElu = BiasAddOutputKernel<T, Elu>;
 template <typename T>
 using WithBiasAddAndLeakyRelu = BiasAddOutputKernel<T, LeakyRelu>;
 template <typename T>
+using WithBiasAddAndGeluExact = BiasAddOutputKernel<T, GeluExact>;
+template <typename T>
+using WithBiasAddAndGeluApproximate = BiasAddOutputKernel<T, GeluApproximate>;
+template <typename T>
 using WithFusedBatchNorm = FusedBatchNormOutputKernel<T>;
 template <typename T>
 using WithFusedBatchNormAndRelu = FusedBatchNormOutputKernel<T, Relu>;
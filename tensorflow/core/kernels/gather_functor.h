@@ -16,6 +16,8 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_KERNELS_GATHER_FUNCTOR_H_
 #define TENSORFLOW_CORE_KERNELS_GATHER_FUNCTOR_H_
 
+#include <algorithm>
+
 #include "unsupported/Eigen/CXX11/Tensor"  // from @eigen_archive
 
 #include "tensorflow/core/framework/bounds_check.h"
@@ -52,6 +54,16 @@ SliceIndex HandleCopies(OpKernelContext* ctx,
   }
   // Compute slice_bytes here so that static knowledge is available
   const size_t slice_bytes = slice_elems * sizeof(T);
+  // Random-access gathers (e.g. embedding lookups) are bound by DRAM latency,
+  // and the one-iteration-ahead prefetch below does not cover a full memory
+  // round trip while one short row is copied. Also prefetch the row
+  // kPrefetchDistance iterations ahead, so that its cache lines are already
+  // in flight when the intervening rows have been copied.
+  constexpr SliceIndex kPrefetchDistance = 8;
+  constexpr size_t kCacheLineBytes = 64;
+  // Cap the lines prefetched per row; for very wide rows the copy itself is
+  // long enough to hide the latency of the remaining lines.
+  const size_t prefetch_row_bytes = std::min<size_t>(slice_bytes, 1024);
   auto* worker_threads = ctx->device()->tensorflow_cpu_worker_threads();
   mutex mu;
   // Store the value of invalidate index for printing error information, it's a
@@ -84,6 +96,19 @@ SliceIndex HandleCopies(OpKernelContext* ctx,
         port::prefetch<port::PREFETCH_HINT_T0>(&out(b_next, 0, 0));
         i_next = 0;
       }
+      if (is_simple_type<T>::value) {
+        const SliceIndex i_ahead = indices_idx + kPrefetchDistance;
+        if (i_ahead < indices_size) {
+          // The index is not bounds checked yet; prefetching a wild address
+          // is architecturally harmless and validation happens when the row
+          // is copied.
+          const char* row_ahead = reinterpret_cast<const char*>(
+              &params(batch_idx, indices(i_ahead), 0));
+          for (size_t b = 0; b < prefetch_row_bytes; b += kCacheLineBytes) {
+            port::prefetch<port::PREFETCH_HINT_T0>(row_ahead + b);
+          }
+        }
+      }
       // Copy using memcpy if possible, otherwise an Eigen loop
       // TODO(cwhipkey): avoid linking to framework to get Allocator (to improve
       // ahead-of-time compilation binary size).
@@ -139,10 +164,19 @@ struct GatherFunctorCPU {
     }                                                                      \
   } while (0)
 
+    // 64/128/256 are common embedding widths; static knowledge of the slice
+    // size lets the compiler emit a vectorized fixed-size copy instead of a
+    // generic memcpy.
     if (slice_size == 10)
       CALL(10);
     else if (slice_size == 20)
       CALL(20);
+    else if (slice_size == 64)
+      CALL(64);
+    else if (slice_size == 128)
+      CALL(128);
+    else if (slice_size == 256)
+      CALL(256);
     else
       CALL(-1);
 #undef CALL
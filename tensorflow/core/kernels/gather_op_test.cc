@@ -148,6 +148,38 @@ TEST_F(GatherOpTest, Simple_TwoD64) {
   test::ExpectTensorEqual<float>(expected, *GetOutput(0));
 }
 
+TEST_F(GatherOpTest, EmbeddingWidth64) {
+  MakeOp(DT_FLOAT, DT_INT32);
+
+  // A 64-float row hits the fixed-width copy specialization, and more
+  // indices than the prefetch distance exercises the deep prefetch pipeline.
+  const int kRows = 16;
+  const int kWidth = 64;
+  std::vector<float> params(kRows * kWidth);
+  for (int i = 0; i < static_cast<int>(params.size()); ++i) {
+    params[i] = static_cast<float>(i);
+  }
+  const std::vector<int32> indices = {3, 0, 15, 7,  3, 9, 1,  14, 2,
+                                      8, 5, 11, 0,  13, 6, 10, 4,  12};
+  AddInputFromArray<float>(TensorShape({kRows, kWidth}), params);
+  AddInputFromArray<int32>(TensorShape({static_cast<int64_t>(indices.size())}),
+                           indices);
+  AddInputFromArray<int32>(TensorShape({}), {0});
+  TF_ASSERT_OK(RunOpKernel());
+
+  // Check the output.
+  Tensor expected(allocator(), DT_FLOAT,
+                  TensorShape({static_cast<int64_t>(indices.size()), kWidth}));
+  std::vector<float> expected_values(indices.size() * kWidth);
+  for (int i = 0; i < static_cast<int>(indices.size()); ++i) {
+    for (int j = 0; j < kWidth; ++j) {
+      expected_values[i * kWidth + j] = params[indices[i] * kWidth + j];
+    }
+  }
+  test::FillValues<float>(&expected, expected_values);
+  test::ExpectTensorEqual<float>(expected, *GetOutput(0));
+}
+
 TEST_F(GatherOpTest, HighRank) {
   MakeOp(DT_FLOAT, DT_INT32);
 
@@ -23,10 +23,18 @@ limitations under the License.
 #include "tensorflow/core/kernels/image/resize_bilinear_op.h"
 
 #ifdef __SSE4_1__
+#include <smmintrin.h>
 #include <xmmintrin.h>
 #endif
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#endif
 
+#include <cstring>
+#include <map>
 #include <memory>
+#include <tuple>
+#include <vector>
 
 #include "unsupported/Eigen/CXX11/Tensor"  // from @eigen_archive
 #include "tensorflow/core/framework/op_kernel.h"
@@ -37,6 +45,7 @@ limitations under the License.
 #include "tensorflow/core/kernels/cast_op.h"
 #include "tensorflow/core/lib/core/status.h"
 #include "tensorflow/core/platform/logging.h"
+#include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/util/image_resizer_state.h"
 
 namespace tensorflow {
@@ -105,6 +114,59 @@ inline void compute_interpolation_weights(const Scaler scaler,
   }
 }
 
+// Upper bound on the number of weight tables kept alive in the cross-call
+// cache below. Input pipelines typically resize to a handful of target sizes,
+// so the cache is cleared in the unlikely event that it fills up.
+constexpr int kMaxCachedWeightTables = 64;
+
+// Returns the interpolation weight table for one dimension, sharing tables
+// across calls. Pipelines that resize many images to the same target size
+// (e.g. video frames) recompute identical tables on every call otherwise. The
+// table is keyed by the full resize geometry; `channel_stride` folds the
+// channel scaling of the x dimension into the cached entries, so the shared
+// table is never mutated after construction.
+std::shared_ptr<const std::vector<CachedInterpolation>>
+GetOrComputeInterpolationWeights(const int64_t out_size, const int64_t in_size,
+                                 const float scale,
+                                 const bool half_pixel_centers,
+                                 const int64_t channel_stride) {
+  using Table = std::vector<CachedInterpolation>;
+  using Key = std::tuple<int64_t, int64_t, uint32, bool, int64_t>;
+  static mutex* mu = new mutex;
+  static auto* cache = new std::map<Key, std::shared_ptr<const Table>>;
+
+  uint32 scale_bits;
+  memcpy(&scale_bits, &scale, sizeof(scale_bits));
+  const Key key(out_size, in_size, scale_bits, half_pixel_centers,
+                channel_stride);
+  {
+    mutex_lock l(*mu);
+    auto it = cache->find(key);
+    if (it != cache->end()) return it->second;
+  }
+
+  auto table = std::make_shared<Table>(out_size + 1);
+  if (half_pixel_centers) {
+    compute_interpolation_weights(HalfPixelScaler(), out_size, in_size, scale,
+                                  table->data());
+  } else {
+    compute_interpolation_weights(LegacyScaler(), out_size, in_size, scale,
+                                  table->data());
+  }
+  if (channel_stride != 1) {
+    for (CachedInterpolation& entry : *table) {
+      entry.lower *= channel_stride;
+      entry.upper *= channel_stride;
+    }
+  }
+
+  mutex_lock l(*mu);
+  if (cache->size() >= kMaxCachedWeightTables) cache->clear();
+  auto& slot = (*cache)[key];
+  if (slot == nullptr) slot = std::move(table);
+  return slot;
+}
+
 /**
  * Computes the bilinear interpolation from the appropriate 4 float points
  * and the linear interpolation weights.
@@ -170,6 +232,22 @@ inline __m128 load_3xfloat_v(float* values) {
   return _mm_loadu_ps(values);
 }
 
+template <>
+inline __m128 load_3xfloat_v(const float* values) {
+  return _mm_loadu_ps(values);
+}
+
+// Packs the 3 bytes into one lane each and converts with a single vector
+// instruction, instead of three scalar int-to-float conversions. Composing
+// the lanes from byte loads avoids reading past the end of the input.
+template <>
+inline __m128 load_3xfloat_v(const uint8* values) {
+  const uint32 packed = static_cast<uint32>(values[0]) |
+                        (static_cast<uint32>(values[1]) << 8) |
+                        (static_cast<uint32>(values[2]) << 16);
+  return _mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(packed)));
+}
+
 template <typename T>
 void ResizeLine3ChannelsVector(const T* const ys_input_lower_ptr,
                                const T* const ys_input_upper_ptr,
@@ -201,16 +279,74 @@ void ResizeLine3ChannelsVector(const T* const ys_input_lower_ptr,
 }
 #endif
 
+#if defined(__AVX2__) && defined(__FMA__)
+/* 8-wide version of compute_lerp_v using fused multiply-add. */
+inline __m256 compute_lerp_v(const __m256 top_left, const __m256 top_right,
+                             const __m256 bottom_left,
+                             const __m256 bottom_right, const __m256 x_lerp,
+                             const __m256 y_lerp) {
+  const __m256 top =
+      _mm256_fmadd_ps(_mm256_sub_ps(top_right, top_left), x_lerp, top_left);
+  const __m256 bottom = _mm256_fmadd_ps(_mm256_sub_ps(bottom_right, bottom_left),
+                                        x_lerp, bottom_left);
+  return _mm256_fmadd_ps(_mm256_sub_ps(bottom, top), y_lerp, top);
+}
+
+// Interpolates the same output pixel of two output rows per iteration, with
+// one row in each 128-bit lane. The two rows share the x weight loads and
+// broadcasts, and the independent lerp chains keep the FMA units busy.
+template <typename T>
+void ResizeLinePair3ChannelsVector(
+    const T* const y0_input_lower_ptr, const T* const y0_input_upper_ptr,
+    const float y0_lerp, const T* const y1_input_lower_ptr,
+    const T* const y1_input_upper_ptr, const float y1_lerp,
+    const CachedInterpolation* const xs, const int64_t out_width,
+    float* out_y0, float* out_y1) {
+  const __m256 ys_lerp_v =
+      _mm256_set_m128(_mm_set1_ps(y1_lerp), _mm_set1_ps(y0_lerp));
+  // As in the single-row kernel, the 4-float stores may overflow a 3-channel
+  // pixel, so the last pixel of each row is handled separately.
+  for (int64_t x = 0; x < out_width - 1; ++x) {
+    const int64_t xs_lower = xs[x].lower;
+    const int64_t xs_upper = xs[x].upper;
+    const __m256 xs_lerp_v = _mm256_set1_ps(xs[x].lerp);
+
+    const __m256 top_left_v =
+        _mm256_set_m128(load_3xfloat_v(y1_input_lower_ptr + xs_lower),
+                        load_3xfloat_v(y0_input_lower_ptr + xs_lower));
+    const __m256 top_right_v =
+        _mm256_set_m128(load_3xfloat_v(y1_input_lower_ptr + xs_upper),
+                        load_3xfloat_v(y0_input_lower_ptr + xs_upper));
+    const __m256 bottom_left_v =
+        _mm256_set_m128(load_3xfloat_v(y1_input_upper_ptr + xs_lower),
+                        load_3xfloat_v(y0_input_upper_ptr + xs_lower));
+    const __m256 bottom_right_v =
+        _mm256_set_m128(load_3xfloat_v(y1_input_upper_ptr + xs_upper),
+                        load_3xfloat_v(y0_input_upper_ptr + xs_upper));
+
+    const __m256 result =
+        compute_lerp_v(top_left_v, top_right_v, bottom_left_v, bottom_right_v,
+                       xs_lerp_v, ys_lerp_v);
+    _mm_storeu_ps(out_y0 + x * 3, _mm256_castps256_ps128(result));
+    _mm_storeu_ps(out_y1 + x * 3, _mm256_extractf128_ps(result, 1));
+  }
+  ResizeLineChannels(y0_input_lower_ptr, y0_input_upper_ptr, xs + out_width - 1,
+                     y0_lerp, 1, out_y0 + (out_width - 1) * 3, 3);
+  ResizeLineChannels(y1_input_lower_ptr, y1_input_upper_ptr, xs + out_width - 1,
+                     y1_lerp, 1, out_y1 + (out_width - 1) * 3, 3);
+}
+#endif
+
 template <typename T>
 void resize_image(
-    typename TTypes<T, 4>::ConstTensor images, const int batch_size,
-    const int64_t in_height, const int64_t in_width, const int64_t out_height,
-    const int64_t out_width, const int channels,
+    const CPUDevice& d, typename TTypes<T, 4>::ConstTensor images,
+    const int batch_size, const int64_t in_height, const int64_t in_width,
+    const int64_t out_height, const int64_t out_width, const int channels,
     const std::vector<CachedInterpolation>& xs,
     const std::vector<CachedInterpolation>& ys,
     typename TTypes<float, 4>::Tensor output) TF_ATTRIBUTE_NOINLINE;
 template <typename T>
-void resize_image(typename TTypes<T, 4>::ConstTensor images,
+void resize_image(const CPUDevice& d, typename TTypes<T, 4>::ConstTensor images,
                   const int batch_size, const int64_t in_height,
                   const int64_t in_width, const int64_t out_height,
                   const int64_t out_width, const int channels,
@@ -220,41 +356,68 @@ void resize_image(typename TTypes<T, 4>::ConstTensor images,
   const int64_t in_row_size = in_width * channels;
   const int64_t in_batch_num_values = in_height * in_row_size;
   const int64_t out_row_size = out_width * channels;
+  const int64_t out_batch_num_values = out_height * out_row_size;
 
-  const T* input_b_ptr = images.data();
   const CachedInterpolation* xs = xs_vec.data();
 
-  if (channels == 3) {
-    float* output_y_ptr = output.data();
-    for (int b = 0; b < batch_size; ++b) {
-      for (int64_t y = 0; y < out_height; ++y) {
-        const T* ys_input_lower_ptr = input_b_ptr + ys[y].lower * in_row_size;
-        const T* ys_input_upper_ptr = input_b_ptr + ys[y].upper * in_row_size;
+  auto resize_batches = [&](Eigen::Index b_start, Eigen::Index b_end) {
+    const T* input_b_ptr = images.data() + b_start * in_batch_num_values;
+    float* output_y_ptr = output.data() + b_start * out_batch_num_values;
+
+    if (channels == 3) {
+      for (Eigen::Index b = b_start; b < b_end; ++b) {
+        int64_t y = 0;
+#if defined(__AVX2__) && defined(__FMA__)
+        for (; y + 1 < out_height; y += 2) {
+          ResizeLinePair3ChannelsVector(
+              input_b_ptr + ys[y].lower * in_row_size,
+              input_b_ptr + ys[y].upper * in_row_size, ys[y].lerp,
+              input_b_ptr + ys[y + 1].lower * in_row_size,
+              input_b_ptr + ys[y + 1].upper * in_row_size, ys[y + 1].lerp, xs,
+              out_width, output_y_ptr, output_y_ptr + out_row_size);
+          output_y_ptr += 2 * out_row_size;
+        }
+#endif
+        for (; y < out_height; ++y) {
+          const T* ys_input_lower_ptr = input_b_ptr + ys[y].lower * in_row_size;
+          const T* ys_input_upper_ptr = input_b_ptr + ys[y].upper * in_row_size;
 #ifdef __SSE4_1__
-        ResizeLine3ChannelsVector(ys_input_lower_ptr, ys_input_upper_ptr, xs,
-                                  ys[y].lerp, out_width, output_y_ptr);
+          ResizeLine3ChannelsVector(ys_input_lower_ptr, ys_input_upper_ptr, xs,
+                                    ys[y].lerp, out_width, output_y_ptr);
 #else
-        ResizeLineChannels(ys_input_lower_ptr, ys_input_upper_ptr, xs,
-                           ys[y].lerp, out_width, output_y_ptr, 3);
+          ResizeLineChannels(ys_input_lower_ptr, ys_input_upper_ptr, xs,
+                             ys[y].lerp, out_width, output_y_ptr, 3);
 #endif
-        output_y_ptr += out_row_size;
+          output_y_ptr += out_row_size;
+        }
+        input_b_ptr += in_batch_num_values;
       }
-      input_b_ptr += in_batch_num_values;
-    }
-  } else {
-    float* output_y_ptr = output.data();
-    for (int b = 0; b < batch_size; ++b) {
-      for (int64_t y = 0; y < out_height; ++y) {
-        const T* ys_input_lower_ptr = input_b_ptr + ys[y].lower * in_row_size;
-        const T* ys_input_upper_ptr = input_b_ptr + ys[y].upper * in_row_size;
+    } else {
+      for (Eigen::Index b = b_start; b < b_end; ++b) {
+        for (int64_t y = 0; y < out_height; ++y) {
+          const T* ys_input_lower_ptr = input_b_ptr + ys[y].lower * in_row_size;
+          const T* ys_input_upper_ptr = input_b_ptr + ys[y].upper * in_row_size;
 
-        ResizeLineChannels(ys_input_lower_ptr, ys_input_upper_ptr, xs,
-                           ys[y].lerp, out_width, output_y_ptr, channels);
+          ResizeLineChannels(ys_input_lower_ptr, ys_input_upper_ptr, xs,
+                             ys[y].lerp, out_width, output_y_ptr, channels);
 
-        output_y_ptr += out_row_size;
+          output_y_ptr += out_row_size;
+        }
+        input_b_ptr += in_batch_num_values;
       }
-      input_b_ptr += in_batch_num_values;
     }
+  };
+
+  if (batch_size > 1) {
+    // Each batch element is independent, so shard them across the intra-op
+    // pool. Each output value reads four inputs and interpolates them.
+    const Eigen::TensorOpCost cost(
+        /*bytes_loaded=*/out_batch_num_values * sizeof(T) * 4,
+        /*bytes_stored=*/out_batch_num_values * sizeof(float),
+        /*compute_cycles=*/out_batch_num_values * 10);
+    d.parallelFor(batch_size, cost, resize_batches);
+  } else {
+    resize_batches(0, batch_size);
   }
 }
 
@@ -302,30 +465,20 @@ struct ResizeBilinear<CPUDevice, T> {
       return;
     }
 
-    std::vector<CachedInterpolation> ys(out_height + 1);
-    std::vector<CachedInterpolation> xs(out_width + 1);
-
-    // Compute the cached interpolation weights on the x and y dimensions.
-    if (half_pixel_centers) {
-      compute_interpolation_weights(HalfPixelScaler(), out_height, in_height,
-                                    height_scale, ys.data());
-      compute_interpolation_weights(HalfPixelScaler(), out_width, in_width,
-                                    width_scale, xs.data());
-
-    } else {
-      compute_interpolation_weights(LegacyScaler(), out_height, in_height,
-                                    height_scale, ys.data());
-      compute_interpolation_weights(LegacyScaler(), out_width, in_width,
-                                    width_scale, xs.data());
-    }
-    // Scale x interpolation weights to avoid a multiplication during iteration.
-    for (int i = 0; i < xs.size(); ++i) {
-      xs[i].lower *= channels;
-      xs[i].upper *= channels;
-    }
-
-    resize_image<T>(images, batch_size, in_height, in_width, out_height,
-                    out_width, channels, xs, ys, output);
+    // Look up (or compute) the interpolation weight tables for the x and y
+    // dimensions. The x weights are pre-scaled by the channel count to avoid
+    // a multiplication during iteration.
+    std::shared_ptr<const std::vector<CachedInterpolation>> ys =
+        GetOrComputeInterpolationWeights(out_height, in_height, height_scale,
+                                         half_pixel_centers,
+                                         /*channel_stride=*/1);
+    std::shared_ptr<const std::vector<CachedInterpolation>> xs =
+        GetOrComputeInterpolationWeights(out_width, in_width, width_scale,
+                                         half_pixel_centers,
+                                         /*channel_stride=*/channels);
+
+    resize_image<T>(d, images, batch_size, in_height, in_width, out_height,
+                    out_width, channels, *xs, *ys, output);
   }
 };
 }  // namespace functor
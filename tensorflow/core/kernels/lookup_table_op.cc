@@ -16,9 +16,13 @@ limitations under the License.
 #include "tensorflow/core/kernels/lookup_table_op.h"
 #define EIGEN_USE_THREADS
 
+#include <algorithm>
+#include <memory>
+#include <optional>
 #include <string>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "tensorflow/core/framework/register_types.h"
 #include "tensorflow/core/framework/types.h"
@@ -27,6 +31,7 @@ limitations under the License.
 #include "tensorflow/core/lib/gtl/inlined_vector.h"
 #include "tensorflow/core/lib/hash/hash.h"
 #include "tensorflow/core/platform/random.h"
+#include "tensorflow/core/util/env_var.h"
 
 namespace tensorflow {
 namespace lookup {
@@ -36,12 +41,43 @@ std::string UniqueNodeName(const std::string& base) {
   return strings::StrCat(base, "/", counter.fetch_add(1), "/", random::New64());
 }
 
+namespace {
+
+template <typename T>
+inline uint64 HashScalar(const T& key) {
+  return static_cast<uint64>(key);
+}
+
+inline uint64 HashScalar(const tstring& key) { return Hash64(key); }
+
+// Number of independently locked shards backing the mutable hash tables below.
+// Concurrent Find calls only contend on a shard's shared mutex when their keys
+// hash to the same shard, so read throughput scales with the shard count
+// instead of serializing on a single lock word. Configured once per process
+// through TF_MUTABLE_HASH_TABLE_SHARDS; the default of 1 preserves the
+// previous single-table layout.
+int64_t NumTableShards() {
+  static const int64_t num_shards = [] {
+    int64_t value;
+    TF_CHECK_OK(
+        ReadInt64FromEnvVar("TF_MUTABLE_HASH_TABLE_SHARDS", 1, &value));
+    return std::max(int64_t{1}, std::min(value, int64_t{256}));
+  }();
+  return num_shards;
+}
+
+}  // namespace
+
 // Lookup table that wraps an unordered_map, where the key and value data type
 // is specified. Each individual value must be a scalar. If vector values are
 // required, use MutableHashTableOfTensors.
 //
 // This table is mutable and thread safe - Insert can be called at any time.
 //
+// The table is split into NumTableShards() independently locked shards so
+// that concurrent Find calls from different threads do not serialize on a
+// single mutex; see TF_MUTABLE_HASH_TABLE_SHARDS above.
+//
 // Sample use case:
 //
 // MutableHashTableOfScalars<int64, int64> table;  // int64 -> int64.
@@ -53,11 +89,16 @@ std::string UniqueNodeName(const std::string& base) {
 template <class K, class V>
 class MutableHashTableOfScalars final : public LookupInterface {
  public:
-  MutableHashTableOfScalars(OpKernelContext* ctx, OpKernel* kernel) {}
+  MutableHashTableOfScalars(OpKernelContext* ctx, OpKernel* kernel)
+      : num_shards_(NumTableShards()), shards_(new Shard[num_shards_]) {}
 
   size_t size() const override {
-    tf_shared_lock l(mu_);
-    return table_.size();
+    size_t ret = 0;
+    for (int64_t s = 0; s < num_shards_; ++s) {
+      tf_shared_lock l(shards_[s].mu);
+      ret += shards_[s].table.size();
+    }
+    return ret;
   }
 
   Status Find(OpKernelContext* ctx, const Tensor& key, Tensor* value,
@@ -70,33 +111,62 @@ class MutableHashTableOfScalars final : public LookupInterface {
     int64_t default_total = default_flat.size();
     bool is_full_size_default = (total == default_total);
 
-    tf_shared_lock l(mu_);
-    for (int64_t i = 0; i < key_values.size(); ++i) {
-      // is_full_size_default is true:
-      //   Each key has an independent default value, key_values(i)
-      //   corresponding uses default_flat(i) as its default value.
-      //
-      // is_full_size_default is false:
-      //   All keys will share the default_flat(0) as default value.
-      value_values(i) = gtl::FindWithDefault(
-          table_, SubtleMustCopyIfIntegral(key_values(i)),
-          is_full_size_default ? default_flat(i) : default_flat(0));
+    // is_full_size_default is true:
+    //   Each key has an independent default value, key_values(i)
+    //   corresponding uses default_flat(i) as its default value.
+    //
+    // is_full_size_default is false:
+    //   All keys will share the default_flat(0) as default value.
+    if (num_shards_ == 1) {
+      // With a single shard (the default) one shared lock covers the whole
+      // batch, as before.
+      Shard& shard = shards_[0];
+      tf_shared_lock l(shard.mu);
+      for (int64_t i = 0; i < key_values.size(); ++i) {
+        value_values(i) = gtl::FindWithDefault(
+            shard.table, SubtleMustCopyIfIntegral(key_values(i)),
+            is_full_size_default ? default_flat(i) : default_flat(0));
+      }
+    } else {
+      for (int64_t i = 0; i < key_values.size(); ++i) {
+        const K key_value = SubtleMustCopyIfIntegral(key_values(i));
+        Shard& shard = ShardForKey(key_value);
+        tf_shared_lock l(shard.mu);
+        value_values(i) = gtl::FindWithDefault(
+            shard.table, key_value,
+            is_full_size_default ? default_flat(i) : default_flat(0));
+      }
     }
 
     return OkStatus();
   }
 
-  Status DoInsert(bool clear, const Tensor& keys, const Tensor& values) {
+  Status DoInsert(bool clear,
+                  const Tensor& keys,
+                  const Tensor& values) TF_NO_THREAD_SAFETY_ANALYSIS {
     const auto key_values = keys.flat<K>();
     const auto value_values = values.flat<V>();
 
-    mutex_lock l(mu_);
     if (clear) {
-      table_.clear();
-    }
-    for (int64_t i = 0; i < key_values.size(); ++i) {
-      gtl::InsertOrUpdate(&table_, SubtleMustCopyIfIntegral(key_values(i)),
-                          SubtleMustCopyIfIntegral(value_values(i)));
+      // Hold every shard exclusively so that the clear and the re-import
+      // appear atomic to concurrent readers.
+      std::vector<mutex_lock> locks = LockAllExclusive();
+      for (int64_t s = 0; s < num_shards_; ++s) {
+        shards_[s].table.clear();
+      }
+      for (int64_t i = 0; i < key_values.size(); ++i) {
+        const K key_value = SubtleMustCopyIfIntegral(key_values(i));
+        gtl::InsertOrUpdate(&ShardForKey(key_value).table, key_value,
+                            SubtleMustCopyIfIntegral(value_values(i)));
+      }
+    } else {
+      for (int64_t i = 0; i < key_values.size(); ++i) {
+        const K key_value = SubtleMustCopyIfIntegral(key_values(i));
+        Shard& shard = ShardForKey(key_value);
+        mutex_lock l(shard.mu);
+        gtl::InsertOrUpdate(&shard.table, key_value,
+                            SubtleMustCopyIfIntegral(value_values(i)));
+      }
     }
     return OkStatus();
   }
@@ -109,9 +179,11 @@ class MutableHashTableOfScalars final : public LookupInterface {
   Status Remove(OpKernelContext* ctx, const Tensor& keys) override {
     const auto key_values = keys.flat<K>();
 
-    mutex_lock l(mu_);
     for (int64_t i = 0; i < key_values.size(); ++i) {
-      table_.erase(SubtleMustCopyIfIntegral(key_values(i)));
+      const K key_value = SubtleMustCopyIfIntegral(key_values(i));
+      Shard& shard = ShardForKey(key_value);
+      mutex_lock l(shard.mu);
+      shard.table.erase(key_value);
     }
     return OkStatus();
   }
@@ -121,9 +193,10 @@ class MutableHashTableOfScalars final : public LookupInterface {
     return DoInsert(true, keys, values);
   }
 
-  Status ExportValues(OpKernelContext* ctx) override {
-    tf_shared_lock l(mu_);
-    int64_t size = table_.size();
+  Status ExportValues(OpKernelContext* ctx) override
+      TF_NO_THREAD_SAFETY_ANALYSIS {
+    std::vector<tf_shared_lock> locks = LockAllShared();
+    int64_t size = SizeLocked();
 
     Tensor* keys;
     Tensor* values;
@@ -145,21 +218,25 @@ class MutableHashTableOfScalars final : public LookupInterface {
 
   int64_t MemoryUsed() const override {
     int64_t ret = 0;
-    tf_shared_lock l(mu_);
-    for (unsigned i = 0; i < table_.bucket_count(); ++i) {
-      size_t bucket_size = table_.bucket_size(i);
-      if (bucket_size == 0) {
-        ret++;
-      } else {
-        ret += bucket_size;
+    for (int64_t s = 0; s < num_shards_; ++s) {
+      tf_shared_lock l(shards_[s].mu);
+      const auto& table = shards_[s].table;
+      for (unsigned i = 0; i < table.bucket_count(); ++i) {
+        size_t bucket_size = table.bucket_size(i);
+        if (bucket_size == 0) {
+          ret++;
+        } else {
+          ret += bucket_size;
+        }
       }
     }
     return sizeof(MutableHashTableOfScalars) + ret;
   }
 
-  Status AsGraphDef(GraphDefBuilder* builder, Node** out) const override {
-    tf_shared_lock l(mu_);
-    int64_t size = table_.size();
+  Status AsGraphDef(GraphDefBuilder* builder, Node** out) const override
+      TF_NO_THREAD_SAFETY_ANALYSIS {
+    std::vector<tf_shared_lock> locks = LockAllShared();
+    int64_t size = SizeLocked();
     Tensor keys(key_dtype(), TensorShape({size}));
     Tensor values(value_dtype(), TensorShape({size}));
     ExportKeysAndValues(&keys, &values);
@@ -195,21 +272,65 @@ class MutableHashTableOfScalars final : public LookupInterface {
   }
 
  private:
+  // One independently locked hash map. Keys are assigned to shards by
+  // HashScalar, so a batch of lookups only touches the locks of the shards
+  // its keys fall in.
+  struct Shard {
+    mutable mutex mu;
+    std::unordered_map<K, V> table TF_GUARDED_BY(mu);
+  };
+
+  Shard& ShardForKey(const K& key) const {
+    return num_shards_ == 1 ? shards_[0]
+                            : shards_[HashScalar(key) % num_shards_];
+  }
+
+  std::vector<tf_shared_lock> LockAllShared() const {
+    std::vector<tf_shared_lock> locks;
+    locks.reserve(num_shards_);
+    for (int64_t s = 0; s < num_shards_; ++s) {
+      locks.emplace_back(shards_[s].mu);
+    }
+    return locks;
+  }
+
+  std::vector<mutex_lock> LockAllExclusive() const {
+    std::vector<mutex_lock> locks;
+    locks.reserve(num_shards_);
+    for (int64_t s = 0; s < num_shards_; ++s) {
+      locks.emplace_back(shards_[s].mu);
+    }
+    return locks;
+  }
+
+  // Requires all shard locks to be held.
+  int64_t SizeLocked() const TF_NO_THREAD_SAFETY_ANALYSIS {
+    int64_t size = 0;
+    for (int64_t s = 0; s < num_shards_; ++s) {
+      size += shards_[s].table.size();
+    }
+    return size;
+  }
+
   // Writes all keys and values into `keys` and `values`. `keys` and `values`
-  // must point to tensors of size `table_.size()`.
+  // must point to tensors of size `SizeLocked()` and all shard locks must be
+  // held.
   void ExportKeysAndValues(Tensor* keys, Tensor* values) const
-      TF_SHARED_LOCKS_REQUIRED(mu_) {
+      TF_NO_THREAD_SAFETY_ANALYSIS {
     auto keys_data = keys->flat<K>();
     auto values_data = values->flat<V>();
     int64_t i = 0;
-    for (auto it = table_.begin(); it != table_.end(); ++it, ++i) {
-      keys_data(i) = it->first;
-      values_data(i) = it->second;
+    for (int64_t s = 0; s < num_shards_; ++s) {
+      const auto& table = shards_[s].table;
+      for (auto it = table.begin(); it != table.end(); ++it, ++i) {
+        keys_data(i) = it->first;
+        values_data(i) = it->second;
+      }
     }
   }
 
-  mutable mutex mu_;
-  std::unordered_map<K, V> table_ TF_GUARDED_BY(mu_);
+  const int64_t num_shards_;
+  const std::unique_ptr<Shard[]> shards_;
 };
 
 // Lookup table that wraps an unordered_map. Behaves identical to
@@ -217,7 +338,8 @@ class MutableHashTableOfScalars final : public LookupInterface {
 template <class K, class V>
 class MutableHashTableOfTensors final : public LookupInterface {
  public:
-  MutableHashTableOfTensors(OpKernelContext* ctx, OpKernel* kernel) {
+  MutableHashTableOfTensors(OpKernelContext* ctx, OpKernel* kernel)
+      : num_shards_(NumTableShards()), shards_(new Shard[num_shards_]) {
     OP_REQUIRES_OK(ctx,
                    GetNodeAttr(kernel->def(), "value_shape", &value_shape_));
     OP_REQUIRES(
@@ -227,12 +349,17 @@ class MutableHashTableOfTensors final : public LookupInterface {
   }
 
   size_t size() const override {
-    tf_shared_lock l(mu_);
-    return table_.size();
+    size_t ret = 0;
+    for (int64_t s = 0; s < num_shards_; ++s) {
+      tf_shared_lock l(shards_[s].mu);
+      ret += shards_[s].table.size();
+    }
+    return ret;
   }
 
   Status Find(OpKernelContext* ctx, const Tensor& key, Tensor* value,
-              const Tensor& default_value) override {
+              const Tensor& default_value) override
+      TF_NO_THREAD_SAFETY_ANALYSIS {
     const auto default_flat = default_value.flat_inner_dims<V, 2>();
     const auto key_values = key.flat<K>();
     auto value_values = value->flat_inner_dims<V, 2>();
@@ -242,10 +369,17 @@ class MutableHashTableOfTensors final : public LookupInterface {
     int64_t default_total = default_flat.size();
     bool is_full_size_default = (total == default_total);
 
-    tf_shared_lock l(mu_);
+    // With a single shard (the default) one shared lock covers the whole
+    // batch, as before; otherwise each lookup takes the shared lock of the
+    // shard its key hashes to.
+    std::optional<tf_shared_lock> batch_lock;
+    if (num_shards_ == 1) batch_lock.emplace(shards_[0].mu);
     for (int64_t i = 0; i < key_values.size(); ++i) {
-      ValueArray* value_vec =
-          gtl::FindOrNull(table_, SubtleMustCopyIfIntegral(key_values(i)));
+      const K key_value = SubtleMustCopyIfIntegral(key_values(i));
+      Shard& shard = ShardForKey(key_value);
+      std::optional<tf_shared_lock> key_lock;
+      if (num_shards_ > 1) key_lock.emplace(shard.mu);
+      ValueArray* value_vec = gtl::FindOrNull(shard.table, key_value);
       if (value_vec != nullptr) {
         for (int64_t j = 0; j < value_dim; j++) {
           value_values(i, j) = value_vec->at(j);
@@ -267,23 +401,40 @@ class MutableHashTableOfTensors final : public LookupInterface {
     return OkStatus();
   }
 
-  Status DoInsert(bool clear, const Tensor& keys, const Tensor& values) {
+  Status DoInsert(bool clear,
+                  const Tensor& keys,
+                  const Tensor& values) TF_NO_THREAD_SAFETY_ANALYSIS {
     const auto key_values = keys.flat<K>();
     const auto value_values = values.flat_inner_dims<V, 2>();
     int64_t value_dim = value_shape_.dim_size(0);
 
-    mutex_lock l(mu_);
     if (clear) {
-      table_.clear();
-    }
-    for (int64_t i = 0; i < key_values.size(); ++i) {
-      ValueArray value_vec;
-      for (int64_t j = 0; j < value_dim; j++) {
-        V value = value_values(i, j);
-        value_vec.push_back(value);
+      // Hold every shard exclusively so that the clear and the re-import
+      // appear atomic to concurrent readers.
+      std::vector<mutex_lock> locks = LockAllExclusive();
+      for (int64_t s = 0; s < num_shards_; ++s) {
+        shards_[s].table.clear();
+      }
+      for (int64_t i = 0; i < key_values.size(); ++i) {
+        ValueArray value_vec;
+        for (int64_t j = 0; j < value_dim; j++) {
+          value_vec.push_back(value_values(i, j));
+        }
+        const K key_value = SubtleMustCopyIfIntegral(key_values(i));
+        gtl::InsertOrUpdate(&ShardForKey(key_value).table, key_value,
+                            value_vec);
+      }
+    } else {
+      for (int64_t i = 0; i < key_values.size(); ++i) {
+        ValueArray value_vec;
+        for (int64_t j = 0; j < value_dim; j++) {
+          value_vec.push_back(value_values(i, j));
+        }
+        const K key_value = SubtleMustCopyIfIntegral(key_values(i));
+        Shard& shard = ShardForKey(key_value);
+        mutex_lock l(shard.mu);
+        gtl::InsertOrUpdate(&shard.table, key_value, value_vec);
       }
-      gtl::InsertOrUpdate(&table_, SubtleMustCopyIfIntegral(key_values(i)),
-                          value_vec);
     }
     return OkStatus();
   }
@@ -296,9 +447,11 @@ class MutableHashTableOfTensors final : public LookupInterface {
   Status Remove(OpKernelContext* ctx, const Tensor& keys) override {
     const auto key_values = keys.flat<K>();
 
-    mutex_lock l(mu_);
     for (int64_t i = 0; i < key_values.size(); ++i) {
-      table_.erase(SubtleMustCopyIfIntegral(key_values(i)));
+      const K key_value = SubtleMustCopyIfIntegral(key_values(i));
+      Shard& shard = ShardForKey(key_value);
+      mutex_lock l(shard.mu);
+      shard.table.erase(key_value);
     }
     return OkStatus();
   }
@@ -308,9 +461,10 @@ class MutableHashTableOfTensors final : public LookupInterface {
     return DoInsert(true, keys, values);
   }
 
-  Status ExportValues(OpKernelContext* ctx) override {
-    tf_shared_lock l(mu_);
-    int64_t size = table_.size();
+  Status ExportValues(OpKernelContext* ctx) override
+      TF_NO_THREAD_SAFETY_ANALYSIS {
+    std::vector<tf_shared_lock> locks = LockAllShared();
+    int64_t size = SizeLocked();
     int64_t value_dim = value_shape_.dim_size(0);
 
     Tensor* keys;
@@ -333,21 +487,25 @@ class MutableHashTableOfTensors final : public LookupInterface {
 
   int64_t MemoryUsed() const override {
     int64_t ret = 0;
-    tf_shared_lock l(mu_);
-    for (unsigned i = 0; i < table_.bucket_count(); ++i) {
-      size_t bucket_size = table_.bucket_size(i);
-      if (bucket_size == 0) {
-        ret++;
-      } else {
-        ret += bucket_size;
+    for (int64_t s = 0; s < num_shards_; ++s) {
+      tf_shared_lock l(shards_[s].mu);
+      const auto& table = shards_[s].table;
+      for (unsigned i = 0; i < table.bucket_count(); ++i) {
+        size_t bucket_size = table.bucket_size(i);
+        if (bucket_size == 0) {
+          ret++;
+        } else {
+          ret += bucket_size;
+        }
       }
     }
     return sizeof(MutableHashTableOfTensors) + ret;
   }
 
-  Status AsGraphDef(GraphDefBuilder* builder, Node** out) const override {
-    tf_shared_lock l(mu_);
-    int64_t size = table_.size();
+  Status AsGraphDef(GraphDefBuilder* builder, Node** out) const override
+      TF_NO_THREAD_SAFETY_ANALYSIS {
+    std::vector<tf_shared_lock> locks = LockAllShared();
+    int64_t size = SizeLocked();
     Tensor keys(key_dtype(), TensorShape({size}));
     Tensor values(value_dtype(), TensorShape({size, value_shape_.dim_size(0)}));
     ExportKeysAndValues(&keys, &values);
@@ -384,39 +542,76 @@ class MutableHashTableOfTensors final : public LookupInterface {
   }
 
  private:
+  typedef gtl::InlinedVector<V, 4> ValueArray;
+
+  // One independently locked hash map. Keys are assigned to shards by
+  // HashScalar, so a batch of lookups only touches the locks of the shards
+  // its keys fall in.
+  struct Shard {
+    mutable mutex mu;
+    std::unordered_map<K, ValueArray> table TF_GUARDED_BY(mu);
+  };
+
+  Shard& ShardForKey(const K& key) const {
+    return num_shards_ == 1 ? shards_[0]
+                            : shards_[HashScalar(key) % num_shards_];
+  }
+
+  std::vector<tf_shared_lock> LockAllShared() const {
+    std::vector<tf_shared_lock> locks;
+    locks.reserve(num_shards_);
+    for (int64_t s = 0; s < num_shards_; ++s) {
+      locks.emplace_back(shards_[s].mu);
+    }
+    return locks;
+  }
+
+  std::vector<mutex_lock> LockAllExclusive() const {
+    std::vector<mutex_lock> locks;
+    locks.reserve(num_shards_);
+    for (int64_t s = 0; s < num_shards_; ++s) {
+      locks.emplace_back(shards_[s].mu);
+    }
+    return locks;
+  }
+
+  // Requires all shard locks to be held.
+  int64_t SizeLocked() const TF_NO_THREAD_SAFETY_ANALYSIS {
+    int64_t size = 0;
+    for (int64_t s = 0; s < num_shards_; ++s) {
+      size += shards_[s].table.size();
+    }
+    return size;
+  }
+
   // Writes all keys and values into `keys` and `values`. `keys` and `values`
-  // must point to tensors of size `table_.size()`.
+  // must point to tensors of size `SizeLocked()` and all shard locks must be
+  // held.
   void ExportKeysAndValues(Tensor* keys, Tensor* values) const
-      TF_SHARED_LOCKS_REQUIRED(mu_) {
+      TF_NO_THREAD_SAFETY_ANALYSIS {
     int64_t value_dim = value_shape_.dim_size(0);
     auto keys_data = keys->flat<K>();
     auto values_data = values->matrix<V>();
     int64_t i = 0;
-    for (auto it = table_.begin(); it != table_.end(); ++it, ++i) {
-      K key = it->first;
-      ValueArray value = it->second;
-      keys_data(i) = key;
-      for (int64_t j = 0; j < value_dim; j++) {
-        values_data(i, j) = value[j];
+    for (int64_t s = 0; s < num_shards_; ++s) {
+      const auto& table = shards_[s].table;
+      for (auto it = table.begin(); it != table.end(); ++it, ++i) {
+        keys_data(i) = it->first;
+        const ValueArray& value = it->second;
+        for (int64_t j = 0; j < value_dim; j++) {
+          values_data(i, j) = value[j];
+        }
       }
     }
   }
 
   TensorShape value_shape_;
-  mutable mutex mu_;
-  typedef gtl::InlinedVector<V, 4> ValueArray;
-  std::unordered_map<K, ValueArray> table_ TF_GUARDED_BY(mu_);
+  const int64_t num_shards_;
+  const std::unique_ptr<Shard[]> shards_;
 };
 
 namespace {
 
-template <typename T>
-inline uint64 HashScalar(const T& key) {
-  return static_cast<uint64>(key);
-}
-
-inline uint64 HashScalar(const tstring& key) { return Hash64(key); }
-
 // If the given shape is a scalar return {1} instead. Otherwise leave it alone.
 TensorShape MaybeVectorizeShape(const TensorShape& shape) {
   if (shape.dims() == 0) {
@@ -342,6 +342,78 @@ struct SingleBatchParallelMatMulKernel {
     constexpr int kPacketSize = Eigen::internal::packet_traits<Scalar>::size;
     constexpr Index kBlockMin = 8 * kPacketSize;
 
+    // When both output dimensions are too small to split, the blocked scheme
+    // below degenerates to a single thread no matter how large the
+    // contraction dimension is. Parallelize over k instead: compute partial
+    // products over k-chunks concurrently and reduce them at the end
+    // (split-K).
+    if (m <= kBlockMin && n <= kBlockMin && m * k * n > work_limit) {
+      Index num_chunks = std::min<Index>(
+          Eigen::divup<Index>(m * k * n, work_limit), pool->NumThreads());
+      if (num_chunks > 1) {
+        const Index chunk = Eigen::divup(k, num_chunks);
+        num_chunks = Eigen::divup(k, chunk);
+        auto compute_split_k_partial =
+            [&x_mat, &y_mat, adj_x, trans_x, adj_y, trans_y, m, n](
+                Matrix* partial, Index k0, Index kc) {
+              partial->resize(m, n);
+              // Assume at most one of adj_x or trans_x is true. Similarly,
+              // for adj_y and trans_y.
+              if (!adj_x && !trans_x) {
+                auto x = x_mat.middleCols(k0, kc);
+                if (!adj_y && !trans_y) {
+                  partial->noalias() = x * y_mat.middleRows(k0, kc);
+                } else if (adj_y) {
+                  partial->noalias() = x * y_mat.middleCols(k0, kc).adjoint();
+                } else {  // trans_y == true
+                  partial->noalias() = x * y_mat.middleCols(k0, kc).transpose();
+                }
+              } else if (adj_x) {
+                auto x = x_mat.middleRows(k0, kc);
+                if (!adj_y && !trans_y) {
+                  partial->noalias() = x.adjoint() * y_mat.middleRows(k0, kc);
+                } else if (adj_y) {
+                  partial->noalias() =
+                      x.adjoint() * y_mat.middleCols(k0, kc).adjoint();
+                } else {  // trans_y == true
+                  partial->noalias() =
+                      x.adjoint() * y_mat.middleCols(k0, kc).transpose();
+                }
+              } else {  // trans_x == true
+                auto x = x_mat.middleRows(k0, kc);
+                if (!adj_y && !trans_y) {
+                  partial->noalias() = x.transpose() * y_mat.middleRows(k0, kc);
+                } else if (adj_y) {
+                  partial->noalias() =
+                      x.transpose() * y_mat.middleCols(k0, kc).adjoint();
+                } else {  // trans_y == true
+                  partial->noalias() =
+                      x.transpose() * y_mat.middleCols(k0, kc).transpose();
+                }
+              }
+            };
+        std::vector<Matrix> partials(num_chunks);
+        Eigen::Barrier barrier(num_chunks);
+        for (Index c = 1; c < num_chunks; ++c) {
+          pool->Schedule([&compute_split_k_partial, &partials, &barrier, chunk,
+                          k, c]() {
+            const Index k0 = c * chunk;
+            compute_split_k_partial(&partials[c], k0,
+                                    std::min(chunk, k - k0));
+            barrier.Notify();
+          });
+        }
+        compute_split_k_partial(&partials[0], 0, std::min(chunk, k));
+        barrier.Notify();
+        barrier.Wait();
+        out_mat.noalias() = partials[0];
+        for (Index c = 1; c < num_chunks; ++c) {
+          out_mat.noalias() += partials[c];
+        }
+        return;
+      }
+    }
+
     // Precompute how many blocks there will be.
     auto compute_blocks = YCombinator([k, work_limit, kBlockMin](
                                           auto& compute_blocks, Index row,
@@ -425,9 +497,19 @@ struct LaunchBatchMatMul<CPUDevice, Scalar> {
     // Jan 21, 2020.
     const int64_t kMaxCostOuterParallelism = 128 * 128;  // heuristic.
     auto worker_threads = *(context->device()->tensorflow_cpu_worker_threads());
+    // Output dimension below which the generic contraction tiling misfits:
+    // for such tall-skinny / short-wide products the explicitly blocked
+    // kernel below is preferable, since it degenerates to a multi-threaded
+    // GEMV-like split over the long output dimension (or to a split-K
+    // reduction when both output dimensions are small).
+    constexpr int64_t kSkinnyOutputDim = 16;
+    const bool is_skinny =
+        batch_size == 1 &&
+        std::min(out->dim_size(1), out->dim_size(2)) <= kSkinnyOutputDim &&
+        cost_per_unit > kMaxCostOuterParallelism;
     // TODO(rmlarsen): Reconsider the heuristics now that we have asynchronous
     // evaluation in Eigen Tensor.
-    if (small_dim > 1 &&
+    if (!is_skinny && small_dim > 1 &&
         (batch_size == 1 || cost_per_unit > kMaxCostOuterParallelism)) {
       // Parallelize over inner dims.
       // For large matrix products it is counter-productive to parallelize
@@ -160,8 +160,42 @@ class FusedMatMulOpTest : public OpsTestBase {
     } else if (activation_type == "LeakyRelu") {
       ops::internal::LeakyRelu(root.WithOpName("with_activation"), with_bias);
     } else if (activation_type == "GeluExact") {
-      VLOG(0) << "ERROR: GeluExact is yet not available!!";
-      ops::Identity(root.WithOpName("with_activation"), with_bias);
+      // Gelu exact, 0.5 * x * (1 + erf(x / sqrt(2))), from primitive ops.
+      auto erf = ops::Erf(
+          root.WithOpName("erf"),
+          ops::Mul(root.WithOpName("scaled"), with_bias,
+                   ops::Const(root.WithOpName("sqrt_one_half"),
+                              0.7071067811865476f)));
+      auto one_plus_erf =
+          ops::AddV2(root.WithOpName("one_plus_erf"),
+                     ops::Const(root.WithOpName("one"), 1.0f), erf);
+      auto halved =
+          ops::Mul(root.WithOpName("halved"), one_plus_erf,
+                   ops::Const(root.WithOpName("one_half"), 0.5f));
+      ops::Mul(root.WithOpName("with_activation"), halved, with_bias);
+    } else if (activation_type == "GeluApproximate") {
+      // Gelu approximate, 0.5 * x * (1 + tanh(sqrt(2 / pi) *
+      // (x + 0.044715 * x^3))), from primitive ops.
+      auto cube = ops::Mul(
+          root.WithOpName("cube"),
+          ops::Mul(root.WithOpName("square"), with_bias, with_bias),
+          with_bias);
+      auto inner = ops::AddV2(
+          root.WithOpName("inner"), with_bias,
+          ops::Mul(root.WithOpName("scaled_cube"), cube,
+                   ops::Const(root.WithOpName("empirical_const"), 0.044715f)));
+      auto tanh = ops::Tanh(
+          root.WithOpName("tanh"),
+          ops::Mul(root.WithOpName("scaled_inner"), inner,
+                   ops::Const(root.WithOpName("sqrt_two_over_pi"),
+                              0.7978845608028654f)));
+      auto one_plus_tanh =
+          ops::AddV2(root.WithOpName("one_plus_tanh"),
+                     ops::Const(root.WithOpName("one"), 1.0f), tanh);
+      auto halved =
+          ops::Mul(root.WithOpName("halved"), one_plus_tanh,
+                   ops::Const(root.WithOpName("one_half"), 0.5f));
+      ops::Mul(root.WithOpName("with_activation"), halved, with_bias);
     } else if (activation_type == "Sigmoid") {
       ops::Sigmoid(root.WithOpName("with_activation"), with_bias);
     } else if (activation_type == "Tanh") {
@@ -367,7 +401,8 @@ static auto GetActivations(DataType dtype) {
       // TODO: not sure how to add GeluExact op ??
       return std::vector{/*"GeluExact",*/ "Tanh", "Sigmoid"};
     default:
-      return std::vector{"Relu", "Relu6", "Elu", "LeakyRelu"};
+      return std::vector{"Relu",      "Relu6",     "Elu",
+                         "LeakyRelu", "GeluExact", "GeluApproximate"};
   }
 }
 
@@ -21,6 +21,8 @@ limitations under the License.
 
 #define EIGEN_USE_THREADS
 
+#include <algorithm>
+
 #include "unsupported/Eigen/CXX11/Tensor"  // from @eigen_archive
 #include "tensorflow/core/framework/bounds_check.h"
 #include "tensorflow/core/framework/tensor_types.h"
@@ -78,43 +80,56 @@ struct OneHot<CPUDevice, T, TI> {
       const typename TTypes<T>::ConstScalar& on_value,
       const typename TTypes<T>::ConstScalar& off_value,
       typename TTypes<T, 3>::Tensor* output) {
-    // Pre-fill output with `off_value`.
-    output->device(d) = output->constant(off_value());
-
-    // Iterate through indices and update on_value elements in the output.
     Eigen::Index prefix_size = output->dimensions()[0];
     Eigen::Index depth_size = output->dimensions()[1];
     Eigen::Index suffix_size = output->dimensions()[2];
 
-    // Cost of setting one `on_value` coefficient.
-    double bytes_loaded = sizeof(T);
-    double bytes_stored = sizeof(T);
-    double cycles = 0.0;
-    const Eigen::TensorOpCost cost(bytes_loaded, bytes_stored, cycles);
-
     if (suffix_size == 1) {
+      // Each shard of batch rows is filled with `off_value` and has its hot
+      // index set in the same pass, so every output row is written exactly
+      // once instead of being pre-filled and then revisited by the scatter.
+      // This halves memory traffic for large depths (e.g. vocabulary-sized
+      // one-hot encodings).
+      T* const output_data = output->data();
+      const T on = on_value();
+      const T off = off_value();
+      // Cost of producing one `depth_size`-wide output row.
+      const Eigen::TensorOpCost cost(sizeof(TI), sizeof(T) * depth_size, 0.0);
       const auto func = [&](Eigen::Index start, Eigen::Index end) -> void {
+        std::fill(output_data + start * depth_size,
+                  output_data + end * depth_size, off);
         for (Eigen::Index i = start; i < end; ++i) {
           const TI depth = internal::SubtleMustCopy(indices(i, 0));
           if (FastBoundsCheck(depth, depth_size)) {
-            (*output)(i, depth, 0) = on_value();
+            output_data[i * depth_size + depth] = on;
           }
         }
       };
       d.parallelFor(prefix_size, cost, func);
-    } else {
-      const auto func = [&](Eigen::Index start, Eigen::Index end) -> void {
-        for (Eigen::Index i = start; i < end; ++i) {
-          const Eigen::Index d0 = i / suffix_size;
-          const Eigen::Index d1 = i - (d0 * suffix_size);
-          const TI depth = internal::SubtleMustCopy(indices(d0, d1));
-          if (FastBoundsCheck(depth, depth_size)) {
-            (*output)(d0, depth, d1) = on_value();
-          }
-        }
-      };
-      d.parallelFor(prefix_size * suffix_size, cost * suffix_size, func);
+      return;
     }
+
+    // Pre-fill output with `off_value`.
+    output->device(d) = output->constant(off_value());
+
+    // Iterate through indices and update on_value elements in the output.
+    // Cost of setting one `on_value` coefficient.
+    double bytes_loaded = sizeof(T);
+    double bytes_stored = sizeof(T);
+    double cycles = 0.0;
+    const Eigen::TensorOpCost cost(bytes_loaded, bytes_stored, cycles);
+
+    const auto func = [&](Eigen::Index start, Eigen::Index end) -> void {
+      for (Eigen::Index i = start; i < end; ++i) {
+        const Eigen::Index d0 = i / suffix_size;
+        const Eigen::Index d1 = i - (d0 * suffix_size);
+        const TI depth = internal::SubtleMustCopy(indices(d0, d1));
+        if (FastBoundsCheck(depth, depth_size)) {
+          (*output)(d0, depth, d1) = on_value();
+        }
+      }
+    };
+    d.parallelFor(prefix_size * suffix_size, cost * suffix_size, func);
   }
 };
 
@@ -22,6 +22,7 @@ limitations under the License.
 #include "tensorflow/core/framework/function.h"
 #include "tensorflow/core/framework/op_kernel.h"
 #include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_util.h"
 #include "tensorflow/core/framework/types.h"
 #include "tensorflow/core/framework/types.pb.h"
 #include "tensorflow/core/lib/random/random.h"
@@ -30,6 +31,7 @@ limitations under the License.
 #include "tensorflow/core/profiler/lib/traceme.h"
 #include "tensorflow/core/protobuf/config.pb.h"
 #include "tensorflow/core/protobuf/rewriter_config.pb.h"
+#include "tensorflow/core/util/env_var.h"
 #ifndef IS_MOBILE_PLATFORM
 #include "tensorflow/core/grappler/optimizers/meta_optimizer.h"
 #endif
@@ -71,6 +73,14 @@ PartitionedCallOp::PartitionedCallOp(OpKernelConstruction* ctx)
                                 "tensorflow::ConfigProto proto."));
   }
   OP_REQUIRES_OK(ctx, ctx->GetAttr("executor_type", &executor_type_));
+  if (ctx->HasAttr("pipelining_micro_batches")) {
+    OP_REQUIRES_OK(ctx, ctx->GetAttr("pipelining_micro_batches",
+                                     &pipelining_micro_batches_));
+  }
+  OP_REQUIRES(ctx, pipelining_micro_batches_ >= 1,
+              errors::InvalidArgument(
+                  "pipelining_micro_batches must be >= 1 but is ",
+                  pipelining_micro_batches_));
 }
 
 PartitionedCallOp::~PartitionedCallOp() {
@@ -128,6 +138,10 @@ void PartitionedCallOp::ComputeAsync(OpKernelContext* ctx, DoneCallback done) {
     }
   }
 
+  if (pipelining_micro_batches_ > 1) {
+    RunPipelined(handle, inputs, lib, ctx, std::move(done));
+    return;
+  }
   RunFunction(handle, inputs, lib, ctx, done);
 }
 
@@ -278,6 +292,220 @@ void PartitionedCallOp::RunFunction(FunctionLibraryRuntime::Handle handle,
            });
 }
 
+namespace {
+
+// Upper bound on concurrently running micro-batches of one pipelined
+// PartitionedCallOp invocation. 0 (the default) means no bound beyond the
+// micro-batch count itself.
+int64_t PipelineQueueDepth() {
+  static const int64_t depth = [] {
+    int64_t value = 0;
+    Status status = ReadInt64FromEnvVar("TF_PARTITIONED_CALL_PIPELINE_DEPTH",
+                                        0, &value);
+    if (!status.ok()) {
+      LOG(ERROR) << "Invalid TF_PARTITIONED_CALL_PIPELINE_DEPTH: " << status;
+      return int64_t{0};
+    }
+    if (value < 0) {
+      LOG(ERROR) << "Invalid TF_PARTITIONED_CALL_PIPELINE_DEPTH: must be "
+                    ">= 0, got "
+                 << value;
+      return int64_t{0};
+    }
+    return value;
+  }();
+  return depth;
+}
+
+}  // namespace
+
+struct PartitionedCallOp::PipelineState {
+  FunctionLibraryRuntime::Handle handle;
+  FunctionLibraryRuntime* lib;
+  OpKernelContext* ctx;
+  DoneCallback done;
+  // Per-micro-batch function inputs and outputs, in micro-batch order.
+  std::vector<std::vector<Tensor>> inputs;
+  std::vector<std::vector<Tensor>> rets;
+  mutex mu;
+  Status status TF_GUARDED_BY(mu);
+  int next_to_launch TF_GUARDED_BY(mu) = 0;
+  int num_done TF_GUARDED_BY(mu) = 0;
+};
+
+void PartitionedCallOp::RunPipelined(FunctionLibraryRuntime::Handle handle,
+                                     const std::vector<Tensor>& inputs,
+                                     FunctionLibraryRuntime* lib,
+                                     OpKernelContext* ctx, DoneCallback done) {
+  const int num_micro_batches = pipelining_micro_batches_;
+  // The op's rendezvous cannot be shared by concurrent micro-batch runs
+  // without colliding send/recv keys.
+  OP_REQUIRES_ASYNC(
+      ctx, !shared_rendezvous_,
+      errors::InvalidArgument("pipelining_micro_batches > 1 cannot be "
+                              "combined with a shared rendezvous"),
+      done);
+  int64_t batch_size = -1;
+  for (const Tensor& tensor : inputs) {
+    if (tensor.dtype() == DT_RESOURCE) continue;
+    OP_REQUIRES_ASYNC(
+        ctx, tensor.dims() >= 1,
+        errors::InvalidArgument("pipelining_micro_batches > 1 requires all "
+                                "non-resource inputs to have a batch "
+                                "dimension; got a scalar input"),
+        done);
+    if (batch_size < 0) {
+      batch_size = tensor.dim_size(0);
+    }
+    OP_REQUIRES_ASYNC(
+        ctx, tensor.dim_size(0) == batch_size,
+        errors::InvalidArgument(
+            "pipelining_micro_batches > 1 requires all non-resource inputs "
+            "to agree on the batch dimension; got ",
+            tensor.dim_size(0), " vs. ", batch_size),
+        done);
+  }
+  OP_REQUIRES_ASYNC(
+      ctx, batch_size >= 0,
+      errors::InvalidArgument("pipelining_micro_batches > 1 requires at "
+                              "least one non-resource input"),
+      done);
+  OP_REQUIRES_ASYNC(
+      ctx, batch_size % num_micro_batches == 0,
+      errors::InvalidArgument("Batch size ", batch_size,
+                              " is not divisible by pipelining_micro_batches ",
+                              num_micro_batches),
+      done);
+  const int64_t micro_batch_size = batch_size / num_micro_batches;
+
+  auto state = std::make_shared<PipelineState>();
+  state->handle = handle;
+  state->lib = lib;
+  state->ctx = ctx;
+  state->done = std::move(done);
+  state->inputs.resize(num_micro_batches);
+  state->rets.resize(num_micro_batches);
+  for (int m = 0; m < num_micro_batches; ++m) {
+    std::vector<Tensor>& micro_inputs = state->inputs[m];
+    micro_inputs.reserve(inputs.size());
+    for (const Tensor& tensor : inputs) {
+      if (tensor.dtype() == DT_RESOURCE) {
+        // Resource inputs (e.g. variables) are passed whole to every
+        // micro-batch.
+        micro_inputs.push_back(tensor);
+        continue;
+      }
+      Tensor slice = tensor.Slice(m * micro_batch_size,
+                                  (m + 1) * micro_batch_size);
+      // Slicing along dimension 0 may break the alignment kernels expect;
+      // fall back to a copy for the (rare) unaligned slices.
+      micro_inputs.push_back(slice.IsAligned() ? slice
+                                               : tensor::DeepCopy(slice));
+    }
+  }
+
+  int64_t queue_depth = PipelineQueueDepth();
+  if (queue_depth <= 0 || queue_depth > num_micro_batches) {
+    queue_depth = num_micro_batches;
+  }
+  {
+    mutex_lock l(state->mu);
+    state->next_to_launch = queue_depth;
+  }
+  for (int m = 0; m < queue_depth; ++m) {
+    LaunchMicroBatch(state, m);
+  }
+}
+
+void PartitionedCallOp::LaunchMicroBatch(
+    const std::shared_ptr<PipelineState>& state, int index) {
+  FunctionLibraryRuntime::Options run_opts;
+  ResourceMgr* resource_mgr = state->lib->device()->resource_manager();
+  ScopedStepContainer* step_container = new ScopedStepContainer(
+      run_opts.step_id, [resource_mgr](const string& name) {
+        resource_mgr->Cleanup(name).IgnoreError();
+      });
+  run_opts.step_container = step_container;
+  run_opts.cancellation_manager = state->ctx->cancellation_manager();
+  run_opts.stats_collector = state->ctx->stats_collector();
+  run_opts.collective_executor = state->ctx->collective_executor();
+  run_opts.runner = state->ctx->runner();
+  run_opts.run_all_kernels_inline = state->ctx->run_all_kernels_inline();
+  run_opts.source_device =
+      state->lib->device() == nullptr ? "" : state->lib->device()->name();
+  run_opts.allow_dead_tensors = true;
+
+  profiler::TraceMe trace_me("PartitionedCallOp-MicroBatch");
+  state->lib->Run(
+      run_opts, state->handle, state->inputs[index], &state->rets[index],
+      [this, state, step_container](const Status& status) {
+        delete step_container;
+        int next = -1;
+        bool finished = false;
+        {
+          mutex_lock l(state->mu);
+          state->status.Update(status);
+          ++state->num_done;
+          const int total = state->inputs.size();
+          if (state->status.ok() && state->next_to_launch < total) {
+            next = state->next_to_launch++;
+          }
+          finished = state->num_done == state->next_to_launch;
+        }
+        if (next >= 0) {
+          LaunchMicroBatch(state, next);
+        } else if (finished) {
+          FinishPipeline(state);
+        }
+      });
+}
+
+void PartitionedCallOp::FinishPipeline(
+    const std::shared_ptr<PipelineState>& state) {
+  OpKernelContext* ctx = state->ctx;
+  Status status;
+  {
+    mutex_lock l(state->mu);
+    status = state->status;
+  }
+  if (status.ok()) {
+    const int num_micro_batches = state->rets.size();
+    for (int i = 0; i < ctx->num_outputs() && status.ok(); ++i) {
+      std::vector<Tensor> pieces;
+      pieces.reserve(num_micro_batches);
+      for (int m = 0; m < num_micro_batches && status.ok(); ++m) {
+        if (i >= static_cast<int>(state->rets[m].size())) {
+          status = errors::Internal("Pipelined function returned ",
+                                    state->rets[m].size(),
+                                    " outputs, expected ", ctx->num_outputs());
+        } else if (state->rets[m][i].dims() < 1) {
+          status = errors::InvalidArgument(
+              "pipelining_micro_batches > 1 requires all function outputs "
+              "to have a batch dimension; output ",
+              i, " is a scalar");
+        } else {
+          pieces.push_back(state->rets[m][i]);
+        }
+      }
+      if (status.ok()) {
+        Tensor output;
+        status = tensor::Concat(pieces, &output);
+        if (status.ok()) {
+          ctx->set_output(i, std::move(output));
+        }
+      }
+    }
+  }
+  if (!status.ok()) {
+    const string function_and_msg = strings::StrCat(
+        errors::FormatFunctionForError(func_->name()), " ", status.message());
+    ctx->SetStatus(errors::CreateWithUpdatedMessage(status, function_and_msg));
+  }
+  // `done()` may release the kernel context, so finish using the state first.
+  DoneCallback done = std::move(state->done);
+  done();
+}
+
 REGISTER_KERNEL_BUILDER(Name("PartitionedCall").Device(DEVICE_CPU),
                         PartitionedCallOp);
 REGISTER_KERNEL_BUILDER(Name("StatefulPartitionedCall").Device(DEVICE_CPU),
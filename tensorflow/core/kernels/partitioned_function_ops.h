@@ -54,10 +54,29 @@ class PartitionedCallOp : public AsyncOpKernel {
                    FunctionLibraryRuntime* lib, OpKernelContext* ctx,
                    DoneCallback done);
 
+  // Shared state for one pipelined invocation; defined in the .cc file.
+  struct PipelineState;
+
+  // Splits `inputs` into `pipelining_micro_batches_` micro-batches along
+  // dimension 0 and runs the function once per micro-batch, with at most the
+  // configured queue depth in flight, so that execution of the function's
+  // partitions overlaps across micro-batches. Outputs are concatenated along
+  // dimension 0 in micro-batch order.
+  void RunPipelined(FunctionLibraryRuntime::Handle handle,
+                    const std::vector<Tensor>& inputs,
+                    FunctionLibraryRuntime* lib, OpKernelContext* ctx,
+                    DoneCallback done);
+
+  void LaunchMicroBatch(const std::shared_ptr<PipelineState>& state,
+                        int index);
+
+  void FinishPipeline(const std::shared_ptr<PipelineState>& state);
+
   // Using unique pointers to avoid including proto headers in kernel headers
   std::unique_ptr<NameAttrList> func_;
   std::unique_ptr<ConfigProto> config_proto_;
   string executor_type_;
+  int pipelining_micro_batches_ = 1;
   bool shared_rendezvous_;
   mutex mu_;
   // Cache the handle per FLR because this kernel may be instantiated for
@@ -229,10 +229,12 @@ class MaxPoolingOp : public OpKernel {
       //    output_as_matrix:
       //      depth by (out_width * out_height * tensor_in_batch)
       //
-      // 2. Walks through the set of columns in the flattened
-      // tensor_in_as_matrix,
-      //    and updates the corresponding column(s) in output_as_matrix with the
-      //    max value.
+      // 2. Walks through the output columns and takes the depth-vectorized
+      //    max over the input columns of the corresponding pooling window.
+      //
+      // Work is sharded over batch x output-row units rather than whole batch
+      // elements, so small-batch shapes (e.g. batch-1 audio models with 1xN
+      // windows) still spread across every worker thread.
       auto shard = [&params, &in_mat, &out_mat](int64_t start, int64_t limit) {
         const int32_t in_rows = params.tensor_in_rows;
         const int32_t in_cols = params.tensor_in_cols;
@@ -245,53 +247,38 @@ class MaxPoolingOp : public OpKernel {
         const int32_t out_height = params.out_height;
         const int32_t out_width = params.out_width;
 
-        {
-          // Initializes the output tensor with MIN<T>.
-          const int32_t output_image_size =
-              out_height * out_width * params.depth;
-          EigenMatrixMap out_shard(out_mat.data() + start * output_image_size,
-                                   1, (limit - start) * output_image_size);
-          out_shard.setConstant(Eigen::NumTraits<T>::lowest());
-        }
-
-        for (int32_t b = start; b < limit; ++b) {
-          const int32_t out_offset_batch = b * out_height;
-          for (int32_t h = 0; h < in_rows; ++h) {
-            for (int32_t w = 0; w < in_cols; ++w) {
-              // (h_start, h_end) * (w_start, w_end) is the range that the input
-              // vector projects to.
-              const int32_t hpad = h + pad_top;
-              const int32_t wpad = w + pad_left;
-              const int32_t h_start =
-                  (hpad < window_rows) ? 0
-                                       : (hpad - window_rows) / row_stride + 1;
-              const int32_t h_end = std::min(hpad / row_stride + 1, out_height);
-              const int32_t w_start =
-                  (wpad < window_cols) ? 0
-                                       : (wpad - window_cols) / col_stride + 1;
-              const int32_t w_end = std::min(wpad / col_stride + 1, out_width);
-              // compute elementwise max
-              const int32_t in_offset = (b * in_rows + h) * in_cols + w;
-              for (int32_t ph = h_start; ph < h_end; ++ph) {
-                const int32_t out_offset_base =
-                    (out_offset_batch + ph) * out_width;
-                for (int32_t pw = w_start; pw < w_end; ++pw) {
-                  const int32_t out_offset = out_offset_base + pw;
-                  out_mat.col(out_offset) =
-                      out_mat.col(out_offset).cwiseMax(in_mat.col(in_offset));
-                }
+        for (int64_t unit = start; unit < limit; ++unit) {
+          const int32_t b = unit / out_height;
+          const int32_t ph = unit % out_height;
+          // (h_begin, h_end) x (w_begin, w_end) is the in-bounds part of the
+          // window that this output column pools over.
+          const int32_t h_begin = std::max(ph * row_stride - pad_top, 0);
+          const int32_t h_end =
+              std::min(ph * row_stride - pad_top + window_rows, in_rows);
+          for (int32_t pw = 0; pw < out_width; ++pw) {
+            const int32_t w_begin = std::max(pw * col_stride - pad_left, 0);
+            const int32_t w_end =
+                std::min(pw * col_stride - pad_left + window_cols, in_cols);
+            const int32_t out_offset = (b * out_height + ph) * out_width + pw;
+            auto out_col = out_mat.col(out_offset);
+            out_col.setConstant(Eigen::NumTraits<T>::lowest());
+            for (int32_t h = h_begin; h < h_end; ++h) {
+              const int32_t in_row_offset = (b * in_rows + h) * in_cols;
+              for (int32_t w = w_begin; w < w_end; ++w) {
+                out_col = out_col.cwiseMax(in_mat.col(in_row_offset + w));
               }
             }
           }
         }
       };
 
-      // TODO(andydavis) Consider sharding across batch x rows x cols.
-      // TODO(andydavis) Consider a higher resolution shard cost model.
-      const int64_t shard_cost =
-          params.tensor_in_rows * params.tensor_in_cols * params.depth;
-      Shard(worker_threads.num_threads, worker_threads.workers,
-            params.tensor_in_batch, shard_cost, shard);
+      const int64_t total_units =
+          static_cast<int64_t>(params.tensor_in_batch) * params.out_height;
+      const int64_t shard_cost = static_cast<int64_t>(params.out_width) *
+                                 params.window_rows * params.window_cols *
+                                 params.depth;
+      Shard(worker_threads.num_threads, worker_threads.workers, total_units,
+            shard_cost, shard);
     }
   }
 
@@ -504,10 +491,12 @@ class MaxPoolingV2Op : public OpKernel {
       //    output_as_matrix:
       //      depth by (out_width * out_height * tensor_in_batch)
       //
-      // 2. Walks through the set of columns in the flattened
-      // tensor_in_as_matrix,
-      //    and updates the corresponding column(s) in output_as_matrix with the
-      //    max value.
+      // 2. Walks through the output columns and takes the depth-vectorized
+      //    max over the input columns of the corresponding pooling window.
+      //
+      // Work is sharded over batch x output-row units rather than whole batch
+      // elements, so small-batch shapes (e.g. batch-1 audio models with 1xN
+      // windows) still spread across every worker thread.
       auto shard = [&params, &in_mat, &out_mat](int64_t start, int64_t limit) {
         const int32_t in_rows = params.tensor_in_rows;
         const int32_t in_cols = params.tensor_in_cols;
@@ -520,53 +509,38 @@ class MaxPoolingV2Op : public OpKernel {
         const int32_t out_height = params.out_height;
         const int32_t out_width = params.out_width;
 
-        {
-          // Initializes the output tensor with MIN<T>.
-          const int32_t output_image_size =
-              out_height * out_width * params.depth;
-          EigenMatrixMap out_shard(out_mat.data() + start * output_image_size,
-                                   1, (limit - start) * output_image_size);
-          out_shard.setConstant(Eigen::NumTraits<T>::lowest());
-        }
-
-        for (int32_t b = start; b < limit; ++b) {
-          const int32_t out_offset_batch = b * out_height;
-          for (int32_t h = 0; h < in_rows; ++h) {
-            for (int32_t w = 0; w < in_cols; ++w) {
-              // (h_start, h_end) * (w_start, w_end) is the range that the input
-              // vector projects to.
-              const int32_t hpad = h + pad_top;
-              const int32_t wpad = w + pad_left;
-              const int32_t h_start =
-                  (hpad < window_rows) ? 0
-                                       : (hpad - window_rows) / row_stride + 1;
-              const int32_t h_end = std::min(hpad / row_stride + 1, out_height);
-              const int32_t w_start =
-                  (wpad < window_cols) ? 0
-                                       : (wpad - window_cols) / col_stride + 1;
-              const int32_t w_end = std::min(wpad / col_stride + 1, out_width);
-              // compute elementwise max
-              const int32_t in_offset = (b * in_rows + h) * in_cols + w;
-              for (int32_t ph = h_start; ph < h_end; ++ph) {
-                const int32_t out_offset_base =
-                    (out_offset_batch + ph) * out_width;
-                for (int32_t pw = w_start; pw < w_end; ++pw) {
-                  const int32_t out_offset = out_offset_base + pw;
-                  out_mat.col(out_offset) =
-                      out_mat.col(out_offset).cwiseMax(in_mat.col(in_offset));
-                }
+        for (int64_t unit = start; unit < limit; ++unit) {
+          const int32_t b = unit / out_height;
+          const int32_t ph = unit % out_height;
+          // (h_begin, h_end) x (w_begin, w_end) is the in-bounds part of the
+          // window that this output column pools over.
+          const int32_t h_begin = std::max(ph * row_stride - pad_top, 0);
+          const int32_t h_end =
+              std::min(ph * row_stride - pad_top + window_rows, in_rows);
+          for (int32_t pw = 0; pw < out_width; ++pw) {
+            const int32_t w_begin = std::max(pw * col_stride - pad_left, 0);
+            const int32_t w_end =
+                std::min(pw * col_stride - pad_left + window_cols, in_cols);
+            const int32_t out_offset = (b * out_height + ph) * out_width + pw;
+            auto out_col = out_mat.col(out_offset);
+            out_col.setConstant(Eigen::NumTraits<T>::lowest());
+            for (int32_t h = h_begin; h < h_end; ++h) {
+              const int32_t in_row_offset = (b * in_rows + h) * in_cols;
+              for (int32_t w = w_begin; w < w_end; ++w) {
+                out_col = out_col.cwiseMax(in_mat.col(in_row_offset + w));
               }
             }
           }
         }
       };
 
-      // TODO(andydavis) Consider sharding across batch x rows x cols.
-      // TODO(andydavis) Consider a higher resolution shard cost model.
-      const int64_t shard_cost =
-          params.tensor_in_rows * params.tensor_in_cols * params.depth;
-      Shard(worker_threads.num_threads, worker_threads.workers,
-            params.tensor_in_batch, shard_cost, shard);
+      const int64_t total_units =
+          static_cast<int64_t>(params.tensor_in_batch) * params.out_height;
+      const int64_t shard_cost = static_cast<int64_t>(params.out_width) *
+                                 params.window_rows * params.window_cols *
+                                 params.depth;
+      Shard(worker_threads.num_threads, worker_threads.workers, total_units,
+            shard_cost, shard);
     }
   }
 
@@ -591,77 +565,71 @@ void SpatialAvgPool(OpKernelContext* context, Tensor* output,
   auto in_flat = input.flat<T>();
   auto out_flat = output->flat<T>();
 
-  auto shard = [&params, &in_flat, &out_flat](int64_t start, int64_t limit) {
-    // Calculate indices for this shards chunk of work.
-    const int64_t input_image_size =
-        params.tensor_in_rows * params.tensor_in_cols * params.depth;
-    const int64_t output_image_size =
-        params.out_width * params.out_height * params.depth;
-    const int64_t shard_batch_size = limit - start;
-
-    ConstEigenMatrixMap in_mat(
-        in_flat.data() + start * input_image_size, params.depth,
-        params.tensor_in_cols * params.tensor_in_rows * shard_batch_size);
-    EigenMatrixMap out_mat(
-        out_flat.data() + start * output_image_size, params.depth,
-        params.out_width * params.out_height * shard_batch_size);
-    Eigen::Matrix<T, Eigen::Dynamic, 1> out_count(out_mat.cols());
-    out_count.setZero();
-
-    // Initializes output to zero.
-    out_mat.setZero();
-
-    // The following code basically does the following:
-    // 1. Flattens the input and output tensors into two dimensional arrays.
-    //    tensor_in_as_matrix:
-    //      depth by (tensor_in_cols * tensor_in_rows * tensor_in_batch)
-    //    output_as_matrix:
-    //      depth by (out_width * out_height * tensor_in_batch)
-    //
-    // 2. Walks through the set of columns in the flattened
-    // tensor_in_as_matrix,
-    //    and updates the corresponding column(s) in output_as_matrix with the
-    //    average value.
-    for (int b = 0; b < shard_batch_size; ++b) {
-      for (int h = 0; h < params.tensor_in_rows; ++h) {
-        for (int w = 0; w < params.tensor_in_cols; ++w) {
-          // (h_start, h_end) * (w_start, w_end) is the range that the input
-          // vector projects to.
-          const int hpad = h + params.pad_top;
-          const int wpad = w + params.pad_left;
-          const int h_start =
-              (hpad < params.window_rows)
-                  ? 0
-                  : (hpad - params.window_rows) / params.row_stride + 1;
-          const int h_end =
-              std::min<int>(hpad / params.row_stride + 1, params.out_height);
-          const int w_start =
-              (wpad < params.window_cols)
-                  ? 0
-                  : (wpad - params.window_cols) / params.col_stride + 1;
-          const int w_end =
-              std::min<int>(wpad / params.col_stride + 1, params.out_width);
-          const int in_offset =
-              (b * params.tensor_in_rows + h) * params.tensor_in_cols + w;
-          Eigen::DSizes<Eigen::DenseIndex, 2> in_indices(0, in_offset);
-          for (int ph = h_start; ph < h_end; ++ph) {
-            for (int pw = w_start; pw < w_end; ++pw) {
-              const int out_offset =
-                  (b * params.out_height + ph) * params.out_width + pw;
-              out_mat.col(out_offset) += in_mat.col(in_offset);
-              out_count(out_offset) += T(1);
-            }
+  ConstEigenMatrixMap in_mat(in_flat.data(), params.depth,
+                             params.tensor_in_cols * params.tensor_in_rows *
+                                 params.tensor_in_batch);
+  EigenMatrixMap out_mat(
+      out_flat.data(), params.depth,
+      params.out_width * params.out_height * params.tensor_in_batch);
+
+  // The following code basically does the following:
+  // 1. Flattens the input and output tensors into two dimensional arrays.
+  //    tensor_in_as_matrix:
+  //      depth by (tensor_in_cols * tensor_in_rows * tensor_in_batch)
+  //    output_as_matrix:
+  //      depth by (out_width * out_height * tensor_in_batch)
+  //
+  // 2. Walks through the output columns, accumulating the depth-vectorized
+  //    sum over the input columns of the corresponding pooling window and
+  //    dividing by the number of in-bounds window cells.
+  //
+  // Work is sharded over batch x output-row units rather than whole batch
+  // elements, so small-batch shapes still spread across every worker thread.
+  auto shard = [&params, &in_mat, &out_mat](int64_t start, int64_t limit) {
+    const int32_t in_rows = params.tensor_in_rows;
+    const int32_t in_cols = params.tensor_in_cols;
+    const int32_t pad_top = params.pad_top;
+    const int32_t pad_left = params.pad_left;
+    const int32_t window_rows = params.window_rows;
+    const int32_t window_cols = params.window_cols;
+    const int32_t row_stride = params.row_stride;
+    const int32_t col_stride = params.col_stride;
+    const int32_t out_height = params.out_height;
+    const int32_t out_width = params.out_width;
+
+    for (int64_t unit = start; unit < limit; ++unit) {
+      const int32_t b = unit / out_height;
+      const int32_t ph = unit % out_height;
+      // (h_begin, h_end) x (w_begin, w_end) is the in-bounds part of the
+      // window that this output column pools over.
+      const int32_t h_begin = std::max(ph * row_stride - pad_top, 0);
+      const int32_t h_end =
+          std::min(ph * row_stride - pad_top + window_rows, in_rows);
+      for (int32_t pw = 0; pw < out_width; ++pw) {
+        const int32_t w_begin = std::max(pw * col_stride - pad_left, 0);
+        const int32_t w_end =
+            std::min(pw * col_stride - pad_left + window_cols, in_cols);
+        const int32_t out_offset = (b * out_height + ph) * out_width + pw;
+        auto out_col = out_mat.col(out_offset);
+        out_col.setZero();
+        for (int32_t h = h_begin; h < h_end; ++h) {
+          const int32_t in_row_offset = (b * in_rows + h) * in_cols;
+          for (int32_t w = w_begin; w < w_end; ++w) {
+            out_col += in_mat.col(in_row_offset + w);
           }
         }
+        const int32_t count = (h_end - h_begin) * (w_end - w_begin);
+        DCHECK_GT(count, 0);
+        out_col /= T(count);
       }
     }
-
-    DCHECK_GT(out_count.minCoeff(), T(0));
-    out_mat.array().rowwise() /= out_count.transpose().array();
   };
 
-  const int64_t work_unit_size =
-      params.tensor_in_rows * params.tensor_in_cols * params.depth;
+  const int64_t total_units =
+      static_cast<int64_t>(params.tensor_in_batch) * params.out_height;
+  const int64_t work_unit_size = static_cast<int64_t>(params.out_width) *
+                                 params.window_rows * params.window_cols *
+                                 params.depth;
   // NOTE: Constants in calculation below were estimated based on benchmarking.
   // Nanoseconds/work_unit for benchmarks ranged from 0.01 to 0.001, and
   // so the factor 0.01 (i.e. 1/100) with a max of 10000, was chosen to limit
@@ -670,8 +638,8 @@ void SpatialAvgPool(OpKernelContext* context, Tensor* output,
   const int64_t work_unit_cost = std::max(int64_t{10000}, work_unit_size / 100);
   const DeviceBase::CpuWorkerThreads& worker_threads =
       *(context->device()->tensorflow_cpu_worker_threads());
-  Shard(worker_threads.num_threads, worker_threads.workers,
-        params.tensor_in_batch, work_unit_cost, shard);
+  Shard(worker_threads.num_threads, worker_threads.workers, total_units,
+        work_unit_cost, shard);
 }
 
 }  // namespace tensorflow
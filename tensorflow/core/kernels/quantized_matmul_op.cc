@@ -17,6 +17,11 @@ limitations under the License.
 
 #define EIGEN_USE_THREADS
 
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
 #define GEMMLOWP_ALLOW_SLOW_SCALAR_FALLBACK
 #include "public/gemmlowp.h"
 #include "tensorflow/core/framework/op_kernel.h"
@@ -28,6 +33,7 @@ limitations under the License.
 #include "tensorflow/core/kernels/reference_gemm.h"
 #include "tensorflow/core/lib/core/errors.h"
 #include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/platform/mutex.h"
 
 namespace tensorflow {
 
@@ -213,4 +219,201 @@ REGISTER_KERNEL_BUILDER(Name("QuantizedMatMul")
                             .TypeConstraint<qint32>("Toutput"),
                         QuantizedMatMulOp<quint8, quint8, qint32>);
 
+namespace {
+
+// Computes an asymmetric uint8 quantization range for the given values. Zero
+// is always included in the range so it is exactly representable, which keeps
+// padding and masked-out activations exact after quantization.
+void ChooseQuantizationParams(const float* data, int64_t count, float* scale,
+                              int32* zero_point) {
+  float min_value = 0.0f;
+  float max_value = 0.0f;
+  for (int64_t i = 0; i < count; ++i) {
+    min_value = std::min(min_value, data[i]);
+    max_value = std::max(max_value, data[i]);
+  }
+  const float range = max_value - min_value;
+  *scale = (range > 0.0f) ? (range / 255.0f) : 1.0f;
+  const float zero_point_from_min = -min_value / *scale;
+  *zero_point = static_cast<int32>(
+      std::min(255.0f, std::max(0.0f, std::roundf(zero_point_from_min))));
+}
+
+inline uint8 QuantizeValue(float value, float inverse_scale,
+                           int32 zero_point) {
+  const int32 quantized =
+      static_cast<int32>(std::roundf(value * inverse_scale)) + zero_point;
+  return static_cast<uint8>(std::min(255, std::max(0, quantized)));
+}
+
+}  // namespace
+
+// Implements MatMul on float inputs by quantizing the activations on the fly
+// with one asymmetric scale per row, running the eight-bit gemmlowp GEMM with
+// zero offsets, and folding the zero-point corrections into the dequantization
+// of the int32 accumulators:
+//
+//   C[i,j] = sa_i * sb * (raw[i,j] - zpa_i * colsum_b[j]
+//                         - zpb * rowsum_a[i] + k * zpa_i * zpb)
+//
+// where colsum_b/rowsum_a are the per-column/per-row sums of the quantized
+// operands. The weights are expected to come from a Const node (the remapper
+// only emits this op for constant weights), so their quantization is computed
+// once and reused across calls.
+class DynamicQuantizedMatMulOp : public OpKernel {
+ public:
+  explicit DynamicQuantizedMatMulOp(OpKernelConstruction* context)
+      : OpKernel(context) {
+    bool transpose_a;
+    bool transpose_b;
+    OP_REQUIRES_OK(context, context->GetAttr("transpose_a", &transpose_a));
+    OP_REQUIRES_OK(context, context->GetAttr("transpose_b", &transpose_b));
+    OP_REQUIRES(context, !transpose_a && !transpose_b,
+                errors::Unimplemented(
+                    "_DynamicQuantizedMatMul does not support transposed "
+                    "inputs; the remapper only emits it for untransposed "
+                    "MatMul nodes."));
+  }
+
+  void Compute(OpKernelContext* context) override {
+    const Tensor& a = context->input(0);
+    const Tensor& b = context->input(1);
+    OP_REQUIRES(context, TensorShapeUtils::IsMatrix(a.shape()),
+                errors::InvalidArgument("In[0] is not a matrix"));
+    OP_REQUIRES(context, TensorShapeUtils::IsMatrix(b.shape()),
+                errors::InvalidArgument("In[1] is not a matrix"));
+    OP_REQUIRES(context, a.dim_size(1) == b.dim_size(0),
+                errors::InvalidArgument("Matrix size-incompatible: In[0]: ",
+                                        a.shape().DebugString(),
+                                        ", In[1]: ", b.shape().DebugString()));
+    const int64_t m = a.dim_size(0);
+    const int64_t k = a.dim_size(1);
+    const int64_t n = b.dim_size(1);
+
+    Tensor* c = nullptr;
+    OP_REQUIRES_OK(context,
+                   context->allocate_output(0, TensorShape({m, n}), &c));
+    if (c->NumElements() == 0) return;
+    if (k == 0) {
+      c->flat<float>().setZero();
+      return;
+    }
+
+    std::shared_ptr<const QuantizedWeights> weights;
+    OP_REQUIRES_OK(context, GetOrQuantizeWeights(context, b, &weights));
+
+    // Quantize the activations with one asymmetric range per row, and record
+    // the per-row sums needed for the zero-point correction.
+    Tensor a_quantized;
+    OP_REQUIRES_OK(context, context->allocate_temp(DT_QUINT8, a.shape(),
+                                                   &a_quantized));
+    const float* a_data = a.flat<float>().data();
+    uint8* a_quantized_data =
+        reinterpret_cast<uint8*>(a_quantized.flat<quint8>().data());
+    std::vector<float> row_scales(m);
+    std::vector<int32> row_zero_points(m);
+    std::vector<int32> row_sums(m);
+    for (int64_t i = 0; i < m; ++i) {
+      const float* row = a_data + i * k;
+      float scale;
+      int32 zero_point;
+      ChooseQuantizationParams(row, k, &scale, &zero_point);
+      const float inverse_scale = 1.0f / scale;
+      uint8* quantized_row = a_quantized_data + i * k;
+      int32 row_sum = 0;
+      for (int64_t j = 0; j < k; ++j) {
+        quantized_row[j] = QuantizeValue(row[j], inverse_scale, zero_point);
+        row_sum += quantized_row[j];
+      }
+      row_scales[i] = scale;
+      row_zero_points[i] = zero_point;
+      row_sums[i] = row_sum;
+    }
+
+    Tensor c_quantized;
+    OP_REQUIRES_OK(context, context->allocate_temp(
+                                DT_QINT32, TensorShape({m, n}), &c_quantized));
+    // Offsets are zero; the zero points are folded into the dequantization
+    // below, which keeps the per-row activation zero points out of the GEMM.
+    GemmlowpMultiply<false, false, false>(
+        context, a_quantized.flat<quint8>().data(),
+        weights->data.flat<quint8>().data(), c_quantized.flat<qint32>().data(),
+        m, n, k, 0 /* offset_a */, 0 /* offset_b */, k, n, n);
+
+    const int32* raw = reinterpret_cast<const int32*>(
+        c_quantized.flat<qint32>().data());
+    float* c_data = c->flat<float>().data();
+    const int32 weight_zero_point = weights->zero_point;
+    for (int64_t i = 0; i < m; ++i) {
+      const float dequantize_scale = row_scales[i] * weights->scale;
+      const int32 zero_point_a = row_zero_points[i];
+      const int32 row_correction =
+          static_cast<int32>(k) * zero_point_a * weight_zero_point -
+          weight_zero_point * row_sums[i];
+      const int32* raw_row = raw + i * n;
+      float* c_row = c_data + i * n;
+      for (int64_t j = 0; j < n; ++j) {
+        c_row[j] = dequantize_scale *
+                   (raw_row[j] - zero_point_a * weights->column_sums[j] +
+                    row_correction);
+      }
+    }
+  }
+
+ private:
+  // Per-tensor quantization of the constant weight matrix, computed on first
+  // use and reused for every subsequent call.
+  struct QuantizedWeights {
+    Tensor data;
+    float scale;
+    int32 zero_point;
+    std::vector<int32> column_sums;
+    // Identity of the float tensor the quantization was computed from.
+    const float* source_data;
+    TensorShape source_shape;
+  };
+
+  Status GetOrQuantizeWeights(OpKernelContext* context, const Tensor& b,
+                              std::shared_ptr<const QuantizedWeights>* result) {
+    mutex_lock lock(mu_);
+    if (weights_ != nullptr && weights_->source_data == b.flat<float>().data() &&
+        weights_->source_shape == b.shape()) {
+      *result = weights_;
+      return OkStatus();
+    }
+    auto weights = std::make_shared<QuantizedWeights>();
+    TF_RETURN_IF_ERROR(
+        context->allocate_temp(DT_QUINT8, b.shape(), &weights->data));
+    const float* b_data = b.flat<float>().data();
+    ChooseQuantizationParams(b_data, b.NumElements(), &weights->scale,
+                             &weights->zero_point);
+    const float inverse_scale = 1.0f / weights->scale;
+    const int64_t k = b.dim_size(0);
+    const int64_t n = b.dim_size(1);
+    uint8* quantized =
+        reinterpret_cast<uint8*>(weights->data.flat<quint8>().data());
+    weights->column_sums.assign(n, 0);
+    for (int64_t i = 0; i < k; ++i) {
+      for (int64_t j = 0; j < n; ++j) {
+        const uint8 value = QuantizeValue(b_data[i * n + j], inverse_scale,
+                                          weights->zero_point);
+        quantized[i * n + j] = value;
+        weights->column_sums[j] += value;
+      }
+    }
+    weights->source_data = b_data;
+    weights->source_shape = b.shape();
+    weights_ = weights;
+    *result = weights_;
+    return OkStatus();
+  }
+
+  mutex mu_;
+  std::shared_ptr<const QuantizedWeights> weights_ TF_GUARDED_BY(mu_);
+};
+
+REGISTER_KERNEL_BUILDER(
+    Name("_DynamicQuantizedMatMul").Device(DEVICE_CPU).TypeConstraint<float>("T"),
+    DynamicQuantizedMatMulOp);
+
 }  // namespace tensorflow
@@ -393,4 +393,67 @@ TEST_F(QuantizedMatMulTest, Medium_WithParams) {
   test::ExpectTensorNear<float>(expected_float, output_float, 15.0);
 }
 
+class DynamicQuantizedMatMulTest : public OpsTestBase {
+ protected:
+};
+
+// Multiplies two small float matrices whose values are exactly representable
+// under the asymmetric uint8 quantization the kernel picks (every row maximum
+// divides 255 evenly), so the result must match the float product closely.
+TEST_F(DynamicQuantizedMatMulTest, Small_Exact) {
+  TF_ASSERT_OK(
+      NodeDefBuilder("dynamic_quantized_mat_mul_op", "_DynamicQuantizedMatMul")
+          .Input(FakeInput(DT_FLOAT))
+          .Input(FakeInput(DT_FLOAT))
+          .Finalize(node_def()));
+  TF_ASSERT_OK(InitOp());
+  // A matrix is:
+  // |  1 |  2 |  3 |
+  // |  3 |  5 | 15 |
+  AddInputFromArray<float>(TensorShape({2, 3}), {1, 2, 3, 3, 5, 15});
+  // B matrix is:
+  // |  7 |  8 |  9 | 10 |
+  // | 11 | 12 | 13 | 14 |
+  // | 15 | 16 | 17 |  1 |
+  AddInputFromArray<float>(TensorShape({3, 4}),
+                           {7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 1});
+
+  TF_ASSERT_OK(RunOpKernel());
+
+  Tensor expected(allocator(), DT_FLOAT, TensorShape({2, 4}));
+  test::FillValues<float>(&expected,
+                          {74, 80, 86, 41, 301, 324, 347, 115});
+  test::ExpectTensorNear<float>(expected, *GetOutput(0), 1e-2);
+}
+
+// Multiplies matrices with negative values and a different dynamic range per
+// activation row, and checks the result against the float product within the
+// error budget of eight-bit quantization.
+TEST_F(DynamicQuantizedMatMulTest, Small_WithNegativeValues) {
+  TF_ASSERT_OK(
+      NodeDefBuilder("dynamic_quantized_mat_mul_op", "_DynamicQuantizedMatMul")
+          .Input(FakeInput(DT_FLOAT))
+          .Input(FakeInput(DT_FLOAT))
+          .Finalize(node_def()));
+  TF_ASSERT_OK(InitOp());
+  Tensor a_float(DT_FLOAT, {2, 4});
+  test::FillValues<float>(&a_float, {-1.1f, 0.3f, 0.7f, -0.5f,  //
+                                     12.0f, -3.5f, 8.25f, 0.1f});
+  Tensor b_float(DT_FLOAT, {4, 3});
+  test::FillValues<float>(&b_float, {-0.3f, 0.45f, 0.1f,   //
+                                     0.25f, -0.6f, 0.33f,  //
+                                     -0.1f, 0.2f, -0.4f,   //
+                                     0.6f, -0.2f, 0.15f});
+  AddInputFromArray<float>(a_float.shape(), a_float.flat<float>());
+  AddInputFromArray<float>(b_float.shape(), b_float.flat<float>());
+
+  TF_ASSERT_OK(RunOpKernel());
+
+  Tensor expected(allocator(), DT_FLOAT, TensorShape({2, 3}));
+  test::FillValues<float>(&expected,
+                          {0.035f, -0.435f, -0.366f,  //
+                           -5.24f, 9.13f, -3.24f});
+  test::ExpectTensorNear<float>(expected, *GetOutput(0), 0.25);
+}
+
 }  // namespace tensorflow
@@ -12,9 +12,11 @@ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
+#include <cstring>
 #include <limits>
 #include <memory>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 #include "tensorflow/core/framework/op_kernel.h"
@@ -35,16 +37,42 @@ void WriteValueSlices(
     const Tensor& params_dense_values_in,
     const std::vector<std::pair<SPLITS_TYPE, SPLITS_TYPE>>& value_slices,
     SPLITS_TYPE value_size, Tensor* values_out) {
-  const auto& params_dense_values =
-      params_dense_values_in.flat_outer_dims<VALUE_TYPE, 2>();
-  auto values = values_out->flat_outer_dims<VALUE_TYPE, 2>();
-  int out_pos = 0;
-  for (const auto& slice : value_slices) {
-    for (int i = slice.first; i < slice.second; ++i) {
-      for (int j = 0; j < value_size; ++j) {
-        values(out_pos, j) = params_dense_values(i, j);
+  if constexpr (std::is_trivially_copyable<VALUE_TYPE>::value) {
+    // Gathered rows are contiguous runs of scalars in the params tensor, so
+    // each slice is a single memcpy.  Adjacent slices (e.g. from gathering
+    // consecutive indices) are coalesced into one copy.
+    const VALUE_TYPE* params_base =
+        params_dense_values_in.flat<VALUE_TYPE>().data();
+    VALUE_TYPE* out_base = values_out->flat<VALUE_TYPE>().data();
+    SPLITS_TYPE out_pos = 0;
+    size_t i = 0;
+    while (i < value_slices.size()) {
+      const SPLITS_TYPE start = value_slices[i].first;
+      SPLITS_TYPE limit = value_slices[i].second;
+      ++i;
+      while (i < value_slices.size() && value_slices[i].first == limit) {
+        limit = value_slices[i].second;
+        ++i;
+      }
+      const SPLITS_TYPE num_scalars = (limit - start) * value_size;
+      if (num_scalars > 0) {
+        std::memcpy(out_base + out_pos, params_base + start * value_size,
+                    num_scalars * sizeof(VALUE_TYPE));
+        out_pos += num_scalars;
+      }
+    }
+  } else {
+    const auto& params_dense_values =
+        params_dense_values_in.flat_outer_dims<VALUE_TYPE, 2>();
+    auto values = values_out->flat_outer_dims<VALUE_TYPE, 2>();
+    int out_pos = 0;
+    for (const auto& slice : value_slices) {
+      for (int i = slice.first; i < slice.second; ++i) {
+        for (int j = 0; j < value_size; ++j) {
+          values(out_pos, j) = params_dense_values(i, j);
+        }
+        ++out_pos;
       }
-      ++out_pos;
     }
   }
 }
@@ -554,12 +554,24 @@ class RaggedTensorToTensorOp : public RaggedTensorToTensorBaseOp<INDEX_TYPE> {
                     output_base + dst_i * value_element_size, *default_value);
           dst_end = dst_i;
         } else {
-          while (dst_i > dst_end) {
-            VALUE_TYPE* dst = output_base + dst_end * value_element_size;
-            copy_array<VALUE_TYPE, INDEX_TYPE>(dst, default_value,
-                                               value_element_size);
-            ++dst_end;
+          // Write the first padded row from default_value, then repeatedly
+          // double the padded region by copying from the rows already written,
+          // so padding large gaps costs O(log n) copies instead of one copy
+          // per row.
+          VALUE_TYPE* dst = output_base + dst_end * value_element_size;
+          copy_array<VALUE_TYPE, INDEX_TYPE>(dst, default_value,
+                                             value_element_size);
+          const INDEX_TYPE total_rows = dst_i - dst_end;
+          INDEX_TYPE filled_rows = 1;
+          while (filled_rows < total_rows) {
+            const INDEX_TYPE copy_rows =
+                std::min(filled_rows, total_rows - filled_rows);
+            copy_array<VALUE_TYPE, INDEX_TYPE>(
+                dst + filled_rows * value_element_size, dst,
+                copy_rows * value_element_size);
+            filled_rows += copy_rows;
           }
+          dst_end = dst_i;
         }
       }
 
@@ -135,6 +135,28 @@ TEST_F(RaggedTensorToTensorOpTest, RaggedTensorToTensorRowSplits) {
       0.01);
 }
 
+TEST_F(RaggedTensorToTensorOpTest, RaggedTensorToTensorRowSplitsVectorDefault) {
+  // params = [[[1, 2], [3, 4]], [[5, 6]], [], []]
+  // Non-scalar default values are written row-by-row rather than with
+  // std::fill; the long run of padded rows at the end exercises that path.
+  BuildRaggedTensorToTensorGraph<float, int32>(
+      TensorShape({5, 3, 2}),  // shape
+      {"ROW_SPLITS"},          // row_partition_types
+      ShapeAndValues<float>{TensorShape({3, 2}), {1, 2, 3, 4, 5, 6}},  // values
+      createVector<float>({9, 8}),            // default_value
+      {createVector<int32>({0, 2, 3, 3, 3})}  // row_partition_tensors
+  );
+
+  TF_ASSERT_OK(RunOpKernel());
+
+  test::ExpectTensorNear<float>(
+      *GetOutput(0),
+      test::AsTensor<float>({1, 2, 3, 4, 9, 8, 5, 6, 9, 8, 9, 8, 9, 8, 9,
+                             8, 9, 8, 9, 8, 9, 8, 9, 8, 9, 8, 9, 8, 9, 8},
+                            TensorShape({5, 3, 2})),
+      0.01);
+}
+
 TEST_F(RaggedTensorToTensorOpTest, RaggedTensorToTensor_3DParams) {
   // params = [
   //           [[]],
@@ -20,7 +20,13 @@ limitations under the License.
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <memory>
+#include <type_traits>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
 
 #include "tensorflow/core/framework/op_kernel.h"
 #include "tensorflow/core/framework/register_types.h"
@@ -76,6 +82,142 @@ struct FillPhiloxRandom {
 template <class Distribution, bool VariableSamplesPerOutput>
 struct FillPhiloxRandomTask;
 
+#ifdef __AVX2__
+// Fills `data` with uniform floats in [0, 1) for as many whole batches of
+// eight Philox groups (32 outputs) as fit in `num_groups`, and returns the
+// number of groups produced. Eight counters are processed per SIMD iteration,
+// one per 32-bit lane, so the ten Philox rounds run on whole batches at a
+// time. The output is bit-identical to the scalar
+// UniformDistribution<PhiloxRandom, float> path: the lanes hold consecutive
+// counter values and the conversion applies the same mantissa trick as
+// Uint32ToFloat.
+inline int64_t FillPhiloxUniformFloatAvx2(const random::PhiloxRandom& base_gen,
+                                          float* data, int64_t num_groups) {
+  const int64_t num_batches = num_groups / 8;
+  if (num_batches == 0) return 0;
+
+  constexpr uint32_t kPhiloxW32A = 0x9E3779B9;
+  constexpr uint32_t kPhiloxW32B = 0xBB67AE85;
+  constexpr uint32_t kPhiloxM4x32A = 0xD2511F53;
+  constexpr uint32_t kPhiloxM4x32B = 0xCD9E8D57;
+
+  // The round keys are the same for every lane; precompute the ten pairs.
+  uint32_t round_keys[10][2];
+  {
+    uint32_t k0 = base_gen.key()[0];
+    uint32_t k1 = base_gen.key()[1];
+    for (int r = 0; r < 10; ++r) {
+      round_keys[r][0] = k0;
+      round_keys[r][1] = k1;
+      k0 += kPhiloxW32A;
+      k1 += kPhiloxW32B;
+    }
+  }
+
+  // Lane-striped 128-bit counters: lane j starts at the base counter plus j.
+  alignas(32) uint32_t counter_words[4][8];
+  for (int j = 0; j < 8; ++j) {
+    random::PhiloxRandom lane = base_gen;
+    lane.Skip(j);
+    for (int w = 0; w < 4; ++w) {
+      counter_words[w][j] = lane.counter()[w];
+    }
+  }
+  __m256i c0 = _mm256_load_si256(
+      reinterpret_cast<const __m256i*>(counter_words[0]));
+  __m256i c1 = _mm256_load_si256(
+      reinterpret_cast<const __m256i*>(counter_words[1]));
+  __m256i c2 = _mm256_load_si256(
+      reinterpret_cast<const __m256i*>(counter_words[2]));
+  __m256i c3 = _mm256_load_si256(
+      reinterpret_cast<const __m256i*>(counter_words[3]));
+
+  const __m256i mul_a = _mm256_set1_epi32(static_cast<int>(kPhiloxM4x32A));
+  const __m256i mul_b = _mm256_set1_epi32(static_cast<int>(kPhiloxM4x32B));
+  const __m256i lo_mask = _mm256_set1_epi64x(0x00000000FFFFFFFFLL);
+  const __m256i hi_mask =
+      _mm256_set1_epi64x(static_cast<int64_t>(0xFFFFFFFF00000000ULL));
+  const __m256i sign_bit = _mm256_set1_epi32(static_cast<int>(0x80000000u));
+  const __m256i eight = _mm256_set1_epi32(8);
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i mantissa_mask = _mm256_set1_epi32(0x7fffff);
+  const __m256i exponent_one = _mm256_set1_epi32(0x3f800000);
+  const __m256 one_ps = _mm256_set1_ps(1.0f);
+
+  // 32x32->64 multiplies of all eight lanes, split into high and low words.
+  const auto mul_hi_lo = [&](__m256i x, __m256i m, __m256i* lo, __m256i* hi) {
+    const __m256i prod_even = _mm256_mul_epu32(x, m);
+    const __m256i prod_odd = _mm256_mul_epu32(_mm256_srli_epi64(x, 32), m);
+    *lo = _mm256_blend_epi32(_mm256_and_si256(prod_even, lo_mask),
+                             _mm256_slli_epi64(prod_odd, 32), 0xAA);
+    *hi = _mm256_blend_epi32(_mm256_srli_epi64(prod_even, 32),
+                             _mm256_and_si256(prod_odd, hi_mask), 0xAA);
+  };
+  const auto to_unit_float = [&](__m256i x) {
+    const __m256i bits = _mm256_or_si256(_mm256_and_si256(x, mantissa_mask),
+                                         exponent_one);
+    return _mm256_sub_ps(_mm256_castsi256_ps(bits), one_ps);
+  };
+
+  for (int64_t batch = 0; batch < num_batches; ++batch) {
+    __m256i x0 = c0;
+    __m256i x1 = c1;
+    __m256i x2 = c2;
+    __m256i x3 = c3;
+    for (int r = 0; r < 10; ++r) {
+      __m256i lo0, hi0, lo1, hi1;
+      mul_hi_lo(x0, mul_a, &lo0, &hi0);
+      mul_hi_lo(x2, mul_b, &lo1, &hi1);
+      const __m256i k0 =
+          _mm256_set1_epi32(static_cast<int>(round_keys[r][0]));
+      const __m256i k1 =
+          _mm256_set1_epi32(static_cast<int>(round_keys[r][1]));
+      x0 = _mm256_xor_si256(_mm256_xor_si256(hi1, x1), k0);
+      x1 = lo1;
+      const __m256i new_x2 = _mm256_xor_si256(_mm256_xor_si256(hi0, x3), k1);
+      x3 = lo0;
+      x2 = new_x2;
+    }
+
+    // Transpose the four lane-striped words into eight contiguous groups of
+    // [x0, x1, x2, x3] and write them out as floats.
+    const __m256i t0 = _mm256_unpacklo_epi32(x0, x1);
+    const __m256i t1 = _mm256_unpackhi_epi32(x0, x1);
+    const __m256i t2 = _mm256_unpacklo_epi32(x2, x3);
+    const __m256i t3 = _mm256_unpackhi_epi32(x2, x3);
+    const __m256i g04 = _mm256_unpacklo_epi64(t0, t2);
+    const __m256i g15 = _mm256_unpackhi_epi64(t0, t2);
+    const __m256i g26 = _mm256_unpacklo_epi64(t1, t3);
+    const __m256i g37 = _mm256_unpackhi_epi64(t1, t3);
+    float* const out = data + batch * 32;
+    _mm256_storeu_ps(out, to_unit_float(_mm256_permute2x128_si256(g04, g15,
+                                                                  0x20)));
+    _mm256_storeu_ps(out + 8, to_unit_float(_mm256_permute2x128_si256(
+                                  g26, g37, 0x20)));
+    _mm256_storeu_ps(out + 16, to_unit_float(_mm256_permute2x128_si256(
+                                   g04, g15, 0x31)));
+    _mm256_storeu_ps(out + 24, to_unit_float(_mm256_permute2x128_si256(
+                                   g26, g37, 0x31)));
+
+    // Advance every lane's 128-bit counter by eight, propagating carries.
+    const __m256i old_c0 = c0;
+    c0 = _mm256_add_epi32(c0, eight);
+    const __m256i carry0 =
+        _mm256_cmpgt_epi32(_mm256_xor_si256(old_c0, sign_bit),
+                           _mm256_xor_si256(c0, sign_bit));
+    c1 = _mm256_sub_epi32(c1, carry0);
+    const __m256i carry1 =
+        _mm256_and_si256(carry0, _mm256_cmpeq_epi32(c1, zero));
+    c2 = _mm256_sub_epi32(c2, carry1);
+    const __m256i carry2 =
+        _mm256_and_si256(carry1, _mm256_cmpeq_epi32(c2, zero));
+    c3 = _mm256_sub_epi32(c3, carry2);
+  }
+
+  return num_batches * 8;
+}
+#endif  // __AVX2__
+
 // Specialization for distribution that takes a fixed number of samples for
 // each output.
 template <class Distribution>
@@ -90,7 +232,24 @@ struct FillPhiloxRandomTask<Distribution, false> {
 
     // First fill all the full-size groups
     int64_t limit_group_full = std::min(limit_group, size / kGroupSize);
-    for (int64_t index = start_group; index < limit_group_full; ++index) {
+    int64_t index = start_group;
+
+#ifdef __AVX2__
+    // The uniform float distribution over Philox has a batched engine that
+    // consumes eight counters per SIMD iteration; use it for the bulk of the
+    // groups and let the scalar loop below finish the tail.
+    if constexpr (std::is_same<Distribution,
+                               random::UniformDistribution<
+                                   random::PhiloxRandom, float>>::value) {
+      const int64_t vectorized_groups = FillPhiloxUniformFloatAvx2(
+          gen, data + offset, limit_group_full - index);
+      gen.Skip(vectorized_groups);
+      index += vectorized_groups;
+      offset += vectorized_groups * kGroupSize;
+    }
+#endif  // __AVX2__
+
+    for (; index < limit_group_full; ++index) {
       auto samples = dist(&gen);
       std::copy(&samples[0], &samples[0] + kGroupSize, data + offset);
       offset += kGroupSize;
@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "tensorflow/core/kernels/save_restore_tensor.h"
 
+#include <algorithm>
 #include <memory>
 #include <numeric>
 #include <unordered_map>
@@ -33,6 +34,7 @@ limitations under the License.
 #include "tensorflow/core/lib/strings/stringprintf.h"
 #include "tensorflow/core/platform/logging.h"
 #include "tensorflow/core/platform/types.h"
+#include "tensorflow/core/util/env_var.h"
 #include "tensorflow/core/util/tensor_bundle/tensor_bundle.h"
 #include "tensorflow/core/util/tensor_slice_reader.h"
 #include "tensorflow/core/util/tensor_slice_reader_cache.h"
@@ -250,6 +252,25 @@ namespace {
 // Tensors larger than this threshold will be restored from a thread-pool.
 const int64_t kLargeShapeThreshold = 16 << 20;  // 16M
 
+// Number of threads used by RestoreTensorsV2 to restore tensors.  Large
+// tensors are restored one per thread; the remaining tensors are partitioned
+// into one contiguous (offset-sorted) range per thread.
+const int64_t kDefaultRestoreThreads = 8;
+
+// Don't bother opening an extra BundleReader for a range smaller than this.
+const int64_t kMinTensorsPerRestoreThread = 16;
+
+int GetRestoreThreadCount() {
+  static const int64_t num_threads = []() {
+    int64_t n;
+    Status s = ReadInt64FromEnvVar("TF_CHECKPOINT_RESTORE_THREADS",
+                                   kDefaultRestoreThreads, &n);
+    if (!s.ok()) LOG(ERROR) << s;
+    return std::max<int64_t>(1, n);
+  }();
+  return num_threads;
+}
+
 // A restore operation for a single tensor.  Small tensors may be restored
 // directly from the op thread to improve read locality.  Large tensors can be
 // restored from a thread pool: this requires creating a separate BundleReader
@@ -412,21 +433,64 @@ Status RestoreTensorsV2(OpKernelContext* context, const Tensor& prefix,
     }
   }
 
+  const int num_threads = GetRestoreThreadCount();
+
+  // Partition the remaining (small) tensors into one contiguous range per
+  // thread.  The ranges follow the offset-sorted order above, so each worker
+  // still accesses its section of the data files sequentially.  Each range
+  // needs its own BundleReader, so don't split when the per-range work would
+  // not amortize re-reading the metadata.
+  int num_direct_ranges = 1;
+  if (num_threads > 1 && !direct_restore_ops.empty()) {
+    const int64_t max_ranges =
+        (direct_restore_ops.size() + kMinTensorsPerRestoreThread - 1) /
+        kMinTensorsPerRestoreThread;
+    num_direct_ranges = std::min<int64_t>(num_threads, max_ranges);
+  }
+
   {
     // Schedule any threaded operations first, skipping thread pool creation if
     // we don't have any expensive operations.
     std::unique_ptr<thread::ThreadPool> reader_pool;
-    if (!pool_restore_ops.empty()) {
-      reader_pool.reset(
-          new thread::ThreadPool(Env::Default(), "restore_tensors", 8));
-      for (auto* op : pool_restore_ops) {
-        reader_pool->Schedule([op]() { op->run_with_new_reader(); });
-      }
+    if (!pool_restore_ops.empty() || num_direct_ranges > 1) {
+      reader_pool.reset(new thread::ThreadPool(Env::Default(),
+                                               "restore_tensors", num_threads));
+    }
+    for (auto* op : pool_restore_ops) {
+      reader_pool->Schedule([op]() { op->run_with_new_reader(); });
     }
 
-    // Read small tensors from the op thread
-    for (auto* op : direct_restore_ops) {
-      TF_RETURN_IF_ERROR(op->run(&default_reader));
+    if (num_direct_ranges > 1) {
+      const size_t range_size =
+          (direct_restore_ops.size() + num_direct_ranges - 1) /
+          num_direct_ranges;
+      for (int r = 0; r < num_direct_ranges; ++r) {
+        const size_t begin = r * range_size;
+        const size_t end =
+            std::min(begin + range_size, direct_restore_ops.size());
+        reader_pool->Schedule([&direct_restore_ops, &prefix_string, begin,
+                               end]() {
+          BundleReader reader(Env::Default(), prefix_string);
+          for (size_t i = begin; i < end; ++i) {
+            RestoreOp* op = direct_restore_ops[i];
+            op->status =
+                reader.status().ok() ? op->run(&reader) : reader.status();
+            // On error, fail the remaining ops in this range rather than
+            // restoring past a corrupt region.
+            if (!op->status.ok()) {
+              for (size_t j = i + 1; j < end; ++j) {
+                direct_restore_ops[j]->status = op->status;
+              }
+              return;
+            }
+          }
+        });
+      }
+    } else {
+      // Read small tensors from the op thread
+      for (auto* op : direct_restore_ops) {
+        TF_RETURN_IF_ERROR(op->run(&default_reader));
+      }
     }
   }
 
@@ -434,6 +498,11 @@ Status RestoreTensorsV2(OpKernelContext* context, const Tensor& prefix,
   for (auto* op : pool_restore_ops) {
     TF_RETURN_IF_ERROR(op->status);
   }
+  if (num_direct_ranges > 1) {
+    for (auto* op : direct_restore_ops) {
+      TF_RETURN_IF_ERROR(op->status);
+    }
+  }
 
   for (const RestoreOp& restore_op : restore_ops) {
     if (restore_op.dtype != context->mutable_output(restore_op.idx)->dtype()) {
@@ -20,6 +20,9 @@ limitations under the License.
 
 #include "tensorflow/core/kernels/scan_ops.h"
 
+#include <algorithm>
+#include <vector>
+
 #include "unsupported/Eigen/CXX11/Tensor"  // from @eigen_archive
 #include "tensorflow/core/framework/bounds_check.h"
 #include "tensorflow/core/framework/numeric_op.h"
@@ -33,6 +36,103 @@ namespace tensorflow {
 typedef Eigen::ThreadPoolDevice CPUDevice;
 typedef Eigen::GpuDevice GPUDevice;
 
+namespace functor {
+
+// CPU specialization implementing the classic three-phase parallel scan for a
+// single contiguous sequence: vectorized per-block reductions, a (tiny)
+// sequential exclusive scan over the block aggregates, then a parallel pass
+// where each block scans its elements seeded with its carry. Batched scans and
+// short sequences keep the sequential Eigen evaluation.
+template <typename Reducer, typename T>
+struct Scan<CPUDevice, Reducer, T> {
+  // Minimum number of elements each block should process; below this the
+  // scheduling overhead dominates the scan itself.
+  static constexpr Index kMinBlockSize = 1 << 14;
+
+  void operator()(const CPUDevice& d, typename TTypes<T, 3>::ConstTensor in,
+                  typename TTypes<T, 3>::Tensor out, const Reducer& reducer,
+                  const bool reverse, const bool exclusive) {
+    const Index n = in.dimension(1);
+    if (in.dimension(0) != 1 || in.dimension(2) != 1 || d.numThreads() <= 1 ||
+        n < 2 * kMinBlockSize) {
+      // Perform the reverse ops directly with Eigen, which avoids copying the
+      // tensor twice compared to using individual ops.
+      Eigen::array<bool, 3> dims;
+      dims[0] = false;
+      dims[1] = reverse;
+      dims[2] = false;
+      MaybeWith32BitIndexing<CPUDevice>(
+          [&](auto in32, auto out32) {
+            out32.device(d) =
+                in32.reverse(dims).scan(1, reducer, exclusive).reverse(dims);
+          },
+          in, out);
+      return;
+    }
+
+    const T* in_data = in.data();
+    T* out_data = out.data();
+    const Index num_blocks =
+        std::min<Index>(d.numThreads(), n / kMinBlockSize);
+    const Index block_size = Eigen::divup(n, num_blocks);
+    // Each parallelFor unit is one block; the per-unit cost reflects the
+    // whole block so that units are not coalesced.
+    const Eigen::TensorOpCost block_cost(block_size * sizeof(T),
+                                         block_size * sizeof(T), block_size);
+
+    // Phase 1: reduce each block of the (logically ordered) sequence. The
+    // reductions use the reducer's packet ops and vectorize, unlike the
+    // element-at-a-time scan.
+    std::vector<T> block_aggregate(num_blocks);
+    d.parallelFor(num_blocks, block_cost,
+                  [&](Index block_begin, Index block_end) {
+                    const Eigen::array<Index, 1> reduce_dims{{0}};
+                    for (Index b = block_begin; b < block_end; ++b) {
+                      const Index begin = b * block_size;
+                      const Index len = std::min(block_size, n - begin);
+                      const T* base = reverse ? in_data + n - begin - len
+                                              : in_data + begin;
+                      Eigen::Tensor<T, 0, Eigen::RowMajor, Index> total =
+                          typename TTypes<T>::UnalignedConstFlat(base, len)
+                              .reduce(reduce_dims, reducer);
+                      block_aggregate[b] = total();
+                    }
+                  });
+
+    // Phase 2: exclusive scan over the block aggregates yields each block's
+    // carry-in.
+    std::vector<T> block_carry(num_blocks);
+    T running = reducer.initialize();
+    for (Index b = 0; b < num_blocks; ++b) {
+      block_carry[b] = running;
+      reducer.reduce(block_aggregate[b], &running);
+    }
+
+    // Phase 3: scan each block sequentially, seeded with its carry; the
+    // blocks write disjoint output ranges in parallel.
+    d.parallelFor(
+        num_blocks, block_cost, [&](Index block_begin, Index block_end) {
+          for (Index b = block_begin; b < block_end; ++b) {
+            const Index begin = b * block_size;
+            const Index len = std::min(block_size, n - begin);
+            T accum = block_carry[b];
+            for (Index j = 0; j < len; ++j) {
+              const Index idx = reverse ? n - 1 - begin - j : begin + j;
+              if (exclusive) {
+                out_data[idx] = reducer.finalize(accum);
+                reducer.reduce(in_data[idx], &accum);
+              } else {
+                reducer.reduce(in_data[idx], &accum);
+                out_data[idx] = reducer.finalize(accum);
+              }
+            }
+          }
+        });
+  }
+};
+
+}  // namespace functor
+
 template <typename Device, class T, typename Reducer, typename Tidx>
 class ScanOp : public OpKernel {
  public:
@@ -17,6 +17,7 @@ limitations under the License.
 #define TENSORFLOW_CORE_KERNELS_SCATTER_FUNCTOR_H_
 
 #include <type_traits>
+#include <vector>
 
 #include "Eigen/Core"  // from @eigen_archive
 #include "unsupported/Eigen/CXX11/Tensor"  // from @eigen_archive
@@ -25,6 +26,7 @@ limitations under the License.
 #include "tensorflow/core/framework/tensor.h"
 #include "tensorflow/core/framework/variant_op_registry.h"
 #include "tensorflow/core/kernels/dense_update_functor.h"
+#include "tensorflow/core/platform/blocking_counter.h"
 #include "tensorflow/core/platform/types.h"
 #include "tensorflow/core/util/determinism.h"
 #include "tensorflow/core/util/work_sharder.h"
@@ -179,6 +181,56 @@ struct ScatterFunctorBase {
           ParallelScatter);  // TODO: Come up with a good cost estimate.
     return bad_index;
   }
+  // Deterministic parallel path: copies and bounds-checks all indices up
+  // front, then partitions the destination rows across threads so that every
+  // row is owned by exactly one thread (row modulo shard count) and its
+  // updates are applied in the original index order. The result is
+  // bit-identical to SerialExecute -- including the accumulation order of
+  // duplicate indices -- at the cost of every thread scanning the full index
+  // vector.
+  Index ParallelDeterministicExecute(OpKernelContext* c, const Device& d,
+                                     typename TTypes<T>::Matrix params,
+                                     typename TTypes<T>::ConstMatrix updates,
+                                     typename TTypes<Index>::ConstFlat indices) {
+    const Index N = static_cast<Index>(indices.size());
+    const Index limit = static_cast<Index>(params.dimension(0));
+    // Copy each index before validating it, so a concurrent writer cannot
+    // swap in an out-of-bounds value between the check and the use, and so
+    // workers never re-read caller-owned index memory.
+    std::vector<Index> index_copy(N);
+    for (Index i = 0; i < N; ++i) {
+      const Index index = ::tensorflow::internal::SubtleMustCopy(indices(i));
+      if (!FastBoundsCheck(index, limit)) return i;
+      index_copy[i] = index;
+    }
+    const DeviceBase::CpuWorkerThreads& worker_threads =
+        *(c->device()->tensorflow_cpu_worker_threads());
+    const int num_shards = static_cast<int>(
+        std::min<Index>(worker_threads.num_threads, N));
+    auto scatter_shard = [&](int shard) {
+      for (Index i = 0; i < N; ++i) {
+        const Index index = index_copy[i];
+        if (index % num_shards != shard) continue;
+        scatter_op::internal::Assign<op>::Run(params.template chip<0>(index),
+                                              updates.template chip<0>(i));
+      }
+    };
+    if (num_shards <= 1) {
+      scatter_shard(0);
+      return -1;
+    }
+    BlockingCounter counter(num_shards - 1);
+    for (int shard = 1; shard < num_shards; ++shard) {
+      worker_threads.workers->Schedule([&scatter_shard, &counter, shard] {
+        scatter_shard(shard);
+        counter.DecrementCount();
+      });
+    }
+    scatter_shard(0);
+    counter.Wait();
+    return -1;
+  }
+
   Index SerialExecute(OpKernelContext* c, const Device& d,
                       typename TTypes<T>::Matrix params,
                       typename TTypes<T>::ConstMatrix updates,
@@ -221,11 +273,14 @@ struct ScatterFunctorBase {
     // come up with a rough heuristic and determine whether the updates execute
     // serially or parallelly. Also if 'N' is small, overheads of parallel
     // execution outweigh its benefits and hence we check the value of N.
-    const bool execute_serial = N < min_n_threshold ||
-                                (N / limit) > ser_par_ratio ||
-                                OpDeterminismRequired();
+    const bool execute_serial =
+        N < min_n_threshold || (N / limit) > ser_par_ratio;
     if (execute_serial)
       return SerialExecute(c, d, params, updates, indices);
+    else if (OpDeterminismRequired())
+      // Determinism used to force the serial path; the partitioned variant
+      // keeps the serial semantics while still using the thread pool.
+      return ParallelDeterministicExecute(c, d, params, updates, indices);
     else
       return ParallelExecute(c, d, params, updates, indices);
 #endif  // PLATFORM_GOOGLE
@@ -21,6 +21,7 @@ limitations under the License.
 #define EIGEN_USE_THREADS
 
 #include <atomic>
+#include <vector>
 
 #include "unsupported/Eigen/CXX11/Tensor"  // from @eigen_archive
 
@@ -102,6 +103,29 @@ class UpdateExecutor<T, Input, Update, Output, scatter_nd_op::UpdateOp::MAX> {
 
 namespace functor {
 
+// Applies one update slice in place with plain scalar loops. Worker threads
+// use this instead of UpdateExecutor because the latter evaluates through the
+// Eigen device, which must not be re-entered from inside the thread pool.
+template <scatter_nd_op::UpdateOp OP, typename T, typename Index>
+EIGEN_STRONG_INLINE void ApplyScatterNdUpdateSlice(T* out, const T* update,
+                                                   Index slice_size) {
+  if constexpr (OP == scatter_nd_op::UpdateOp::ASSIGN) {
+    for (Index j = 0; j < slice_size; ++j) out[j] = update[j];
+  } else if constexpr (OP == scatter_nd_op::UpdateOp::ADD) {
+    for (Index j = 0; j < slice_size; ++j) out[j] = out[j] + update[j];
+  } else if constexpr (OP == scatter_nd_op::UpdateOp::SUB) {
+    for (Index j = 0; j < slice_size; ++j) out[j] = out[j] - update[j];
+  } else if constexpr (OP == scatter_nd_op::UpdateOp::MIN) {
+    for (Index j = 0; j < slice_size; ++j) {
+      out[j] = Eigen::numext::mini(out[j], update[j]);
+    }
+  } else if constexpr (OP == scatter_nd_op::UpdateOp::MAX) {
+    for (Index j = 0; j < slice_size; ++j) {
+      out[j] = Eigen::numext::maxi(out[j], update[j]);
+    }
+  }
+}
+
 // Implementation of update functor for CPU.
 template <typename T, typename Index, scatter_nd_op::UpdateOp OP, int IXDIM>
 struct ScatterNdFunctor<CPUDevice, T, Index, OP, IXDIM> {
@@ -127,6 +151,60 @@ struct ScatterNdFunctor<CPUDevice, T, Index, OP, IXDIM> {
           batch_strides[dim + 1] * output_shape_prefix[dim + 1];
     }
 
+    // For large updates, partition the destination rows across the threads of
+    // the device's pool: every row is owned by exactly one thread (row modulo
+    // shard count), and each thread applies its rows' updates in the original
+    // index order. This keeps the result bit-identical to the serial loop
+    // below -- including the accumulation order of duplicate indices -- while
+    // scaling with cores. Each thread scans the full index vector, so the
+    // path only pays off when the slices carry most of the work.
+    constexpr Eigen::DenseIndex kMinParallelScatterNdElements = 64 << 10;
+    Eigen::ThreadPoolInterface* pool = d.getPool();
+    if (pool != nullptr && pool->NumThreads() > 1 && batch_size > 1 &&
+        batch_size * slice_size >= kMinParallelScatterNdElements) {
+      // Validate all indices and resolve them to flat destination rows up
+      // front, so the serial error semantics (first out-of-bounds location)
+      // are preserved and workers never re-read caller-owned index memory.
+      std::vector<Index> dest_row(batch_size);
+      for (Eigen::DenseIndex loc = 0; loc < batch_size; ++loc) {
+        Index i = 0;
+        bool out_of_bounds = false;
+        for (int dim = 0; dim < IXDIM; ++dim) {
+          const Index ix_d = internal::SubtleMustCopy(Tindices(loc, dim));
+          out_of_bounds |= !FastBoundsCheck(ix_d, output_shape_prefix[dim]);
+          i += ix_d * batch_strides[dim];
+        }
+        if (TF_PREDICT_FALSE(out_of_bounds)) {
+          return loc;
+        }
+        dest_row[loc] = i;
+      }
+      const int num_shards = static_cast<int>(std::min<Eigen::DenseIndex>(
+          pool->NumThreads(), batch_size));
+      T* const output_base = Toutput.data();
+      const T* const updates_base = Tupdates.data();
+      auto scatter_shard = [&dest_row, output_base, updates_base, batch_size,
+                            slice_size, num_shards](int shard) {
+        for (Eigen::DenseIndex loc = 0; loc < batch_size; ++loc) {
+          const Index row = dest_row[loc];
+          if (row % num_shards != shard) continue;
+          ApplyScatterNdUpdateSlice<OP>(output_base + row * slice_size,
+                                        updates_base + loc * slice_size,
+                                        slice_size);
+        }
+      };
+      Eigen::Barrier barrier(num_shards - 1);
+      for (int shard = 1; shard < num_shards; ++shard) {
+        pool->Schedule([&scatter_shard, &barrier, shard]() {
+          scatter_shard(shard);
+          barrier.Notify();
+        });
+      }
+      scatter_shard(0);
+      barrier.Wait();
+      return error_loc;
+    }
+
     for (Eigen::DenseIndex loc = 0; loc < batch_size; ++loc) {
       Index i = 0;
       bool out_of_bounds = false;
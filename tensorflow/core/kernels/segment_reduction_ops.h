@@ -28,6 +28,11 @@ class OpKernelContext;
 
 bool UseDeterministicSegmentReductions();
 bool DisableSegmentReductionOpDeterminismExceptions();
+// Whether unsorted segment reductions on GPU should avoid atomic operations
+// by sorting segment IDs and using tiled per-segment block reductions. This
+// trades a radix sort (skipped if the IDs already arrive sorted) for stable
+// performance when a few hot segments receive most of the contributions.
+bool UseAtomicsFreeSegmentReductions();
 
 // Type of SparseSegmentReduction operation to perform gradient of.
 enum class SparseSegmentReductionOperation { kSum, kMean, kSqrtN };
@@ -234,6 +234,57 @@ __global__ void UnsortedSegmentCustomKernel(
   }
 }
 
+// Sets *found_unsorted to 1 if any adjacent pair of segment IDs decreases.
+template <typename Tsegmentids>
+__global__ void SegmentIdsUnsortedKernel(
+    const int64_t size, const Tsegmentids* __restrict__ segment_ids,
+    int* __restrict__ found_unsorted) {
+  for (int64_t i : GpuGridRangeX(size - 1)) {
+    if (segment_ids[i] > segment_ids[i + 1]) {
+      GpuAtomicMax(found_unsorted, 1);
+    }
+  }
+}
+
+// Sets *out_sorted to true if segment_ids is non-decreasing. This synchronizes
+// the host with the device stream, so it is only worth calling when a sorted
+// layout lets us skip more expensive work (e.g. a radix sort).
+template <typename Tsegmentids>
+Status SegmentIdsSortedOnDevice(OpKernelContext* ctx,
+                                const Tsegmentids* segment_ids, int64_t size,
+                                bool* out_sorted) {
+  if (size <= 1) {
+    *out_sorted = true;
+    return OkStatus();
+  }
+  const GPUDevice& d = ctx->eigen_gpu_device();
+  se::Stream* stream = ctx->op_device_context()->stream();
+  Tensor found_unsorted_t;
+  TF_RETURN_IF_ERROR(
+      ctx->allocate_temp(DT_INT32, TensorShape({1}), &found_unsorted_t));
+  int* found_unsorted_ptr = found_unsorted_t.flat<int>().data();
+  se::DeviceMemoryBase found_unsorted_gpu_memory(found_unsorted_ptr,
+                                                 sizeof(int));
+  if (!stream->ThenMemZero(&found_unsorted_gpu_memory, sizeof(int)).ok()) {
+    return errors::Internal("Failed to zero found_unsorted");
+  }
+  GpuLaunchConfig config = GetGpuLaunchConfig(size - 1, d);
+  TF_RETURN_IF_ERROR(GpuLaunchKernel(SegmentIdsUnsortedKernel<Tsegmentids>,
+                                     config.block_count,
+                                     config.thread_per_block, 0, d.stream(),
+                                     size, segment_ids, found_unsorted_ptr));
+  ScratchSpace<int> found_unsorted_host(ctx, 1, /*on_host=*/true);
+  if (!stream
+           ->ThenMemcpy(found_unsorted_host.mutable_data(),
+                        found_unsorted_gpu_memory, sizeof(int))
+           .ok()) {
+    return errors::Internal("Failed to copy found_unsorted to host");
+  }
+  TF_RETURN_IF_ERROR(stream->BlockHostUntilDone());
+  *out_sorted = (*found_unsorted_host.data() == 0);
+  return OkStatus();
+}
+
 template <typename Toffsets, typename Tsegmentids>
 __global__ void SegmentOffsetsKernel(
     Toffsets size, Tsegmentids nsegments,
@@ -864,8 +915,14 @@ struct UnsortedSegmentFunctor<GPUDevice, T, Index, InitialValueF, ReductionF> {
         (!ReduceOpIsAssociative<ReductionF, T>::value &&
          OpDeterminismRequired());
 
+    // The sort-based kernels below avoid atomic operations entirely, which
+    // also makes them attractive (independently of determinism) when a few
+    // hot segments receive most of the contributions and atomics serialize.
+    bool use_atomics_free_kernels =
+        use_deterministic_kernels || UseAtomicsFreeSegmentReductions();
+
     bool determinism_requirement_met =
-        use_deterministic_kernels ||
+        use_atomics_free_kernels ||
         ReduceOpIsAssociative<ReductionF, T>::value ||
         !OpDeterminismRequired() ||
         DisableSegmentReductionOpDeterminismExceptions();
@@ -888,7 +945,7 @@ struct UnsortedSegmentFunctor<GPUDevice, T, Index, InitialValueF, ReductionF> {
     // TODO(benbarsdell): If there are no performance concerns with the new
     // deterministic kernels, remove this runtime check and the old
     // non-deterministic kernels.
-    if (!use_deterministic_kernels) {
+    if (!use_atomics_free_kernels) {
       // Set 'output' to initial value.
       GPUDevice d = ctx->template eigen_device<GPUDevice>();
       GpuLaunchConfig config = GetGpuLaunchConfig(output.size(), d);
@@ -907,30 +964,48 @@ struct UnsortedSegmentFunctor<GPUDevice, T, Index, InitialValueF, ReductionF> {
           input_outer_dim_size, input_inner_dim_size, output_outer_dim_size,
           unsorted_segment_ids.data(), data.data(), output.data()));
     } else {
-      // Allocate temporary space and sort segment_ids, then call the sorted
-      // implem.
+      const Index* segment_ids_ptr = unsorted_segment_ids.data();
+      const Index* sorted_indices_ptr = nullptr;
       Tensor segment_ids;
-      OP_REQUIRES_OK(
-          ctx, ctx->allocate_temp(
-                   DataTypeToEnum<Index>::value,
-                   TensorShape({static_cast<int64_t>(input_outer_dim_size)}),
-                   &segment_ids));
-      Index* segment_ids_ptr = segment_ids.flat<Index>().data();
       Tensor sorted_indices;
-      OP_REQUIRES_OK(
-          ctx, ctx->allocate_temp(
-                   DataTypeToEnum<Index>::value,
-                   TensorShape({static_cast<int64_t>(input_outer_dim_size)}),
-                   &sorted_indices));
-      Index* sorted_indices_ptr = sorted_indices.flat<Index>().data();
-      // Note: We must sort using all bits here because unsorted_segment_ids
-      // may contain negative values.
-      OP_REQUIRES_OK(
-          ctx, GpuRadixSort(ctx, input_outer_dim_size,
-                            /*keys_in=*/unsorted_segment_ids.data(),
-                            /*keys_out=*/segment_ids_ptr,
-                            /*indices_in=*/static_cast<const Index*>(nullptr),
-                            /*indices_out=*/sorted_indices_ptr));
+      // If the atomics-free mode was explicitly requested, probe whether the
+      // segment IDs already arrive sorted (common when the producer emits them
+      // in order) so that the radix sort can be skipped and input rows read
+      // directly. The probe synchronizes with the device, so it is not done
+      // for callers that only asked for determinism.
+      bool ids_already_sorted = false;
+      if (UseAtomicsFreeSegmentReductions()) {
+        OP_REQUIRES_OK(ctx, SegmentIdsSortedOnDevice(
+                                ctx, unsorted_segment_ids.data(),
+                                static_cast<int64_t>(input_outer_dim_size),
+                                &ids_already_sorted));
+      }
+      if (!ids_already_sorted) {
+        // Allocate temporary space and sort segment_ids, then call the sorted
+        // implem.
+        OP_REQUIRES_OK(
+            ctx, ctx->allocate_temp(
+                     DataTypeToEnum<Index>::value,
+                     TensorShape({static_cast<int64_t>(input_outer_dim_size)}),
+                     &segment_ids));
+        Index* sorted_segment_ids_ptr = segment_ids.flat<Index>().data();
+        OP_REQUIRES_OK(
+            ctx, ctx->allocate_temp(
+                     DataTypeToEnum<Index>::value,
+                     TensorShape({static_cast<int64_t>(input_outer_dim_size)}),
+                     &sorted_indices));
+        Index* permutation_ptr = sorted_indices.flat<Index>().data();
+        // Note: We must sort using all bits here because unsorted_segment_ids
+        // may contain negative values.
+        OP_REQUIRES_OK(
+            ctx, GpuRadixSort(ctx, input_outer_dim_size,
+                              /*keys_in=*/unsorted_segment_ids.data(),
+                              /*keys_out=*/sorted_segment_ids_ptr,
+                              /*indices_in=*/static_cast<const Index*>(nullptr),
+                              /*indices_out=*/permutation_ptr));
+        segment_ids_ptr = sorted_segment_ids_ptr;
+        sorted_indices_ptr = permutation_ptr;
+      }
       using Treduce = typename ReduceType<ReductionF, T>::type;
       using Tweights = typename RealTypeIfComplex<T>::type;
       OP_REQUIRES_OK(
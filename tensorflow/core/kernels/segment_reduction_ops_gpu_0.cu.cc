@@ -33,6 +33,17 @@ bool UseDeterministicSegmentReductions() {
   return cached_result;
 }
 
+bool UseAtomicsFreeSegmentReductions() {
+  static bool cached_result = [] {
+    bool result = false;
+    TF_CHECK_OK(tensorflow::ReadBoolFromEnvVar(
+        "TF_USE_ATOMICS_FREE_SEGMENT_REDUCTIONS",
+        /*default_val=*/false, &result));
+    return result;
+  }();
+  return cached_result;
+}
+
 bool DisableSegmentReductionOpDeterminismExceptions() {
   static bool cached_disable = [] {
     bool disable = false;
@@ -41,6 +41,7 @@ limitations under the License.
 #include "tensorflow/core/kernels/segment_reduction_ops.h"
 #include "tensorflow/core/lib/core/status.h"
 #include "tensorflow/core/platform/logging.h"
+#include "tensorflow/core/platform/prefetch.h"
 #include "tensorflow/core/util/determinism.h"
 #include "tensorflow/core/util/util.h"
 
@@ -593,7 +594,10 @@ class SparseSegmentReductionOpBase : public OpKernel {
 
     Tensor temp;
     if (input.dtype() == DT_BFLOAT16 || input.dtype() == DT_HALF) {
-      temp = tensorflow::Tensor(DT_FLOAT, output_shape);
+      // These types accumulate in float. Segments are reduced one at a time,
+      // so a single row of scratch space is sufficient; allocating the full
+      // output shape here would be the op's largest transient allocation.
+      temp = tensorflow::Tensor(DT_FLOAT, TensorShape({1, num_col}));
     }
     auto temp_flat = temp.flat_outer_dims<float>();
 
@@ -635,7 +639,7 @@ class SparseSegmentReductionOpBase : public OpKernel {
       }
 
       auto out = output_flat.template chip<0>(out_index);
-      auto temp = temp_flat.template chip<0>(out_index);
+      auto temp = temp_flat.template chip<0>(0);
       const int bad_offset = Reduce<T, Index>(input_flat, indices_vec, start,
                                               end - start, out, temp);
       OP_REQUIRES(context, bad_offset < 0,
@@ -823,6 +827,14 @@ class SparseSegmentReductionOpBase : public OpKernel {
         }
       }
       for (; r < num; r += 8) {
+        // Embedding rows are gathered at random; start pulling the next
+        // block's rows from DRAM while this block is accumulated.
+        if (r + 15 < num) {
+          for (int64_t p = r + 8; p < r + 16; ++p) {
+            port::prefetch<port::PREFETCH_HINT_T0>(
+                &input_flat(indices_vec(start + p), 0));
+          }
+        }
         INDEX(0, r);
         INDEX(1, r + 1);
         INDEX(2, r + 2);
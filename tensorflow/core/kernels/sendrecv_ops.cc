@@ -16,11 +16,15 @@ limitations under the License.
 #include "tensorflow/core/kernels/sendrecv_ops.h"
 
 #include <utility>
+#include <vector>
 
 #include "tensorflow/core/framework/attr_value.pb.h"
 #include "tensorflow/core/framework/op.h"
 #include "tensorflow/core/framework/op_def_util.h"
 #include "tensorflow/core/framework/op_kernel.h"
+#include "tensorflow/core/framework/variant.h"
+#include "tensorflow/core/framework/variant_encode_decode.h"
+#include "tensorflow/core/framework/variant_op_registry.h"
 #include "tensorflow/core/lib/strings/numbers.h"
 #include "tensorflow/core/lib/strings/strcat.h"
 #include "tensorflow/core/platform/logging.h"
@@ -246,4 +250,100 @@ static bool InitModule() {
 
 static bool module_initialized = InitModule();
 
+// The payload of a packed component transfer: all component tensors of a
+// composite value (e.g. the values and row splits of a ragged tensor) moved
+// through a single rendezvous item instead of one item per component.  The
+// _PackComponents/_UnpackComponents pairs carrying this variant are inserted
+// by graph partitioning; see PartitionOptions.pack_composite_transfers.
+struct PackedComponents {
+  std::vector<Tensor> components;
+
+  static const char kTypeName[];
+
+  string TypeName() const { return kTypeName; }
+
+  void Encode(VariantTensorData* data) const {
+    data->set_type_name(TypeName());
+    for (const Tensor& component : components) {
+      *data->add_tensors() = component;
+    }
+  }
+
+  bool Decode(const VariantTensorData& data) {
+    components = data.tensors();
+    return true;
+  }
+
+  string DebugString() const {
+    return strings::StrCat("PackedComponents[", components.size(), "]");
+  }
+};
+
+const char PackedComponents::kTypeName[] = "tensorflow::PackedComponents";
+
+REGISTER_UNARY_VARIANT_DECODE_FUNCTION(PackedComponents,
+                                       PackedComponents::kTypeName);
+
+namespace {
+
+class PackComponentsOp : public OpKernel {
+ public:
+  explicit PackComponentsOp(OpKernelConstruction* ctx) : OpKernel(ctx) {}
+
+  void Compute(OpKernelContext* ctx) override {
+    OpInputList components;
+    OP_REQUIRES_OK(ctx, ctx->input_list("components", &components));
+    PackedComponents packed;
+    packed.components.reserve(components.size());
+    for (int i = 0; i < components.size(); ++i) {
+      packed.components.push_back(components[i]);
+    }
+    Tensor* out = nullptr;
+    OP_REQUIRES_OK(ctx, ctx->allocate_output(0, TensorShape({}), &out));
+    out->scalar<Variant>()() = std::move(packed);
+  }
+};
+
+class UnpackComponentsOp : public OpKernel {
+ public:
+  explicit UnpackComponentsOp(OpKernelConstruction* ctx) : OpKernel(ctx) {}
+
+  void Compute(OpKernelContext* ctx) override {
+    const Tensor& packed_t = ctx->input(0);
+    OP_REQUIRES(ctx, TensorShapeUtils::IsScalar(packed_t.shape()),
+                errors::InvalidArgument(
+                    "Input to _UnpackComponents must be a scalar, got shape ",
+                    packed_t.shape().DebugString()));
+    const PackedComponents* packed =
+        packed_t.scalar<Variant>()().get<PackedComponents>();
+    OP_REQUIRES(ctx, packed != nullptr,
+                errors::InvalidArgument(
+                    "Input to _UnpackComponents is not a PackedComponents "
+                    "variant, got ",
+                    packed_t.scalar<Variant>()().TypeName()));
+    OP_REQUIRES(
+        ctx, static_cast<int>(packed->components.size()) == ctx->num_outputs(),
+        errors::InvalidArgument("Expected ", ctx->num_outputs(),
+                                " packed components, got ",
+                                packed->components.size()));
+    for (int i = 0; i < ctx->num_outputs(); ++i) {
+      const Tensor& component = packed->components[i];
+      OP_REQUIRES(
+          ctx, component.dtype() == ctx->expected_output_dtype(i),
+          errors::InvalidArgument(
+              "Packed component ", i, " has type ",
+              DataTypeString(component.dtype()), " but the output expects ",
+              DataTypeString(ctx->expected_output_dtype(i))));
+      ctx->set_output(i, component);
+    }
+  }
+};
+
+REGISTER_KERNEL_BUILDER(Name("_PackComponents").Device(DEVICE_CPU),
+                        PackComponentsOp);
+REGISTER_KERNEL_BUILDER(Name("_UnpackComponents").Device(DEVICE_CPU),
+                        UnpackComponentsOp);
+
+}  // namespace
+
 }  // end namespace tensorflow
@@ -57,7 +57,11 @@ struct SparseReorderFunctor<CPUDevice, T> {
         context, sparse::SparseTensor::Create(input_ind, input_val, input_shape,
                                               std_order, &input_sp));
 
-    if (input_sp.IndicesValid().ok()) {
+    auto* worker_threads = context->device()->tensorflow_cpu_worker_threads();
+    thread::ThreadPool* thread_pool =
+        worker_threads == nullptr ? nullptr : worker_threads->workers;
+
+    if (input_sp.IndicesValid(thread_pool).ok()) {
       context->set_output(0, input_sp.indices());
       context->set_output(1, input_sp.values());
     } else {
@@ -67,7 +71,7 @@ struct SparseReorderFunctor<CPUDevice, T> {
                      sparse::SparseTensor::Create(tensor::DeepCopy(input_ind),
                                                   tensor::DeepCopy(input_val),
                                                   input_shape, &reordered_sp));
-      reordered_sp.Reorder<T>(std_order);
+      reordered_sp.Reorder<T>(std_order, thread_pool);
       context->set_output(0, reordered_sp.indices());
       context->set_output(1, reordered_sp.values());
     }
@@ -19,11 +19,14 @@ limitations under the License.
 
 #include "tensorflow/core/kernels/sparse_tensor_dense_matmul_op.h"
 
+#include <vector>
+
 #include "tensorflow/core/framework/bounds_check.h"
 #include "tensorflow/core/framework/op.h"
 #include "tensorflow/core/framework/op_kernel.h"
 #include "tensorflow/core/kernels/fill_functor.h"
 #include "tensorflow/core/platform/bfloat16.h"
+#include "tensorflow/core/platform/blocking_counter.h"
 
 namespace tensorflow {
 
@@ -250,13 +253,123 @@ Status MOutOfBoundsError(int64_t m, std::size_t i, int lhs_index_a,
                                  "] out of bounds (>=", out_dim0, ")");
 }
 
+// Multiplies the COO entries of `a` against `b` after bucketing them by
+// output row into CSR-style row extents, then processes contiguous blocks of
+// output rows on the worker threads. Every output row is owned by exactly one
+// block, so the accumulations are race free, and block boundaries are chosen
+// by cumulative nnz rather than row count so that power-law row distributions
+// still load-balance. The bucketing is a stable counting sort, which keeps
+// each row's accumulation in the original entry order.
 template <typename T, typename Tsum, typename Tindices, bool ADJ_A, bool ADJ_B>
-Status SparseTensorDenseMatMulImpl(
+Status SparseTensorDenseMatMulParallelImpl(
+    const DeviceBase::CpuWorkerThreads& worker_threads,
     typename TTypes<Tsum>::Matrix out,
     typename TTypes<Tindices>::ConstMatrix a_indices,
     typename TTypes<T>::ConstVec a_values, typename TTypes<T>::ConstMatrix b) {
+  const std::size_t nnz = a_values.size();
+  const std::size_t lhs_right = (ADJ_B ? b.dimension(1) : b.dimension(0));
+  const int lhs_index_a = ADJ_A ? 1 : 0;
+  const int rhs_index_a = ADJ_A ? 0 : 1;
+  const int b_chip_index = ADJ_B ? 1 : 0;
+  const int64_t out_rows = out.dimension(0);
+
+  // Bounds-check every entry and copy its coordinates up front, preserving
+  // the serial path's first-error semantics and keeping the workers from
+  // re-reading caller-owned index memory after validation.
+  std::vector<Tindices> m_copy(nnz);
+  std::vector<Tindices> k_copy(nnz);
+  std::vector<std::size_t> row_ptr(out_rows + 1, 0);
+  for (std::size_t i = 0; i < nnz; ++i) {
+    const Tindices m = internal::SubtleMustCopy(a_indices(i, lhs_index_a));
+    const Tindices k = internal::SubtleMustCopy(a_indices(i, rhs_index_a));
+    if (!FastBoundsCheck(k, lhs_right)) {
+      return KOutOfBoundsError(k, i, rhs_index_a, lhs_right);
+    }
+    if (!FastBoundsCheck(m, out_rows)) {
+      return MOutOfBoundsError(m, i, lhs_index_a, out_rows);
+    }
+    m_copy[i] = m;
+    k_copy[i] = k;
+    ++row_ptr[m + 1];
+  }
+  for (int64_t r = 0; r < out_rows; ++r) {
+    row_ptr[r + 1] += row_ptr[r];
+  }
+  // Stable counting sort of entry ids by output row.
+  std::vector<std::size_t> perm(nnz);
+  {
+    std::vector<std::size_t> fill_pos(row_ptr.begin(), row_ptr.end() - 1);
+    for (std::size_t i = 0; i < nnz; ++i) {
+      perm[fill_pos[m_copy[i]]++] = i;
+    }
+  }
+
+  // Cut the row space into blocks of roughly equal nnz.
+  const std::size_t target_nnz_per_block =
+      (nnz + worker_threads.num_threads - 1) / worker_threads.num_threads;
+  std::vector<int64_t> block_bounds;
+  block_bounds.push_back(0);
+  std::size_t block_nnz = 0;
+  for (int64_t r = 0; r < out_rows; ++r) {
+    block_nnz += row_ptr[r + 1] - row_ptr[r];
+    if (block_nnz >= target_nnz_per_block && r + 1 < out_rows) {
+      block_bounds.push_back(r + 1);
+      block_nnz = 0;
+    }
+  }
+  block_bounds.push_back(out_rows);
+  const int num_blocks = static_cast<int>(block_bounds.size()) - 1;
+
+  auto run_blocks = [&](const auto& b_ref) {
+    auto process_block = [&](int block) {
+      for (int64_t r = block_bounds[block]; r < block_bounds[block + 1]; ++r) {
+        for (std::size_t idx = row_ptr[r]; idx < row_ptr[r + 1]; ++idx) {
+          const std::size_t i = perm[idx];
+          const Tindices k = k_copy[i];
+          const T a_value = (ADJ_A) ? MaybeConj(a_values(i)) : a_values(i);
+          out.template chip<0>(r) +=
+              b_ref.template chip<b_chip_index>(k).template cast<Tsum>() *
+              static_cast<Tsum>(a_value);
+        }
+      }
+    };
+    if (num_blocks <= 1) {
+      process_block(0);
+      return;
+    }
+    BlockingCounter counter(num_blocks - 1);
+    for (int block = 1; block < num_blocks; ++block) {
+      worker_threads.workers->Schedule([&process_block, &counter, block] {
+        process_block(block);
+        counter.DecrementCount();
+      });
+    }
+    process_block(0);
+    counter.Wait();
+  };
+
+  if (ADJ_B) {
+    // Perform transpose and conjugation on B once, since we chip out B's
+    // columns in the per-row loops.
+    Eigen::array<int, 2> shuffle(1, 0);  // preserve dimension order
+    Eigen::Tensor<T, 2, Eigen::ColMajor> col_major_conj_b =
+        b.swap_layout().shuffle(shuffle).conjugate();
+    run_blocks(col_major_conj_b);
+  } else {
+    run_blocks(b);
+  }
+  return OkStatus();
+}
+
+template <typename T, typename Tsum, typename Tindices, bool ADJ_A, bool ADJ_B>
+Status SparseTensorDenseMatMulImpl(
+    OpKernelContext* ctx, typename TTypes<Tsum>::Matrix out,
+    typename TTypes<Tindices>::ConstMatrix a_indices,
+    typename TTypes<T>::ConstVec a_values, typename TTypes<T>::ConstMatrix b) {
   // Vectorize certain operations above this size.
   static constexpr std::size_t kNumVectorize = 32;
+  // Bucket the COO entries by row and go parallel above this many entries.
+  static constexpr std::size_t kMinNnzToParallelize = std::size_t{1} << 15;
 
   const std::size_t nnz = a_values.size();
   const std::size_t rhs_right = (ADJ_B ? b.dimension(0) : b.dimension(1));
@@ -267,6 +380,19 @@ Status SparseTensorDenseMatMulImpl(
   // TODO(ebrevdo): After many failed experiments, can't find a multi-threaded
   // approach that achieves the performance of the single threaded
   // one.  Perhaps Eigen threadpool implementation is just too slow?
+  //
+  // Sharding the flat nnz loop indeed does not pay off: duplicate output rows
+  // force either atomics or locks. The parallel path below sidesteps that by
+  // bucketing entries by output row first so that threads own disjoint rows;
+  // it takes over for large, wide products where the bucketing cost amortizes.
+  const DeviceBase::CpuWorkerThreads* worker_threads =
+      ctx->device()->tensorflow_cpu_worker_threads();
+  if (worker_threads != nullptr && worker_threads->num_threads > 1 &&
+      nnz >= kMinNnzToParallelize && rhs_right >= kNumVectorize) {
+    return SparseTensorDenseMatMulParallelImpl<T, Tsum, Tindices, ADJ_A,
+                                               ADJ_B>(*worker_threads, out,
+                                                      a_indices, a_values, b);
+  }
 
   if (rhs_right < kNumVectorize) {
     // Disable vectorization if the RHS of output is too small
@@ -339,7 +465,7 @@ struct SparseTensorDenseMatMulFunctor<CPUDevice, T, Tindices, ADJ_A, ADJ_B> {
       temp_out.setZero();
       TF_RETURN_IF_ERROR(
           SparseTensorDenseMatMulImpl<T, Tsum, Tindices, ADJ_A, ADJ_B>(
-              temp_out, a_indices, a_values, b));
+              ctx, temp_out, a_indices, a_values, b));
       out = temp_out.template cast<T>();
     } else {
       out.setZero();
@@ -349,7 +475,7 @@ struct SparseTensorDenseMatMulFunctor<CPUDevice, T, Tindices, ADJ_A, ADJ_B> {
           *reinterpret_cast<typename TTypes<Tsum>::Matrix*>(&out);
       TF_RETURN_IF_ERROR(
           SparseTensorDenseMatMulImpl<T, Tsum, Tindices, ADJ_A, ADJ_B>(
-              out_workaround, a_indices, a_values, b));
+              ctx, out_workaround, a_indices, a_values, b));
     }
     return OkStatus();
   }
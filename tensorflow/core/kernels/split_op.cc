@@ -22,6 +22,7 @@ limitations under the License.
 #include "tensorflow/core/framework/op_kernel.h"
 #include "tensorflow/core/framework/register_types.h"
 #include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/kernels/chunked_copy.h"
 #include "tensorflow/core/kernels/ops_util.h"
 #include "tensorflow/core/kernels/split_lib.h"
 #include "tensorflow/core/lib/core/status.h"
@@ -231,6 +232,29 @@ class SplitOpCPU : public SplitOpBase<CPUDevice, T> {
 
     const int64_t split_dim_output_size = split_dim_size / num_split;
 
+    // Splitting along the outermost (effective) dimension makes every output
+    // a contiguous range of the input; copy those with the chunked copy
+    // engine, which parallelizes large copies and uses non-temporal stores
+    // for outputs that exceed the last-level cache.
+    if (prefix_dim_size == 1 && DataTypeCanUseMemcpy(DataTypeToEnum<T>::v())) {
+      const int64_t bytes_per_output =
+          split_dim_output_size * suffix_dim_size * sizeof(T);
+      TensorShape output_shape(input_shape);
+      output_shape.set_dim(split_dim, split_dim_output_size);
+      const char* in = input.tensor_data().data();
+      for (int i = 0; i < num_split; ++i) {
+        Tensor* result = nullptr;
+        OP_REQUIRES_OK(context,
+                       context->allocate_output(i, output_shape, &result));
+        if (bytes_per_output > 0) {
+          char* out = const_cast<char*>(result->tensor_data().data());
+          ChunkedParallelCopy(context->device(), out,
+                              in + i * bytes_per_output, bytes_per_output);
+        }
+      }
+      return;
+    }
+
     if (prefix_dim_size == 1) {
       auto input_reshaped =
           input.shaped<T, 2>({split_dim_size, suffix_dim_size});
@@ -13,6 +13,7 @@ See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
 
+#include <atomic>
 #include <cstddef>
 #include <deque>
 #include <mutex>
@@ -26,6 +27,7 @@ limitations under the License.
 #include "tensorflow/core/lib/strings/strcat.h"
 #include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/util/env_var.h"
 
 namespace tensorflow {
 namespace {
@@ -34,11 +36,28 @@ class Buffer : public ResourceBase {
  public:
   using Tuple = std::vector<Tensor>;
 
-  explicit Buffer(std::size_t capacity, std::size_t memory_limit)
+  // the Buffer takes ownership of the Tuple
+  virtual Status Put(Tuple* tuple) = 0;
+
+  // Get tuple at front of the buffer
+  virtual void Get(Tuple* tuple) = 0;
+
+  // Return tuple at index
+  virtual Status Peek(std::size_t index, Tuple* tuple) = 0;
+
+  // Buffer size
+  virtual std::size_t Size() = 0;
+
+  virtual void Clear() = 0;
+};
+
+class MutexBuffer : public Buffer {
+ public:
+  explicit MutexBuffer(std::size_t capacity, std::size_t memory_limit)
       : capacity_(capacity), memory_limit_(memory_limit), current_bytes_(0) {}
 
   // the Buffer takes ownership of the Tuple
-  Status Put(Tuple* tuple) {
+  Status Put(Tuple* tuple) override {
     std::unique_lock<std::mutex> lock(mu_);
 
     std::size_t tuple_bytes = GetTupleBytes(*tuple);
@@ -86,7 +105,7 @@ class Buffer : public ResourceBase {
   }
 
   // Get tuple at front of the buffer
-  void Get(Tuple* tuple) {  // TODO(zhifengc): Support cancellation.
+  void Get(Tuple* tuple) override {  // TODO(zhifengc): Support cancellation.
     std::unique_lock<std::mutex> lock(mu_);
 
     // Wait for data if the buffer is empty
@@ -103,7 +122,7 @@ class Buffer : public ResourceBase {
   }
 
   // Return tuple at index
-  Status Peek(std::size_t index, Tuple* tuple) {
+  Status Peek(std::size_t index, Tuple* tuple) override {
     std::unique_lock<std::mutex> lock(mu_);
 
     // Wait if the requested index is not available
@@ -119,12 +138,12 @@ class Buffer : public ResourceBase {
   }
 
   // Buffer size
-  size_t Size() {
+  std::size_t Size() override {
     std::unique_lock<std::mutex> lock(mu_);
     return buf_.size();
   }
 
-  void Clear() {
+  void Clear() override {
     std::unique_lock<std::mutex> lock(mu_);
     buf_.clear();
     current_bytes_ = 0;
@@ -176,6 +195,148 @@ class Buffer : public ResourceBase {
   std::deque<Tuple> buf_;
 };
 
+// Lock-free bounded single-producer single-consumer ring buffer for the
+// common double-buffered training setup, where exactly one thread stages and
+// one thread unstages. Put and Get synchronize through the monotonically
+// increasing head_/tail_ cursors, which live on separate cache lines so the
+// producer and consumer do not false-share; the mutex and condition variables
+// (a futex on Linux) are only touched when the ring is full or empty, or to
+// hand over a wakeup. StagePeek, StageSize and StageClear count as consumer
+// side operations.
+class SpscBuffer : public Buffer {
+ public:
+  explicit SpscBuffer(std::size_t capacity)
+      : capacity_(capacity), ring_(capacity), head_(0), tail_(0) {}
+
+  // the Buffer takes ownership of the Tuple. Producer side only.
+  Status Put(Tuple* tuple) override {
+    const std::size_t tail = tail_.load(std::memory_order_relaxed);
+
+    // Slow path: ring is full, wait until the consumer frees a slot.
+    if (tail - head_.load(std::memory_order_acquire) == capacity_) {
+      std::unique_lock<std::mutex> lock(mu_);
+      producer_waiting_.store(true, std::memory_order_seq_cst);
+      full_cond_var_.wait(lock, [tail, this]() {
+        return tail - head_.load(std::memory_order_seq_cst) < capacity_;
+      });
+      producer_waiting_.store(false, std::memory_order_relaxed);
+    }
+
+    ring_[tail % capacity_] = std::move(*tuple);
+    // Publish the element; sequential consistency orders this store against
+    // the consumer_waiting_ load below so a consumer that went to sleep after
+    // we published is always observed and woken.
+    tail_.store(tail + 1, std::memory_order_seq_cst);
+
+    if (consumer_waiting_.load(std::memory_order_seq_cst)) {
+      // Taking the mutex before notifying guarantees the consumer is either
+      // fully asleep or will re-check the cursors before sleeping.
+      { std::lock_guard<std::mutex> lock(mu_); }
+      non_empty_cond_var_.notify_all();
+    }
+
+    return OkStatus();
+  }
+
+  // Get tuple at front of the buffer. Consumer side only.
+  void Get(Tuple* tuple) override {
+    const std::size_t head = head_.load(std::memory_order_relaxed);
+    WaitForSize(head, 1);
+
+    *tuple = std::move(ring_[head % capacity_]);
+    // Release the slot back to the producer.
+    head_.store(head + 1, std::memory_order_seq_cst);
+
+    WakeProducer();
+  }
+
+  // Return tuple at index. Consumer side only, so the element cannot be
+  // overwritten while it is copied out.
+  Status Peek(std::size_t index, Tuple* tuple) override {
+    const std::size_t head = head_.load(std::memory_order_relaxed);
+    WaitForSize(head, index + 1);
+
+    for (const auto& tensor : ring_[(head + index) % capacity_]) {
+      tuple->push_back(tensor);
+    }
+
+    return OkStatus();
+  }
+
+  // Buffer size
+  std::size_t Size() override {
+    return tail_.load(std::memory_order_acquire) -
+           head_.load(std::memory_order_acquire);
+  }
+
+  // Consumer side only.
+  void Clear() override {
+    std::size_t head = head_.load(std::memory_order_relaxed);
+    const std::size_t tail = tail_.load(std::memory_order_acquire);
+    for (; head != tail; ++head) {
+      ring_[head % capacity_].clear();
+    }
+    head_.store(head, std::memory_order_seq_cst);
+
+    WakeProducer();
+  }
+
+  string DebugString() const override {
+    return strings::StrCat("Staging size: ",
+                           tail_.load(std::memory_order_acquire) -
+                               head_.load(std::memory_order_acquire));
+  }
+
+ private:
+  // Block the consumer until at least `size` elements are available.
+  void WaitForSize(std::size_t head, std::size_t size) {
+    if (tail_.load(std::memory_order_acquire) - head < size) {
+      std::unique_lock<std::mutex> lock(mu_);
+      consumer_waiting_.store(true, std::memory_order_seq_cst);
+      non_empty_cond_var_.wait(lock, [head, size, this]() {
+        return tail_.load(std::memory_order_seq_cst) - head >= size;
+      });
+      consumer_waiting_.store(false, std::memory_order_relaxed);
+    }
+  }
+
+  void WakeProducer() {
+    if (producer_waiting_.load(std::memory_order_seq_cst)) {
+      { std::lock_guard<std::mutex> lock(mu_); }
+      full_cond_var_.notify_all();
+    }
+  }
+
+  // Assumed size of a cache line; pessimistic so adjacent cursors never share
+  // one on common architectures.
+  static constexpr std::size_t kCacheLineSize = 64;
+
+  const std::size_t capacity_;
+  std::vector<Tuple> ring_;
+
+  // Consumer cursor: index of the next element to remove.
+  alignas(kCacheLineSize) std::atomic<std::size_t> head_;
+  // Producer cursor: index of the next free slot.
+  alignas(kCacheLineSize) std::atomic<std::size_t> tail_;
+
+  alignas(kCacheLineSize) std::atomic<bool> producer_waiting_{false};
+  std::atomic<bool> consumer_waiting_{false};
+  std::mutex mu_;
+  std::condition_variable non_empty_cond_var_;
+  std::condition_variable full_cond_var_;
+};
+
+// Selects the SPSC ring buffer for staging areas with a fixed capacity and no
+// memory limit. Opt-in via the environment because it requires at most one
+// concurrent producer (Stage) and one concurrent consumer (Unstage/StagePeek/
+// StageClear), which the kernels cannot verify.
+bool SpscStagingBufferEnabled() {
+  bool is_enabled = false;
+  TF_CHECK_OK(ReadBoolFromEnvVar("TF_STAGE_SPSC_BUFFER",
+                                 /*default_val=*/false, &is_enabled));
+  return is_enabled;
+}
+
 Status GetBuffer(OpKernelContext* ctx, const NodeDef& ndef, Buffer** buf) {
   auto rm = ctx->resource_manager();
   ContainerInfo cinfo;
@@ -186,7 +347,11 @@ Status GetBuffer(OpKernelContext* ctx, const NodeDef& ndef, Buffer** buf) {
     int64_t memory_limit;
     TF_RETURN_IF_ERROR(GetNodeAttr(ndef, "capacity", &capacity));
     TF_RETURN_IF_ERROR(GetNodeAttr(ndef, "memory_limit", &memory_limit));
-    *ret = new Buffer(capacity, memory_limit);
+    if (capacity > 0 && memory_limit == 0 && SpscStagingBufferEnabled()) {
+      *ret = new SpscBuffer(capacity);
+    } else {
+      *ret = new MutexBuffer(capacity, memory_limit);
+    }
     return OkStatus();
   };
 
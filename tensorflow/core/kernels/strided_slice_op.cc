@@ -143,6 +143,51 @@ class StridedSliceOp : public OpKernel {
       return;
     }
 
+    // Optimization #2b, simple slice that selects a memory-contiguous block
+    // of the input, e.g. a prefix along one dimension with every leading
+    // dimension pinned to a single index. Such a slice can share the input
+    // buffer just like the dim-0 case above; it only needs to be re-shaped
+    // through a flattened view first. Aliasing is safe because in-place
+    // buffer reuse elsewhere in the runtime is gated on the buffer having a
+    // single reference.
+    if (is_simple_slice && processing_shape.num_elements() > 0) {
+      int64_t first = 0;
+      int64_t last = 0;
+      for (int i = 0; i < input.dims(); ++i) {
+        first = first * input.dim_size(i) + begin[i];
+        last = last * input.dim_size(i) + (end[i] - 1);
+      }
+      const int64_t num_slice_elements = processing_shape.num_elements();
+      // The selected hyper-rectangle is contiguous iff it spans exactly
+      // num_slice_elements consecutive elements in row-major order.
+      const bool contiguous = last - first + 1 == num_slice_elements;
+#if EIGEN_MAX_ALIGN_BYTES == 0
+      const bool aligned = true;
+#else
+      // The view must start on an aligned address for downstream kernels
+      // that map the tensor with aligned Eigen accessors.
+      const bool aligned = (first * static_cast<int64_t>(sizeof(T))) %
+                               EIGEN_MAX_ALIGN_BYTES ==
+                           0;
+#endif
+      if (contiguous && aligned) {
+        VLOG(1) << "Strided slice contiguous view: "
+                << input.shape().DebugString();
+        Tensor flat_input;
+        OP_REQUIRES(context,
+                    flat_input.CopyFrom(input,
+                                        TensorShape({input.NumElements()})),
+                    errors::Internal("Copy failed"));
+        Tensor slice =
+            flat_input.Slice(first, first + num_slice_elements);
+        Tensor tmp;
+        OP_REQUIRES(context, tmp.CopyFrom(slice, final_shape),
+                    errors::Internal("Copy failed"));
+        context->set_output(0, tmp);
+        return;
+      }
+    }
+
     Tensor* result = nullptr;
     OP_REQUIRES_OK(context, context->allocate_output(0, final_shape, &result));
     const int input_dims = input.dims();
@@ -20,6 +20,7 @@ limitations under the License.
 #include "tensorflow/core/framework/kernel_def_builder.h"
 #include "tensorflow/core/framework/op_kernel.h"
 #include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/kernels/string_tensor_arena.h"
 #include "tensorflow/core/lib/core/errors.h"
 #include "tensorflow/core/lib/core/status.h"
 #include "tensorflow/core/lib/core/stringpiece.h"
@@ -213,26 +214,29 @@ class StringSplitOp : public OpKernel {
     Tensor* sp_indices_t;
     OP_REQUIRES_OK(ctx, ctx->allocate_output(0, TensorShape({output_size, 2}),
                                              &sp_indices_t));
-    Tensor* sp_tokens_t;
-    OP_REQUIRES_OK(
-        ctx, ctx->allocate_output(1, TensorShape({output_size}), &sp_tokens_t));
     Tensor* sp_shape_t;
     OP_REQUIRES_OK(ctx, ctx->allocate_output(2, TensorShape({2}), &sp_shape_t));
 
     auto sp_indices = sp_indices_t->matrix<int64_t>();
-    auto sp_tokens = sp_tokens_t->vec<tstring>();
     auto sp_shape = sp_shape_t->vec<int64_t>();
     sp_shape(0) = batch_size;
     sp_shape(1) = max_num_entries;
+    // Copy all tokens into one shared character arena instead of giving each
+    // output element its own heap allocation.
+    StringTensorArena arena(output_size);
     size_t c = 0;
     for (size_t i = 0; i < batch_size; ++i) {
       for (size_t j = 0; j < num_indices[i]; ++j) {
         sp_indices(c, 0) = i;
         sp_indices(c, 1) = j;
-        sp_tokens(c).assign(tokens[c].data(), tokens[c].size());
+        arena.Add(tokens[c]);
         ++c;
       }
     }
+    Tensor sp_tokens_t;
+    OP_REQUIRES_OK(ctx,
+                   arena.Finalize(TensorShape({output_size}), &sp_tokens_t));
+    ctx->set_output(1, sp_tokens_t);
   }
 
  private:
@@ -283,26 +287,29 @@ class StringSplitV2Op : public OpKernel {
     Tensor* sp_indices_t;
     OP_REQUIRES_OK(ctx, ctx->allocate_output(0, TensorShape({output_size, 2}),
                                              &sp_indices_t));
-    Tensor* sp_tokens_t;
-    OP_REQUIRES_OK(
-        ctx, ctx->allocate_output(1, TensorShape({output_size}), &sp_tokens_t));
     Tensor* sp_shape_t;
     OP_REQUIRES_OK(ctx, ctx->allocate_output(2, TensorShape({2}), &sp_shape_t));
 
     auto sp_indices = sp_indices_t->matrix<int64_t>();
-    auto sp_tokens = sp_tokens_t->vec<tstring>();
     auto sp_shape = sp_shape_t->vec<int64_t>();
     sp_shape(0) = batch_size;
     sp_shape(1) = max_num_entries;
+    // Copy all tokens into one shared character arena instead of giving each
+    // output element its own heap allocation.
+    StringTensorArena arena(output_size);
     size_t c = 0;
     for (size_t i = 0; i < batch_size; ++i) {
       for (size_t j = 0; j < num_indices[i]; ++j) {
         sp_indices(c, 0) = i;
         sp_indices(c, 1) = j;
-        sp_tokens(c).assign(tokens[c].data(), tokens[c].size());
+        arena.Add(tokens[c]);
         ++c;
       }
     }
+    Tensor sp_tokens_t;
+    OP_REQUIRES_OK(ctx,
+                   arena.Finalize(TensorShape({output_size}), &sp_tokens_t));
+    ctx->set_output(1, sp_tokens_t);
   }
 
  private:
@@ -0,0 +1,114 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/kernels/string_tensor_arena.h"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <utility>
+
+#include "tensorflow/core/framework/allocation_description.pb.h"
+#include "tensorflow/core/framework/allocator.h"
+#include "tensorflow/core/framework/types.pb.h"
+#include "tensorflow/core/lib/core/errors.h"
+#include "tensorflow/core/lib/core/refcount.h"
+#include "tensorflow/core/platform/mem.h"
+
+namespace tensorflow {
+namespace {
+
+// Owns the block holding the tstring array and the character arena the
+// elements point into.
+class ArenaStringTensorBuffer : public TensorBuffer {
+ public:
+  ArenaStringTensorBuffer(void* data, size_t size, int64_t num_elements)
+      : TensorBuffer(data), size_(size), num_elements_(num_elements) {}
+
+  ~ArenaStringTensorBuffer() override {
+    // Destroying a view is a no-op; this only releases heap storage for
+    // elements a consumer has since overwritten in place.
+    tstring* elements = base<tstring>();
+    for (int64_t i = 0; i < num_elements_; ++i) {
+      elements[i].~tstring();
+    }
+    port::AlignedFree(data());
+  }
+
+  size_t size() const override { return size_; }
+
+  TensorBuffer* root_buffer() override { return this; }
+
+  void FillAllocationDescription(AllocationDescription* proto) const override {
+    proto->set_requested_bytes(static_cast<int64_t>(size_));
+    proto->set_allocator_name("string_tensor_arena");
+    proto->set_ptr(reinterpret_cast<uintptr_t>(data()));
+  }
+
+ private:
+  size_t size_;
+  int64_t num_elements_;
+};
+
+}  // namespace
+
+StringTensorArena::StringTensorArena(int64_t num_elements,
+                                     int64_t expected_bytes) {
+  sizes_.reserve(num_elements);
+  if (expected_bytes > 0) {
+    chars_.reserve(expected_bytes);
+  }
+}
+
+void StringTensorArena::Add(StringPiece element) {
+  chars_.append(element.data(), element.size());
+  // NUL-terminate each element so views satisfy c_str() like owned strings.
+  chars_.push_back('\0');
+  sizes_.push_back(element.size());
+}
+
+Status StringTensorArena::Finalize(const TensorShape& shape, Tensor* out) {
+  const int64_t num_elements = sizes_.size();
+  if (shape.num_elements() != num_elements) {
+    return errors::Internal("StringTensorArena holds ", num_elements,
+                            " elements but output shape ",
+                            shape.DebugString(), " requires ",
+                            shape.num_elements());
+  }
+  const size_t header_bytes = num_elements * sizeof(tstring);
+  const size_t total_bytes = header_bytes + chars_.size();
+  void* data = port::AlignedMalloc(std::max<size_t>(total_bytes, 1),
+                                   Allocator::kAllocatorAlignment);
+  if (data == nullptr) {
+    return errors::ResourceExhausted(
+        "Failed to allocate string tensor arena of ", total_bytes, " bytes");
+  }
+  char* arena = static_cast<char*>(data) + header_bytes;
+  std::memcpy(arena, chars_.data(), chars_.size());
+  tstring* elements = static_cast<tstring*>(data);
+  size_t offset = 0;
+  for (int64_t i = 0; i < num_elements; ++i) {
+    new (&elements[i]) tstring();
+    elements[i].assign_as_view(arena + offset, sizes_[i]);
+    offset += sizes_[i] + 1;  // Skip the NUL terminator.
+  }
+  core::RefCountPtr<TensorBuffer> buf(
+      new ArenaStringTensorBuffer(data, total_bytes, num_elements));
+  *out = Tensor(DT_STRING, shape, std::move(buf));
+  chars_.clear();
+  sizes_.clear();
+  return OkStatus();
+}
+
+}  // namespace tensorflow
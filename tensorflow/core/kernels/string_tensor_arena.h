@@ -0,0 +1,58 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_CORE_KERNELS_STRING_TENSOR_ARENA_H_
+#define TENSORFLOW_CORE_KERNELS_STRING_TENSOR_ARENA_H_
+
+#include <vector>
+
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/lib/core/status.h"
+#include "tensorflow/core/lib/core/stringpiece.h"
+#include "tensorflow/core/platform/types.h"
+
+namespace tensorflow {
+
+// Builds a DT_STRING Tensor whose elements all live in one contiguous
+// character arena, instead of each tstring owning a separate heap block.
+// Kernels that produce many strings per batch append elements in flat index
+// order with Add() and then call Finalize(), which allocates a single buffer
+// holding the tstring array followed by the character data and fills the
+// elements as views into it. The buffer keeps the arena alive for as long as
+// any copy of the tensor exists; each element is NUL-terminated in the arena
+// so c_str() behaves like an owned string. Consumers may still overwrite
+// individual elements in place, which converts them back to owned storage.
+class StringTensorArena {
+ public:
+  // `num_elements` is the expected number of Add() calls; `expected_bytes`,
+  // if positive, pre-reserves arena capacity for the character data.
+  explicit StringTensorArena(int64_t num_elements, int64_t expected_bytes = 0);
+
+  // Appends the next element in flat index order. The bytes are copied, so
+  // `element` need only be valid for the duration of the call.
+  void Add(StringPiece element);
+
+  // Produces a tensor of `shape` from the added elements and resets the
+  // arena. Fails if the number of elements added does not match `shape`.
+  Status Finalize(const TensorShape& shape, Tensor* out);
+
+ private:
+  string chars_;
+  std::vector<size_t> sizes_;
+};
+
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_KERNELS_STRING_TENSOR_ARENA_H_
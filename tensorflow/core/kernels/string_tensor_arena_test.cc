@@ -0,0 +1,74 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/kernels/string_tensor_arena.h"
+
+#include <cstring>
+#include <string>
+
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace {
+
+TEST(StringTensorArenaTest, ElementsShareOneArena) {
+  StringTensorArena arena(3);
+  arena.Add("short");
+  arena.Add("");
+  // Long enough to defeat tstring's small string optimization.
+  const std::string long_element(100, 'x');
+  arena.Add(long_element);
+
+  Tensor result;
+  TF_ASSERT_OK(arena.Finalize(TensorShape({3}), &result));
+  auto flat = result.vec<tstring>();
+  EXPECT_EQ(flat(0), "short");
+  EXPECT_EQ(flat(1), "");
+  EXPECT_EQ(flat(2), long_element);
+  // Elements are NUL-terminated views laid out back to back in one buffer.
+  EXPECT_EQ(flat(0).c_str()[flat(0).size()], '\0');
+  EXPECT_EQ(flat(2).data(), flat(0).data() + flat(0).size() + 2);
+
+  // Copies of the tensor share the arena; the data survives the original.
+  Tensor copy = result;
+  result = Tensor();
+  EXPECT_EQ(copy.vec<tstring>()(2), long_element);
+}
+
+TEST(StringTensorArenaTest, OverwritingAnElementInPlaceIsSafe) {
+  StringTensorArena arena(2);
+  arena.Add("first");
+  arena.Add("second");
+  Tensor result;
+  TF_ASSERT_OK(arena.Finalize(TensorShape({2}), &result));
+  // Assigning converts the view back to an owned string without touching the
+  // neighboring element.
+  result.vec<tstring>()(0) = std::string(50, 'y');
+  EXPECT_EQ(result.vec<tstring>()(0), std::string(50, 'y'));
+  EXPECT_EQ(result.vec<tstring>()(1), "second");
+}
+
+TEST(StringTensorArenaTest, FinalizeRejectsShapeMismatch) {
+  StringTensorArena arena(2);
+  arena.Add("a");
+  arena.Add("b");
+  Tensor result;
+  EXPECT_FALSE(arena.Finalize(TensorShape({3}), &result).ok());
+}
+
+}  // namespace
+}  // namespace tensorflow
@@ -20,9 +20,11 @@ limitations under the License.
 #include "tensorflow/core/lib/core/refcount.h"
 #include "tensorflow/core/lib/db/sqlite.h"
 #include "tensorflow/core/platform/protobuf.h"
+#include "tensorflow/core/summary/async_summary_writer.h"
 #include "tensorflow/core/summary/schema.h"
 #include "tensorflow/core/summary/summary_db_writer.h"
 #include "tensorflow/core/summary/summary_file_writer.h"
+#include "tensorflow/core/util/env_var.h"
 #include "tensorflow/core/util/event.pb.h"
 
 namespace tensorflow {
@@ -59,9 +61,22 @@ class CreateSummaryFileWriterOp : public OpKernel {
                             ctx, HandleFromInput(ctx, 0), &s,
                             [max_queue, flush_millis, logdir, filename_suffix,
                              ctx](SummaryWriterInterface** s) {
-                              return CreateSummaryFileWriter(
+                              TF_RETURN_IF_ERROR(CreateSummaryFileWriter(
                                   max_queue, flush_millis, logdir,
-                                  filename_suffix, ctx->env(), s);
+                                  filename_suffix, ctx->env(), s));
+                              // Opt-in: move serialization and file I/O off
+                              // the training step onto a background thread.
+                              // Flush remains a full barrier.
+                              bool async_writes = false;
+                              TF_RETURN_IF_ERROR(ReadBoolFromEnvVar(
+                                  "TF_SUMMARY_ASYNC_WRITES",
+                                  /*default_val=*/false, &async_writes));
+                              if (async_writes) {
+                                SummaryWriterInterface* file_writer = *s;
+                                return CreateAsyncSummaryWriter(
+                                    file_writer, max_queue, ctx->env(), s);
+                              }
+                              return OkStatus();
                             }));
   }
 };
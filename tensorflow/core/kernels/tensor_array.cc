@@ -20,6 +20,7 @@ limitations under the License.
 #include "tensorflow/core/framework/register_types.h"
 #include "tensorflow/core/framework/tensor_util.h"
 #include "tensorflow/core/kernels/aggregate_ops_cpu.h"
+#include "tensorflow/core/util/env_var.h"
 
 namespace tensorflow {
 
@@ -77,10 +78,48 @@ TF_CALL_COMPLEX_TYPES(TENSOR_ARRAY_SET_ZERO_GPU);
 
 #undef TENSOR_ARRAY_SET_ZERO
 
+bool ContiguousStorageEnabled() {
+  bool is_enabled = false;
+  TF_CHECK_OK(ReadBoolFromEnvVar("TF_TENSOR_ARRAY_CONTIGUOUS",
+                                 /*default_val=*/false, &is_enabled));
+  return is_enabled;
+}
+
 }  // namespace tensor_array
 
 std::atomic<int64_t> TensorArray::tensor_array_counter{0};
 
+Status TensorArray::TryPackView(const std::vector<int32>& indices,
+                                Tensor* value, bool* is_view) {
+  mutex_lock l(mu_);
+  *is_view = false;
+  TF_RETURN_IF_ERROR(LockedReturnIfClosed());
+  const int64_t n = static_cast<int64_t>(indices.size());
+  if (!use_contiguous_ || n == 0 || n > contiguous_capacity_ ||
+      static_cast<size_t>(n) > tensors_.size()) {
+    return OkStatus();
+  }
+  for (int64_t i = 0; i < n; ++i) {
+    if (indices[i] != i) return OkStatus();
+    const TensorAndState& t = tensors_[i];
+    if (!t.in_buffer || t.cleared) return OkStatus();
+  }
+  // The requested elements are exactly the leading rows of the shared
+  // buffer; hand out a view instead of copying each element.  The rows are
+  // write-once, so the view cannot be invalidated by later writes.
+  *value = contiguous_buffer_.Slice(0, n);
+  for (int64_t i = 0; i < n; ++i) {
+    TensorAndState& t = tensors_[i];
+    if (clear_after_read_) {
+      t.tensor = Tensor();
+      t.cleared = true;
+    }
+    t.read = true;
+  }
+  *is_view = true;
+  return OkStatus();
+}
+
 Status TensorArray::CopyShapesFrom(TensorArray* rhs,
                                    const TensorShape* shape_to_prepend) {
   mutex_lock l(mu_);
@@ -18,6 +18,9 @@ limitations under the License.
 
 #include <limits.h>
 
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
 #include <vector>
 
 #include "tensorflow/core/framework/op_kernel.h"
@@ -96,6 +99,12 @@ TF_CALL_COMPLEX_TYPES(TENSOR_ARRAY_SET_ZERO_GPU);
 
 #undef TENSOR_ARRAY_SET_ZERO
 
+// Returns true if newly created TensorArrays should back their elements with
+// a single contiguous buffer when possible (see TensorArray below).  Reads
+// the TF_TENSOR_ARRAY_CONTIGUOUS environment variable on every call so a
+// long-running binary can flip it between steps.
+bool ContiguousStorageEnabled();
+
 }  // namespace tensor_array
 
 // The TensorArray object keeps an array of Tensors.  It allows reading from the
@@ -114,6 +123,11 @@ TF_CALL_COMPLEX_TYPES(TENSOR_ARRAY_SET_ZERO_GPU);
 //     All operations on a TensorArray are thread-safe.
 //   * A TensorArray may be preemptively closed, which releases all
 //     memory associated with it.
+//   * When contiguous storage is enabled (see TF_TENSOR_ARRAY_CONTIGUOUS),
+//     write-once CPU arrays with a fully defined element shape keep their
+//     elements as rows of a single growable buffer written in place, and
+//     packing or gathering the leading elements returns a view of that
+//     buffer instead of concatenating per-element copies.
 //
 // These properties together allow the TensorArray to work as a
 // functional object and makes gradient computation easy.  For
@@ -153,7 +167,10 @@ class TensorArray : public ResourceBase {
         marked_size_(marked_size),
         element_shape_(element_shape),
         identical_element_shapes_(identical_element_shapes),
-        tensors_(N) {}
+        tensors_(N),
+        use_contiguous_(!is_grad && !multiple_writes_aggregate &&
+                        tensor_array::ContiguousStorageEnabled()),
+        contiguous_capacity_(0) {}
 
   // Write Tensor 'value' to index 'index'.
   //
@@ -241,6 +258,15 @@ class TensorArray : public ResourceBase {
     return OkStatus();
   }
 
+  // If contiguous storage is in use and 'indices' requests exactly the
+  // leading elements of the array in order, returns in '*value' a Tensor of
+  // shape [indices.size()] + element_shape that aliases the shared buffer
+  // and sets '*is_view' to true.  Otherwise '*value' is left untouched and
+  // '*is_view' is set to false so the caller can fall back to element-wise
+  // reads.  Elements covered by the view are marked as read.
+  Status TryPackView(const std::vector<int32>& indices, Tensor* value,
+                     bool* is_view);
+
   DataType ElemType() const { return dtype_; }
 
   PartialTensorShape ElemShape() {
@@ -338,6 +364,7 @@ class TensorArray : public ResourceBase {
   void ClearAndMarkClosed() {
     mutex_lock l(mu_);
     tensors_.clear();
+    contiguous_buffer_ = Tensor();
     closed_ = true;
   }
 
@@ -362,6 +389,19 @@ class TensorArray : public ResourceBase {
   Status LockedRead(OpKernelContext* ctx, const int32_t index, Tensor* value)
       TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
 
+  // Tries to store 'value' in place as row 'index' of the shared contiguous
+  // buffer, growing the buffer if necessary.  Returns true if the value was
+  // stored there; on false the caller falls back to keeping a per-element
+  // reference.  The first write decides whether contiguous storage is
+  // usable: it requires a fully defined element shape and a trivially
+  // copyable element type on CPU.  Once a write cannot use the buffer,
+  // contiguous storage is switched off for the whole array so that every
+  // element lives in the same kind of storage.
+  template <typename Device, typename T>
+  bool LockedWriteContiguous(OpKernelContext* ctx, const int32_t index,
+                             const Tensor* value)
+      TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
   Status LockedReturnIfClosed() const TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
     if (closed_) {
       return errors::InvalidArgument("TensorArray ", handle_.vec<tstring>()(1),
@@ -417,7 +457,11 @@ class TensorArray : public ResourceBase {
   // they have already been read or not.
   struct TensorAndState {
     TensorAndState()
-        : written(false), read(false), cleared(false), local_copy(false) {}
+        : written(false),
+          read(false),
+          cleared(false),
+          in_buffer(false),
+          local_copy(false) {}
     Tensor tensor;
     TensorShape shape;
     bool written;  // True if a Tensor has been written to the index.
@@ -425,6 +469,10 @@ class TensorArray : public ResourceBase {
     bool cleared;  // True if a tensor has been read with
                    // clear_after_read = true;
 
+    // True if the value lives as a row of contiguous_buffer_ rather than in
+    // 'tensor' (see LockedWriteContiguous).
+    bool in_buffer;
+
     // Used by writes when multiple_writes_aggregate is true.  In this
     // case, the first time a value is written, it is a shallow copy.
     // The second time a value is written, it is aggregated.  However,
@@ -435,6 +483,18 @@ class TensorArray : public ResourceBase {
   };
   // The list of underlying Tensors and states.
   std::vector<TensorAndState> tensors_ TF_GUARDED_BY(mu_);
+
+  // When true, elements may be stored as rows of contiguous_buffer_ rather
+  // than as individual Tensors (see LockedWriteContiguous).  Switched off
+  // permanently as soon as a write cannot use the buffer.
+  bool use_contiguous_ TF_GUARDED_BY(mu_);
+
+  // The shared buffer of shape [contiguous_capacity_] + element_shape
+  // backing the elements with in_buffer == true.  Rows are write-once, so a
+  // previously handed out view is never invalidated by later writes; growth
+  // reallocates the buffer but old views keep the old allocation alive.
+  Tensor contiguous_buffer_ TF_GUARDED_BY(mu_);
+  int64_t contiguous_capacity_ TF_GUARDED_BY(mu_);
 };
 
 template <typename Device, typename T>
@@ -532,13 +592,71 @@ Status TensorArray::LockedWriteOrAggregate(OpKernelContext* ctx,
     // TensorArray.
     gradients_disallowed_ = true;
   } else {
-    t.tensor = *value;
+    t.in_buffer = LockedWriteContiguous<Device, T>(ctx, index, value);
+    if (!t.in_buffer) {
+      t.tensor = *value;
+    }
     t.shape = value->shape();
     t.written = true;
   }
   return OkStatus();
 }
 
+template <typename Device, typename T>
+bool TensorArray::LockedWriteContiguous(OpKernelContext* ctx,
+                                        const int32_t index,
+                                        const Tensor* value) {
+  if constexpr (!std::is_same<Device, CPUDevice>::value ||
+                !std::is_trivially_copyable<T>::value) {
+    use_contiguous_ = false;
+    return false;
+  } else {
+    if (!use_contiguous_) return false;
+    // The caller has already merged value->shape() into element_shape_, so
+    // with identical_element_shapes_ the shape is fully defined from the
+    // first write on.
+    if (!element_shape_.IsFullyDefined()) {
+      use_contiguous_ = false;
+      return false;
+    }
+    TensorShape element_shape;
+    element_shape_.AsTensorShape(&element_shape);  // Always succeeds.
+    if (value->shape() != element_shape) {
+      use_contiguous_ = false;
+      return false;
+    }
+    if (index >= contiguous_capacity_) {
+      // Fixed-size arrays get their full extent up front so a later pack is
+      // a single view of the whole buffer; dynamically sized arrays grow
+      // geometrically for amortized constant-time writes.
+      const int64_t new_capacity =
+          dynamic_size_ ? std::max<int64_t>(2 * contiguous_capacity_,
+                                            static_cast<int64_t>(index) + 1)
+                        : static_cast<int64_t>(tensors_.size());
+      TensorShape buffer_shape = element_shape;
+      buffer_shape.InsertDim(0, new_capacity);
+      Tensor new_buffer;
+      if (!ctx->allocate_temp(dtype_, buffer_shape, &new_buffer).ok()) {
+        use_contiguous_ = false;
+        return false;
+      }
+      if (contiguous_capacity_ > 0) {
+        std::memcpy(new_buffer.flat<T>().data(),
+                    contiguous_buffer_.flat<T>().data(),
+                    contiguous_buffer_.NumElements() * sizeof(T));
+      }
+      contiguous_buffer_ = new_buffer;
+      contiguous_capacity_ = new_capacity;
+    }
+    const int64_t num_elements = element_shape.num_elements();
+    if (num_elements > 0) {
+      std::memcpy(contiguous_buffer_.flat<T>().data() + index * num_elements,
+                  value->flat<T>().data(), num_elements * sizeof(T));
+    }
+    return true;
+  }
+}
+
 template <typename Device, typename T>
 Status TensorArray::LockedRead(OpKernelContext* ctx, const int32_t index,
                                Tensor* value) {
@@ -601,6 +719,22 @@ Status TensorArray::LockedRead(OpKernelContext* ctx, const int32_t index,
                                    "clear_after_read = false?).");
   }
 
+  if (t.in_buffer && !t.tensor.IsInitialized()) {
+    // The value lives in a row of the shared contiguous buffer.  Alias the
+    // row when it is suitably aligned; otherwise fall back to a copy so
+    // callers always receive an aligned tensor.
+    Tensor row = contiguous_buffer_.Slice(index, index + 1);
+    Tensor element;
+    CHECK(element.CopyFrom(row, t.shape));
+    if (element.IsAligned()) {
+      t.tensor = element;
+    } else {
+      TF_RETURN_IF_ERROR(ctx->allocate_temp(dtype_, t.shape, &t.tensor));
+      std::memcpy(t.tensor.flat<T>().data(), element.flat<T>().data(),
+                  element.NumElements() * sizeof(T));
+    }
+  }
+
   if (!t.tensor.IsInitialized() || t.tensor.NumElements() == 0) {
     // We stored just a shape, but no value.  This means create and
     // return zeros of the appropriate shape.
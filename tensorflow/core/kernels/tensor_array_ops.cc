@@ -705,6 +705,20 @@ class TensorArrayPackOrGatherOp : public OpKernel {
       return;
     }
 
+    // If the array is backed by contiguous storage and the request is for
+    // the leading elements in order, return a view of the shared buffer
+    // instead of reading and concatenating every element.
+    {
+      Tensor packed;
+      bool is_view = false;
+      OP_REQUIRES_OK(ctx,
+                     tensor_array->TryPackView(indices, &packed, &is_view));
+      if (is_view) {
+        ctx->set_output(0, packed);
+        return;
+      }
+    }
+
     // Read all the Tensors into a vector to keep track of their memory.
     Status s = tensor_array->ReadMany<Device, T>(ctx, indices, &values);
     OP_REQUIRES_OK(ctx, s);
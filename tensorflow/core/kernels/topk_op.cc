@@ -161,7 +161,19 @@ struct TopKFunctor<CPUDevice, T, Tidx> {
       return OkStatus();
     }
 
+    // For large k, partition-based selection beats the heap: one
+    // nth_element pass moves the top k to the front in O(num_cols)
+    // mostly-branchless partitioning steps that compilers vectorize well,
+    // and only those k entries are then sorted. The heap, by contrast,
+    // performs a branchy O(log k) sift per column. The crossover is fuzzy;
+    // 100 is conservative enough that the heap keeps its cache-friendliness
+    // advantage for small k.
+    constexpr int kSelectionThreshold = 100;
+    const bool use_selection = k >= kSelectionThreshold && k < num_cols;
+
     auto SortIndices = [&](int64_t start_batch, int64_t limit_batch) {
+      std::vector<Tidx> col_indices;
+      if (use_selection) col_indices.resize(num_cols);
       for (int32_t b = start_batch; b < limit_batch; ++b) {
         const T* input_data = &input(b, 0);
         const auto stable_comp = [input_data](const int32_t a,
@@ -204,6 +216,19 @@ struct TopKFunctor<CPUDevice, T, Tidx> {
             }
             run_begin = run_end;
           }
+        } else if (use_selection) {
+          // Select the top k of the full index set with nth_element
+          // (introselect), then sort just those k if requested. Ties are
+          // broken by index via stable_comp, matching the heap path.
+          std::iota(col_indices.begin(), col_indices.end(), Tidx(0));
+          std::nth_element(col_indices.begin(), col_indices.begin() + k - 1,
+                           col_indices.end(), stable_comp);
+          if (sorted) {
+            std::sort(col_indices.begin(), col_indices.begin() + k,
+                      stable_comp);
+          }
+          std::copy(col_indices.begin(), col_indices.begin() + k,
+                    &indices(b, 0));
         } else {
           // Use the TopN heap object to sort.
           gtl::TopN<Tidx, decltype(stable_comp)> filter(k, stable_comp);
@@ -235,13 +260,20 @@ struct TopKFunctor<CPUDevice, T, Tidx> {
 
     // Guesstimate of cost; 4*N*log(K) where N == num_cols.
     // If K == N, assume the cost is N*log(K + 1).
+    // The selection path is linear in N plus a sort of the selected K.
     const double cmp_cost = 3 * Eigen::TensorOpCost::AddCost<Tidx>() +
                             Eigen::TensorOpCost::AddCost<T>();
     const double base_cost =
         cmp_cost *
         static_cast<double>(num_cols *
                             Eigen::numext::log2(static_cast<float>(k + 1)));
-    const double sort_cost = (k == num_cols) ? base_cost : 4 * base_cost;
+    const double selection_cost =
+        cmp_cost *
+        static_cast<double>(
+            num_cols + k * Eigen::numext::log2(static_cast<float>(k + 1)));
+    const double sort_cost = (k == num_cols) ? base_cost
+                             : use_selection ? selection_cost
+                                             : 4 * base_cost;
     const double copy_cost = 2 * k * Eigen::TensorOpCost::AddCost<T>();
     const double total_cost = sort_cost + copy_cost;
     const int64_t final_cost = (total_cost >= static_cast<double>(kint64max))
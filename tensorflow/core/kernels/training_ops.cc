@@ -17,6 +17,8 @@ limitations under the License.
 #include "tensorflow/core/kernels/training_ops.h"
 
 #include <algorithm>  // NOLINT
+#include <numeric>
+#include <vector>
 
 #include "tensorflow/core/framework/bounds_check.h"
 #include "tensorflow/core/framework/op_kernel.h"
@@ -1040,6 +1042,77 @@ REGISTER_KERNELS(GPU, complex128);
 #undef REGISTER_CPU_KERNELS
 #undef REGISTER_KERNELS
 
+// Applies the gradient descent update to a pack of variables in one op
+// dispatch. The pack is assembled by the "multi_tensor_apply" grappler pass,
+// which only groups updates that share the same alpha input.
+template <typename Device, typename T>
+class ApplyGradientDescentPackedOp : public OpKernel {
+ public:
+  explicit ApplyGradientDescentPackedOp(OpKernelConstruction* ctx)
+      : OpKernel(ctx) {
+    OP_REQUIRES_OK(ctx, ctx->GetAttr("use_locking", &use_exclusive_lock_));
+    OP_REQUIRES_OK(ctx, ctx->GetAttr("N", &num_packed_));
+  }
+
+  void Compute(OpKernelContext* ctx) override {
+    const bool sparse = false;
+    std::vector<int> var_ids(num_packed_);
+    std::iota(var_ids.begin(), var_ids.end(), 0);
+    auto locks = MaybeLockVariableInputMutexesInOrder<Device, T>(
+        ctx, use_exclusive_lock_, sparse, var_ids);
+
+    const Tensor& alpha = ctx->input(num_packed_);
+    OP_REQUIRES(ctx, TensorShapeUtils::IsScalar(alpha.shape()),
+                errors::InvalidArgument("alpha is not a scalar: ",
+                                        alpha.shape().DebugString()));
+
+    const Device& device = ctx->template eigen_device<Device>();
+    for (int i = 0; i < num_packed_; ++i) {
+      Tensor var;
+      OP_REQUIRES_OK(ctx, GetInputTensorFromVariable<Device, T>(
+                              ctx, i, use_exclusive_lock_, sparse, &var));
+      OP_REQUIRES(ctx, var.IsInitialized(),
+                  errors::FailedPrecondition(
+                      "Attempting to use uninitialized variables: ",
+                      requested_input(i)));
+      const Tensor& delta = ctx->input(num_packed_ + 1 + i);
+      OP_REQUIRES(
+          ctx, var.shape().IsSameSize(delta.shape()),
+          errors::InvalidArgument("var and delta do not have the same shape",
+                                  var.shape().DebugString(), " ",
+                                  delta.shape().DebugString()));
+      functor::ApplyGradientDescent<Device, T>()(
+          device, var.flat<T>(), alpha.scalar<T>(), delta.flat<T>());
+    }
+  }
+
+ private:
+  bool use_exclusive_lock_;
+  int num_packed_;
+};
+
+#define REGISTER_KERNELS(D, T)                                        \
+  REGISTER_KERNEL_BUILDER(Name("_ResourceApplyGradientDescentPacked") \
+                              .Device(DEVICE_##D)                     \
+                              .HostMemory("var")                      \
+                              .TypeConstraint<T>("T"),                \
+                          ApplyGradientDescentPackedOp<D##Device, T>);
+#define REGISTER_CPU_KERNELS(T) REGISTER_KERNELS(CPU, T);
+
+TF_CALL_FLOAT_TYPES(REGISTER_CPU_KERNELS);
+TF_CALL_COMPLEX_TYPES(REGISTER_CPU_KERNELS);
+
+#if GOOGLE_CUDA || TENSORFLOW_USE_ROCM
+REGISTER_KERNELS(GPU, Eigen::half);
+REGISTER_KERNELS(GPU, float);
+REGISTER_KERNELS(GPU, double);
+REGISTER_KERNELS(GPU, complex64);
+REGISTER_KERNELS(GPU, complex128);
+#endif
+
+#undef REGISTER_CPU_KERNELS
+#undef REGISTER_KERNELS
+
 template <typename Device, typename T>
 class ApplyAdadeltaOp : public OpKernel {
  public:
@@ -3654,6 +3727,134 @@ REGISTER_KERNELS(GPU, complex128);
 #undef REGISTER_CPU_KERNELS
 #undef REGISTER_KERNELS
 
+// Applies the Adam update to a pack of variables in one op dispatch. The pack
+// is assembled by the "multi_tensor_apply" grappler pass, which only groups
+// updates that share the same hyperparameter inputs. The packed inputs are
+// laid out as [var x N, m x N, v x N, scalars, grad x N].
+template <typename Device, typename T>
+class ApplyAdamPackedOp : public OpKernel {
+ public:
+  explicit ApplyAdamPackedOp(OpKernelConstruction* ctx) : OpKernel(ctx) {
+    OP_REQUIRES_OK(ctx, ctx->GetAttr("use_locking", &use_exclusive_lock_));
+    OP_REQUIRES_OK(ctx, ctx->GetAttr("use_nesterov", &use_nesterov_));
+    OP_REQUIRES_OK(ctx, ctx->GetAttr("N", &num_packed_));
+  }
+
+  void Compute(OpKernelContext* ctx) override {
+    const bool sparse = false;
+    std::vector<int> var_ids(3 * num_packed_);
+    std::iota(var_ids.begin(), var_ids.end(), 0);
+    auto locks = MaybeLockVariableInputMutexesInOrder<Device, T>(
+        ctx, use_exclusive_lock_, sparse, var_ids);
+
+    const int scalar_base = 3 * num_packed_;
+    const Tensor& beta1_power = ctx->input(scalar_base);
+    const Tensor& beta2_power = ctx->input(scalar_base + 1);
+    const Tensor& lr = ctx->input(scalar_base + 2);
+    const Tensor& beta1 = ctx->input(scalar_base + 3);
+    const Tensor& beta2 = ctx->input(scalar_base + 4);
+    const Tensor& epsilon = ctx->input(scalar_base + 5);
+
+    OP_REQUIRES(ctx, TensorShapeUtils::IsScalar(beta1_power.shape()),
+                errors::InvalidArgument("beta1_power is not a scalar: ",
+                                        beta1_power.shape().DebugString()));
+    OP_REQUIRES(ctx, TensorShapeUtils::IsScalar(beta2_power.shape()),
+                errors::InvalidArgument("beta2_power is not a scalar: ",
+                                        beta2_power.shape().DebugString()));
+    OP_REQUIRES(ctx, TensorShapeUtils::IsScalar(lr.shape()),
+                errors::InvalidArgument("lr is not a scalar : ",
+                                        lr.shape().DebugString()));
+    OP_REQUIRES(ctx, TensorShapeUtils::IsScalar(beta1.shape()),
+                errors::InvalidArgument("beta1 is not a scalar: ",
+                                        beta1.shape().DebugString()));
+    OP_REQUIRES(ctx, TensorShapeUtils::IsScalar(beta2.shape()),
+                errors::InvalidArgument("beta2 is not a scalar: ",
+                                        beta2.shape().DebugString()));
+    OP_REQUIRES(ctx, TensorShapeUtils::IsScalar(epsilon.shape()),
+                errors::InvalidArgument("epsilon is not a scalar: ",
+                                        epsilon.shape().DebugString()));
+
+    const Device& device = ctx->template eigen_device<Device>();
+    for (int i = 0; i < num_packed_; ++i) {
+      Tensor var;
+      OP_REQUIRES_OK(ctx, GetInputTensorFromVariable<Device, T>(
+                              ctx, i, use_exclusive_lock_, sparse, &var));
+      Tensor m;
+      OP_REQUIRES_OK(ctx,
+                     GetInputTensorFromVariable<Device, T>(
+                         ctx, num_packed_ + i, use_exclusive_lock_, sparse, &m));
+      Tensor v;
+      OP_REQUIRES_OK(ctx, GetInputTensorFromVariable<Device, T>(
+                              ctx, 2 * num_packed_ + i, use_exclusive_lock_,
+                              sparse, &v));
+      OP_REQUIRES(ctx, var.IsInitialized(),
+                  errors::FailedPrecondition(
+                      "Attempting to use uninitialized variables: ",
+                      requested_input(i)));
+      OP_REQUIRES(ctx, m.IsInitialized(),
+                  errors::FailedPrecondition(
+                      "Attempting to use uninitialized variables: ",
+                      requested_input(num_packed_ + i)));
+      OP_REQUIRES(ctx, v.IsInitialized(),
+                  errors::FailedPrecondition(
+                      "Attempting to use uninitialized variables: ",
+                      requested_input(2 * num_packed_ + i)));
+
+      const Tensor& grad = ctx->input(scalar_base + 6 + i);
+      OP_REQUIRES(
+          ctx, var.shape().IsSameSize(m.shape()),
+          errors::InvalidArgument("var and m do not have the same shape",
+                                  var.shape().DebugString(), " ",
+                                  m.shape().DebugString()));
+      OP_REQUIRES(
+          ctx, var.shape().IsSameSize(v.shape()),
+          errors::InvalidArgument("var and v do not have the same shape",
+                                  var.shape().DebugString(), " ",
+                                  v.shape().DebugString()));
+      OP_REQUIRES(
+          ctx, var.shape().IsSameSize(grad.shape()),
+          errors::InvalidArgument("var and grad do not have the same shape",
+                                  var.shape().DebugString(), " ",
+                                  grad.shape().DebugString()));
+
+      functor::ApplyAdam<Device, T>()(
+          device, var.flat<T>(), m.flat<T>(), v.flat<T>(),
+          beta1_power.scalar<T>(), beta2_power.scalar<T>(), lr.scalar<T>(),
+          beta1.scalar<T>(), beta2.scalar<T>(), epsilon.scalar<T>(),
+          grad.flat<T>(), use_nesterov_);
+    }
+  }
+
+ private:
+  bool use_exclusive_lock_;
+  bool use_nesterov_;
+  int num_packed_;
+};
+
+#define REGISTER_KERNELS(D, T)                            \
+  REGISTER_KERNEL_BUILDER(Name("_ResourceApplyAdamPacked") \
+                              .Device(DEVICE_##D)         \
+                              .HostMemory("var")          \
+                              .HostMemory("m")            \
+                              .HostMemory("v")            \
+                              .TypeConstraint<T>("T"),    \
+                          ApplyAdamPackedOp<D##Device, T>);
+#define REGISTER_CPU_KERNELS(T) REGISTER_KERNELS(CPU, T);
+
+TF_CALL_FLOAT_TYPES(REGISTER_CPU_KERNELS);
+TF_CALL_COMPLEX_TYPES(REGISTER_CPU_KERNELS);
+
+#if GOOGLE_CUDA || TENSORFLOW_USE_ROCM
+REGISTER_KERNELS(GPU, Eigen::half);
+REGISTER_KERNELS(GPU, float);
+REGISTER_KERNELS(GPU, double);
+REGISTER_KERNELS(GPU, complex64);
+REGISTER_KERNELS(GPU, complex128);
+#endif
+
+#undef REGISTER_CPU_KERNELS
+#undef REGISTER_KERNELS
+
 template <typename Device, typename T>
 class ApplyAdamWithAmsgradOp : public OpKernel {
  public:
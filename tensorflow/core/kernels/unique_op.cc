@@ -13,9 +13,12 @@ See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
 
+#include <algorithm>
 #include <functional>
+#include <type_traits>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "absl/container/flat_hash_map.h"
 #include "tensorflow/core/framework/bounds_check.h"
@@ -26,12 +29,22 @@ limitations under the License.
 #include "tensorflow/core/lib/core/status.h"
 #include "tensorflow/core/lib/hash/hash.h"
 #include "tensorflow/core/platform/bfloat16.h"
+#include "tensorflow/core/util/work_sharder.h"
 
 namespace tensorflow {
 namespace {
 
 typedef Eigen::ThreadPoolDevice CPUDevice;
 
+// Minimum number of scalar elements before Unique deduplicates in parallel;
+// below this the partitioning overhead outweighs the parallelism.
+constexpr int64_t kParallelizationThreshold = 256 * 1024;
+
+// Upper bound on the number of hash shards used by the parallel path. More
+// shards than cores buy nothing, and the bound keeps the per-element shard
+// id within a uint8.
+constexpr int64_t kMaxShards = 16;
+
 // `UniqueOpHashMap` defines the map type that is used when elements of type
 // `T` are to be uniquified. By default, we use `absl::flat_hash_map<T, TIndex>`
 // as the map type. Subsequent specializations are provided for
@@ -150,26 +163,134 @@ class UniqueOp : public OpKernel {
       auto Tin = input.flat<T>();
       const int64_t N = static_cast<int64_t>(Tin.size());
 
-      typename UniqueOpHashMap<T, TIndex>::map_type uniq;
-      uniq.reserve(2 * N);
-      for (Eigen::Index i = 0, j = 0; i < N; ++i) {
-        auto it = uniq.emplace(Tin(i), j);
-        idx_vec(i) = it.first->second;
-        if (it.second) {
-          ++j;
+      // Large integral inputs (e.g. feature ids) are deduplicated in
+      // parallel: elements are partitioned by hash into shards, each shard is
+      // deduplicated on its own thread, and the shard-local ids are then
+      // renumbered into first-occurrence order.
+      bool done_in_parallel = false;
+      if constexpr (std::is_integral<T>::value) {
+        auto* worker_threads =
+            context->device()->tensorflow_cpu_worker_threads();
+        if (N >= kParallelizationThreshold && worker_threads != nullptr &&
+            worker_threads->num_threads > 1) {
+          done_in_parallel = true;
+          const int64_t num_shards =
+              std::min<int64_t>(worker_threads->num_threads, kMaxShards);
+
+          // Partition elements by a mixed hash so that equal elements land in
+          // the same shard and the shards are balanced even for skewed ids.
+          std::vector<uint8> shard_of(N);
+          Shard(worker_threads->num_threads, worker_threads->workers, N,
+                /*cost_per_unit=*/15, [&](int64_t start, int64_t end) {
+                  for (int64_t i = start; i < end; ++i) {
+                    const T value = Tin(i);
+                    shard_of[i] = static_cast<uint8>(
+                        Hash64(reinterpret_cast<const char*>(&value),
+                               sizeof(T)) %
+                        num_shards);
+                  }
+                });
+
+          // Deduplicate every shard on its own thread. Each element belongs
+          // to exactly one shard, so the writes to `idx_vec` are disjoint.
+          struct ShardResult {
+            typename UniqueOpHashMap<T, TIndex>::map_type uniq;
+            // Input position of the first occurrence of each local id.
+            std::vector<int64_t> first_occurrence;
+          };
+          std::vector<ShardResult> shards(num_shards);
+          Shard(worker_threads->num_threads, worker_threads->workers,
+                num_shards, /*cost_per_unit=*/20 * N,
+                [&](int64_t shard_begin, int64_t shard_end) {
+                  for (int64_t s = shard_begin; s < shard_end; ++s) {
+                    ShardResult& shard = shards[s];
+                    shard.uniq.reserve(2 * N / num_shards);
+                    TIndex j = 0;
+                    for (int64_t i = 0; i < N; ++i) {
+                      if (shard_of[i] != s) continue;
+                      auto it = shard.uniq.emplace(Tin(i), j);
+                      idx_vec(i) = it.first->second;
+                      if (it.second) {
+                        shard.first_occurrence.push_back(i);
+                        ++j;
+                      }
+                    }
+                  }
+                });
+
+          // Renumber shard-local ids into global first-occurrence order, the
+          // order the sequential implementation produces.
+          struct FirstOccurrence {
+            int64_t position;
+            int64_t shard;
+            TIndex local_id;
+          };
+          std::vector<FirstOccurrence> firsts;
+          uniq_size = 0;
+          for (int64_t s = 0; s < num_shards; ++s) {
+            uniq_size += static_cast<int64_t>(shards[s].first_occurrence.size());
+          }
+          firsts.reserve(uniq_size);
+          for (int64_t s = 0; s < num_shards; ++s) {
+            const auto& first_occurrence = shards[s].first_occurrence;
+            for (int64_t l = 0; l < static_cast<int64_t>(first_occurrence.size());
+                 ++l) {
+              firsts.push_back(
+                  {first_occurrence[l], s, static_cast<TIndex>(l)});
+            }
+          }
+          std::sort(firsts.begin(), firsts.end(),
+                    [](const FirstOccurrence& a, const FirstOccurrence& b) {
+                      return a.position < b.position;
+                    });
+
+          TensorShape output_shape(input.shape());
+          output_shape.set_dim(axis, uniq_size);
+          Tensor* output = nullptr;
+          OP_REQUIRES_OK(context,
+                         context->allocate_output(0, output_shape, &output));
+          auto Tout = output->flat<T>();
+
+          std::vector<std::vector<TIndex>> local_to_global(num_shards);
+          for (int64_t s = 0; s < num_shards; ++s) {
+            local_to_global[s].resize(shards[s].first_occurrence.size());
+          }
+          for (int64_t g = 0; g < uniq_size; ++g) {
+            Tout(g) = Tin(firsts[g].position);
+            local_to_global[firsts[g].shard][firsts[g].local_id] =
+                static_cast<TIndex>(g);
+          }
+          Shard(worker_threads->num_threads, worker_threads->workers, N,
+                /*cost_per_unit=*/5, [&](int64_t start, int64_t end) {
+                  for (int64_t i = start; i < end; ++i) {
+                    idx_vec(i) = local_to_global[shard_of[i]][idx_vec(i)];
+                  }
+                });
         }
       }
 
-      uniq_size = static_cast<int64_t>(uniq.size());
-      TensorShape output_shape(input.shape());
-      output_shape.set_dim(axis, uniq_size);
-      Tensor* output = nullptr;
-      OP_REQUIRES_OK(context,
-                     context->allocate_output(0, output_shape, &output));
-      auto Tout = output->flat<T>();
+      if (!done_in_parallel) {
+        typename UniqueOpHashMap<T, TIndex>::map_type uniq;
+        uniq.reserve(2 * N);
+        for (Eigen::Index i = 0, j = 0; i < N; ++i) {
+          auto it = uniq.emplace(Tin(i), j);
+          idx_vec(i) = it.first->second;
+          if (it.second) {
+            ++j;
+          }
+        }
+
+        uniq_size = static_cast<int64_t>(uniq.size());
+        TensorShape output_shape(input.shape());
+        output_shape.set_dim(axis, uniq_size);
+        Tensor* output = nullptr;
+        OP_REQUIRES_OK(context,
+                       context->allocate_output(0, output_shape, &output));
+        auto Tout = output->flat<T>();
 
-      for (const auto& it : uniq) {
-        Tout(it.second) = it.first;
+        for (const auto& it : uniq) {
+          Tout(it.second) = it.first;
+        }
       }
     } else {
       // General implementation when unique is run over multiple elements.
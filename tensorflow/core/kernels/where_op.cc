@@ -23,8 +23,11 @@ limitations under the License.
 
 #include "tensorflow/core/kernels/where_op.h"
 
+#include <algorithm>
 #include <memory>
 #include <numeric>
+#include <vector>
+
 #include "unsupported/Eigen/CXX11/Tensor"  // from @eigen_archive
 #include "tensorflow/core/framework/bounds_check.h"
 #include "tensorflow/core/framework/op_kernel.h"
@@ -36,6 +39,7 @@ limitations under the License.
 #include "tensorflow/core/platform/logging.h"
 #include "tensorflow/core/platform/macros.h"
 #include "tensorflow/core/platform/types.h"
+#include "tensorflow/core/util/work_sharder.h"
 
 #if GOOGLE_CUDA || TENSORFLOW_USE_ROCM
 #include "tensorflow/core/common_runtime/gpu/gpu_event_mgr.h"
@@ -120,6 +124,40 @@ struct Where<CPUDevice, DIMS, T, TIndex> {
     }
     return OkStatus();
   }
+
+  // Writes the coordinates of the true elements with flat indices in
+  // [begin, end) to the output starting at row 'true_offset', and returns the
+  // number of true elements seen. Used by the two-phase parallel path, where
+  // each block's output offset is known from the per-block counts so the
+  // blocks write disjoint row ranges.
+  EIGEN_ALWAYS_INLINE static TIndex ComputeBlock(
+      typename TTypes<T, DIMS>::ConstTensor input,
+      typename TTypes<int64_t>::Matrix output, Eigen::DenseIndex begin,
+      Eigen::DenseIndex end, TIndex true_offset) {
+    Eigen::DSizes<Eigen::DenseIndex, DIMS> dims = input.dimensions();
+    Eigen::DSizes<TIndex, DIMS> strides;
+
+    EIGEN_STATIC_ASSERT((static_cast<int>(decltype(input)::Layout) ==
+                         static_cast<int>(Eigen::RowMajor)),
+                        INTERNAL_ERROR_INPUT_SHOULD_BE_ROWMAJOR);
+
+    strides[DIMS - 1] = 1;
+    for (int i = DIMS - 2; i >= 0; --i) {
+      strides[i] = strides[i + 1] * dims[i + 1];
+    }
+
+    const Eigen::DenseIndex output_size = output.dimension(0);
+    TIndex found = 0;
+    for (Eigen::DenseIndex n = begin; n < end; ++n) {
+      if (input.data()[n] != T(0)) {
+        if (FastBoundsCheck(true_offset + found, output_size)) {
+          WriteIndexRowMajor(output, strides, true_offset + found, n);
+        }
+        ++found;
+      }
+    }
+    return found;
+  }
 };
 
 }  // namespace functor
@@ -139,22 +177,32 @@ class WhereCPUOp : public OpKernel {
                               "creating costly copies from device."));
 
     const int input_dims = input.dims();
-
-    int64_t num_true;
-    TTypes<int64_t>::UnalignedScalar num_true_t(&num_true);
-
-    Status s = functor::NumTrue<CPUDevice, T, int64_t>::Compute(
-        context, context->eigen_device<CPUDevice>(), input.flat<T>(),
-        num_true_t);
-    OP_REQUIRES_OK(context, s);
-    TensorShape output_shape({num_true, input_dims});
-    Tensor* output = nullptr;
-    OP_REQUIRES_OK(context, context->allocate_output(0, output_shape, &output));
-
-    // TODO(ebrevdo): Replace single-threaded copy with a multithreaded block
-    // copy by getting block counts above instead of a global NumTrue, then
-    // having each block filled in separate threads below.
-    int64_t found_true = 0;
+    const int64_t num_elements = input.NumElements();
+
+    // Two-phase parallel compaction: count the true elements in each block,
+    // compute each block's output offset with an exclusive scan over the block
+    // counts, then scatter the indices with each block writing its own
+    // (disjoint) row range. Small inputs use a single block, which degenerates
+    // to the single-threaded count-then-write pass.
+    auto* worker_threads = context->device()->tensorflow_cpu_worker_threads();
+    const int64_t num_blocks = std::max<int64_t>(
+        1, std::min<int64_t>(worker_threads->num_threads,
+                             num_elements / kMinElementsPerBlock));
+
+    if (num_blocks <= 1) {
+      int64_t num_true;
+      TTypes<int64_t>::UnalignedScalar num_true_t(&num_true);
+
+      Status s = functor::NumTrue<CPUDevice, T, int64_t>::Compute(
+          context, context->eigen_device<CPUDevice>(), input.flat<T>(),
+          num_true_t);
+      OP_REQUIRES_OK(context, s);
+      TensorShape output_shape({num_true, input_dims});
+      Tensor* output = nullptr;
+      OP_REQUIRES_OK(context,
+                     context->allocate_output(0, output_shape, &output));
+
+      int64_t found_true = 0;
 
 #define HANDLE_DIM(NDIM)                                                      \
   case NDIM: {                                                                \
@@ -164,6 +212,85 @@ class WhereCPUOp : public OpKernel {
     OP_REQUIRES_OK(context, s);                                               \
   } break;
 
+      switch (input_dims) {
+        HANDLE_DIM(1);
+        HANDLE_DIM(2);
+        HANDLE_DIM(3);
+        HANDLE_DIM(4);
+        HANDLE_DIM(5);
+        HANDLE_DIM(6);
+        HANDLE_DIM(7);
+        HANDLE_DIM(8);
+
+        default:
+          OP_REQUIRES(
+              context, false,
+              errors::InvalidArgument("WhereOp : Unhandled input dimensions: ",
+                                      input_dims));
+      }
+#undef HANDLE_DIM
+
+      OP_REQUIRES(
+          context, found_true == num_true_t(),
+          errors::InvalidArgument(
+              "WhereOp: Race condition between counting the number of true "
+              "elements and writing them.  When counting, saw ",
+              num_true_t(), " elements; but when writing their indices, saw ",
+              found_true, " elements."));
+      return;
+    }
+
+    // Phase 1: per-block counts. The tight per-block loops vectorize, unlike
+    // a single sequential scan interleaved with index writes.
+    const int64_t block_size = (num_elements + num_blocks - 1) / num_blocks;
+    const T* input_data = input.flat<T>().data();
+    std::vector<int64_t> block_counts(num_blocks);
+    Shard(worker_threads->num_threads, worker_threads->workers, num_blocks,
+          block_size, [&](int64_t begin, int64_t end) {
+            for (int64_t b = begin; b < end; ++b) {
+              const int64_t block_begin = b * block_size;
+              const int64_t block_end =
+                  std::min(block_begin + block_size, num_elements);
+              block_counts[b] = functor::CountAccumulator<T>(
+                  input_data + block_begin, input_data + block_end);
+            }
+          });
+
+    // Exclusive scan over the block counts yields each block's output offset
+    // and the total number of true elements.
+    std::vector<int64_t> block_offsets(num_blocks);
+    int64_t num_true = 0;
+    for (int64_t b = 0; b < num_blocks; ++b) {
+      block_offsets[b] = num_true;
+      num_true += block_counts[b];
+    }
+
+    TensorShape output_shape({num_true, input_dims});
+    Tensor* output = nullptr;
+    OP_REQUIRES_OK(context, context->allocate_output(0, output_shape, &output));
+
+    // Phase 2: parallel scatter of the index rows, one disjoint output range
+    // per block.
+    std::vector<int64_t> found_per_block(num_blocks);
+
+#define HANDLE_DIM(NDIM)                                                     \
+  case NDIM: {                                                               \
+    auto input_t = input.tensor<T, NDIM>();                                  \
+    auto output_t = output->matrix<int64_t>();                               \
+    Shard(worker_threads->num_threads, worker_threads->workers, num_blocks,  \
+          block_size, [&](int64_t begin, int64_t end) {                      \
+            for (int64_t b = begin; b < end; ++b) {                          \
+              const int64_t block_begin = b * block_size;                    \
+              const int64_t block_end =                                      \
+                  std::min(block_begin + block_size, num_elements);          \
+              found_per_block[b] =                                           \
+                  functor::Where<CPUDevice, NDIM, T, int64_t>::ComputeBlock( \
+                      input_t, output_t, block_begin, block_end,             \
+                      block_offsets[b]);                                     \
+            }                                                                \
+          });                                                                \
+  } break;
+
     switch (input_dims) {
       HANDLE_DIM(1);
       HANDLE_DIM(2);
@@ -181,16 +308,24 @@ class WhereCPUOp : public OpKernel {
     }
 #undef HANDLE_DIM
 
+    int64_t found_true = 0;
+    for (int64_t b = 0; b < num_blocks; ++b) {
+      found_true += found_per_block[b];
+    }
     OP_REQUIRES(
-        context, found_true == num_true_t(),
+        context, found_true == num_true,
         errors::InvalidArgument(
             "WhereOp: Race condition between counting the number of true "
             "elements and writing them.  When counting, saw ",
-            num_true_t(), " elements; but when writing their indices, saw ",
+            num_true, " elements; but when writing their indices, saw ",
             found_true, " elements."));
   }
 
  private:
+  // Minimum number of elements each block of the two-phase parallel path
+  // should process; below this the sharding overhead dominates.
+  static constexpr int64_t kMinElementsPerBlock = 1 << 14;
+
   WhereCPUOp(const WhereCPUOp&) = delete;
   void operator=(const WhereCPUOp&) = delete;
 };
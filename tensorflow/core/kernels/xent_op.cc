@@ -19,6 +19,9 @@ limitations under the License.
 
 #include "tensorflow/core/kernels/xent_op.h"
 
+#include <algorithm>
+#include <vector>
+
 #include "unsupported/Eigen/CXX11/Tensor"  // from @eigen_archive
 #include "tensorflow/core/framework/op_kernel.h"
 #include "tensorflow/core/framework/register_types.h"
@@ -102,6 +105,124 @@ class SoftmaxXentWithLogitsOp : public OpKernel {
 // Partial specialization for a CPUDevice, that uses the Eigen implementation
 // from XentEigenImpl.
 namespace functor {
+
+// Tiled implementation for wide class dimensions (large vocabulary softmax
+// heads). The Eigen expression path makes five full passes over the
+// [batch, classes] matrix, using the backprop output to materialize the
+// shifted logits in between. This implementation instead reduces each row in
+// fixed-size class tiles, keeping a running max and rescaled exponential sum
+// per (row, tile) pair, and then writes the gradient in one fused pass. Work
+// units are (row, tile) pairs, so a handful of very wide rows still spreads
+// across all threads.
+template <typename T>
+struct TiledXentImpl {
+  // One tile stays cache resident between the two passes over it. Rows
+  // narrower than kMinClassesToTile use the Eigen expression path, which
+  // keeps the accumulation order of narrow classifiers unchanged.
+  static constexpr Eigen::DenseIndex kTileSize = 1 << 13;
+  static constexpr Eigen::DenseIndex kMinClassesToTile = 1 << 12;
+
+  static void Compute(const CPUDevice& d,
+                      typename TTypes<T>::ConstMatrix logits,
+                      typename TTypes<T>::ConstMatrix labels,
+                      typename TTypes<T>::Vec loss,
+                      typename TTypes<T>::Matrix backprop) {
+    const Eigen::DenseIndex batch_size = logits.dimension(0);
+    const Eigen::DenseIndex num_classes = logits.dimension(1);
+    const Eigen::DenseIndex num_tiles = Eigen::divup(num_classes, kTileSize);
+    const Eigen::DenseIndex num_units = batch_size * num_tiles;
+
+    // Per (row, tile) partial reductions.
+    std::vector<T> tile_max(num_units);
+    std::vector<T> tile_sum(num_units);        // sum(exp(logits - tile max))
+    std::vector<T> tile_dot(num_units);        // sum(labels * logits)
+    std::vector<T> tile_label_sum(num_units);  // sum(labels)
+
+    const Eigen::TensorOpCost cost(/*bytes_loaded=*/2 * kTileSize * sizeof(T),
+                                   /*bytes_stored=*/kTileSize * sizeof(T),
+                                   /*compute_cycles=*/5 * kTileSize);
+
+    auto for_each_tile = [&](Eigen::DenseIndex first, Eigen::DenseIndex last,
+                             auto fn) {
+      for (Eigen::DenseIndex unit = first; unit < last; ++unit) {
+        const Eigen::DenseIndex row = unit / num_tiles;
+        const Eigen::DenseIndex col = (unit % num_tiles) * kTileSize;
+        const Eigen::DenseIndex len = std::min(kTileSize, num_classes - col);
+        const Eigen::DSizes<Eigen::DenseIndex, 2> offsets(row, col);
+        const Eigen::DSizes<Eigen::DenseIndex, 2> extents(1, len);
+        fn(unit, row, offsets, extents);
+      }
+    };
+
+    d.parallelFor(
+        num_units, cost,
+        [&](Eigen::DenseIndex first, Eigen::DenseIndex last) {
+          for_each_tile(
+              first, last,
+              [&](Eigen::DenseIndex unit, Eigen::DenseIndex row,
+                  const Eigen::DSizes<Eigen::DenseIndex, 2>& offsets,
+                  const Eigen::DSizes<Eigen::DenseIndex, 2>& extents) {
+                auto logits_tile = logits.slice(offsets, extents);
+                auto labels_tile = labels.slice(offsets, extents);
+                Eigen::Tensor<T, 0, Eigen::RowMajor, Eigen::DenseIndex> value;
+                value = logits_tile.maximum();
+                const T m = value();
+                tile_max[unit] = m;
+                value = (logits_tile - logits_tile.constant(m)).exp().sum();
+                tile_sum[unit] = value();
+                value = (labels_tile * logits_tile).sum();
+                tile_dot[unit] = value();
+                value = labels_tile.sum();
+                tile_label_sum[unit] = value();
+              });
+        });
+
+    // Combine the tile reductions per row, rescaling each partial sum to the
+    // running row max. With at most a few hundred tiles per row this is
+    // negligible next to the tile passes.
+    std::vector<T> row_max(batch_size);
+    std::vector<T> row_sum_inv(batch_size);
+    for (Eigen::DenseIndex row = 0; row < batch_size; ++row) {
+      T m = Eigen::NumTraits<T>::lowest();
+      T sum = T(0);
+      T dot = T(0);
+      T label_sum = T(0);
+      for (Eigen::DenseIndex tile = 0; tile < num_tiles; ++tile) {
+        const Eigen::DenseIndex unit = row * num_tiles + tile;
+        const T new_max = Eigen::numext::maxi(m, tile_max[unit]);
+        sum = sum * Eigen::numext::exp(m - new_max) +
+              tile_sum[unit] * Eigen::numext::exp(tile_max[unit] - new_max);
+        m = new_max;
+        dot += tile_dot[unit];
+        label_sum += tile_label_sum[unit];
+      }
+      row_max[row] = m;
+      row_sum_inv[row] = T(1) / sum;
+      // loss = sum(labels * (log(sum(exp(logits - max))) + max - logits))
+      loss(row) = label_sum * (Eigen::numext::log(sum) + m) - dot;
+    }
+
+    // Fused gradient pass: prob - labels, without materializing the shifted
+    // logits or probabilities.
+    d.parallelFor(
+        num_units, cost,
+        [&](Eigen::DenseIndex first, Eigen::DenseIndex last) {
+          for_each_tile(
+              first, last,
+              [&](Eigen::DenseIndex unit, Eigen::DenseIndex row,
+                  const Eigen::DSizes<Eigen::DenseIndex, 2>& offsets,
+                  const Eigen::DSizes<Eigen::DenseIndex, 2>& extents) {
+                auto logits_tile = logits.slice(offsets, extents);
+                auto labels_tile = labels.slice(offsets, extents);
+                backprop.slice(offsets, extents) =
+                    (logits_tile - logits_tile.constant(row_max[row])).exp() *
+                        logits_tile.constant(row_sum_inv[row]) -
+                    labels_tile;
+              });
+        });
+  }
+};
+
 template <typename Device, typename T>
 struct XentFunctorBase {
   void operator()(const Device& d,
@@ -113,6 +234,13 @@ struct XentFunctorBase {
                   typename TTypes<T>::Matrix scratch,
                   typename TTypes<T>::Vec loss,
                   typename TTypes<T>::Matrix backprop) {
+    // Wide, non-broadcast inputs go through the tiled implementation.
+    if (shape[1] >= TiledXentImpl<T>::kMinClassesToTile &&
+        logits.dimension(0) == shape[0] && logits.dimension(1) == shape[1] &&
+        labels.dimension(0) == shape[0] && labels.dimension(1) == shape[1]) {
+      TiledXentImpl<T>::Compute(d, logits, labels, loss, backprop);
+      return;
+    }
     XentEigenImpl<Device, T>::Compute(d, shape, logits_bcast, labels_bcast,
                                       logits, labels, scratch, loss, backprop);
   }
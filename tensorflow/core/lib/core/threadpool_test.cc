@@ -285,6 +285,37 @@ TEST(ThreadPool, ParallelFor) {
   }
 }
 
+TEST(ThreadPool, ParallelForWithAffinity) {
+  Context outer_context(ContextKind::kThread);
+  // Make the fallback path use as many threads as possible.
+  int64_t kHugeCost = 1 << 30;
+  for (int num_threads = 1; num_threads < kNumThreads; num_threads++) {
+    fprintf(stderr, "Testing with %d threads\n", num_threads);
+    const int kWorkItems = 15;
+    std::atomic<bool> work[kWorkItems];
+    ThreadPool pool(Env::Default(), "test", num_threads);
+    // On machines without multiple NUMA nodes this returns false and
+    // ParallelForWithAffinity falls back to plain ParallelFor; the
+    // correctness contract below holds either way.
+    pool.EnableNumaAwareScheduling();
+    for (int i = 0; i < kWorkItems; i++) {
+      work[i] = false;
+    }
+    pool.ParallelForWithAffinity(
+        &work[0], kWorkItems, kHugeCost,
+        [&outer_context, &work](int64_t begin, int64_t end) {
+          Context inner_context(ContextKind::kThread);
+          ASSERT_EQ(outer_context, inner_context);
+          for (int64_t i = begin; i < end; ++i) {
+            ASSERT_FALSE(work[i].exchange(true));
+          }
+        });
+    for (int i = 0; i < kWorkItems; i++) {
+      ASSERT_TRUE(work[i]);
+    }
+  }
+}
+
 TEST(ThreadPool, ParallelForWithAdaptiveSchedulingStrategy) {
   Context outer_context(ContextKind::kThread);
   // Make ParallelFor use as many threads as possible.
@@ -14,11 +14,13 @@ limitations under the License.
 ==============================================================================*/
 #include "tensorflow/core/nccl/nccl_manager.h"
 
+#include <algorithm>
 #include <utility>
 
 #if GOOGLE_CUDA || TENSORFLOW_USE_ROCM
 
 #include "absl/base/call_once.h"
+#include "absl/container/inlined_vector.h"
 #include "tensorflow/core/framework/types.h"
 #include "tensorflow/core/lib/core/refcount.h"
 #include "tensorflow/core/lib/core/threadpool.h"
@@ -28,6 +30,7 @@ limitations under the License.
 #include "tensorflow/core/profiler/lib/annotated_traceme.h"
 #include "tensorflow/core/profiler/lib/connected_traceme.h"
 #include "tensorflow/core/profiler/lib/traceme.h"
+#include "tensorflow/core/util/env_var.h"
 #if GOOGLE_CUDA
 #include "xla/stream_executor/cuda/cuda_activation.h"
 #elif TENSORFLOW_USE_ROCM
@@ -369,7 +372,25 @@ Status NcclManager::GetCommunicator(NcclManager::Collective* collective,
 #if TENSORFLOW_USE_ROCM
       nccl_stream->stream = collective->participants[i]->context->nccl_stream();
 #else
+      // With the default stream priority, collective kernels queue behind
+      // large compute kernels (e.g. backprop GEMMs) and the intended overlap
+      // of communication and compute never materializes; a high-priority
+      // stream lets the collective's blocks be scheduled as compute blocks
+      // retire instead of waiting for whole kernels to drain.
+      static const bool use_high_priority_comm_streams = [] {
+        bool enabled = false;
+        Status s = ReadBoolFromEnvVar("TF_NCCL_HIGH_PRIORITY_STREAMS",
+                                      /*default_val=*/false, &enabled);
+        if (!s.ok()) {
+          LOG(ERROR) << s.message();
+        }
+        return enabled;
+      }();
       nccl_stream->stream.reset(new se::Stream(executor));
+      if (use_high_priority_comm_streams) {
+        nccl_stream->stream->implementation()->SetPriority(
+            se::StreamPriority::Highest);
+      }
       nccl_stream->stream->Init();
 #endif
 
@@ -713,6 +734,25 @@ size_t ComputeBufferSize(const NcclManager::Participant* p,
   }
   return num_elements * DataTypeSize(data_type);
 }
+
+// Maximum number of queued collective launches to issue inside a single
+// ncclGroupStart/ncclGroupEnd. Grouping amortizes the fixed per-launch cost
+// when many small collectives (e.g. per-gradient reductions) become ready
+// close together. Only launches that are already waiting in the queue are
+// grouped, so a lone collective is never delayed.
+int GroupLaunchSize() {
+  static const int group_size = [] {
+    int64_t value;
+    Status s = ReadInt64FromEnvVar("TF_NCCL_LAUNCH_GROUP_SIZE", 1, &value);
+    if (!s.ok()) {
+      LOG(ERROR) << s.message();
+      return 1;
+    }
+    // NCCL limits the number of operations in one group; stay well below it.
+    return static_cast<int>(std::min<int64_t>(std::max<int64_t>(value, 1), 32));
+  }();
+  return group_size;
+}
 }  // namespace
 
 void NcclManager::LoopKernelLaunches(NcclStream* nccl_stream) {
@@ -725,9 +765,13 @@ void NcclManager::LoopKernelLaunches(NcclStream* nccl_stream) {
   cudaStream_t cu_stream = reinterpret_cast<cudaStream_t>(
       comm_stream->platform_specific_handle().stream);
 
+  const int max_group_launches = GroupLaunchSize();
+
   while (true) {
-    // Find collective to run.
-    std::pair<Collective*, int> next_launch;
+    // Find collectives to run. If group launching is enabled, drain up to
+    // max_group_launches already-queued launches so that they can be issued
+    // inside a single NCCL group.
+    absl::InlinedVector<std::pair<Collective*, int>, 4> next_launches;
     {
       VLOG(3) << "Locking mutex nccl_stream " << nccl_stream;
       mutex_lock l(nccl_stream->mu);
@@ -738,187 +782,230 @@ void NcclManager::LoopKernelLaunches(NcclStream* nccl_stream) {
         }
         nccl_stream->cv.wait(l);
       }
-      next_launch = nccl_stream->pending_launches_.back();
-      nccl_stream->pending_launches_.pop_back();
+      while (static_cast<int>(next_launches.size()) < max_group_launches &&
+             !nccl_stream->pending_launches_.empty()) {
+        next_launches.push_back(nccl_stream->pending_launches_.back());
+        nccl_stream->pending_launches_.pop_back();
+      }
     }
 
-    // Launch the nccl kernel.
-    Collective* collective = next_launch.first;
-    tensorflow::profiler::TraceMeConsumer traceme("Run Collective",
-                                                  collective->trace_context);
-
-    ncclDataType_t data_type = ToNcclType(collective->data_type);
-    int p_idx = next_launch.second;
-    Participant* p = collective->participants[p_idx].get();
-    auto nccl_comm = collective->communicator->members[p_idx].nccl_comm;
-    ncclResult_t nccl_result = ncclSuccess;
-    switch (collective->type) {
-      case kAllReduce: {
-        const void* sendbuff = p->input->tensor_data().data();
-        void* recvbuff = const_cast<char*>(p->output->tensor_data().data());
-
-        VLOG(2) << "call NcclAllReduce collective_key "
-                << collective->collective_key << " participant " << p_idx
-                << " num_participants " << collective->participants.size()
-                << " sendbuff " << sendbuff << " recvbuff " << recvbuff
-                << " nccl_comm " << nccl_comm << " comm_stream " << comm_stream
-                << " cuda_stream " << cu_stream;
-        profiler::AnnotatedTraceMe traceme([&] {
-          return profiler::TraceMeEncode(
-              "ncclAllReduce",
-              {{"buffer_size", ComputeBufferSize(p, collective->data_type)},
-               {"collective_type", "all_reduce"}});
-        });
-        nccl_result = ncclAllReduce(sendbuff, recvbuff, p->input->NumElements(),
-                                    data_type, collective->reduction_op,
-                                    nccl_comm, cu_stream);
-        break;
-      }
-      case kBroadcast: {
-        const void* sendbuff = nullptr;
-        void* recvbuff = nullptr;
-        int num_elements = -1;
-        if (p->input) {
-          sendbuff = p->input->tensor_data().data();
-          num_elements = p->input->NumElements();
+    const bool grouped = next_launches.size() > 1;
+    if (grouped) {
+      // All drained launches target this thread's comm stream, so one group
+      // turns them into a single fused launch.
+      ncclGroupStart();
+    }
+
+    // Per-launch results. Completion callbacks are only scheduled once the
+    // whole group has been committed to the stream; registering them earlier
+    // would let them fire before the grouped kernels are enqueued.
+    absl::InlinedVector<ncclResult_t, 4> results(next_launches.size(),
+                                                 ncclSuccess);
+
+    for (int launch_idx = 0; launch_idx < next_launches.size(); ++launch_idx) {
+      std::pair<Collective*, int>& next_launch = next_launches[launch_idx];
+
+      // Launch the nccl kernel.
+      Collective* collective = next_launch.first;
+      tensorflow::profiler::TraceMeConsumer traceme("Run Collective",
+                                                    collective->trace_context);
+
+      ncclDataType_t data_type = ToNcclType(collective->data_type);
+      int p_idx = next_launch.second;
+      Participant* p = collective->participants[p_idx].get();
+      auto nccl_comm = collective->communicator->members[p_idx].nccl_comm;
+      ncclResult_t& nccl_result = results[launch_idx];
+      switch (collective->type) {
+        case kAllReduce: {
+          const void* sendbuff = p->input->tensor_data().data();
+          void* recvbuff = const_cast<char*>(p->output->tensor_data().data());
+
+          VLOG(2) << "call NcclAllReduce collective_key "
+                  << collective->collective_key << " participant " << p_idx
+                  << " num_participants " << collective->participants.size()
+                  << " sendbuff " << sendbuff << " recvbuff " << recvbuff
+                  << " nccl_comm " << nccl_comm << " comm_stream " << comm_stream
+                  << " cuda_stream " << cu_stream;
+          profiler::AnnotatedTraceMe traceme([&] {
+            return profiler::TraceMeEncode(
+                "ncclAllReduce",
+                {{"buffer_size", ComputeBufferSize(p, collective->data_type)},
+                 {"collective_type", "all_reduce"}});
+          });
+          nccl_result = ncclAllReduce(sendbuff, recvbuff, p->input->NumElements(),
+                                      data_type, collective->reduction_op,
+                                      nccl_comm, cu_stream);
+          break;
         }
-        if (p->output) {
-          recvbuff = const_cast<char*>(p->output->tensor_data().data());
-          num_elements = p->output->NumElements();
-        } else {
-          // Operate in-place if no output (for the src node).
-          recvbuff = const_cast<void*>(sendbuff);
+        case kBroadcast: {
+          const void* sendbuff = nullptr;
+          void* recvbuff = nullptr;
+          int num_elements = -1;
+          if (p->input) {
+            sendbuff = p->input->tensor_data().data();
+            num_elements = p->input->NumElements();
+          }
+          if (p->output) {
+            recvbuff = const_cast<char*>(p->output->tensor_data().data());
+            num_elements = p->output->NumElements();
+          } else {
+            // Operate in-place if no output (for the src node).
+            recvbuff = const_cast<void*>(sendbuff);
+          }
+          if (num_elements < 0) {
+            p->done_callback(errors::Internal(
+                "Both input and output are null in ncclBroadcast"));
+            collective->Unref();
+            // Mark the launch as already handled so no completion callback is
+            // scheduled for it below.
+            next_launch.first = nullptr;
+            continue;
+          }
+          VLOG(2) << "call NcclBroadcast collective_key "
+                  << collective->collective_key << " participant " << p_idx
+                  << " sendbuff " << sendbuff << " recvbuff " << recvbuff
+                  << " nccl_comm " << nccl_comm << " comm_stream " << comm_stream
+                  << " cuda_stream " << cu_stream;
+          profiler::AnnotatedTraceMe traceme([&] {
+            return profiler::TraceMeEncode(
+                "ncclBroadcast",
+                {{"buffer_size", ComputeBufferSize(p, collective->data_type)},
+                 {"collective_type", "broadcast"}});
+          });
+          nccl_result =
+              ncclBroadcast(sendbuff, recvbuff, num_elements, data_type,
+                            collective->root_rank, nccl_comm, cu_stream);
+          break;
         }
-        if (num_elements < 0) {
-          p->done_callback(errors::Internal(
-              "Both input and output are null in ncclBroadcast"));
-          collective->Unref();
-          continue;
+        case kReduce: {
+          const void* sendbuff = p->input->tensor_data().data();
+          void* recvbuff =
+              p->output ? const_cast<char*>(p->output->tensor_data().data())
+                        : nullptr;
+          profiler::AnnotatedTraceMe traceme([&] {
+            return profiler::TraceMeEncode(
+                "buffer_size",
+                {{"output_size", ComputeBufferSize(p, collective->data_type)},
+                 {"collective_type", "reduce"}});
+          });
+          nccl_result = ncclReduce(sendbuff, recvbuff, p->input->NumElements(),
+                                   data_type, collective->reduction_op,
+                                   collective->root_rank, nccl_comm, cu_stream);
+          break;
+        }
+        case kAllGather: {
+          const void* sendbuff = p->input->tensor_data().data();
+          void* recvbuff = const_cast<char*>(p->output->tensor_data().data());
+
+          VLOG(2) << "call NcclAllGather collective_key "
+                  << collective->collective_key << " participant " << p_idx
+                  << " sendbuff " << sendbuff << " sendcount "
+                  << p->input->NumElements() << " recvbuff " << recvbuff
+                  << " recvcount " << p->output->NumElements() << " nccl_comm "
+                  << nccl_comm << " comm_stream " << comm_stream
+                  << " cuda_stream " << cu_stream;
+          profiler::AnnotatedTraceMe traceme([&] {
+            return profiler::TraceMeEncode(
+                "ncclAllGather",
+                {{"buffer_size", ComputeBufferSize(p, collective->data_type)},
+                 {"collective_type", "all_gather"}});
+          });
+          nccl_result = ncclAllGather(sendbuff, recvbuff, p->input->NumElements(),
+                                      data_type, nccl_comm, cu_stream);
+          break;
+        }
+        case kReduceScatter: {
+          const void* sendbuff = p->input->tensor_data().data();
+          void* recvbuff = const_cast<char*>(p->output->tensor_data().data());
+
+          VLOG(2) << "call NcclReduceScatter collective_key "
+                  << collective->collective_key << " participant " << p_idx
+                  << " num_participants " << collective->participants.size()
+                  << " sendbuff " << sendbuff << " recvbuff " << recvbuff
+                  << " nccl_comm " << nccl_comm << " comm_stream " << comm_stream
+                  << " cuda_stream " << cu_stream;
+          profiler::AnnotatedTraceMe traceme([&] {
+            return profiler::TraceMeEncode(
+                "ncclReduceScatter",
+                {{"buffer_size", ComputeBufferSize(p, collective->data_type)},
+                 {"collective_type", "reduce_scatter"}});
+          });
+          nccl_result = ncclReduceScatter(
+              sendbuff, recvbuff, p->output->NumElements(), data_type,
+              collective->reduction_op, nccl_comm, cu_stream);
+          break;
+        }
+        case kAllToAll: {
+          const char* sendbuff = p->input->tensor_data().data();
+          char* recvbuff = const_cast<char*>(p->output->tensor_data().data());
+          size_t count =
+              p->input->NumElements() / collective->participants.size();
+          size_t rank_offset = count * DataTypeSize(collective->data_type);
+
+          VLOG(2) << "call Nccl All to All collective_key "
+                  << collective->collective_key << " participant " << p_idx
+                  << " num_participants " << collective->participants.size()
+                  << " sendbuff " << static_cast<const void*>(sendbuff)
+                  << " recvbuff " << static_cast<void*>(recvbuff) << " nccl_comm "
+                  << nccl_comm << " comm_stream " << comm_stream
+                  << " cuda_stream " << cu_stream;
+          profiler::AnnotatedTraceMe traceme([&] {
+            return profiler::TraceMeEncode(
+                "ncclAllToAll",
+                {{"buffer_size", ComputeBufferSize(p, collective->data_type)},
+                 {"collective_type", "all_to_all"}});
+          });
+          ncclGroupStart();
+          for (int i = 0; i < collective->participants.size(); ++i) {
+            ncclSend(sendbuff + i * rank_offset, count, data_type,
+                     collective->participants[i]->global_rank, nccl_comm,
+                     cu_stream);
+            ncclRecv(recvbuff + i * rank_offset, count, data_type,
+                     collective->participants[i]->global_rank, nccl_comm,
+                     cu_stream);
+          }
+          nccl_result = ncclGroupEnd();
+          break;
         }
-        VLOG(2) << "call NcclBroadcast collective_key "
-                << collective->collective_key << " participant " << p_idx
-                << " sendbuff " << sendbuff << " recvbuff " << recvbuff
-                << " nccl_comm " << nccl_comm << " comm_stream " << comm_stream
-                << " cuda_stream " << cu_stream;
-        profiler::AnnotatedTraceMe traceme([&] {
-          return profiler::TraceMeEncode(
-              "ncclBroadcast",
-              {{"buffer_size", ComputeBufferSize(p, collective->data_type)},
-               {"collective_type", "broadcast"}});
-        });
-        nccl_result =
-            ncclBroadcast(sendbuff, recvbuff, num_elements, data_type,
-                          collective->root_rank, nccl_comm, cu_stream);
-        break;
-      }
-      case kReduce: {
-        const void* sendbuff = p->input->tensor_data().data();
-        void* recvbuff =
-            p->output ? const_cast<char*>(p->output->tensor_data().data())
-                      : nullptr;
-        profiler::AnnotatedTraceMe traceme([&] {
-          return profiler::TraceMeEncode(
-              "buffer_size",
-              {{"output_size", ComputeBufferSize(p, collective->data_type)},
-               {"collective_type", "reduce"}});
-        });
-        nccl_result = ncclReduce(sendbuff, recvbuff, p->input->NumElements(),
-                                 data_type, collective->reduction_op,
-                                 collective->root_rank, nccl_comm, cu_stream);
-        break;
       }
-      case kAllGather: {
-        const void* sendbuff = p->input->tensor_data().data();
-        void* recvbuff = const_cast<char*>(p->output->tensor_data().data());
+    }
 
-        VLOG(2) << "call NcclAllGather collective_key "
-                << collective->collective_key << " participant " << p_idx
-                << " sendbuff " << sendbuff << " sendcount "
-                << p->input->NumElements() << " recvbuff " << recvbuff
-                << " recvcount " << p->output->NumElements() << " nccl_comm "
-                << nccl_comm << " comm_stream " << comm_stream
-                << " cuda_stream " << cu_stream;
-        profiler::AnnotatedTraceMe traceme([&] {
-          return profiler::TraceMeEncode(
-              "ncclAllGather",
-              {{"buffer_size", ComputeBufferSize(p, collective->data_type)},
-               {"collective_type", "all_gather"}});
-        });
-        nccl_result = ncclAllGather(sendbuff, recvbuff, p->input->NumElements(),
-                                    data_type, nccl_comm, cu_stream);
-        break;
+    if (grouped) {
+      const ncclResult_t group_result = ncclGroupEnd();
+      if (group_result != ncclSuccess) {
+        for (ncclResult_t& result : results) {
+          if (result == ncclSuccess) {
+            result = group_result;
+          }
+        }
       }
-      case kReduceScatter: {
-        const void* sendbuff = p->input->tensor_data().data();
-        void* recvbuff = const_cast<char*>(p->output->tensor_data().data());
+    }
 
-        VLOG(2) << "call NcclReduceScatter collective_key "
-                << collective->collective_key << " participant " << p_idx
-                << " num_participants " << collective->participants.size()
-                << " sendbuff " << sendbuff << " recvbuff " << recvbuff
-                << " nccl_comm " << nccl_comm << " comm_stream " << comm_stream
-                << " cuda_stream " << cu_stream;
-        profiler::AnnotatedTraceMe traceme([&] {
-          return profiler::TraceMeEncode(
-              "ncclReduceScatter",
-              {{"buffer_size", ComputeBufferSize(p, collective->data_type)},
-               {"collective_type", "reduce_scatter"}});
-        });
-        nccl_result = ncclReduceScatter(
-            sendbuff, recvbuff, p->output->NumElements(), data_type,
-            collective->reduction_op, nccl_comm, cu_stream);
-        break;
+    for (int launch_idx = 0; launch_idx < next_launches.size(); ++launch_idx) {
+      Collective* collective = next_launches[launch_idx].first;
+      if (collective == nullptr) {
+        continue;
       }
-      case kAllToAll: {
-        const char* sendbuff = p->input->tensor_data().data();
-        char* recvbuff = const_cast<char*>(p->output->tensor_data().data());
-        size_t count =
-            p->input->NumElements() / collective->participants.size();
-        size_t rank_offset = count * DataTypeSize(collective->data_type);
-
-        VLOG(2) << "call Nccl All to All collective_key "
+      const int p_idx = next_launches[launch_idx].second;
+      const ncclResult_t nccl_result = results[launch_idx];
+      // Run the done_callback when the nccl kernel finishes running.
+      auto done_callback = [collective, p_idx, nccl_result]() {
+        VLOG(2) << "done Nccl kernel collective_key "
                 << collective->collective_key << " participant " << p_idx
-                << " num_participants " << collective->participants.size()
-                << " sendbuff " << static_cast<const void*>(sendbuff)
-                << " recvbuff " << static_cast<void*>(recvbuff) << " nccl_comm "
-                << nccl_comm << " comm_stream " << comm_stream
-                << " cuda_stream " << cu_stream;
-        profiler::AnnotatedTraceMe traceme([&] {
-          return profiler::TraceMeEncode(
-              "ncclAllToAll",
-              {{"buffer_size", ComputeBufferSize(p, collective->data_type)},
-               {"collective_type", "all_to_all"}});
-        });
-        ncclGroupStart();
-        for (int i = 0; i < collective->participants.size(); ++i) {
-          ncclSend(sendbuff + i * rank_offset, count, data_type,
-                   collective->participants[i]->global_rank, nccl_comm,
-                   cu_stream);
-          ncclRecv(recvbuff + i * rank_offset, count, data_type,
-                   collective->participants[i]->global_rank, nccl_comm,
-                   cu_stream);
+                << " ncclResult " << nccl_result;
+        if (nccl_result == ncclSuccess) {
+          collective->participants[p_idx]->done_callback(OkStatus());
+        } else {
+          // Propagate the error, but note that if other members of the
+          // collective did launch their kernels, then they are hanging.
+          collective->participants[p_idx]->done_callback(errors::Unknown(
+              "Error invoking NCCL: ", ncclGetErrorString(nccl_result)));
         }
-        nccl_result = ncclGroupEnd();
-        break;
-      }
+        collective->Unref();
+      };
+      collective->participants[p_idx]->event_mgr->ThenExecute(comm_stream,
+                                                              done_callback);
     }
-
-    // Run the done_callback when the nccl kernel finishes running.
-    auto done_callback = [collective, p_idx, nccl_result]() {
-      VLOG(2) << "done Nccl kernel collective_key "
-              << collective->collective_key << " participant " << p_idx
-              << " ncclResult " << nccl_result;
-      if (nccl_result == ncclSuccess) {
-        collective->participants[p_idx]->done_callback(OkStatus());
-      } else {
-        // Propagate the error, but note that if other members of the collective
-        // did launch their kernels, then they are hanging.
-        collective->participants[p_idx]->done_callback(errors::Unknown(
-            "Error invoking NCCL: ", ncclGetErrorString(nccl_result)));
-      }
-      collective->Unref();
-    };
-    p->event_mgr->ThenExecute(comm_stream, done_callback);
   }
 }
 
@@ -45,6 +45,14 @@ REGISTER_OP("BatchFunction")
     .Attr("container: string = ''")
     .Attr("shared_name: string = ''")
     .Attr("batching_queue: string = ''")
+    // If non-empty, requests are routed to per-bucket batching queues based
+    // on the largest second (non-batch) dimension among their inputs: a
+    // request goes to the first bucket whose boundary is >= that dimension,
+    // or to an overflow bucket when no such boundary exists. Batching only
+    // combines requests from the same bucket, which bounds the padding
+    // inserted when concatenating variable-length inputs. The boundaries
+    // must be positive and strictly increasing.
+    .Attr("shape_bucket_boundaries: list(int) = []")
     // A separate set of batch options for the low priority requests, which is
     // used for priority queue batching.
     .Attr("low_priority_max_batch_size: int = 0")
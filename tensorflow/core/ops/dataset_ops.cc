@@ -205,6 +205,11 @@ REGISTER_OP("ParallelMapDatasetV2")
     // "true", "false", or "default".
     .Attr("deterministic: string = 'default'")
     .Attr("preserve_cardinality: bool = false")
+    // If > 1, the runtime may apply `f` to blocks of this many input elements
+    // stacked on a new leading dimension, falling back to per-element calls
+    // when element shapes do not match. `f` must be shape-polymorphic in its
+    // leading dimension for this to be valid.
+    .Attr("vectorization_block_size: int = 0")
     .Attr("metadata: string = ''")
     .SetTypeConstructor(full_type::VariadicTensorContainer(TFT_DATASET,
                                                            "output_types"))
@@ -1216,6 +1216,7 @@ REGISTER_OP("SnapshotDatasetReader")
     .Attr("output_shapes: list(shape) >= 1")
     .Attr("compression: string = ''")
     .Attr("version: int")
+    .Attr("projected_columns: list(int) = []")
     .SetTypeConstructor(full_type::VariadicTensorContainer(TFT_DATASET,
                                                            "output_types"))
     .SetShapeFn([](shape_inference::InferenceContext* c) {
@@ -280,6 +280,11 @@ REGISTER_OP("PartitionedCall")
     .Attr("config: string = ''")
     .Attr("config_proto: string = ''")
     .Attr("executor_type: string = ''")
+    // If > 1, inputs are split into this many micro-batches along dimension 0
+    // and the function is run once per micro-batch, overlapping execution of
+    // the function's partitions across micro-batches. Only valid for
+    // batch-parallel functions.
+    .Attr("pipelining_micro_batches: int = 1")
     .SetShapeFn(shape_inference::UnknownShape);
 
 REGISTER_OP("StatefulPartitionedCall")
@@ -291,6 +296,8 @@ REGISTER_OP("StatefulPartitionedCall")
     .Attr("config: string = ''")  // Deprecated in favor of config_proto
     .Attr("config_proto: string = ''")
     .Attr("executor_type: string = ''")
+    // See PartitionedCall.
+    .Attr("pipelining_micro_batches: int = 1")
     .SetIsStateful()
     .SetIsDistributedCommunication()
     .SetShapeFn(shape_inference::UnknownShape);
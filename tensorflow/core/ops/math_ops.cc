@@ -1016,6 +1016,38 @@ _FusedConv2D output.
 expected to create these operators.
 )doc");
 
+REGISTER_OP("_FusedAttention")
+    .Input("query: T")
+    .Input("key: T")
+    .Input("value: T")
+    .Output("output: T")
+    .Attr("T: {float}")
+    .Attr("scale: float = 1.0")
+    .Attr("transpose_key: bool = false")
+    .SetShapeFn([](shape_inference::InferenceContext* c) {
+      shape_inference::ShapeHandle query;
+      shape_inference::ShapeHandle value;
+      TF_RETURN_IF_ERROR(c->WithRankAtLeast(c->input(0), 2, &query));
+      TF_RETURN_IF_ERROR(c->WithRankAtLeast(c->input(2), 2, &value));
+      shape_inference::ShapeHandle output;
+      TF_RETURN_IF_ERROR(
+          c->ReplaceDim(query, -1, c->Dim(value, -1), &output));
+      c->set_output(0, output);
+      return OkStatus();
+    })
+    .Doc(R"doc(
+Computes scaled dot-product attention: softmax(scale * query x key^T) x value.
+
+The score matrix is never materialized; the kernel processes keys in tiles
+using an online softmax, so memory usage is linear in the sequence length.
+`key` is expected in [..., seq_k, head_dim] layout when `transpose_key` is
+true, and [..., head_dim, seq_k] layout otherwise, matching the `adj_y`
+attribute of the BatchMatMul this op replaces.
+
+*NOTE*: Do not invoke this operator directly in Python. Grappler is
+expected to create these operators.
+)doc");
+
 // --------------------------------------------------------------------------
 
 // For operations where the output is a reduction function along some
@@ -2011,6 +2043,20 @@ REGISTER_OP("QuantizedMatMul")
       return OkStatus();
     });
 
+// Internal op produced by the remapper when dynamic-range quantization of
+// MatMul is enabled. The kernel quantizes the float activations on the fly,
+// runs an eight-bit GEMM against constant weights it quantizes once, and
+// dequantizes the accumulators into the float output, so the signature
+// matches MatMul.
+REGISTER_OP("_DynamicQuantizedMatMul")
+    .Input("a: T")
+    .Input("b: T")
+    .Output("product: T")
+    .Attr("transpose_a: bool = false")
+    .Attr("transpose_b: bool = false")
+    .Attr("T: {float}")
+    .SetShapeFn(shape_inference::MatMulShape);
+
 // Note: This op is not commutative w.r.t. to all its inputs.
 REGISTER_OP("QuantizedMul")
     .Input("x: T1")
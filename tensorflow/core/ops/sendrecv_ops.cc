@@ -145,4 +145,35 @@ client_terminated: If set to true, this indicates that the node was added
   locally by the caller.
 )doc");
 
+REGISTER_OP("_PackComponents")
+    .Input("components: T_components")
+    .Output("packed: variant")
+    .Attr("T_components: list(type)")
+    .SetShapeFn(shape_inference::ScalarShape)
+    .Doc(R"doc(
+Packs several tensors into one variant scalar for a single send/recv
+transfer.
+
+Inserted by graph partitioning (see PartitionOptions.pack_composite_transfers)
+on the send side when several outputs of one node are consumed by the same
+destination partition, e.g. the component tensors of a ragged or sparse
+tensor.  The matching _UnpackComponents on the recv side restores the
+components.
+
+components: The tensors to pack.
+packed: A variant scalar carrying all of the components.
+)doc");
+
+REGISTER_OP("_UnpackComponents")
+    .Input("packed: variant")
+    .Output("components: T_components")
+    .Attr("T_components: list(type)")
+    .SetShapeFn(shape_inference::UnknownShape)
+    .Doc(R"doc(
+Restores the tensors packed into a variant scalar by _PackComponents.
+
+packed: A variant scalar produced by _PackComponents.
+components: The packed tensors, in their original order.
+)doc");
+
 }  // end namespace tensorflow
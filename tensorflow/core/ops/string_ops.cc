@@ -95,6 +95,25 @@ Do not invoke this operator directly in Python. A fusion optimization is
 expected to create these operators.
 )doc");
 
+REGISTER_OP("_BatchStringToHashBucketFast")
+    .Input("input: N * string")
+    .Output("output: N * int64")
+    .Attr("N: int >= 1")
+    .Attr("num_buckets: list(int)")
+    .SetShapeFn([](InferenceContext* c) {
+      for (int i = 0; i < c->num_inputs(); ++i) {
+        c->set_output(i, c->input(i));
+      }
+      return OkStatus();
+    })
+    .Doc(R"doc(
+Internal operation which applies StringToHashBucketFast to a batch of feature
+tensors, with `num_buckets[i]` used for input `i`: reserved for internal use.
+
+Do not invoke this operator directly in Python. A fusion optimization is
+expected to create these operators.
+)doc");
+
 REGISTER_OP("StringToHashBucketStrong")
     .Input("input: string")
     .Output("output: int64")
@@ -13,6 +13,7 @@ See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
 
+#include "tensorflow/core/framework/common_shape_fns.h"
 #include "tensorflow/core/framework/op.h"
 #include "tensorflow/core/framework/shape_inference.h"
 
@@ -99,6 +100,18 @@ REGISTER_OP("ResourceApplyGradientDescent")
     .Attr("use_locking: bool = false")
     .SetShapeFn(ApplyGradientDescentShapeFn<true>);
 
+// Internal op emitted by the "multi_tensor_apply" grappler pass. Applies the
+// gradient descent update to N variables in one op dispatch; all variables
+// share the same alpha input.
+REGISTER_OP("_ResourceApplyGradientDescentPacked")
+    .Input("var: N * resource")
+    .Input("alpha: T")
+    .Input("delta: N * T")
+    .Attr("N: int >= 1")
+    .Attr("T: numbertype")
+    .Attr("use_locking: bool = false")
+    .SetShapeFn(shape_inference::NoOutputs);
+
 template <bool is_sparse, bool is_resource>
 Status ApplyProximalGradientDescentShapeFn(InferenceContext* c) {
   ShapeHandle unused;
@@ -826,6 +839,26 @@ REGISTER_OP("ResourceApplyAdam")
     .Attr("use_nesterov: bool = false")
     .SetShapeFn(ApplyAdamShapeFn</*is_resource=*/true>);
 
+// Internal op emitted by the "multi_tensor_apply" grappler pass. Applies the
+// Adam update to N variables in one op dispatch; all variables share the same
+// hyperparameter inputs.
+REGISTER_OP("_ResourceApplyAdamPacked")
+    .Input("var: N * resource")
+    .Input("m: N * resource")
+    .Input("v: N * resource")
+    .Input("beta1_power: T")
+    .Input("beta2_power: T")
+    .Input("lr: T")
+    .Input("beta1: T")
+    .Input("beta2: T")
+    .Input("epsilon: T")
+    .Input("grad: N * T")
+    .Attr("N: int >= 1")
+    .Attr("T: numbertype")
+    .Attr("use_locking: bool = false")
+    .Attr("use_nesterov: bool = false")
+    .SetShapeFn(shape_inference::NoOutputs);
+
 template <bool is_resource>
 static Status ApplyAdamWithAmsgradShapeFn(InferenceContext* c) {
   ShapeHandle unused;
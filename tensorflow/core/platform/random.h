@@ -23,6 +23,7 @@ namespace tensorflow {
 namespace random {
 using tsl::random::New64;             // NOLINT
 using tsl::random::New64DefaultSeed;  // NOLINT
+using tsl::random::ThreadLocalNew64;  // NOLINT
 }  // namespace random
 }  // namespace tensorflow
 
@@ -0,0 +1,211 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/summary/async_summary_writer.h"
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <utility>
+
+#include "tensorflow/core/framework/graph.pb.h"
+#include "tensorflow/core/lib/core/errors.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/thread_annotations.h"
+#include "tensorflow/core/util/event.pb.h"
+
+namespace tensorflow {
+namespace {
+
+class AsyncSummaryWriter : public SummaryWriterInterface {
+ public:
+  AsyncSummaryWriter(SummaryWriterInterface* inner, int max_pending, Env* env)
+      : inner_(inner), max_pending_(max_pending > 0 ? max_pending : 1) {
+    thread_.reset(env->StartThread(ThreadOptions(), "async_summary_writer",
+                                   [this]() { WorkLoop(); }));
+  }
+
+  ~AsyncSummaryWriter() override {
+    {
+      mutex_lock l(mu_);
+      shutdown_ = true;
+      work_added_.notify_all();
+    }
+    // Joins the background thread, which drains the queue before exiting.
+    thread_.reset();
+    inner_->Unref();
+  }
+
+  Status Flush() override {
+    // Step-end barrier: wait for every buffered write to reach the wrapped
+    // writer, then flush the wrapped writer itself.
+    mutex_lock l(mu_);
+    while (!queue_.empty() || busy_) {
+      work_done_.wait(l);
+    }
+    if (!status_.ok()) {
+      Status s = status_;
+      status_ = OkStatus();
+      return s;
+    }
+    // The background thread is idle while `mu_` is held with an empty queue,
+    // so flushing the wrapped writer here cannot race with a write.
+    return inner_->Flush();
+  }
+
+  Status WriteTensor(int64_t global_step, Tensor t, const string& tag,
+                     const string& serialized_metadata) override {
+    return Enqueue([this, global_step, t = std::move(t), tag,
+                    serialized_metadata]() {
+      return inner_->WriteTensor(global_step, t, tag, serialized_metadata);
+    });
+  }
+
+  Status WriteScalar(int64_t global_step, Tensor t,
+                     const string& tag) override {
+    return Enqueue([this, global_step, t = std::move(t), tag]() {
+      return inner_->WriteScalar(global_step, t, tag);
+    });
+  }
+
+  Status WriteHistogram(int64_t global_step, Tensor t,
+                        const string& tag) override {
+    return Enqueue([this, global_step, t = std::move(t), tag]() {
+      return inner_->WriteHistogram(global_step, t, tag);
+    });
+  }
+
+  Status WriteImage(int64_t global_step, Tensor t, const string& tag,
+                    int max_images, Tensor bad_color) override {
+    return Enqueue([this, global_step, t = std::move(t), tag, max_images,
+                    bad_color = std::move(bad_color)]() {
+      return inner_->WriteImage(global_step, t, tag, max_images, bad_color);
+    });
+  }
+
+  Status WriteAudio(int64_t global_step, Tensor t, const string& tag,
+                    int max_outputs, float sample_rate) override {
+    return Enqueue([this, global_step, t = std::move(t), tag, max_outputs,
+                    sample_rate]() {
+      return inner_->WriteAudio(global_step, t, tag, max_outputs, sample_rate);
+    });
+  }
+
+  Status WriteGraph(int64_t global_step,
+                    std::unique_ptr<GraphDef> graph) override {
+    // std::function requires copyable captures; the graph is moved back into
+    // a unique_ptr when the closure runs (it runs exactly once).
+    std::shared_ptr<GraphDef> shared_graph(graph.release());
+    return Enqueue([this, global_step, shared_graph]() {
+      return inner_->WriteGraph(
+          global_step, std::make_unique<GraphDef>(std::move(*shared_graph)));
+    });
+  }
+
+  Status WriteEvent(std::unique_ptr<Event> e) override {
+    std::shared_ptr<Event> shared_event(e.release());
+    return Enqueue([this, shared_event]() {
+      return inner_->WriteEvent(
+          std::make_unique<Event>(std::move(*shared_event)));
+    });
+  }
+
+  string DebugString() const override { return "AsyncSummaryWriter"; }
+
+ private:
+  Status Enqueue(std::function<Status()> work) {
+    mutex_lock l(mu_);
+    if (shutdown_) {
+      return errors::FailedPrecondition(
+          "Async summary writer has been shut down.");
+    }
+    // Report (and clear) any error from earlier background writes instead of
+    // silently dropping it.
+    if (!status_.ok()) {
+      Status s = status_;
+      status_ = OkStatus();
+      return s;
+    }
+    // Bounded memory: block until the background thread catches up.
+    while (queue_.size() >= max_pending_ && !shutdown_) {
+      space_available_.wait(l);
+    }
+    queue_.push_back(std::move(work));
+    work_added_.notify_one();
+    return OkStatus();
+  }
+
+  void WorkLoop() {
+    while (true) {
+      std::function<Status()> work;
+      {
+        mutex_lock l(mu_);
+        while (queue_.empty() && !shutdown_) {
+          work_added_.wait(l);
+        }
+        if (queue_.empty()) {
+          // Shutting down with a drained queue.
+          work_done_.notify_all();
+          return;
+        }
+        work = std::move(queue_.front());
+        queue_.pop_front();
+        busy_ = true;
+        space_available_.notify_one();
+      }
+      // Histograms, image encoding and serialization run here, outside the
+      // lock and off the training step.
+      Status s = work();
+      {
+        mutex_lock l(mu_);
+        busy_ = false;
+        if (!s.ok() && status_.ok()) {
+          status_ = s;
+        }
+        if (queue_.empty()) {
+          work_done_.notify_all();
+        }
+      }
+    }
+  }
+
+  SummaryWriterInterface* const inner_;
+  const size_t max_pending_;
+
+  mutex mu_;
+  condition_variable work_added_;
+  condition_variable work_done_;
+  condition_variable space_available_;
+  std::deque<std::function<Status()>> queue_ TF_GUARDED_BY(mu_);
+  bool busy_ TF_GUARDED_BY(mu_) = false;
+  bool shutdown_ TF_GUARDED_BY(mu_) = false;
+  Status status_ TF_GUARDED_BY(mu_);
+
+  // Joined in the destructor; must be declared after the state it uses.
+  std::unique_ptr<Thread> thread_;
+};
+
+}  // namespace
+
+Status CreateAsyncSummaryWriter(SummaryWriterInterface* inner, int max_pending,
+                                Env* env, SummaryWriterInterface** result) {
+  if (inner == nullptr) {
+    return errors::InvalidArgument(
+        "Async summary writer requires a wrapped writer.");
+  }
+  *result = new AsyncSummaryWriter(inner, max_pending, env);
+  return OkStatus();
+}
+
+}  // namespace tensorflow
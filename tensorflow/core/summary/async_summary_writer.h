@@ -0,0 +1,46 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_CORE_SUMMARY_ASYNC_SUMMARY_WRITER_H_
+#define TENSORFLOW_CORE_SUMMARY_ASYNC_SUMMARY_WRITER_H_
+
+#include "tensorflow/core/kernels/summary_interface.h"
+#include "tensorflow/core/lib/core/status.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/types.h"
+
+namespace tensorflow {
+
+/// \brief Creates a SummaryWriterInterface that forwards writes to `inner`
+/// from a background thread.
+///
+/// Each Write* call snapshots its tensor arguments and returns immediately;
+/// histogram computation, image encoding, proto serialization and file I/O
+/// all happen on the background thread, off the training step. At most
+/// `max_pending` writes are buffered, so memory stays bounded; once the
+/// queue is full, callers block until the background thread catches up.
+///
+/// Flush() is a barrier: it waits for every buffered write to reach `inner`
+/// and then flushes `inner` itself. Errors from background writes are
+/// reported by the next Write* or Flush() call.
+///
+/// Takes ownership of one reference on `inner`. The caller owns a reference
+/// to `*result` if the returned status is ok. The Env object must not be
+/// destroyed until after the returned writer.
+Status CreateAsyncSummaryWriter(SummaryWriterInterface* inner, int max_pending,
+                                Env* env, SummaryWriterInterface** result);
+
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_SUMMARY_ASYNC_SUMMARY_WRITER_H_
@@ -0,0 +1,183 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/summary/async_summary_writer.h"
+
+#include <memory>
+#include <vector>
+
+#include "tensorflow/core/framework/graph.pb.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/lib/core/errors.h"
+#include "tensorflow/core/lib/core/refcount.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/lib/strings/strcat.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/test.h"
+#include "tensorflow/core/util/event.pb.h"
+
+namespace tensorflow {
+namespace {
+
+// Records the tags of the writes it receives, optionally failing them, so
+// tests can observe what reached the wrapped writer and when.
+class RecordingWriter : public SummaryWriterInterface {
+ public:
+  Status Flush() override {
+    mutex_lock l(mu_);
+    flush_count_++;
+    return OkStatus();
+  }
+
+  Status WriteTensor(int64_t global_step, Tensor t, const string& tag,
+                     const string& serialized_metadata) override {
+    return Record(tag);
+  }
+
+  Status WriteScalar(int64_t global_step, Tensor t,
+                     const string& tag) override {
+    return Record(tag);
+  }
+
+  Status WriteHistogram(int64_t global_step, Tensor t,
+                        const string& tag) override {
+    return Record(tag);
+  }
+
+  Status WriteImage(int64_t global_step, Tensor t, const string& tag,
+                    int max_images, Tensor bad_color) override {
+    return Record(tag);
+  }
+
+  Status WriteAudio(int64_t global_step, Tensor t, const string& tag,
+                    int max_outputs, float sample_rate) override {
+    return Record(tag);
+  }
+
+  Status WriteGraph(int64_t global_step,
+                    std::unique_ptr<GraphDef> graph) override {
+    return Record("graph");
+  }
+
+  Status WriteEvent(std::unique_ptr<Event> e) override {
+    return Record("event");
+  }
+
+  string DebugString() const override { return "RecordingWriter"; }
+
+  std::vector<string> tags() {
+    mutex_lock l(mu_);
+    return tags_;
+  }
+
+  int flush_count() {
+    mutex_lock l(mu_);
+    return flush_count_;
+  }
+
+  void set_next_status(const Status& status) {
+    mutex_lock l(mu_);
+    next_status_ = status;
+  }
+
+ private:
+  Status Record(const string& tag) {
+    mutex_lock l(mu_);
+    Status s = next_status_;
+    next_status_ = OkStatus();
+    if (s.ok()) {
+      tags_.push_back(tag);
+    }
+    return s;
+  }
+
+  mutex mu_;
+  std::vector<string> tags_ TF_GUARDED_BY(mu_);
+  int flush_count_ TF_GUARDED_BY(mu_) = 0;
+  Status next_status_ TF_GUARDED_BY(mu_);
+};
+
+Tensor One() {
+  Tensor t(DT_FLOAT, TensorShape({}));
+  t.scalar<float>()() = 1.0;
+  return t;
+}
+
+TEST(AsyncSummaryWriterTest, WritesAreForwardedInOrder) {
+  auto* recorder = new RecordingWriter;
+  SummaryWriterInterface* writer;
+  TF_ASSERT_OK(
+      CreateAsyncSummaryWriter(recorder, 4, Env::Default(), &writer));
+  core::ScopedUnref deleter(writer);
+  recorder->Ref();
+  core::ScopedUnref recorder_deleter(recorder);
+
+  for (int i = 0; i < 10; ++i) {
+    TF_ASSERT_OK(writer->WriteScalar(i, One(), strings::StrCat("tag", i)));
+  }
+  TF_ASSERT_OK(writer->WriteHistogram(10, One(), "hist"));
+
+  // Flush is the barrier: afterwards every write must have reached the
+  // wrapped writer, in order, and the wrapped writer must have been flushed.
+  TF_ASSERT_OK(writer->Flush());
+  std::vector<string> tags = recorder->tags();
+  ASSERT_EQ(tags.size(), 11);
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_EQ(tags[i], strings::StrCat("tag", i));
+  }
+  EXPECT_EQ(tags[10], "hist");
+  EXPECT_EQ(recorder->flush_count(), 1);
+}
+
+TEST(AsyncSummaryWriterTest, DrainsQueueOnDestruction) {
+  auto* recorder = new RecordingWriter;
+  recorder->Ref();
+  core::ScopedUnref recorder_deleter(recorder);
+  {
+    SummaryWriterInterface* writer;
+    TF_ASSERT_OK(
+        CreateAsyncSummaryWriter(recorder, 4, Env::Default(), &writer));
+    core::ScopedUnref deleter(writer);
+    for (int i = 0; i < 8; ++i) {
+      TF_ASSERT_OK(writer->WriteScalar(i, One(), strings::StrCat("tag", i)));
+    }
+  }
+  EXPECT_EQ(recorder->tags().size(), 8);
+}
+
+TEST(AsyncSummaryWriterTest, BackgroundErrorsAreReported) {
+  auto* recorder = new RecordingWriter;
+  SummaryWriterInterface* writer;
+  TF_ASSERT_OK(
+      CreateAsyncSummaryWriter(recorder, 4, Env::Default(), &writer));
+  core::ScopedUnref deleter(writer);
+  recorder->Ref();
+  core::ScopedUnref recorder_deleter(recorder);
+
+  recorder->set_next_status(errors::Internal("disk on fire"));
+  TF_ASSERT_OK(writer->WriteScalar(0, One(), "tag"));
+  // The write fails on the background thread; the error surfaces on the next
+  // barrier instead of being dropped.
+  Status s = writer->Flush();
+  EXPECT_TRUE(errors::IsInternal(s));
+  // The error has been reported once; the writer keeps working.
+  TF_ASSERT_OK(writer->WriteScalar(1, One(), "tag1"));
+  TF_ASSERT_OK(writer->Flush());
+  ASSERT_EQ(recorder->tags().size(), 1);
+  EXPECT_EQ(recorder->tags()[0], "tag1");
+}
+
+}  // namespace
+}  // namespace tensorflow
@@ -17,6 +17,7 @@ limitations under the License.
 #include <algorithm>
 #include <array>
 #include <cstdint>
+#include <cstdlib>
 #include <functional>
 #include <memory>
 #include <numeric>
@@ -28,6 +29,7 @@ limitations under the License.
 #include "absl/log/check.h"
 #include "absl/log/log.h"
 #include "absl/status/status.h"
+#include "absl/strings/numbers.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
 #include "absl/time/clock.h"
@@ -481,6 +483,26 @@ StatusOr<std::unique_ptr<GraphExecutor>> GraphExecutor::Create(
     options.cost_analysis_options.version = Options::CostAnalysisOptions::kOnce;
   }
 
+  // The compiler runs streams whose total cost falls below
+  // `compile_options.cost_threshold` inline on the thread that resolved their
+  // inputs instead of dispatching them to the work queue. The threshold
+  // defaults to 1 (everything is considered expensive), and most callers have
+  // no hook to change it; TF_TFRT_COST_THRESHOLD lets latency-critical
+  // deployments raise it without a code change. With cost analysis enabled
+  // above, recompilation applies the same threshold to the measured op costs.
+  if (const char* cost_threshold_env = std::getenv("TF_TFRT_COST_THRESHOLD")) {
+    uint64_t cost_threshold = 0;
+    if (absl::SimpleAtoi(cost_threshold_env, &cost_threshold) &&
+        cost_threshold > 0) {
+      LOG(INFO) << "Overriding TFRT compile cost_threshold with "
+                << cost_threshold << " from TF_TFRT_COST_THRESHOLD.";
+      options.compile_options.cost_threshold = cost_threshold;
+    } else {
+      LOG(WARNING) << "Ignoring invalid TF_TFRT_COST_THRESHOLD value: "
+                   << cost_threshold_env;
+    }
+  }
+
   TfrtGraphExecutionState::Options graph_execution_state_options;
   graph_execution_state_options.run_placer_grappler_on_functions =
       options.run_placer_grappler_on_functions;
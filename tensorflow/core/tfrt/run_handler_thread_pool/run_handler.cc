@@ -356,6 +356,8 @@ RunHandlerThreadPool::RunHandlerThreadPool(
       blocking_thread_max_waiting_time_(
           options.blocking_threads_max_sleep_time_micro_sec),
       enable_wake_up_(options.enable_wake_up),
+      adaptive_domain_stealing_(ParamFromEnvBoolWithDefault(
+          "TF_RUN_HANDLER_ADAPTIVE_DOMAIN_STEALING", false)),
       thread_data_(num_threads_),
       env_(env, thread_options, name),
       name_(name),
@@ -522,6 +524,12 @@ void RunHandlerThreadPool::WorkerLoop(int thread_id,
   pt->pool = this;
   pt->thread_id = thread_id;
   static constexpr int32_t kMaxBlockingInflight = 10;
+  // Number of consecutive empty scans a non-blocking thread must see before
+  // it starts taking blocking work (when adaptive domain stealing is on).
+  // The hysteresis keeps a momentary gap between intra-op closures from
+  // flipping the thread to the other domain.
+  static constexpr int kEmptyScansBeforeDomainSteal = 2;
+  int consecutive_empty_scans = 0;
 
   while (!cancelled_) {
     Task t;
@@ -577,6 +585,20 @@ void RunHandlerThreadPool::WorkerLoop(int thread_id,
                    kMaxBlockingInflight,
                    /*may_steal_blocking_work=*/false, *thread_work_sources,
                    &task_from_blocking_queue, &tws);
+      if (t.f) {
+        consecutive_empty_scans = 0;
+      } else if (adaptive_domain_stealing_ &&
+                 ++consecutive_empty_scans >= kEmptyScansBeforeDomainSteal) {
+        // The intra-op side of the pool has gone idle; rather than sleeping
+        // while inter-op work queues up (e.g. during a sequential phase of
+        // the model), take blocking work as well. Each iteration scans the
+        // non-blocking queues before reaching this point, so the thread
+        // flips back to intra-op work as soon as any reappears.
+        t = FindTask(0, active_requests, thread_id, sub_thread_pool_id,
+                     kMaxBlockingInflight,
+                     /*may_steal_blocking_work=*/true, *thread_work_sources,
+                     &task_from_blocking_queue, &tws);
+      }
     }
     if (t.f) {
       VLOG(2) << "Running " << (task_from_blocking_queue ? "inter" : "intra")
@@ -399,6 +399,11 @@ class RunHandlerThreadPool {
   const int non_blocking_thread_sleep_time_;
   const int blocking_thread_max_waiting_time_;
   const bool enable_wake_up_;
+  // If true, non-blocking (intra-op) threads that keep finding their queues
+  // empty may take blocking (inter-op) work, so the split between the two
+  // domains adapts to the workload's phase. Controlled by the env var
+  // TF_RUN_HANDLER_ADAPTIVE_DOMAIN_STEALING.
+  const bool adaptive_domain_stealing_;
   Eigen::MaxSizeVector<ThreadData> thread_data_;
   internal::RunHandlerEnvironment env_;
   std::atomic<bool> cancelled_;
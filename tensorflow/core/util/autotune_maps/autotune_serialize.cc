@@ -16,6 +16,8 @@ limitations under the License.
 // For Google-internal use only.
 #include "tensorflow/core/util/autotune_maps/autotune_serialize.h"
 
+#include <atomic>
+#include <cstdlib>
 #include <map>
 #include <string>
 #include <unordered_map>
@@ -24,7 +26,12 @@ limitations under the License.
 #include "xla/status_macros.h"
 #include "xla/stream_executor/dnn.h"
 #include "xla/stream_executor/gpu/gpu_init.h"
+#include "xla/stream_executor/stream_executor.h"
+#include "tensorflow/core/lib/io/path.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/fingerprint.h"
 #include "tensorflow/core/platform/str_util.h"
+#include "tensorflow/core/platform/strcat.h"
 #include "tensorflow/core/util/activation_mode.h"
 #include "tensorflow/core/util/autotune_maps/autotune_map.pb.h"
 #include "tensorflow/core/util/autotune_maps/conv_autotune_maps.h"
@@ -210,4 +217,124 @@ void ResetAutotuneMaps() {
 #endif  // GOOGLE_CUDA || TENSORFLOW_USE_ROCM
 }
 
+namespace {
+
+// Directory for the persistent autotune cache, or the empty string when
+// persistence is disabled.
+std::string AutotunePersistentCacheDir() {
+  const char* dir = std::getenv("TF_AUTOTUNE_PERSISTENT_CACHE_DIR");
+  return dir == nullptr ? std::string() : std::string(dir);
+}
+
+#if GOOGLE_CUDA || TENSORFLOW_USE_ROCM
+// Path of the cache file inside `dir`. The file name is keyed by a
+// fingerprint of the visible GPU models, the DNN library version and the
+// ConvParameters version, so caches written on other machines or under other
+// library versions are simply never opened.
+StatusOr<std::string> AutotunePersistentCachePath(const std::string& dir) {
+  TF_ASSIGN_OR_RETURN(
+      se::Platform* platform,
+      se::MultiPlatformManager::PlatformWithName(se::GpuPlatformName()));
+  uint64 fingerprint =
+      Fingerprint64(strings::StrCat("v", ConvParameters::kVersion));
+  for (int i = 0; i < platform->VisibleDeviceCount(); i++) {
+    TF_ASSIGN_OR_RETURN(std::unique_ptr<se::DeviceDescription> device_desc,
+                        platform->DescriptionForDevice(i));
+    fingerprint =
+        FingerprintCat64(fingerprint, Fingerprint64(device_desc->model_str()));
+  }
+  if (platform->VisibleDeviceCount() > 0) {
+    TF_ASSIGN_OR_RETURN(se::StreamExecutor * executor,
+                        platform->ExecutorForDevice(0));
+    if (auto* dnn = executor->AsDnn()) {
+      auto version = dnn->GetVersion();
+      if (version.ok()) {
+        fingerprint = FingerprintCat64(
+            fingerprint,
+            Fingerprint64(strings::StrCat(version->major_version(), ".",
+                                          version->minor_version(), ".",
+                                          version->patch())));
+      }
+    }
+  }
+  return io::JoinPath(dir,
+                      strings::StrCat("tf_autotune_cache_", fingerprint, ".pb"));
+}
+
+Status LoadPersistentAutotuneMapsImpl() {
+  const std::string dir = AutotunePersistentCacheDir();
+  if (dir.empty()) {
+    return OkStatus();
+  }
+  TF_ASSIGN_OR_RETURN(const std::string path, AutotunePersistentCachePath(dir));
+  std::string data;
+  Status status = ReadFileToString(Env::Default(), path, &data);
+  if (errors::IsNotFound(status)) {
+    // Cold cache; the first save will create the file.
+    return OkStatus();
+  }
+  TF_RETURN_IF_ERROR(status);
+  TF_RETURN_IF_ERROR(LoadSerializedAutotuneMaps(data));
+  LOG(INFO) << "Loaded persisted autotune results from " << path;
+  return OkStatus();
+}
+
+Status SavePersistentAutotuneMaps() {
+  const std::string dir = AutotunePersistentCacheDir();
+  if (dir.empty()) {
+    return OkStatus();
+  }
+  TF_ASSIGN_OR_RETURN(const std::string path, AutotunePersistentCachePath(dir));
+  std::string serialized;
+  TF_RETURN_IF_ERROR(SerializeAutotuneMaps(&serialized));
+  TF_RETURN_IF_ERROR(Env::Default()->RecursivelyCreateDir(dir));
+  // Write to a temporary file and rename so that readers never observe a
+  // partially written cache.
+  const std::string tmp_path = strings::StrCat(path, ".tmp");
+  TF_RETURN_IF_ERROR(WriteStringToFile(Env::Default(), tmp_path, serialized));
+  return Env::Default()->RenameFile(tmp_path, path);
+}
+
+// True while a save closure is scheduled but has not run yet; used to
+// coalesce bursts of save requests during warmup.
+std::atomic<bool> save_pending(false);
+
+// Delay before a scheduled save runs, so that a warmup phase autotuning many
+// convolutions back to back results in a single write.
+constexpr int64_t kSaveDelayMicros = 10 * 1000 * 1000;
+#endif  // GOOGLE_CUDA || TENSORFLOW_USE_ROCM
+
+}  // namespace
+
+Status LoadPersistentAutotuneMaps() {
+#if GOOGLE_CUDA || TENSORFLOW_USE_ROCM
+  // The load is attempted exactly once per process; later calls return the
+  // first call's status.
+  static Status* result = new Status(LoadPersistentAutotuneMapsImpl());
+  return *result;
+#else
+  return OkStatus();
+#endif  // GOOGLE_CUDA || TENSORFLOW_USE_ROCM
+}
+
+void RequestPersistentAutotuneMapsSave() {
+#if GOOGLE_CUDA || TENSORFLOW_USE_ROCM
+  if (AutotunePersistentCacheDir().empty()) {
+    return;
+  }
+  if (save_pending.exchange(true)) {
+    return;
+  }
+  Env::Default()->SchedClosureAfter(kSaveDelayMicros, []() {
+    // Allow new requests to schedule another save for entries inserted while
+    // this one is serializing.
+    save_pending.store(false);
+    Status status = SavePersistentAutotuneMaps();
+    if (!status.ok()) {
+      LOG(WARNING) << "Failed to persist autotune results: " << status;
+    }
+  });
+#endif  // GOOGLE_CUDA || TENSORFLOW_USE_ROCM
+}
+
 }  // namespace tensorflow
@@ -43,6 +43,24 @@ Status SerializeAutotuneMaps(std::string* output);
 // Resets all autotune maps. For test use only.
 void ResetAutotuneMaps();
 
+// On-disk persistence for the autotune maps, gated by the
+// TF_AUTOTUNE_PERSISTENT_CACHE_DIR environment variable. The cache file name
+// is keyed by the visible GPU models, the DNN library version and the
+// ConvParameters version, so results persisted on a different machine or
+// under a different library version are never picked up; per-entry device and
+// version checks in LoadSerializedAutotuneMaps guard the remaining cases.
+
+// Loads previously persisted autotune results into the runtime autotune maps.
+// A missing cache file and a disabled cache are not errors. Safe to call
+// concurrently and repeatedly; only the first call does any work.
+Status LoadPersistentAutotuneMaps();
+
+// Schedules an asynchronous write of the current autotune maps to the
+// persistent cache. Bursts of requests (e.g. during warmup, when many
+// convolutions are autotuned back to back) are coalesced into a single
+// delayed write. No-op when persistence is disabled.
+void RequestPersistentAutotuneMapsSave();
+
 }  // namespace tensorflow
 
 #endif  // TENSORFLOW_CORE_UTIL_AUTOTUNE_MAPS_AUTOTUNE_SERIALIZE_H_
@@ -36,6 +36,7 @@ limitations under the License.
 #include "tensorflow/core/platform/blocking_counter.h"
 #include "tensorflow/core/platform/byte_order.h"
 #include "tensorflow/core/platform/logging.h"
+#include "tensorflow/core/platform/macros.h"
 #include "tensorflow/core/platform/protobuf.h"
 #include "tensorflow/core/util/presized_cuckoo_map.h"
 #include "tensorflow/core/util/sparse/sparse_tensor.h"
@@ -117,6 +118,27 @@ constexpr uint8 kVarintTag(uint32 tag) { return (tag << 3) | 0; }
 constexpr uint8 kDelimitedTag(uint32 tag) { return (tag << 3) | 2; }
 constexpr uint8 kFixed32Tag(uint32 tag) { return (tag << 3) | 5; }
 
+// Decodes a base-128 varint from [p, limit). Returns the position right after
+// the varint, or nullptr if the input is truncated or malformed. Compared to
+// CodedInputStream::ReadVarint64 this avoids the per-call stream bookkeeping,
+// which dominates when decoding long packed int64 lists.
+inline const uint8* DecodeVarint64Fast(const uint8* p, const uint8* limit,
+                                       protobuf_uint64* value) {
+  if (TF_PREDICT_TRUE(p < limit && *p < 0x80)) {  // Single-byte fast path.
+    *value = *p;
+    return p + 1;
+  }
+  protobuf_uint64 result = 0;
+  for (int shift = 0; shift <= 63 && p < limit; shift += 7) {
+    result |= static_cast<protobuf_uint64>(*p & 0x7f) << shift;
+    if (!(*p++ & 0x80)) {
+      *value = result;
+      return p;
+    }
+  }
+  return nullptr;
+}
+
 namespace parsed {
 
 // ParseDataType has to be called first, then appropriate ParseZzzzList.
@@ -305,10 +327,29 @@ class Feature {
         if (!stream.ReadVarint32(&packed_length)) return false;
         auto packed_limit = stream.PushLimit(packed_length);
 
-        while (!stream.ExpectAtEnd()) {
-          protobuf_uint64 n;  // There is no API for int64
-          if (!stream.ReadVarint64(&n)) return false;
-          int64_list->push_back(static_cast<int64_t>(n));
+        // When the packed payload is fully available in the current buffer
+        // (always the case here, since the stream is backed by `serialized_`),
+        // decode the varints directly instead of paying the CodedInputStream
+        // bookkeeping per element.
+        const void* buffer;
+        int buffer_size;
+        if (stream.GetDirectBufferPointer(&buffer, &buffer_size) &&
+            buffer_size >= static_cast<int>(packed_length)) {
+          const uint8* p = static_cast<const uint8*>(buffer);
+          const uint8* end = p + packed_length;
+          while (p < end) {
+            protobuf_uint64 n;  // There is no API for int64
+            p = DecodeVarint64Fast(p, end, &n);
+            if (p == nullptr) return false;
+            int64_list->push_back(static_cast<int64_t>(n));
+          }
+          if (!stream.Skip(packed_length)) return false;
+        } else {
+          while (!stream.ExpectAtEnd()) {
+            protobuf_uint64 n;  // There is no API for int64
+            if (!stream.ReadVarint64(&n)) return false;
+            int64_list->push_back(static_cast<int64_t>(n));
+          }
         }
 
         stream.PopLimit(packed_limit);
@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "tensorflow/core/util/example_proto_fast_parsing.h"
 
+#include <limits>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -172,6 +173,21 @@ TEST(FastParse, Packed) {
       "\x0a\x0d\x0a\x0b\x0a\x03\x61\x67\x65\x12\x04\x1a\x02\x08\x0d");
 }
 
+TEST(FastParse, PackedInt64MultiByteVarints) {
+  // Exercises the direct-buffer varint decoder on every varint width,
+  // including negative values, which encode as ten bytes.
+  Example example;
+  auto* int64_list = (*example.mutable_features()->mutable_feature())["values"]
+                         .mutable_int64_list();
+  for (int shift = 0; shift < 63; shift += 7) {
+    int64_list->add_value(int64_t{1} << shift);
+  }
+  int64_list->add_value(-1);
+  int64_list->add_value(std::numeric_limits<int64_t>::min());
+  int64_list->add_value(std::numeric_limits<int64_t>::max());
+  TestCorrectness(Serialize(example));
+}
+
 TEST(FastParse, ValueBeforeKeyInMap) {
   TestCorrectness("\x0a\x12\x0a\x10\x12\x09\x0a\x07\x0a\x05value\x0a\x03key");
 }
@@ -15,6 +15,8 @@ limitations under the License.
 
 #include "tensorflow/core/util/sparse/sparse_tensor.h"
 
+#include <atomic>
+
 #include "tensorflow/core/lib/strings/strcat.h"
 
 namespace tensorflow {
@@ -308,5 +310,69 @@ Status SparseTensor::IndicesValid() const {
   }
 }
 
+Status SparseTensor::IndicesValid(thread::ThreadPool* pool) const {
+  if (pool == nullptr || pool->NumThreads() <= 1 ||
+      num_entries() < kMinEntriesForParallelism) {
+    return IndicesValid();
+  }
+
+  bool standard_order = true;
+  for (size_t i = 0; i < order_.size(); ++i) {
+    if (order_[i] < 0) {
+      return errors::FailedPrecondition(
+          "Order was not provided.  Provide an order at "
+          "construction time or run ReorderInPlace");
+    }
+    standard_order = standard_order && order_[i] == i;
+  }
+  if (!standard_order) {
+    return IndicesValid();
+  }
+
+  const auto ix_t = ix_.matrix<int64_t>();
+  const int64_t* const shape_ptr = shape_.data();
+  const int64_t n = num_entries();
+  std::atomic<bool> valid(true);
+  // Each shard checks bounds for its own rows and the ordering constraint
+  // against each row's predecessor, so the constraint spanning two shards is
+  // checked by the later shard.
+  pool->ParallelFor(
+      n, /*cost_per_unit=*/3 * dims_, [&](int64_t begin, int64_t end) {
+        if (!valid.load(std::memory_order_relaxed)) return;
+        for (int64_t i = begin; i < end; ++i) {
+          bool row_valid = true;
+          bool different = false;
+          bool increasing = true;
+          if (i == 0) {
+            for (int di = 0; di < dims_; ++di) {
+              if (ix_t(i, di) < 0 || ix_t(i, di) >= shape_ptr[di]) {
+                row_valid = false;
+              }
+            }
+            different = true;
+          } else {
+            for (int di = 0; di < dims_; ++di) {
+              if (ix_t(i, di) < 0 || ix_t(i, di) >= shape_ptr[di]) {
+                row_valid = false;
+              }
+              const int64_t diff = ix_t(i, di) - ix_t(i - 1, di);
+              if (diff > 0) different = true;
+              if (!different && diff < 0) increasing = false;
+            }
+          }
+          if (TF_PREDICT_FALSE(!row_valid || !increasing || !different)) {
+            valid.store(false, std::memory_order_relaxed);
+            return;
+          }
+        }
+      });
+  if (valid.load(std::memory_order_relaxed)) {
+    return OkStatus();
+  }
+  // Rare failure path: rerun the single-threaded validation to produce the
+  // usual detailed error message.
+  return IndicesValidHelper<true>();
+}
+
 }  // namespace sparse
 }  // namespace tensorflow
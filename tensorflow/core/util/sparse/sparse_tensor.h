@@ -16,6 +16,7 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_UTIL_SPARSE_SPARSE_TENSOR_H_
 #define TENSORFLOW_CORE_UTIL_SPARSE_SPARSE_TENSOR_H_
 
+#include <algorithm>
 #include <limits>
 #include <numeric>
 #include <vector>
@@ -29,6 +30,7 @@ limitations under the License.
 #include "tensorflow/core/framework/types.pb.h"
 #include "tensorflow/core/lib/core/errors.h"
 #include "tensorflow/core/lib/core/status.h"
+#include "tensorflow/core/lib/core/threadpool.h"
 #include "tensorflow/core/lib/strings/str_util.h"
 #include "tensorflow/core/platform/errors.h"
 #include "tensorflow/core/platform/logging.h"
@@ -115,6 +117,12 @@ class SparseTensor {
 
   Status IndicesValid() const;
 
+  // Multithreaded variant of `IndicesValid` that shards the bounds and
+  // ordering checks over `pool`. Falls back to the single-threaded
+  // implementation when `pool` is null, the tensor is small, or the order is
+  // not the standard (row-major) order.
+  Status IndicesValid(thread::ThreadPool* pool) const;
+
   VarDimArray shape() const { return shape_; }
 
   VarDimArray order() const { return order_; }
@@ -123,6 +131,15 @@ class SparseTensor {
   template <typename T>
   void Reorder(const VarDimArray& order);
 
+  // Multithreaded variant of `Reorder` that partitions the entries into
+  // contiguous ranges of the leading sort dimension and sorts the ranges
+  // independently on `pool`. Unlike the in-place single-threaded variant,
+  // this uses O(N) scratch space for the permuted result. Falls back to the
+  // single-threaded implementation when `pool` is null or the tensor is
+  // small.
+  template <typename T>
+  void Reorder(const VarDimArray& order, thread::ThreadPool* pool);
+
   // Returns a group iterable that can be used for clumping indices
   // and values according to the group indices of interest.
   //
@@ -214,6 +231,10 @@ class SparseTensor {
   template <bool standard_order>
   Status IndicesValidHelper() const;
 
+  // Minimum number of entries before the threaded variants of IndicesValid
+  // and Reorder switch away from the single-threaded implementations.
+  static constexpr int64_t kMinEntriesForParallelism = 1 << 15;
+
   // Helper for ToDense<T>()
   template <typename T>
   bool ValidateAndInitializeToDense(Tensor* out, bool initialize);
@@ -328,6 +349,98 @@ inline void SparseTensor::Reorder(const VarDimArray& order) {
   order_ = ShapeArray(order.begin(), order.end());
 }
 
+template <typename T>
+inline void SparseTensor::Reorder(const VarDimArray& order,
+                                  thread::ThreadPool* pool) {
+  DCHECK_EQ(DataTypeToEnum<T>::v(), dtype())
+      << "Reorder requested with the wrong datatype";
+  DCHECK_EQ(order.size(), dims_) << "Order length must be SparseTensor rank";
+  const int64_t n = num_entries();
+  if (pool == nullptr || pool->NumThreads() <= 1 ||
+      n < kMinEntriesForParallelism || order.empty() ||
+      shape_[order[0]] <= 0) {
+    Reorder<T>(order);
+    return;
+  }
+  auto ix_t = ix_.matrix<int64_t>();
+  auto vals_t = vals_.vec<T>();
+
+  // Partition the entries into contiguous ranges ("buckets") of the leading
+  // sort dimension. The mapping is monotonic in the leading index (with
+  // out-of-range indices clamped into the first and last bucket), so the
+  // buckets partition the sorted output and can be sorted independently.
+  const int64_t leading_dim = order[0];
+  const int64_t dim_size = shape_[leading_dim];
+  const int64_t num_buckets =
+      std::min<int64_t>(dim_size, 4 * pool->NumThreads());
+  auto bucket_of = [&](int64_t i) {
+    const int64_t leading =
+        std::min(std::max<int64_t>(ix_t(i, leading_dim), 0), dim_size - 1);
+    return leading * num_buckets / dim_size;
+  };
+
+  std::vector<int64_t> bucket_starts(num_buckets + 1, 0);
+  for (int64_t i = 0; i < n; ++i) ++bucket_starts[bucket_of(i) + 1];
+  for (int64_t b = 0; b < num_buckets; ++b) {
+    bucket_starts[b + 1] += bucket_starts[b];
+  }
+
+  // Stable scatter of the entry ids into their buckets.
+  std::vector<int64_t> reorder(n);
+  {
+    std::vector<int64_t> fill(bucket_starts.begin(), bucket_starts.end() - 1);
+    for (int64_t i = 0; i < n; ++i) reorder[fill[bucket_of(i)]++] = i;
+  }
+
+  // Sort each bucket with the full comparator; entries in different buckets
+  // already compare correctly on the leading dimension.
+  auto sort_buckets = [&](int64_t begin, int64_t end) {
+    for (int64_t b = begin; b < end; ++b) {
+      auto* bucket_begin = reorder.data() + bucket_starts[b];
+      auto* bucket_end = reorder.data() + bucket_starts[b + 1];
+      switch (order.size()) {
+#define CASE_SORT(ORDER_SIZE)                                    \
+  case ORDER_SIZE: {                                             \
+    FixedDimComparator<ORDER_SIZE> sorter(ix_t, order, shape()); \
+    std::sort(bucket_begin, bucket_end, sorter);                 \
+    break;                                                       \
+  }
+        CASE_SORT(0);
+        CASE_SORT(1);
+        CASE_SORT(2);
+        CASE_SORT(3);
+        CASE_SORT(4);
+        CASE_SORT(5);
+#undef CASE_SORT
+        default: {
+          DimComparator sorter(ix_t, order, shape());
+          std::sort(bucket_begin, bucket_end, sorter);
+        }
+      }
+    }
+  };
+  const int64_t sort_cost_per_bucket = (n / num_buckets + 1) * dims_ * 30;
+  pool->ParallelFor(num_buckets, sort_cost_per_bucket, sort_buckets);
+
+  // Gather indices and values into their sorted positions.
+  Tensor sorted_ix(DT_INT64, TensorShape({n, dims_}));
+  Tensor sorted_vals(vals_.dtype(), TensorShape({n}));
+  auto sorted_ix_t = sorted_ix.matrix<int64_t>();
+  auto sorted_vals_t = sorted_vals.vec<T>();
+  pool->ParallelFor(n, 10 * dims_,
+                    [&](int64_t begin, int64_t end) {
+                      for (int64_t i = begin; i < end; ++i) {
+                        const int64_t j = reorder[i];
+                        std::copy_n(&ix_t(j, 0), dims_, &sorted_ix_t(i, 0));
+                        sorted_vals_t(i) = vals_t(j);
+                      }
+                    });
+
+  ix_ = std::move(sorted_ix);
+  vals_ = std::move(sorted_vals);
+  order_ = ShapeArray(order.begin(), order.end());
+}
+
 template <typename T>
 inline bool SparseTensor::ValidateAndInitializeToDense(Tensor* out,
                                                        bool initialize) {
@@ -24,6 +24,7 @@ limitations under the License.
 #include "tensorflow/core/lib/core/status_test_util.h"
 #include "tensorflow/core/lib/random/simple_philox.h"
 #include "tensorflow/core/lib/strings/str_util.h"
+#include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/statusor.h"
 #include "tensorflow/core/platform/test.h"
 #include "tensorflow/core/platform/test_benchmark.h"
@@ -730,6 +731,74 @@ TEST(SparseTensorTest, SliceReducesOutputDimension) {
   EXPECT_EQ(TensorShape(slice.shape()), TensorShape({0, 1}));
 }
 
+TEST(SparseTensorTest, ParallelReorderMatchesSerial) {
+  const int N = 50000;  // Above the threshold for the threaded code paths.
+  const int NDIM = 3;
+
+  Tensor ix1(DT_INT64, TensorShape({N, NDIM}));
+  Tensor vals1(DT_INT32, TensorShape({N}));
+  auto ix1_t = ix1.matrix<int64_t>();
+  ix1_t = ix1_t.random(Eigen::internal::UniformRandomGenerator<int64_t>(17));
+  ix1_t = ix1_t.abs() % (1 << 20);
+  auto vals1_t = vals1.vec<int32>();
+  for (int i = 0; i < N; ++i) vals1_t(i) = i;
+
+  Tensor ix2(DT_INT64, TensorShape({N, NDIM}));
+  Tensor vals2(DT_INT32, TensorShape({N}));
+  ix2.matrix<int64_t>() = ix1_t;
+  vals2.vec<int32>() = vals1_t;
+
+  TensorShape shape({1 << 20, 1 << 20, 1 << 20});
+  SparseTensor st_serial;
+  TF_ASSERT_OK(SparseTensor::Create(ix1, vals1, shape, &st_serial));
+  SparseTensor st_parallel;
+  TF_ASSERT_OK(SparseTensor::Create(ix2, vals2, shape, &st_parallel));
+
+  thread::ThreadPool pool(Env::Default(), "sparse_reorder_test", 4);
+  st_serial.Reorder<int32>({0, 1, 2});
+  st_parallel.Reorder<int32>({0, 1, 2}, &pool);
+  TF_EXPECT_OK(st_parallel.IndicesValid(&pool));
+
+  auto serial_ix = st_serial.indices().matrix<int64_t>();
+  auto parallel_ix = st_parallel.indices().matrix<int64_t>();
+  auto serial_vals = st_serial.values().vec<int32>();
+  auto parallel_vals = st_parallel.values().vec<int32>();
+  for (int i = 0; i < N; ++i) {
+    ASSERT_EQ(serial_vals(i), parallel_vals(i)) << "at entry " << i;
+    for (int d = 0; d < NDIM; ++d) {
+      ASSERT_EQ(serial_ix(i, d), parallel_ix(i, d)) << "at entry " << i;
+    }
+  }
+}
+
+TEST(SparseTensorTest, ParallelIndicesValidFindsInvalid) {
+  const int N = 50000;  // Above the threshold for the threaded code paths.
+  const int NDIM = 2;
+
+  Tensor ix(DT_INT64, TensorShape({N, NDIM}));
+  Tensor vals(DT_INT32, TensorShape({N}));
+  auto ix_t = ix.matrix<int64_t>();
+  for (int i = 0; i < N; ++i) {
+    ix_t(i, 0) = i;
+    ix_t(i, 1) = 5;
+  }
+
+  TensorShape shape({N, 10});
+  std::vector<int64_t> order{0, 1};
+  SparseTensor st;
+  TF_ASSERT_OK(SparseTensor::Create(ix, vals, shape, order, &st));
+
+  thread::ThreadPool pool(Env::Default(), "sparse_valid_test", 4);
+  TF_EXPECT_OK(st.IndicesValid(&pool));
+
+  // Corrupt an entry in the middle; the parallel path should find it and
+  // report the same error as the single-threaded validation.
+  ix_t(N / 2, 1) = 100;
+  Status st_indices_valid = st.IndicesValid(&pool);
+  EXPECT_FALSE(st_indices_valid.ok());
+  EXPECT_EQ(st_indices_valid.message(), st.IndicesValid().message());
+}
+
 TEST(SparseTensorTest, Dim0SparseTensorToDenseTensor) {
   Tensor ix(DT_INT64, TensorShape({1, 0}));
   Tensor vals(DT_INT32, TensorShape({1}));
@@ -15,10 +15,12 @@ limitations under the License.
 
 #include "tensorflow/core/util/tensor_bundle/tensor_bundle.h"
 
+#include <algorithm>
 #include <cstdlib>
 #include <cstring>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "tensorflow/core/framework/register_types.h"
 #include "tensorflow/core/framework/tensor.pb.h"
@@ -43,6 +45,7 @@ limitations under the License.
 #include "tensorflow/core/platform/mem.h"
 #include "tensorflow/core/platform/path.h"
 #include "tensorflow/core/platform/random.h"
+#include "tensorflow/core/platform/snappy.h"
 #include "tensorflow/core/platform/status.h"
 #include "tensorflow/core/platform/stringprintf.h"
 #include "tensorflow/core/platform/tstring.h"
@@ -63,7 +66,8 @@ namespace tensorflow {
 // Versioning of the tensor bundle format.
 const int kTensorBundleMinProducer = 0;
 const int kTensorBundleMinConsumer = 0;
-const int kTensorBundleVersion = 1;
+const int kTensorBundleVersion = 2;
+const int kTensorBundleVersionWithCompression = 2;
 
 // Size of our input buffer for streaming reads
 static const int kBufferSize = 1024 * 1024;
@@ -80,6 +84,15 @@ const int kMaxFileReadThreads = 8;
 // Minimum size of a file section handled by each thread.
 const int64_t kMinSectionSize = static_cast<int64_t>(1) << 31;
 
+// Number of tensor bytes covered by one compression block.  Divisible by
+// every fixed dtype size, so byte-stream-split never straddles an element.
+const int64_t kCompressionBlockBytes = 1 << 20;
+// Maximum number of threads compressing blocks of a single tensor.
+const int kMaxCompressionThreads = 8;
+// Tensors smaller than this are always stored uncompressed, regardless of the
+// writer's codec option; the framing and codec overhead is not worthwhile.
+const int64_t kMinCompressionSize = 16 << 10;
+
 namespace {
 
 // Reads "num_elements" string elements from file[offset, offset+size) into the
@@ -362,6 +375,185 @@ Status WriteVariantTensor(const Tensor& val, tsl::BufferedWritableFile* out,
   return OkStatus();
 }
 
+// Scatters the bytes of "input" so that the i-th byte of every
+// "elem_size"-sized element is contiguous in "output".
+// REQUIRES: size % elem_size == 0
+void ByteStreamSplit(const char* input, size_t size, size_t elem_size,
+                     char* output) {
+  const size_t num_elements = size / elem_size;
+  for (size_t lane = 0; lane < elem_size; ++lane) {
+    char* out = output + lane * num_elements;
+    for (size_t i = 0; i < num_elements; ++i) {
+      out[i] = input[i * elem_size + lane];
+    }
+  }
+}
+
+// Inverse of ByteStreamSplit().
+void ByteStreamMerge(const char* input, size_t size, size_t elem_size,
+                     char* output) {
+  const size_t num_elements = size / elem_size;
+  for (size_t lane = 0; lane < elem_size; ++lane) {
+    const char* in = input + lane * num_elements;
+    for (size_t i = 0; i < num_elements; ++i) {
+      output[i * elem_size + lane] = in[i];
+    }
+  }
+}
+
+// Returns the element size to use for byte-stream-split, or 1 (making the
+// split a no-op) when the dtype's size is unknown or does not evenly divide
+// the tensor bytes and the compression blocks.
+size_t ByteStreamSplitElemSize(DataType dtype, size_t size) {
+  const size_t elem_size = DataTypeSize(dtype);
+  if (elem_size == 0 || size % elem_size != 0 ||
+      kCompressionBlockBytes % elem_size != 0) {
+    return 1;
+  }
+  return elem_size;
+}
+
+// Serializes the data bytes of the non-string tensor "val" with "codec".
+// "bytes_written" is treated in the same fashion as WriteTensor().
+//
+// On-disk format:
+//   [varint64 uncompressed_size][varint64 num_blocks]
+//   [varint64 compressed_len][compressed block bytes]   (num_blocks times)
+// Each block covers kCompressionBlockBytes input bytes, except possibly the
+// last.  Blocks are independent and are compressed in parallel.
+// REQUIRES: DataTypeCanUseMemcpy(val.dtype()) && codec != NONE
+Status WriteCompressedTensor(const Tensor& val, BundleEntryProto::Codec codec,
+                             tsl::BufferedWritableFile* out,
+                             size_t* bytes_written) {
+  DCHECK(DataTypeCanUseMemcpy(val.dtype()));
+  DCHECK_NE(codec, BundleEntryProto::NONE);
+  const char* buf = GetBackingBuffer(val);
+  const int64_t total_size = val.TotalBytes();
+  const int64_t num_blocks =
+      (total_size + kCompressionBlockBytes - 1) / kCompressionBlockBytes;
+  const size_t elem_size =
+      codec == BundleEntryProto::BYTE_STREAM_SPLIT_SNAPPY
+          ? ByteStreamSplitElemSize(val.dtype(), total_size)
+          : 1;
+
+  std::vector<string> compressed_blocks(num_blocks);
+  std::vector<char> block_ok(num_blocks, 0);
+  {
+    const int num_threads =
+        static_cast<int>(std::min<int64_t>(num_blocks, kMaxCompressionThreads));
+    thread::ThreadPool pool(Env::Default(), "bundle_compress", num_threads);
+    for (int64_t b = 0; b < num_blocks; ++b) {
+      pool.Schedule([&, b]() {
+        const int64_t offset = b * kCompressionBlockBytes;
+        const int64_t block_size =
+            std::min(kCompressionBlockBytes, total_size - offset);
+        const char* src = buf + offset;
+        string split;
+        if (elem_size > 1) {
+          split.resize(block_size);
+          ByteStreamSplit(src, block_size, elem_size, &split[0]);
+          src = split.data();
+        }
+        block_ok[b] =
+            port::Snappy_Compress(src, block_size, &compressed_blocks[b]);
+      });
+    }
+  }  // Joins the compression workers.
+  for (int64_t b = 0; b < num_blocks; ++b) {
+    if (!block_ok[b]) {
+      return errors::Internal("Snappy compression failed for tensor block ", b);
+    }
+  }
+
+  string framing;
+  core::PutVarint64(&framing, total_size);
+  core::PutVarint64(&framing, num_blocks);
+  TF_RETURN_IF_ERROR(out->Append(framing));
+  *bytes_written = framing.size();
+  for (const string& block : compressed_blocks) {
+    string len;
+    core::PutVarint64(&len, block.size());
+    TF_RETURN_IF_ERROR(out->Append(len));
+    TF_RETURN_IF_ERROR(out->Append(block));
+    *bytes_written += len.size() + block.size();
+  }
+  return OkStatus();
+}
+
+// Reads a tensor written by WriteCompressedTensor() from
+// file[entry.offset(), entry.offset() + entry.size()) into "destination",
+// which holds "expected_size" bytes.
+//
+// Checksums the stored (compressed) bytes and stores it into "actual_crc32c".
+Status ReadCompressedTensor(io::InputBuffer* buffered_file,
+                            const BundleEntryProto& entry,
+                            size_t expected_size, char* destination,
+                            uint32* actual_crc32c) {
+  string compressed;
+  compressed.resize(entry.size());
+  TF_RETURN_IF_ERROR(buffered_file->Seek(entry.offset()));
+  size_t bytes_read = 0;
+  TF_RETURN_IF_ERROR(
+      buffered_file->ReadNBytes(entry.size(), &compressed[0], &bytes_read));
+  *actual_crc32c = crc32c::Value(compressed.data(), compressed.size());
+
+  const char* p = compressed.data();
+  const char* limit = p + compressed.size();
+  uint64 uncompressed_size = 0;
+  uint64 num_blocks = 0;
+  p = core::GetVarint64Ptr(p, limit, &uncompressed_size);
+  if (p == nullptr) {
+    return errors::DataLoss("Truncated compressed tensor framing");
+  }
+  p = core::GetVarint64Ptr(p, limit, &num_blocks);
+  if (p == nullptr) {
+    return errors::DataLoss("Truncated compressed tensor framing");
+  }
+  if (uncompressed_size != expected_size) {
+    return errors::DataLoss("Invalid uncompressed size in bundle entry: ",
+                            "stored ", uncompressed_size, "; expected ",
+                            expected_size);
+  }
+  const size_t elem_size =
+      entry.codec() == BundleEntryProto::BYTE_STREAM_SPLIT_SNAPPY
+          ? ByteStreamSplitElemSize(entry.dtype(), expected_size)
+          : 1;
+
+  size_t offset = 0;
+  string scratch;
+  for (uint64 b = 0; b < num_blocks; ++b) {
+    uint64 compressed_len = 0;
+    p = core::GetVarint64Ptr(p, limit, &compressed_len);
+    if (p == nullptr || compressed_len > static_cast<uint64>(limit - p)) {
+      return errors::DataLoss("Truncated compressed tensor block ", b);
+    }
+    size_t block_size = 0;
+    if (!port::Snappy_GetUncompressedLength(p, compressed_len, &block_size) ||
+        offset + block_size > expected_size) {
+      return errors::DataLoss("Invalid compressed tensor block ", b);
+    }
+    if (elem_size > 1) {
+      scratch.resize(block_size);
+      if (!port::Snappy_Uncompress(p, compressed_len, &scratch[0])) {
+        return errors::DataLoss("Snappy decompression failed for block ", b);
+      }
+      ByteStreamMerge(scratch.data(), block_size, elem_size,
+                      destination + offset);
+    } else {
+      if (!port::Snappy_Uncompress(p, compressed_len, destination + offset)) {
+        return errors::DataLoss("Snappy decompression failed for block ", b);
+      }
+    }
+    p += compressed_len;
+    offset += block_size;
+  }
+  if (offset != expected_size) {
+    return errors::DataLoss("Compressed tensor blocks cover ", offset,
+                            " bytes; expected ", expected_size);
+  }
+  return OkStatus();
+}
+
 // Returns whether "slice_spec" is a full slice, with respect to the full shape.
 //
 // This can happen say, when "slice_spec" is
@@ -475,7 +667,15 @@ Status BundleWriter::Add(StringPiece key, const Tensor& val) {
   } else if (val.dtype() == DT_VARIANT) {
     status_ = WriteVariantTensor(val, out_.get(), &data_bytes_written, &crc32c);
   } else {
-    status_ = WriteTensor(val, out_.get(), &data_bytes_written);
+    if (options_.codec != BundleEntryProto::NONE &&
+        val.TotalBytes() >= kMinCompressionSize) {
+      entry->set_codec(options_.codec);
+      seen_codec_ = true;
+      status_ = WriteCompressedTensor(val, options_.codec, out_.get(),
+                                      &data_bytes_written);
+    } else {
+      status_ = WriteTensor(val, out_.get(), &data_bytes_written);
+    }
     crc32c = out_->crc32();
   }
 
@@ -562,7 +762,10 @@ Status BundleWriter::Finish() {
     if (!port::kLittleEndian) header.set_endianness(BundleHeaderProto::BIG);
     VersionDef* version = header.mutable_version();
     version->set_producer(kTensorBundleVersion);
-    version->set_min_consumer(kTensorBundleMinConsumer);
+    // Consumers predating codec support would misinterpret compressed tensor
+    // bytes; require a new enough consumer iff a codec was actually used.
+    version->set_min_consumer(seen_codec_ ? kTensorBundleVersionWithCompression
+                                          : kTensorBundleMinConsumer);
 
     builder.Add(kHeaderEntryKey, header.SerializeAsString());
 
@@ -876,8 +1079,10 @@ Status BundleReader::GetValue(const BundleEntryProto& entry, Tensor* val) {
     ret = new Tensor(entry.dtype(), stored_shape);
   }
 
-  // Validates the "size" field.
-  if (entry.dtype() != DT_STRING && entry.dtype() != DT_VARIANT) {
+  // Validates the "size" field.  For compressed entries, "size" is the number
+  // of bytes as stored; the uncompressed size is validated during decoding.
+  if (entry.dtype() != DT_STRING && entry.dtype() != DT_VARIANT &&
+      entry.codec() == BundleEntryProto::NONE) {
     if (entry.size() != ret->TotalBytes()) {
       return errors::DataLoss("Invalid size in bundle entry: key ", key(),
                               "; stored size ", entry.size(),
@@ -916,7 +1121,18 @@ Status BundleReader::GetValue(const BundleEntryProto& entry, Tensor* val) {
   if (DataTypeCanUseMemcpy(entry.dtype())) {
     char* backing_buffer = const_cast<char*>((ret->tensor_data().data()));
     size_t unused_bytes_read;
-    if (entry.size() > kBufferSize) {
+    if (entry.codec() != BundleEntryProto::NONE) {
+      if (entry.codec() != BundleEntryProto::SNAPPY &&
+          entry.codec() != BundleEntryProto::BYTE_STREAM_SPLIT_SNAPPY) {
+        return errors::Unimplemented(
+            "TensorBundle at ", prefix_, " uses unsupported codec ",
+            entry.codec(), ". Please upgrade TensorFlow to read this ",
+            "checkpoint.");
+      }
+      TF_RETURN_IF_ERROR(ReadCompressedTensor(
+          buffered_file, entry, ret->TotalBytes(), backing_buffer,
+          &actual_crc32c));
+    } else if (entry.size() > kBufferSize) {
       StringPiece sp;
       if (!enable_multi_threading_for_testing_ &&
           entry.size() < kLargeTensorThreshold) {
@@ -974,7 +1190,10 @@ Status BundleReader::GetValue(const BundleEntryProto& entry, Tensor* val) {
     }
     // Note that we compute the checksum *before* byte-swapping. The checksum
     // should be on the bytes in the order they appear in the file.
-    actual_crc32c = crc32c::Value(backing_buffer, entry.size());
+    // ReadCompressedTensor() already checksummed the stored bytes.
+    if (entry.codec() == BundleEntryProto::NONE) {
+      actual_crc32c = crc32c::Value(backing_buffer, entry.size());
+    }
     if (need_to_swap_bytes_) {
       TF_RETURN_IF_ERROR(ByteSwapTensor(ret));
     }
@@ -1062,6 +1281,82 @@ Status BundleReader::LookupSlice(StringPiece full_tensor_key,
   return GetSliceValue(full_tensor_key, entry, slice_spec, val);
 }
 
+Status BundleReader::LookupRowRange(StringPiece full_tensor_key,
+                                    int64_t row_start, int64_t num_rows,
+                                    Tensor* val) {
+  CHECK(val != nullptr);
+  BundleEntryProto entry;
+  TF_RETURN_IF_ERROR(GetBundleEntryProto(full_tensor_key, &entry));
+
+  const TensorShape stored_shape(entry.shape());
+  if (stored_shape.dims() < 1) {
+    return errors::InvalidArgument(
+        "LookupRowRange requires a tensor with at least one dimension; key ",
+        full_tensor_key, " has shape ", stored_shape.DebugString());
+  }
+  const int64_t num_stored_rows = stored_shape.dim_size(0);
+  if (row_start < 0 || num_rows < 0 ||
+      row_start + num_rows > num_stored_rows) {
+    return errors::InvalidArgument(
+        "Row range [", row_start, ", ", row_start + num_rows,
+        ") is out of bounds for key ", full_tensor_key, " with ",
+        num_stored_rows, " rows");
+  }
+  TensorShape expected_shape = stored_shape;
+  expected_shape.set_dim(0, num_rows);
+  if (entry.dtype() != val->dtype() || expected_shape != val->shape()) {
+    return errors::InvalidArgument(
+        "Expected tensor of type ", DataTypeString(entry.dtype()),
+        " and shape ", expected_shape.DebugString(), "; got ",
+        DataTypeString(val->dtype()), " and ", val->shape().DebugString());
+  }
+  if (num_rows == 0) return OkStatus();
+
+  // Partitioned, compressed, and non-POD tensors do not store the requested
+  // rows as one contiguous byte range; service them through the regular
+  // slice path.
+  if (!entry.slices().empty() || entry.codec() != BundleEntryProto::NONE ||
+      !DataTypeCanUseMemcpy(entry.dtype())) {
+    TensorSlice slice_spec(stored_shape.dims());
+    slice_spec.set_start(0, row_start);
+    slice_spec.set_length(0, num_rows);
+    return GetSliceValue(full_tensor_key, entry, slice_spec, val);
+  }
+
+  const int64_t bytes_per_row = val->TotalBytes() / num_rows;
+  if (entry.size() != bytes_per_row * num_stored_rows) {
+    return errors::DataLoss("Invalid size in bundle entry: key ",
+                            full_tensor_key, "; stored size ", entry.size(),
+                            "; expected size ",
+                            bytes_per_row * num_stored_rows);
+  }
+
+  // Open the data file if it has not been opened.
+  io::InputBuffer* buffered_file = data_[entry.shard_id()];
+  if (buffered_file == nullptr) {
+    std::unique_ptr<RandomAccessFile> file = nullptr;
+    TF_RETURN_IF_ERROR(env_->NewRandomAccessFile(
+        DataFilename(prefix_, entry.shard_id(), num_shards_), &file));
+    buffered_file = new io::InputBuffer(file.release(), kBufferSize);
+    // The InputBuffer and RandomAccessFile objects are both released in dtor.
+    data_[entry.shard_id()] = buffered_file;
+  }
+
+  char* backing_buffer = const_cast<char*>(val->tensor_data().data());
+  StringPiece sp;
+  TF_RETURN_IF_ERROR(
+      buffered_file->file()->Read(entry.offset() + row_start * bytes_per_row,
+                                  num_rows * bytes_per_row, &sp,
+                                  backing_buffer));
+  if (sp.data() != backing_buffer) {
+    memmove(backing_buffer, sp.data(), sp.size());
+  }
+  if (need_to_swap_bytes_) {
+    TF_RETURN_IF_ERROR(ByteSwapTensor(val));
+  }
+  return OkStatus();
+}
+
 Status BundleReader::GetSliceValue(StringPiece full_tensor_key,
                                    const BundleEntryProto& full_tensor_entry,
                                    const TensorSlice& slice_spec, Tensor* val) {
@@ -98,9 +98,13 @@ namespace tensorflow {
 // History:
 // 0. Any tensor bundles produced before this field was added.
 // 1. Added this field (2016-09-14).
+// 2. Added per-tensor compression codecs (2024-02-20).  Bundles that use a
+//    codec set min_consumer to this version; codec-free bundles remain
+//    readable by older consumers.
 extern const int kTensorBundleMinProducer;
 extern const int kTensorBundleMinConsumer;
 extern const int kTensorBundleVersion;
+extern const int kTensorBundleVersionWithCompression;
 
 // The empty string, hence always the first key in the metadata table.  Its
 // corresponding value is a BundleHeaderProto.
@@ -119,6 +123,12 @@ class BundleWriter {
     // Alignment, in bytes, for tensor data.
     // Must be >= 1. The default size of 1 densely packs tensors.
     int data_alignment{1};
+    // Compression codec applied to tensors whose dtype can use memcpy and
+    // whose size makes compression worthwhile.  String and variant tensors
+    // are always written uncompressed.  Bundles written with a codec other
+    // than NONE cannot be read by consumers that predate bundle format
+    // version 2.
+    BundleEntryProto::Codec codec{BundleEntryProto::NONE};
   };
   BundleWriter(Env* env, absl::string_view prefix,
                const Options& options = Options());
@@ -163,6 +173,9 @@ class BundleWriter {
   int64_t size_;  // Number of bytes written into out_.
   std::map<std::string, BundleEntryProto> entries_;
   Status status_;
+  // True iff any entry was written with a codec other than NONE, in which
+  // case Finish() raises the header's min_consumer version.
+  bool seen_codec_ = false;
 
   BundleWriter(const BundleWriter&) = delete;
   void operator=(const BundleWriter&) = delete;
@@ -278,6 +291,23 @@ class BundleReader {
                      const TensorSlice& slice_spec,
                      Tensor* val) TF_MUST_USE_RESULT;
 
+  // Looks up the rows [row_start, row_start + num_rows) along dimension 0 of
+  // the tensor keyed by "full_tensor_key" and reads them directly into the
+  // pre-allocated buffer of "val", without reading the untouched rows.  This
+  // makes restoring a small subset of a large tensor (e.g. a handful of
+  // embedding-table rows) proportional to the bytes requested rather than to
+  // the stored tensor size.
+  //
+  // "val" must have the stored dtype, and the stored shape with dimension 0
+  // replaced by "num_rows".  For tensors stored unpartitioned and
+  // uncompressed, exactly the requested byte range is read; since the stored
+  // crc32c checksum covers the full tensor, it is not validated for such
+  // partial reads.  Partitioned, compressed, and non-POD tensors fall back to
+  // a regular slice lookup, which may read more than the requested rows.
+  // REQUIRES: status().ok()
+  Status LookupRowRange(absl::string_view full_tensor_key, int64_t row_start,
+                        int64_t num_rows, Tensor* val) TF_MUST_USE_RESULT;
+
   // Seeks to the first position in the bundle whose key is no less than "key".
   // REQUIRES: status().ok()
   void Seek(absl::string_view key) { return iter_->Seek(key); }
@@ -648,6 +648,61 @@ TEST(TensorBundleTest, PartitionedVariables) {
   }
 }
 
+TEST(TensorBundleTest, LookupRowRange) {
+  const TensorShape kFullShape({5, 10});
+  Tensor full(DT_FLOAT, kFullShape);
+  test::FillFn<float>(&full, [](int offset) -> float { return offset; });
+  {
+    BundleWriter writer(Env::Default(), Prefix("foo"));
+    TF_ASSERT_OK(writer.Add("foo", full));
+    TF_ASSERT_OK(writer.Finish());
+  }
+  BundleReader reader(Env::Default(), Prefix("foo"));
+  TF_ASSERT_OK(reader.status());
+  // Reads rows [2, 4) directly, without touching the other rows.
+  {
+    Tensor expected_val(DT_FLOAT, TensorShape({2, 10}));
+    test::FillFn<float>(&expected_val,
+                        [](int offset) -> float { return 20 + offset; });
+    Tensor val(DT_FLOAT, TensorShape({2, 10}));
+    TF_ASSERT_OK(reader.LookupRowRange("foo", 2, 2, &val));
+    test::ExpectTensorEqual<float>(val, expected_val);
+  }
+  // An empty range is allowed.
+  {
+    Tensor val(DT_FLOAT, TensorShape({0, 10}));
+    TF_ASSERT_OK(reader.LookupRowRange("foo", 5, 0, &val));
+  }
+  // Out-of-bounds ranges and mis-shaped destinations are rejected.
+  {
+    Tensor val(DT_FLOAT, TensorShape({2, 10}));
+    EXPECT_FALSE(reader.LookupRowRange("foo", 4, 2, &val).ok());
+    EXPECT_FALSE(reader.LookupRowRange("foo", -1, 2, &val).ok());
+    EXPECT_FALSE(reader.LookupRowRange("foo", 0, 3, &val).ok());
+  }
+  // Partitioned tensors fall back to the slice path.
+  {
+    BundleWriter writer(Env::Default(), Prefix("bar"));
+    TF_ASSERT_OK(writer.AddSlice("bar", kFullShape,
+                                 TensorSlice::ParseOrDie("0,2:-"),
+                                 Constant<float>(0., TensorShape({2, 10}))));
+    TF_ASSERT_OK(writer.AddSlice("bar", kFullShape,
+                                 TensorSlice::ParseOrDie("2,3:-"),
+                                 Constant<float>(1., TensorShape({3, 10}))));
+    TF_ASSERT_OK(writer.Finish());
+
+    BundleReader partitioned_reader(Env::Default(), Prefix("bar"));
+    TF_ASSERT_OK(partitioned_reader.status());
+    Tensor expected_val(DT_FLOAT, TensorShape({2, 10}));
+    test::FillFn<float>(&expected_val, [](int offset) -> float {
+      return offset < 10 ? 0 : 1;  // Row 1 zeros, row 2 ones.
+    });
+    Tensor val(DT_FLOAT, TensorShape({2, 10}));
+    TF_ASSERT_OK(partitioned_reader.LookupRowRange("bar", 1, 2, &val));
+    test::ExpectTensorEqual<float>(val, expected_val);
+  }
+}
+
 TEST(TensorBundleTest, EquivalentSliceTest) {
   const TensorShape kFullShape({5, 10});
   const Tensor kExpected(Constant<float>(1., kFullShape));
@@ -1038,6 +1093,37 @@ TEST(TensorBundleTest, Checksum) {
   }
 }
 
+TEST(TensorBundleTest, CompressionCodecs) {
+  for (const auto codec :
+       {BundleEntryProto::SNAPPY, BundleEntryProto::BYTE_STREAM_SPLIT_SNAPPY}) {
+    // Large enough to be compressed and to span multiple compression blocks.
+    Tensor big(DT_FLOAT, TensorShape({512, 1024}));
+    for (int64_t i = 0; i < big.NumElements(); ++i) {
+      big.flat<float>()(i) = static_cast<float>(i % 1000) * 0.25f;
+    }
+    {
+      BundleWriter::Options opts;
+      opts.codec = codec;
+      BundleWriter writer(Env::Default(), Prefix("compressed"), opts);
+      TF_EXPECT_OK(writer.Add("big", big));
+      // Small tensors stay uncompressed.
+      TF_EXPECT_OK(writer.Add("small", Constant_2x3<float>(1)));
+      // String tensors are unaffected by the codec option.
+      TF_EXPECT_OK(
+          writer.Add("strs", test::AsTensor<tstring>({"hello", "world"})));
+      TF_ASSERT_OK(writer.Finish());
+    }
+    {
+      BundleReader reader(Env::Default(), Prefix("compressed"));
+      TF_ASSERT_OK(reader.status());
+      Expect<float>(&reader, "big", big);
+      Expect<float>(&reader, "small", Constant_2x3<float>(1));
+      Expect<tstring>(&reader, "strs",
+                      test::AsTensor<tstring>({"hello", "world"}));
+    }
+  }
+}
+
 TEST(TensorBundleTest, TruncatedTensorContents) {
   Env* env = Env::Default();
   BundleWriter writer(env, Prefix("end"));
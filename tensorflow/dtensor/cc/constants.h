@@ -164,6 +164,15 @@ static constexpr char kEnableMultiDeviceMode[] =
 static constexpr char kAllReduceTopologicalDistance[] =
     "dtensor.all_reduce_combiner.topological_distance";
 
+// Attribute which stores the environment variable value for all_reduce
+// optimization maximum group size in bytes:
+// DTENSOR_ALLREDUCE_COMBINE_OPTIMIZATION_MAX_GROUP_BYTES. This caps the total
+// payload of a merged AllReduce so bucket sizing can be tuned to the bandwidth
+// of the mesh dimension being reduced over. It is a determining factor used
+// during dtensor_allreduce_combine_optimization.
+static constexpr char kAllReduceMaxGroupBytes[] =
+    "dtensor.all_reduce_combiner.max_group_bytes";
+
 }  // namespace dtensor
 }  // namespace tensorflow
 
@@ -16,6 +16,7 @@ limitations under the License.
 #ifndef TENSORFLOW_DTENSOR_CC_DTENSOR_UTILS_H_
 #define TENSORFLOW_DTENSOR_CC_DTENSOR_UTILS_H_
 
+#include <cstdint>
 #include <string>
 
 #include "absl/strings/string_view.h"
@@ -84,6 +85,15 @@ int AllReduceCombineOptimizationGroupSize();
 // extended grouping.
 int AllReduceCombineOptimizationTopologicalDistance();
 
+// Returns the maximum total payload, in bytes, of a merged AllReduce group in
+// dtensor_allreduce_combine_optimization. The input value should be in range
+// of [0, INT64_MAX]. It is advised to pick a value based on the bandwidth of
+// the mesh dimension being reduced over: higher-bandwidth links amortize
+// launch overhead with larger buckets, while smaller buckets let early
+// gradient reductions overlap with remaining backprop compute. When the value
+// is 0 (the default), no byte-size cap is applied.
+int64_t AllReduceCombineOptimizationMaxGroupBytes();
+
 // Returns whether to perform multi-device expansion.
 bool EnableMultiDeviceMode();
 }  // namespace dtensor
@@ -565,6 +565,58 @@ createSubgroupsByExtendedNumOps(
   return all_reduce_new_groups;
 }
 
+// Returns the payload of `all_reduce` in bytes. All eligible all-reduces have
+// a ranked static shape, checked when they were collected.
+int64_t allReduceSizeBytes(mlir::TF::DTensorAllReduceOp all_reduce) {
+  auto ranked_type = all_reduce.getType().cast<mlir::RankedTensorType>();
+  // Sub-byte element types round up to one byte, matching the padding the
+  // merged tensor receives anyway.
+  int64_t elem_bytes =
+      std::max<int64_t>(1, ranked_type.getElementTypeBitWidth() / 8);
+  return ranked_type.getNumElements() * elem_bytes;
+}
+
+// Experimental extended grouping logics to avoid aggressive grouping.
+// This function caps the total payload of each merged AllReduce at
+// max_group_bytes, closing a group as soon as adding the next op would exceed
+// the cap. Sizing buckets by bytes rather than op count keeps each combined
+// reduction's latency bounded, so reductions of early gradients can overlap
+// with remaining backprop compute instead of draining in one large collective.
+// It is advised to pick a value based on the bandwidth of the mesh dimension
+// being reduced over. When max_group_bytes is too big, the function will act
+// as aggressive grouping. When max_group_bytes is too small, the function will
+// act as having no extended grouping.
+std::vector<std::vector<mlir::TF::DTensorAllReduceOp>>
+createSubgroupsByMaxGroupBytes(
+    std::vector<std::vector<mlir::TF::DTensorAllReduceOp>> all_reduce_groups,
+    int64_t max_group_bytes) {
+  VLOG(4) << "max payload of a all-reduce group in bytes: " << max_group_bytes;
+  // Disable extended grouping if the byte cap is set to zero
+  if (max_group_bytes <= 0) return all_reduce_groups;
+  std::vector<std::vector<mlir::TF::DTensorAllReduceOp>> all_reduce_new_groups;
+  // Further break down the current all_reduced_groups by accumulated byte size
+  for (const auto& all_reduce_group : all_reduce_groups) {
+    std::vector<mlir::TF::DTensorAllReduceOp> new_group;
+    int64_t new_group_bytes = 0;
+    for (mlir::TF::DTensorAllReduceOp all_reduce : all_reduce_group) {
+      int64_t op_bytes = allReduceSizeBytes(all_reduce);
+      // An op larger than the cap forms its own group; splitting a single
+      // tensor is not profitable here.
+      if (!new_group.empty() && new_group_bytes + op_bytes > max_group_bytes) {
+        all_reduce_new_groups.push_back(new_group);
+        new_group.clear();
+        new_group_bytes = 0;
+      }
+      new_group.push_back(all_reduce);
+      new_group_bytes += op_bytes;
+    }
+    if (!new_group.empty()) all_reduce_new_groups.push_back(new_group);
+  }
+  VLOG(4) << "current number of groups: " << all_reduce_new_groups.size()
+          << " after grouping by max group bytes.";
+  return all_reduce_new_groups;
+}
+
 // Experimental grouping logics to optimize from aggressive grouping.
 // This function first sort by topological level, then create AllReduce sub-
 // groups by accessing each topological distance from its previous AllReduce.
@@ -738,6 +790,14 @@ struct DTensorAllReduceCombineOptimization
                   .getInt());
         }
 
+        // Experimental extended grouping: maximum payload bytes per group
+        if (module->hasAttrOfType<mlir::IntegerAttr>(kAllReduceMaxGroupBytes)) {
+          all_reduce_groups = createSubgroupsByMaxGroupBytes(
+              all_reduce_groups,
+              module->getAttrOfType<mlir::IntegerAttr>(kAllReduceMaxGroupBytes)
+                  .getInt());
+        }
+
         // Maintain relative order of ALLReduces within the block.
         std::sort(all_reduce_groups.begin(), all_reduce_groups.end(),
                   [](std::vector<mlir::TF::DTensorAllReduceOp> lhs,
@@ -18,8 +18,10 @@ limitations under the License.
 
 #include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <limits>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -35,6 +37,32 @@ constexpr int32_t kLastActiveNodeUndefined =
 constexpr int32_t kNodeNotAssigned = std::numeric_limits<int32_t>::max();
 constexpr int32_t kScalarTensorBytes = 4;
 
+namespace {
+
+// Wire format of a plan snapshot. Fields are stored in host byte order; a
+// snapshot is a warm-start cache for the producing device, not a portable
+// artifact, and mismatches are caught by the magic and the per-entry
+// validation in ApplyPlanSnapshot().
+constexpr uint32_t kPlanSnapshotMagic = 0x54464c50;  // "TFLP"
+constexpr uint32_t kPlanSnapshotVersion = 1;
+
+template <typename T>
+void SnapshotAppend(std::string* output, T value) {
+  output->append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool SnapshotRead(const char** pos, const char* end, T* value) {
+  if (end - *pos < static_cast<ptrdiff_t>(sizeof(T))) {
+    return false;
+  }
+  std::memcpy(value, *pos, sizeof(T));
+  *pos += sizeof(T);
+  return true;
+}
+
+}  // namespace
+
 ArenaPlanner::ArenaPlanner(TfLiteContext* context,
                            std::unique_ptr<GraphInfo> graph_info,
                            bool preserve_all_tensors, int tensor_alignment,
@@ -45,18 +73,41 @@ ArenaPlanner::ArenaPlanner(TfLiteContext* context,
       persistent_arena_(kDefaultArenaAlignment, subgraph_index),
       preserve_all_tensors_(preserve_all_tensors),
       tensor_alignment_(tensor_alignment),
-      last_active_node_(kLastActiveNodeUndefined) {}
+      last_active_node_(kLastActiveNodeUndefined),
+      arena_group_(nullptr),
+      subgraph_index_(subgraph_index),
+      shared_base_(0),
+      shared_size_(0),
+      shared_generation_(-1),
+      shared_committed_(false),
+      shared_resolved_base_(nullptr) {}
 
 ArenaPlanner::~ArenaPlanner() {
+  if (arena_group_ != nullptr && shared_committed_) {
+    arena_group_->SetRegionSize(subgraph_index_, 0);
+  }
   arena_.ReleaseBuffer();
   persistent_arena_.ReleaseBuffer();
 }
 
+void ArenaPlanner::SetSubgraphArenaGroup(SubgraphArenaGroup* group) {
+  arena_group_ = group;
+}
+
+bool ArenaPlanner::UseSharedArena() const {
+  return arena_group_ != nullptr &&
+         (subgraph_index_ == 0 || arena_group_->HasCaller(subgraph_index_));
+}
+
 std::intptr_t ArenaPlanner::BasePointer(TfLiteAllocationType type) {
   if (type == kTfLiteArenaRwPersistent) {
     return persistent_arena_.BasePointer();
   }
   if (type == kTfLiteArenaRw) {
+    if (UseSharedArena() && shared_committed_) {
+      return reinterpret_cast<std::intptr_t>(arena_group_->buffer() +
+                                             shared_base_);
+    }
     return arena_.BasePointer();
   }
   return 0;
@@ -356,6 +407,13 @@ TfLiteStatus ArenaPlanner::ExecuteAllocations(int first_node, int last_node) {
     }
   }
 
+  // A staged plan snapshot can only be validated once the usage intervals of
+  // every tensor -- including op temporaries, registered just above -- are
+  // known, i.e. on the planning pass that starts at the first node.
+  if (!staged_snapshot_.empty() && first_node == 0) {
+    ApplyPlanSnapshot();
+  }
+
   std::vector<int32_t> tensors_allocated;
   TF_LITE_ENSURE_STATUS(
       CalculateAllocations(first_node, last_node, &tensors_allocated));
@@ -380,6 +438,13 @@ TfLiteStatus ArenaPlanner::ExecuteAllocations(int first_node, int last_node) {
 TfLiteStatus ArenaPlanner::ReleaseNonPersistentMemory() {
   // Clear non-persistent arena's buffer.
   TF_LITE_ENSURE_STATUS(arena_.ReleaseBuffer());
+  if (arena_group_ != nullptr && shared_committed_) {
+    // The shared buffer may back other subgraphs; only withdraw this
+    // subgraph's region from it.
+    arena_group_->SetRegionSize(subgraph_index_, 0);
+    shared_committed_ = false;
+    shared_resolved_base_ = nullptr;
+  }
   // Set data pointers for all non-persistent tensors to nullptr.
   TfLiteTensor* tensors = graph_info_->tensors();
   for (int i = 0; i < static_cast<int>(graph_info_->num_tensors()); ++i) {
@@ -394,7 +459,11 @@ TfLiteStatus ArenaPlanner::ReleaseNonPersistentMemory() {
 TfLiteStatus ArenaPlanner::AcquireNonPersistentMemory() {
   // First commit arena_ to allocate underlying buffer.
   bool reallocated;
-  TF_LITE_ENSURE_STATUS(arena_.Commit(context_, &reallocated));
+  if (UseSharedArena()) {
+    TF_LITE_ENSURE_STATUS(CommitShared(&reallocated));
+  } else {
+    TF_LITE_ENSURE_STATUS(arena_.Commit(context_, &reallocated));
+  }
   // Resolve allocations for all tensors not on the persistent arena.
   TfLiteTensor* tensors = graph_info_->tensors();
   for (int i = 0; i < static_cast<int>(graph_info_->num_tensors()); ++i) {
@@ -407,9 +476,188 @@ TfLiteStatus ArenaPlanner::AcquireNonPersistentMemory() {
 }
 
 bool ArenaPlanner::HasNonPersistentMemory() {
+  if (UseSharedArena()) {
+    return shared_committed_;
+  }
   return arena_.GetBufferSize() != 0;
 }
 
+TfLiteStatus ArenaPlanner::RefreshTensorAllocations() {
+  if (!UseSharedArena() || !shared_committed_) {
+    return kTfLiteOk;
+  }
+  if (arena_group_->generation() == shared_generation_ &&
+      arena_group_->BaseOffset(subgraph_index_) == shared_base_) {
+    return kTfLiteOk;
+  }
+  // The shared buffer has moved, or this subgraph's region inside it has
+  // shifted, since our tensors were last resolved. All tensors are
+  // recomputed during the invocation, but the subgraph inputs were filled
+  // through the old pointers, so their contents must be carried over to the
+  // new location. The old pointers still read consistent data because
+  // retired buffers are kept alive until every subgraph has refreshed.
+  char* const old_base = shared_resolved_base_;
+  TfLiteTensor* tensors = graph_info_->tensors();
+  struct SavedInput {
+    int32_t tensor_index;
+    char* old_data;
+    std::vector<char> contents;
+  };
+  std::vector<SavedInput> saved_inputs;
+  for (int tensor_index : graph_info_->inputs()) {
+    if (tensor_index == kTfLiteOptionalTensor) continue;
+    TfLiteTensor& tensor = tensors[tensor_index];
+    if (tensor.allocation_type == kTfLiteArenaRw &&
+        tensor.data.raw != nullptr) {
+      saved_inputs.push_back(
+          {tensor_index, tensor.data.raw,
+           std::vector<char>(tensor.data.raw, tensor.data.raw + tensor.bytes)});
+    }
+  }
+  bool reallocated = false;
+  TF_LITE_ENSURE_STATUS(CommitShared(&reallocated));
+  char* const new_base = arena_group_->buffer() + shared_base_;
+  for (int i = 0; i < static_cast<int>(allocs_.size()); ++i) {
+    TfLiteTensor& tensor = tensors[i];
+    if (tensor.allocation_type != kTfLiteArenaRw) continue;
+    const ArenaAllocWithUsageInterval& alloc = allocs_[FindSharedTensor(i)];
+    if (alloc.size == 0) continue;
+    // Only move pointers this planner placed. A control flow kernel may have
+    // redirected a tensor at another subgraph's buffer, and such aliases
+    // must survive the refresh.
+    if (old_base != nullptr && tensor.data.raw != old_base + alloc.offset) {
+      continue;
+    }
+    tensor.data.raw = new_base + alloc.offset;
+  }
+  for (const auto& saved : saved_inputs) {
+    TfLiteTensor& tensor = tensors[saved.tensor_index];
+    if (tensor.data.raw != nullptr && tensor.data.raw != saved.old_data &&
+        saved.contents.size() == tensor.bytes) {
+      std::memcpy(tensor.data.raw, saved.contents.data(), tensor.bytes);
+    }
+  }
+  return kTfLiteOk;
+}
+
+TfLiteStatus ArenaPlanner::GetPlanSnapshot(std::string* output) const {
+  TF_LITE_ENSURE(context_, output != nullptr);
+  output->clear();
+  const TfLiteTensor* tensors = graph_info_->tensors();
+  std::vector<SnapshotAlloc> entries;
+  for (size_t i = 0; i < allocs_.size(); ++i) {
+    const ArenaAllocWithUsageInterval& alloc = allocs_[i];
+    if (alloc.tensor < 0 || alloc.size == 0) {
+      continue;
+    }
+    const TfLiteAllocationType allocation_type = tensors[i].allocation_type;
+    if (allocation_type != kTfLiteArenaRw &&
+        allocation_type != kTfLiteArenaRwPersistent) {
+      continue;
+    }
+    entries.push_back({alloc, allocation_type == kTfLiteArenaRwPersistent});
+  }
+  SnapshotAppend(output, kPlanSnapshotMagic);
+  SnapshotAppend(output, kPlanSnapshotVersion);
+  SnapshotAppend(output, static_cast<uint32_t>(tensor_alignment_));
+  SnapshotAppend(output, static_cast<uint32_t>(preserve_all_tensors_));
+  SnapshotAppend(output, static_cast<uint32_t>(entries.size()));
+  for (const SnapshotAlloc& entry : entries) {
+    SnapshotAppend(output, entry.alloc.tensor);
+    SnapshotAppend(output, entry.alloc.first_node);
+    SnapshotAppend(output, entry.alloc.last_node);
+    SnapshotAppend(output, static_cast<uint32_t>(entry.persistent));
+    SnapshotAppend(output, static_cast<uint64_t>(entry.alloc.offset));
+    SnapshotAppend(output, static_cast<uint64_t>(entry.alloc.size));
+  }
+  return kTfLiteOk;
+}
+
+TfLiteStatus ArenaPlanner::SetPlanSnapshot(const std::string& snapshot) {
+  staged_snapshot_.clear();
+  const char* pos = snapshot.data();
+  const char* end = pos + snapshot.size();
+  uint32_t magic, version, alignment, preserve, num_entries;
+  if (!SnapshotRead(&pos, end, &magic) || magic != kPlanSnapshotMagic ||
+      !SnapshotRead(&pos, end, &version) || version != kPlanSnapshotVersion) {
+    return kTfLiteError;
+  }
+  // A snapshot produced under different planner settings describes a
+  // different packing and cannot be reused.
+  if (!SnapshotRead(&pos, end, &alignment) ||
+      alignment != static_cast<uint32_t>(tensor_alignment_) ||
+      !SnapshotRead(&pos, end, &preserve) ||
+      preserve != static_cast<uint32_t>(preserve_all_tensors_)) {
+    return kTfLiteError;
+  }
+  if (!SnapshotRead(&pos, end, &num_entries)) {
+    return kTfLiteError;
+  }
+  std::vector<SnapshotAlloc> entries;
+  entries.reserve(num_entries);
+  for (uint32_t i = 0; i < num_entries; ++i) {
+    SnapshotAlloc entry;
+    uint32_t persistent;
+    uint64_t offset, size;
+    if (!SnapshotRead(&pos, end, &entry.alloc.tensor) ||
+        !SnapshotRead(&pos, end, &entry.alloc.first_node) ||
+        !SnapshotRead(&pos, end, &entry.alloc.last_node) ||
+        !SnapshotRead(&pos, end, &persistent) ||
+        !SnapshotRead(&pos, end, &offset) || !SnapshotRead(&pos, end, &size)) {
+      return kTfLiteError;
+    }
+    entry.alloc.offset = offset;
+    entry.alloc.size = size;
+    entry.persistent = persistent != 0;
+    entries.push_back(entry);
+  }
+  if (pos != end) {
+    return kTfLiteError;
+  }
+  staged_snapshot_ = std::move(entries);
+  return kTfLiteOk;
+}
+
+void ArenaPlanner::ApplyPlanSnapshot() {
+  const std::vector<SnapshotAlloc> staged = std::move(staged_snapshot_);
+  staged_snapshot_.clear();
+  const size_t num_tensors = graph_info_->num_tensors();
+  const TfLiteTensor* tensors = graph_info_->tensors();
+  for (const SnapshotAlloc& entry : staged) {
+    const ArenaAllocWithUsageInterval& alloc = entry.alloc;
+    if (alloc.tensor < 0 || static_cast<size_t>(alloc.tensor) >= num_tensors) {
+      return;
+    }
+    const TfLiteTensor& tensor = tensors[alloc.tensor];
+    const TfLiteAllocationType expected_type =
+        entry.persistent ? kTfLiteArenaRwPersistent : kTfLiteArenaRw;
+    // The graph must still require exactly the allocation the snapshot
+    // describes: same arena, a size that still fits the tensor and an
+    // unchanged usage interval. Any mismatch (resized inputs, a delegate
+    // that changed allocation types, a different model) voids the whole
+    // snapshot, since offsets were packed against the old lifetimes.
+    if (tensor.allocation_type != expected_type ||
+        alloc.size < tensor.bytes ||
+        alloc.offset % tensor_alignment_ != 0 ||
+        alloc.first_node != alloc_node_[alloc.tensor] ||
+        alloc.last_node != dealloc_node_[alloc.tensor]) {
+      return;
+    }
+  }
+  for (const SnapshotAlloc& entry : staged) {
+    allocs_[entry.alloc.tensor] = entry.alloc;
+    if (entry.persistent) {
+      persistent_arena_.ReserveAlloc(entry.alloc);
+    } else {
+      arena_.ReserveAlloc(entry.alloc);
+    }
+  }
+  // Mark the plan as active from the first node so that the following
+  // planning pass purges nothing and only allocates tensors the snapshot
+  // does not cover.
+  last_active_node_ = 0;
+}
+
 void ArenaPlanner::DumpDebugInfo(const std::vector<int>& execution_plan) const {
   arena_.DumpDebugInfo("kTfLiteArenaRw Dump:", execution_plan);
   persistent_arena_.DumpDebugInfo("kTfLiteArenaRwPersistent Dump:",
@@ -418,13 +666,21 @@ void ArenaPlanner::DumpDebugInfo(const std::vector<int>& execution_plan) const {
 
 void ArenaPlanner::GetAllocInfo(size_t* arena_size,
                                 size_t* arena_persist_size) const {
-  *arena_size = arena_.GetBufferSize();
+  if (UseSharedArena()) {
+    *arena_size = shared_committed_ ? shared_size_ : 0;
+  } else {
+    *arena_size = arena_.GetBufferSize();
+  }
   *arena_persist_size = persistent_arena_.GetBufferSize();
 }
 
 TfLiteStatus ArenaPlanner::Commit(bool* reallocated) {
   bool arena_reallocated, persistent_arena_reallocated;
-  TF_LITE_ENSURE_STATUS(arena_.Commit(context_, &arena_reallocated));
+  if (UseSharedArena()) {
+    TF_LITE_ENSURE_STATUS(CommitShared(&arena_reallocated));
+  } else {
+    TF_LITE_ENSURE_STATUS(arena_.Commit(context_, &arena_reallocated));
+  }
   TF_LITE_ENSURE_STATUS(
       persistent_arena_.Commit(context_, &persistent_arena_reallocated));
   *reallocated = arena_reallocated;
@@ -432,6 +688,26 @@ TfLiteStatus ArenaPlanner::Commit(bool* reallocated) {
   return kTfLiteOk;
 }
 
+TfLiteStatus ArenaPlanner::CommitShared(bool* arena_reallocated) {
+  const size_t base = arena_group_->BaseOffset(subgraph_index_);
+  const size_t size = arena_.RequiredBufferSize();
+  bool buffer_reallocated = false;
+  TF_LITE_ENSURE_STATUS(
+      arena_group_->EnsureBufferSize(context_, base + size,
+                                     &buffer_reallocated));
+  arena_group_->SetRegionSize(subgraph_index_, size);
+  *arena_reallocated = buffer_reallocated || !shared_committed_ ||
+                       base != shared_base_ ||
+                       arena_group_->generation() != shared_generation_;
+  shared_base_ = base;
+  shared_size_ = size;
+  shared_generation_ = arena_group_->generation();
+  shared_committed_ = true;
+  shared_resolved_base_ = arena_group_->buffer() + shared_base_;
+  arena_group_->NotifySynced(subgraph_index_, shared_generation_);
+  return kTfLiteOk;
+}
+
 void ArenaPlanner::CreateTensorAllocationVector(
     std::vector<int32_t>* tensors_to_allocate) {
   const TfLiteTensor* tensors = this->graph_info_->tensors();
@@ -593,6 +869,14 @@ TfLiteStatus ArenaPlanner::ResolveTensorAllocation(int32_t tensor_index,
     // Skip resolution if the size of the tensor is zero, leaving it as a
     // nullptr.
     if (allocs_[tensor_index].size != 0) {
+      if (UseSharedArena() && shared_committed_) {
+        TF_LITE_ENSURE(context_, shared_base_ + allocs_[tensor_index].offset +
+                                         allocs_[tensor_index].size <=
+                                     arena_group_->buffer_size());
+        tensor.data.raw = arena_group_->buffer() + shared_base_ +
+                          allocs_[tensor_index].offset;
+        return kTfLiteOk;
+      }
       return arena_.ResolveAlloc(context_, allocs_[tensor_index],
                                  &tensor.data.raw);
     }
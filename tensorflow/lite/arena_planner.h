@@ -17,6 +17,7 @@ limitations under the License.
 
 #include <cstdint>
 #include <memory>
+#include <string>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -25,11 +26,11 @@ limitations under the License.
 #include "tensorflow/lite/graph_info.h"
 #include "tensorflow/lite/memory_planner.h"
 #include "tensorflow/lite/simple_memory_arena.h"
+#include "tensorflow/lite/subgraph_arena_group.h"
 #include "tensorflow/lite/util.h"
 
 namespace tflite {
 
-constexpr const int kDefaultArenaAlignment = 64;
 struct AllocationInfo;
 
 // A memory planner that makes all the allocations using arenas.
@@ -65,6 +66,9 @@ class ArenaPlanner : public MemoryPlanner {
   TfLiteStatus ReleaseNonPersistentMemory() override;
   TfLiteStatus AcquireNonPersistentMemory() override;
   bool HasNonPersistentMemory() override;
+  TfLiteStatus RefreshTensorAllocations() override;
+  TfLiteStatus GetPlanSnapshot(std::string* output) const override;
+  TfLiteStatus SetPlanSnapshot(const std::string& snapshot) override;
   void DumpDebugInfo(const std::vector<int>& execution_plan) const override;
   void GetAllocInfo(size_t* arena_size,
                     size_t* arena_persist_size) const override;
@@ -72,6 +76,11 @@ class ArenaPlanner : public MemoryPlanner {
   // Returns the base arena location for a given allocation type.
   std::intptr_t BasePointer(TfLiteAllocationType type);
 
+  // Lays the non-persistent arena of this planner out inside `group`'s
+  // shared buffer instead of a private allocation. Does not take ownership
+  // of `group`, which must outlive the planner.
+  void SetSubgraphArenaGroup(SubgraphArenaGroup* group);
+
  private:
   // Check whether the input tensor's memory may be shared the output tensor.
   // tensor_changed: true if the output tensor modifies the tensor data. For
@@ -120,6 +129,30 @@ class ArenaPlanner : public MemoryPlanner {
   // Return the index of the tensor owing `tensor_index's` buffer.
   int FindSharedTensor(int tensor_index);
 
+  // Returns true if the non-persistent arena is laid out inside the shared
+  // subgraph buffer. A non-primary subgraph only shares once one of its
+  // callers is known, so that a subgraph invoked by an op the call scan
+  // cannot see through keeps a private arena instead of clashing with the
+  // primary subgraph's region.
+  bool UseSharedArena() const;
+
+  // Commits the non-persistent arena into the shared subgraph buffer.
+  TfLiteStatus CommitShared(bool* arena_reallocated);
+
+  // An allocation staged from a deserialized plan snapshot, waiting to be
+  // validated against the current graph.
+  struct SnapshotAlloc {
+    ArenaAllocWithUsageInterval alloc;
+    bool persistent;
+  };
+
+  // Validates the staged snapshot against the current graph and, if every
+  // entry still matches (tensor sizes, lifetimes and allocation types),
+  // installs its allocations so that the subsequent planning pass skips
+  // them. Discards the staged snapshot either way; on a mismatch the plan is
+  // simply recomputed.
+  void ApplyPlanSnapshot();
+
   TfLiteContext* context_;
   std::unique_ptr<GraphInfo> graph_info_;
 
@@ -164,6 +197,31 @@ class ArenaPlanner : public MemoryPlanner {
 
   // Store number of references to each tensor.
   std::vector<int> refcounts_;
+
+  // When non-null, the non-persistent arena is placed inside this shared
+  // buffer instead of committing a private allocation. Not owned. See
+  // SubgraphArenaGroup.
+  SubgraphArenaGroup* arena_group_;
+
+  // Index of the subgraph this planner belongs to; identifies its region
+  // inside `arena_group_`.
+  int subgraph_index_;
+
+  // Offset, size and buffer generation of the region last committed to
+  // `arena_group_`, used to detect when tensors must be re-resolved.
+  size_t shared_base_;
+  size_t shared_size_;
+  int64_t shared_generation_;
+  bool shared_committed_;
+
+  // Address tensors were last resolved against (shared buffer plus
+  // `shared_base_`). Used to tell pointers this planner placed apart from
+  // pointers a kernel has redirected elsewhere.
+  char* shared_resolved_base_;
+
+  // Allocations staged by SetPlanSnapshot(), applied on the next
+  // ExecuteAllocations() call that starts at the first node.
+  std::vector<SnapshotAlloc> staged_snapshot_;
 };
 
 }  // namespace tflite
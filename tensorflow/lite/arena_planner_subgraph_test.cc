@@ -12,9 +12,11 @@ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
+#include <string>
 #include <vector>
 
 #include <gtest/gtest.h>
+#include "tensorflow/lite/interpreter_options.h"
 #include "tensorflow/lite/kernels/subgraph_test_util.h"
 
 namespace tflite {
@@ -123,5 +125,114 @@ TEST(ArenaPlannerSubgraphTest, TestOffsetAddSharing) {
   subgraph_test_util::CheckIntTensor(subgraph_output, {3}, {10, 12, 11});
 }
 
+TEST(ArenaPlannerSubgraphTest, MemoryPlanSnapshotRoundTrip) {
+  // Warm planning pass: serialize the memory plan of an allocated model.
+  std::string snapshot;
+  {
+    Interpreter interpreter;
+    subgraph_test_util::SubgraphBuilder builder;
+    builder.BuildBroadcastingSubgraph(&interpreter.primary_subgraph());
+    ASSERT_EQ(interpreter.ResizeInputTensor(interpreter.inputs()[0], {1}),
+              kTfLiteOk);
+    ASSERT_EQ(interpreter.ResizeInputTensor(interpreter.inputs()[1], {2}),
+              kTfLiteOk);
+    ASSERT_EQ(interpreter.AllocateTensors(), kTfLiteOk);
+    ASSERT_EQ(interpreter.GetMemoryPlanSnapshot(&snapshot), kTfLiteOk);
+    EXPECT_FALSE(snapshot.empty());
+  }
+
+  // Warm start: an identical interpreter restores the plan before
+  // AllocateTensors() and still produces correct results.
+  Interpreter interpreter;
+  subgraph_test_util::SubgraphBuilder builder;
+  builder.BuildBroadcastingSubgraph(&interpreter.primary_subgraph());
+  ASSERT_EQ(interpreter.SetMemoryPlanSnapshot(snapshot), kTfLiteOk);
+  ASSERT_EQ(interpreter.ResizeInputTensor(interpreter.inputs()[0], {1}),
+            kTfLiteOk);
+  ASSERT_EQ(interpreter.ResizeInputTensor(interpreter.inputs()[1], {2}),
+            kTfLiteOk);
+  ASSERT_EQ(interpreter.AllocateTensors(), kTfLiteOk);
+  subgraph_test_util::FillIntTensor(
+      interpreter.tensor(interpreter.inputs()[0]), {1});
+  subgraph_test_util::FillIntTensor(
+      interpreter.tensor(interpreter.inputs()[1]), {2, 2});
+  ASSERT_EQ(interpreter.Invoke(), kTfLiteOk);
+  subgraph_test_util::CheckIntTensor(
+      interpreter.tensor(interpreter.outputs()[0]), {2}, {9, 9});
+
+  // A truncated snapshot is rejected up front.
+  EXPECT_EQ(interpreter.SetMemoryPlanSnapshot(snapshot.substr(0, 3)),
+            kTfLiteError);
+}
+
+class SharedArenaControlFlowTest : public subgraph_test_util::ControlFlowOpTest {
+};
+
+TEST_F(SharedArenaControlFlowTest, TestWhileLoopWithSharedArena) {
+  AddSubgraphs(2);
+  builder_->BuildLessEqualCondSubgraph(interpreter_->subgraph(1), 3);
+  builder_->BuildAccumulateLoopBodySubgraph(interpreter_->subgraph(2));
+  builder_->BuildWhileSubgraph(&interpreter_->primary_subgraph());
+
+  InterpreterOptions options;
+  options.SetShareArenaAcrossSubgraphs(true);
+  ASSERT_EQ(interpreter_->ApplyOptions(&options), kTfLiteOk);
+
+  ASSERT_EQ(interpreter_->ResizeInputTensor(interpreter_->inputs()[0], {1}),
+            kTfLiteOk);
+  ASSERT_EQ(interpreter_->ResizeInputTensor(interpreter_->inputs()[1], {1}),
+            kTfLiteOk);
+  ASSERT_EQ(interpreter_->AllocateTensors(), kTfLiteOk);
+  subgraph_test_util::FillIntTensor(
+      interpreter_->tensor(interpreter_->inputs()[0]), {1});
+  subgraph_test_util::FillIntTensor(
+      interpreter_->tensor(interpreter_->inputs()[1]), {1});
+  ASSERT_EQ(interpreter_->Invoke(), kTfLiteOk);
+  subgraph_test_util::CheckIntTensor(
+      interpreter_->tensor(interpreter_->outputs()[0]), {1}, {4});
+  subgraph_test_util::CheckIntTensor(
+      interpreter_->tensor(interpreter_->outputs()[1]), {1}, {10});
+
+  // A second invocation reuses the shared plan.
+  subgraph_test_util::FillIntTensor(
+      interpreter_->tensor(interpreter_->inputs()[0]), {1});
+  subgraph_test_util::FillIntTensor(
+      interpreter_->tensor(interpreter_->inputs()[1]), {1});
+  ASSERT_EQ(interpreter_->Invoke(), kTfLiteOk);
+  subgraph_test_util::CheckIntTensor(
+      interpreter_->tensor(interpreter_->outputs()[0]), {1}, {4});
+  subgraph_test_util::CheckIntTensor(
+      interpreter_->tensor(interpreter_->outputs()[1]), {1}, {10});
+}
+
+TEST_F(SharedArenaControlFlowTest, TestWhileLoopSurvivesReleaseAndReacquire) {
+  AddSubgraphs(2);
+  builder_->BuildLessEqualCondSubgraph(interpreter_->subgraph(1), 3);
+  builder_->BuildAccumulateLoopBodySubgraph(interpreter_->subgraph(2));
+  builder_->BuildWhileSubgraph(&interpreter_->primary_subgraph());
+
+  InterpreterOptions options;
+  options.SetShareArenaAcrossSubgraphs(true);
+  ASSERT_EQ(interpreter_->ApplyOptions(&options), kTfLiteOk);
+
+  ASSERT_EQ(interpreter_->ResizeInputTensor(interpreter_->inputs()[0], {1}),
+            kTfLiteOk);
+  ASSERT_EQ(interpreter_->ResizeInputTensor(interpreter_->inputs()[1], {1}),
+            kTfLiteOk);
+  ASSERT_EQ(interpreter_->AllocateTensors(), kTfLiteOk);
+
+  ASSERT_EQ(interpreter_->ReleaseNonPersistentMemory(), kTfLiteOk);
+  ASSERT_EQ(interpreter_->AllocateTensors(), kTfLiteOk);
+  subgraph_test_util::FillIntTensor(
+      interpreter_->tensor(interpreter_->inputs()[0]), {1});
+  subgraph_test_util::FillIntTensor(
+      interpreter_->tensor(interpreter_->inputs()[1]), {1});
+  ASSERT_EQ(interpreter_->Invoke(), kTfLiteOk);
+  subgraph_test_util::CheckIntTensor(
+      interpreter_->tensor(interpreter_->outputs()[0]), {1}, {4});
+  subgraph_test_util::CheckIntTensor(
+      interpreter_->tensor(interpreter_->outputs()[1]), {1}, {10});
+}
+
 }  // namespace
 }  // namespace tflite
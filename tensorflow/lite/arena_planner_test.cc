@@ -18,9 +18,11 @@ limitations under the License.
 #include <cstdarg>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <initializer_list>
 #include <memory>
 #include <set>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -29,6 +31,7 @@ limitations under the License.
 #include "tensorflow/lite/builtin_ops.h"
 #include "tensorflow/lite/core/c/common.h"
 #include "tensorflow/lite/graph_info.h"
+#include "tensorflow/lite/subgraph_arena_group.h"
 #include "tensorflow/lite/testing/util.h"
 
 namespace tflite {
@@ -1085,5 +1088,149 @@ TEST_F(ArenaPlannerTest, SimpleProfilerTest) {
   EXPECT_EQ(gNumDealloc, 2);
 }
 
+TEST_F(ArenaPlannerTest, PlanSnapshotRoundTrip) {
+  TestGraph graph({0, 1},
+                  {
+                      /* in, out, tmp */
+                      {{0, 1}, {2}, {}},     // First op
+                      {{2, 0}, {4, 5}, {}},  // Second op
+                      {{4, 5}, {3}, {}}      // Third op
+                  },
+                  {3});
+  SetGraph(&graph);
+  Execute(0, graph.nodes().size() - 1);
+  std::string snapshot;
+  ASSERT_EQ(planner_->GetPlanSnapshot(&snapshot), kTfLiteOk);
+  EXPECT_FALSE(snapshot.empty());
+  std::vector<std::ptrdiff_t> offsets;
+  for (int i = 0; i <= 5; ++i) {
+    offsets.push_back(GetOffset(i));
+  }
+
+  // A fresh planner restores the serialized plan instead of repacking.
+  TestGraph restored_graph({0, 1},
+                           {
+                               /* in, out, tmp */
+                               {{0, 1}, {2}, {}},     // First op
+                               {{2, 0}, {4, 5}, {}},  // Second op
+                               {{4, 5}, {3}, {}}      // Third op
+                           },
+                           {3});
+  SetGraph(&restored_graph);
+  ASSERT_EQ(planner_->SetPlanSnapshot(snapshot), kTfLiteOk);
+  Execute(0, restored_graph.nodes().size() - 1);
+  for (int i = 0; i <= 5; ++i) {
+    EXPECT_EQ(GetOffset(i), offsets[i]);
+  }
+}
+
+TEST_F(ArenaPlannerTest, PlanSnapshotDiscardedWhenTensorSizeChanges) {
+  TestGraph graph({0, 1},
+                  {
+                      /* in, out, tmp */
+                      {{0, 1}, {2}, {}},     // First op
+                      {{2, 0}, {4, 5}, {}},  // Second op
+                      {{4, 5}, {3}, {}}      // Third op
+                  },
+                  {3});
+  SetGraph(&graph);
+  Execute(0, graph.nodes().size() - 1);
+  std::string snapshot;
+  ASSERT_EQ(planner_->GetPlanSnapshot(&snapshot), kTfLiteOk);
+
+  // The same graph with a grown intermediate tensor no longer matches the
+  // snapshot; planning must fall back to a regular pass and still allocate
+  // every tensor.
+  TestGraph resized_graph({0, 1},
+                          {
+                              /* in, out, tmp */
+                              {{0, 1}, {2}, {}},     // First op
+                              {{2, 0}, {4, 5}, {}},  // Second op
+                              {{4, 5}, {3}, {}}      // Third op
+                          },
+                          {3});
+  (*resized_graph.tensors())[2].bytes = 64;
+  SetGraph(&resized_graph);
+  ASSERT_EQ(planner_->SetPlanSnapshot(snapshot), kTfLiteOk);
+  Execute(0, resized_graph.nodes().size() - 1);
+  for (int i = 0; i <= 5; ++i) {
+    EXPECT_FALSE(IsUnallocated(i));
+  }
+}
+
+TEST_F(ArenaPlannerTest, MalformedPlanSnapshotIsRejected) {
+  TestGraph graph({1}, {{{1}, {2}, {}}}, {2});
+  SetGraph(&graph);
+  EXPECT_EQ(planner_->SetPlanSnapshot("not a plan snapshot"), kTfLiteError);
+  EXPECT_EQ(planner_->SetPlanSnapshot(""), kTfLiteError);
+  Execute(0, graph.nodes().size() - 1);
+}
+
+TEST(SubgraphArenaGroupTest, SubgraphWithoutCallerSitsAtBufferStart) {
+  SubgraphArenaGroup group;
+  EXPECT_FALSE(group.HasCaller(1));
+  EXPECT_EQ(group.BaseOffset(0), 0);
+  EXPECT_EQ(group.BaseOffset(1), 0);
+}
+
+TEST(SubgraphArenaGroupTest, CalleeStacksAboveCaller) {
+  SubgraphArenaGroup group;
+  group.AddCaller(/*callee=*/1, /*caller=*/0);
+  group.SetRegionSize(0, 100);
+  EXPECT_TRUE(group.HasCaller(1));
+  EXPECT_EQ(group.BaseOffset(0), 0);
+  // The caller's region size is aligned up before the callee is stacked on
+  // top of it.
+  EXPECT_EQ(group.BaseOffset(1), 128);
+}
+
+TEST(SubgraphArenaGroupTest, MutuallyExclusiveCalleesShareOneRegion) {
+  SubgraphArenaGroup group;
+  // Subgraphs 1 and 2 are e.g. the two branches of an IF op: they can never
+  // be live at the same time and must receive the same base offset.
+  group.AddCaller(/*callee=*/1, /*caller=*/0);
+  group.AddCaller(/*callee=*/2, /*caller=*/0);
+  group.SetRegionSize(0, 64);
+  EXPECT_EQ(group.BaseOffset(1), 64);
+  EXPECT_EQ(group.BaseOffset(2), 64);
+}
+
+TEST(SubgraphArenaGroupTest, MultipleCallersTakeDeepestChain) {
+  SubgraphArenaGroup group;
+  // Subgraph 2 is invoked both directly from the primary subgraph and from
+  // subgraph 1; it must clear the deepest chain of live callers.
+  group.AddCaller(/*callee=*/1, /*caller=*/0);
+  group.AddCaller(/*callee=*/2, /*caller=*/0);
+  group.AddCaller(/*callee=*/2, /*caller=*/1);
+  group.SetRegionSize(0, 64);
+  group.SetRegionSize(1, 64);
+  EXPECT_EQ(group.BaseOffset(1), 64);
+  EXPECT_EQ(group.BaseOffset(2), 128);
+  // Releasing subgraph 1's region removes it from the chain.
+  group.SetRegionSize(1, 0);
+  EXPECT_EQ(group.BaseOffset(2), 64);
+}
+
+TEST(SubgraphArenaGroupTest, BufferGrowthMovesContentsAndBumpsGeneration) {
+  SubgraphArenaGroup group;
+  bool reallocated = false;
+  ASSERT_EQ(group.EnsureBufferSize(nullptr, 128, &reallocated), kTfLiteOk);
+  EXPECT_TRUE(reallocated);
+  EXPECT_GE(group.buffer_size(), 128);
+  const int64_t first_generation = group.generation();
+  std::memset(group.buffer(), 0xAB, 128);
+  // A smaller request must not reallocate.
+  ASSERT_EQ(group.EnsureBufferSize(nullptr, 64, &reallocated), kTfLiteOk);
+  EXPECT_FALSE(reallocated);
+  EXPECT_EQ(group.generation(), first_generation);
+  // Growth carries the old contents over and bumps the generation.
+  ASSERT_EQ(group.EnsureBufferSize(nullptr, 4096, &reallocated), kTfLiteOk);
+  EXPECT_TRUE(reallocated);
+  EXPECT_EQ(group.generation(), first_generation + 1);
+  for (int i = 0; i < 128; ++i) {
+    EXPECT_EQ(static_cast<unsigned char>(group.buffer()[i]), 0xAB);
+  }
+}
+
 }  // namespace
 }  // namespace tflite
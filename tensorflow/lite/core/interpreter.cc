@@ -37,6 +37,7 @@ limitations under the License.
 #include "tensorflow/lite/minimal_logging.h"
 #include "tensorflow/lite/profiling/telemetry/telemetry.h"
 #include "tensorflow/lite/stderr_reporter.h"
+#include "tensorflow/lite/subgraph_arena_group.h"
 #include "tensorflow/lite/util.h"
 
 // TODO(b/139446230): Move to portable platform header.
@@ -500,6 +501,16 @@ TfLiteStatus Interpreter::ApplyOptionsImpl(InterpreterOptions* options) {
           options->GetDynamicAllocationForLargeTensors());
     }
   }
+
+  // Handle `experimental_share_arena_across_subgraphs_`.
+  if (options->GetShareArenaAcrossSubgraphs()) {
+    if (subgraph_arena_group_ == nullptr) {
+      subgraph_arena_group_ = std::make_unique<SubgraphArenaGroup>();
+    }
+    for (auto& subgraph : subgraphs_) {
+      subgraph->SetSubgraphArenaGroup(subgraph_arena_group_.get());
+    }
+  }
   return kTfLiteOk;
 }
 
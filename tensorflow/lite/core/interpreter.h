@@ -490,6 +490,23 @@ class Interpreter {
   /// invocation.
   TfLiteStatus ReleaseNonPersistentMemory();
 
+  /// \warning Experimental interface, subject to change. \n
+  /// \brief Serializes the memory plans of all subgraphs into `output` so
+  /// that a later process running the same model can warm-start via
+  /// SetMemoryPlanSnapshot() and skip memory planning. Only valid after
+  /// AllocateTensors(). Callers should key the stored artifact by a
+  /// fingerprint of the model (e.g. delegates::StrFingerprint()); a snapshot
+  /// that no longer matches the model is discarded at apply time.
+  TfLiteStatus GetMemoryPlanSnapshot(std::string* output);
+
+  /// \warning Experimental interface, subject to change. \n
+  /// \brief Stages memory plans previously serialized by
+  /// GetMemoryPlanSnapshot(). Must be called before AllocateTensors().
+  /// Returns kTfLiteError if the snapshot is malformed; a well-formed
+  /// snapshot that no longer matches the model is validated and discarded
+  /// during AllocateTensors(), which then plans from scratch.
+  TfLiteStatus SetMemoryPlanSnapshot(const std::string& snapshot);
+
   /// Update allocations for all tensors. This will redim dependent tensors
   /// using the input tensor dimensionality as given. This is relatively
   /// expensive. This *must be* called after the interpreter has been created
@@ -933,6 +950,12 @@ class Interpreter {
   // nullptr if necessary.
   std::unique_ptr<ExternalCpuBackendContext> own_external_cpu_backend_context_;
 
+  // Lays the non-persistent arenas of all subgraphs out in one shared
+  // buffer. Only created when the corresponding `InterpreterOptions` feature
+  // is enabled. Declared before `subgraphs_` because subgraphs deregister
+  // from it on destruction.
+  std::unique_ptr<SubgraphArenaGroup> subgraph_arena_group_;
+
   // Subgraphs
   std::vector<std::unique_ptr<Subgraph>> subgraphs_;
 
@@ -17,8 +17,10 @@ limitations under the License.
 #include <stdlib.h>
 
 #include <cstdint>
+#include <cstring>
 #include <functional>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -56,6 +58,54 @@ TfLiteStatus Interpreter::ReleaseNonPersistentMemory() {
   return primary_subgraph().ReleaseNonPersistentMemory();
 }
 
+TfLiteStatus Interpreter::GetMemoryPlanSnapshot(std::string* output) {
+  if (output == nullptr) return kTfLiteError;
+  output->clear();
+  // Frame the per-subgraph plans with a count so that a snapshot taken from
+  // a different model (or model version) with another subgraph layout is
+  // rejected up front.
+  const uint32_t num_subgraphs = static_cast<uint32_t>(subgraphs_.size());
+  output->append(reinterpret_cast<const char*>(&num_subgraphs),
+                 sizeof(num_subgraphs));
+  for (auto& subgraph : subgraphs_) {
+    std::string subgraph_snapshot;
+    TF_LITE_ENSURE_STATUS(
+        subgraph->GetMemoryPlanSnapshot(&subgraph_snapshot));
+    const uint64_t size = static_cast<uint64_t>(subgraph_snapshot.size());
+    output->append(reinterpret_cast<const char*>(&size), sizeof(size));
+    output->append(subgraph_snapshot);
+  }
+  return kTfLiteOk;
+}
+
+TfLiteStatus Interpreter::SetMemoryPlanSnapshot(const std::string& snapshot) {
+  const char* pos = snapshot.data();
+  const char* end = pos + snapshot.size();
+  uint32_t num_subgraphs = 0;
+  if (end - pos < static_cast<ptrdiff_t>(sizeof(num_subgraphs))) {
+    return kTfLiteError;
+  }
+  memcpy(&num_subgraphs, pos, sizeof(num_subgraphs));
+  pos += sizeof(num_subgraphs);
+  if (num_subgraphs != subgraphs_.size()) {
+    return kTfLiteError;
+  }
+  for (auto& subgraph : subgraphs_) {
+    uint64_t size = 0;
+    if (end - pos < static_cast<ptrdiff_t>(sizeof(size))) {
+      return kTfLiteError;
+    }
+    memcpy(&size, pos, sizeof(size));
+    pos += sizeof(size);
+    if (static_cast<uint64_t>(end - pos) < size) {
+      return kTfLiteError;
+    }
+    subgraph->SetMemoryPlanSnapshot(std::string(pos, size));
+    pos += size;
+  }
+  return pos == end ? kTfLiteOk : kTfLiteError;
+}
+
 TfLiteStatus Interpreter::ResetVariableTensors() {
   for (auto& subgraph : subgraphs_) {
     TF_LITE_ENSURE_STATUS(subgraph->ResetVariableTensors());
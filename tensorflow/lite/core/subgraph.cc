@@ -37,6 +37,7 @@ limitations under the License.
 #include "tensorflow/lite/core/api/op_resolver.h"
 #include "tensorflow/lite/core/api/profiler.h"
 #include "tensorflow/lite/core/api/tensor_utils.h"
+#include "tensorflow/lite/core/c/builtin_op_data.h"
 #include "tensorflow/lite/core/c/c_api_types.h"
 #include "tensorflow/lite/core/c/common.h"
 #include "tensorflow/lite/experimental/resource/resource_base.h"
@@ -45,6 +46,7 @@ limitations under the License.
 #include "tensorflow/lite/minimal_logging.h"
 #include "tensorflow/lite/profiling/telemetry/telemetry.h"
 #include "tensorflow/lite/schema/schema_generated.h"
+#include "tensorflow/lite/subgraph_arena_group.h"
 #include "tensorflow/lite/util.h"
 #ifdef TFLITE_USE_SIMPLE_MEMORY_PLANNER
 #include "tensorflow/lite/simple_planner.h"
@@ -963,6 +965,49 @@ std::vector<int> Subgraph::GetInputTensorsCount() {
   return input_tensors_count;
 }
 
+void Subgraph::RegisterSubgraphCallers() {
+  if (subgraph_arena_group_ == nullptr) return;
+  for (const auto& node_and_reg : nodes_and_registration_) {
+    const void* builtin_data = node_and_reg.first.builtin_data;
+    if (builtin_data == nullptr) continue;
+    switch (node_and_reg.second.builtin_code) {
+      case kTfLiteBuiltinWhile: {
+        const auto* params =
+            static_cast<const TfLiteWhileParams*>(builtin_data);
+        subgraph_arena_group_->AddCaller(params->cond_subgraph_index,
+                                         subgraph_index_);
+        subgraph_arena_group_->AddCaller(params->body_subgraph_index,
+                                         subgraph_index_);
+        break;
+      }
+      case kTfLiteBuiltinIf: {
+        const auto* params = static_cast<const TfLiteIfParams*>(builtin_data);
+        subgraph_arena_group_->AddCaller(params->then_subgraph_index,
+                                         subgraph_index_);
+        subgraph_arena_group_->AddCaller(params->else_subgraph_index,
+                                         subgraph_index_);
+        break;
+      }
+      case kTfLiteBuiltinCallOnce: {
+        const auto* params =
+            static_cast<const TfLiteCallOnceParams*>(builtin_data);
+        subgraph_arena_group_->AddCaller(params->init_subgraph_index,
+                                         subgraph_index_);
+        break;
+      }
+      case kTfLiteBuiltinStablehloScatter: {
+        const auto* params =
+            static_cast<const TfLiteStablehloScatterParams*>(builtin_data);
+        subgraph_arena_group_->AddCaller(
+            params->update_computation_subgraph_index, subgraph_index_);
+        break;
+      }
+      default:
+        break;
+    }
+  }
+}
+
 TfLiteStatus Subgraph::AllocateTensors() {
   if (!consistent_) {
     ReportError("AllocateTensors() called on inconsistent model.");
@@ -972,6 +1017,10 @@ TfLiteStatus Subgraph::AllocateTensors() {
   // Restore delegation state if applicable.
   TF_LITE_ENSURE_STATUS(RedoAllDelegates());
 
+  // With a shared subgraph arena, the subgraphs invoked from this one must
+  // be known before they plan their own memory.
+  RegisterSubgraphCallers();
+
   // The runtime doesn't need to adjust any allocations if the state is
   // invokable & no inputs are dynamic (which implies memory plan is unchanged).
   const bool no_reallocations_necessary =
@@ -982,6 +1031,13 @@ TfLiteStatus Subgraph::AllocateTensors() {
     if (memory_planner_ && !memory_planner_->HasNonPersistentMemory()) {
       memory_planner_->AcquireNonPersistentMemory();
     }
+    // Re-resolve tensor pointers whose backing buffer has moved, e.g.
+    // because another subgraph grew a shared arena. Control flow kernels
+    // call AllocateTensors() on their subgraphs before filling their inputs,
+    // so this runs before any data is written through stale pointers.
+    if (memory_planner_) {
+      TF_LITE_ENSURE_STATUS(memory_planner_->RefreshTensorAllocations());
+    }
     // Check custom allocations, which may have been modified since last
     // AllocateTensors() call.
     if (!custom_allocations_.empty()) {
@@ -1521,11 +1577,22 @@ TfLiteStatus Subgraph::PrepareOpsAndTensors() {
 #ifdef TFLITE_USE_SIMPLE_MEMORY_PLANNER
     memory_planner_.reset(new SimplePlanner(&context_, CreateGraphInfo()));
 #else
-    memory_planner_ = std::make_unique<ArenaPlanner>(
+    auto arena_planner = std::make_unique<ArenaPlanner>(
         &context_, CreateGraphInfo(), ShouldPreserveAllTensors(),
         kDefaultTensorAlignment, subgraph_index_);
+    if (subgraph_arena_group_ != nullptr) {
+      arena_planner->SetSubgraphArenaGroup(subgraph_arena_group_);
+    }
+    memory_planner_ = std::move(arena_planner);
 #endif
     memory_planner_->PlanAllocations();
+    if (!pending_plan_snapshot_.empty()) {
+      // A failure to stage the snapshot -- because it is malformed or the
+      // planner does not support snapshots -- just means the plan is
+      // computed from scratch.
+      memory_planner_->SetPlanSnapshot(pending_plan_snapshot_);
+      pending_plan_snapshot_.clear();
+    }
   }
 
   // Execute arena allocations.
@@ -1596,6 +1663,11 @@ TfLiteStatus Subgraph::InvokeImpl() {
     ReportError("Non-persistent memory is not available.");
     return kTfLiteError;
   }
+  // Re-resolve tensor pointers whose backing buffer has moved since the last
+  // invocation, e.g. because another subgraph grew a shared arena.
+  if (memory_planner_) {
+    TF_LITE_ENSURE_STATUS(memory_planner_->RefreshTensorAllocations());
+  }
   TFLITE_SCOPED_TAGGED_DEFAULT_PROFILE(profiler_.get(), "Invoke");
 #ifdef TF_LITE_TENSORFLOW_PROFILER
   tensorflow::profiler::TraceMe* trace_subgraph =
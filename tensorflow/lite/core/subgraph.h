@@ -43,6 +43,8 @@ limitations under the License.
 
 namespace tflite {
 
+class SubgraphArenaGroup;
+
 #ifndef DOXYGEN_SKIP
 class SingleOpModel;  // Class for friend declarations.
 
@@ -424,6 +426,32 @@ class Subgraph {
   // Set the given `InterpreterOptions` object.
   void SetOptions(InterpreterOptions* options) { options_ = options; }
 
+  // WARNING: This is an experimental API and subject to change.
+  // Sets the group that lays the non-persistent arenas of all subgraphs of
+  // the model out in one shared buffer. Must be called before
+  // AllocateTensors(). The group is owned by the interpreter.
+  void SetSubgraphArenaGroup(SubgraphArenaGroup* group) {
+    subgraph_arena_group_ = group;
+  }
+
+  // WARNING: This is an experimental API and subject to change.
+  // Serializes the memory planner's allocation plan into `output`. Only
+  // valid after AllocateTensors(). Returns kTfLiteError if the planner does
+  // not support plan snapshots.
+  TfLiteStatus GetMemoryPlanSnapshot(std::string* output) {
+    if (memory_planner_ == nullptr) return kTfLiteError;
+    return memory_planner_->GetPlanSnapshot(output);
+  }
+
+  // WARNING: This is an experimental API and subject to change.
+  // Stages a plan previously serialized by GetMemoryPlanSnapshot() so that
+  // the next AllocateTensors() can skip recomputing tensor offsets. Must be
+  // called before AllocateTensors(). A snapshot that no longer matches the
+  // graph is discarded and the plan is computed from scratch.
+  void SetMemoryPlanSnapshot(std::string snapshot) {
+    pending_plan_snapshot_ = std::move(snapshot);
+  }
+
   // WARNING: This is an experimental API and subject to change.
   // True if all intermediates tensors should be preserved for debugging.
   bool ShouldPreserveAllTensors() const {
@@ -656,6 +684,12 @@ class Subgraph {
   // to wait until Invoke() to resolve the sizes of dynamic tensors.
   TfLiteStatus PrepareOpsAndTensors();
 
+  // Records on the shared subgraph arena group which subgraphs the control
+  // flow ops of this subgraph invoke. Must run before those subgraphs plan
+  // their own memory so that they are stacked above this subgraph's arena
+  // region. No-op when no group is set.
+  void RegisterSubgraphCallers();
+
   // Call OpPrepare() for all ops starting at 'first_node'. Stop when a
   // dynamic tensors is found or all ops have been prepared. Fill
   // 'last_node_prepared' with the id of the op containing dynamic tensors, or
@@ -1107,6 +1141,14 @@ class Subgraph {
   // `InterpreterOptions` object which is being used and owned by Interpreter.
   InterpreterOptions* options_;
 
+  // When non-null, the non-persistent memory arenas of all subgraphs of the
+  // model are laid out in this shared buffer. Owned by the interpreter.
+  SubgraphArenaGroup* subgraph_arena_group_ = nullptr;
+
+  // Serialized memory plan staged by SetMemoryPlanSnapshot(), handed to the
+  // memory planner when it is created.
+  std::string pending_plan_snapshot_;
+
   // Control edges (i.e., dependencies between nodes in addition to their data
   // dependencies); can be nullptr. Will be initialized from metadata associated
   // with the owning interpreter; the pointee is owned by the owning
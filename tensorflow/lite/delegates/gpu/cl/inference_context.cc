@@ -51,6 +51,12 @@ namespace tflite {
 namespace gpu {
 namespace cl {
 
+InferenceContext::~InferenceContext() {
+  if (command_buffer_) {
+    clReleaseCommandBufferKHR(command_buffer_);
+  }
+}
+
 namespace {
 void AddUsage(ValueId id, int task_index,
               std::map<ValueId, int2>* usage_records) {
@@ -307,6 +313,9 @@ absl::Status InferenceContext::InitFromGpuModel(
   if (external_mutable_tensors_.empty()) {
     // using recordable queue only when no mutable external tensors
     InitRecordableQueue(env);
+    if (!recordable_queue_ || !recordable_queue_->IsSupported()) {
+      InitCommandBuffer(env);
+    }
   }
 
   for (auto& external_tensor : external_mutable_tensors_) {
@@ -401,6 +410,9 @@ absl::Status InferenceContext::RestoreDeserialized(
   if (external_mutable_tensors_.empty()) {
     // using recordable queue only when no mutable external tensors
     InitRecordableQueue(env);
+    if (!recordable_queue_ || !recordable_queue_->IsSupported()) {
+      InitCommandBuffer(env);
+    }
   }
   for (auto& external_tensor : external_mutable_tensors_) {
     external_tensor.second = nullptr;
@@ -432,6 +444,31 @@ void InferenceContext::InitRecordableQueue(Environment* env) {
   recordable_queue_ = CreateRecordableQueue(ops, env->device(), env->context());
 }
 
+void InferenceContext::InitCommandBuffer(Environment* env) {
+  if (!env->device().GetInfo().SupportsExtension("cl_khr_command_buffer")) {
+    return;
+  }
+  if (execution_hints_.need_manual_release) {
+    // The manual release trick enqueues an event per run; keep the regular
+    // per-kernel path on devices that need it.
+    return;
+  }
+  cl_command_queue command_queue = env->queue()->queue();
+  cl_int errcode_ret;
+  cl_command_buffer_khr cb =
+      clCreateCommandBufferKHR(1, &command_queue, nullptr, &errcode_ret);
+  if (errcode_ret != CL_SUCCESS) {
+    return;
+  }
+  const absl::Status status = AddToCommanBuffer(cb);
+  if (!status.ok() || clFinalizeCommandBufferKHR(cb) != CL_SUCCESS) {
+    clReleaseCommandBufferKHR(cb);
+    return;
+  }
+  command_buffer_ = cb;
+  command_buffer_queue_ = command_queue;
+}
+
 absl::Status InferenceContext::InitFromGraphWithTransforms(
     const CreateGpuModelInfo& create_info, GraphFloat32* graph,
     Environment* env, std::vector<uint8_t>* serialized_model) {
@@ -789,6 +826,19 @@ absl::Status InferenceContext::AddToQueue(CLCommandQueue* queue) {
   if (recordable_queue_ && recordable_queue_->IsSupported()) {
     return recordable_queue_->Execute(queue);
   }
+  if (command_buffer_ && queue->queue() == command_buffer_queue_) {
+    const cl_int error_code = clEnqueueCommandBufferKHR(
+        0, nullptr, command_buffer_, 0, nullptr, nullptr);
+    if (error_code != CL_SUCCESS) {
+      return absl::UnknownError(
+          "Failed to clEnqueueCommandBufferKHR: error code " +
+          std::to_string(error_code));
+    }
+    if (execution_hints_.need_flush) {
+      clFlush(queue->queue());
+    }
+    return absl::OkStatus();
+  }
   if (execution_hints_.need_manual_release) {
     if (execution_hints_.prev_enqueue_start_point.is_valid()) {
       execution_hints_.prev_enqueue_start_point.Wait();
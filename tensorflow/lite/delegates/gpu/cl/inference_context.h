@@ -65,6 +65,9 @@ enum class TensorType { kVariable, kConst, kExternal, kRuntime };
 
 class InferenceContext {
  public:
+  InferenceContext() = default;
+  ~InferenceContext();
+
   absl::Status InitFromGraph(const CreateGpuModelInfo& create_info,
                              const GraphFloat32& graph, Environment* env,
                              std::vector<uint8_t>* serialized_model = nullptr);
@@ -147,6 +150,12 @@ class InferenceContext {
 
   void InitRecordableQueue(Environment* env);
 
+  // Records the whole inference into a persistent cl_khr_command_buffer so
+  // that AddToQueue can resubmit it instead of re-enqueueing every kernel.
+  // No-op when the extension is unsupported or recording fails; AddToQueue
+  // then falls back to per-kernel enqueues.
+  void InitCommandBuffer(Environment* env);
+
   absl::Status ProfileTime(ProfilingCommandQueue* queue, ProfilingInfo* result);
 
   struct ExecutionHints {
@@ -197,6 +206,12 @@ class InferenceContext {
 
   std::unique_ptr<RecordableQueue> recordable_queue_ = nullptr;
 
+  // Inference recorded once as a cl_khr_command_buffer, together with the
+  // queue it was recorded against. Only created when there are no external
+  // mutable tensors, so the bindings frozen at record time stay valid.
+  cl_command_buffer_khr command_buffer_ = nullptr;
+  cl_command_queue command_buffer_queue_ = nullptr;
+
   GpuInfo gpu_info_;
 };
 
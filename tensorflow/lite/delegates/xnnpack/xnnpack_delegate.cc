@@ -24,12 +24,15 @@ limitations under the License.
 #include <limits>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
 
+#include <farmhash.h>
+
 #include "experiments-config.h"  // from @XNNPACK
 #include "xnnpack.h"  // from @XNNPACK
 #include "tensorflow/lite/builtin_ops.h"
@@ -6746,6 +6749,56 @@ TfLiteStatus DelegatePrepare(TfLiteContext* context, TfLiteDelegate* delegate) {
   return status;
 }
 
+// Process-wide registry of weights caches shared across delegate instances,
+// keyed by a fingerprint of the model contents. Reference-counted so the
+// packed weights for a model stay alive exactly as long as some interpreter
+// instance still uses them.
+class SharedWeightsCacheRegistry {
+ public:
+  static SharedWeightsCacheRegistry& GetInstance() {
+    static SharedWeightsCacheRegistry* registry =
+        new SharedWeightsCacheRegistry();
+    return *registry;
+  }
+
+  xnn_weights_cache_t Acquire(uint64_t fingerprint) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = caches_.find(fingerprint);
+    if (it != caches_.end()) {
+      ++it->second.ref_count;
+      return it->second.cache;
+    }
+    xnn_weights_cache_t cache = nullptr;
+    if (xnn_create_weights_cache(&cache) != xnn_status_success) {
+      return nullptr;
+    }
+    caches_.emplace(fingerprint, Entry{cache, /*ref_count=*/1});
+    return cache;
+  }
+
+  void Release(xnn_weights_cache_t cache) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto it = caches_.begin(); it != caches_.end(); ++it) {
+      if (it->second.cache == cache) {
+        if (--it->second.ref_count == 0) {
+          xnn_delete_weights_cache(cache);
+          caches_.erase(it);
+        }
+        return;
+      }
+    }
+  }
+
+ private:
+  struct Entry {
+    xnn_weights_cache_t cache;
+    int ref_count;
+  };
+
+  std::mutex mutex_;
+  std::unordered_map<uint64_t, Entry> caches_;
+};
+
 }  // namespace
 }  // namespace xnnpack
 }  // namespace tflite
@@ -6804,6 +6857,38 @@ void TfLiteXNNPackDelegateWeightsCacheDelete(
   xnn_deinitialize();
 }
 
+TfLiteXNNPackDelegateWeightsCache* TfLiteXNNPackDelegateWeightsCacheAcquire(
+    const void* model_data, size_t model_size) {
+  if (model_data == nullptr || model_size == 0) {
+    return nullptr;
+  }
+  xnn_status status = xnn_initialize(/*allocator=*/nullptr);
+  if (status != xnn_status_success) {
+    return nullptr;
+  }
+
+  const uint64_t fingerprint = ::util::Fingerprint64(
+      reinterpret_cast<const char*>(model_data), model_size);
+  xnn_weights_cache_t weights_cache =
+      tflite::xnnpack::SharedWeightsCacheRegistry::GetInstance().Acquire(
+          fingerprint);
+  if (weights_cache == nullptr) {
+    xnn_deinitialize();
+    return nullptr;
+  }
+  return reinterpret_cast<TfLiteXNNPackDelegateWeightsCache*>(weights_cache);
+}
+
+void TfLiteXNNPackDelegateWeightsCacheRelease(
+    TfLiteXNNPackDelegateWeightsCache* cache) {
+  if (cache == nullptr) {
+    return;
+  }
+  tflite::xnnpack::SharedWeightsCacheRegistry::GetInstance().Release(
+      reinterpret_cast<xnn_weights_cache_t>(cache));
+  xnn_deinitialize();
+}
+
 TfLiteXNNPackDelegateOptions TfLiteXNNPackDelegateOptionsDefault() {
   TfLiteXNNPackDelegateOptions options = {0};
 
@@ -133,6 +133,28 @@ TFL_CAPI_EXPORT bool TfLiteXNNPackDelegateWeightsCacheFinalizeHard(
 TFL_CAPI_EXPORT void TfLiteXNNPackDelegateWeightsCacheDelete(
     struct TfLiteXNNPackDelegateWeightsCache* cache);
 
+// Acquires a process-wide weights cache keyed by a fingerprint of the model
+// contents. All delegate instances created for the same model share a single
+// cache of packed weights instead of repacking per instance, e.g. when an
+// application creates one interpreter per thread for the same model. The
+// first acquisition for a given model creates the cache; subsequent
+// acquisitions, including from other threads, return the same cache and
+// increment its reference count. The caller is still responsible for
+// finalizing the cache (prefer
+// `TfLiteXNNPackDelegateWeightsCacheFinalizeSoft` so that instances created
+// later can insert packed weights on a cache miss).
+// Returns NULL on error.
+TFL_CAPI_EXPORT struct TfLiteXNNPackDelegateWeightsCache*
+TfLiteXNNPackDelegateWeightsCacheAcquire(const void* model_data,
+                                         size_t model_size);
+// Releases a weights cache obtained from
+// `TfLiteXNNPackDelegateWeightsCacheAcquire`. The cache is destroyed when the
+// last reference to it is released. Caches created with
+// `TfLiteXNNPackDelegateWeightsCacheCreate` must be destroyed with
+// `TfLiteXNNPackDelegateWeightsCacheDelete` instead.
+TFL_CAPI_EXPORT void TfLiteXNNPackDelegateWeightsCacheRelease(
+    struct TfLiteXNNPackDelegateWeightsCache* cache);
+
 #ifdef __cplusplus
 }
 #endif  // __cplusplus
@@ -29,7 +29,8 @@ class InterpreterOptions {
       : experimental_preserve_all_tensors_(false),
         experimental_ensure_dynamic_tensors_are_released_(false),
         experimental_optimize_memory_for_large_tensors_(0),
-        experimental_disable_delegate_clustering_(false) {}
+        experimental_disable_delegate_clustering_(false),
+        experimental_share_arena_across_subgraphs_(false) {}
 
   /// Preserving all intermediates tensors for debugging.
   /// WARNING: This is an experimental API and subject to change.
@@ -93,11 +94,30 @@ class InterpreterOptions {
     experimental_disable_delegate_clustering_ = value;
   }
 
+  /// Lay the non-persistent memory arenas of all subgraphs of the model out
+  /// in one shared buffer, stacked by subgraph invocation depth. Subgraphs
+  /// which can never be live at the same time -- such as the two branches of
+  /// an IF op, or the bodies of two WHILE ops in the same subgraph -- then
+  /// share one region of the buffer, which reduces the peak memory footprint
+  /// of control-flow-heavy models.
+  /// WARNING: This is an experimental API and subject to change.
+  void SetShareArenaAcrossSubgraphs(bool value = true) {
+    experimental_share_arena_across_subgraphs_ = value;
+  }
+
+  /// Returns if the `experimental_share_arena_across_subgraphs_` feature is
+  /// enabled.
+  /// WARNING: This is an experimental API and subject to change.
+  bool GetShareArenaAcrossSubgraphs() {
+    return experimental_share_arena_across_subgraphs_;
+  }
+
  private:
   bool experimental_preserve_all_tensors_;
   bool experimental_ensure_dynamic_tensors_are_released_;
   int experimental_optimize_memory_for_large_tensors_;
   bool experimental_disable_delegate_clustering_;
+  bool experimental_share_arena_across_subgraphs_;
 };
 
 }  // namespace tflite
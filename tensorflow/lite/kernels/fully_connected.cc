@@ -136,6 +136,11 @@ struct OpData {
   // Used for 4bit hybrid
   std::unique_ptr<optimized_4bit::OpData4Bit> op_data_4bit = nullptr;
   TfLiteType quantized_bias_type = kTfLiteNoType;
+  // Lazily-populated int8 copy of a constant int4-packed filter. Unpacking
+  // once and reusing the buffer avoids a per-invoke allocation and unpack,
+  // and gives the GEMM backend a stable weight pointer so its prepacked
+  // matrix cache stays effective across invocations.
+  std::unique_ptr<int8_t[]> unpacked_int4_weights = nullptr;
 };
 
 constexpr int kInputTensor = 0;
@@ -427,7 +432,12 @@ TfLiteStatus PrepareImpl(TfLiteContext* context, TfLiteNode* node,
       //  Currently only Int8/Int16 is supported for per channel quantization.
       TF_LITE_ENSURE(context,
                      input->type == kTfLiteInt8 || input->type == kTfLiteInt16);
-      TF_LITE_ENSURE(context, (filter->type == kTfLiteInt8));
+      // Int4-packed weights are only supported with int8 activations; the
+      //  int16 kernels consume the filter without unpacking.
+      TF_LITE_ENSURE(context,
+                     filter->type == kTfLiteInt8 ||
+                         (filter->type == kTfLiteInt4 &&
+                          input->type == kTfLiteInt8));
       TF_LITE_ENSURE_EQ(context, affine_quantization->scale->size,
                         per_channel_quantization_size);
       TF_LITE_ENSURE_EQ(
@@ -667,6 +677,32 @@ TfLiteStatus EvalPie(TfLiteContext* context, TfLiteNode* node,
   return kTfLiteOk;
 }
 
+// Returns the int8 weights to evaluate with, unpacking an int4-packed filter
+// when necessary. Constant filters are unpacked once and cached in `data`;
+// non-constant filters are unpacked into `scratch`, which must outlive the use
+// of the returned pointer.
+const int8_t* GetInt8FilterData(OpData* data, const TfLiteTensor* filter,
+                                std::unique_ptr<int8_t[]>* scratch) {
+  if (filter->type != kTfLiteInt4) {
+    return GetTensorData<int8_t>(filter);
+  }
+  const size_t bytes_unpacked = filter->bytes * 2;
+  if (IsConstantTensor(filter)) {
+    if (data->unpacked_int4_weights == nullptr) {
+      data->unpacked_int4_weights = std::make_unique<int8_t[]>(bytes_unpacked);
+      tensor_utils::UnpackDenseInt4IntoInt8(
+          GetTensorData<int8_t>(filter), GetTensorShape(filter).FlatSize(),
+          data->unpacked_int4_weights.get());
+    }
+    return data->unpacked_int4_weights.get();
+  }
+  *scratch = std::make_unique<int8_t[]>(bytes_unpacked);
+  tensor_utils::UnpackDenseInt4IntoInt8(GetTensorData<int8_t>(filter),
+                                        GetTensorShape(filter).FlatSize(),
+                                        scratch->get());
+  return scratch->get();
+}
+
 TfLiteStatus EvalHybridDense(
     TfLiteContext* context, TfLiteNode* node,
     TfLiteFullyConnectedParams* params, OpData* data, const TfLiteTensor* input,
@@ -710,18 +746,9 @@ TfLiteStatus EvalHybridDense(
     row_sums_ptr = GetTensorData<int32_t>(row_sums);
   }
   int8_t* quant_data = GetTensorData<int8_t>(input_quantized);
-  const int8_t* filter_data = nullptr;
   std::unique_ptr<int8_t[]> unpacked_filter_data = nullptr;
-  if (filter->type == kTfLiteInt4) {
-    const size_t bytes_unpacked = filter->bytes * 2;
-    unpacked_filter_data = std::make_unique<int8_t[]>(bytes_unpacked);
-    tflite::tensor_utils::UnpackDenseInt4IntoInt8(
-        GetTensorData<int8_t>(filter), GetTensorShape(filter).FlatSize(),
-        unpacked_filter_data.get());
-    filter_data = unpacked_filter_data.get();
-  } else {
-    filter_data = GetTensorData<int8_t>(filter);
-  }
+  const int8_t* filter_data =
+      GetInt8FilterData(data, filter, &unpacked_filter_data);
   const float* input_ptr = GetTensorData<float>(input);
   tensor_utils::BatchQuantizeFloats(
       input_ptr, batch_size, input_size, quant_data, scaling_factors_ptr,
@@ -1051,7 +1078,7 @@ TfLiteStatus EvalHybrid(TfLiteContext* context, TfLiteNode* node,
 
 namespace {
 template <KernelType kernel_type>
-void FullyConnectedInt8(const OpData* data, const TfLiteTensor* input,
+void FullyConnectedInt8(OpData* data, const TfLiteTensor* input,
                         const TfLiteTensor* filter, const TfLiteTensor* bias,
                         TfLiteTensor* output,
                         CpuBackendContext* cpu_backend_context) {
@@ -1066,19 +1093,9 @@ void FullyConnectedInt8(const OpData* data, const TfLiteTensor* input,
   op_params.lhs_cacheable = IsConstantTensor(filter);
   op_params.rhs_cacheable = IsConstantTensor(input);
 
-  const int8_t* filter_data;
   std::unique_ptr<int8_t[]> unpacked_filter_data = nullptr;
-
-  if (filter->type == kTfLiteInt4) {
-    const size_t bytes_unpacked = filter->bytes * 2;
-    unpacked_filter_data = std::make_unique<int8_t[]>(bytes_unpacked);
-    tflite::tensor_utils::UnpackDenseInt4IntoInt8(
-        GetTensorData<int8_t>(filter), GetTensorShape(filter).FlatSize(),
-        unpacked_filter_data.get());
-    filter_data = unpacked_filter_data.get();
-  } else {
-    filter_data = GetTensorData<int8>(filter);
-  }
+  const int8_t* filter_data =
+      GetInt8FilterData(data, filter, &unpacked_filter_data);
 
   if (kernel_type == kReference) {
     reference_integer_ops::FullyConnected(
@@ -1124,7 +1141,7 @@ void FullyConnectedInt16(const OpData* data, const TfLiteTensor* input,
 }
 
 template <KernelType kernel_type>
-void FullyConnectedPerChannelInt8(const OpData* data, const TfLiteTensor* input,
+void FullyConnectedPerChannelInt8(OpData* data, const TfLiteTensor* input,
                                   const TfLiteTensor* filter,
                                   const TfLiteTensor* bias,
                                   TfLiteTensor* output,
@@ -1139,22 +1156,26 @@ void FullyConnectedPerChannelInt8(const OpData* data, const TfLiteTensor* input,
   op_params.quantized_activation_max = data->output_activation_max;
   op_params.lhs_cacheable = IsConstantTensor(filter);
   op_params.rhs_cacheable = IsConstantTensor(input);
+
+  std::unique_ptr<int8_t[]> unpacked_filter_data = nullptr;
+  const int8_t* filter_data =
+      GetInt8FilterData(data, filter, &unpacked_filter_data);
+
   if (kernel_type == kReference) {
     reference_integer_ops::FullyConnectedPerChannel(
         op_params, data->per_channel_output_multiplier.data(),
         data->per_channel_output_shift.data(), GetTensorShape(input),
-        GetTensorData<int8_t>(input), GetTensorShape(filter),
-        GetTensorData<int8_t>(filter), GetTensorShape(bias),
-        GetTensorData<int32_t>(bias), GetTensorShape(output),
-        GetTensorData<int8_t>(output));
+        GetTensorData<int8_t>(input), GetTensorShape(filter), filter_data,
+        GetTensorShape(bias), GetTensorData<int32_t>(bias),
+        GetTensorShape(output), GetTensorData<int8_t>(output));
   } else {
     optimized_integer_ops::FullyConnectedPerChannel(
         op_params, data->per_channel_output_multiplier.data(),
         data->per_channel_output_shift.data(), GetTensorShape(input),
-        GetTensorData<int8_t>(input), GetTensorShape(filter),
-        GetTensorData<int8_t>(filter), GetTensorShape(bias),
-        GetTensorData<int32_t>(bias), GetTensorShape(output),
-        GetTensorData<int8_t>(output), cpu_backend_context);
+        GetTensorData<int8_t>(input), GetTensorShape(filter), filter_data,
+        GetTensorShape(bias), GetTensorData<int32_t>(bias),
+        GetTensorShape(output), GetTensorData<int8_t>(output),
+        cpu_backend_context);
   }
 }
 
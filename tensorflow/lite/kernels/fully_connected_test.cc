@@ -174,7 +174,9 @@ class BaseFullyConnectedOpModel : public SingleOpModel {
                              per_channel_quantization_offsets,
                              0});
       } else {
-        weights_ = AddInput({input.type,
+        const TensorType weights_type =
+            filter_type == kTfLiteInt4 ? TensorType_INT4 : input.type;
+        weights_ = AddInput({weights_type,
                              {units_, input_size_},
                              0,
                              0,
@@ -375,12 +377,13 @@ class PerChannelQuantizedFullyConnectedOpModel
       ActivationFunctionType activation_func = ActivationFunctionType_RELU,
       FullyConnectedOptionsWeightsFormat weights_format =
           FullyConnectedOptionsWeightsFormat_DEFAULT,
-      int input_size = -1)
-      : BaseFullyConnectedOpModel(
-            registration, units, batches, input, output, bias_type,
-            keep_num_dims, bias_tensor_optional, activation_func,
-            weights_format, input_size, true, per_channel_quantization_scales) {
-  }
+      int input_size = -1, TfLiteType filter_type = kTfLiteNoType)
+      : BaseFullyConnectedOpModel(registration, units, batches, input, output,
+                                  bias_type, keep_num_dims,
+                                  bias_tensor_optional, activation_func,
+                                  weights_format, input_size, true,
+                                  per_channel_quantization_scales,
+                                  filter_type) {}
 
   void SetBias(const std::vector<float>& data) {
     PerChannelQuantizeBias(bias_, data);
@@ -797,6 +800,42 @@ TEST_P(QuantizedFullyConnectedOpTest, SimpleTestPerChannelQuantizedInt8) {
   EXPECT_THAT(m.GetOutput<int8_t>(), ElementsAre(23, 24, 25, 57, 58, 59));
 }
 
+TEST_P(QuantizedFullyConnectedOpTest, SimpleTestPerChannelQuantizedInt4) {
+  PerChannelQuantizedFullyConnectedOpModel m(
+      GetRegistration(), /*units=*/3, /*batches*/ 2,
+      /*input=*/{TensorType_INT8, {2, 10}, -63.5, 64},
+      /*per_channel_quantization_scales=*/{0.2, 0.25, 0.5},
+      /*output=*/{TensorType_INT8, {}, -127, 128},
+      /*bias_type=*/TensorType_INT32,
+      /*keep_num_dims=*/false, /*bias_tensor_optional=*/false,
+      /*activation_func=*/ActivationFunctionType_RELU,
+      /*weights_format=*/FullyConnectedOptionsWeightsFormat_DEFAULT,
+      /*input_size=*/-1, /*filter_type=*/kTfLiteInt4);
+
+  // Weights quantize to {1, 2, 3, 4, 5, 6, 7, 7, 6, 5} in every channel,
+  // which stays within the int4 range.
+  m.SetWeights<int8_t>({
+      0.2, 0.4, 0.6, 0.8, 1.0, 1.2, 1.4, 1.4, 1.2, 1.0,            // u = 0
+      0.25, 0.5, 0.75, 1.0, 1.25, 1.5, 1.75, 1.75, 1.5, 1.25,      // u = 1
+      0.5, 1.0, 1.5, 2.0, 2.5, 3.0, 3.5, 3.5, 3.0, 2.5,            // u = 2
+  });
+  m.SetBias({1, 2, 3});
+
+  m.SetInput<int8_t>({
+      1, 2, 3, 4, 5, 6, 7, 8,  -9, -10,  // b = 0
+      1, 2, 3, 4, 5, 6, 7, -8, 9,  -10,  // b = 1
+  });
+
+  ASSERT_EQ(m.Invoke(), kTfLiteOk);
+  EXPECT_THAT(m.GetDequantizedOutput<int8_t>(),
+              ElementsAreArray(ArrayFloatNear({19, 25, 49, 19, 24, 47})));
+  EXPECT_THAT(m.GetOutput<int8_t>(), ElementsAre(18, 24, 48, 18, 23, 46));
+
+  // Repeated invocations must keep producing identical results.
+  ASSERT_EQ(m.Invoke(), kTfLiteOk);
+  EXPECT_THAT(m.GetOutput<int8_t>(), ElementsAre(18, 24, 48, 18, 23, 46));
+}
+
 TEST_P(QuantizedFullyConnectedOpTest, SimpleTestQuantizedInt16NoBias) {
   const float scale = 128.0 / 65536;
   QuantizedFullyConnectedOpModel m(
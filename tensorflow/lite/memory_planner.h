@@ -15,6 +15,7 @@ limitations under the License.
 #ifndef TENSORFLOW_LITE_MEMORY_PLANNER_H_
 #define TENSORFLOW_LITE_MEMORY_PLANNER_H_
 
+#include <string>
 #include <vector>
 
 #include "tensorflow/lite/core/c/common.h"
@@ -62,6 +63,30 @@ class MemoryPlanner {
   // Returns true if the non-persistent memory is available.
   virtual bool HasNonPersistentMemory() = 0;
 
+  // Re-resolves tensor data pointers if the memory backing them has moved
+  // since they were last resolved, e.g. because another subgraph grew a
+  // memory arena that is shared across subgraphs. Called before each
+  // invocation. The default implementation does nothing.
+  virtual TfLiteStatus RefreshTensorAllocations() { return kTfLiteOk; }
+
+  // Serializes the current allocation plan into `output` so that a later
+  // process can skip replanning via SetPlanSnapshot(). Only meaningful after
+  // ExecuteAllocations() has covered the whole graph. Returns kTfLiteError if
+  // the planner does not support plan snapshots.
+  virtual TfLiteStatus GetPlanSnapshot(std::string* output) const {
+    return kTfLiteError;
+  }
+
+  // Stages a plan previously serialized by GetPlanSnapshot(). The plan is
+  // validated against the current graph on the next call to
+  // ExecuteAllocations() and silently discarded if it no longer matches, so a
+  // stale snapshot degrades to a regular planning pass. Returns kTfLiteError
+  // if the snapshot is malformed or the planner does not support plan
+  // snapshots.
+  virtual TfLiteStatus SetPlanSnapshot(const std::string& snapshot) {
+    return kTfLiteError;
+  }
+
   // Dumps the memory planning information against the specified op node
   // execution plan (i.e. `execution_plan`) for the purpose of debugging.
   virtual void DumpDebugInfo(const std::vector<int>& execution_plan) const = 0;
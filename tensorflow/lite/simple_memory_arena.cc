@@ -141,6 +141,17 @@ TfLiteStatus SimpleMemoryArena::Allocate(
   return kTfLiteOk;
 }
 
+void SimpleMemoryArena::ReserveAlloc(
+    const ArenaAllocWithUsageInterval& alloc) {
+  if (alloc.size == 0) {
+    return;
+  }
+  high_water_mark_ = std::max(high_water_mark_, alloc.offset + alloc.size);
+  auto insertion_it =
+      std::upper_bound(active_allocs_.begin(), active_allocs_.end(), alloc);
+  active_allocs_.insert(insertion_it, alloc);
+}
+
 TfLiteStatus SimpleMemoryArena::Commit(TfLiteContext* context,
                                        bool* arena_reallocated) {
   size_t required_size = RequiredBufferSize();
@@ -99,6 +99,12 @@ class SimpleMemoryArena {
                         int32_t tensor, int32_t first_node, int32_t last_node,
                         ArenaAllocWithUsageInterval* new_alloc);
 
+  // Re-registers an allocation produced by an earlier Allocate() call, e.g.
+  // one restored from a serialized plan. Keeps the high water mark and the
+  // active allocation list consistent so that subsequent Allocate() calls do
+  // not overlap the reserved region.
+  void ReserveAlloc(const ArenaAllocWithUsageInterval& alloc);
+
   inline size_t RequiredBufferSize() {
     // Add in a small amount of padding to reduce the chance of resize events
     // for small allocations.
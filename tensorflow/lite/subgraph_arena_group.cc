@@ -0,0 +1,137 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/lite/subgraph_arena_group.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include "tensorflow/lite/core/c/common.h"
+
+namespace tflite {
+
+namespace {
+
+template <typename T>
+T AlignTo(size_t alignment, T offset) {
+  return offset % alignment == 0 ? offset
+                                 : offset + (alignment - offset % alignment);
+}
+
+}  // namespace
+
+void SubgraphArenaGroup::AddCaller(int callee, int caller) {
+  if (callee < 0 || callee == caller) {
+    return;
+  }
+  std::vector<int>& callers = callers_[callee];
+  if (std::find(callers.begin(), callers.end(), caller) == callers.end()) {
+    callers.push_back(caller);
+  }
+}
+
+bool SubgraphArenaGroup::HasCaller(int callee) const {
+  return callers_.find(callee) != callers_.end();
+}
+
+size_t SubgraphArenaGroup::BaseOffset(int subgraph_index) const {
+  return BaseOffsetImpl(subgraph_index, /*depth=*/0);
+}
+
+size_t SubgraphArenaGroup::BaseOffsetImpl(int subgraph_index,
+                                          int depth) const {
+  auto it = callers_.find(subgraph_index);
+  // Subgraphs without a recorded caller sit at the bottom of the buffer. The
+  // depth limit cannot be reached through a valid model, since subgraphs
+  // cannot recurse; it merely guarantees termination on a malformed call
+  // structure.
+  if (it == callers_.end() || depth > static_cast<int>(callers_.size())) {
+    return 0;
+  }
+  size_t offset = 0;
+  for (int caller : it->second) {
+    size_t caller_region = 0;
+    auto size_it = region_sizes_.find(caller);
+    if (size_it != region_sizes_.end()) {
+      caller_region = size_it->second;
+    }
+    offset =
+        std::max(offset, BaseOffsetImpl(caller, depth + 1) + caller_region);
+  }
+  return offset;
+}
+
+void SubgraphArenaGroup::SetRegionSize(int subgraph_index, size_t size) {
+  if (size == 0) {
+    region_sizes_.erase(subgraph_index);
+    // A released subgraph holds no pointers into the buffer and must not
+    // keep retired buffers alive.
+    synced_generations_.erase(subgraph_index);
+    MaybeFreeRetiredBuffers();
+    return;
+  }
+  // Keep region sizes aligned so that the offsets handed out by each
+  // subgraph's arena stay aligned when its base offset is added.
+  region_sizes_[subgraph_index] = AlignTo(kDefaultArenaAlignment, size);
+}
+
+TfLiteStatus SubgraphArenaGroup::EnsureBufferSize(TfLiteContext* context,
+                                                  size_t size,
+                                                  bool* reallocated) {
+  *reallocated = false;
+  if (size <= buffer_size_) {
+    return kTfLiteOk;
+  }
+  char* new_buffer = new char[size + kDefaultArenaAlignment - 1];
+  char* new_aligned_ptr = reinterpret_cast<char*>(
+      AlignTo(kDefaultArenaAlignment, reinterpret_cast<intptr_t>(new_buffer)));
+  if (buffer_ != nullptr) {
+    // Callers of the subgraph that triggered the growth may be mid-invocation
+    // with live tensors in the old buffer, so carry the old contents over and
+    // retire -- rather than free -- the old buffer. Tensor pointers that have
+    // not yet been refreshed keep reading consistent data from it.
+    std::memcpy(new_aligned_ptr, aligned_ptr_, buffer_size_);
+    retired_buffers_.push_back(std::move(buffer_));
+    ++generation_;
+  }
+  buffer_.reset(new_buffer);
+  buffer_size_ = size;
+  aligned_ptr_ = new_aligned_ptr;
+  *reallocated = true;
+  return kTfLiteOk;
+}
+
+void SubgraphArenaGroup::NotifySynced(int subgraph_index,
+                                      int64_t generation) {
+  synced_generations_[subgraph_index] = generation;
+  MaybeFreeRetiredBuffers();
+}
+
+void SubgraphArenaGroup::MaybeFreeRetiredBuffers() {
+  if (retired_buffers_.empty()) {
+    return;
+  }
+  for (const auto& region : region_sizes_) {
+    auto it = synced_generations_.find(region.first);
+    if (it == synced_generations_.end() || it->second != generation_) {
+      return;
+    }
+  }
+  retired_buffers_.clear();
+}
+
+}  // namespace tflite
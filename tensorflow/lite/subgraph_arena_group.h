@@ -0,0 +1,109 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_SUBGRAPH_ARENA_GROUP_H_
+#define TENSORFLOW_LITE_SUBGRAPH_ARENA_GROUP_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "tensorflow/lite/core/c/common.h"
+
+namespace tflite {
+
+constexpr const int kDefaultArenaAlignment = 64;
+
+// Coordinates the non-persistent arenas of all subgraphs of a model so that
+// they are laid out in one shared buffer, stacked by subgraph invocation
+// depth. A subgraph invoked by a control flow op (WHILE, IF, CALL_ONCE) is
+// placed directly above the regions of its (transitive) callers, the only
+// subgraphs that can be live at the same time as it. Mutually exclusive
+// subgraphs -- the two branches of an IF op, or the bodies of two WHILE ops
+// in the same subgraph -- receive the same base offset and therefore share
+// one region, so the peak memory of a control flow model is determined by
+// its deepest call chain rather than by the sum of all subgraph arenas.
+//
+// The buffer may grow (and therefore move) while a caller subgraph is in the
+// middle of an invocation. Retired buffers are kept alive until every
+// subgraph has re-resolved its tensor pointers, so that pointers which have
+// not yet been refreshed keep reading consistent data.
+//
+// This class is not thread-safe; like the interpreter that owns it, it
+// assumes that subgraph invocations are serialized.
+class SubgraphArenaGroup {
+ public:
+  // Records that `caller` contains a control flow op which invokes `callee`.
+  void AddCaller(int callee, int caller);
+
+  // Returns true if some subgraph has been recorded as invoking `callee`.
+  bool HasCaller(int callee) const;
+
+  // Returns the byte offset of `subgraph_index`'s region in the shared
+  // buffer: the maximum, over all recorded callers, of the caller's base
+  // offset plus the caller's region size.
+  size_t BaseOffset(int subgraph_index) const;
+
+  // Publishes the committed size of `subgraph_index`'s region, above which
+  // its callees are stacked. A size of zero marks the region as released.
+  void SetRegionSize(int subgraph_index, size_t size);
+
+  // Grows the shared buffer to hold at least `size` bytes. On growth the old
+  // buffer is retired (but kept alive, see above), `generation()` is
+  // incremented and `*reallocated` is set to true.
+  TfLiteStatus EnsureBufferSize(TfLiteContext* context, size_t size,
+                                bool* reallocated);
+
+  // Records that `subgraph_index` has resolved its tensors against
+  // `generation`. Once every live region is up to date, retired buffers are
+  // freed.
+  void NotifySynced(int subgraph_index, int64_t generation);
+
+  char* buffer() const { return aligned_ptr_; }
+  size_t buffer_size() const { return buffer_size_; }
+
+  // Incremented every time the shared buffer is reallocated.
+  int64_t generation() const { return generation_; }
+
+ private:
+  size_t BaseOffsetImpl(int subgraph_index, int depth) const;
+
+  // Frees retired buffers once no subgraph can still hold pointers into
+  // them.
+  void MaybeFreeRetiredBuffers();
+
+  // Calling subgraph indices, keyed by callee subgraph index.
+  // NOLINTNEXTLINE - absl::flat_hash_map increases binary size by 106kB.
+  std::unordered_map<int, std::vector<int>> callers_;
+
+  // Committed region size of each subgraph, keyed by subgraph index.
+  // NOLINTNEXTLINE - absl::flat_hash_map increases binary size by 106kB.
+  std::unordered_map<int, size_t> region_sizes_;
+
+  // Generation each subgraph last resolved its tensors against.
+  // NOLINTNEXTLINE - absl::flat_hash_map increases binary size by 106kB.
+  std::unordered_map<int, int64_t> synced_generations_;
+
+  std::unique_ptr<char[]> buffer_;
+  std::vector<std::unique_ptr<char[]>> retired_buffers_;
+  size_t buffer_size_ = 0;
+  char* aligned_ptr_ = nullptr;
+  int64_t generation_ = 0;
+};
+
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_SUBGRAPH_ARENA_GROUP_H_
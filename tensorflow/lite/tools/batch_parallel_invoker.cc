@@ -0,0 +1,172 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/lite/tools/batch_parallel_invoker.h"
+
+#include <cstring>
+#include <memory>
+#include <thread>  // NOLINT(build/c++11)
+#include <utility>
+#include <vector>
+
+#include "tensorflow/lite/core/c/common.h"
+#include "tensorflow/lite/core/interpreter.h"
+#include "tensorflow/lite/tools/logging.h"
+
+namespace tflite {
+namespace tools {
+
+std::unique_ptr<BatchParallelInvoker> BatchParallelInvoker::Create(
+    const InterpreterFactory& factory, int pool_size) {
+  if (pool_size <= 0) {
+    TFLITE_LOG(ERROR) << "Pool size must be positive, got " << pool_size;
+    return nullptr;
+  }
+  std::vector<std::unique_ptr<Interpreter>> interpreters;
+  interpreters.reserve(pool_size);
+  for (int i = 0; i < pool_size; ++i) {
+    std::unique_ptr<Interpreter> interpreter = factory();
+    if (interpreter == nullptr) {
+      TFLITE_LOG(ERROR) << "Interpreter factory failed for pool slot " << i;
+      return nullptr;
+    }
+    interpreters.push_back(std::move(interpreter));
+  }
+  return std::unique_ptr<BatchParallelInvoker>(
+      new BatchParallelInvoker(std::move(interpreters)));
+}
+
+TfLiteStatus BatchParallelInvoker::Invoke(
+    const std::vector<std::vector<char>>& batched_inputs, int batch_size,
+    std::vector<std::vector<char>>* batched_outputs) {
+  if (batch_size <= 0 || batched_outputs == nullptr) {
+    return kTfLiteError;
+  }
+  Interpreter* first = interpreters_.front().get();
+  const size_t num_inputs = first->inputs().size();
+  const size_t num_outputs = first->outputs().size();
+  if (batched_inputs.size() != num_inputs) {
+    TFLITE_LOG(ERROR) << "Expected " << num_inputs << " inputs, got "
+                      << batched_inputs.size();
+    return kTfLiteError;
+  }
+  for (size_t j = 0; j < num_inputs; ++j) {
+    if (batched_inputs[j].size() % batch_size != 0) {
+      TFLITE_LOG(ERROR) << "Input " << j << " size " << batched_inputs[j].size()
+                        << " is not a multiple of the batch size";
+      return kTfLiteError;
+    }
+  }
+
+  // Split the batch as evenly as possible; the first `batch_size % pool_size`
+  // shards get one extra example.
+  const int pool = pool_size();
+  std::vector<int> shard_sizes(pool);
+  std::vector<int> shard_offsets(pool);
+  int offset = 0;
+  for (int i = 0; i < pool; ++i) {
+    shard_sizes[i] = batch_size / pool + (i < batch_size % pool ? 1 : 0);
+    shard_offsets[i] = offset;
+    offset += shard_sizes[i];
+  }
+
+  // Resize each instance to its shard and copy the input slices in. Setup is
+  // serial; only Invoke below runs in parallel.
+  for (int i = 0; i < pool; ++i) {
+    if (shard_sizes[i] == 0) continue;
+    Interpreter* interpreter = interpreters_[i].get();
+    for (size_t j = 0; j < num_inputs; ++j) {
+      const TfLiteTensor* tensor = interpreter->input_tensor(j);
+      std::vector<int> dims(tensor->dims->data,
+                            tensor->dims->data + tensor->dims->size);
+      if (dims.empty()) {
+        TFLITE_LOG(ERROR) << "Input " << j << " has no batch dimension";
+        return kTfLiteError;
+      }
+      dims[0] = shard_sizes[i];
+      if (interpreter->ResizeInputTensor(interpreter->inputs()[j], dims) !=
+          kTfLiteOk) {
+        return kTfLiteError;
+      }
+    }
+    if (interpreter->AllocateTensors() != kTfLiteOk) {
+      return kTfLiteError;
+    }
+    for (size_t j = 0; j < num_inputs; ++j) {
+      TfLiteTensor* tensor = interpreter->input_tensor(j);
+      const size_t example_bytes = batched_inputs[j].size() / batch_size;
+      const size_t shard_bytes = example_bytes * shard_sizes[i];
+      if (tensor->bytes != shard_bytes) {
+        TFLITE_LOG(ERROR) << "Input " << j << " shard expects " << tensor->bytes
+                          << " bytes but the batched data provides "
+                          << shard_bytes
+                          << "; is dimension 0 the batch dimension?";
+        return kTfLiteError;
+      }
+      std::memcpy(tensor->data.raw,
+                  batched_inputs[j].data() + example_bytes * shard_offsets[i],
+                  shard_bytes);
+    }
+  }
+
+  // Invoke all non-empty shards in parallel.
+  std::vector<TfLiteStatus> statuses(pool, kTfLiteOk);
+  std::vector<std::thread> workers;
+  workers.reserve(pool);
+  for (int i = 0; i < pool; ++i) {
+    if (shard_sizes[i] == 0) continue;
+    workers.emplace_back([this, i, &statuses]() {
+      statuses[i] = interpreters_[i]->Invoke();
+    });
+  }
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+  for (int i = 0; i < pool; ++i) {
+    if (statuses[i] != kTfLiteOk) {
+      TFLITE_LOG(ERROR) << "Invoke failed for pool slot " << i;
+      return statuses[i];
+    }
+  }
+
+  // Reassemble the per-shard outputs into batch-major buffers.
+  batched_outputs->assign(num_outputs, {});
+  for (size_t j = 0; j < num_outputs; ++j) {
+    size_t example_bytes = 0;
+    for (int i = 0; i < pool; ++i) {
+      if (shard_sizes[i] == 0) continue;
+      const TfLiteTensor* tensor = interpreters_[i]->output_tensor(j);
+      if (tensor->bytes % shard_sizes[i] != 0) {
+        TFLITE_LOG(ERROR) << "Output " << j
+                          << " does not split evenly along dimension 0";
+        return kTfLiteError;
+      }
+      example_bytes = tensor->bytes / shard_sizes[i];
+      break;
+    }
+    (*batched_outputs)[j].resize(example_bytes * batch_size);
+    for (int i = 0; i < pool; ++i) {
+      if (shard_sizes[i] == 0) continue;
+      const TfLiteTensor* tensor = interpreters_[i]->output_tensor(j);
+      std::memcpy((*batched_outputs)[j].data() +
+                      example_bytes * shard_offsets[i],
+                  tensor->data.raw, tensor->bytes);
+    }
+  }
+  return kTfLiteOk;
+}
+
+}  // namespace tools
+}  // namespace tflite
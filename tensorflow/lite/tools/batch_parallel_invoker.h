@@ -0,0 +1,82 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_LITE_TOOLS_BATCH_PARALLEL_INVOKER_H_
+#define TENSORFLOW_LITE_TOOLS_BATCH_PARALLEL_INVOKER_H_
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "tensorflow/lite/core/c/common.h"
+#include "tensorflow/lite/core/interpreter.h"
+
+namespace tflite {
+namespace tools {
+
+// Throughput-mode inference helper that splits a batched input across a pool
+// of interpreter instances created from the same model and invokes them in
+// parallel, then reassembles the per-instance outputs into a single batched
+// result. Interpreters built from the same FlatBuffer model share the
+// read-only weight buffers, so the pool costs one copy of the mutable tensor
+// arena per instance rather than one copy of the model.
+//
+// Requirements on the model:
+//  * Dimension 0 of every input and output is the batch dimension.
+//  * The model is stateless (no variables or other state that would make
+//    instances diverge across invocations).
+//
+// To avoid oversubscribing cores, the factory should configure each instance
+// with roughly (available cores / pool size) threads, e.g. via
+// Interpreter::SetNumThreads or a shared ExternalCpuBackendContext.
+class BatchParallelInvoker {
+ public:
+  // Builds one interpreter instance for the pool. The returned interpreter
+  // must be ready for tensor allocation (ops resolved, delegates applied).
+  using InterpreterFactory = std::function<std::unique_ptr<Interpreter>()>;
+
+  // Creates a pool of `pool_size` interpreters using `factory`. Returns
+  // nullptr if `pool_size` is not positive or the factory fails.
+  static std::unique_ptr<BatchParallelInvoker> Create(
+      const InterpreterFactory& factory, int pool_size);
+
+  // Runs one batched inference. `batched_inputs` holds the raw batch-major
+  // data for each model input, in input order; `batch_size` is the size of
+  // dimension 0 shared by all inputs. On success, `batched_outputs` is
+  // resized to the number of model outputs and filled with the reassembled
+  // batch-major output data. The batch is split as evenly as possible across
+  // the pool; instances that receive an empty shard are skipped.
+  TfLiteStatus Invoke(const std::vector<std::vector<char>>& batched_inputs,
+                      int batch_size,
+                      std::vector<std::vector<char>>* batched_outputs);
+
+  // Interpreter backing the first pool slot, e.g. for querying input and
+  // output metadata. Do not invoke it directly.
+  Interpreter* primary() { return interpreters_.front().get(); }
+
+  int pool_size() const { return static_cast<int>(interpreters_.size()); }
+
+ private:
+  explicit BatchParallelInvoker(
+      std::vector<std::unique_ptr<Interpreter>> interpreters)
+      : interpreters_(std::move(interpreters)) {}
+
+  std::vector<std::unique_ptr<Interpreter>> interpreters_;
+};
+
+}  // namespace tools
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_TOOLS_BATCH_PARALLEL_INVOKER_H_
@@ -0,0 +1,143 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/lite/tools/batch_parallel_invoker.h"
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "tensorflow/lite/core/c/common.h"
+#include "tensorflow/lite/core/interpreter.h"
+
+namespace tflite {
+namespace tools {
+namespace {
+
+// Element-wise float addition with the output resized to the first input's
+// shape, so the invoker's per-shard input resizes propagate to the output.
+TfLiteRegistration AddOpRegistration() {
+  TfLiteRegistration reg{};
+  reg.prepare = [](TfLiteContext* context, TfLiteNode* node) {
+    TfLiteTensor* input = &context->tensors[node->inputs->data[0]];
+    TfLiteTensor* output = &context->tensors[node->outputs->data[0]];
+    return context->ResizeTensor(context, output,
+                                 TfLiteIntArrayCopy(input->dims));
+  };
+  reg.invoke = [](TfLiteContext* context, TfLiteNode* node) {
+    const TfLiteTensor& a = context->tensors[node->inputs->data[0]];
+    const TfLiteTensor& b = context->tensors[node->inputs->data[1]];
+    TfLiteTensor& output = context->tensors[node->outputs->data[0]];
+    const int num_elements = static_cast<int>(a.bytes / sizeof(float));
+    for (int i = 0; i < num_elements; ++i) {
+      output.data.f[i] = a.data.f[i] + b.data.f[i];
+    }
+    return kTfLiteOk;
+  };
+  return reg;
+}
+
+std::unique_ptr<Interpreter> BuildAddInterpreter() {
+  static TfLiteRegistration reg = AddOpRegistration();
+  auto interpreter = std::make_unique<Interpreter>();
+  if (interpreter->AddTensors(3) != kTfLiteOk) return nullptr;
+  interpreter->SetInputs({0, 1});
+  interpreter->SetOutputs({2});
+  TfLiteQuantizationParams quant;
+  interpreter->SetTensorParametersReadWrite(0, kTfLiteFloat32, "a", {1, 4},
+                                            quant);
+  interpreter->SetTensorParametersReadWrite(1, kTfLiteFloat32, "b", {1, 4},
+                                            quant);
+  interpreter->SetTensorParametersReadWrite(2, kTfLiteFloat32, "out", {1, 4},
+                                            quant);
+  if (interpreter->AddNodeWithParameters({0, 1}, {2}, nullptr, 0, nullptr,
+                                         &reg) < 0) {
+    return nullptr;
+  }
+  return interpreter;
+}
+
+std::vector<char> AsBytes(const std::vector<float>& values) {
+  std::vector<char> bytes(values.size() * sizeof(float));
+  std::memcpy(bytes.data(), values.data(), bytes.size());
+  return bytes;
+}
+
+TEST(BatchParallelInvokerTest, SplitsBatchAcrossPoolAndReassembles) {
+  constexpr int kBatchSize = 8;
+  constexpr int kExampleElements = 4;
+  auto invoker = BatchParallelInvoker::Create(BuildAddInterpreter, 3);
+  ASSERT_NE(invoker, nullptr);
+  EXPECT_EQ(invoker->pool_size(), 3);
+
+  std::vector<float> a(kBatchSize * kExampleElements);
+  std::vector<float> b(kBatchSize * kExampleElements);
+  for (int i = 0; i < kBatchSize * kExampleElements; ++i) {
+    a[i] = static_cast<float>(i);
+    b[i] = static_cast<float>(2 * i);
+  }
+
+  std::vector<std::vector<char>> outputs;
+  ASSERT_EQ(invoker->Invoke({AsBytes(a), AsBytes(b)}, kBatchSize, &outputs),
+            kTfLiteOk);
+  ASSERT_EQ(outputs.size(), 1);
+  ASSERT_EQ(outputs[0].size(), kBatchSize * kExampleElements * sizeof(float));
+
+  std::vector<float> result(kBatchSize * kExampleElements);
+  std::memcpy(result.data(), outputs[0].data(), outputs[0].size());
+  for (int i = 0; i < kBatchSize * kExampleElements; ++i) {
+    EXPECT_EQ(result[i], 3.0f * i) << "at element " << i;
+  }
+}
+
+TEST(BatchParallelInvokerTest, BatchSmallerThanPoolSkipsIdleInstances) {
+  constexpr int kExampleElements = 4;
+  auto invoker = BatchParallelInvoker::Create(BuildAddInterpreter, 4);
+  ASSERT_NE(invoker, nullptr);
+
+  std::vector<float> a = {1.0f, 2.0f, 3.0f, 4.0f};
+  std::vector<float> b = {10.0f, 20.0f, 30.0f, 40.0f};
+  std::vector<std::vector<char>> outputs;
+  ASSERT_EQ(invoker->Invoke({AsBytes(a), AsBytes(b)}, /*batch_size=*/1,
+                            &outputs),
+            kTfLiteOk);
+  ASSERT_EQ(outputs.size(), 1);
+  ASSERT_EQ(outputs[0].size(), kExampleElements * sizeof(float));
+
+  std::vector<float> result(kExampleElements);
+  std::memcpy(result.data(), outputs[0].data(), outputs[0].size());
+  for (int i = 0; i < kExampleElements; ++i) {
+    EXPECT_EQ(result[i], a[i] + b[i]);
+  }
+}
+
+TEST(BatchParallelInvokerTest, RejectsWrongInputCount) {
+  auto invoker = BatchParallelInvoker::Create(BuildAddInterpreter, 2);
+  ASSERT_NE(invoker, nullptr);
+
+  std::vector<std::vector<char>> outputs;
+  EXPECT_EQ(invoker->Invoke({AsBytes({1.0f, 2.0f, 3.0f, 4.0f})},
+                            /*batch_size=*/1, &outputs),
+            kTfLiteError);
+}
+
+TEST(BatchParallelInvokerTest, RejectsInvalidPoolSize) {
+  EXPECT_EQ(BatchParallelInvoker::Create(BuildAddInterpreter, 0), nullptr);
+}
+
+}  // namespace
+}  // namespace tools
+}  // namespace tflite
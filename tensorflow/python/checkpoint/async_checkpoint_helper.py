@@ -623,6 +623,13 @@ class AsyncCheckpointHelper:
     return status
 
   def sync(self):
-    """Sync on any ongoing save or restore events."""
+    """Sync on any ongoing save or restore events.
+
+    Blocks until the background thread has finished writing any pending
+    checkpoint, making this a completion barrier for coordinated multi-worker
+    checkpoints. If the background save failed, the error is raised here
+    rather than silently deferred to the next save attempt.
+    """
     self._queue.join()
     logging.info("Sync on ongoing save/restore.")
+    self._check_async_thread_error()
@@ -336,6 +336,15 @@ class OptimizationOptions(options_lib.OptionsBase):
       "Whether to parallelize stateless filter transformations. If None, "
       "defaults to False.")
 
+  fuse_decode_jpeg = options_lib.create_option(
+      name="fuse_decode_jpeg",
+      ty=bool,
+      docstring=
+      "Whether to fuse JPEG decode, crop and resize operations into a "
+      "region-of-interest decode with DCT scaling. The fused decode of a "
+      "downscaled image may produce slightly different pixel values than "
+      "resizing the full-resolution decode. If None, defaults to False.")
+
   inject_prefetch = options_lib.create_option(
       name="inject_prefetch",
       ty=bool,
@@ -397,6 +406,8 @@ class OptimizationOptions(options_lib.OptionsBase):
       pb.filter_fusion = self.filter_fusion
     if self.filter_parallelization is not None:
       pb.filter_parallelization = self.filter_parallelization
+    if self.fuse_decode_jpeg is not None:
+      pb.fuse_decode_jpeg = self.fuse_decode_jpeg
     if self.inject_prefetch is not None:
       pb.inject_prefetch = self.inject_prefetch
     if self.map_and_batch_fusion is not None:
@@ -422,6 +433,8 @@ class OptimizationOptions(options_lib.OptionsBase):
       self.filter_fusion = pb.filter_fusion
     if pb.WhichOneof("optional_filter_parallelization") is not None:
       self.filter_parallelization = pb.filter_parallelization
+    if pb.WhichOneof("optional_fuse_decode_jpeg") is not None:
+      self.fuse_decode_jpeg = pb.fuse_decode_jpeg
     if pb.WhichOneof("optional_inject_prefetch") is not None:
       self.inject_prefetch = pb.inject_prefetch
     if pb.WhichOneof("optional_map_and_batch_fusion") is not None:
@@ -12,6 +12,7 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 # ==============================================================================
+import os
 import queue
 import threading
 
@@ -295,5 +296,142 @@ class StageTest(test.TestCase):
       self.assertTrue(sess.run(size) == 0)
 
 
+class StageSpscTest(test.TestCase):
+  """Exercises the lock-free SPSC ring buffer staging variant.
+
+  The ring buffer is selected when the staging area resource is created, so
+  the environment variable has to be set before the first op runs.
+  """
+
+  def setUp(self):
+    super(StageSpscTest, self).setUp()
+    os.environ['TF_STAGE_SPSC_BUFFER'] = '1'
+
+  def tearDown(self):
+    del os.environ['TF_STAGE_SPSC_BUFFER']
+    super(StageSpscTest, self).tearDown()
+
+  @test_util.run_deprecated_v1
+  def testPipelined(self):
+    capacity = 3
+    n = 100
+
+    with ops.Graph().as_default() as G:
+      with ops.device('/cpu:0'):
+        x = array_ops.placeholder(dtypes.int32, name='x')
+        stager = data_flow_ops.StagingArea(
+            [
+                dtypes.int32,
+            ], capacity=capacity, shapes=[[]])
+        stage = stager.put([x])
+        ret = stager.get()
+        size = stager.size()
+
+    G.finalize()
+
+    with self.session(graph=G) as sess:
+
+      def thread_run():
+        for i in range(n):
+          sess.run(stage, feed_dict={x: i})
+
+      t = threading.Thread(target=thread_run)
+      t.daemon = True
+      t.start()
+
+      # A single consumer draining a single producer observes every element
+      # in order, with both sides alternately blocking on the ring.
+      for i in range(n):
+        self.assertEqual(sess.run(ret), [i])
+
+      t.join()
+      self.assertEqual(sess.run(size), 0)
+
+  @test_util.run_deprecated_v1
+  def testCapacityBlocksProducer(self):
+    capacity = 3
+
+    with ops.Graph().as_default() as G:
+      with ops.device('/cpu:0'):
+        x = array_ops.placeholder(dtypes.int32, name='x')
+        stager = data_flow_ops.StagingArea(
+            [
+                dtypes.int32,
+            ], capacity=capacity, shapes=[[]])
+        stage = stager.put([x])
+        ret = stager.get()
+        size = stager.size()
+
+    G.finalize()
+
+    value_queue = queue.Queue()
+    n = 8
+
+    with self.session(graph=G) as sess:
+      # Stage data in a separate thread which will block when it hits the
+      # ring buffer's capacity and thus not fill the value_queue with n tokens
+      def thread_run():
+        for i in range(n):
+          sess.run(stage, feed_dict={x: i})
+          value_queue.put(0)
+
+      t = threading.Thread(target=thread_run)
+      t.daemon = True
+      t.start()
+
+      # Get tokens from the value_queue until a timeout occurs
+      try:
+        for i in range(n):
+          value_queue.get(timeout=TIMEOUT)
+      except queue.Empty:
+        pass
+
+      # Should've timed out on the iteration 'capacity'
+      if not i == capacity:
+        self.fail("Expected to timeout on iteration '{}' "
+                  "but instead timed out on iteration '{}' "
+                  "Staging Area size is '{}' and configured "
+                  "capacity is '{}'.".format(capacity, i, sess.run(size),
+                                             capacity))
+
+      # Should have capacity elements in the staging area
+      self.assertTrue(sess.run(size) == capacity)
+
+      # Clear the staging area completely
+      for i in range(n):
+        self.assertTrue(sess.run(ret) == [i])
+
+      # It should now be empty
+      self.assertTrue(sess.run(size) == 0)
+
+  @test_util.run_deprecated_v1
+  def testPeekSizeAndClear(self):
+    with ops.Graph().as_default() as G:
+      with ops.device('/cpu:0'):
+        x = array_ops.placeholder(dtypes.int32, name='x')
+        p = array_ops.placeholder(dtypes.int32, name='p')
+        stager = data_flow_ops.StagingArea(
+            [
+                dtypes.int32,
+            ], capacity=4, shapes=[[]])
+        stage = stager.put([x])
+        peek = stager.peek(p)
+        size = stager.size()
+        clear = stager.clear()
+
+    G.finalize()
+
+    with self.session(graph=G) as sess:
+      for i in range(3):
+        sess.run(stage, feed_dict={x: i})
+
+      self.assertEqual(sess.run(size), 3)
+      for i in range(3):
+        self.assertTrue(sess.run(peek, feed_dict={p: i}) == [i])
+
+      sess.run(clear)
+      self.assertEqual(sess.run(size), 0)
+
+
 if __name__ == '__main__':
   test.main()
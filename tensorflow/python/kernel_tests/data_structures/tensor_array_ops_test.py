@@ -14,6 +14,8 @@
 # ==============================================================================
 """Tests for tensorflow.ops.tensor_array_ops."""
 
+import os
+
 import numpy as np
 
 from tensorflow.core.protobuf import config_pb2
@@ -1865,6 +1867,68 @@ class TensorArrayTest(test.TestCase):
       self.evaluate(func())
 
 
+class TensorArrayContiguousTest(test.TestCase):
+  """Exercises the contiguous-backed storage of cpu TensorArrays."""
+
+  def setUp(self):
+    super().setUp()
+    os.environ["TF_TENSOR_ARRAY_CONTIGUOUS"] = "1"
+
+  def tearDown(self):
+    del os.environ["TF_TENSOR_ARRAY_CONTIGUOUS"]
+    super().tearDown()
+
+  def testWriteStack(self):
+    with self.session(use_gpu=False):
+      ta = tensor_array_ops.TensorArray(
+          dtype=dtypes.float32, tensor_array_name="contiguous", size=3)
+      w0 = ta.write(0, [[4.0, 5.0]])
+      w1 = w0.write(1, [[6.0, 7.0]])
+      w2 = w1.write(2, [[8.0, 9.0]])
+      self.assertAllEqual([[[4.0, 5.0]], [[6.0, 7.0]], [[8.0, 9.0]]],
+                          self.evaluate(w2.stack()))
+
+  def testDynamicSizeWriteInWhileThenStack(self):
+    # The common decode shape: a dynamically sized array written once per
+    # loop iteration and stacked at the end.
+    with self.session(use_gpu=False):
+      n = 17
+      ta = tensor_array_ops.TensorArray(
+          dtype=dtypes.float32, size=0, dynamic_size=True)
+      (_, final) = while_loop.while_loop(
+          lambda i, _: i < n,
+          lambda i, a: (i + 1, a.write(i, math_ops.cast(i, dtypes.float32) *
+                                       array_ops.ones([2, 3]))),
+          [0, ta])
+      value = self.evaluate(final.stack())
+      expected = np.arange(n, dtype=np.float32).reshape(n, 1, 1) * np.ones(
+          (n, 2, 3), dtype=np.float32)
+      self.assertAllEqual(expected, value)
+
+  def testReadAndGatherSubset(self):
+    with self.session(use_gpu=False):
+      ta = tensor_array_ops.TensorArray(
+          dtype=dtypes.float32, size=4, clear_after_read=False)
+      w = ta
+      for i in range(4):
+        w = w.write(i, [1.0 * i, 2.0 * i])
+      self.assertAllEqual([2.0, 4.0], self.evaluate(w.read(2)))
+      # A non-leading index list falls back to the element-wise gather.
+      self.assertAllEqual([[3.0, 6.0], [1.0, 2.0]],
+                          self.evaluate(w.gather([3, 1])))
+      self.assertAllEqual(
+          [[0.0, 0.0], [1.0, 2.0], [2.0, 4.0], [3.0, 6.0]],
+          self.evaluate(w.stack()))
+
+  def testStringFallsBack(self):
+    with self.session(use_gpu=False):
+      ta = tensor_array_ops.TensorArray(
+          dtype=dtypes.string, tensor_array_name="contiguous_str", size=2)
+      w = ta.write(0, ["a", "b"]).write(1, ["c", "d"])
+      self.assertAllEqual([[b"a", b"b"], [b"c", b"d"]],
+                          self.evaluate(w.stack()))
+
+
 class TensorArrayBenchmark(test.Benchmark):
 
   def _tensorArrayWriteInWhile(self):
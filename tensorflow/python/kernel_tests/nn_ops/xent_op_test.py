@@ -66,6 +66,22 @@ class XentOpTest(xent_op_test_base.XentOpTestBase):
     self.assertAllClose([0, 0], tf_loss)
     self.assertAllCloseAccordingToType([[0], [0]], tf_gradient)
 
+  def testLargeVocab(self):
+    # Wide rows take the tiled CPU implementation; compare it against the
+    # numpy reference used by the narrow-class tests.
+    np.random.seed(1)
+    for dtype in np.float32, np.float64:
+      np_logits = np.random.randn(4, 8192).astype(dtype)
+      np_labels = np.random.rand(4, 8192).astype(dtype)
+      np_labels /= np_labels.sum(axis=1, keepdims=True)
+      np_loss, np_gradient = self._npXent(labels=np_labels, logits=np_logits)
+      tf_loss, tf_gradient = gen_nn_ops.softmax_cross_entropy_with_logits(
+          np_logits, np_labels)
+      self.assertAllClose(np_loss, self.evaluate(tf_loss), rtol=1e-5,
+                          atol=1e-5)
+      self.assertAllClose(np_gradient, self.evaluate(tf_gradient), rtol=1e-5,
+                          atol=1e-5)
+
   @test_util.run_deprecated_v1
   def testNotMatrix(self):
     with self.cached_session():
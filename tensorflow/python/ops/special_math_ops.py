@@ -749,7 +749,11 @@ def einsum(equation, *inputs, **kwargs):
     **kwargs:
       - optimize: Optimization strategy to use to find contraction path using
         opt_einsum. Must be 'greedy', 'optimal', 'branch-2', 'branch-all' or
-          'auto'. (optional, default: 'greedy').
+          'auto'. (optional, default: 'auto'). The default searches
+          exhaustively for the contraction order with the fewest FLOPs when
+          the number of operands is small, and uses cheaper heuristics for
+          larger expressions. The chosen path is cached per equation and
+          shape signature.
       - name: A name for the operation (optional).
 
   Returns:
@@ -1171,7 +1175,12 @@ def _exponential_space_einsum_v1(equation, *inputs):
 def _einsum_v2(equation, *inputs, **kwargs):
   """Implementation of einsum utilizing opt_einsum and EinsumOp."""
   name = kwargs.pop('name', None)
-  optimize = kwargs.pop('optimize', 'greedy')
+  # Default to 'auto', which performs an exhaustive search for the cheapest
+  # contraction order on small expressions (where greedy ordering can cost an
+  # order of magnitude more FLOPs) and falls back to cheaper heuristics as the
+  # number of operands grows. The resulting path is memoized per equation and
+  # shape signature; see `_get_opt_einsum_contract_path`.
+  optimize = kwargs.pop('optimize', 'auto')
   if kwargs:
     raise TypeError(
         f'Invalid keyword arguments for einsum: {", ".join(kwargs)}. '
@@ -16,6 +16,7 @@ limitations under the License.
 #include "tsl/distributed_runtime/coordination/coordination_service.h"
 
 #include <algorithm>
+#include <array>
 #include <cstdint>
 #include <functional>
 #include <map>
@@ -36,6 +37,7 @@ limitations under the License.
 #include "tsl/distributed_runtime/coordination/coordination_service_error_util.h"
 #include "tsl/platform/env.h"
 #include "tsl/platform/errors.h"
+#include "tsl/platform/hash.h"
 #include "tsl/platform/macros.h"
 #include "tsl/platform/mutex.h"
 #include "tsl/platform/random.h"
@@ -62,6 +64,10 @@ constexpr int kServiceToClientTimeoutMs = 10 * 1000;   // 10 seconds
 constexpr size_t kOngoingBarriersSoftLimit = 20;
 constexpr char kHealthCheckThread[] = "CoordinationServiceHealthCheck";
 constexpr int kPendingTaskLogLimit = 20;
+// Barriers with at least this many pending callbacks have their results
+// propagated on a separate thread, so that writing thousands of RPC responses
+// does not happen while holding the service state lock.
+constexpr size_t kAsyncBarrierFanOutThreshold = 128;
 
 std::string GetTaskName(absl::string_view job_name, int task_id) {
   return strings::StrCat("/job:", job_name, "/replica:", 0, "/task:", task_id);
@@ -93,6 +99,17 @@ struct CoordinatedTaskEqual {
   }
 };
 
+// Order-insensitive fingerprint of a set of tasks. Used to validate that
+// repeated barrier calls specify the same participant set in O(1) instead of
+// probing the barrier's task map once per participant per call.
+uint64_t TaskSetFingerprint(const std::vector<CoordinatedTask>& tasks) {
+  uint64_t fingerprint = 0;
+  for (const auto& task : tasks) {
+    fingerprint += CoordinatedTaskHash()(task);
+  }
+  return fingerprint;
+}
+
 // Standalone implementation of the coordination service.
 class CoordinationServiceStandaloneImpl : public CoordinationServiceInterface {
  public:
@@ -162,17 +179,18 @@ class CoordinationServiceStandaloneImpl : public CoordinationServiceInterface {
     absl::flat_hash_map<CoordinatedTask, bool, CoordinatedTaskHash,
                         CoordinatedTaskEqual>
         tasks_at_barrier;
+    // Order-insensitive fingerprint of the keys of `tasks_at_barrier`, so
+    // repeated barrier calls can be validated without iterating over the
+    // participant set.
+    uint64_t participant_fingerprint = 0;
     std::vector<StatusCallback> done_callbacks;
   };
   void PassBarrier(absl::string_view barrier_id, Status result,
                    BarrierState* barrier)
       TF_EXCLUSIVE_LOCKS_REQUIRED(state_mu_);
   // Check if participating tasks are specified correctly across barrier calls.
-  bool ValidateTaskArgs(
-      const std::vector<CoordinatedTask>& tasks_args,
-      const absl::flat_hash_map<CoordinatedTask, bool, CoordinatedTaskHash,
-                                CoordinatedTaskEqual>& tasks_at_barrier,
-      int64_t cluster_size);
+  bool ValidateTaskArgs(const std::vector<CoordinatedTask>& tasks_args,
+                        const BarrierState& barrier, int64_t cluster_size);
   bool isRecoverableJob(absl::string_view task_name) const;
 
   class TaskState {
@@ -249,11 +267,22 @@ class CoordinationServiceStandaloneImpl : public CoordinationServiceInterface {
       TF_GUARDED_BY(state_mu_);
   DeviceInfo cluster_devices_ TF_GUARDED_BY(state_mu_);
 
-  mutex kv_mu_;
-  // Ordered map to store config key-values
-  std::map<std::string, std::string> kv_store_ TF_GUARDED_BY(kv_mu_);
-  absl::flat_hash_map<std::string, std::vector<StatusOrValueCallback>> get_cb_
-      TF_GUARDED_BY(kv_mu_);
+  // The key-value store is sharded to reduce lock contention: at scale, every
+  // task hits the store during startup (e.g. to exchange addresses), and a
+  // single mutex serializes all of those requests. Keys are assigned to shards
+  // by their top-level directory so that directory-level reads and deletes
+  // stay within one shard and remain atomic.
+  static constexpr int kNumKvShards = 16;
+  struct KvShard {
+    mutex mu;
+    // Ordered map to store config key-values
+    std::map<std::string, std::string> kv_store TF_GUARDED_BY(mu);
+    absl::flat_hash_map<std::string, std::vector<StatusOrValueCallback>> get_cb
+        TF_GUARDED_BY(mu);
+  };
+  // Returns the shard that owns `norm_key` (which must already be normalized).
+  KvShard& KvShardForKey(absl::string_view norm_key);
+  std::array<KvShard, kNumKvShards> kv_shards_;
 
   mutex check_staleness_thread_shutdown_mu_;
   condition_variable check_staleness_thread_cv_;
@@ -482,9 +511,9 @@ void CoordinationServiceStandaloneImpl::StartCheckStaleness() {
 }
 
 void CoordinationServiceStandaloneImpl::Stop(bool shut_staleness_thread) {
-  {
-    mutex_lock l(kv_mu_);
-    for (const auto& [key, get_kv_callbacks] : get_cb_) {
+  for (KvShard& shard : kv_shards_) {
+    mutex_lock l(shard.mu);
+    for (const auto& [key, get_kv_callbacks] : shard.get_cb) {
       for (const auto& get_kv_callback : get_kv_callbacks) {
         get_kv_callback(errors::Cancelled(
             absl::StrCat("Coordination service is shutting down. Cancelling "
@@ -492,7 +521,7 @@ void CoordinationServiceStandaloneImpl::Stop(bool shut_staleness_thread) {
                          key)));
       }
     }
-    get_cb_.clear();
+    shard.get_cb.clear();
   }
   {
     mutex_lock l(state_mu_);
@@ -716,29 +745,33 @@ Status CoordinationServiceStandaloneImpl::RecordHeartbeat(
   const std::string& task_name = GetTaskName(task);
   Status s = OkStatus();
   {
-    mutex_lock l(state_mu_);
-    if (!cluster_state_.contains(task_name)) {
+    // Heartbeats are by far the most frequent RPC at scale and only read the
+    // cluster map; a shared lock keeps them from serializing behind each
+    // other. The per-task heartbeat timestamp is guarded by its own mutex.
+    tf_shared_lock l(state_mu_);
+    const auto task_state_iter = cluster_state_.find(task_name);
+    if (task_state_iter == cluster_state_.end()) {
       return MakeCoordinationError(errors::InvalidArgument(
           "Unexpected heartbeat request from task: ", task_name,
           ". This usually implies an earlier error that caused coordination "
           "service to shut down before the workers disconnect. Check the task "
           "leader's logs for an earlier error to debug the root cause."));
     }
-    if (!cluster_state_[task_name]->GetStatus().ok()) {
-      return cluster_state_[task_name]->GetStatus();
-    } else if (cluster_state_[task_name]->GetState() ==
+    TaskState* task_state = task_state_iter->second.get();
+    if (!task_state->GetStatus().ok()) {
+      return task_state->GetStatus();
+    } else if (task_state->GetState() ==
                    CoordinatedTaskState::TASKSTATE_DISCONNECTED &&
                // We accept heartbeats for a short grace period to account for
                // the lag time between the service recording the state change
                // and the agent stopping heartbeats.
                Env::Default()->NowMicros() >
-                   cluster_state_[task_name]
-                       ->GetDisconnectedGracePeriodMicros()) {
+                   task_state->GetDisconnectedGracePeriodMicros()) {
       return MakeCoordinationError(errors::InvalidArgument(
           "Task with task_name=", task_name,
           " must be registered before sending heartbeat messages"));
     }
-    s = cluster_state_[task_name]->RecordHeartbeat(incarnation);
+    s = task_state->RecordHeartbeat(incarnation);
   }
 
   // Set and propagate any heartbeat errors.
@@ -878,22 +911,33 @@ std::string NormalizeKey(const StringPiece orig_key) {
   return norm_key;
 }
 
+CoordinationServiceStandaloneImpl::KvShard&
+CoordinationServiceStandaloneImpl::KvShardForKey(absl::string_view norm_key) {
+  // Hash only the top-level directory so that all keys under it land in the
+  // same shard, keeping GetKeyValueDir() and DeleteKeyValue() single-shard.
+  const absl::string_view top_level_dir =
+      norm_key.substr(0, norm_key.find('/'));
+  return kv_shards_[Hash64(top_level_dir.data(), top_level_dir.size()) %
+                    kNumKvShards];
+}
+
 Status CoordinationServiceStandaloneImpl::InsertKeyValue(
     const std::string& key, const std::string& value) {
   VLOG(3) << "InsertKeyValue(): " << key << ": " << value;
   const std::string& norm_key = NormalizeKey(key);
-  mutex_lock l(kv_mu_);
-  if (kv_store_.find(norm_key) != kv_store_.end()) {
+  KvShard& shard = KvShardForKey(norm_key);
+  mutex_lock l(shard.mu);
+  if (shard.kv_store.find(norm_key) != shard.kv_store.end()) {
     return MakeCoordinationError(
         errors::AlreadyExists("Config key ", key, " already exists."));
   }
-  kv_store_.emplace(norm_key, value);
-  auto iter = get_cb_.find(norm_key);
-  if (iter != get_cb_.end()) {
+  shard.kv_store.emplace(norm_key, value);
+  auto iter = shard.get_cb.find(norm_key);
+  if (iter != shard.get_cb.end()) {
     for (const auto& cb : iter->second) {
       cb(value);
     }
-    get_cb_.erase(iter);
+    shard.get_cb.erase(iter);
   }
   return OkStatus();
 }
@@ -902,16 +946,18 @@ void CoordinationServiceStandaloneImpl::GetKeyValueAsync(
     const std::string& key, StatusOrValueCallback done) {
   VLOG(3) << "GetKeyValue(): " << key;
   const std::string& norm_key = NormalizeKey(key);
-  mutex_lock l(kv_mu_);
-  const auto& iter = kv_store_.find(norm_key);
-  if (iter != kv_store_.end()) {
+  KvShard& shard = KvShardForKey(norm_key);
+  mutex_lock l(shard.mu);
+  const auto& iter = shard.kv_store.find(norm_key);
+  if (iter != shard.kv_store.end()) {
     done(iter->second);
     return;
   }
-  auto cb_iter = get_cb_.find(norm_key);
-  if (cb_iter == get_cb_.end()) {
+  auto cb_iter = shard.get_cb.find(norm_key);
+  if (cb_iter == shard.get_cb.end()) {
     cb_iter =
-        get_cb_.emplace(norm_key, std::vector<StatusOrValueCallback>()).first;
+        shard.get_cb.emplace(norm_key, std::vector<StatusOrValueCallback>())
+            .first;
   }
   cb_iter->second.emplace_back(std::move(done));
 }
@@ -920,9 +966,10 @@ StatusOr<std::string> CoordinationServiceStandaloneImpl::TryGetKeyValue(
     const std::string& key) {
   VLOG(3) << "TryGetKeyValue(): " << key;
   const std::string& norm_key = NormalizeKey(key);
-  mutex_lock l(kv_mu_);
-  const auto& iter = kv_store_.find(norm_key);
-  if (iter == kv_store_.end()) {
+  KvShard& shard = KvShardForKey(norm_key);
+  mutex_lock l(shard.mu);
+  const auto& iter = shard.kv_store.find(norm_key);
+  if (iter == shard.kv_store.end()) {
     return errors::NotFound("Config key ", key, " not found.");
   }
   return iter->second;
@@ -935,12 +982,15 @@ std::vector<KeyValueEntry> CoordinationServiceStandaloneImpl::GetKeyValueDir(
   const std::string norm_key = NormalizeKey(directory_key);
   const std::string dir = absl::StrCat(norm_key, "/");
 
-  mutex_lock l(kv_mu_);
+  // All keys under a directory hash to the same shard, so a single shard lock
+  // yields an atomic snapshot of the directory.
+  KvShard& shard = KvShardForKey(norm_key);
+  mutex_lock l(shard.mu);
   // Find first key in ordered map that has the directory prefix.
-  auto begin = kv_store_.lower_bound(dir);
+  auto begin = shard.kv_store.lower_bound(dir);
   std::map<std::string, std::string>::iterator it;
   // Iterate through key range that match directory prefix.
-  for (it = begin; it != kv_store_.end(); ++it) {
+  for (it = begin; it != shard.kv_store.end(); ++it) {
     // Stop once the next key does not have the directory prefix. Since keys are
     // ordered, none of the other keys would have a matching prefix.
     if (std::mismatch(dir.begin(), dir.end(), it->first.begin()).first !=
@@ -960,20 +1010,21 @@ Status CoordinationServiceStandaloneImpl::DeleteKeyValue(
     const std::string& key) {
   VLOG(3) << "DeleteKeyValue(): " << key;
   const std::string& norm_key = NormalizeKey(key);
-  mutex_lock l(kv_mu_);
+  KvShard& shard = KvShardForKey(norm_key);
+  mutex_lock l(shard.mu);
   // Delete directory: find key range that match directory prefix
   const std::string& dir = strings::StrCat(norm_key, "/");
-  auto begin = kv_store_.lower_bound(dir);
+  auto begin = shard.kv_store.lower_bound(dir);
   std::map<std::string, std::string>::iterator end;
-  for (end = begin; end != kv_store_.end(); end++) {
+  for (end = begin; end != shard.kv_store.end(); end++) {
     if (std::mismatch(dir.begin(), dir.end(), end->first.begin()).first !=
         dir.end())
       break;
   }
-  kv_store_.erase(begin, end);
-  auto iter = kv_store_.find(norm_key);
-  if (iter != kv_store_.end()) {
-    kv_store_.erase(iter);
+  shard.kv_store.erase(begin, end);
+  auto iter = shard.kv_store.find(norm_key);
+  if (iter != shard.kv_store.end()) {
+    shard.kv_store.erase(iter);
   }
   return OkStatus();
 }
@@ -1034,6 +1085,10 @@ void CoordinationServiceStandaloneImpl::BarrierAsync(
       }
     }
     barrier->num_pending_tasks = barrier->tasks_at_barrier.size();
+    for (const auto& pending_task : barrier->tasks_at_barrier) {
+      barrier->participant_fingerprint +=
+          CoordinatedTaskHash()(pending_task.first);
+    }
 
     // Fail the barrier immediately if any tasks are already in error.
     for (const auto& pending_task : barrier->tasks_at_barrier) {
@@ -1098,7 +1153,7 @@ void CoordinationServiceStandaloneImpl::BarrierAsync(
   }
 
   // Check if task args are specified consistently across barrier calls.
-  if (!ValidateTaskArgs(participating_tasks, barrier->tasks_at_barrier,
+  if (!ValidateTaskArgs(participating_tasks, *barrier,
                         cluster_state_.size())) {
     Status error = MakeCoordinationError(errors::InvalidArgument(absl::StrCat(
         "Conflicting tasks specified for the same barrier: ", barrier_id)));
@@ -1196,31 +1251,40 @@ void CoordinationServiceStandaloneImpl::PassBarrier(
   ongoing_barriers_.erase(barrier_id);
   // Note: barrier_id shouldn't be referenced after this line as its lifetime
   // may be tied to one of the callbacks.
-  // Propagate results to participating tasks.
-  for (const auto& callback : barrier->done_callbacks) {
-    callback(result);
-  }
+  // Propagate results to participating tasks. For large barriers, fan out on a
+  // separate thread so that the per-task responses are not written while
+  // holding `state_mu_`; small barriers keep the synchronous behavior.
+  std::vector<StatusCallback> done_callbacks =
+      std::move(barrier->done_callbacks);
   barrier->done_callbacks.clear();
+  if (done_callbacks.size() >= kAsyncBarrierFanOutThreshold) {
+    env_.SchedClosure(
+        [result, done_callbacks = std::move(done_callbacks)]() mutable {
+          for (const auto& callback : done_callbacks) {
+            callback(result);
+          }
+        });
+  } else {
+    for (const auto& callback : done_callbacks) {
+      callback(result);
+    }
+  }
 }
 
 bool CoordinationServiceStandaloneImpl::ValidateTaskArgs(
 
-    const std::vector<CoordinatedTask>& tasks_args,
-    const absl::flat_hash_map<CoordinatedTask, bool, CoordinatedTaskHash,
-                              CoordinatedTaskEqual>& tasks_at_barrier,
+    const std::vector<CoordinatedTask>& tasks_args, const BarrierState& barrier,
     int64_t cluster_size) {
   if (tasks_args.empty()) {
-    return tasks_at_barrier.size() == cluster_size;
-  } else if (tasks_at_barrier.size() != tasks_args.size()) {
+    return barrier.tasks_at_barrier.size() == cluster_size;
+  } else if (barrier.tasks_at_barrier.size() != tasks_args.size()) {
     return false;
-  } else {
-    for (const auto& task : tasks_args) {
-      if (!tasks_at_barrier.contains(task)) {
-        return false;
-      }
-    }
   }
-  return true;
+  // Same set size: compare an order-insensitive fingerprint of the specified
+  // tasks against the barrier's participant set. This keeps repeated calls
+  // O(participants) in total per barrier rather than per call, which matters
+  // once thousands of tasks hit the same barrier.
+  return TaskSetFingerprint(tasks_args) == barrier.participant_fingerprint;
 }
 
 void CoordinationServiceStandaloneImpl::AggregateClusterDevices() {
@@ -315,6 +315,21 @@ Status CoordinationServiceAgentImpl::Connect() {
         CallOptions call_opts;
         call_opts.SetTimeout(heartbeat_interval_ms);
 
+        // Tasks in a large job typically connect at roughly the same time, so
+        // without jitter their heartbeats arrive at the service in synchronized
+        // bursts. Stagger the first heartbeat by a random fraction of the
+        // interval to spread the load evenly over time.
+        {
+          const int64_t jitter_ms =
+              random::New64() % std::max<int64_t>(heartbeat_interval_ms, 1);
+          mutex_lock l(heartbeat_thread_shutdown_mu_);
+          heartbeat_thread_cv_.wait_for(l,
+                                        std::chrono::milliseconds(jitter_ms));
+          if (shutting_down_) {
+            return;
+          }
+        }
+
         while (true) {
           Status status;
           absl::Notification n;
@@ -16,9 +16,14 @@ limitations under the License.
 #include "tsl/framework/allocator.h"
 
 #include <atomic>
+#include <cstdlib>
+#include <map>
+#include <utility>
+#include <vector>
 
 #include "tsl/framework/allocator_registry.h"
 #include "tsl/framework/tracking_allocator.h"
+#include "tsl/platform/env_time.h"
 #include "tsl/platform/mem.h"
 #include "tsl/platform/mutex.h"
 #include "tsl/platform/strcat.h"
@@ -90,6 +95,112 @@ Allocator* cpu_allocator(int numa_node) {
   }
 }
 
+namespace {
+
+// FNV-1a, used as a cheap grouping key over the attribution strings.
+uint64 HashAnnotation(const char* op_name, const char* region_type) {
+  uint64 h = 0xcbf29ce484222325ULL;
+  auto mix = [&h](const char* s) {
+    if (s == nullptr) return;
+    for (; *s != '\0'; ++s) {
+      h = (h ^ static_cast<unsigned char>(*s)) * 0x100000001b3ULL;
+    }
+    // Separator so ("ab", "c") and ("a", "bc") hash differently.
+    h = (h ^ 0xff) * 0x100000001b3ULL;
+  };
+  mix(op_name);
+  mix(region_type);
+  return h;
+}
+
+int64_t ReadSampleIntervalFromEnv() {
+  const char* val = std::getenv("TF_ALLOCATION_SAMPLE_INTERVAL");
+  if (val == nullptr || *val == '\0') return 0;
+  char* end = nullptr;
+  int64_t interval = std::strtoll(val, &end, 10);
+  if (end == val || *end != '\0' || interval < 0) {
+    LOG(WARNING) << "Invalid TF_ALLOCATION_SAMPLE_INTERVAL value \"" << val
+                 << "\"; allocation sampling disabled.";
+    return 0;
+  }
+  return interval;
+}
+
+}  // namespace
+
+AllocationSampler* AllocationSampler::Global() {
+  static AllocationSampler* sampler = new AllocationSampler;
+  return sampler;
+}
+
+AllocationSampler::AllocationSampler()
+    : sample_interval_(ReadSampleIntervalFromEnv()) {
+  if (sample_interval_ > 0) {
+    LOG(INFO) << "Sampling one of every " << sample_interval_
+              << " allocations (TF_ALLOCATION_SAMPLE_INTERVAL).";
+  }
+}
+
+void AllocationSampler::Record(absl::string_view allocator_name,
+                               size_t alignment, size_t num_bytes,
+                               const char* op_name, int64_t step_id,
+                               const char* region_type) {
+  Sample sample;
+  sample.timestamp_ns = EnvTime::NowNanos();
+  sample.requested_bytes = static_cast<int64_t>(num_bytes);
+  sample.alignment = static_cast<int64_t>(alignment);
+  sample.allocator_name = std::string(allocator_name);
+  if (op_name != nullptr) sample.op_name = op_name;
+  if (region_type != nullptr) sample.region_type = region_type;
+  sample.step_id = step_id;
+  sample.annotation_hash = HashAnnotation(op_name, region_type);
+
+  mutex_lock l(mu_);
+  if (ring_.size() < kRingCapacity) {
+    ring_.push_back(std::move(sample));
+  } else {
+    ring_[next_slot_] = std::move(sample);
+  }
+  next_slot_ = (next_slot_ + 1) % kRingCapacity;
+  ++total_samples_;
+}
+
+std::vector<AllocationSampler::Sample> AllocationSampler::GetSamples() const {
+  mutex_lock l(mu_);
+  std::vector<Sample> samples;
+  samples.reserve(ring_.size());
+  if (ring_.size() < kRingCapacity) {
+    samples = ring_;
+  } else {
+    // next_slot_ is the oldest entry once the ring has wrapped.
+    samples.insert(samples.end(), ring_.begin() + next_slot_, ring_.end());
+    samples.insert(samples.end(), ring_.begin(), ring_.begin() + next_slot_);
+  }
+  return samples;
+}
+
+uint64 AllocationSampler::TotalSamples() const {
+  mutex_lock l(mu_);
+  return total_samples_;
+}
+
+std::string AllocationSampler::ToFoldedString() const {
+  std::vector<Sample> samples = GetSamples();
+  std::map<std::string, int64_t> bytes_by_frame;
+  for (const Sample& sample : samples) {
+    string frame = strings::StrCat(
+        sample.allocator_name, ";",
+        sample.op_name.empty() ? "(unknown op)" : sample.op_name, ";",
+        sample.region_type.empty() ? "(unknown region)" : sample.region_type);
+    bytes_by_frame[frame] += sample.requested_bytes;
+  }
+  string folded;
+  for (const auto& [frame, bytes] : bytes_by_frame) {
+    strings::StrAppend(&folded, frame, " ", bytes, "\n");
+  }
+  return folded;
+}
+
 SubAllocator::SubAllocator(const std::vector<Visitor>& alloc_visitors,
                            const std::vector<Visitor>& free_visitors)
     : alloc_visitors_(alloc_visitors), free_visitors_(free_visitors) {}
@@ -18,9 +18,12 @@ limitations under the License.
 
 #include <stdlib.h>
 
+#include <atomic>
 #include <functional>
 #include <limits>
 #include <optional>
+#include <string>
+#include <vector>
 
 #include "absl/strings/string_view.h"
 #include "absl/types/optional.h"
@@ -28,7 +31,9 @@ limitations under the License.
 #include "tsl/framework/type_traits.h"
 #include "tsl/platform/logging.h"
 #include "tsl/platform/macros.h"
+#include "tsl/platform/mutex.h"
 #include "tsl/platform/numa.h"
+#include "tsl/platform/thread_annotations.h"
 #include "tsl/platform/types.h"
 
 namespace tsl {
@@ -380,6 +385,85 @@ bool CPUAllocatorStatsEnabled();
 void EnableCPUAllocatorFullStats();
 bool CPUAllocatorFullStatsEnabled();
 
+// A low-overhead sampling profiler for allocation calls.  Unlike
+// TrackingAllocator, which wraps an allocator and records every allocation
+// while step stats are being collected, the sampler records every Nth
+// allocation process-wide into a fixed-size ring buffer and is cheap enough
+// to leave enabled for the lifetime of a job.
+//
+// Sampling is controlled by the environment variable
+// TF_ALLOCATION_SAMPLE_INTERVAL: a value of N > 0 records one of every N
+// allocations; 0 or unset disables sampling, in which case ShouldSample() is
+// a single relaxed atomic increment.
+//
+// Allocator implementations that participate call ShouldSample() on their
+// allocation path and, only when it returns true, gather whatever attribution
+// is available (e.g. the pending op from ScopedMemoryDebugAnnotation) and
+// call Record().
+class AllocationSampler {
+ public:
+  struct Sample {
+    // Wall time when the sample was recorded, in nanoseconds.
+    int64_t timestamp_ns = 0;
+    // Requested allocation size and alignment.
+    int64_t requested_bytes = 0;
+    int64_t alignment = 0;
+    // Name() of the allocator that served the allocation.
+    std::string allocator_name;
+    // Attribution from the active memory debug annotation, when available.
+    std::string op_name;
+    std::string region_type;
+    int64_t step_id = 0;
+    // Hash of the attribution strings, usable as a cheap grouping key where
+    // a true stack hash is unavailable.
+    uint64 annotation_hash = 0;
+  };
+
+  // Returns the process-wide sampler.  Never returns nullptr.
+  static AllocationSampler* Global();
+
+  // Returns true if the caller should record this allocation.  Safe to call
+  // concurrently from any thread; does not allocate.
+  bool ShouldSample() {
+    if (sample_interval_ <= 0) return false;
+    return counter_.fetch_add(1, std::memory_order_relaxed) %
+               sample_interval_ ==
+           0;
+  }
+
+  // Records one sampled allocation.  `op_name` and `region_type` may be
+  // nullptr or empty when no annotation is active.
+  void Record(absl::string_view allocator_name, size_t alignment,
+              size_t num_bytes, const char* op_name, int64_t step_id,
+              const char* region_type);
+
+  // Returns a snapshot of the retained samples, oldest first.  At most the
+  // most recent kRingCapacity samples are retained.
+  std::vector<Sample> GetSamples() const;
+
+  // Total number of samples recorded since process start, including samples
+  // that have since been evicted from the ring buffer.
+  uint64 TotalSamples() const;
+
+  // Renders the retained samples in collapsed-stack ("folded") form, one
+  // "allocator;op_name;region_type <sampled_bytes>" line per distinct
+  // attribution, suitable for direct consumption by flame graph tooling.
+  std::string ToFoldedString() const;
+
+  static constexpr int kRingCapacity = 4096;
+
+ private:
+  AllocationSampler();
+
+  const int64_t sample_interval_;
+  std::atomic<uint64> counter_{0};
+
+  mutable mutex mu_;
+  std::vector<Sample> ring_ TF_GUARDED_BY(mu_);
+  size_t next_slot_ TF_GUARDED_BY(mu_) = 0;
+  uint64 total_samples_ TF_GUARDED_BY(mu_) = 0;
+};
+
 // An object that does the underlying suballoc/free of memory for a higher-level
 // allocator.  The expectation is that the higher-level allocator is doing some
 // kind of cache or pool management so that it will call SubAllocator::Alloc and
@@ -379,6 +379,52 @@ bool BFCAllocator::DeallocateFreeRegions(size_t rounded_bytes)
   return true;
 }
 
+void BFCAllocator::MaybeReclaimFreeRegions() {
+  if (!opts_.garbage_collection ||
+      opts_.gc_free_bytes_watermark_fraction <= 0) {
+    return;
+  }
+
+  const int64_t free_bytes = *stats_.pool_bytes - stats_.bytes_in_use;
+  if (free_bytes < static_cast<int64_t>(
+                       opts_.gc_free_bytes_watermark_fraction *
+                       static_cast<double>(memory_limit_))) {
+    return;
+  }
+
+  absl::flat_hash_set<void*> free_region_ptrs;
+  for (const AllocationRegion& region : region_manager_.regions()) {
+    ChunkHandle h = region_manager_.get_handle(region.ptr());
+    bool any_use = false;
+    while (h != kInvalidChunkHandle) {
+      const Chunk* c = ChunkFromHandle(h);
+      if (c->in_use()) {
+        any_use = true;
+        break;
+      }
+      h = c->next;
+    }
+    if (!any_use) {
+      free_region_ptrs.insert(region.ptr());
+    }
+  }
+
+  // Keep the pool if nothing can be reclaimed, and don't tear down the whole
+  // pool when the allocator is merely idle between steps: returning every
+  // region would force the next step to re-acquire all of its memory from the
+  // suballocator.
+  if (free_region_ptrs.empty() ||
+      free_region_ptrs.size() == region_manager_.regions().size()) {
+    return;
+  }
+
+  VLOG(1) << "Proactive garbage collection: returning "
+          << free_region_ptrs.size() << " fully-free memory regions to the"
+          << " suballocator because free bytes (" << free_bytes
+          << ") exceeded the configured watermark.";
+  DeallocateRegions(free_region_ptrs);
+}
+
 void BFCAllocator::DeallocateRegions(
     const absl::flat_hash_set<void*>& region_ptrs)
     TF_EXCLUSIVE_LOCKS_REQUIRED(lock_) {
@@ -422,6 +468,14 @@ void* BFCAllocator::AllocateRawInternal(size_t unused_alignment,
     VLOG(2) << "tried to allocate 0 bytes";
     return nullptr;
   }
+  if (TF_PREDICT_FALSE(AllocationSampler::Global()->ShouldSample())) {
+    const auto& annotation =
+        tsl::profiler::ScopedMemoryDebugAnnotation::CurrentAnnotation();
+    AllocationSampler::Global()->Record(
+        Name(), unused_alignment, num_bytes, annotation.pending_op_name,
+        annotation.pending_step_id, annotation.pending_region_type);
+  }
+
   // First, always allocate memory of at least kMinAllocationSize
   // bytes, and always allocate multiples of kMinAllocationSize bytes
   // so all memory addresses are nicely byte aligned.
@@ -718,6 +772,8 @@ void BFCAllocator::DeallocateRawInternal(void* ptr) {
   // correct aggregation stats (bytes_in_use, fragmentation).
   AddTraceMe("MemoryDeallocation", chunk_ptr, req_bytes, alloc_bytes);
 
+  MaybeReclaimFreeRegions();
+
   if (VLOG_IS_ON(4)) {
     LOG(INFO) << "F: " << RenderOccupancy();
   }
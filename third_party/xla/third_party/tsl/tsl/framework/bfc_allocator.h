@@ -68,6 +68,14 @@ class BFCAllocator : public Allocator {
     // Controls when a chunk should be split, if its size exceeds the requested
     // allocation size.
     double fragmentation_fraction = 0;
+
+    // If positive, the fraction of the memory limit at which deallocations
+    // proactively return fully-free allocation regions to the sub-allocator,
+    // instead of waiting for an allocation failure to trigger garbage
+    // collection. This keeps long-running processes from stranding memory in
+    // fragmented regions. Only takes effect when `garbage_collection` is
+    // also true. Zero disables proactive reclamation.
+    double gc_free_bytes_watermark_fraction = 0;
   };
   BFCAllocator(std::unique_ptr<SubAllocator> sub_allocator, size_t total_memory,
                const string& name, const Options& opts);
@@ -462,6 +470,13 @@ class BFCAllocator : public Allocator {
   // found and freed; false otherwise.
   bool DeallocateFreeRegions(size_t rounded_bytes);
 
+  // If the bytes sitting in free chunks exceed the configured watermark
+  // fraction of the memory limit, returns fully-free regions to the
+  // suballocator without waiting for an allocation failure. Regions are only
+  // reclaimed while at least one other region is still in use, so an idle
+  // allocator does not thrash its entire pool between steps.
+  void MaybeReclaimFreeRegions() TF_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
   // Helper function to deallocate regions.
   void DeallocateRegions(const absl::flat_hash_set<void*>& region_ptrs)
       TF_EXCLUSIVE_LOCKS_REQUIRED(lock_);
@@ -86,6 +86,13 @@ class CPUAllocator : public Allocator {
     }
 
     void* p = port::AlignedMalloc(num_bytes, alignment);
+    if (TF_PREDICT_FALSE(AllocationSampler::Global()->ShouldSample())) {
+      const auto& annotation =
+          tsl::profiler::ScopedMemoryDebugAnnotation::CurrentAnnotation();
+      AllocationSampler::Global()->Record(
+          Name(), alignment, num_bytes, annotation.pending_op_name,
+          annotation.pending_step_id, annotation.pending_region_type);
+    }
     if (cpu_allocator_collect_stats) {
       const std::size_t alloc_size = port::MallocExtension_GetAllocatedSize(p);
       mutex_lock l(mu_);
@@ -15,21 +15,54 @@ limitations under the License.
 
 #include "tsl/lib/io/random_inputstream.h"
 
+#include <cstring>
 #include <memory>
 
 namespace tsl {
 namespace io {
 
 RandomAccessInputStream::RandomAccessInputStream(RandomAccessFile* file,
-                                                 bool owns_file)
-    : file_(file), owns_file_(owns_file) {}
+                                                 bool owns_file,
+                                                 int64_t readahead_bytes)
+    : file_(file),
+      owns_file_(owns_file),
+      readahead_bytes_(readahead_bytes > 0 ? readahead_bytes : 0) {
+  MaybePrefetch();
+}
 
 RandomAccessInputStream::~RandomAccessInputStream() {
+  if (prefetch_) {
+    // The chunk is shared with the ReadAsync callback, which may still be
+    // reading into it, so wait for it to complete before possibly deleting
+    // the file.
+    mutex_lock l(prefetch_->mu);
+    while (!prefetch_->done) {
+      prefetch_->cv.wait(l);
+    }
+  }
   if (owns_file_) {
     delete file_;
   }
 }
 
+void RandomAccessInputStream::MaybePrefetch() {
+  if (readahead_bytes_ == 0) {
+    return;
+  }
+  auto chunk = std::make_shared<PrefetchChunk>();
+  chunk->offset = pos_;
+  chunk->scratch.reset(new char[readahead_bytes_]);
+  prefetch_ = chunk;
+  file_->ReadAsync(pos_, readahead_bytes_, chunk->scratch.get(),
+                   [chunk](const Status& status, StringPiece data) {
+                     mutex_lock l(chunk->mu);
+                     chunk->status = status;
+                     chunk->data = data;
+                     chunk->done = true;
+                     chunk->cv.notify_all();
+                   });
+}
+
 Status RandomAccessInputStream::ReadNBytes(int64_t bytes_to_read,
                                            tstring* result) {
   if (bytes_to_read < 0) {
@@ -38,6 +71,51 @@ Status RandomAccessInputStream::ReadNBytes(int64_t bytes_to_read,
   result->clear();
   result->resize_uninitialized(bytes_to_read);
   char* result_buffer = &(*result)[0];
+  if (prefetch_ && pos_ >= prefetch_->offset &&
+      pos_ + bytes_to_read <= prefetch_->offset + readahead_bytes_) {
+    std::shared_ptr<PrefetchChunk> chunk = prefetch_;
+    Status status;
+    StringPiece chunk_data;
+    {
+      mutex_lock l(chunk->mu);
+      while (!chunk->done) {
+        chunk->cv.wait(l);
+      }
+      status = chunk->status;
+      chunk_data = chunk->data;
+    }
+    const int64_t skip = pos_ - chunk->offset;
+    if (status.ok() || errors::IsOutOfRange(status)) {
+      // Serve from the chunk if it fully covers the request, or if it ended
+      // at EOF (in which case a partial result is correct).
+      const int64_t available =
+          std::max<int64_t>(0, static_cast<int64_t>(chunk_data.size()) - skip);
+      if (available >= bytes_to_read || errors::IsOutOfRange(status)) {
+        const int64_t n = std::min<int64_t>(available, bytes_to_read);
+        if (n > 0) {
+          memcpy(result_buffer, chunk_data.data() + skip, n);
+        }
+        result->resize(n);
+        pos_ += n;
+        // The chunk is consumed once the caller has read up to its end;
+        // start fetching the next one so it overlaps with processing.
+        if (pos_ >= chunk->offset + static_cast<int64_t>(chunk_data.size())) {
+          prefetch_ = nullptr;
+          if (status.ok()) {
+            MaybePrefetch();
+          }
+        }
+        return n < bytes_to_read ? status : OkStatus();
+      }
+    }
+    // Short read without EOF, or a real error: drop the chunk and fall back
+    // to a synchronous read, which reports its own status.
+    prefetch_ = nullptr;
+  } else if (prefetch_) {
+    // The request does not fit inside the in-flight chunk (e.g. it starts
+    // before it or extends past it); discard the chunk.
+    prefetch_ = nullptr;
+  }
   StringPiece data;
   Status s = file_->Read(pos_, bytes_to_read, &data, result_buffer);
   if (data.data() != result_buffer) {
@@ -47,6 +125,9 @@ Status RandomAccessInputStream::ReadNBytes(int64_t bytes_to_read,
   if (s.ok() || errors::IsOutOfRange(s)) {
     pos_ += data.size();
   }
+  if (s.ok()) {
+    MaybePrefetch();
+  }
   return s;
 }
 
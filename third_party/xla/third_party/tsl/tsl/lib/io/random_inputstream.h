@@ -16,9 +16,13 @@ limitations under the License.
 #ifndef TENSORFLOW_TSL_LIB_IO_RANDOM_INPUTSTREAM_H_
 #define TENSORFLOW_TSL_LIB_IO_RANDOM_INPUTSTREAM_H_
 
+#include <memory>
+
 #include "tsl/lib/io/inputstream_interface.h"
 #include "tsl/platform/cord.h"
 #include "tsl/platform/file_system.h"
+#include "tsl/platform/mutex.h"
+#include "tsl/platform/thread_annotations.h"
 
 namespace tsl {
 namespace io {
@@ -29,7 +33,15 @@ class RandomAccessInputStream : public InputStreamInterface {
  public:
   // Does not take ownership of 'file' unless owns_file is set to true. 'file'
   // must outlive *this.
-  RandomAccessInputStream(RandomAccessFile* file, bool owns_file = false);
+  //
+  // If 'readahead_bytes' is > 0, the stream asynchronously prefetches the
+  // next 'readahead_bytes' of the file via RandomAccessFile::ReadAsync()
+  // while the caller consumes the current data, overlapping I/O with
+  // processing for sequential readers. Reads that fall inside the prefetched
+  // chunk are served from it; any other read falls back to a synchronous
+  // file read.
+  RandomAccessInputStream(RandomAccessFile* file, bool owns_file = false,
+                          int64_t readahead_bytes = 0);
 
   ~RandomAccessInputStream();
 
@@ -44,6 +56,7 @@ class RandomAccessInputStream : public InputStreamInterface {
   int64_t Tell() const override;
 
   Status Seek(int64_t position) {
+    prefetch_ = nullptr;
     pos_ = position;
     return OkStatus();
   }
@@ -51,9 +64,28 @@ class RandomAccessInputStream : public InputStreamInterface {
   Status Reset() override { return Seek(0); }
 
  private:
+  // One in-flight or completed asynchronous read-ahead chunk. Shared with the
+  // ReadAsync callback so that a dropped chunk stays valid until its read
+  // completes.
+  struct PrefetchChunk {
+    mutex mu;
+    condition_variable cv;
+    bool done TF_GUARDED_BY(mu) = false;
+    Status status TF_GUARDED_BY(mu);
+    StringPiece data TF_GUARDED_BY(mu);
+    int64_t offset = 0;  // File offset of the chunk. Const after creation.
+    std::unique_ptr<char[]> scratch;
+  };
+
+  // Starts prefetching 'readahead_bytes_' at 'pos_' unless a usable chunk is
+  // already in flight. No-op when read-ahead is disabled.
+  void MaybePrefetch();
+
   RandomAccessFile* file_;  // Not owned.
   int64_t pos_ = 0;         // Tracks where we are in the file.
   bool owns_file_ = false;
+  int64_t readahead_bytes_ = 0;
+  std::shared_ptr<PrefetchChunk> prefetch_;
 };
 
 }  // namespace io
@@ -142,6 +142,57 @@ TEST(RandomInputStream, Seek) {
   EXPECT_EQ(5, in.Tell());
 }
 
+TEST(RandomInputStream, ReadNBytesWithReadahead) {
+  Env* env = Env::Default();
+  string fname = testing::TmpDir() + "/random_inputbuffer_readahead_test";
+  TF_ASSERT_OK(WriteStringToFile(env, fname, "0123456789"));
+
+  std::unique_ptr<RandomAccessFile> file;
+  TF_ASSERT_OK(env->NewRandomAccessFile(fname, &file));
+  tstring read;
+  RandomAccessInputStream in(file.get(), /*owns_file=*/false,
+                             /*readahead_bytes=*/4);
+  // Reads within the prefetched chunk, crossing into the next chunk, and
+  // past end of file all behave exactly as without read-ahead.
+  TF_ASSERT_OK(in.ReadNBytes(3, &read));
+  EXPECT_EQ(read, "012");
+  EXPECT_EQ(3, in.Tell());
+  TF_ASSERT_OK(in.ReadNBytes(1, &read));
+  EXPECT_EQ(read, "3");
+  EXPECT_EQ(4, in.Tell());
+  TF_ASSERT_OK(in.ReadNBytes(5, &read));
+  EXPECT_EQ(read, "45678");
+  EXPECT_EQ(9, in.Tell());
+  EXPECT_TRUE(errors::IsOutOfRange(in.ReadNBytes(20, &read)));
+  EXPECT_EQ(read, "9");
+  EXPECT_EQ(10, in.Tell());
+}
+
+TEST(RandomInputStream, SeekWithReadahead) {
+  Env* env = Env::Default();
+  string fname = testing::TmpDir() + "/random_inputbuffer_readahead_seek_test";
+  TF_ASSERT_OK(WriteStringToFile(env, fname, "0123456789"));
+
+  std::unique_ptr<RandomAccessFile> file;
+  TF_ASSERT_OK(env->NewRandomAccessFile(fname, &file));
+  tstring read;
+  RandomAccessInputStream in(file.get(), /*owns_file=*/false,
+                             /*readahead_bytes=*/4);
+  TF_ASSERT_OK(in.ReadNBytes(2, &read));
+  EXPECT_EQ(read, "01");
+
+  // Seeking invalidates the prefetched chunk in both directions.
+  TF_ASSERT_OK(in.Seek(6));
+  TF_ASSERT_OK(in.ReadNBytes(3, &read));
+  EXPECT_EQ(read, "678");
+  EXPECT_EQ(9, in.Tell());
+
+  TF_ASSERT_OK(in.Seek(1));
+  TF_ASSERT_OK(in.ReadNBytes(4, &read));
+  EXPECT_EQ(read, "1234");
+  EXPECT_EQ(5, in.Tell());
+}
+
 }  // anonymous namespace
 }  // namespace io
 }  // namespace tsl
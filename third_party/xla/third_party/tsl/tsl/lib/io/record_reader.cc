@@ -24,10 +24,31 @@ limitations under the License.
 #include "tsl/platform/env.h"
 #include "tsl/platform/errors.h"
 #include "tsl/platform/raw_coding.h"
+#include "tsl/util/env_var.h"
 
 namespace tsl {
 namespace io {
 
+namespace {
+
+// Whether buffered readers should asynchronously prefetch the next buffer of
+// the file via RandomAccessFile::ReadAsync() while the current one is being
+// consumed. Off by default; enable with TF_RECORD_READER_ASYNC_READAHEAD=true.
+bool AsyncReadaheadEnabled() {
+  static const bool enabled = [] {
+    bool b = false;
+    Status s = ReadBoolFromEnvVar("TF_RECORD_READER_ASYNC_READAHEAD",
+                                  /*default_val=*/false, &b);
+    if (!s.ok()) {
+      LOG(ERROR) << s.message();
+    }
+    return b;
+  }();
+  return enabled;
+}
+
+}  // namespace
+
 RecordReaderOptions RecordReaderOptions::CreateRecordReaderOptions(
     const string& compression_type) {
   RecordReaderOptions options;
@@ -57,9 +78,17 @@ RecordReaderOptions RecordReaderOptions::CreateRecordReaderOptions(
 RecordReader::RecordReader(RandomAccessFile* file,
                            const RecordReaderOptions& options)
     : options_(options),
-      input_stream_(new RandomAccessInputStream(file)),
+      input_stream_(new RandomAccessInputStream(
+          file, /*owns_file=*/false,
+          /*readahead_bytes=*/
+          (options.buffer_size > 0 && AsyncReadaheadEnabled())
+              ? options.buffer_size
+              : 0)),
       last_read_failed_(false) {
   if (options.buffer_size > 0) {
+    // BufferedInputStream refills in fixed 'buffer_size' chunks, so with
+    // read-ahead enabled each refill is served from the chunk prefetched
+    // while the previous buffer was being consumed.
     input_stream_.reset(new BufferedInputStream(input_stream_.release(),
                                                 options.buffer_size, true));
   }
@@ -255,6 +284,62 @@ Status RecordReader::SkipRecords(uint64* offset, int num_to_skip,
   return OkStatus();
 }
 
+Status MemoryRegionRecordReader::ReadHeader(uint64 offset,
+                                            uint64* length) const {
+  if (offset + RecordReader::kHeaderSize > file_image_.size()) {
+    return errors::DataLoss("truncated record at ", offset);
+  }
+  const char* header = file_image_.data() + offset;
+  const uint32 masked_crc = core::DecodeFixed32(header + sizeof(uint64));
+  if (crc32c::Unmask(masked_crc) != crc32c::Value(header, sizeof(uint64))) {
+    return errors::DataLoss("corrupted record at ", offset);
+  }
+  *length = core::DecodeFixed64(header);
+  return OkStatus();
+}
+
+Status MemoryRegionRecordReader::ReadRecord(uint64* offset,
+                                            StringPiece* record) {
+  if (*offset >= file_image_.size()) {
+    return errors::OutOfRange("eof");
+  }
+  uint64 length;
+  TF_RETURN_IF_ERROR(ReadHeader(*offset, &length));
+  const uint64 record_size =
+      RecordReader::kHeaderSize + length + RecordReader::kFooterSize;
+  if (*offset + record_size > file_image_.size()) {
+    return errors::DataLoss("truncated record at ", *offset);
+  }
+  const char* data = file_image_.data() + *offset + RecordReader::kHeaderSize;
+  const uint32 masked_crc = core::DecodeFixed32(data + length);
+  if (crc32c::Unmask(masked_crc) != crc32c::Value(data, length)) {
+    return errors::DataLoss("corrupted record at ", *offset);
+  }
+  *record = StringPiece(data, length);
+  *offset += record_size;
+  return OkStatus();
+}
+
+Status MemoryRegionRecordReader::SkipRecords(uint64* offset, int num_to_skip,
+                                             int* num_skipped) {
+  *num_skipped = 0;
+  for (int i = 0; i < num_to_skip; ++i) {
+    if (*offset >= file_image_.size()) {
+      return errors::OutOfRange("eof");
+    }
+    uint64 length;
+    TF_RETURN_IF_ERROR(ReadHeader(*offset, &length));
+    const uint64 record_size =
+        RecordReader::kHeaderSize + length + RecordReader::kFooterSize;
+    if (*offset + record_size > file_image_.size()) {
+      return errors::DataLoss("truncated record at ", *offset);
+    }
+    *offset += record_size;
+    ++*num_skipped;
+  }
+  return OkStatus();
+}
+
 SequentialRecordReader::SequentialRecordReader(
     RandomAccessFile* file, const RecordReaderOptions& options)
     : underlying_(file, options), offset_(0) {}
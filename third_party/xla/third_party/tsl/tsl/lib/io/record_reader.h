@@ -128,6 +128,42 @@ class RecordReader {
   void operator=(const RecordReader&) = delete;
 };
 
+// Reads TFRecords from a file image that is fully resident in the address
+// space, typically an mmap'ed ReadOnlyMemoryRegion. Records are returned as
+// zero-copy views into the image, so no per-record buffer is allocated; the
+// image must outlive every returned view.
+//
+// Only uncompressed files are supported, since compressed records cannot be
+// viewed in place.
+//
+// Note: this class is not thread safe; external synchronization required.
+class MemoryRegionRecordReader {
+ public:
+  // "file_image" must contain the entire file and remain live (and unchanged)
+  // while this reader and any record views obtained from it are in use.
+  explicit MemoryRegionRecordReader(StringPiece file_image)
+      : file_image_(file_image) {}
+
+  // Read the record at "*offset" as a view into the file image and update
+  // *offset to point to the offset of the next record. Returns OK on
+  // success, OUT_OF_RANGE for end of file, or DATA_LOSS for a corrupt file.
+  Status ReadRecord(uint64* offset, StringPiece* record);
+
+  // Skip num_to_skip records starting at "*offset", validating only the
+  // record headers. "*num_skipped" is set to the number of records actually
+  // skipped, as in RecordReader::SkipRecords.
+  Status SkipRecords(uint64* offset, int num_to_skip, int* num_skipped);
+
+ private:
+  // Validates the header at "offset" and returns the record's data length.
+  Status ReadHeader(uint64 offset, uint64* length) const;
+
+  const StringPiece file_image_;
+
+  MemoryRegionRecordReader(const MemoryRegionRecordReader&) = delete;
+  void operator=(const MemoryRegionRecordReader&) = delete;
+};
+
 // High-level interface to read TFRecord files.
 //
 // Note: this class is not thread safe; external synchronization required.
@@ -162,6 +162,65 @@ TEST(RecordReaderWriterTest, TestBasics) {
   }
 }
 
+TEST(RecordReaderWriterTest, TestMemoryRegionReader) {
+  Env* env = Env::Default();
+  string fname = testing::TmpDir() + "/record_reader_writer_mmap_test";
+
+  {
+    std::unique_ptr<WritableFile> file;
+    TF_CHECK_OK(env->NewWritableFile(fname, &file));
+    io::RecordWriter writer(file.get());
+    TF_EXPECT_OK(writer.WriteRecord("abc"));
+    TF_EXPECT_OK(writer.WriteRecord("defg"));
+    TF_EXPECT_OK(writer.WriteRecord("hij"));
+    TF_CHECK_OK(writer.Flush());
+  }
+
+  string file_image;
+  TF_CHECK_OK(ReadFileToString(env, fname, &file_image));
+
+  {
+    io::MemoryRegionRecordReader reader(file_image);
+    uint64 offset = 0;
+    StringPiece record;
+    TF_CHECK_OK(reader.ReadRecord(&offset, &record));
+    EXPECT_EQ("abc", record);
+    TF_CHECK_OK(reader.ReadRecord(&offset, &record));
+    EXPECT_EQ("defg", record);
+    TF_CHECK_OK(reader.ReadRecord(&offset, &record));
+    EXPECT_EQ("hij", record);
+    EXPECT_TRUE(errors::IsOutOfRange(reader.ReadRecord(&offset, &record)));
+    EXPECT_EQ(file_image.size(), offset);
+  }
+
+  {
+    io::MemoryRegionRecordReader reader(file_image);
+    uint64 offset = 0;
+    int num_skipped;
+    TF_CHECK_OK(reader.SkipRecords(&offset, 2, &num_skipped));
+    EXPECT_EQ(2, num_skipped);
+    StringPiece record;
+    TF_CHECK_OK(reader.ReadRecord(&offset, &record));
+    EXPECT_EQ("hij", record);
+    EXPECT_TRUE(errors::IsOutOfRange(reader.SkipRecords(&offset, 1,
+                                                        &num_skipped)));
+    EXPECT_EQ(0, num_skipped);
+  }
+
+  {
+    // Corrupt a data byte of the second record; the first record still reads.
+    string corrupt = file_image;
+    corrupt[io::RecordReader::kHeaderSize * 2 + 3 +
+            io::RecordReader::kFooterSize] ^= 0xff;
+    io::MemoryRegionRecordReader reader(corrupt);
+    uint64 offset = 0;
+    StringPiece record;
+    TF_CHECK_OK(reader.ReadRecord(&offset, &record));
+    EXPECT_EQ("abc", record);
+    EXPECT_TRUE(errors::IsDataLoss(reader.ReadRecord(&offset, &record)));
+  }
+}
+
 TEST(RecordReaderWriterTest, TestSkipBasic) {
   Env* env = Env::Default();
   string fname = testing::TmpDir() + "/record_reader_writer_skip_basic_test";
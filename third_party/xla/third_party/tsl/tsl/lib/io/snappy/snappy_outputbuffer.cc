@@ -16,10 +16,42 @@ limitations under the License.
 #include "tsl/lib/io/snappy/snappy_outputbuffer.h"
 
 #include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "tsl/platform/blocking_counter.h"
+#include "tsl/platform/threadpool.h"
 
 namespace tsl {
 namespace io {
 
+namespace {
+
+// Maximum number of input bytes compressed into a single framed block when
+// parallel compression is enabled. Each sub-block becomes an ordinary
+// length-prefixed block, so readers are unaffected; bounding the block size
+// also bounds the per-block allocation on the read side.
+constexpr size_t kParallelCompressionBlockBytes = 1 << 20;
+
+// Shared worker pool for block compression, enabled by setting
+// TF_SNAPPY_PARALLEL_COMPRESSION_THREADS to a value greater than 1. Returns
+// nullptr (compress on the writer thread) when disabled.
+thread::ThreadPool* SnappyCompressionPool() {
+  static thread::ThreadPool* pool = []() -> thread::ThreadPool* {
+    const char* val = std::getenv("TF_SNAPPY_PARALLEL_COMPRESSION_THREADS");
+    if (val == nullptr) return nullptr;
+    char* endptr;
+    const long threads = strtol(val, &endptr, 10);  // NOLINT
+    if (*endptr != '\0' || threads <= 1) return nullptr;
+    return new thread::ThreadPool(Env::Default(), "snappy_compress",
+                                  static_cast<int>(threads));
+  }();
+  return pool;
+}
+
+}  // namespace
+
 SnappyOutputBuffer::SnappyOutputBuffer(WritableFile* file,
                                        int32_t input_buffer_bytes,
                                        int32_t output_buffer_bytes)
@@ -190,15 +222,7 @@ Status SnappyOutputBuffer::FlushOutputBufferToFile() {
   return OkStatus();
 }
 
-Status SnappyOutputBuffer::Deflate() {
-  if (avail_in_ == 0) {
-    return OkStatus();
-  }
-  string output;
-  if (!port::Snappy_Compress(next_in_, avail_in_, &output)) {
-    return errors::DataLoss("Snappy_Compress failed");
-  }
-
+Status SnappyOutputBuffer::EmitCompressedBlock(const string& output) {
   // Write length of compressed block to output buffer.
   char compressed_length_array[4];
   std::fill(compressed_length_array, compressed_length_array + 4, 0);
@@ -209,7 +233,51 @@ Status SnappyOutputBuffer::Deflate() {
   TF_RETURN_IF_ERROR(AddToOutputBuffer(compressed_length_array, 4));
 
   // Write compressed output to buffer.
-  TF_RETURN_IF_ERROR(AddToOutputBuffer(output.data(), output.size()));
+  return AddToOutputBuffer(output.data(), output.size());
+}
+
+Status SnappyOutputBuffer::Deflate() {
+  if (avail_in_ == 0) {
+    return OkStatus();
+  }
+
+  thread::ThreadPool* pool = SnappyCompressionPool();
+  if (pool != nullptr && avail_in_ > kParallelCompressionBlockBytes) {
+    // Carve the input into bounded blocks, compress them concurrently and
+    // frame the compressed blocks in input order.
+    const size_t num_blocks = (avail_in_ + kParallelCompressionBlockBytes - 1) /
+                              kParallelCompressionBlockBytes;
+    std::vector<string> outputs(num_blocks);
+    std::vector<char> ok(num_blocks, 0);
+    BlockingCounter counter(num_blocks);
+    for (size_t i = 0; i < num_blocks; ++i) {
+      const char* block = next_in_ + i * kParallelCompressionBlockBytes;
+      const size_t block_size =
+          std::min(kParallelCompressionBlockBytes,
+                   avail_in_ - i * kParallelCompressionBlockBytes);
+      pool->Schedule([block, block_size, i, &outputs, &ok, &counter]() {
+        ok[i] = port::Snappy_Compress(block, block_size, &outputs[i]);
+        counter.DecrementCount();
+      });
+    }
+    counter.Wait();
+    for (size_t i = 0; i < num_blocks; ++i) {
+      if (!ok[i]) {
+        return errors::DataLoss("Snappy_Compress failed");
+      }
+      TF_RETURN_IF_ERROR(EmitCompressedBlock(outputs[i]));
+    }
+    next_in_ += avail_in_;
+    avail_in_ = 0;
+    return OkStatus();
+  }
+
+  string output;
+  if (!port::Snappy_Compress(next_in_, avail_in_, &output)) {
+    return errors::DataLoss("Snappy_Compress failed");
+  }
+
+  TF_RETURN_IF_ERROR(EmitCompressedBlock(output));
   next_in_ += avail_in_;
   avail_in_ = 0;
 
@@ -128,10 +128,17 @@ class SnappyOutputBuffer : public WritableFile {
   Status FlushOutputBufferToFile();
 
   // Compresses `avail_in_` bytes at `next_in_` location in `input_buffer_` and
-  // writes the results to output using `AddToOutputBuffer`.
+  // writes the results to output using `AddToOutputBuffer`. Large inputs are
+  // split into bounded blocks compressed on a shared worker pool when
+  // TF_SNAPPY_PARALLEL_COMPRESSION_THREADS is set; the framed output format is
+  // unchanged either way.
   // Returns non-OK status if writing to file failed.
   Status Deflate();
 
+  // Writes one compressed block to the output, preceded by its length encoded
+  // in 4 bytes (little endian).
+  Status EmitCompressedBlock(const string& output);
+
   WritableFile* file_;  // Not owned
 
   // Buffer for storing contents read from input `file_`.
@@ -94,6 +94,12 @@ class FileBlockCache {
   virtual Status Read(const string& filename, size_t offset, size_t n,
                       char* buffer, size_t* bytes_transferred) = 0;
 
+  /// Hint that the byte range [offset, offset + n) of `filename` is likely to
+  /// be read soon. Implementations may fetch the covered blocks into the cache
+  /// in the background; the hint is best-effort and any fetch errors are
+  /// surfaced by a subsequent Read. The default implementation does nothing.
+  virtual void Prefetch(const string& filename, size_t offset, size_t n) {}
+
   // Validate the given file signature with the existing file signature in the
   // cache. Returns true if the signature doesn't change or the file did not
   // exist before. If the signature changes, update the existing signature with
@@ -62,6 +62,11 @@ constexpr size_t kDefaultMaxCacheSize = 0;
 // will be evicted on the next read.
 constexpr char kMaxStaleness[] = "GCS_READ_CACHE_MAX_STALENESS";
 constexpr uint64 kDefaultMaxStaleness = 0;
+// The environment variable that overrides the number of blocks the block cache
+// fetches ahead of a sequential reader, in parallel ranged reads. A value of 0
+// (the default) disables prefetching.
+constexpr char kPrefetchBlocks[] = "GCS_READ_CACHE_PREFETCH_BLOCKS";
+constexpr size_t kDefaultPrefetchBlocks = 0;
 
 // Helper function to extract an environment variable and convert it into a
 // value of type T.
@@ -415,6 +420,10 @@ class GcsFileSystem : public FileSystem {
   // Reads smaller than block_size_ will trigger a read of block_size_.
   uint64 block_size_;
 
+  // The number of blocks the block cache fetches ahead of a sequential
+  // reader. 0 disables prefetching.
+  size_t prefetch_blocks_ = kDefaultPrefetchBlocks;
+
   // block_cache_lock_ protects the file_block_cache_ pointer (Note that
   // FileBlockCache instances are themselves threadsafe).
   mutex block_cache_lock_;
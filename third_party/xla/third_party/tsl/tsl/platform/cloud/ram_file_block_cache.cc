@@ -184,6 +184,19 @@ Status RamFileBlockCache::Read(const string& filename, size_t offset, size_t n,
   if (finish < offset + n) {
     finish += block_size_;
   }
+  if (prefetch_blocks_ > 0) {
+    // If this read continues where the previous read of the file left off,
+    // the file is being read sequentially; start fetching the blocks ahead
+    // of it while the blocks below are read.
+    mutex_lock lock(mu_);
+    auto it = sequential_end_map_.find(filename);
+    const bool sequential =
+        offset == 0 || (it != sequential_end_map_.end() && it->second == offset);
+    sequential_end_map_[filename] = offset + n;
+    if (sequential) {
+      EnqueuePrefetch(filename, finish, prefetch_blocks_ * block_size_);
+    }
+  }
   size_t total_bytes_transferred = 0;
   // Now iterate through the blocks, reading them one at a time.
   for (size_t pos = start; pos < finish; pos += block_size_) {
@@ -229,6 +242,95 @@ Status RamFileBlockCache::Read(const string& filename, size_t offset, size_t n,
   return OkStatus();
 }
 
+void RamFileBlockCache::Prefetch(const string& filename, size_t offset,
+                                 size_t n) {
+  if (prefetch_blocks_ == 0 || n == 0) {
+    return;
+  }
+  mutex_lock lock(mu_);
+  EnqueuePrefetch(filename, offset, n);
+}
+
+void RamFileBlockCache::EnqueuePrefetch(const string& filename, size_t offset,
+                                        size_t n) {
+  if (n == 0) {
+    return;
+  }
+  size_t start = block_size_ * (offset / block_size_);
+  size_t finish = block_size_ * ((offset + n) / block_size_);
+  if (finish < offset + n) {
+    finish += block_size_;
+  }
+  bool queued = false;
+  for (size_t pos = start; pos < finish; pos += block_size_) {
+    Key key = std::make_pair(filename, pos);
+    if (block_map_.count(key) > 0 || prefetch_pending_.count(key) > 0) {
+      // Cached, in flight, or already queued.
+      continue;
+    }
+    prefetch_queue_.push_back(key);
+    prefetch_pending_.insert(key);
+    queued = true;
+  }
+  if (queued) {
+    prefetch_cond_var_.notify_all();
+  }
+}
+
+void RamFileBlockCache::PrefetchLoop() {
+  while (true) {
+    Key key;
+    {
+      mutex_lock lock(mu_);
+      while (prefetch_queue_.empty() && !stop_prefetch_threads_) {
+        prefetch_cond_var_.wait(lock);
+      }
+      if (stop_prefetch_threads_) {
+        return;
+      }
+      key = prefetch_queue_.front();
+      prefetch_queue_.pop_front();
+    }
+    std::shared_ptr<Block> block = Lookup(key);
+    DCHECK(block) << "No block for key " << key.first << "@" << key.second;
+    Status status = MaybeFetch(key, block);
+    if (status.ok()) {
+      status = UpdateLRU(key, block);
+    } else {
+      // The hint is best-effort; a subsequent Read of the block will retry
+      // and surface the error.
+      VLOG(1) << "Prefetch of block at offset " << key.second << " in file "
+              << key.first << " failed: " << status;
+    }
+    // The data vector may be read without the block's lock once the state is
+    // FINISHED.
+    const bool partial =
+        status.ok() && block->data.size() < block_size_;
+    mutex_lock lock(mu_);
+    prefetch_pending_.erase(key);
+    if (partial) {
+      // The block hit EOF, so drop any queued blocks of the file past it.
+      for (auto it = prefetch_queue_.begin(); it != prefetch_queue_.end();) {
+        if (it->first == key.first && it->second > key.second) {
+          prefetch_pending_.erase(*it);
+          it = prefetch_queue_.erase(it);
+        } else {
+          ++it;
+        }
+      }
+      if (block->data.empty()) {
+        // The block starts at or past EOF. Remove it so that it is not
+        // mistaken for the last block of the file by the consistency check
+        // in UpdateLRU.
+        auto entry = block_map_.find(key);
+        if (entry != block_map_.end() && entry->second == block) {
+          RemoveBlock(entry);
+        }
+      }
+    }
+  }
+}
+
 bool RamFileBlockCache::ValidateAndUpdateFileSignature(const string& filename,
                                                        int64_t file_signature) {
   mutex_lock lock(mu_);
@@ -274,6 +376,7 @@ void RamFileBlockCache::Flush() {
   lru_list_.clear();
   lra_list_.clear();
   cache_size_ = 0;
+  sequential_end_map_.clear();
 }
 
 void RamFileBlockCache::RemoveFile(const string& filename) {
@@ -282,6 +385,7 @@ void RamFileBlockCache::RemoveFile(const string& filename) {
 }
 
 void RamFileBlockCache::RemoveFile_Locked(const string& filename) {
+  sequential_end_map_.erase(filename);
   Key begin = std::make_pair(filename, 0);
   auto it = block_map_.lower_bound(begin);
   while (it != block_map_.end() && it->first.first == filename) {
@@ -16,10 +16,12 @@ limitations under the License.
 #ifndef TENSORFLOW_TSL_PLATFORM_CLOUD_RAM_FILE_BLOCK_CACHE_H_
 #define TENSORFLOW_TSL_PLATFORM_CLOUD_RAM_FILE_BLOCK_CACHE_H_
 
+#include <deque>
 #include <functional>
 #include <list>
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -50,22 +52,41 @@ class RamFileBlockCache : public FileBlockCache {
                                size_t* bytes_transferred)>
       BlockFetcher;
 
+  /// If `prefetch_blocks` is > 0, the cache detects sequential access per file
+  /// and fetches up to `prefetch_blocks` blocks ahead of the reader in the
+  /// background, issuing one ranged read per block in parallel. Prefetch() can
+  /// additionally be used to hint arbitrary ranges.
   RamFileBlockCache(size_t block_size, size_t max_bytes, uint64 max_staleness,
-                    BlockFetcher block_fetcher, Env* env = Env::Default())
+                    BlockFetcher block_fetcher, size_t prefetch_blocks = 0,
+                    Env* env = Env::Default())
       : block_size_(block_size),
         max_bytes_(max_bytes),
         max_staleness_(max_staleness),
         block_fetcher_(block_fetcher),
+        prefetch_blocks_(IsCacheEnabled() ? prefetch_blocks : 0),
         env_(env) {
     if (max_staleness_ > 0) {
       pruning_thread_.reset(env_->StartThread(ThreadOptions(), "TF_prune_FBC",
                                               [this] { Prune(); }));
     }
+    for (size_t i = 0; i < prefetch_blocks_; i++) {
+      prefetch_threads_.emplace_back(env_->StartThread(
+          ThreadOptions(), "TF_prefetch_FBC", [this] { PrefetchLoop(); }));
+    }
     VLOG(1) << "GCS file block cache is "
             << (IsCacheEnabled() ? "enabled" : "disabled");
   }
 
   ~RamFileBlockCache() override {
+    if (!prefetch_threads_.empty()) {
+      {
+        mutex_lock lock(mu_);
+        stop_prefetch_threads_ = true;
+      }
+      prefetch_cond_var_.notify_all();
+      // Destroying the threads will block until every PrefetchLoop() returns.
+      prefetch_threads_.clear();
+    }
     if (pruning_thread_) {
       stop_pruning_thread_.Notify();
       // Destroying pruning_thread_ will block until Prune() receives the above
@@ -91,6 +112,12 @@ class RamFileBlockCache : public FileBlockCache {
   Status Read(const string& filename, size_t offset, size_t n, char* buffer,
               size_t* bytes_transferred) override;
 
+  /// Enqueue background fetches for the blocks covering [offset, offset + n)
+  /// of `filename` that are not already cached or in flight. No-op unless the
+  /// cache was constructed with prefetch_blocks > 0.
+  void Prefetch(const string& filename, size_t offset, size_t n) override
+      TF_LOCKS_EXCLUDED(mu_);
+
   // Validate the given file signature with the existing file signature in the
   // cache. Returns true if the signature doesn't change or the file doesn't
   // exist before. If the signature changes, update the existing signature with
@@ -129,6 +156,9 @@ class RamFileBlockCache : public FileBlockCache {
   const uint64 max_staleness_;
   /// The callback to read a block from the underlying filesystem.
   const BlockFetcher block_fetcher_;
+  /// The number of blocks to fetch ahead of a sequential reader, as well as
+  /// the number of background prefetch threads.
+  const size_t prefetch_blocks_;
   /// The Env from which we read timestamps.
   Env* const env_;  // not owned
 
@@ -215,9 +245,21 @@ class RamFileBlockCache : public FileBlockCache {
   /// cache size accordingly.
   void RemoveBlock(BlockMap::iterator entry) TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
 
+  /// Enqueue the blocks covering [offset, offset + n) of `filename` for
+  /// background fetching, skipping blocks that are cached or already queued.
+  void EnqueuePrefetch(const string& filename, size_t offset, size_t n)
+      TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  /// The loop run by the background prefetch threads, which fetch queued
+  /// blocks until the cache is destroyed.
+  void PrefetchLoop() TF_LOCKS_EXCLUDED(mu_);
+
   /// The cache pruning thread that removes files with expired blocks.
   std::unique_ptr<Thread> pruning_thread_;
 
+  /// The background threads fetching queued prefetch blocks.
+  std::vector<std::unique_ptr<Thread>> prefetch_threads_;
+
   /// Notification for stopping the cache pruning thread.
   Notification stop_pruning_thread_;
 
@@ -243,6 +285,25 @@ class RamFileBlockCache : public FileBlockCache {
 
   // A filename->file_signature map.
   std::map<string, int64_t> file_signature_map_ TF_GUARDED_BY(mu_);
+
+  /// The queue of blocks to prefetch, consumed by the prefetch threads.
+  std::deque<Key> prefetch_queue_ TF_GUARDED_BY(mu_);
+
+  /// The blocks that are queued or currently being prefetched, to avoid
+  /// enqueueing the same block twice.
+  std::set<Key> prefetch_pending_ TF_GUARDED_BY(mu_);
+
+  /// Signalled when a block is queued for prefetching or the cache is being
+  /// destroyed.
+  condition_variable prefetch_cond_var_;
+
+  /// Tells the prefetch threads to exit.
+  bool stop_prefetch_threads_ TF_GUARDED_BY(mu_) = false;
+
+  /// A filename->offset map recording where the last sequential read of each
+  /// file ended, used to detect sequential access. Entries are dropped when
+  /// the file is removed from the cache.
+  std::map<string, size_t> sequential_end_map_ TF_GUARDED_BY(mu_);
 };
 
 }  // namespace tsl
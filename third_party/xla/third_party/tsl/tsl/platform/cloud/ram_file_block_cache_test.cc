@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "tsl/platform/cloud/ram_file_block_cache.h"
 
+#include <atomic>
 #include <cstring>
 
 #include "tsl/lib/core/status_test_util.h"
@@ -330,7 +331,8 @@ TEST(RamFileBlockCacheTest, MaxStaleness) {
   std::unique_ptr<NowSecondsEnv> env(new NowSecondsEnv);
   // Create a cache with max staleness of 2 seconds, and verify that it works as
   // expected.
-  RamFileBlockCache cache1(8, 16, 2 /* max staleness */, fetcher, env.get());
+  RamFileBlockCache cache1(8, 16, 2 /* max staleness */, fetcher,
+                           0 /* prefetch blocks */, env.get());
   // Execute the first read to load the block.
   TF_EXPECT_OK(ReadCache(&cache1, "", 0, 1, &out));
   EXPECT_EQ(calls, 1);
@@ -346,7 +348,8 @@ TEST(RamFileBlockCacheTest, MaxStaleness) {
   // as expected.
   calls = 0;
   env->SetNowSeconds(0);
-  RamFileBlockCache cache2(8, 16, 0 /* max staleness */, fetcher, env.get());
+  RamFileBlockCache cache2(8, 16, 0 /* max staleness */, fetcher,
+                           0 /* prefetch blocks */, env.get());
   // Execute the first read to load the block.
   TF_EXPECT_OK(ReadCache(&cache2, "", 0, 1, &out));
   EXPECT_EQ(calls, 1);
@@ -433,7 +436,8 @@ TEST(RamFileBlockCacheTest, Prune) {
   std::unique_ptr<NowSecondsEnv> env(new NowSecondsEnv);
   uint64 now = Env::Default()->NowSeconds();
   env->SetNowSeconds(now);
-  RamFileBlockCache cache(8, 32, 1 /* max staleness */, fetcher, env.get());
+  RamFileBlockCache cache(8, 32, 1 /* max staleness */, fetcher,
+                          0 /* prefetch blocks */, env.get());
   // Read three blocks into the cache, and advance the timestamp by one second
   // with each read. Start with a block of "a" at the current timestamp `now`.
   TF_EXPECT_OK(ReadCache(&cache, "a", 0, 1, &out));
@@ -566,5 +570,69 @@ TEST(RamFileBlockCacheTest, Flush) {
   EXPECT_EQ(calls, 2);
 }
 
+TEST(RamFileBlockCacheTest, Prefetch) {
+  const size_t block_size = 8;
+  std::atomic<int> calls(0);
+  auto fetcher = [&calls](const string& filename, size_t offset, size_t n,
+                          char* buffer, size_t* bytes_transferred) {
+    calls++;
+    memset(buffer, 'x', n);
+    *bytes_transferred = n;
+    return OkStatus();
+  };
+  RamFileBlockCache cache(block_size, 8 * block_size, 0, fetcher,
+                          2 /* prefetch blocks */);
+  cache.Prefetch("", block_size, 2 * block_size);
+  // Wait for the background threads to fetch the two hinted blocks.
+  while (cache.CacheSize() < 2 * block_size) {
+    Env::Default()->SleepForMicroseconds(1000);
+  }
+  EXPECT_EQ(calls, 2);
+  // A non-sequential read of the hinted range is served from the cache.
+  std::vector<char> out;
+  TF_EXPECT_OK(ReadCache(&cache, "", 2 * block_size, block_size, &out));
+  std::vector<char> x(block_size, 'x');
+  EXPECT_EQ(out, x);
+  EXPECT_EQ(calls, 2);
+}
+
+TEST(RamFileBlockCacheTest, SequentialPrefetch) {
+  // A file of two full blocks, so that prefetching also runs past EOF.
+  const size_t block_size = 8;
+  const size_t file_size = 2 * block_size;
+  std::atomic<int> calls(0);
+  auto fetcher = [&calls, file_size](const string& filename, size_t offset,
+                                     size_t n, char* buffer,
+                                     size_t* bytes_transferred) {
+    calls++;
+    if (offset >= file_size) {
+      *bytes_transferred = 0;
+      return OkStatus();
+    }
+    size_t bytes = std::min(n, file_size - offset);
+    memset(buffer, 'x', bytes);
+    *bytes_transferred = bytes;
+    return OkStatus();
+  };
+  RamFileBlockCache cache(block_size, 8 * block_size, 0, fetcher,
+                          2 /* prefetch blocks */);
+  // Reading the first block of the file counts as sequential access and
+  // triggers a background fetch of the blocks ahead, one of which is past
+  // EOF and is discarded.
+  std::vector<char> out;
+  TF_EXPECT_OK(ReadCache(&cache, "", 0, block_size, &out));
+  while (cache.CacheSize() < 2 * block_size || calls < 3) {
+    Env::Default()->SleepForMicroseconds(1000);
+  }
+  EXPECT_EQ(calls, 3);
+  EXPECT_EQ(cache.CacheSize(), 2 * block_size);
+  // The next block is served from the cache, and reading past EOF still
+  // reports EOF despite the discarded prefetch at that offset.
+  TF_EXPECT_OK(ReadCache(&cache, "", block_size, block_size, &out));
+  std::vector<char> x(block_size, 'x');
+  EXPECT_EQ(out, x);
+  EXPECT_TRUE(errors::IsOutOfRange(ReadCache(&cache, "", file_size, 1, &out)));
+}
+
 }  // namespace
 }  // namespace tsl
@@ -18,8 +18,8 @@ limitations under the License.
 #include <fcntl.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <sys/mman.h>
-
 #if defined(__linux__)
 #include <sys/sendfile.h>
 #endif
@@ -29,11 +29,17 @@ limitations under the License.
 #include <time.h>
 #include <unistd.h>
 
+#include <deque>
+#include <functional>
+#include <thread>  // NOLINT
+#include <utility>
+
 #include "tsl/platform/default/posix_file_system.h"
 #include "tsl/platform/env.h"
 #include "tsl/platform/errors.h"
 #include "tsl/platform/file_system_helper.h"
 #include "tsl/platform/logging.h"
+#include "tsl/platform/mutex.h"
 #include "tsl/platform/status.h"
 #include "tsl/platform/strcat.h"
 #include "tsl/protobuf/error_codes.pb.h"
@@ -45,6 +51,68 @@ using ::tsl::errors::IOError;
 // 128KB of copy buffer
 constexpr size_t kPosixCopyFileBufferSize = 128 * 1024;
 
+// Shared worker pool backing PosixRandomAccessFile::ReadAsync(). pread() has
+// no portable completion-based kernel interface, so a small pool of threads
+// keeps many reads in flight on behalf of the callers; the pool size bounds
+// the I/O queue depth submitted to the kernel and is configurable via
+// TF_POSIX_FILE_ASYNC_THREADS. The pool is created on first use and lives for
+// the remainder of the process.
+class PosixAsyncReadPool {
+ public:
+  static PosixAsyncReadPool* Global() {
+    static PosixAsyncReadPool* pool = new PosixAsyncReadPool(NumThreads());
+    return pool;
+  }
+
+  void Schedule(std::function<void()> work) {
+    {
+      mutex_lock l(mu_);
+      queue_.push_back(std::move(work));
+    }
+    work_cv_.notify_one();
+  }
+
+ private:
+  static constexpr int kDefaultNumThreads = 16;
+
+  static int NumThreads() {
+    const char* env = getenv("TF_POSIX_FILE_ASYNC_THREADS");
+    if (env == nullptr) return kDefaultNumThreads;
+    char* end = nullptr;
+    const long value = strtol(env, &end, 10);  // NOLINT
+    if (end == env || *end != '\0' || value <= 0) {
+      LOG(ERROR) << "Invalid TF_POSIX_FILE_ASYNC_THREADS: " << env;
+      return kDefaultNumThreads;
+    }
+    return static_cast<int>(value);
+  }
+
+  explicit PosixAsyncReadPool(int num_threads) {
+    for (int i = 0; i < num_threads; ++i) {
+      std::thread([this]() { WorkerLoop(); }).detach();
+    }
+  }
+
+  void WorkerLoop() {
+    while (true) {
+      std::function<void()> work;
+      {
+        mutex_lock l(mu_);
+        while (queue_.empty()) {
+          work_cv_.wait(l);
+        }
+        work = std::move(queue_.front());
+        queue_.pop_front();
+      }
+      work();
+    }
+  }
+
+  mutex mu_;
+  condition_variable work_cv_;
+  std::deque<std::function<void()>> queue_ TF_GUARDED_BY(mu_);
+};
+
 // pread() based random-access
 class PosixRandomAccessFile : public RandomAccessFile {
  private:
@@ -65,6 +133,17 @@ class PosixRandomAccessFile : public RandomAccessFile {
     return OkStatus();
   }
 
+  void ReadAsync(
+      uint64 offset, size_t n, char* scratch,
+      std::function<void(const Status&, StringPiece)> done) const override {
+    PosixAsyncReadPool::Global()->Schedule(
+        [this, offset, n, scratch, done = std::move(done)]() {
+          StringPiece result;
+          Status status = Read(offset, n, &result, scratch);
+          done(status, result);
+        });
+  }
+
   Status Read(uint64 offset, size_t n, StringPiece* result,
               char* scratch) const override {
     Status s;
@@ -762,6 +762,26 @@ class RandomAccessFile {
   virtual tsl::Status Read(uint64 offset, size_t n, StringPiece* result,
                            char* scratch) const = 0;
 
+  /// \brief Asynchronously reads up to `n` bytes from the file starting at
+  /// `offset`.
+  ///
+  /// Invokes `done` exactly once with the read status and result, possibly
+  /// from another thread and possibly before this call returns. The result
+  /// follows the same contract as `Read()` and may point into `scratch`, so
+  /// both `scratch` and this file must stay live until `done` has been
+  /// invoked. Implementations backed by queue-based I/O can keep many such
+  /// reads in flight per calling thread; the default implementation simply
+  /// performs the read synchronously before returning.
+  ///
+  /// Safe for concurrent use by multiple threads.
+  virtual void ReadAsync(
+      uint64 offset, size_t n, char* scratch,
+      std::function<void(const tsl::Status&, StringPiece)> done) const {
+    StringPiece result;
+    tsl::Status status = Read(offset, n, &result, scratch);
+    done(status, result);
+  }
+
 #if defined(TF_CORD_SUPPORT)
   /// \brief Read up to `n` bytes from the file starting at `offset`.
   virtual tsl::Status Read(uint64 offset, size_t n, absl::Cord* cord) const {
@@ -17,6 +17,9 @@ limitations under the License.
 
 #define EIGEN_USE_THREADS
 
+#include <algorithm>
+#include <atomic>
+
 #include "absl/types/optional.h"
 #include "unsupported/Eigen/CXX11/Tensor"  // from @eigen_archive
 #include "tsl/platform/blocking_counter.h"
@@ -24,6 +27,7 @@ limitations under the License.
 #include "tsl/platform/denormal.h"
 #include "tsl/platform/logging.h"
 #include "tsl/platform/mutex.h"
+#include "tsl/platform/notification.h"
 #include "tsl/platform/numa.h"
 #include "tsl/platform/setround.h"
 #include "tsl/platform/tracing.h"
@@ -225,6 +229,84 @@ void ThreadPool::ParallelFor(int64_t total, int64_t cost_per_unit,
       [&fn](Eigen::Index first, Eigen::Index last) { fn(first, last); });
 }
 
+bool ThreadPool::EnableNumaAwareScheduling() {
+  if (eigen_threadpool_ == nullptr) {
+    // The pool wraps a user-provided threadpool whose threads we don't own.
+    return false;
+  }
+  if (!port::NUMAEnabled()) return false;
+  const int num_nodes = port::NUMANumNodes();
+  const int num_threads = NumThreads();
+  if (num_nodes < 2 || num_threads < num_nodes) return false;
+  std::vector<std::pair<unsigned, unsigned>> partitions;
+  for (int node = 0; node < num_nodes; ++node) {
+    partitions.push_back(
+        {static_cast<unsigned>(node * num_threads / num_nodes),
+         static_cast<unsigned>((node + 1) * num_threads / num_nodes)});
+  }
+  // Pin each pool thread to the node owning its partition. Each pinning task
+  // blocks until all of them have started, which forces the tasks onto
+  // distinct threads: a thread cannot pick up a second task while its first
+  // is still blocked.
+  std::atomic<int> started(0);
+  Notification all_started;
+  BlockingCounter done(num_threads);
+  for (int i = 0; i < num_threads; ++i) {
+    Schedule([this, &partitions, &started, &all_started, &done, num_threads] {
+      if (started.fetch_add(1) + 1 == num_threads) all_started.Notify();
+      all_started.WaitForNotification();
+      const unsigned id = static_cast<unsigned>(CurrentThreadId());
+      for (int node = 0; node < static_cast<int>(partitions.size()); ++node) {
+        if (id >= partitions[node].first && id < partitions[node].second) {
+          port::NUMASetThreadNodeAffinity(node);
+          break;
+        }
+      }
+      done.DecrementCount();
+    });
+  }
+  done.Wait();
+  numa_partitions_ = std::move(partitions);
+  return true;
+}
+
+void ThreadPool::ParallelForWithAffinity(
+    const void* data, int64_t total, int64_t cost_per_unit,
+    const std::function<void(int64_t, int64_t)>& fn) {
+  CHECK_GE(total, 0);
+  int node = port::kNUMANoAffinity;
+  if (!numa_partitions_.empty() && data != nullptr) {
+    node = port::NUMAGetMemAffinity(data);
+  }
+  if (node < 0 || node >= static_cast<int>(numa_partitions_.size())) {
+    ParallelFor(total, cost_per_unit, fn);
+    return;
+  }
+  const std::pair<unsigned, unsigned>& partition = numa_partitions_[node];
+  const int64_t partition_threads = partition.second - partition.first;
+  if (total <= 1 || partition_threads <= 1) {
+    if (total > 0) fn(0, total);
+    return;
+  }
+  // One block per thread in the owning partition, queued with a hint so the
+  // blocks land on threads whose caches and memory controller live on `node`.
+  const int64_t block_size =
+      (total + partition_threads - 1) / partition_threads;
+  const int64_t num_shards = (total + block_size - 1) / block_size;
+  BlockingCounter counter(num_shards);
+  for (int64_t shard = 0; shard < num_shards; ++shard) {
+    const int64_t first = shard * block_size;
+    const int64_t last = std::min(total, first + block_size);
+    ScheduleWithHint(
+        [&fn, &counter, first, last]() {
+          fn(first, last);
+          counter.DecrementCount();
+        },
+        partition.first, partition.second);
+  }
+  counter.Wait();
+}
+
 void ThreadPool::ParallelForWithWorkerId(
     int64_t total, int64_t cost_per_unit,
     const std::function<void(int64_t, int64_t, int)>& fn) {
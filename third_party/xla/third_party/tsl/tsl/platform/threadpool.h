@@ -143,6 +143,29 @@ class ThreadPool {
 
   void ScheduleWithHint(std::function<void()> fn, int start, int limit);
 
+  // Partitions the pool's threads evenly across the NUMA nodes of the machine
+  // and pins each partition's threads to its node. After this returns true,
+  // ParallelForWithAffinity prefers to run shards on the threads pinned to the
+  // node that owns the data. Returns false and leaves scheduling unchanged if
+  // NUMA is not supported, the machine has a single node, the pool has fewer
+  // threads than nodes, or the pool wraps a user-provided threadpool.
+  //
+  // Should be called right after construction: in order to pin the threads it
+  // briefly occupies every thread in the pool, so it will block behind any
+  // long-running work already scheduled.
+  bool EnableNumaAwareScheduling();
+
+  // Like ParallelFor, but once EnableNumaAwareScheduling has succeeded, each
+  // shard of [0, total) is queued with a hint restricting it to the threads
+  // pinned to the NUMA node owning `data` (per port::NUMAGetMemAffinity).
+  // Idle threads on other nodes may still steal queued shards, so a saturated
+  // partition degrades to the normal work-stealing behavior instead of
+  // serializing the loop. Falls back to plain ParallelFor when NUMA-aware
+  // scheduling is not enabled or the owning node of `data` is unknown.
+  void ParallelForWithAffinity(const void* data, int64_t total,
+                               int64_t cost_per_unit,
+                               const std::function<void(int64_t, int64_t)>& fn);
+
   // Returns the number of shards used by ParallelForFixedBlockSizeScheduling
   // with these parameters.
   int NumShardsUsedByFixedBlockSizeScheduling(const int64_t total,
@@ -235,6 +258,9 @@ class ThreadPool {
   // user_threadpool is not in the constructor.
   std::unique_ptr<Eigen::ThreadPoolTempl<EigenEnvironment>> eigen_threadpool_;
   std::unique_ptr<Eigen::ThreadPoolDevice> threadpool_device_;
+  // Thread index range pinned to each NUMA node; empty until
+  // EnableNumaAwareScheduling succeeds.
+  std::vector<std::pair<unsigned, unsigned>> numa_partitions_;
   ThreadPool(const ThreadPool&) = delete;
   void operator=(const ThreadPool&) = delete;
 };
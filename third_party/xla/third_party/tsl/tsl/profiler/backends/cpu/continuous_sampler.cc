@@ -0,0 +1,233 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tsl/profiler/backends/cpu/continuous_sampler.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "tsl/platform/env.h"
+#include "tsl/platform/logging.h"
+#include "tsl/platform/mutex.h"
+#include "tsl/platform/random.h"
+#include "tsl/platform/types.h"
+#include "tsl/profiler/backends/cpu/host_tracer_utils.h"
+#include "tsl/profiler/backends/cpu/traceme_recorder.h"
+#include "tsl/profiler/lib/profiler_lock.h"
+#include "tsl/profiler/protobuf/xplane.pb.h"
+#include "tsl/profiler/utils/time_utils.h"
+#include "tsl/profiler/utils/xplane_utils.h"
+#include "tsl/util/env_var.h"
+
+namespace tsl {
+namespace profiler {
+
+/*static*/ ContinuousSampler* ContinuousSampler::Get() {
+  static ContinuousSampler* singleton = new ContinuousSampler;
+  return singleton;
+}
+
+/*static*/ ContinuousSamplerOptions ContinuousSampler::OptionsFromEnv() {
+  ContinuousSamplerOptions options;
+  int64_t value = 0;
+  if (ReadInt64FromEnvVar("TF_PROFILER_CONTINUOUS_SAMPLING_LEVEL",
+                          options.trace_level, &value)
+          .ok()) {
+    options.trace_level = value;
+  }
+  if (ReadInt64FromEnvVar("TF_PROFILER_CONTINUOUS_SAMPLING_PERIOD_MS",
+                          options.harvest_period_ms, &value)
+          .ok() &&
+      value > 0) {
+    options.harvest_period_ms = value;
+  }
+  if (ReadInt64FromEnvVar("TF_PROFILER_CONTINUOUS_SAMPLING_RETENTION_SEC",
+                          options.retention_ns / (1000 * 1000 * 1000), &value)
+          .ok() &&
+      value > 0) {
+    options.retention_ns = value * 1000 * 1000 * 1000;
+  }
+  return options;
+}
+
+bool ContinuousSampler::Start(const ContinuousSamplerOptions& options) {
+  mutex_lock lock(mu_);
+  if (running_) return false;
+  options_ = options;
+  shutdown_ = false;
+  running_ = true;
+  thread_.reset(Env::Default()->StartThread(
+      ThreadOptions(), "continuous_sampler", [this]() { HarvestLoop(); }));
+  VLOG(1) << "ContinuousSampler started at trace level "
+          << options_.trace_level;
+  return true;
+}
+
+void ContinuousSampler::Stop() {
+  std::unique_ptr<Thread> thread;
+  {
+    mutex_lock lock(mu_);
+    if (!running_) return;
+    shutdown_ = true;
+    running_ = false;
+    cv_.notify_all();
+    thread = std::move(thread_);
+  }
+  thread.reset();  // Joins the harvest thread.
+}
+
+bool ContinuousSampler::IsRunning() const {
+  mutex_lock lock(mu_);
+  return running_;
+}
+
+void ContinuousSampler::Pause() {
+  mutex_lock lock(mu_);
+  if (owns_recorder_) {
+    AddEvents(TraceMeRecorder::Stop());
+    owns_recorder_ = false;
+    VLOG(1) << "ContinuousSampler released TraceMeRecorder to a profiler "
+               "session";
+  }
+}
+
+void ContinuousSampler::HarvestLoop() {
+  mutex_lock lock(mu_);
+  while (!shutdown_) {
+    WaitForMilliseconds(&lock, &cv_, options_.harvest_period_ms);
+    if (shutdown_) break;
+    if (ProfilerLock::HasActiveSession()) {
+      // A profiler session may own TraceMeRecorder; stay out of its way.
+      // Pause() normally releases the recorder before the session's host
+      // tracer starts, this is a fallback in case a session was started
+      // without going through the profiler factories.
+      if (owns_recorder_) {
+        AddEvents(TraceMeRecorder::Stop());
+        owns_recorder_ = false;
+      }
+      continue;
+    }
+    if (!owns_recorder_) {
+      owns_recorder_ = TraceMeRecorder::Start(options_.trace_level);
+      if (owns_recorder_ && ProfilerLock::HasActiveSession()) {
+        // Lost a race with a session that started after the check above;
+        // give the recorder back.
+        AddEvents(TraceMeRecorder::Stop());
+        owns_recorder_ = false;
+      }
+      continue;
+    }
+    AddEvents(TraceMeRecorder::Stop());
+    owns_recorder_ = TraceMeRecorder::Start(options_.trace_level);
+  }
+  if (owns_recorder_) {
+    // Drain events recorded since the last harvest so they remain available
+    // to CollectData after Stop.
+    AddEvents(TraceMeRecorder::Stop());
+    owns_recorder_ = false;
+  }
+}
+
+void ContinuousSampler::AddEvents(TraceMeRecorder::Events&& events) {
+  for (TraceMeRecorder::ThreadEvents& thread_events : events) {
+    thread_names_[thread_events.thread.tid] = thread_events.thread.name;
+    for (TraceMeRecorder::Event& event : thread_events.events) {
+      // Unpaired start/end events cannot be attributed a duration; drop them
+      // like HostTracer does.
+      if (!event.IsComplete()) continue;
+      OpLatencySnapshot& reservoir = reservoirs_[event.name];
+      ++reservoir.count;
+      if (reservoir.name.empty()) reservoir.name = event.name;
+      int64_t duration_ns = event.end_time - event.start_time;
+      reservoir.sum_ns += duration_ns;
+      if (reservoir.samples_ns.size() < options_.reservoir_size) {
+        reservoir.samples_ns.push_back(duration_ns);
+      } else {
+        // Reservoir sampling: replace a random sample with probability
+        // reservoir_size / count, so retained samples stay uniform.
+        size_t index = random::New64() % reservoir.count;
+        if (index < reservoir.samples_ns.size()) {
+          reservoir.samples_ns[index] = duration_ns;
+        }
+      }
+      buffer_.push_back({thread_events.thread.tid, std::move(event)});
+    }
+  }
+  int64_t cutoff_ns = GetCurrentTimeNanos() - options_.retention_ns;
+  while (!buffer_.empty() && (buffer_.size() > options_.max_events ||
+                              buffer_.front().event.end_time < cutoff_ns)) {
+    buffer_.pop_front();
+  }
+}
+
+void ContinuousSampler::CollectData(int64_t duration_ns,
+                                    tensorflow::profiler::XSpace* space) {
+  mutex_lock lock(mu_);
+  int64_t cutoff_ns =
+      (duration_ns > 0) ? GetCurrentTimeNanos() - duration_ns : 0;
+  TraceMeRecorder::Events events;
+  absl::flat_hash_map<uint32, size_t> thread_index;
+  int64_t start_timestamp_ns = 0;
+  for (const BufferedEvent& buffered : buffer_) {
+    if (buffered.event.end_time < cutoff_ns) continue;
+    auto emplaced = thread_index.emplace(buffered.tid, events.size());
+    if (emplaced.second) {
+      events.push_back(
+          {{buffered.tid, thread_names_[buffered.tid]}, /*events=*/{}});
+    }
+    events[emplaced.first->second].events.push_back(buffered.event);
+    if (start_timestamp_ns == 0 ||
+        buffered.event.start_time < start_timestamp_ns) {
+      start_timestamp_ns = buffered.event.start_time;
+    }
+  }
+  if (events.empty()) return;
+  tensorflow::profiler::XPlane* plane =
+      FindOrAddMutablePlaneWithName(space, kSampledHostThreadsPlaneName);
+  ConvertCompleteEventsToXPlane(start_timestamp_ns, std::move(events), plane);
+}
+
+std::vector<ContinuousSampler::OpLatencySnapshot>
+ContinuousSampler::GetOpLatencies() const {
+  mutex_lock lock(mu_);
+  std::vector<OpLatencySnapshot> snapshots;
+  snapshots.reserve(reservoirs_.size());
+  for (const auto& name_and_reservoir : reservoirs_) {
+    snapshots.push_back(name_and_reservoir.second);
+  }
+  return snapshots;
+}
+
+namespace {
+
+// Starts the sampler at load time if requested through the environment, so
+// that production binaries need no code change to get continuous sampling.
+auto start_continuous_sampler_from_env = [] {
+  bool enable = false;
+  ReadBoolFromEnvVar("TF_PROFILER_CONTINUOUS_SAMPLING", false, &enable)
+      .IgnoreError();
+  if (enable) {
+    ContinuousSampler::Get()->Start(ContinuousSampler::OptionsFromEnv());
+  }
+  return 0;
+}();
+
+}  // namespace
+
+}  // namespace profiler
+}  // namespace tsl
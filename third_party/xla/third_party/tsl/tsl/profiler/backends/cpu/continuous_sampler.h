@@ -0,0 +1,153 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_TSL_PROFILER_BACKENDS_CPU_CONTINUOUS_SAMPLER_H_
+#define TENSORFLOW_TSL_PROFILER_BACKENDS_CPU_CONTINUOUS_SAMPLER_H_
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
+#include "tsl/platform/env.h"
+#include "tsl/platform/mutex.h"
+#include "tsl/platform/thread_annotations.h"
+#include "tsl/platform/types.h"
+#include "tsl/profiler/backends/cpu/traceme_recorder.h"
+#include "tsl/profiler/protobuf/xplane.pb.h"
+
+namespace tsl {
+namespace profiler {
+
+// Name of the XPlane that holds events exported from the continuous sampler,
+// distinct from kHostThreadsPlaneName so they are not confused with events
+// captured during the profiling session itself.
+constexpr absl::string_view kSampledHostThreadsPlaneName =
+    "/host:sampled_threads";
+
+struct ContinuousSamplerOptions {
+  // Only TraceMe events at or below this level are recorded.  The default,
+  // level 1 (critical), keeps overhead low enough for production use.
+  int trace_level = 1;
+  // How often the background thread drains TraceMeRecorder into the ring
+  // buffer.
+  int64_t harvest_period_ms = 500;
+  // Events older than this are evicted from the ring buffer.
+  int64_t retention_ns = 60LL * 1000 * 1000 * 1000;
+  // Hard cap on the number of buffered events, in case retention_ns alone
+  // would retain too many.
+  size_t max_events = 1 << 20;
+  // Number of per-op duration samples retained by reservoir sampling.
+  size_t reservoir_size = 64;
+};
+
+// An always-on, low-overhead sampling profiler for TraceMe events.
+//
+// While no regular profiler session is active, a background thread keeps
+// TraceMeRecorder recording at a low trace level and periodically drains it
+// into a bounded ring buffer of recent events, as well as into per-op latency
+// reservoirs.  The buffered events can be exported on demand as an XPlane via
+// CollectData(), so a production regression can be examined after the fact
+// without having had a profiler session running when it happened.
+//
+// When a regular profiler session starts, the sampler hands TraceMeRecorder
+// over to it (see Pause()) and resumes automatically once the session ends.
+//
+// Thread-safety: all public methods are thread-safe.
+class ContinuousSampler {
+ public:
+  // Summary of the durations observed for one TraceMe name.
+  struct OpLatencySnapshot {
+    std::string name;
+    int64_t count = 0;
+    int64_t sum_ns = 0;
+    // Uniform random sample of durations, at most
+    // ContinuousSamplerOptions::reservoir_size entries.
+    std::vector<int64_t> samples_ns;
+  };
+
+  // Returns the process-wide instance.
+  static ContinuousSampler* Get();
+
+  // Returns options with overrides read from the environment:
+  //   TF_PROFILER_CONTINUOUS_SAMPLING_LEVEL
+  //   TF_PROFILER_CONTINUOUS_SAMPLING_PERIOD_MS
+  //   TF_PROFILER_CONTINUOUS_SAMPLING_RETENTION_SEC
+  static ContinuousSamplerOptions OptionsFromEnv();
+
+  // Starts the background harvest thread.  Returns false if already running.
+  bool Start(const ContinuousSamplerOptions& options);
+
+  // Stops the background thread.  Buffered events are retained and can still
+  // be exported with CollectData().
+  void Stop();
+
+  bool IsRunning() const;
+
+  // Releases TraceMeRecorder, draining any recorded events into the ring
+  // buffer first.  Called when a regular profiler session starts, so that the
+  // session's host tracer can own the recorder.  Harvesting resumes
+  // automatically once ProfilerLock reports no active session.
+  void Pause();
+
+  // Exports the buffered events from the last `duration_ns` into `space`, on
+  // the plane named kSampledHostThreadsPlaneName.  If `duration_ns` is zero,
+  // exports everything currently buffered (i.e. up to retention_ns worth of
+  // events).
+  void CollectData(int64_t duration_ns, tensorflow::profiler::XSpace* space);
+
+  // Returns a snapshot of the per-op latency reservoirs.
+  std::vector<OpLatencySnapshot> GetOpLatencies() const;
+
+ private:
+  struct BufferedEvent {
+    uint32 tid;
+    TraceMeRecorder::Event event;
+  };
+
+  ContinuousSampler() = default;
+
+  ContinuousSampler(const ContinuousSampler&) = delete;
+  void operator=(const ContinuousSampler&) = delete;
+
+  // Body of the background thread.
+  void HarvestLoop();
+
+  // Appends complete events to the ring buffer and updates the latency
+  // reservoirs, then evicts events beyond max_events or retention_ns.
+  void AddEvents(TraceMeRecorder::Events&& events)
+      TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  mutable mutex mu_;
+  condition_variable cv_;
+  ContinuousSamplerOptions options_ TF_GUARDED_BY(mu_);
+  bool running_ TF_GUARDED_BY(mu_) = false;
+  bool shutdown_ TF_GUARDED_BY(mu_) = false;
+  // True while the harvest thread owns TraceMeRecorder.
+  bool owns_recorder_ TF_GUARDED_BY(mu_) = false;
+  // Ring buffer of recent events, oldest first.
+  std::deque<BufferedEvent> buffer_ TF_GUARDED_BY(mu_);
+  // Names of the threads that produced buffered events.
+  absl::flat_hash_map<uint32, std::string> thread_names_ TF_GUARDED_BY(mu_);
+  absl::flat_hash_map<std::string, OpLatencySnapshot> reservoirs_
+      TF_GUARDED_BY(mu_);
+  std::unique_ptr<Thread> thread_;
+};
+
+}  // namespace profiler
+}  // namespace tsl
+
+#endif  // TENSORFLOW_TSL_PROFILER_BACKENDS_CPU_CONTINUOUS_SAMPLER_H_
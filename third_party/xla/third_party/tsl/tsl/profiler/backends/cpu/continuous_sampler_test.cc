@@ -0,0 +1,86 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tsl/profiler/backends/cpu/continuous_sampler.h"
+
+#include <string>
+#include <vector>
+
+#include "tsl/platform/env.h"
+#include "tsl/platform/test.h"
+#include "tsl/platform/types.h"
+#include "tsl/profiler/lib/traceme.h"
+#include "tsl/profiler/protobuf/xplane.pb.h"
+
+namespace tsl {
+namespace profiler {
+namespace {
+
+constexpr char kEventName[] = "continuous_sampler_test_event";
+
+TEST(ContinuousSamplerTest, BuffersAndExportsEvents) {
+  auto* sampler = ContinuousSampler::Get();
+  ContinuousSamplerOptions options;
+  options.harvest_period_ms = 10;
+  ASSERT_TRUE(sampler->Start(options));
+  EXPECT_TRUE(sampler->IsRunning());
+  EXPECT_FALSE(sampler->Start(options));  // Already running.
+
+  // Give the harvest thread a chance to start TraceMeRecorder, then emit some
+  // events.
+  Env::Default()->SleepForMicroseconds(100 * 1000);
+  constexpr int kNumEvents = 5;
+  for (int i = 0; i < kNumEvents; ++i) {
+    TraceMe traceme(kEventName);
+    Env::Default()->SleepForMicroseconds(1000);
+  }
+  // Stopping drains any events not yet harvested into the ring buffer.
+  sampler->Stop();
+  EXPECT_FALSE(sampler->IsRunning());
+
+  tensorflow::profiler::XSpace space;
+  sampler->CollectData(/*duration_ns=*/0, &space);
+  const tensorflow::profiler::XPlane* plane = nullptr;
+  for (const auto& p : space.planes()) {
+    if (p.name() == kSampledHostThreadsPlaneName) plane = &p;
+  }
+  ASSERT_NE(plane, nullptr);
+  int num_events = 0;
+  for (const auto& id_and_metadata : plane->event_metadata()) {
+    if (id_and_metadata.second.name() == kEventName) {
+      for (const auto& line : plane->lines()) {
+        for (const auto& event : line.events()) {
+          if (event.metadata_id() == id_and_metadata.first) ++num_events;
+        }
+      }
+    }
+  }
+  EXPECT_EQ(num_events, kNumEvents);
+
+  // The latency reservoir should have seen every instance of the event.
+  bool found_reservoir = false;
+  for (const auto& snapshot : sampler->GetOpLatencies()) {
+    if (snapshot.name == kEventName) {
+      found_reservoir = true;
+      EXPECT_EQ(snapshot.count, kNumEvents);
+      EXPECT_EQ(snapshot.samples_ns.size(), kNumEvents);
+      EXPECT_GT(snapshot.sum_ns, 0);
+    }
+  }
+  EXPECT_TRUE(found_reservoir);
+}
+
+}  // namespace
+}  // namespace profiler
+}  // namespace tsl
@@ -0,0 +1,64 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include <memory>
+
+#include "tsl/platform/status.h"
+#include "tsl/profiler/backends/cpu/continuous_sampler.h"
+#include "tsl/profiler/lib/profiler_factory.h"
+#include "tsl/profiler/lib/profiler_interface.h"
+#include "tsl/profiler/protobuf/profiler_options.pb.h"
+#include "tsl/profiler/protobuf/xplane.pb.h"
+
+namespace xla {
+namespace profiler {
+namespace {
+
+// Exports the ring buffer of the always-on ContinuousSampler into a profiler
+// session's XSpace, which makes the regular collection paths (including the
+// profiler RPC service) the on-demand hook to dump recently sampled events.
+class ContinuousSamplerExporter : public tsl::profiler::ProfilerInterface {
+ public:
+  tsl::Status Start() override { return tsl::OkStatus(); }
+
+  tsl::Status Stop() override { return tsl::OkStatus(); }
+
+  tsl::Status CollectData(tensorflow::profiler::XSpace* space) override {
+    // Exports everything currently buffered; the sampler's retention window
+    // bounds how far back this reaches.
+    tsl::profiler::ContinuousSampler::Get()->CollectData(/*duration_ns=*/0,
+                                                         space);
+    return tsl::OkStatus();
+  }
+};
+
+std::unique_ptr<tsl::profiler::ProfilerInterface> CreateContinuousSamplerExporter(
+    const tensorflow::ProfileOptions& profile_options) {
+  auto* sampler = tsl::profiler::ContinuousSampler::Get();
+  if (!sampler->IsRunning()) return nullptr;
+  // The session's host tracer needs to own TraceMeRecorder.  Profilers are
+  // created before any of them is started, so releasing the recorder here
+  // guarantees it is available by the time the host tracer starts.
+  sampler->Pause();
+  return std::make_unique<ContinuousSamplerExporter>();
+}
+
+auto register_continuous_sampler_factory = [] {
+  RegisterProfilerFactory(&CreateContinuousSamplerExporter);
+  return 0;
+}();
+
+}  // namespace
+}  // namespace profiler
+}  // namespace xla